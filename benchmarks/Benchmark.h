@@ -0,0 +1,60 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_BENCHMARK_H_K7PZ2QWM
+#define ARTERY_BENCHMARK_H_K7PZ2QWM
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+
+namespace artery
+{
+namespace benchmark
+{
+
+/**
+ * Sink for benchmark results, prevents the compiler from discarding the measured work
+ */
+inline void consume(std::size_t value)
+{
+    static volatile std::size_t sink = 0;
+    sink = sink + value;
+}
+
+/**
+ * Measure given callable and print nanoseconds per operation
+ *
+ * The callable is invoked for the given number of iterations per repetition,
+ * the fastest of all repetitions is reported to suppress scheduling noise.
+ * \param name label of measurement
+ * \param ops number of operations carried out by one invocation of fn
+ * \param iterations number of invocations per repetition
+ * \param fn measured callable
+ * \param repetitions number of repetitions
+ */
+template<typename Fn>
+void run(const char* name, std::size_t ops, std::size_t iterations, Fn&& fn, unsigned repetitions = 5)
+{
+    using clock = std::chrono::steady_clock;
+    double best = std::numeric_limits<double>::infinity();
+    fn(); // warm-up, e.g. caches and allocations
+    for (unsigned r = 0; r < repetitions; ++r) {
+        const auto start = clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            fn();
+        }
+        const std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+        best = std::min(best, elapsed.count() / static_cast<double>(iterations * std::max<std::size_t>(ops, 1)));
+    }
+    std::printf("%-48s %12.1f ns/op\n", name, best);
+}
+
+} // namespace benchmark
+} // namespace artery
+
+#endif /* ARTERY_BENCHMARK_H_K7PZ2QWM */
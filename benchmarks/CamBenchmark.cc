@@ -0,0 +1,90 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "Benchmark.h"
+#include "artery/application/CaService.h"
+#include <vanetza/asn1/cam.hpp>
+#include <random>
+
+namespace
+{
+
+// fills high frequency CAM like createCooperativeAwarenessMessage with representative vehicle data
+vanetza::asn1::Cam makeCam(std::mt19937& rng)
+{
+    std::uniform_int_distribution<long> latitude(500000000, 510000000);
+    std::uniform_int_distribution<long> longitude(110000000, 120000000);
+    std::uniform_int_distribution<long> heading(0, 3600);
+    std::uniform_int_distribution<long> speed(0, 4000);
+
+    vanetza::asn1::Cam message;
+    ItsPduHeader_t& header = (*message).header;
+    header.protocolVersion = 2;
+    header.messageID = ItsPduHeader__messageID_cam;
+    header.stationID = rng();
+
+    CoopAwareness_t& cam = (*message).cam;
+    cam.generationDeltaTime = rng() % 65536;
+    BasicContainer_t& basic = cam.camParameters.basicContainer;
+    basic.stationType = StationType_passengerCar;
+    basic.referencePosition.altitude.altitudeValue = AltitudeValue_unavailable;
+    basic.referencePosition.altitude.altitudeConfidence = AltitudeConfidence_unavailable;
+    basic.referencePosition.longitude = longitude(rng);
+    basic.referencePosition.latitude = latitude(rng);
+    basic.referencePosition.positionConfidenceEllipse.semiMajorOrientation = HeadingValue_unavailable;
+    basic.referencePosition.positionConfidenceEllipse.semiMajorConfidence = SemiAxisLength_unavailable;
+    basic.referencePosition.positionConfidenceEllipse.semiMinorConfidence = SemiAxisLength_unavailable;
+
+    HighFrequencyContainer_t& hfc = cam.camParameters.highFrequencyContainer;
+    hfc.present = HighFrequencyContainer_PR_basicVehicleContainerHighFrequency;
+    BasicVehicleContainerHighFrequency& bvc = hfc.choice.basicVehicleContainerHighFrequency;
+    bvc.heading.headingValue = heading(rng);
+    bvc.heading.headingConfidence = HeadingConfidence_equalOrWithinOneDegree;
+    bvc.speed.speedValue = speed(rng);
+    bvc.speed.speedConfidence = SpeedConfidence_equalOrWithinOneCentimeterPerSec * 3;
+    bvc.driveDirection = DriveDirection_forward;
+    bvc.longitudinalAcceleration.longitudinalAccelerationValue = LongitudinalAccelerationValue_unavailable;
+    bvc.longitudinalAcceleration.longitudinalAccelerationConfidence = AccelerationConfidence_unavailable;
+    bvc.curvature.curvatureValue = 0;
+    bvc.curvature.curvatureConfidence = CurvatureConfidence_unavailable;
+    bvc.curvatureCalculationMode = CurvatureCalculationMode_yawRateUsed;
+    bvc.yawRate.yawRateValue = YawRateValue_unavailable;
+    bvc.vehicleLength.vehicleLengthValue = VehicleLengthValue_unavailable;
+    bvc.vehicleLength.vehicleLengthConfidenceIndication = VehicleLengthConfidenceIndication_noTrailerPresent;
+    bvc.vehicleWidth = VehicleWidth_unavailable;
+    return message;
+}
+
+} // namespace
+
+int main()
+{
+    using namespace artery::benchmark;
+    std::mt19937 rng { 42 };
+
+    run("CAM creation (high frequency)", 1, 10000, [&]() {
+        auto cam = makeCam(rng);
+        consume(cam->header.stationID);
+    });
+
+    run("CAM creation (low frequency, 23 path points)", 1, 10000, [&]() {
+        auto cam = makeCam(rng);
+        artery::addLowFrequencyContainer(cam, 23, false);
+        consume(cam->header.stationID);
+    });
+
+    const auto high = makeCam(rng);
+    run("CAM UPER encoding (high frequency)", 1, 10000, [&]() {
+        consume(high.encode().size());
+    });
+
+    auto low = makeCam(rng);
+    artery::addLowFrequencyContainer(low, 23, false);
+    run("CAM UPER encoding (low frequency, 23 path points)", 1, 10000, [&]() {
+        consume(low.encode().size());
+    });
+
+    return 0;
+}
@@ -0,0 +1,148 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "Benchmark.h"
+#include "artery/envmod/sensor/OcclusionEngine.h"
+#include "artery/utility/Geometry.h"
+#include <boost/geometry/index/rtree.hpp>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace bgi = boost::geometry::index;
+using artery::Position;
+using Outline = std::vector<Position>;
+
+namespace
+{
+
+const std::size_t objects = 5000;
+const std::size_t sensors = 500;
+const double fieldSize = 5000.0;
+
+Outline makeVehicle(double x, double y, double heading)
+{
+    // 4.5 m x 1.8 m rectangle like outlines of EnvironmentModelObjects
+    const double c = std::cos(heading);
+    const double s = std::sin(heading);
+    Outline outline;
+    for (auto corner : { std::make_pair(2.25, 0.9), std::make_pair(-2.25, 0.9), std::make_pair(-2.25, -0.9), std::make_pair(2.25, -0.9) }) {
+        outline.emplace_back(x + c * corner.first - s * corner.second, y + s * corner.first + c * corner.second);
+    }
+    return outline;
+}
+
+Outline makeSector(const Position& origin, double heading, double range, double opening)
+{
+    // sensor field of view polygon as built by FovSensor
+    Outline sector { origin };
+    const unsigned segments = 8;
+    for (unsigned i = 0; i <= segments; ++i) {
+        const double angle = heading - 0.5 * opening + opening * i / segments;
+        sector.emplace_back(origin.x.value() + range * std::cos(angle), origin.y.value() + range * std::sin(angle));
+    }
+    return sector;
+}
+
+} // namespace
+
+int main()
+{
+    using namespace artery::benchmark;
+    using Value = std::pair<artery::geometry::Box, std::size_t>;
+    using Rtree = bgi::rtree<Value, bgi::quadratic<16>>; // same parameters as GlobalEnvironmentModel's object rtree
+
+    std::mt19937 rng { 42 };
+    std::uniform_real_distribution<double> coord(0.0, fieldSize);
+    std::uniform_real_distribution<double> heading(-M_PI, M_PI);
+
+    std::vector<Outline> outlines;
+    std::vector<Value> values;
+    for (std::size_t i = 0; i < objects; ++i) {
+        outlines.push_back(makeVehicle(coord(rng), coord(rng), heading(rng)));
+        values.emplace_back(boost::geometry::return_envelope<artery::geometry::Box>(outlines.back()), i);
+    }
+
+    std::vector<Outline> sectors;
+    for (std::size_t i = 0; i < sensors; ++i) {
+        sectors.push_back(makeSector(Position { coord(rng), coord(rng) }, heading(rng), 200.0, M_PI / 3.0));
+    }
+
+    run("object rtree bulk-load", objects, 20, [&]() {
+        Rtree rtree { values.begin(), values.end() };
+        consume(rtree.size());
+    });
+
+    run("object rtree insertion", objects, 20, [&]() {
+        Rtree rtree;
+        for (const Value& value : values) {
+            rtree.insert(value);
+        }
+        consume(rtree.size());
+    });
+
+    const Rtree rtree { values.begin(), values.end() };
+    std::vector<std::size_t> preselection;
+    run("sensor preselection query", sensors, 20, [&]() {
+        for (const Outline& sector : sectors) {
+            preselection.clear();
+            for (auto it = rtree.qbegin(bgi::intersects(sector)); it != rtree.qend(); ++it) {
+                preselection.push_back(it->second);
+            }
+            consume(preselection.size());
+        }
+    });
+
+    // line of sight checks from sensor origin to preselected objects against all preselected outlines
+    std::vector<std::pair<Position, std::vector<std::size_t>>> views;
+    for (const Outline& sector : sectors) {
+        std::vector<std::size_t> visible;
+        for (auto it = rtree.qbegin(bgi::intersects(sector)); it != rtree.qend(); ++it) {
+            visible.push_back(it->second);
+        }
+        views.emplace_back(sector.front(), std::move(visible));
+    }
+
+    std::size_t checks = 0;
+    for (const auto& view : views) {
+        checks += view.second.size() * view.second.size();
+    }
+
+    run("line of sight (exact predicate)", checks, 3, [&]() {
+        for (const auto& view : views) {
+            for (std::size_t target : view.second) {
+                const artery::geometry::LineString los { { view.first.x.value(), view.first.y.value() }, { outlines[target].front().x.value(), outlines[target].front().y.value() } };
+                for (std::size_t blocker : view.second) {
+                    if (blocker != target) {
+                        consume(boost::geometry::intersects(los, outlines[blocker]));
+                    }
+                }
+            }
+        }
+    });
+
+    artery::OcclusionEngine engine;
+    run("line of sight (OcclusionEngine screening)", checks, 3, [&]() {
+        for (const auto& view : views) {
+            engine.clear();
+            for (std::size_t object : view.second) {
+                engine.add(outlines[object]);
+            }
+            for (std::size_t t = 0; t < view.second.size(); ++t) {
+                const Position& a = view.first;
+                const Position& b = outlines[view.second[t]].front();
+                const artery::geometry::LineString los { { a.x.value(), a.y.value() }, { b.x.value(), b.y.value() } };
+                for (std::size_t k = 0; k < view.second.size(); ++k) {
+                    if (k != t && engine.mayTouch(k, a, b)) {
+                        consume(boost::geometry::intersects(los, outlines[view.second[k]]));
+                    }
+                }
+            }
+        }
+    });
+
+    return 0;
+}
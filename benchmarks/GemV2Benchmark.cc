@@ -0,0 +1,127 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "Benchmark.h"
+#include "artery/inet/gemv2/BlockageCandidates.h"
+#include "artery/utility/Geometry.h"
+#include <boost/geometry/geometries/register/linestring.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <array>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+using artery::Position;
+using Outline = std::vector<Position>;
+
+namespace { using LineOfSight = std::array<artery::Position, 2>; }
+BOOST_GEOMETRY_REGISTER_LINESTRING(LineOfSight)
+
+namespace
+{
+
+const double blockSize = 100.0;
+const unsigned blocks = 40;
+const std::size_t transmitters = 200;
+const std::size_t receivers = 2000;
+const double range = 500.0;
+
+// building footprints of a Manhattan grid, streets are 20 m wide
+std::vector<Outline> makeBuildings()
+{
+    std::vector<Outline> buildings;
+    for (unsigned i = 0; i < blocks; ++i) {
+        for (unsigned j = 0; j < blocks; ++j) {
+            const double x = i * blockSize + 10.0;
+            const double y = j * blockSize + 10.0;
+            const double w = blockSize - 20.0;
+            buildings.push_back({ Position { x, y }, Position { x + w, y }, Position { x + w, y + w }, Position { x, y + w } });
+        }
+    }
+    return buildings;
+}
+
+} // namespace
+
+int main()
+{
+    using namespace artery::benchmark;
+    using Value = std::pair<artery::geometry::Box, std::size_t>;
+    using Rtree = bgi::rtree<Value, bgi::rstar<16>>; // same parameters as ObstacleIndex
+
+    const std::vector<Outline> buildings = makeBuildings();
+    std::vector<Value> values;
+    for (std::size_t i = 0; i < buildings.size(); ++i) {
+        values.emplace_back(bg::return_envelope<artery::geometry::Box>(buildings[i]), i);
+    }
+    const Rtree rtree { values.begin(), values.end() };
+
+    // stations are placed on streets, i.e. outside of building footprints
+    std::mt19937 rng { 42 };
+    std::uniform_int_distribution<unsigned> street(0, blocks);
+    std::uniform_real_distribution<double> along(0.0, blocks * blockSize);
+    auto station = [&]() {
+        const double s = street(rng) * blockSize;
+        const double t = along(rng);
+        return rng() % 2 ? Position { s, t } : Position { t, s };
+    };
+
+    std::vector<Position> rx;
+    for (std::size_t i = 0; i < receivers; ++i) {
+        rx.push_back(station());
+    }
+
+    std::vector<std::pair<Position, std::vector<Position>>> links;
+    std::size_t numLinks = 0;
+    for (std::size_t i = 0; i < transmitters; ++i) {
+        const Position tx = station();
+        std::vector<Position> peers;
+        for (const Position& r : rx) {
+            if (bg::distance(tx, r) < range) {
+                peers.push_back(r);
+            }
+        }
+        numLinks += peers.size();
+        links.emplace_back(tx, std::move(peers));
+    }
+
+    // NLOSb blockage check with one rtree query per line of sight
+    run("link blockage (rtree query per link)", numLinks, 5, [&]() {
+        for (const auto& link : links) {
+            for (const Position& r : link.second) {
+                const LineOfSight los { link.first, r };
+                bool blocked = false;
+                for (auto it = rtree.qbegin(bgi::intersects(los)); it != rtree.qend() && !blocked; ++it) {
+                    blocked = bg::crosses(los, buildings[it->second]);
+                }
+                consume(blocked);
+            }
+        }
+    });
+
+    // one candidate query per transmitter, links are screened by BlockageCandidates
+    artery::gemv2::BlockageCandidates candidates;
+    run("link blockage (BlockageCandidates)", numLinks, 5, [&]() {
+        for (const auto& link : links) {
+            const double x = link.first.x.value();
+            const double y = link.first.y.value();
+            const artery::geometry::Box box { { x - range, y - range }, { x + range, y + range } };
+            candidates.clear();
+            for (auto it = rtree.qbegin(bgi::intersects(box)); it != rtree.qend(); ++it) {
+                candidates.add(it->second, buildings[it->second]);
+            }
+            for (const Position& r : link.second) {
+                const LineOfSight los { link.first, r };
+                consume(candidates.any(link.first, r, [&](artery::gemv2::BlockageCandidates::Index candidate) {
+                    return bg::crosses(los, buildings[candidate]);
+                }));
+            }
+        }
+    });
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "Benchmark.h"
+#include "traci/StorageView.h"
+#include "traci/VehicleStateTable.h"
+#include "traci/sumo/foreign/tcpip/storage.h"
+#include "traci/sumo/libsumo/TraCIConstants.h"
+#include "traci/sumo/libsumo/TraCIDefs.h"
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+const std::size_t vehicles = 2000;
+
+// encode variable subscription responses of all vehicles as sent by SUMO at each step
+std::vector<unsigned char> encodeStep(std::mt19937& rng)
+{
+    std::uniform_real_distribution<double> coord(0.0, 5000.0);
+    std::uniform_real_distribution<double> angle(0.0, 360.0);
+    std::uniform_real_distribution<double> speed(0.0, 30.0);
+
+    tcpip::Storage storage;
+    for (std::size_t i = 0; i < vehicles; ++i) {
+        storage.writeString("veh" + std::to_string(i));
+        storage.writeUnsignedByte(3);
+        storage.writeUnsignedByte(libsumo::VAR_POSITION);
+        storage.writeUnsignedByte(libsumo::RTYPE_OK);
+        storage.writeUnsignedByte(libsumo::POSITION_2D);
+        storage.writeDouble(coord(rng));
+        storage.writeDouble(coord(rng));
+        storage.writeUnsignedByte(libsumo::VAR_ANGLE);
+        storage.writeUnsignedByte(libsumo::RTYPE_OK);
+        storage.writeUnsignedByte(libsumo::TYPE_DOUBLE);
+        storage.writeDouble(angle(rng));
+        storage.writeUnsignedByte(libsumo::VAR_SPEED);
+        storage.writeUnsignedByte(libsumo::RTYPE_OK);
+        storage.writeUnsignedByte(libsumo::TYPE_DOUBLE);
+        storage.writeDouble(speed(rng));
+    }
+    return std::vector<unsigned char>(storage.begin(), storage.end());
+}
+
+template<typename Msg>
+std::shared_ptr<libsumo::TraCIResult> readValue(Msg& msg, int type)
+{
+    if (type == libsumo::POSITION_2D) {
+        auto p = std::make_shared<libsumo::TraCIPosition>();
+        p->x = msg.readDouble();
+        p->y = msg.readDouble();
+        return p;
+    } else {
+        return std::make_shared<libsumo::TraCIDouble>(msg.readDouble());
+    }
+}
+
+template<typename Msg>
+void readVariables(Msg& msg, libsumo::TraCIResults& into)
+{
+    for (int count = msg.readUnsignedByte(); count > 0; --count) {
+        const int variable = msg.readUnsignedByte();
+        msg.readUnsignedByte(); // status
+        const int type = msg.readUnsignedByte();
+        into[variable] = readValue(msg, type);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    using namespace artery::benchmark;
+    std::mt19937 rng { 42 };
+    const std::vector<unsigned char> step = encodeStep(rng);
+
+    // baseline: copying tcpip::Storage and fresh result maps at each step
+    run("tcpip::Storage decoding", vehicles, 50, [&]() {
+        tcpip::Storage msg { step.data(), static_cast<int>(step.size()) };
+        libsumo::SubscriptionResults results;
+        while (msg.valid_pos()) {
+            const std::string id = msg.readString();
+            readVariables(msg, results[id]);
+        }
+        consume(results.size());
+    });
+
+    // StorageView decoding into retained result maps (see API::readSimulationStepResult)
+    libsumo::SubscriptionResults retained;
+    std::string lookup;
+    run("StorageView decoding (retained results)", vehicles, 50, [&]() {
+        traci::StorageView msg { step.data(), step.size() };
+        while (msg.valid_pos()) {
+            lookup.assign(msg.readString());
+            readVariables(msg, retained[lookup]);
+        }
+        consume(retained.size());
+    });
+
+    traci::VehicleStateTable table;
+    run("VehicleStateTable update", vehicles, 50, [&]() {
+        table.beginStep();
+        for (const auto& vehicle : retained) {
+            consume(table.update(vehicle.first, vehicle.second));
+        }
+        consume(table.endStep());
+    });
+
+    return 0;
+}
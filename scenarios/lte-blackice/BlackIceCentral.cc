@@ -1,7 +1,12 @@
 #include "BlackIceCentral.h"
+#include "BlackIceWarner.h"
 #include "lte_msgs/BlackIceWarning_m.h"
+#include <inet/common/InitStages.h>
+#include <inet/mobility/contract/IMobility.h>
 #include <inet/networklayer/common/L3AddressResolver.h>
 #include <inet/transportlayer/contract/udp/UDPControlInfo.h>
+#include <algorithm>
+#include <limits>
 
 using namespace omnetpp;
 
@@ -9,10 +14,43 @@ Define_Module(BlackIceCentral)
 
 BlackIceCentral::~BlackIceCentral()
 {
+    cancelAndDelete(disseminationTrigger);
 }
 
-void BlackIceCentral::initialize()
+int BlackIceCentral::numInitStages() const
 {
+    return inet::NUM_INIT_STAGES;
+}
+
+void BlackIceCentral::initialize(int stage)
+{
+    if (stage == inet::INITSTAGE_LAST && par("abstractUu").boolValue()) {
+        // base stations are located once their mobility has been initialized
+        cModule* enb = getSystemModule()->getSubmodule("eNodeB", 0);
+        const int numCells = enb ? enb->getVectorSize() : 0;
+        for (int i = 0; i < numCells; ++i) {
+            enb = getSystemModule()->getSubmodule("eNodeB", i);
+            auto mobility = check_and_cast<inet::IMobility*>(enb->getSubmodule("mobility"));
+            cells.push_back(mobility->getCurrentPosition());
+        }
+        if (cells.empty()) {
+            throw cRuntimeError("abstract Uu link requires eNodeB modules");
+        }
+        cellLoads.assign(cells.size(), 0);
+
+        disseminationInterval = par("disseminationInterval");
+        uuBaseDelay = par("uuBaseDelay");
+        uuLoadDelay = par("uuLoadDelay");
+        uuLossPerUe = par("uuLossPerUe");
+        uuMaxLoss = par("uuMaxLoss");
+        disseminationTrigger = new cMessage("disseminate black ice digests");
+        scheduleAt(simTime() + disseminationInterval, disseminationTrigger);
+    }
+
+    if (stage != inet::INITSTAGE_LOCAL) {
+        return;
+    }
+
     reportPort = par("reportPort");
     reportSocket.setOutputGate(gate("udpOut"));
     reportSocket.bind(inet::L3Address(), reportPort);
@@ -23,8 +61,10 @@ void BlackIceCentral::initialize()
 
     numReceivedWarnings = 0;
     numReceivedQueries = 0;
+    numDisseminatedDigests = 0;
     WATCH(numReceivedWarnings);
     WATCH(numReceivedQueries);
+    WATCH(numDisseminatedDigests);
 }
 
 void BlackIceCentral::finish()
@@ -34,11 +74,21 @@ void BlackIceCentral::finish()
 
     recordScalar("numReceivedWarnings", numReceivedWarnings);
     recordScalar("numReceivedQueries", numReceivedQueries);
+    if (disseminationTrigger) {
+        recordScalar("numDisseminatedDigests", numDisseminatedDigests);
+    }
 }
 
 void BlackIceCentral::handleMessage(cMessage* msg)
 {
-    if (msg->getKind() == inet::UDP_I_DATA) {
+    if (msg == disseminationTrigger) {
+        disseminateWarning();
+        scheduleAt(simTime() + disseminationInterval, disseminationTrigger);
+    } else if (msg->getArrivalGate() == gate("directIn")) {
+        // report sent via abstract Uu link
+        processReport(*check_and_cast<BlackIceReport*>(msg));
+        delete msg;
+    } else if (msg->getKind() == inet::UDP_I_DATA) {
         processPacket(PK(msg));
     } else if (msg->getKind() == inet::UDP_I_ERROR) {
         EV_ERROR << "UDP error occurred\n";
@@ -86,3 +136,89 @@ void BlackIceCentral::processQuery(BlackIceQuery& query, const inet::L3Address&
     querySocket.sendTo(response, addr, port);
 }
 
+void BlackIceCentral::disseminateWarning()
+{
+    // assign UEs to cells, the resulting loads are also used for uplink until next dissemination
+    std::fill(cellLoads.begin(), cellLoads.end(), 0);
+    std::vector<double> cellReach(cells.size(), 0.0);
+    std::vector<unsigned> warnerCells;
+    warnerCells.reserve(warners.size());
+    for (BlackIceWarner* warner : warners) {
+        const inet::Coord position = warner->getUePosition();
+        const unsigned cell = getCell(position);
+        warnerCells.push_back(cell);
+        ++cellLoads[cell];
+        cellReach[cell] = std::max(cellReach[cell], position.distance(cells[cell]) + warner->getPollingRadius());
+    }
+
+    // one digest per cell carries all reports relevant to any of its UEs
+    for (unsigned cell = 0; cell < cells.size(); ++cell) {
+        if (cellLoads[cell] == 0) {
+            continue;
+        }
+
+        BlackIceDigest digest("black ice digest");
+        digest.setCell(cell);
+        std::vector<const BlackIceReport*> relevant;
+        for (const BlackIceReport& report : reports) {
+            const inet::Coord position { report.getPositionX(), report.getPositionY() };
+            if (position.distance(cells[cell]) < cellReach[cell]) {
+                relevant.push_back(&report);
+            }
+        }
+        digest.setPositionXArraySize(relevant.size());
+        digest.setPositionYArraySize(relevant.size());
+        for (unsigned i = 0; i < relevant.size(); ++i) {
+            digest.setPositionX(i, relevant[i]->getPositionX());
+            digest.setPositionY(i, relevant[i]->getPositionY());
+        }
+        ++numDisseminatedDigests;
+
+        const simtime_t delay = uuBaseDelay + uuLoadDelay * cellLoads[cell];
+        const double loss = std::min(uuMaxLoss, uuLossPerUe * cellLoads[cell]);
+        for (unsigned i = 0; i < warners.size(); ++i) {
+            if (warnerCells[i] == cell && uniform(0.0, 1.0) >= loss) {
+                sendDirect(digest.dup(), delay, SIMTIME_ZERO, warners[i], "directIn");
+            }
+        }
+    }
+}
+
+void BlackIceCentral::registerWarner(BlackIceWarner* warner)
+{
+    Enter_Method_Silent();
+    if (!disseminationTrigger) {
+        throw cRuntimeError("abstract Uu link is disabled at black ice central");
+    }
+    warners.push_back(warner);
+}
+
+void BlackIceCentral::unregisterWarner(BlackIceWarner* warner)
+{
+    Enter_Method_Silent();
+    warners.erase(std::remove(warners.begin(), warners.end(), warner), warners.end());
+}
+
+unsigned BlackIceCentral::getCell(const inet::Coord& position) const
+{
+    unsigned closest = 0;
+    double closestDistance = std::numeric_limits<double>::infinity();
+    for (unsigned cell = 0; cell < cells.size(); ++cell) {
+        const double distance = position.sqrdist(cells[cell]);
+        if (distance < closestDistance) {
+            closest = cell;
+            closestDistance = distance;
+        }
+    }
+    return closest;
+}
+
+simtime_t BlackIceCentral::getUuDelay(const inet::Coord& position) const
+{
+    return cellLoads.empty() ? uuBaseDelay : uuBaseDelay + uuLoadDelay * cellLoads[getCell(position)];
+}
+
+double BlackIceCentral::getUuLoss(const inet::Coord& position) const
+{
+    return cellLoads.empty() ? 0.0 : std::min(uuMaxLoss, uuLossPerUe * cellLoads[getCell(position)]);
+}
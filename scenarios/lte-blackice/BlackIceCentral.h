@@ -1,22 +1,32 @@
 #ifndef BLACKICECENTRAL_H_3LKZ0NOB
 #define BLACKICECENTRAL_H_3LKZ0NOB
 
+#include <inet/common/geometry/common/Coord.h>
 #include <inet/networklayer/common/L3Address.h>
 #include <inet/transportlayer/contract/udp/UDPSocket.h>
 #include <omnetpp/csimplemodule.h>
 #include <list>
+#include <vector>
 
 // forward declaration
 class BlackIceQuery;
 class BlackIceReport;
+class BlackIceWarner;
 
 class BlackIceCentral : public omnetpp::cSimpleModule
 {
 public:
     ~BlackIceCentral();
 
+    // abstract Uu link: UEs are assigned to their closest eNodeB
+    void registerWarner(BlackIceWarner*);
+    void unregisterWarner(BlackIceWarner*);
+    omnetpp::simtime_t getUuDelay(const inet::Coord&) const;
+    double getUuLoss(const inet::Coord&) const;
+
 protected:
-    void initialize() override;
+    int numInitStages() const override;
+    void initialize(int stage) override;
     void finish() override;
     void handleMessage(omnetpp::cMessage*) override;
 
@@ -25,6 +35,7 @@ private:
     void processReport(BlackIceReport&);
     void processQuery(BlackIceQuery&, const inet::L3Address&, int port);
     void disseminateWarning();
+    unsigned getCell(const inet::Coord&) const;
 
     int reportPort;
     int queryPort;
@@ -33,6 +44,17 @@ private:
     inet::UDPSocket reportSocket;
     inet::UDPSocket querySocket;
     std::list<BlackIceReport> reports;
+
+    omnetpp::cMessage* disseminationTrigger = nullptr;
+    omnetpp::simtime_t disseminationInterval;
+    omnetpp::simtime_t uuBaseDelay;
+    omnetpp::simtime_t uuLoadDelay;
+    double uuLossPerUe;
+    double uuMaxLoss;
+    std::vector<inet::Coord> cells;
+    std::vector<unsigned> cellLoads;
+    std::vector<BlackIceWarner*> warners;
+    int numDisseminatedDigests;
 };
 
 #endif /* BLACKICECENTRAL_H_3LKZ0NOB */
@@ -1,4 +1,5 @@
 #include "BlackIceReporter.h"
+#include "BlackIceCentral.h"
 #include "lte_msgs/BlackIceWarning_m.h"
 #include "artery/application/Middleware.h"
 #include "artery/application/StoryboardSignal.h"
@@ -28,6 +29,9 @@ void BlackIceReporter::initialize(int stage)
         auto mw = inet::getModuleFromPar<artery::Middleware>(par("middlewareModule"), this);
         mw->subscribe(storyboardSignal, this);
         vehicleController = artery::notNullPtr(mw->getFacilities().get_const_ptr<traci::VehicleController>());
+        if (par("abstractUu").boolValue()) {
+            abstractCentral = check_and_cast<BlackIceCentral*>(getModuleByPath(par("centralModule")));
+        }
     }
 }
 
@@ -63,5 +67,16 @@ void BlackIceReporter::sendReport()
     report->setPositionY(vehicleController->getPosition().y / meter);
     report->setSpeed(vehicleController->getSpeed() / meter_per_second);
     report->setTime(simTime());
-    socket.send(report);
+
+    if (abstractCentral) {
+        // bypass LTE stack: uplink delay and loss depend on load of serving cell
+        const inet::Coord position { report->getPositionX(), report->getPositionY() };
+        if (uniform(0.0, 1.0) < abstractCentral->getUuLoss(position)) {
+            delete report;
+        } else {
+            sendDirect(report, abstractCentral->getUuDelay(position), SIMTIME_ZERO, abstractCentral, "directIn");
+        }
+    } else {
+        socket.send(report);
+    }
 }
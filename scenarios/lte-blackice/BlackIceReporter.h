@@ -6,6 +6,7 @@
 #include <omnetpp/csimplemodule.h>
 
 // forward declaration
+class BlackIceCentral;
 namespace traci { class VehicleController; }
 
 class BlackIceReporter : public omnetpp::cSimpleModule, public omnetpp::cListener
@@ -21,6 +22,7 @@ private:
 
     inet::UDPSocket socket;
     const traci::VehicleController* vehicleController = nullptr;
+    BlackIceCentral* abstractCentral = nullptr;
     unsigned tractionLosses;
 };
 
@@ -1,4 +1,5 @@
 #include "BlackIceWarner.h"
+#include "BlackIceCentral.h"
 #include "lte_msgs/BlackIceWarning_m.h"
 #include "artery/application/Middleware.h"
 #include "artery/traci/VehicleController.h"
@@ -34,7 +35,13 @@ void BlackIceWarner::initialize(int stage)
         auto mw = inet::getModuleFromPar<artery::Middleware>(par("middlewareModule"), this);
         vehicleController = artery::notNullPtr(mw->getFacilities().get_mutable_ptr<traci::VehicleController>());
 
-        scheduleAt(simTime() + uniform(0.0, pollingInterval), pollingTrigger);
+        if (par("abstractUu").boolValue()) {
+            // central pushes digests, no polling required
+            abstractCentral = check_and_cast<BlackIceCentral*>(getModuleByPath(par("centralModule")));
+            abstractCentral->registerWarner(this);
+        } else {
+            scheduleAt(simTime() + uniform(0.0, pollingInterval), pollingTrigger);
+        }
     }
 }
 
@@ -46,6 +53,10 @@ int BlackIceWarner::numInitStages() const
 void BlackIceWarner::finish()
 {
     socket.close();
+    if (abstractCentral) {
+        abstractCentral->unregisterWarner(this);
+        abstractCentral = nullptr;
+    }
     recordScalar("numWarningsCentral", numWarningsCentral);
 }
 
@@ -53,6 +64,9 @@ void BlackIceWarner::handleMessage(cMessage* msg)
 {
     if (msg->isSelfMessage()) {
         pollCentral();
+    } else if (msg->getArrivalGate() == gate("directIn")) {
+        processDigest(*check_and_cast<BlackIceDigest*>(msg));
+        delete msg;
     } else if (msg->getKind() == inet::UDP_I_DATA) {
         processResponse(*check_and_cast<BlackIceResponse*>(msg));
         delete msg;
@@ -71,14 +85,40 @@ void BlackIceWarner::pollCentral()
     scheduleAt(simTime() + pollingInterval, pollingTrigger);
 }
 
+inet::Coord BlackIceWarner::getUePosition() const
+{
+    const auto& position = vehicleController->getPosition();
+    return inet::Coord { position.x / boost::units::si::meter, position.y / boost::units::si::meter };
+}
+
 void BlackIceWarner::processResponse(BlackIceResponse& response)
 {
-    EV_INFO << "Black ice warnings: " << response.getWarnings() << "\n";
-    if (response.getWarnings() >= 2 && !reducedSpeed) {
+    processWarnings(response.getWarnings());
+}
+
+void BlackIceWarner::processDigest(BlackIceDigest& digest)
+{
+    // count reports like central does for queries
+    const inet::Coord position = getUePosition();
+    int warnings = 0;
+    for (unsigned i = 0; i < digest.getPositionXArraySize(); ++i) {
+        double dx = position.x - digest.getPositionX(i);
+        double dy = position.y - digest.getPositionY(i);
+        if (dx * dx + dy * dy < pollingRadius * pollingRadius) {
+            ++warnings;
+        }
+    }
+    processWarnings(warnings);
+}
+
+void BlackIceWarner::processWarnings(int warnings)
+{
+    EV_INFO << "Black ice warnings: " << warnings << "\n";
+    if (warnings >= 2 && !reducedSpeed) {
         vehicleController->setSpeedFactor(0.5);
         reducedSpeed = true;
         ++numWarningsCentral;
-    } else if (response.getWarnings() == 0 && reducedSpeed) {
+    } else if (warnings == 0 && reducedSpeed) {
         vehicleController->setSpeedFactor(1.0);
         reducedSpeed = false;
     }
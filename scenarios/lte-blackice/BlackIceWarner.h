@@ -1,10 +1,13 @@
 #ifndef BLACKICEWARNER_H_IONPZSRI
 #define BLACKICEWARNER_H_IONPZSRI
 
+#include <inet/common/geometry/common/Coord.h>
 #include <inet/transportlayer/contract/udp/UDPSocket.h>
 #include <omnetpp/csimplemodule.h>
 
 // forward declaration
+class BlackIceCentral;
+class BlackIceDigest;
 class BlackIceResponse;
 namespace traci { class VehicleController; }
 
@@ -13,6 +16,9 @@ class BlackIceWarner : public omnetpp::cSimpleModule
 public:
     ~BlackIceWarner();
 
+    inet::Coord getUePosition() const;
+    double getPollingRadius() const { return pollingRadius; }
+
 protected:
     int numInitStages() const override;
     void initialize(int stage) override;
@@ -22,12 +28,15 @@ protected:
 private:
     void pollCentral();
     void processResponse(BlackIceResponse&);
+    void processDigest(BlackIceDigest&);
+    void processWarnings(int warnings);
 
     inet::UDPSocket socket;
     double pollingRadius;
     omnetpp::simtime_t pollingInterval;
     omnetpp::cMessage* pollingTrigger = nullptr;
     traci::VehicleController* vehicleController = nullptr;
+    BlackIceCentral* abstractCentral = nullptr;
     bool reducedSpeed = false;
     int numWarningsCentral;
 };
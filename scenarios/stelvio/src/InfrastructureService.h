@@ -39,6 +39,7 @@ public:
     void initialize() override;
     void finish() override;
     void trigger() override;
+    bool requiresTrigger() const override { return true; }
     void indicate(const vanetza::btp::DataIndication&, omnetpp::cPacket*, const artery::NetworkInterface&) override;
 
 private:
@@ -7,6 +7,8 @@
 #include "artery/StaticNodeManager.h"
 #include "artery/inet/AntennaMobility.h"
 #include "artery/utility/InitStages.h"
+#include <set>
+#include <unordered_map>
 
 namespace artery
 {
@@ -54,14 +56,14 @@ void StaticNodeManager::initialize(int stage)
 void StaticNodeManager::handleMessage(omnetpp::cMessage* msg)
 {
     if (msg == mInsertionEvent) {
-        for (auto it = mInsertionQueue.begin(); it != mInsertionQueue.end();) {
-            if (it->first <= simTime()) {
-                addRoadSideUnit(it->second);
-                it = mInsertionQueue.erase(it);
-            } else {
-                break;
-            }
+        // all RSUs due now are added in one pass, e.g. the whole grid of RSUs sharing an insertion delay
+        std::vector<const RSU*> rsus;
+        auto it = mInsertionQueue.begin();
+        for (; it != mInsertionQueue.end() && it->first <= simTime(); ++it) {
+            rsus.push_back(&mRsus.at(it->second));
         }
+        mInsertionQueue.erase(mInsertionQueue.begin(), it);
+        addRoadSideUnits(rsus);
 
         scheduleInsertionEvent();
     }
@@ -87,15 +89,23 @@ void StaticNodeManager::loadRoadSideUnits()
 {
     cXMLElement* config = par("nodes").xmlValue();
 
+    std::set<std::string> ids;
+    for (const RSU& rsu : mRsus) {
+        ids.insert(rsu.id);
+    }
+
     for (cXMLElement* rsu : config->getChildrenByTagName("rsu")) {
         const char* id = rsu->getAttribute("id");
         if (!id) {
             EV_WARN << "rsu has no id specified, skip" << endl;
-        } else if (mRsuMap.find(id) != mRsuMap.end()) {
+            continue;
+        } else if (!ids.insert(id).second) {
             EV_WARN << "rsu with id " << id << " already exists, skip" << endl;
+            continue;
         }
 
         RSU rsuStruct;
+        rsuStruct.id = id;
         rsuStruct.position.x = std::stod(rsu->getAttribute("positionX")) * boost::units::si::meter;
         rsuStruct.position.y = std::stod(rsu->getAttribute("positionY")) * boost::units::si::meter;
         for (cXMLElement* antenna : rsu->getChildrenByTagName("antenna")) {
@@ -103,19 +113,32 @@ void StaticNodeManager::loadRoadSideUnits()
             rsuStruct.antennaDirections.push_back(direction);
         }
 
-        mRsuMap.emplace(id, std::move(rsuStruct));
-        mInsertionQueue.emplace(simTime() + par("insertionDelay"), id);
+        mRsus.push_back(std::move(rsuStruct));
+        mInsertionQueue.emplace(simTime() + par("insertionDelay"), mRsus.size() - 1);
     }
 
     scheduleInsertionEvent();
 }
 
-void StaticNodeManager::addRoadSideUnit(const std::string& id)
+void StaticNodeManager::addRoadSideUnits(const std::vector<const RSU*>& rsus)
+{
+    std::vector<cModule*> modules;
+    modules.reserve(rsus.size());
+    for (const RSU* rsu : rsus) {
+        modules.push_back(addRoadSideUnit(*rsu));
+    }
+
+    if (mInitSource) {
+        fakeInitSignal(modules);
+    }
+}
+
+cModule* StaticNodeManager::addRoadSideUnit(const RSU& rsu)
 {
-    const artery::Position& pos = mRsuMap.at(id).position;
-    const std::vector<double>& antennaDirections = mRsuMap.at(id).antennaDirections;
+    const artery::Position& pos = rsu.position;
+    const std::vector<double>& antennaDirections = rsu.antennaDirections;
 
-    cModule* rsuModule = createRoadSideUnitModule(id);
+    cModule* rsuModule = createRoadSideUnitModule(rsu.id);
     rsuModule->par("numRadios") = mDirectionalAntennas ? std::max(1ul, antennaDirections.size()) : 1;
     rsuModule->par("withAntennaMobility") = mDirectionalAntennas;
     rsuModule->finalizeParameters();
@@ -170,18 +193,35 @@ void StaticNodeManager::addRoadSideUnit(const std::string& id)
 
     rsuModule->scheduleStart(simTime());
     rsuModule->callInitialize();
-    emit(addRoadSideUnitSignal, id.c_str(), rsuModule);
+    emit(addRoadSideUnitSignal, rsu.id.c_str(), rsuModule);
+    return rsuModule;
+}
 
-    // fake traci.init signal for added RSU module if it has matching listeners
-    if (mInitSource) {
-        auto listeners = getSystemModule()->getLocalSignalListeners(initSignal);
-        for (omnetpp::cIListener* listener : listeners) {
-            auto mod = dynamic_cast<omnetpp::cModule*>(listener);
-            if (mod && rsuModule->containsModule(mod)) {
-                listener->receiveSignal(mInitSource, initSignal, simTime(), nullptr);
+void StaticNodeManager::fakeInitSignal(const std::vector<cModule*>& modules)
+{
+    // assign each listener to its enclosing RSU by walking up its parents once
+    std::unordered_map<const cModule*, std::size_t> rsuIndex;
+    for (std::size_t i = 0; i < modules.size(); ++i) {
+        rsuIndex.emplace(modules[i], i);
+    }
+
+    std::vector<std::vector<omnetpp::cIListener*>> rsuListeners(modules.size());
+    for (omnetpp::cIListener* listener : getSystemModule()->getLocalSignalListeners(initSignal)) {
+        for (auto mod = dynamic_cast<const cModule*>(listener); mod; mod = mod->getParentModule()) {
+            auto found = rsuIndex.find(mod);
+            if (found != rsuIndex.end()) {
+                rsuListeners[found->second].push_back(listener);
+                break;
             }
         }
     }
+
+    // listeners are notified per RSU in order of their addition
+    for (const auto& listeners : rsuListeners) {
+        for (omnetpp::cIListener* listener : listeners) {
+            listener->receiveSignal(mInitSource, initSignal, simTime(), nullptr);
+        }
+    }
 }
 
 cModule* StaticNodeManager::createRoadSideUnitModule(const std::string& id)
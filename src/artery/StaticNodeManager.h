@@ -10,6 +10,7 @@
 #include "artery/utility/Geometry.h"
 #include <omnetpp/csimplemodule.h>
 #include <omnetpp/clistener.h>
+#include <cstddef>
 #include <map>
 #include <string>
 #include <vector>
@@ -28,6 +29,7 @@ public:
 protected:
     struct RSU
     {
+        std::string id;
         Position position;
         std::vector<double> antennaDirections;
     };
@@ -38,16 +40,23 @@ protected:
     void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t signal, const omnetpp::SimTime&, omnetpp::cObject*) override;
 
     virtual void loadRoadSideUnits();
-    virtual void addRoadSideUnit(const std::string& index);
+    virtual void addRoadSideUnits(const std::vector<const RSU*>&);
+    virtual omnetpp::cModule* addRoadSideUnit(const RSU&);
     virtual omnetpp::cModule* createRoadSideUnitModule(const std::string&);
     virtual void scheduleInsertionEvent();
 
+    /**
+     * Deliver traci.init signal to listeners within added RSU modules
+     * \param modules added RSU modules
+     */
+    void fakeInitSignal(const std::vector<omnetpp::cModule*>& modules);
+
 private:
     omnetpp::cMessage* mInsertionEvent;
-    std::multimap<omnetpp::SimTime, std::string> mInsertionQueue;
+    std::multimap<omnetpp::SimTime, std::size_t> mInsertionQueue; /*< indices of mRsus */
     bool mDirectionalAntennas;
     std::string mRsuPrefix;
-    std::map<std::string, RSU> mRsuMap;
+    std::vector<RSU> mRsus;
     omnetpp::cComponent* mInitSource = nullptr;
 };
 
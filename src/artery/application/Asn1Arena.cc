@@ -0,0 +1,99 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/application/Asn1Arena.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace artery
+{
+
+namespace
+{
+
+struct ArenaPool
+{
+    static constexpr std::size_t capacity = 64;
+
+    ~ArenaPool() { destroyed = true; }
+
+    std::vector<std::unique_ptr<Asn1Arena>> arenas;
+    static thread_local bool destroyed;
+};
+
+thread_local bool ArenaPool::destroyed = false;
+
+ArenaPool& pool()
+{
+    static thread_local ArenaPool instance;
+    return instance;
+}
+
+} // namespace
+
+Asn1Arena::Asn1Arena(std::size_t blockSize) : mBlockSize(blockSize)
+{
+}
+
+std::shared_ptr<Asn1Arena> Asn1Arena::acquire()
+{
+    std::unique_ptr<Asn1Arena> arena;
+    if (!ArenaPool::destroyed && !pool().arenas.empty()) {
+        arena = std::move(pool().arenas.back());
+        pool().arenas.pop_back();
+    } else {
+        arena.reset(new Asn1Arena());
+    }
+
+    // messages may be released by another thread or after this thread's pool has vanished
+    return std::shared_ptr<Asn1Arena>(arena.release(), [](Asn1Arena* released) {
+        if (!ArenaPool::destroyed && pool().arenas.size() < ArenaPool::capacity) {
+            released->reset();
+            pool().arenas.emplace_back(released);
+        } else {
+            delete released;
+        }
+    });
+}
+
+void* Asn1Arena::allocate(std::size_t size, std::size_t alignment)
+{
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0 && alignment <= alignof(std::max_align_t));
+    size = std::max<std::size_t>(size, 1);
+
+    while (mCurrent < mBlocks.size()) {
+        Block& block = mBlocks[mCurrent];
+        const std::size_t offset = (mOffset + alignment - 1) & ~(alignment - 1);
+        if (offset <= block.size && size <= block.size - offset) {
+            mOffset = offset + size;
+            void* memory = block.data.get() + offset;
+            std::memset(memory, 0, size);
+            return memory;
+        }
+        ++mCurrent;
+        mOffset = 0;
+    }
+
+    // new blocks are aligned for any type by operator new[]
+    const std::size_t blockSize = std::max(mBlockSize, size);
+    mBlocks.push_back(Block { std::unique_ptr<unsigned char[]>(new unsigned char[blockSize]), blockSize });
+    mCurrent = mBlocks.size() - 1;
+    mOffset = size;
+    std::memset(mBlocks.back().data.get(), 0, size);
+    return mBlocks.back().data.get();
+}
+
+void Asn1Arena::reset()
+{
+    // keep a single block, spare blocks indicate an unusually large message
+    if (mBlocks.size() > 1) {
+        mBlocks.erase(mBlocks.begin() + 1, mBlocks.end());
+    }
+    mCurrent = 0;
+    mOffset = 0;
+}
+
+} // namespace artery
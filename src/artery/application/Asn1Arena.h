@@ -0,0 +1,87 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_ASN1ARENA_H_Q8VDN4ZK
+#define ARTERY_ASN1ARENA_H_Q8VDN4ZK
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace artery
+{
+
+/**
+ * Asn1Arena is a bump allocator for members of asn1c structures built by Artery.
+ *
+ * asn1c frees every member of a structure one by one, hence members taken from an arena have
+ * to be detached from their structure before it is freed by its vanetza::asn1 wrapper.
+ * Messages sharing their arena via shareArenaMessage take care of this on destruction.
+ * Arenas are recycled per thread, i.e. their blocks are allocated only once in steady state.
+ */
+class Asn1Arena
+{
+public:
+    explicit Asn1Arena(std::size_t blockSize = 4096);
+    Asn1Arena(const Asn1Arena&) = delete;
+    Asn1Arena& operator=(const Asn1Arena&) = delete;
+
+    /**
+     * Get an empty arena from this thread's pool, it is reset and returned to the pool once released
+     */
+    static std::shared_ptr<Asn1Arena> acquire();
+
+    /**
+     * Allocate zeroed memory like calloc
+     * \param size number of bytes
+     * \param alignment power of two, at most alignof(std::max_align_t)
+     */
+    void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+    template<typename T>
+    T* allocate(std::size_t count = 1)
+    {
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /**
+     * Release all allocations at once, the first block is kept for reuse
+     */
+    void reset();
+
+private:
+    struct Block
+    {
+        std::unique_ptr<unsigned char[]> data;
+        std::size_t size;
+    };
+
+    std::size_t mBlockSize;
+    std::vector<Block> mBlocks;
+    std::size_t mCurrent = 0; /*< block serving allocations */
+    std::size_t mOffset = 0; /*< next free byte within current block */
+};
+
+/**
+ * Share a message whose members are partially allocated from an arena
+ * \param message asn1c wrapper, e.g. vanetza::asn1::Cam
+ * \param arena arena kept alive along with message
+ * \param detach invoked before message is freed, has to unlink all arena members
+ * \return shared message
+ */
+template<typename T, typename Detach>
+std::shared_ptr<const T> shareArenaMessage(T&& message, std::shared_ptr<Asn1Arena> arena, Detach detach)
+{
+    return std::shared_ptr<const T>(new T(std::move(message)), [arena, detach](const T* shared) {
+        T* message = const_cast<T*>(shared);
+        detach(*message);
+        delete message;
+    });
+}
+
+} // namespace artery
+
+#endif /* ARTERY_ASN1ARENA_H_Q8VDN4ZK */
@@ -0,0 +1,114 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_ASN1DECODECACHE_H_K5MW2RVB
+#define ARTERY_ASN1DECODECACHE_H_K5MW2RVB
+
+#include <boost/functional/hash.hpp>
+#include <vanetza/common/byte_buffer.hpp>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+
+namespace artery
+{
+
+/**
+ * Asn1DecodeCache keeps recently decoded ASN.1 messages by their encoded bytes.
+ *
+ * All receivers of a transmission get identical payload bytes, thus only the first receiver
+ * needs to decode them. Later receivers share the decoded, immutable message. Results of
+ * validation are cached along with the message. The oldest entries are evicted first.
+ */
+template<class T>
+class Asn1DecodeCache
+{
+public:
+    class Entry
+    {
+    public:
+        /**
+         * Get decoded message
+         * \return decoded message or nullptr if decoding failed
+         */
+        const std::shared_ptr<const T>& wrapper() const { return mWrapper; }
+
+        /**
+         * Validate decoded message against its constraints, result is computed only once
+         */
+        bool validate() const
+        {
+            if (!mValidated) {
+                mValid = mWrapper && mWrapper->validate();
+                mValidated = true;
+            }
+            return mValid;
+        }
+
+    private:
+        friend class Asn1DecodeCache;
+        std::shared_ptr<const T> mWrapper;
+        mutable bool mValidated = false;
+        mutable bool mValid = false;
+    };
+
+    /**
+     * Get cache shared by all users of a message type
+     */
+    static Asn1DecodeCache& instance()
+    {
+        static Asn1DecodeCache cache { 1024 };
+        return cache;
+    }
+
+    explicit Asn1DecodeCache(std::size_t capacity) : mCapacity(capacity) {}
+
+    /**
+     * Decode buffer unless bytes have been decoded recently
+     * \param buffer encoded message
+     * \return cache entry (never nullptr)
+     */
+    std::shared_ptr<const Entry> decode(const vanetza::ByteBuffer& buffer)
+    {
+        auto found = mEntries.find(buffer);
+        if (found != mEntries.end()) {
+            return found->second;
+        }
+
+        auto entry = std::make_shared<Entry>();
+        auto wrapper = std::make_shared<T>();
+        if (wrapper->decode(buffer)) {
+            entry->mWrapper = std::move(wrapper);
+        }
+
+        if (mCapacity > 0) {
+            if (mEntries.size() >= mCapacity) {
+                mEntries.erase(mInsertions.front());
+                mInsertions.pop_front();
+            }
+            mEntries.emplace(buffer, entry);
+            mInsertions.push_back(buffer);
+        }
+        return entry;
+    }
+
+private:
+    struct BufferHash
+    {
+        std::size_t operator()(const vanetza::ByteBuffer& buffer) const
+        {
+            return boost::hash_range(buffer.begin(), buffer.end());
+        }
+    };
+
+    std::size_t mCapacity;
+    std::unordered_map<vanetza::ByteBuffer, std::shared_ptr<const Entry>, BufferHash> mEntries;
+    std::deque<vanetza::ByteBuffer> mInsertions; /*< keys in insertion order */
+};
+
+} // namespace artery
+
+#endif /* ARTERY_ASN1DECODECACHE_H_K5MW2RVB */
@@ -16,6 +16,7 @@
 #ifndef __ARTERY_ASN1PACKETVISITOR_H_
 #define __ARTERY_ASN1PACKETVISITOR_H_
 
+#include "artery/application/Asn1DecodeCache.h"
 #include <vanetza/common/byte_buffer.hpp>
 #include <vanetza/common/byte_buffer_convertible.hpp>
 #include <vanetza/net/chunk_packet.hpp>
@@ -32,6 +33,14 @@ namespace artery
 template<class T>
 struct Asn1PacketVisitor : public boost::static_visitor<const T*>
 {
+    Asn1PacketVisitor() = default;
+
+    /**
+     * Visitor sharing decoded byte payloads through cache
+     * \param cache decode cache of message type
+     */
+    explicit Asn1PacketVisitor(Asn1DecodeCache<T>& cache) : decode_cache(&cache) {}
+
     const T* operator()(vanetza::CohesivePacket& packet)
     {
         const auto range = packet[vanetza::OsiLayer::Application];
@@ -60,6 +69,17 @@ struct Asn1PacketVisitor : public boost::static_visitor<const T*>
 
     void deserialize(const vanetza::ByteBuffer& buffer)
     {
+        if (decode_cache) {
+            decoded_entry = decode_cache->decode(buffer);
+            shared_wrapper = decoded_entry->wrapper();
+            if (!shared_wrapper) {
+                using namespace omnetpp;
+                const std::type_info& asn1_type = typeid(T);
+                EV_ERROR << "Decoding of " << asn1_type.name() << " failed";
+            }
+            return;
+        }
+
         auto temp_wrapper = std::make_shared<T>();
         bool decoded = temp_wrapper->decode(buffer);
         if (decoded) {
@@ -71,7 +91,21 @@ struct Asn1PacketVisitor : public boost::static_visitor<const T*>
         }
     }
 
+    /**
+     * Validate visited message, using cached result of decode cache if available
+     */
+    bool validate() const
+    {
+        if (decoded_entry && decoded_entry->wrapper() == shared_wrapper) {
+            return decoded_entry->validate();
+        } else {
+            return shared_wrapper && shared_wrapper->validate();
+        }
+    }
+
     std::shared_ptr<const T> shared_wrapper;
+    Asn1DecodeCache<T>* decode_cache = nullptr;
+    std::shared_ptr<const typename Asn1DecodeCache<T>::Entry> decoded_entry;
 };
 
 } // namespace artery
@@ -4,8 +4,10 @@
 * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
 */
 
+#include "artery/application/Asn1Arena.h"
 #include "artery/application/CaObject.h"
 #include "artery/application/CaService.h"
+#include "artery/application/CamReceptionLog.h"
 #include "artery/application/Asn1PacketVisitor.h"
 #include "artery/application/MultiChannelPolicy.h"
 #include "artery/application/VehicleDataProvider.h"
@@ -18,7 +20,10 @@
 #include <vanetza/dcc/transmission.hpp>
 #include <vanetza/dcc/transmit_rate_control.hpp>
 #include <vanetza/facilities/cam_functions.hpp>
+#include <cassert>
 #include <chrono>
+#include <cmath>
+#include <string>
 
 namespace artery
 {
@@ -93,6 +98,35 @@ void CaService::initialize()
 
 	mDccRestriction = par("withDccRestriction");
 	mFixedRate = par("fixedRate");
+	mEventDriven = par("eventDriven");
+	mValidateMessages = par("validateMessages");
+
+	const std::string receptionValidation = par("receptionValidation").stdstringValue();
+	if (receptionValidation == "always") {
+		mReceptionValidation = ReceptionValidation::Always;
+	} else if (receptionValidation == "sender") {
+		mReceptionValidation = ReceptionValidation::Sender;
+	} else if (receptionValidation == "sampling") {
+		mReceptionValidation = ReceptionValidation::Sampling;
+		const int interval = par("receptionValidationInterval");
+		if (interval < 1) {
+			throw cRuntimeError("receptionValidationInterval has to be positive (given: %d)", interval);
+		}
+		mReceptionValidationInterval = interval;
+		mReceptionsSinceValidation = 0;
+	} else {
+		throw cRuntimeError("unknown reception validation policy \"%s\"", receptionValidation.c_str());
+	}
+
+	// path history of concise points
+	mWithPathHistory = par("withPathHistory");
+	mPathHistoryArena = par("pathHistoryArena");
+	if (mWithPathHistory) {
+		mPathHistory.setChordError(par("pathHistoryChordError").doubleValue() * vanetza::units::si::meter);
+		mPathHistory.feed(*mVehicleDataProvider);
+	}
+
+	mReceptionLog = dynamic_cast<CamReceptionLog*>(getModuleByPath(par("camReceptionLogModule")));
 
 	// look up primary channel for CA
 	mPrimaryChannel = getFacilities().get_const<MultiChannelPolicy>().primaryChannel(vanetza::aid::CA);
@@ -100,20 +134,63 @@ void CaService::initialize()
 
 void CaService::trigger()
 {
+	const SimTime now = simTime();
+	if (mWithPathHistory) {
+		mPathHistory.feed(*mVehicleDataProvider);
+	}
+	if (mEventDriven && isIdle(now)) {
+		return;
+	}
+
 	Enter_Method("trigger");
-	checkTriggeringConditions(simTime());
+	checkTriggeringConditions(now);
+}
+
+bool CaService::isIdle(const SimTime& T_now) const
+{
+	if (T_now < mLastCamTimestamp + mGenCamMin) {
+		// T_GenCamDcc is never shorter than T_GenCamMin
+		return true;
+	} else if (!mFixedRate && mDynamicsChecked && mDynamicsUpdate == mVehicleDataProvider->updated()) {
+		// vehicle dynamics are unchanged since their last check, only T_GenCam may trigger
+		return T_now - mLastCamTimestamp < mGenCam;
+	} else {
+		return false;
+	}
 }
 
 void CaService::indicate(const vanetza::btp::DataIndication& ind, std::unique_ptr<vanetza::UpPacket> packet)
 {
 	Enter_Method("indicate");
 
-	Asn1PacketVisitor<vanetza::asn1::Cam> visitor;
+	Asn1PacketVisitor<vanetza::asn1::Cam> visitor { Asn1DecodeCache<vanetza::asn1::Cam>::instance() };
 	const vanetza::asn1::Cam* cam = boost::apply_visitor(visitor, *packet);
-	if (cam && cam->validate()) {
+	if (cam && (!isReceptionValidated() || visitor.validate())) {
 		CaObject obj = visitor.shared_wrapper;
 		emit(scSignalCamReceived, &obj);
 		mLocalDynamicMap->updateAwareness(obj);
+		if (mReceptionLog) {
+			// RSSI is not available at facilities layer
+			mReceptionLog->record((*cam)->header.stationID, mVehicleDataProvider->station_id(),
+					(*cam)->cam.generationDeltaTime, boost::none);
+		}
+	}
+}
+
+bool CaService::isReceptionValidated()
+{
+	switch (mReceptionValidation) {
+		case ReceptionValidation::Sender:
+			// every CAM in simulation stems from Artery's own encoder
+			return false;
+		case ReceptionValidation::Sampling:
+			if (++mReceptionsSinceValidation >= mReceptionValidationInterval) {
+				mReceptionsSinceValidation = 0;
+				return true;
+			}
+			return false;
+		default:
+			return true;
 	}
 }
 
@@ -138,6 +215,9 @@ void CaService::checkTriggeringConditions(const SimTime& T_now)
 			if (++mGenCamLowDynamicsCounter >= mGenCamLowDynamicsLimit) {
 				T_GenCam = T_GenCamMax;
 			}
+		} else {
+			mDynamicsChecked = true;
+			mDynamicsUpdate = mVehicleDataProvider->updated();
 		}
 	}
 }
@@ -160,17 +240,32 @@ bool CaService::checkSpeedDelta() const
 void CaService::sendCam(const SimTime& T_now)
 {
 	uint16_t genDeltaTimeMod = countTaiMilliseconds(mTimer->getTimeFor(mVehicleDataProvider->updated()));
-	auto cam = createCooperativeAwarenessMessage(*mVehicleDataProvider, genDeltaTimeMod);
+	auto cam = createCooperativeAwarenessMessage(*mVehicleDataProvider, genDeltaTimeMod, false);
 
 	mLastCamPosition = mVehicleDataProvider->position();
 	mLastCamSpeed = mVehicleDataProvider->speed();
 	mLastCamHeading = mVehicleDataProvider->heading();
 	mLastCamTimestamp = T_now;
+	mDynamicsChecked = false;
+	std::shared_ptr<Asn1Arena> arena;
 	if (T_now - mLastLowCamTimestamp >= artery::simtime_cast(scLowFrequencyContainerInterval)) {
-		addLowFrequencyContainer(cam, par("pathHistoryLength"));
+		if (mPathHistoryArena) {
+			arena = Asn1Arena::acquire();
+		}
+		if (mWithPathHistory) {
+			addLowFrequencyContainer(cam, *mVehicleDataProvider, mPathHistory, par("pathHistoryLength"), false, arena.get());
+		} else {
+			addLowFrequencyContainer(cam, par("pathHistoryLength"), false, arena.get());
+		}
 		mLastLowCamTimestamp = T_now;
 	}
 
+	// validate complete message once instead of each container
+	std::string error;
+	if (mValidateMessages && !cam.validate(error)) {
+		throw cRuntimeError("Invalid CAM: %s", error.c_str());
+	}
+
 	using namespace vanetza;
 	btp::DataRequestB request;
 	request.destination_port = btp::ports::CAM;
@@ -180,7 +275,8 @@ void CaService::sendCam(const SimTime& T_now)
 	request.gn.traffic_class.tc_id(static_cast<unsigned>(dcc::Profile::DP2));
 	request.gn.communication_profile = geonet::CommunicationProfile::ITS_G5;
 
-	CaObject obj(std::move(cam));
+	// path points stay in arena until the last reference to this CAM is released, e.g. by receivers' LDM
+	CaObject obj = arena ? CaObject(shareArenaMessage(std::move(cam), arena, detachPathHistory)) : CaObject(std::move(cam));
 	emit(scSignalCamSent, &obj);
 
 	using CamByteBuffer = convertible::byte_buffer_impl<asn1::Cam>;
@@ -205,7 +301,7 @@ SimTime CaService::genCamDcc()
 	return std::min(mGenCamMax, std::max(mGenCamMin, dcc));
 }
 
-vanetza::asn1::Cam createCooperativeAwarenessMessage(const VehicleDataProvider& vdp, uint16_t genDeltaTime)
+vanetza::asn1::Cam createCooperativeAwarenessMessage(const VehicleDataProvider& vdp, uint16_t genDeltaTime, bool validate)
 {
 	vanetza::asn1::Cam message;
 
@@ -262,20 +358,18 @@ vanetza::asn1::Cam createCooperativeAwarenessMessage(const VehicleDataProvider&
 	bvc.vehicleWidth = VehicleWidth_unavailable;
 
 	std::string error;
-	if (!message.validate(error)) {
+	if (validate && !message.validate(error)) {
 		throw cRuntimeError("Invalid High Frequency CAM: %s", error.c_str());
 	}
 
 	return message;
 }
 
-void addLowFrequencyContainer(vanetza::asn1::Cam& message, unsigned pathHistoryLength)
+namespace
 {
-	if (pathHistoryLength > 40) {
-		EV_WARN << "path history can contain 40 elements at maximum";
-		pathHistoryLength = 40;
-	}
 
+BasicVehicleContainerLowFrequency& allocateLowFrequencyContainer(vanetza::asn1::Cam& message)
+{
 	LowFrequencyContainer_t*& lfc = message->cam.camParameters.lowFrequencyContainer;
 	lfc = vanetza::asn1::allocate<LowFrequencyContainer_t>();
 	lfc->present = LowFrequencyContainer_PR_basicVehicleContainerLowFrequency;
@@ -285,21 +379,123 @@ void addLowFrequencyContainer(vanetza::asn1::Cam& message, unsigned pathHistoryL
 	assert(nullptr != bvc.exteriorLights.buf);
 	bvc.exteriorLights.size = 1;
 	bvc.exteriorLights.buf[0] |= 1 << (7 - ExteriorLights_daytimeRunningLightsOn);
+	return bvc;
+}
 
-	for (unsigned i = 0; i < pathHistoryLength; ++i) {
-		PathPoint* pathPoint = vanetza::asn1::allocate<PathPoint>();
+PathPoint* addPathPoint(BasicVehicleContainerLowFrequency& bvc, unsigned capacity, Asn1Arena* arena)
+{
+	PathPoint* pathPoint = nullptr;
+	if (arena) {
+		// all path points share one array sized up-front, no reallocation on growth
+		auto& list = bvc.pathHistory.list;
+		if (!list.array) {
+			list.array = arena->allocate<PathPoint*>(capacity);
+			list.size = capacity;
+		}
+		assert(list.count < list.size);
+		pathPoint = arena->allocate<PathPoint>();
+		pathPoint->pathDeltaTime = arena->allocate<PathDeltaTime_t>();
+		list.array[list.count++] = pathPoint;
+	} else {
+		pathPoint = vanetza::asn1::allocate<PathPoint>();
 		pathPoint->pathDeltaTime = vanetza::asn1::allocate<PathDeltaTime_t>();
-		*(pathPoint->pathDeltaTime) = (i + 1) * PathDeltaTime_tenMilliSecondsInPast * 10;
-		pathPoint->pathPosition.deltaLatitude = DeltaLatitude_unavailable;
-		pathPoint->pathPosition.deltaLongitude = DeltaLongitude_unavailable;
-		pathPoint->pathPosition.deltaAltitude = DeltaAltitude_unavailable;
 		ASN_SEQUENCE_ADD(&bvc.pathHistory, pathPoint);
 	}
+	return pathPoint;
+}
 
+void validateLowFrequencyContainer(const vanetza::asn1::Cam& message)
+{
 	std::string error;
 	if (!message.validate(error)) {
 		throw cRuntimeError("Invalid Low Frequency CAM: %s", error.c_str());
 	}
 }
 
+} // namespace
+
+void addLowFrequencyContainer(vanetza::asn1::Cam& message, unsigned pathHistoryLength, bool validate, Asn1Arena* arena)
+{
+	if (pathHistoryLength > 40) {
+		EV_WARN << "path history can contain 40 elements at maximum";
+		pathHistoryLength = 40;
+	}
+
+	BasicVehicleContainerLowFrequency& bvc = allocateLowFrequencyContainer(message);
+	for (unsigned i = 0; i < pathHistoryLength; ++i) {
+		PathPoint* pathPoint = addPathPoint(bvc, pathHistoryLength, arena);
+		*(pathPoint->pathDeltaTime) = (i + 1) * PathDeltaTime_tenMilliSecondsInPast * 10;
+		pathPoint->pathPosition.deltaLatitude = DeltaLatitude_unavailable;
+		pathPoint->pathPosition.deltaLongitude = DeltaLongitude_unavailable;
+		pathPoint->pathPosition.deltaAltitude = DeltaAltitude_unavailable;
+	}
+
+	if (validate) {
+		validateLowFrequencyContainer(message);
+	}
+}
+
+void addLowFrequencyContainer(vanetza::asn1::Cam& message, const VehicleDataProvider& vdp,
+		const PathHistory& history, unsigned pathHistoryLength, bool validate, Asn1Arena* arena)
+{
+	if (pathHistoryLength > 40) {
+		EV_WARN << "path history can contain 40 elements at maximum";
+		pathHistoryLength = 40;
+	}
+
+	BasicVehicleContainerLowFrequency& bvc = allocateLowFrequencyContainer(message);
+
+	// each path point is given relative to its predecessor, the first one relative to reference position
+	GeoPosition previousPosition;
+	previousPosition.latitude = vdp.latitude();
+	previousPosition.longitude = vdp.longitude();
+	SimTime previousTime = vdp.updated();
+	unsigned points = 0;
+
+	for (const auto& sample : history.points()) {
+		if (points >= pathHistoryLength) {
+			break;
+		} else if (sample.timestamp >= previousTime) {
+			continue;
+		}
+
+		const double deltaLat = (sample.value.geo_position.latitude - previousPosition.latitude) / vanetza::units::degree;
+		const double deltaLon = (sample.value.geo_position.longitude - previousPosition.longitude) / vanetza::units::degree;
+		const long deltaTime = std::lround((previousTime - sample.timestamp).dbl() * 100.0) * PathDeltaTime_tenMilliSecondsInPast;
+		const long deltaLatValue = std::lround(deltaLat * 1e6 * DeltaLatitude_oneMicrodegreeNorth);
+		const long deltaLonValue = std::lround(deltaLon * 1e6 * DeltaLongitude_oneMicrodegreeEast);
+		if (deltaTime < 1 || deltaTime > 65535 ||
+				deltaLatValue < -131071 || deltaLatValue > 131071 ||
+				deltaLonValue < -131071 || deltaLonValue > 131071) {
+			// path points beyond this one cannot be represented
+			break;
+		}
+
+		PathPoint* pathPoint = addPathPoint(bvc, pathHistoryLength, arena);
+		*(pathPoint->pathDeltaTime) = deltaTime;
+		pathPoint->pathPosition.deltaLatitude = deltaLatValue;
+		pathPoint->pathPosition.deltaLongitude = deltaLonValue;
+		pathPoint->pathPosition.deltaAltitude = DeltaAltitude_unavailable;
+
+		previousPosition = sample.value.geo_position;
+		previousTime = sample.timestamp;
+		++points;
+	}
+
+	if (validate) {
+		validateLowFrequencyContainer(message);
+	}
+}
+
+void detachPathHistory(vanetza::asn1::Cam& message)
+{
+	LowFrequencyContainer_t* lfc = message->cam.camParameters.lowFrequencyContainer;
+	if (lfc && lfc->present == LowFrequencyContainer_PR_basicVehicleContainerLowFrequency) {
+		auto& list = lfc->choice.basicVehicleContainerLowFrequency.pathHistory.list;
+		list.array = nullptr;
+		list.count = 0;
+		list.size = 0;
+	}
+}
+
 } // namespace artery
@@ -8,6 +8,7 @@
 #define ARTERY_CASERVICE_H_
 
 #include "artery/application/ItsG5BaseService.h"
+#include "artery/application/PathHistory.h"
 #include "artery/utility/Channel.h"
 #include "artery/utility/Geometry.h"
 #include <vanetza/asn1/cam.hpp>
@@ -19,6 +20,8 @@
 namespace artery
 {
 
+class Asn1Arena;
+class CamReceptionLog;
 class NetworkInterfaceTable;
 class Timer;
 class VehicleDataProvider;
@@ -30,20 +33,26 @@ class CaService : public ItsG5BaseService
 		void initialize() override;
 		void indicate(const vanetza::btp::DataIndication&, std::unique_ptr<vanetza::UpPacket>) override;
 		void trigger() override;
+		bool requiresTrigger() const override { return true; }
 
 	private:
 		void checkTriggeringConditions(const omnetpp::SimTime&);
+		bool isIdle(const omnetpp::SimTime&) const;
 		bool checkHeadingDelta() const;
 		bool checkPositionDelta() const;
 		bool checkSpeedDelta() const;
 		void sendCam(const omnetpp::SimTime&);
 		omnetpp::SimTime genCamDcc();
+		bool isReceptionValidated();
+
+		enum class ReceptionValidation { Always, Sender, Sampling };
 
 		ChannelNumber mPrimaryChannel = channel::CCH;
 		const NetworkInterfaceTable* mNetworkInterfaceTable = nullptr;
 		const VehicleDataProvider* mVehicleDataProvider = nullptr;
 		const Timer* mTimer = nullptr;
 		LocalDynamicMap* mLocalDynamicMap = nullptr;
+		CamReceptionLog* mReceptionLog = nullptr;
 
 		omnetpp::SimTime mGenCamMin;
 		omnetpp::SimTime mGenCamMax;
@@ -60,10 +69,35 @@ class CaService : public ItsG5BaseService
 		vanetza::units::Velocity mSpeedDelta;
 		bool mDccRestriction;
 		bool mFixedRate;
+		bool mEventDriven;
+		bool mValidateMessages;
+		ReceptionValidation mReceptionValidation = ReceptionValidation::Always;
+		unsigned mReceptionValidationInterval = 1;
+		unsigned mReceptionsSinceValidation = 0;
+		bool mWithPathHistory;
+		bool mPathHistoryArena;
+		PathHistory mPathHistory;
+		bool mDynamicsChecked = false; /*< dynamics deltas have been checked without triggering */
+		omnetpp::SimTime mDynamicsUpdate; /*< vehicle data timestamp at last dynamics check */
 };
 
-vanetza::asn1::Cam createCooperativeAwarenessMessage(const VehicleDataProvider&, uint16_t genDeltaTime);
-void addLowFrequencyContainer(vanetza::asn1::Cam&, unsigned pathHistoryLength = 0);
+vanetza::asn1::Cam createCooperativeAwarenessMessage(const VehicleDataProvider&, uint16_t genDeltaTime, bool validate = true);
+
+/**
+ * Add low frequency container with path history
+ *
+ * Path points are taken from arena if given, such a message has to be released
+ * after detachPathHistory, e.g. by shareArenaMessage.
+ */
+void addLowFrequencyContainer(vanetza::asn1::Cam&, unsigned pathHistoryLength = 0, bool validate = true,
+		Asn1Arena* arena = nullptr);
+void addLowFrequencyContainer(vanetza::asn1::Cam&, const VehicleDataProvider&, const PathHistory&,
+		unsigned pathHistoryLength, bool validate = true, Asn1Arena* arena = nullptr);
+
+/**
+ * Unlink path points allocated from an arena, asn1c would free them one by one otherwise
+ */
+void detachPathHistory(vanetza::asn1::Cam&);
 
 } // namespace artery
 
@@ -0,0 +1,125 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/application/CamReceptionLog.h"
+#include <omnetpp/cconfiguration.h>
+#include <cmath>
+#include <filesystem>
+#include <system_error>
+
+namespace artery
+{
+
+Define_Module(CamReceptionLog)
+
+using namespace omnetpp;
+
+namespace
+{
+    const char sLogMagic[8] = { 'A', 'R', 'T', 'C', 'A', 'M', 'R', 'X' };
+    const std::uint32_t sLogVersion = 2;
+
+    template<typename T>
+    void writeRaw(std::ostream& os, const T& value)
+    {
+        os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    void writeColumn(std::ostream& os, const std::vector<T>& column)
+    {
+        os.write(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(T));
+    }
+}
+
+void CamReceptionLog::initialize()
+{
+    std::string file = par("outputFile").stdstringValue();
+    if (file.empty()) {
+        auto cfg = getEnvir()->getConfigEx();
+        file = cfg->getVariable(CFGVAR_RESULTDIR) + std::string("/") + cfg->getVariable(CFGVAR_CONFIGNAME) +
+            "-" + cfg->getVariable(CFGVAR_RUNNUMBER) + ".camrx";
+    }
+
+    // result directory is not created by OMNeT++ before the first result is recorded
+    const std::filesystem::path path { file };
+    std::error_code ec;
+    if (path.has_parent_path() && !std::filesystem::create_directories(path.parent_path(), ec) && ec) {
+        throw cRuntimeError("cannot create directory for CAM reception log %s: %s", file.c_str(), ec.message().c_str());
+    }
+
+    mOutput.open(file, std::ios::binary | std::ios::trunc);
+    if (!mOutput) {
+        throw cRuntimeError("cannot open CAM reception log %s", file.c_str());
+    }
+    mOutput.write(sLogMagic, sizeof(sLogMagic));
+    writeRaw(mOutput, sLogVersion);
+
+    mBlockSize = par("blockSize");
+    if (mBlockSize == 0) {
+        throw cRuntimeError("blockSize of CAM reception log must be positive");
+    }
+    mTransmitters.reserve(mBlockSize);
+    mReceivers.reserve(mBlockSize);
+    mGenerationDeltaTimes.reserve(mBlockSize);
+    mReceptionTimes.reserve(mBlockSize);
+    mRssiAvailable.reserve(mBlockSize);
+    mRssi.reserve(mBlockSize);
+}
+
+void CamReceptionLog::handleMessage(cMessage*)
+{
+    throw cRuntimeError("CamReceptionLog does not handle any messages");
+}
+
+void CamReceptionLog::finish()
+{
+    writeBlock();
+    mOutput.close();
+}
+
+void CamReceptionLog::record(std::uint32_t tx, std::uint32_t rx, std::uint16_t generationDeltaTime, boost::optional<double> rssi)
+{
+    Enter_Method_Silent();
+    mTransmitters.push_back(tx);
+    mReceivers.push_back(rx);
+    mGenerationDeltaTimes.push_back(generationDeltaTime);
+    mReceptionTimes.push_back(simTime().dbl());
+    // NaN is not a meaningful signal strength, store it as unknown as well
+    const bool available = rssi && !std::isnan(*rssi);
+    mRssiAvailable.push_back(available ? 1 : 0);
+    mRssi.push_back(available ? *rssi : 0.0);
+
+    if (mTransmitters.size() >= mBlockSize) {
+        writeBlock();
+    }
+}
+
+void CamReceptionLog::writeBlock()
+{
+    if (mTransmitters.empty() || !mOutput.is_open()) {
+        return;
+    }
+
+    writeRaw(mOutput, static_cast<std::uint32_t>(mTransmitters.size()));
+    writeColumn(mOutput, mTransmitters);
+    writeColumn(mOutput, mReceivers);
+    writeColumn(mOutput, mGenerationDeltaTimes);
+    writeColumn(mOutput, mReceptionTimes);
+    writeColumn(mOutput, mRssiAvailable);
+    writeColumn(mOutput, mRssi);
+    if (!mOutput) {
+        throw cRuntimeError("writing CAM reception log failed");
+    }
+
+    mTransmitters.clear();
+    mReceivers.clear();
+    mGenerationDeltaTimes.clear();
+    mReceptionTimes.clear();
+    mRssiAvailable.clear();
+    mRssi.clear();
+}
+
+} // namespace artery
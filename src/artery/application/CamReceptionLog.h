@@ -0,0 +1,66 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_CAMRECEPTIONLOG_H_J6RZ2DKF
+#define ARTERY_CAMRECEPTIONLOG_H_J6RZ2DKF
+
+#include <omnetpp/csimplemodule.h>
+#include <omnetpp/simtime.h>
+#include <boost/optional/optional.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace artery
+{
+
+/**
+ * CamReceptionLog records CAM receptions of all stations in a simulation-wide table.
+ *
+ * Receptions are appended to columns in memory and written as blocks of a binary file whenever
+ * the block size is reached and at the end of the simulation. The file starts with the magic
+ * "ARTCAMRX" and a uint32 format version. Each block consists of a uint32 row count followed by
+ * its columns, each stored contiguously in native byte order:
+ *  - transmitting station ID (uint32)
+ *  - receiving station ID (uint32)
+ *  - CAM generation delta time (uint16)
+ *  - reception time in seconds (double)
+ *  - RSSI availability (uint8, 1 if known and 0 otherwise)
+ *  - RSSI in dBm (double, 0 if unknown)
+ */
+class CamReceptionLog : public omnetpp::cSimpleModule
+{
+public:
+    void initialize() override;
+    void handleMessage(omnetpp::cMessage*) override;
+    void finish() override;
+
+    /**
+     * Record reception of a CAM
+     * \param tx station ID of CAM originator
+     * \param rx station ID of receiver
+     * \param generationDeltaTime generation delta time of received CAM
+     * \param rssi received signal strength in dBm if available
+     */
+    void record(std::uint32_t tx, std::uint32_t rx, std::uint16_t generationDeltaTime, boost::optional<double> rssi);
+
+private:
+    void writeBlock();
+
+    std::ofstream mOutput;
+    std::size_t mBlockSize = 0;
+    std::vector<std::uint32_t> mTransmitters;
+    std::vector<std::uint32_t> mReceivers;
+    std::vector<std::uint16_t> mGenerationDeltaTimes;
+    std::vector<double> mReceptionTimes;
+    std::vector<std::uint8_t> mRssiAvailable;
+    std::vector<double> mRssi;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_CAMRECEPTIONLOG_H_J6RZ2DKF */
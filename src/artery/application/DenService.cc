@@ -11,11 +11,14 @@
 #include "artery/application/StoryboardSignal.h"
 #include "artery/application/VehicleDataProvider.h"
 #include "artery/utility/FilterRules.h"
+#include "artery/utility/XmlConfigCache.h"
 #include <omnetpp/checkandcast.h>
 #include <omnetpp/ccomponenttype.h>
 #include <omnetpp/cxmlelement.h>
 #include <vanetza/asn1/denm.hpp>
 #include <vanetza/btp/ports.hpp>
+#include <string>
+#include <vector>
 
 using namespace omnetpp;
 
@@ -28,16 +31,95 @@ static const simsignal_t denmReceivedSignal = cComponent::registerSignal("DenmRe
 static const simsignal_t denmSentSignal = cComponent::registerSignal("DenmSent");
 static const simsignal_t storyboardSignal = cComponent::registerSignal("StoryboardSignal");
 
+namespace
+{
+
+/**
+ * Use case configuration compiled from XML once for all DEN services
+ */
+struct UseCasePlan
+{
+    cModuleType* type;
+    std::string name;
+    FilterPlan filters;
+};
+
+std::vector<UseCasePlan> compileUseCasePlans(const cXMLElement& config)
+{
+    std::vector<UseCasePlan> plans;
+    for (cXMLElement* useCaseElement : config.getChildrenByTagName("usecase")) {
+        UseCasePlan plan;
+        plan.type = cModuleType::get(useCaseElement->getAttribute("type"));
+        plan.name = useCaseElement->getAttribute("name") ? useCaseElement->getAttribute("name") : plan.type->getName();
+        cXMLElement* filter = useCaseElement->getFirstChildWithTag("filters");
+        if (filter) {
+            plan.filters = FilterPlan { *filter };
+        }
+        plans.push_back(std::move(plan));
+    }
+    return plans;
+}
+
+XmlConfigCache<std::vector<UseCasePlan>> useCasePlanCache;
+
+using DenmConvertible = vanetza::convertible::byte_buffer_impl<vanetza::asn1::Denm>;
+
+/**
+ * DENM payload encoded once for all its repetitions
+ *
+ * Receivers still get the shared DENM object without decoding it.
+ */
+class EncodedDenm : public DenmConvertible
+{
+public:
+    explicit EncodedDenm(std::shared_ptr<const vanetza::asn1::Denm> denm) :
+        EncodedDenm(denm, std::make_shared<const vanetza::ByteBuffer>(denm->encode()))
+    {
+    }
+
+    EncodedDenm(std::shared_ptr<const vanetza::asn1::Denm> denm, std::shared_ptr<const vanetza::ByteBuffer> encoded) :
+        DenmConvertible(std::move(denm)), mEncoded(std::move(encoded))
+    {
+    }
+
+    void convert(vanetza::ByteBuffer& buffer) const override
+    {
+        buffer = *mEncoded;
+    }
+
+    std::size_t size() const override
+    {
+        return mEncoded->size();
+    }
+
+    std::unique_ptr<vanetza::convertible::byte_buffer> duplicate() const override
+    {
+        return std::unique_ptr<vanetza::convertible::byte_buffer> { new EncodedDenm(wrapper(), mEncoded) };
+    }
+
+private:
+    std::shared_ptr<const vanetza::ByteBuffer> mEncoded;
+};
+
+} // namespace
+
 DenService::DenService() :
     mTimer(nullptr), mSequenceNumber(0)
 {
 }
 
+DenService::~DenService()
+{
+    cancelAndDelete(mRepetitionTimer);
+}
+
 void DenService::initialize()
 {
     ItsG5BaseService::initialize();
     mTimer = &getFacilities().get_const<Timer>();
     mMemory.reset(new artery::den::Memory(*mTimer));
+    mSharedRepetitions = par("sharedRepetitions");
+    mRepetitionTimer = new cMessage("DENM repetition");
 
     subscribe(storyboardSignal);
     initUseCases();
@@ -46,20 +128,10 @@ void DenService::initialize()
 void DenService::initUseCases()
 {
     omnetpp::cXMLElement* useCases = par("useCases").xmlValue();
-    for (omnetpp::cXMLElement* useCaseElement : useCases->getChildrenByTagName("usecase")) {
-        omnetpp::cModuleType* useCaseType = omnetpp::cModuleType::get(useCaseElement->getAttribute("type"));
-        omnetpp::cXMLElement* filter = useCaseElement->getFirstChildWithTag("filters");
-
-        bool useCaseApplicable = true;
-        if (filter) {
-            artery::FilterRules rules(getRNG(0), getFacilities().get_const<artery::Identity>());
-            useCaseApplicable = rules.applyFilterConfig(*filter);
-        }
-
-        if (useCaseApplicable) {
-            const char* useCaseName = useCaseElement->getAttribute("name") ?
-                useCaseElement->getAttribute("name") : useCaseType->getName();
-            omnetpp::cModule* module = useCaseType->create(useCaseName, this);
+    const auto& plans = useCasePlanCache.get(useCases, compileUseCasePlans);
+    for (const UseCasePlan& plan : plans) {
+        if (plan.filters.apply(getRNG(0), getFacilities().get_const<artery::Identity>())) {
+            omnetpp::cModule* module = plan.type->create(plan.name.c_str(), this);
             // do not call initialize here! omnetpp::cModule initializes submodules on its own!
             module->buildInside();
             den::UseCase* useCase = dynamic_cast<den::UseCase*>(module);
@@ -70,6 +142,15 @@ void DenService::initUseCases()
     }
 }
 
+void DenService::handleMessage(cMessage* msg)
+{
+    if (msg == mRepetitionTimer) {
+        repeat();
+    } else {
+        ItsG5BaseService::handleMessage(msg);
+    }
+}
+
 void DenService::receiveSignal(cComponent*, simsignal_t signal, cObject* obj, cObject*)
 {
     if (signal == storyboardSignal) {
@@ -82,7 +163,7 @@ void DenService::receiveSignal(cComponent*, simsignal_t signal, cObject* obj, cO
 
 void DenService::indicate(const vanetza::btp::DataIndication& indication, std::unique_ptr<vanetza::UpPacket> packet)
 {
-    Asn1PacketVisitor<vanetza::asn1::Denm> visitor;
+    Asn1PacketVisitor<vanetza::asn1::Denm> visitor { Asn1DecodeCache<vanetza::asn1::Denm>::instance() };
     const vanetza::asn1::Denm* denm = boost::apply_visitor(visitor, *packet);
     const auto egoStationID = getFacilities().get_const<VehicleDataProvider>().station_id();
 
@@ -102,7 +183,10 @@ void DenService::trigger()
     mMemory->drop();
 
     for (auto use_case : mUseCases) {
-        use_case->check();
+        use_case->sample();
+        if (use_case->isCheckDue()) {
+            use_case->check();
+        }
     }
 }
 
@@ -130,14 +214,61 @@ void DenService::sendDenm(vanetza::asn1::Denm&& message, vanetza::btp::DataReque
     DenmObject obj { std::move(message) };
     emit(denmSentSignal, &obj);
 
+    if (mSharedRepetitions && request.gn.repetition) {
+        // repeat by service instead of GeoNetworking router, which stores and re-encodes a packet copy per DENM
+        Repetition repetition;
+        repetition.interval = SimTime { request.gn.repetition->interval / vanetza::units::si::seconds };
+        repetition.remaining = SimTime { request.gn.repetition->maximum / vanetza::units::si::seconds } - repetition.interval;
+        request.gn.repetition = boost::none;
+        repetition.request = request;
+        repetition.payload = std::make_shared<const EncodedDenm>(obj.shared_ptr());
+        transmit(repetition.request, *repetition.payload);
+        if (repetition.interval > SIMTIME_ZERO && repetition.remaining >= SIMTIME_ZERO) {
+            mRepetitions.emplace(simTime() + repetition.interval, std::move(repetition));
+            scheduleRepetition();
+        }
+    } else {
+        transmit(request, DenmConvertible { obj.shared_ptr() });
+    }
+}
+
+void DenService::transmit(const vanetza::btp::DataRequestB& request, const vanetza::convertible::byte_buffer& denm)
+{
     using namespace vanetza;
-    using DenmConvertible = vanetza::convertible::byte_buffer_impl<vanetza::asn1::Denm>;
     std::unique_ptr<geonet::DownPacket> payload { new geonet::DownPacket };
-    std::unique_ptr<vanetza::convertible::byte_buffer> denm { new DenmConvertible { obj.shared_ptr() } };
-    payload->layer(OsiLayer::Application) = vanetza::ByteBufferConvertible { std::move(denm) };
+    payload->layer(OsiLayer::Application) = vanetza::ByteBufferConvertible { denm.duplicate() };
     this->request(request, std::move(payload));
 }
 
+void DenService::repeat()
+{
+    const SimTime now = simTime();
+    while (!mRepetitions.empty() && mRepetitions.begin()->first <= now) {
+        Repetition repetition = std::move(mRepetitions.begin()->second);
+        mRepetitions.erase(mRepetitions.begin());
+        transmit(repetition.request, *repetition.payload);
+        repetition.remaining -= repetition.interval;
+        if (repetition.remaining >= SIMTIME_ZERO) {
+            mRepetitions.emplace(now + repetition.interval, std::move(repetition));
+        }
+    }
+    scheduleRepetition();
+}
+
+void DenService::scheduleRepetition()
+{
+    // single timer for all repetitions of this station
+    if (!mRepetitions.empty()) {
+        const SimTime due = mRepetitions.begin()->first;
+        if (!mRepetitionTimer->isScheduled()) {
+            scheduleAt(due, mRepetitionTimer);
+        } else if (mRepetitionTimer->getArrivalTime() > due) {
+            cancelEvent(mRepetitionTimer);
+            scheduleAt(due, mRepetitionTimer);
+        }
+    }
+}
+
 void DenService::fillRequest(vanetza::btp::DataRequestB& request)
 {
     using namespace vanetza;
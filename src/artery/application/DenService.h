@@ -13,8 +13,11 @@
 #include <vanetza/asn1/denm.hpp>
 #include <vanetza/btp/data_indication.hpp>
 #include <vanetza/btp/data_request.hpp>
+#include <vanetza/common/byte_buffer_convertible.hpp>
+#include <omnetpp/simtime.h>
 #include <cstdint>
 #include <list>
+#include <map>
 #include <memory>
 
 namespace artery
@@ -26,10 +29,13 @@ class DenService : public ItsG5BaseService
 {
     public:
         DenService();
+        ~DenService();
         void initialize() override;
+        void handleMessage(omnetpp::cMessage*) override;
         void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, omnetpp::cObject*, omnetpp::cObject*) override;
         void indicate(const vanetza::btp::DataIndication&, std::unique_ptr<vanetza::UpPacket>) override;
         void trigger() override;
+        bool requiresTrigger() const override { return true; }
 
         using ItsG5BaseService::getFacilities;
         const Timer* getTimer() const;
@@ -39,10 +45,27 @@ class DenService : public ItsG5BaseService
         void sendDenm(vanetza::asn1::Denm&&, vanetza::btp::DataRequestB&);
 
     private:
+        /**
+         * Repeated DENM sharing its encoded payload with all its transmissions
+         */
+        struct Repetition
+        {
+            vanetza::btp::DataRequestB request;
+            std::shared_ptr<const vanetza::convertible::byte_buffer> payload;
+            omnetpp::SimTime interval;
+            omnetpp::SimTime remaining;
+        };
+
         void fillRequest(vanetza::btp::DataRequestB&);
         void initUseCases();
+        void transmit(const vanetza::btp::DataRequestB&, const vanetza::convertible::byte_buffer&);
+        void repeat();
+        void scheduleRepetition();
 
         const Timer* mTimer;
+        bool mSharedRepetitions = false;
+        std::multimap<omnetpp::SimTime, Repetition> mRepetitions; /*< pending repetitions by due time */
+        omnetpp::cMessage* mRepetitionTimer = nullptr;
         uint16_t mSequenceNumber;
         std::shared_ptr<artery::den::Memory> mMemory;
         std::list<artery::den::UseCase*> mUseCases;
@@ -0,0 +1,48 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_DUMMYPAYLOAD_H_Q3ZK8TVR
+#define ARTERY_DUMMYPAYLOAD_H_Q3ZK8TVR
+
+#include <vanetza/common/byte_buffer_convertible.hpp>
+#include <cstddef>
+#include <memory>
+
+namespace artery
+{
+
+/**
+ * DummyPayload is an application payload only known by its size
+ *
+ * No packet object is allocated for it and its bytes are only generated
+ * if some layer really needs them, e.g. for signing.
+ */
+class DummyPayload : public vanetza::convertible::byte_buffer
+{
+public:
+    explicit DummyPayload(std::size_t length) : mLength(length) {}
+
+    void convert(vanetza::ByteBuffer& buf) const override
+    {
+        buf.assign(mLength, 0);
+    }
+
+    std::size_t size() const override
+    {
+        return mLength;
+    }
+
+    std::unique_ptr<vanetza::convertible::byte_buffer> duplicate() const override
+    {
+        return std::unique_ptr<vanetza::convertible::byte_buffer> { new DummyPayload(mLength) };
+    }
+
+private:
+    std::size_t mLength;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_DUMMYPAYLOAD_H_Q3ZK8TVR */
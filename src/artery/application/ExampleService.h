@@ -30,6 +30,7 @@ class ExampleService : public ItsG5Service
 
         void indicate(const vanetza::btp::DataIndication&, omnetpp::cPacket*, const NetworkInterface&) override;
         void trigger() override;
+        bool requiresTrigger() const override { return true; }
         void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, omnetpp::cObject*, omnetpp::cObject*) override;
 
     protected:
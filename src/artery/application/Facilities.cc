@@ -0,0 +1,18 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/application/Facilities.h"
+
+namespace artery
+{
+
+std::size_t Facilities::allocate_slot()
+{
+    // defined out of line: one counter shared by all libraries using Facilities
+    static std::size_t next = 0;
+    return next++;
+}
+
+} // namespace artery
@@ -20,10 +20,11 @@
 #define ARTERY_FACILITIES_H_
 
 #include <cassert>
+#include <cstddef>
 #include <stdexcept>
-#include <typeindex>
+#include <type_traits>
 #include <typeinfo>
-#include <unordered_map>
+#include <vector>
 #include <omnetpp/cexception.h>
 
 namespace artery
@@ -31,6 +32,9 @@ namespace artery
 
 /**
  * Context class for each ITS-G5 service provided by middleware
+ *
+ * Each registered type gets a process-wide slot index on first use,
+ * thus lookups are plain array accesses instead of hash map look ups.
  */
 class Facilities
 {
@@ -40,12 +44,8 @@ class Facilities
 		{
 			static_assert(std::is_class<T>::value, "T has to be a class type");
 			using DT = typename std::decay<T>::type;
-			DT* object = nullptr;
-			auto found = m_mutable_objects.find(std::type_index(typeid(DT)));
-			if (found != m_mutable_objects.end()) {
-				object = static_cast<DT*>(found->second);
-			}
-			return object;
+			const std::size_t index = slot<DT>();
+			return index < m_objects.size() ? static_cast<DT*>(m_objects[index].mutable_object) : nullptr;
 		}
 
 		template<typename T>
@@ -73,12 +73,8 @@ class Facilities
 		{
 			static_assert(std::is_class<T>::value, "T has to be a class type");
 			using DT = typename std::decay<T>::type;
-			const DT* object = nullptr;
-			auto found = m_const_objects.find(std::type_index(typeid(DT)));
-			if (found != m_const_objects.end()) {
-				object = static_cast<const DT*>(found->second);
-			}
-			return object;
+			const std::size_t index = slot<DT>();
+			return index < m_objects.size() ? static_cast<const DT*>(m_objects[index].const_object) : nullptr;
 		}
 
 		template<typename T>
@@ -107,7 +103,7 @@ class Facilities
 			assert(object);
 			static_assert(std::is_class<T>::value, "T has to be a class type");
 			using DT = typename std::decay<T>::type;
-			m_mutable_objects[std::type_index(typeid(DT))] = object;
+			entry(slot<DT>()).mutable_object = object;
 			register_const(object);
 		}
 
@@ -123,7 +119,7 @@ class Facilities
 			assert(object);
 			static_assert(std::is_class<T>::value, "T has to be a class type");
 			using DT = typename std::decay<T>::type;
-			m_const_objects[std::type_index(typeid(DT))] = object;
+			entry(slot<DT>()).const_object = object;
 		}
 
 		template<typename T>
@@ -133,8 +129,30 @@ class Facilities
 		}
 
 	private:
-		std::unordered_map<std::type_index, void*> m_mutable_objects;
-		std::unordered_map<std::type_index, const void*> m_const_objects;
+		struct Entry
+		{
+			void* mutable_object = nullptr;
+			const void* const_object = nullptr;
+		};
+
+		static std::size_t allocate_slot();
+
+		template<typename DT>
+		static std::size_t slot()
+		{
+			static const std::size_t index = allocate_slot();
+			return index;
+		}
+
+		Entry& entry(std::size_t index)
+		{
+			if (index >= m_objects.size()) {
+				m_objects.resize(index + 1);
+			}
+			return m_objects[index];
+		}
+
+		std::vector<Entry> m_objects;
 };
 
 } // namespace artery
@@ -111,6 +111,11 @@ void ItsG5BaseService::trigger()
 {
 }
 
+bool ItsG5BaseService::requiresTrigger() const
+{
+	return false;
+}
+
 void ItsG5BaseService::request(const vanetza::btp::DataRequestB& req,
 	std::unique_ptr<vanetza::DownPacket> packet, const NetworkInterface* interface)
 {
@@ -60,6 +60,16 @@ class ItsG5BaseService :
 		 */
 		virtual void trigger();
 
+		/**
+		 * Determine if this service relies on periodic triggers.
+		 *
+		 * Middleware of static stations may skip triggers of services returning false
+		 * and stop its update cycle altogether if no service requires triggers.
+		 *
+		 * \return false by default, services overriding trigger() should return true
+		 */
+		virtual bool requiresTrigger() const;
+
 		/**
 		 * Add listening transport descriptor (channel + BTP port).
 		 *
@@ -1,12 +1,32 @@
 #include "artery/application/LocalDynamicMap.h"
 #include "artery/application/Timer.h"
+#include "artery/utility/MemoryFootprint.h"
+#include <omnetpp/cexception.h>
 #include <omnetpp/csimulation.h>
 #include <cassert>
 #include <algorithm>
+#include <cmath>
 
 namespace artery
 {
 
+namespace
+{
+    const double earthRadius = 6371000.0; // mean radius in metres
+    const double cellDegrees = 0.002; // approx. 220 m towards north
+    const double toRadian = M_PI / 180.0;
+
+    long getCellIndex(double degrees)
+    {
+        return static_cast<long>(std::floor(degrees / cellDegrees));
+    }
+
+    std::int64_t getCellKey(long lat, long lon)
+    {
+        return (static_cast<std::int64_t>(lat) << 32) ^ (static_cast<std::int64_t>(lon) & 0xffffffff);
+    }
+}
+
 LocalDynamicMap::LocalDynamicMap(const Timer& timer) :
     mTimer(timer)
 {
@@ -27,23 +47,34 @@ void LocalDynamicMap::updateAwareness(const CaObject& obj)
         return;
     }
 
-    AwarenessEntry entry(obj, expiry);
-    auto found = mCaMessages.find(msg->header.stationID);
+    const StationID station = msg->header.stationID;
+    AwarenessEntry entry(obj, expiry, mKeepCams);
+    auto found = mCaMessages.find(station);
     if (found != mCaMessages.end()) {
+        if (found->second.mCell != entry.mCell || found->second.mHasPosition != entry.mHasPosition) {
+            removeCell(station, found->second);
+            insertCell(station, entry);
+        }
         found->second = std::move(entry);
     } else {
-        mCaMessages.emplace(msg->header.stationID, std::move(entry));
+        insertCell(station, entry);
+        mCaMessages.emplace(station, std::move(entry));
     }
+    mExpiries.emplace(expiry, station);
 }
 
 void LocalDynamicMap::dropExpired()
 {
     const auto now = omnetpp::simTime();
-    for (auto it = mCaMessages.begin(); it != mCaMessages.end();) {
-        if (it->second.expiry() < now) {
-            it = mCaMessages.erase(it);
-        } else {
-            ++it;
+    while (!mExpiries.empty() && mExpiries.top().first < now) {
+        const Expiry expired = mExpiries.top();
+        mExpiries.pop();
+
+        // entries refreshed meanwhile have a later expiry
+        auto found = mCaMessages.find(expired.second);
+        if (found != mCaMessages.end() && found->second.expiry() == expired.first) {
+            removeCell(found->first, found->second);
+            mCaMessages.erase(found);
         }
     }
 }
@@ -52,7 +83,7 @@ unsigned LocalDynamicMap::count(const CamPredicate& predicate) const
 {
     return std::count_if(mCaMessages.begin(), mCaMessages.end(),
             [&predicate](const AwarenessEntries::value_type& map_entry) {
-                return predicate(map_entry.second.cam());
+                return map_entry.second.mCam && predicate(*map_entry.second.mCam);
             });
 }
 
@@ -66,9 +97,158 @@ std::shared_ptr<const LocalDynamicMap::Cam> LocalDynamicMap::getCam(StationID st
     return nullptr;
 }
 
-LocalDynamicMap::AwarenessEntry::AwarenessEntry(const CaObject& obj, omnetpp::SimTime t) :
-    mExpiry(t), mObject(obj)
+std::vector<const LocalDynamicMap::AwarenessEntry*> LocalDynamicMap::query(const GeoPosition& center,
+        Length radius, const CamPredicate& predicate) const
+{
+    std::vector<const AwarenessEntry*> result;
+    // entries of ring n are at least (n - 1) cell lengths apart from center
+    const long rings = static_cast<long>(radius.value() / getCellLength(center).value()) + 1;
+    for (long ring = 0; ring <= rings; ++ring) {
+        visitRing(center, ring, [&](const AwarenessEntry& entry) {
+            if (distance(center, entry.position()) <= radius && (!predicate || (entry.mCam && predicate(*entry.mCam)))) {
+                result.push_back(&entry);
+            }
+        });
+    }
+    return result;
+}
+
+std::vector<const LocalDynamicMap::AwarenessEntry*> LocalDynamicMap::nearest(const GeoPosition& center, std::size_t k) const
+{
+    using Candidate = std::pair<Length, const AwarenessEntry*>;
+    auto closer = [](const Candidate& a, const Candidate& b) { return a.first < b.first; };
+
+    std::size_t indexed = 0;
+    for (const auto& cell : mCells) {
+        indexed += cell.second.size();
+    }
+
+    // expand rings until no unvisited entry can be closer than k-th candidate
+    std::vector<Candidate> candidates;
+    std::size_t visited = 0;
+    const Length cellLength = getCellLength(center);
+    for (long ring = 0; k > 0 && visited < indexed; ++ring) {
+        visitRing(center, ring, [&](const AwarenessEntry& entry) {
+            candidates.emplace_back(distance(center, entry.position()), &entry);
+            ++visited;
+        });
+
+        if (candidates.size() >= k) {
+            std::nth_element(candidates.begin(), candidates.begin() + (k - 1), candidates.end(), closer);
+            candidates.erase(candidates.begin() + k, candidates.end());
+            const Length bound = static_cast<double>(ring) * cellLength;
+            if (std::max_element(candidates.begin(), candidates.end(), closer)->first <= bound) {
+                break;
+            }
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), closer);
+    std::vector<const AwarenessEntry*> result;
+    result.reserve(candidates.size());
+    for (const Candidate& candidate : candidates) {
+        result.push_back(candidate.second);
+    }
+    return result;
+}
+
+template<typename F>
+void LocalDynamicMap::visitRing(const GeoPosition& center, long ring, F&& visitor) const
+{
+    const long lat = getCellIndex(center.latitude.value());
+    const long lon = getCellIndex(center.longitude.value());
+    for (long i = lat - ring; i <= lat + ring; ++i) {
+        // inner cells of ring have been visited already
+        const long step = (i == lat - ring || i == lat + ring) ? 1 : std::max(2 * ring, 1L);
+        for (long j = lon - ring; j <= lon + ring; j += step) {
+            auto cell = mCells.find(getCellKey(i, j));
+            if (cell != mCells.end()) {
+                for (StationID station : cell->second) {
+                    visitor(mCaMessages.at(station));
+                }
+            }
+        }
+    }
+}
+
+void LocalDynamicMap::insertCell(StationID station, const AwarenessEntry& entry)
 {
+    if (entry.mHasPosition) {
+        mCells[entry.mCell].push_back(station);
+    }
+}
+
+void LocalDynamicMap::removeCell(StationID station, const AwarenessEntry& entry)
+{
+    if (entry.mHasPosition) {
+        auto cell = mCells.find(entry.mCell);
+        assert(cell != mCells.end());
+        auto& stations = cell->second;
+        auto found = std::find(stations.begin(), stations.end(), station);
+        assert(found != stations.end());
+        *found = stations.back();
+        stations.pop_back();
+        if (stations.empty()) {
+            mCells.erase(cell);
+        }
+    }
+}
+
+LocalDynamicMap::Length LocalDynamicMap::getCellLength(const GeoPosition& center) const
+{
+    // cells are narrowest along a circle of latitude
+    const double lat = std::min(std::abs(center.latitude.value()) + cellDegrees, 90.0) * toRadian;
+    const double length = cellDegrees * toRadian * earthRadius * std::cos(lat);
+    return std::max(length, 1.0) * boost::units::si::meters;
+}
+
+LocalDynamicMap::AwarenessEntry::AwarenessEntry(const CaObject& obj, omnetpp::SimTime t, bool keepCam) :
+    mExpiry(t), mCell(0), mHasPosition(false), mHasMotion(false)
+{
+    const vanetza::asn1::Cam& msg = obj.asn1();
+    const BasicContainer_t& basic = msg->cam.camParameters.basicContainer;
+    mStationType = basic.stationType;
+    mGenerationDeltaTime = msg->cam.generationDeltaTime;
+
+    const ReferencePosition_t& ref = basic.referencePosition;
+    if (ref.latitude != Latitude_unavailable && ref.longitude != Longitude_unavailable) {
+        mPosition.latitude = ref.latitude / (1e6 * Latitude_oneMicrodegreeNorth) * boost::units::degree::degrees;
+        mPosition.longitude = ref.longitude / (1e6 * Longitude_oneMicrodegreeEast) * boost::units::degree::degrees;
+        mHasPosition = true;
+        mCell = getCellKey(getCellIndex(mPosition.latitude.value()), getCellIndex(mPosition.longitude.value()));
+    }
+
+    const HighFrequencyContainer_t& hfc = msg->cam.camParameters.highFrequencyContainer;
+    if (hfc.present == HighFrequencyContainer_PR_basicVehicleContainerHighFrequency) {
+        const BasicVehicleContainerHighFrequency& bvc = hfc.choice.basicVehicleContainerHighFrequency;
+        if (bvc.speed.speedValue != SpeedValue_unavailable && bvc.heading.headingValue != HeadingValue_unavailable) {
+            mSpeed = bvc.speed.speedValue / (100.0 * SpeedValue_oneCentimeterPerSec) * vanetza::units::si::meter_per_second;
+            // heading values are given in 0.1 degree
+            mHeading = vanetza::units::Angle { bvc.heading.headingValue / 10.0 * vanetza::units::degree };
+            mHasMotion = true;
+        }
+    }
+
+    if (keepCam) {
+        mCam = obj.shared_ptr();
+    }
+}
+
+const LocalDynamicMap::Cam& LocalDynamicMap::AwarenessEntry::cam() const
+{
+    if (!mCam) {
+        throw omnetpp::cRuntimeError("CAM has not been kept by LocalDynamicMap");
+    }
+    return *mCam;
+}
+
+std::size_t LocalDynamicMap::estimateMemoryFootprint() const
+{
+    std::size_t bytes = memory::bytes(mCaMessages) + memory::bytes(mExpiries) + memory::bytes(mCells);
+    for (const auto& cell : mCells) {
+        bytes += memory::bytes(cell.second);
+    }
+    return bytes;
 }
 
 } // namespace artery
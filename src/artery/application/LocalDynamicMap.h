@@ -2,56 +2,149 @@
 #define ARTERY_LOCALDYNAMICMAP_H_AL7SS9KT
 
 #include "artery/application/CaObject.h"
+#include "artery/utility/Geometry.h"
 #include <omnetpp/simtime.h>
 #include <vanetza/asn1/cam.hpp>
+#include <vanetza/units/angle.hpp>
+#include <vanetza/units/velocity.hpp>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace artery
 {
 
 class Timer;
 
+/**
+ * LocalDynamicMap stores the most recent CAM of each station until it expires.
+ *
+ * Commonly used CAM fields are decoded once on insertion. The CAM itself is kept by reference
+ * only if desired, which reduces the memory footprint of entries considerably.
+ *
+ * Entries are ordered by station ID and additionally indexed by expiry time and by their reference positions.
+ * The spatial index is a grid of geodetic cells, thus entries near a position can be found
+ * without visiting the whole map.
+ */
 class LocalDynamicMap
 {
 public:
     using StationID = uint32_t;
     using Cam = vanetza::asn1::Cam;
     using CamPredicate = std::function<bool(const Cam&)>;
+    using Length = Position::value_type;
 
     class AwarenessEntry
     {
     public:
-        AwarenessEntry(const CaObject&, omnetpp::SimTime);
+        AwarenessEntry(const CaObject&, omnetpp::SimTime, bool keepCam = true);
         AwarenessEntry(AwarenessEntry&&) = default;
         AwarenessEntry& operator=(AwarenessEntry&&) = default;
 
         omnetpp::SimTime expiry() const { return mExpiry; }
-        const Cam& cam() const { return mObject.asn1(); }
-        std::shared_ptr<const Cam> camPtr() const { return mObject.shared_ptr(); }
+
+        /**
+         * Get received CAM, only available if LDM keeps CAMs
+         * \throw omnetpp::cRuntimeError if CAM has not been kept
+         */
+        const Cam& cam() const;
+        std::shared_ptr<const Cam> camPtr() const { return mCam; }
+
+        /**
+         * Check if CAM provides a reference position
+         */
+        bool hasPosition() const { return mHasPosition; }
+        const GeoPosition& position() const { return mPosition; }
+
+        /**
+         * Check if CAM provides speed and heading of a basic vehicle container
+         */
+        bool hasMotion() const { return mHasMotion; }
+        vanetza::units::Velocity speed() const { return mSpeed; }
+        vanetza::units::Angle heading() const { return mHeading; } // degree from north, clockwise
+
+        long stationType() const { return mStationType; }
+        uint16_t generationDeltaTime() const { return mGenerationDeltaTime; }
 
     private:
+        friend class LocalDynamicMap;
+        std::shared_ptr<const Cam> mCam;
         omnetpp::SimTime mExpiry;
-        CaObject mObject;
+        GeoPosition mPosition;
+        vanetza::units::Velocity mSpeed;
+        vanetza::units::Angle mHeading;
+        std::int64_t mCell; /*< spatial grid cell */
+        long mStationType;
+        uint16_t mGenerationDeltaTime;
+        bool mHasPosition;
+        bool mHasMotion;
     };
 
+    // ordered by station ID, i.e. iteration order does not depend on the standard library's hashing
     using AwarenessEntries = std::map<StationID, AwarenessEntry>;
 
     LocalDynamicMap(const Timer&);
+
+    /**
+     * Keep received CAMs along with their decoded fields (enabled by default)
+     *
+     * Without kept CAMs, only decoded fields are available and predicates on CAMs never match.
+     */
+    void setKeepCams(bool keep) { mKeepCams = keep; }
+
     void updateAwareness(const CaObject&);
     void dropExpired();
     unsigned count(const CamPredicate&) const;
     std::shared_ptr<const Cam> getCam(StationID) const;
     const AwarenessEntries& allEntries() const { return mCaMessages; }
 
+    /**
+     * Find entries within a circular area
+     * \param center center of area
+     * \param radius radius of area
+     * \param predicate optional filter of found entries
+     * \return matching entries with reference position in area
+     */
+    std::vector<const AwarenessEntry*> query(const GeoPosition& center, Length radius,
+            const CamPredicate& predicate = nullptr) const;
+
+    /**
+     * Find entries closest to a position
+     * \param center reference point
+     * \param k maximum number of entries
+     * \return up to k entries ordered by ascending distance
+     */
+    std::vector<const AwarenessEntry*> nearest(const GeoPosition& center, std::size_t k) const;
+
+    /**
+     * Estimate bytes used by entries and indices (kept CAMs are shared with other receivers)
+     */
+    std::size_t estimateMemoryFootprint() const;
+
 private:
+    using CellKey = std::int64_t;
+    using Expiry = std::pair<omnetpp::SimTime, StationID>;
+
+    void insertCell(StationID, const AwarenessEntry&);
+    void removeCell(StationID, const AwarenessEntry&);
+    Length getCellLength(const GeoPosition&) const;
+
+    template<typename F>
+    void visitRing(const GeoPosition& center, long ring, F&& visitor) const;
+
     const Timer& mTimer;
+    bool mKeepCams = true;
     AwarenessEntries mCaMessages;
+    std::priority_queue<Expiry, std::vector<Expiry>, std::greater<Expiry>> mExpiries; /*< including outdated expiries */
+    std::unordered_map<CellKey, std::vector<StationID>> mCells;
 };
 
 } // namespace artery
 
 #endif /* ARTERY_LOCALDYNAMICMAP_H_AL7SS9KT */
-
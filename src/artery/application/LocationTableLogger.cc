@@ -1,7 +1,10 @@
 #include "artery/application/LocationTableLogger.h"
 #include "artery/networking/Router.h"
 #include <boost/optional/optional.hpp>
+#include <boost/units/systems/angle/degrees.hpp>
 #include <inet/common/ModuleAccess.h>
+#include <algorithm>
+#include <cmath>
 
 namespace artery
 {
@@ -12,6 +15,11 @@ static const omnetpp::simsignal_t scNeighbourDensitySignal = omnetpp::cComponent
 
 Define_Module(LocationTableLogger)
 
+LocationTableLogger::~LocationTableLogger()
+{
+    cancelAndDelete(mLogTrigger);
+}
+
 void LocationTableLogger::initialize()
 {
     ItsG5BaseService::initialize();
@@ -19,9 +27,32 @@ void LocationTableLogger::initialize()
     mLocationTable = &router->getLocationTable();
     mEgoPositionVector = &router->getEgoPositionVector();
     mTimer = &getFacilities().get_const<Timer>();
+
+    mLogInterval = par("logInterval");
+    if (mLogInterval > omnetpp::SimTime::ZERO) {
+        mLogTrigger = new omnetpp::cMessage("log location table");
+        scheduleAt(omnetpp::simTime() + mLogInterval, mLogTrigger);
+    }
+}
+
+void LocationTableLogger::handleMessage(omnetpp::cMessage* msg)
+{
+    if (msg == mLogTrigger) {
+        logLocationTable();
+        scheduleAt(omnetpp::simTime() + mLogInterval, mLogTrigger);
+    } else {
+        error("unexpected message %s", msg->getName());
+    }
 }
 
 void LocationTableLogger::trigger()
+{
+    if (!mLogTrigger) {
+        logLocationTable();
+    }
+}
+
+void LocationTableLogger::logLocationTable()
 {
     namespace gn = vanetza::geonet;
 
@@ -30,6 +61,13 @@ void LocationTableLogger::trigger()
         LocationTableVisitor(gn::GeodeticPosition ego, gn::Timestamp deadline) :
             egoPosition(ego), pvDeadline(deadline)
         {
+            // equirectangular projection around ego position, accurate enough for radio ranges
+            static const double earthRadius = 6371000.0;
+            static const double toRadian = M_PI / 180.0;
+            egoLatitude = egoPosition.latitude / boost::units::degree::degree;
+            egoLongitude = egoPosition.longitude / boost::units::degree::degree;
+            metersPerLatitude = earthRadius * toRadian;
+            metersPerLongitude = metersPerLatitude * std::cos(egoLatitude * toRadian);
         }
 
         LocationTableVisitor(const LocationTableVisitor&) = delete;
@@ -39,11 +77,11 @@ void LocationTableLogger::trigger()
         {
             if (locte.has_position_vector()) {
                 const vanetza::geonet::LongPositionVector& pv = locte.get_position_vector();
-                auto range = gn::distance(pv.position(), egoPosition) / vanetza::units::si::meter;
                 if (pv.timestamp >= pvDeadline) {
-                    if (range > communicationRange) {
-                        communicationRange = range;
-                    }
+                    const gn::GeodeticPosition position = pv.position();
+                    double dy = (position.latitude / boost::units::degree::degree - egoLatitude) * metersPerLatitude;
+                    double dx = (position.longitude / boost::units::degree::degree - egoLongitude) * metersPerLongitude;
+                    squaredCommunicationRange = std::max(squaredCommunicationRange, dx * dx + dy * dy);
                     ++neighbourDensity;
                 }
             }
@@ -55,7 +93,11 @@ void LocationTableLogger::trigger()
 
         const gn::GeodeticPosition egoPosition;
         const gn::Timestamp pvDeadline;
-        double communicationRange = 0.0;
+        double egoLatitude;
+        double egoLongitude;
+        double metersPerLatitude;
+        double metersPerLongitude;
+        double squaredCommunicationRange = 0.0;
         unsigned neighbourDensity = 0;
         unsigned neighbourCount = 0;
     };
@@ -64,7 +106,7 @@ void LocationTableLogger::trigger()
     LocationTableVisitor visitor(mEgoPositionVector->position(), deadline);
     mLocationTable->visit(std::ref(visitor));
 
-    emit(scCommunicationRangeSignal, visitor.communicationRange);
+    emit(scCommunicationRangeSignal, std::sqrt(visitor.squaredCommunicationRange));
     emit(scNeighbourDensitySignal, visitor.neighbourDensity);
     emit(scNeighbourCountSignal, visitor.neighbourCount);
 }
@@ -13,13 +13,20 @@ namespace artery
 class LocationTableLogger : public ItsG5Service
 {
 public:
+    ~LocationTableLogger();
     void trigger() override;
+    bool requiresTrigger() const override { return true; }
     bool requiresListener() const { return false; }
 
 protected:
     void initialize() override;
+    void handleMessage(omnetpp::cMessage*) override;
 
 private:
+    void logLocationTable();
+
+    omnetpp::cMessage* mLogTrigger = nullptr;
+    omnetpp::SimTime mLogInterval;
     const Timer* mTimer = nullptr;
     const vanetza::geonet::LocationTable* mLocationTable = nullptr;
     const vanetza::geonet::LongPositionVector* mEgoPositionVector = nullptr;
@@ -15,7 +15,10 @@
 #include "artery/utility/IdentityRegistry.h"
 #include "artery/utility/InitStages.h"
 #include "artery/utility/FilterRules.h"
+#include "artery/utility/XmlConfigCache.h"
 #include "inet/common/ModuleAccess.h"
+#include <string>
+#include <vector>
 
 using namespace omnetpp;
 
@@ -44,6 +47,47 @@ ChannelNumber getChannel(const omnetpp::cXMLElement* cfg)
     return channel;
 }
 
+/**
+ * Service configuration compiled from XML once for all middlewares
+ */
+struct ServicePlan
+{
+    cModuleType* type;
+    std::string name;
+    FilterPlan filters;
+    std::vector<TransportDescriptor> ports;
+    std::vector<ChannelNumber> channels; /*< channels of promiscuous listeners */
+};
+
+std::vector<ServicePlan> compileServicePlans(const cXMLElement& config)
+{
+    std::vector<ServicePlan> plans;
+    for (cXMLElement* service_cfg : config.getChildrenByTagName("service")) {
+        ServicePlan plan;
+        plan.type = cModuleType::get(service_cfg->getAttribute("type"));
+        plan.name = service_cfg->getAttribute("name") ? service_cfg->getAttribute("name") : plan.type->getName();
+
+        cXMLElement* service_filters = service_cfg->getFirstChildWithTag("filters");
+        if (service_filters) {
+            plan.filters = FilterPlan { *service_filters };
+        }
+
+        for (const cXMLElement* listener : service_cfg->getChildrenByTagName("listener")) {
+            if (listener->getAttribute("port")) {
+                auto port = boost::lexical_cast<PortNumber>(listener->getAttribute("port"));
+                plan.ports.push_back(std::forward_as_tuple(getChannel(listener), port));
+            } else if (listener->getAttribute("channel")) {
+                plan.channels.push_back(getChannel(listener));
+            }
+        }
+
+        plans.push_back(std::move(plan));
+    }
+    return plans;
+}
+
+XmlConfigCache<std::vector<ServicePlan>> servicePlanCache;
+
 } // namespace
 
 Middleware::Middleware() : mLocalDynamicMap(mTimer)
@@ -65,7 +109,7 @@ void Middleware::initialize(int stage)
     if (stage == InitStages::Prepare) {
         mTimer.setTimebase(par("datetime"));
         mUpdateInterval = par("updateInterval");
-        mUpdateMessage = new cMessage("middleware update");
+        mLocalDynamicMap.setKeepCams(par("keepLocalDynamicMapCams"));
         mIdentity.host = findHost();
         mIdentity.host->subscribe(Identity::changeSignal, this);
         mMultiChannelPolicy.reset(new XmlMultiChannelPolicy(par("mcoPolicy").xmlValue()));
@@ -82,7 +126,16 @@ void Middleware::initialize(int stage)
 
         // start update cycle with random jitter to avoid unrealistic node synchronization
         const auto jitter = uniform(SimTime(0, SIMTIME_MS), mUpdateInterval);
-        scheduleAt(simTime() + jitter + mUpdateInterval, mUpdateMessage);
+        auto clock = dynamic_cast<MiddlewareClock*>(getModuleByPath(par("middlewareClockModule")));
+        if (mStaticStation && mTriggeredServices.empty()) {
+            // jitter is drawn nevertheless, random number streams are thus unaffected
+            EV_INFO << "no service requires triggers, middleware update cycle is not started\n";
+        } else if (clock) {
+            clock->subscribe(this, simTime() + jitter + mUpdateInterval, mUpdateInterval);
+        } else {
+            mUpdateMessage = new cMessage("middleware update");
+            scheduleAt(simTime() + jitter + mUpdateInterval, mUpdateMessage);
+        }
     } else if (stage == InitStages::Propagate) {
         emit(artery::IdentityRegistry::updateSignal, &mIdentity);
     }
@@ -91,20 +144,11 @@ void Middleware::initialize(int stage)
 void Middleware::initializeServices(int stage)
 {
     cXMLElement* config = par("services").xmlValue();
-    for (cXMLElement* service_cfg : config->getChildrenByTagName("service")) {
-        cModuleType* module_type = cModuleType::get(service_cfg->getAttribute("type"));
-
-        cXMLElement* service_filters = service_cfg->getFirstChildWithTag("filters");
-        bool service_applicable = true;
-        if (service_filters) {
-            artery::FilterRules rules(getRNG(0), mIdentity);
-            service_applicable = rules.applyFilterConfig(*service_filters);
-        }
-
-        if (service_applicable) {
-            const char* service_name = service_cfg->getAttribute("name") ?
-                service_cfg->getAttribute("name") : module_type->getName();
-            cModule* module = module_type->create(service_name, this);
+    const auto& plans = servicePlanCache.get(config, compileServicePlans);
+    for (const ServicePlan& plan : plans) {
+        cModuleType* module_type = plan.type;
+        if (plan.filters.apply(getRNG(0), mIdentity)) {
+            cModule* module = module_type->create(plan.name.c_str(), this);
             module->finalizeParameters();
             module->buildInside();
             module->scheduleStart(simTime());
@@ -135,15 +179,14 @@ void Middleware::initializeServices(int stage)
             unsigned channels = 0;
             auto promiscuous = dynamic_cast<ItsG5PromiscuousService*>(service);
 
-            for (const cXMLElement* listener : service_cfg->getChildrenByTagName("listener")) {
-                if (listener->getAttribute("port")) {
-                    auto port = boost::lexical_cast<PortNumber>(listener->getAttribute("port"));
-                    TransportDescriptor td = std::forward_as_tuple(getChannel(listener), port);
-                    mTransportDispatcher.addListener(service, td);
-                    service->addTransportDescriptor(td);
-                    ++ports;
-                } else if (promiscuous && listener->getAttribute("channel")) {
-                    ChannelNumber channel = getChannel(listener);
+            for (const TransportDescriptor& td : plan.ports) {
+                mTransportDispatcher.addListener(service, td);
+                service->addTransportDescriptor(td);
+                ++ports;
+            }
+
+            if (promiscuous) {
+                for (ChannelNumber channel : plan.channels) {
                     mTransportDispatcher.addPromiscuousListener(promiscuous, channel);
                     ++channels;
                 }
@@ -167,6 +210,13 @@ void Middleware::initializeServices(int stage)
             }
         }
     }
+
+    mTriggeredServices.clear();
+    for (ItsG5BaseService* service : mServices) {
+        if (!mStaticStation || service->requiresTrigger()) {
+            mTriggeredServices.push_back(service);
+        }
+    }
 }
 
 void Middleware::finish()
@@ -178,6 +228,7 @@ void Middleware::handleMessage(cMessage *msg)
 {
     if (msg == mUpdateMessage) {
         updateServices();
+        scheduleAt(simTime() + mUpdateInterval, mUpdateMessage);
     } else {
         error("Middleware cannot handle message '%s'", msg->getFullName());
     }
@@ -193,6 +244,12 @@ void Middleware::receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t signal
     }
 }
 
+void Middleware::tickMiddlewareClock()
+{
+    Enter_Method_Silent();
+    updateServices();
+}
+
 cModule* Middleware::findHost()
 {
     return inet::getContainingNode(this);
@@ -203,6 +260,11 @@ void Middleware::setStationType(const StationType& type)
     mStationType = type;
 }
 
+void Middleware::setStaticStation(bool flag)
+{
+    mStaticStation = flag;
+}
+
 void Middleware::registerNetworkInterface(std::shared_ptr<NetworkInterface> ifc)
 {
     mNetworkInterfaceTable.insert(ifc);
@@ -211,10 +273,9 @@ void Middleware::registerNetworkInterface(std::shared_ptr<NetworkInterface> ifc)
 void Middleware::updateServices()
 {
     mLocalDynamicMap.dropExpired();
-    for (auto& service : mServices) {
+    for (auto& service : mTriggeredServices) {
         service->trigger();
     }
-    scheduleAt(simTime() + mUpdateInterval, mUpdateMessage);
 }
 
 void Middleware::requestTransmission(const vanetza::btp::DataRequestB& request,
@@ -239,7 +300,7 @@ void Middleware::requestTransmission(const vanetza::btp::DataRequestB& request,
         if (netifc) {
             ++pass;
             if (channels.size() > pass) {
-                // duplicate packet for all but last network interface
+                // duplicate packet for all but last network interface (payload is shared by duplicates)
                 netifc->getRouter().request(request, vanetza::duplicate(*packet));
             } else {
                 // last network interface -> pass "original" packet
@@ -257,5 +318,12 @@ void Middleware::requestTransmission(const vanetza::btp::DataRequestB& request,
     }
 }
 
+std::size_t Middleware::estimateMemoryFootprint() const
+{
+    // services are modules on their own, local dynamic map is owned by middleware
+    return sizeof(Middleware) + mLocalDynamicMap.estimateMemoryFootprint() + memory::bytes(mServices) +
+        memory::bytes(mTriggeredServices);
+}
+
 } // namespace artery
 
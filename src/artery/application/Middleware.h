@@ -9,6 +9,7 @@
 
 #include "artery/application/Facilities.h"
 #include "artery/application/LocalDynamicMap.h"
+#include "artery/application/MiddlewareClock.h"
 #include "artery/application/MultiChannelPolicy.h"
 #include "artery/application/NetworkInterface.h"
 #include "artery/application/NetworkInterfaceTable.h"
@@ -16,6 +17,7 @@
 #include "artery/application/Timer.h"
 #include "artery/application/TransportDispatcher.h"
 #include "artery/utility/Identity.h"
+#include "artery/utility/MemoryFootprint.h"
 #include <omnetpp/clistener.h>
 #include <omnetpp/csimplemodule.h>
 #include <omnetpp/simtime.h>
@@ -23,6 +25,7 @@
 #include <vanetza/btp/port_dispatcher.hpp>
 #include <memory>
 #include <set>
+#include <vector>
 
 namespace artery
 {
@@ -34,7 +37,8 @@ class Router;
 /**
  * Middleware providing a runtime context for services.
  */
-class Middleware : public omnetpp::cSimpleModule, public omnetpp::cListener
+class Middleware : public omnetpp::cSimpleModule, public omnetpp::cListener, public MiddlewareClock::Client,
+    public MemoryFootprint
 {
     public:
         Middleware();
@@ -58,6 +62,9 @@ class Middleware : public omnetpp::cSimpleModule, public omnetpp::cListener
         void requestTransmission(const vanetza::btp::DataRequestB&, std::unique_ptr<vanetza::DownPacket>);
         void requestTransmission(const vanetza::btp::DataRequestB&, std::unique_ptr<vanetza::DownPacket>, const NetworkInterface&);
 
+        // MemoryFootprint
+        std::size_t estimateMemoryFootprint() const override;
+
     protected:
         // cSimpleModule
         int numInitStages() const override;
@@ -68,9 +75,18 @@ class Middleware : public omnetpp::cSimpleModule, public omnetpp::cListener
         // cListener
         void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, long, omnetpp::cObject*) override;
 
+        // MiddlewareClock::Client
+        void tickMiddlewareClock() override;
+
         omnetpp::cModule* findHost();
         void setStationType(const StationType&);
 
+        /**
+         * Static stations trigger only services requiring triggers.
+         * Has to be set before services are initialized.
+         */
+        void setStaticStation(bool);
+
     private:
         void updateServices();
         void initializeServices(int stage);
@@ -87,6 +103,8 @@ class Middleware : public omnetpp::cSimpleModule, public omnetpp::cListener
         TransportDispatcher mTransportDispatcher;
         std::unique_ptr<MultiChannelPolicy> mMultiChannelPolicy;
         std::set<ItsG5BaseService*> mServices;
+        std::vector<ItsG5BaseService*> mTriggeredServices; /*< subset of mServices in same order */
+        bool mStaticStation = false;
 };
 
 } // namespace artery
@@ -0,0 +1,133 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/application/MiddlewareClock.h"
+#include <cmath>
+
+namespace artery
+{
+
+Define_Module(MiddlewareClock)
+
+using namespace omnetpp;
+
+MiddlewareClock::Client::~Client()
+{
+    if (mClock) {
+        mClock->unsubscribe(this);
+    }
+}
+
+MiddlewareClock::~MiddlewareClock()
+{
+    cancelAndDelete(mTrigger);
+    for (auto& bucket : mBuckets) {
+        for (Client* client : bucket.second) {
+            client->mClock = nullptr;
+        }
+    }
+    for (Client* client : mExpiring) {
+        if (client) {
+            client->mClock = nullptr;
+        }
+    }
+}
+
+void MiddlewareClock::initialize()
+{
+    mGranularity = par("granularity");
+    if (mGranularity <= SIMTIME_ZERO) {
+        throw cRuntimeError("granularity of middleware clock must be positive");
+    }
+    mTrigger = new cMessage("middleware clock");
+}
+
+void MiddlewareClock::handleMessage(cMessage* msg)
+{
+    if (msg != mTrigger) {
+        throw cRuntimeError("unexpected message");
+    }
+
+    auto bucket = mBuckets.begin();
+    ASSERT(bucket != mBuckets.end() && bucket->first == simTime());
+    mExpiringDue = bucket->first;
+    mExpiring = std::move(bucket->second);
+    mBuckets.erase(bucket);
+
+    // clients are moved to their next bucket before being updated
+    for (std::size_t i = 0; i < mExpiring.size(); ++i) {
+        Client* client = mExpiring[i];
+        if (client) {
+            mExpiring[i] = nullptr;
+            client->mDue += client->mInterval;
+            insert(client);
+            client->tickMiddlewareClock();
+        }
+    }
+
+    mExpiring.clear();
+    scheduleBucket();
+}
+
+void MiddlewareClock::subscribe(Client* client, simtime_t first, simtime_t interval)
+{
+    Enter_Method_Silent();
+    ASSERT(client && !client->mClock);
+    client->mClock = this;
+    client->mDue = roundUp(first);
+    client->mInterval = roundUp(interval);
+    if (client->mDue <= simTime() || client->mInterval <= SIMTIME_ZERO) {
+        throw cRuntimeError("middleware clock requires future updates at positive intervals");
+    }
+    insert(client);
+    scheduleBucket();
+}
+
+void MiddlewareClock::unsubscribe(Client* client)
+{
+    Enter_Method_Silent();
+    ASSERT(client && client->mClock == this);
+    if (!mExpiring.empty() && client->mDue == mExpiringDue) {
+        // keep slots of expiring bucket stable while updating its clients
+        ASSERT(mExpiring[client->mSlot] == client);
+        mExpiring[client->mSlot] = nullptr;
+    } else {
+        auto found = mBuckets.find(client->mDue);
+        ASSERT(found != mBuckets.end());
+        Bucket& bucket = found->second;
+        ASSERT(bucket[client->mSlot] == client);
+        bucket[client->mSlot] = bucket.back();
+        bucket[client->mSlot]->mSlot = client->mSlot;
+        bucket.pop_back();
+        if (bucket.empty()) {
+            mBuckets.erase(found);
+        }
+    }
+    client->mClock = nullptr;
+}
+
+simtime_t MiddlewareClock::roundUp(simtime_t t) const
+{
+    return std::ceil(t / mGranularity) * mGranularity;
+}
+
+void MiddlewareClock::insert(Client* client)
+{
+    Bucket& bucket = mBuckets[client->mDue];
+    client->mSlot = bucket.size();
+    bucket.push_back(client);
+}
+
+void MiddlewareClock::scheduleBucket()
+{
+    if (mBuckets.empty()) {
+        cancelEvent(mTrigger);
+    } else if (!mTrigger->isScheduled() || mTrigger->getArrivalTime() != mBuckets.begin()->first) {
+        cancelEvent(mTrigger);
+        scheduleAt(mBuckets.begin()->first, mTrigger);
+    }
+}
+
+} // namespace artery
@@ -0,0 +1,85 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_MIDDLEWARECLOCK_H_P3HV7TQN
+#define ARTERY_MIDDLEWARECLOCK_H_P3HV7TQN
+
+#include <omnetpp/cmessage.h>
+#include <omnetpp/csimplemodule.h>
+#include <omnetpp/simtime.h>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+namespace artery
+{
+
+/**
+ * MiddlewareClock drives periodic updates of many middlewares by a single timer.
+ *
+ * Clients are grouped in buckets by their due time, which is rounded up to the clock's
+ * granularity. Only the earliest bucket is scheduled in the future event set and all its
+ * clients are updated one after another when it expires.
+ */
+class MiddlewareClock : public omnetpp::cSimpleModule
+{
+public:
+    class Client
+    {
+    public:
+        Client() = default;
+        Client(const Client&) = delete;
+        Client& operator=(const Client&) = delete;
+        virtual ~Client();
+
+        /**
+         * Periodic update, invoked by clock in context of its bucket event
+         */
+        virtual void tickMiddlewareClock() = 0;
+
+    private:
+        friend class MiddlewareClock;
+        MiddlewareClock* mClock = nullptr;
+        omnetpp::simtime_t mDue;
+        omnetpp::simtime_t mInterval;
+        std::size_t mSlot = 0;
+    };
+
+    ~MiddlewareClock();
+
+    void initialize() override;
+    void handleMessage(omnetpp::cMessage*) override;
+
+    /**
+     * Subscribe client for periodic updates
+     * \param client not yet subscribed client
+     * \param first time of first update, rounded up to granularity
+     * \param interval time between updates, rounded up to granularity
+     */
+    void subscribe(Client* client, omnetpp::simtime_t first, omnetpp::simtime_t interval);
+
+    /**
+     * Unsubscribe client, no further updates are triggered then
+     * \param client subscribed client
+     */
+    void unsubscribe(Client* client);
+
+private:
+    using Bucket = std::vector<Client*>;
+
+    omnetpp::simtime_t roundUp(omnetpp::simtime_t) const;
+    void insert(Client*);
+    void scheduleBucket();
+
+    omnetpp::simtime_t mGranularity;
+    omnetpp::cMessage* mTrigger = nullptr;
+    std::map<omnetpp::simtime_t, Bucket> mBuckets;
+    Bucket mExpiring; /*< clients of expiring bucket, slots of updated clients are null */
+    omnetpp::simtime_t mExpiringDue;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_MIDDLEWARECLOCK_H_P3HV7TQN */
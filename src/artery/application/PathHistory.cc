@@ -0,0 +1,70 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/application/PathHistory.h"
+#include "artery/application/VehicleDataProvider.h"
+#include <boost/geometry/algorithms/distance.hpp>
+#include <boost/geometry/geometries/segment.hpp>
+
+namespace artery
+{
+
+namespace
+{
+    // bound effort per position update on long straight paths
+    const std::size_t maxCandidates = 64;
+}
+
+PathHistory::PathHistory() :
+    mChordError(1.0 * boost::units::si::meter), mLastFeed(-1.0)
+{
+    mConcisePoints.set_capacity(40);
+}
+
+void PathHistory::setCapacity(std::size_t points)
+{
+    mConcisePoints.set_capacity(points);
+}
+
+void PathHistory::feed(const VehicleDataProvider& vdp)
+{
+    const omnetpp::SimTime timestamp = vdp.updated();
+    if (timestamp <= mLastFeed) {
+        return;
+    }
+    mLastFeed = timestamp;
+
+    Point point;
+    point.position = vdp.position();
+    point.geo_position.latitude = vdp.latitude();
+    point.geo_position.longitude = vdp.longitude();
+    Sample<Point> current { point, timestamp };
+
+    if (mConcisePoints.empty()) {
+        mConcisePoints.insert(current.value, current.timestamp);
+        return;
+    } else if (!mCandidates.empty() &&
+            (mCandidates.size() >= maxCandidates || exceedsChordError(mConcisePoints.latest(), current))) {
+        // previous position is the last one still approximated by a chord
+        const Sample<Point>& previous = mCandidates.back();
+        mConcisePoints.insert(previous.value, previous.timestamp);
+        mCandidates.clear();
+    }
+    mCandidates.push_back(current);
+}
+
+bool PathHistory::exceedsChordError(const Sample<Point>& anchor, const Sample<Point>& current) const
+{
+    namespace bg = boost::geometry;
+    const bg::model::segment<Position> chord { anchor.value.position, current.value.position };
+    for (const Sample<Point>& candidate : mCandidates) {
+        if (bg::distance(candidate.value.position, chord) > mChordError.value()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace artery
@@ -0,0 +1,74 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_PATHHISTORY_H_XC4NW8UE
+#define ARTERY_PATHHISTORY_H_XC4NW8UE
+
+#include "artery/application/SampleBuffer.h"
+#include "artery/utility/Geometry.h"
+#include <omnetpp/simtime.h>
+#include <cstddef>
+#include <vector>
+
+namespace artery
+{
+
+class VehicleDataProvider;
+
+/**
+ * PathHistory records concise path points of a station's recent trace.
+ *
+ * Positions are reduced incrementally as they arrive: the trace since the most recent concise
+ * point is approximated by a chord to the current position. As soon as any intermediate
+ * position deviates from this chord by more than the allowed chord error, the previous position
+ * becomes a new concise point. Hence, generating a path history for a CAM does not require
+ * any reduction at all.
+ */
+class PathHistory
+{
+public:
+    struct Point
+    {
+        Position position;
+        GeoPosition geo_position;
+    };
+
+    using buffer_type = SampleBuffer<Point>;
+
+    PathHistory();
+
+    /**
+     * Set maximum number of concise points, latest points are kept
+     */
+    void setCapacity(std::size_t points);
+
+    /**
+     * Set allowed deviation of approximated path from actual positions
+     */
+    void setChordError(Position::value_type error) { mChordError = error; }
+
+    /**
+     * Feed current position of vehicle, repeated feeding of same update is ignored
+     * \param vdp vehicle data
+     */
+    void feed(const VehicleDataProvider& vdp);
+
+    /**
+     * Get concise path points, most recent point first
+     */
+    const buffer_type& points() const { return mConcisePoints; }
+
+private:
+    bool exceedsChordError(const Sample<Point>& anchor, const Sample<Point>& current) const;
+
+    buffer_type mConcisePoints;
+    std::vector<Sample<Point>> mCandidates; /*< positions since latest concise point */
+    Position::value_type mChordError;
+    omnetpp::SimTime mLastFeed;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_PATHHISTORY_H_XC4NW8UE */
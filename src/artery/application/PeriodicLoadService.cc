@@ -5,6 +5,7 @@
 */
 
 #include "PeriodicLoadService.h"
+#include "artery/application/DummyPayload.h"
 #include <omnetpp/cpacket.h>
 #include <vanetza/btp/data_request.hpp>
 #include <vanetza/dcc/profile.hpp>
@@ -27,6 +28,16 @@ PeriodicLoadService::~PeriodicLoadService()
     cancelAndDelete(mTrigger);
 }
 
+void PeriodicLoadService::indicate(const btp::DataIndication& ind, std::unique_ptr<UpPacket> packet, const NetworkInterface& net)
+{
+    // dummy payloads are dropped right away, i.e. without extracting a cPacket
+    auto chunk = boost::get<ChunkPacket>(packet.get());
+    if (chunk && dynamic_cast<const DummyPayload*>((*chunk)[OsiLayer::Application].ptr())) {
+        return;
+    }
+    ItsG5Service::indicate(ind, std::move(packet), net);
+}
+
 void PeriodicLoadService::indicate(const btp::DataIndication& ind, cPacket* packet, const NetworkInterface& net)
 {
     Enter_Method("indicate");
@@ -37,6 +48,7 @@ void PeriodicLoadService::initialize()
 {
     ItsG5Service::initialize();
     mAppId = par("aid");
+    mDummyPayload = par("dummyPayload");
     mTrigger = new cMessage("PeriodicLoadService generate message");
     mTrigger->setSchedulingPriority(1); // this trigger is then after radio setup
     if (!par("waitForFirstTrigger")) {
@@ -82,11 +94,17 @@ void PeriodicLoadService::generateTransmissionRequest()
             req.gn.communication_profile = geonet::CommunicationProfile::ITS_G5;
             req.gn.its_aid = mAppId;
 
-            cPacket* packet = new cPacket("PeriodicLoadService packet");
-            packet->setByteLength(par("payloadLength"));
-
             // send packet on specific network interface
-            request(req, packet, network.get());
+            if (mDummyPayload) {
+                std::unique_ptr<convertible::byte_buffer> payload { new DummyPayload(par("payloadLength").intValue()) };
+                std::unique_ptr<geonet::DownPacket> packet { new geonet::DownPacket() };
+                packet->layer(OsiLayer::Application) = ByteBufferConvertible { std::move(payload) };
+                request(req, std::move(packet), network.get());
+            } else {
+                cPacket* packet = new cPacket("PeriodicLoadService packet");
+                packet->setByteLength(par("payloadLength"));
+                request(req, packet, network.get());
+            }
         } else {
             EV_ERROR << "No network interface available for channel " << channel << "\n";
         }
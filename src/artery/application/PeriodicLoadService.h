@@ -19,8 +19,10 @@ class PeriodicLoadService : public ItsG5Service
         PeriodicLoadService();
         ~PeriodicLoadService();
 
+        void indicate(const vanetza::btp::DataIndication&, std::unique_ptr<vanetza::UpPacket>, const NetworkInterface&) override;
         void indicate(const vanetza::btp::DataIndication&, omnetpp::cPacket*, const NetworkInterface&) override;
         void trigger() override;
+        bool requiresTrigger() const override { return true; }
 
     protected:
         void initialize() override;
@@ -31,6 +33,7 @@ class PeriodicLoadService : public ItsG5Service
     private:
         omnetpp::cMessage* mTrigger;
         std::uint32_t mAppId;
+        bool mDummyPayload;
 };
 
 } // namespace artery
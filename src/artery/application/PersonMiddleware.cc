@@ -37,6 +37,8 @@ void PersonMiddleware::initialize(int stage)
 
         mVehicleDataProvider.setStationId(identity.application);
         mVehicleDataProvider.update(getKinematics(*mPersonController));
+        mThrottle.configure(par("updateDistance"), par("maxUpdateInterval"));
+        mThrottle.updated(mPersonController->getPosition(), simTime());
         getFacilities().register_const(&mVehicleDataProvider);
     }
 
@@ -67,7 +69,11 @@ void PersonMiddleware::initializePersonController(cPar& mobilityPar)
 void PersonMiddleware::receiveSignal(cComponent* component, simsignal_t signal, cObject* obj, cObject* details)
 {
 	if (signal == MobilityBase::stateChangedSignal && mPersonController) {
-		mVehicleDataProvider.update(getKinematics(*mPersonController));
+		const Position position = mPersonController->getPosition();
+		if (mThrottle.isDue(position, simTime())) {
+			mVehicleDataProvider.update(getKinematics(*mPersonController));
+			mThrottle.updated(position, simTime());
+		}
 	}
 }
 
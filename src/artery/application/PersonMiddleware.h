@@ -10,6 +10,7 @@
 #include "artery/application/Middleware.h"
 #include "artery/application/VehicleDataProvider.h"
 #include "artery/traci/PersonController.h"
+#include "artery/utility/DisplacementThrottle.h"
 
 namespace artery
 {
@@ -29,6 +30,7 @@ class PersonMiddleware : public Middleware
     private:
         traci::PersonController* mPersonController = nullptr;
         VehicleDataProvider mVehicleDataProvider;
+        DisplacementThrottle mThrottle;
 };
 
 } // namespace artery
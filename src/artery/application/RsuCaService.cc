@@ -16,6 +16,7 @@
 #include <omnetpp/cxmlelement.h>
 #include <vanetza/btp/ports.hpp>
 #include <cmath>
+#include <cstring>
 
 namespace artery
 {
@@ -25,6 +26,55 @@ using namespace omnetpp;
 static const simsignal_t scSignalCamReceived = cComponent::registerSignal("CamReceived");
 static const simsignal_t scSignalCamSent = cComponent::registerSignal("CamSent");
 
+namespace
+{
+
+// UPER encoding of generationDeltaTime follows the fixed-size ITS PDU header
+const std::size_t scGenerationDeltaTimeOffset = 6;
+
+void patchGenerationDeltaTime(vanetza::ByteBuffer& buffer, GenerationDeltaTime_t genDeltaTime)
+{
+    buffer[scGenerationDeltaTimeOffset] = (genDeltaTime >> 8) & 0xff;
+    buffer[scGenerationDeltaTimeOffset + 1] = genDeltaTime & 0xff;
+}
+
+/**
+ * CAM payload whose serialized form is derived from a shared, pre-encoded template
+ *
+ * Receivers can still access the CAM object directly as with any other CAM byte buffer.
+ */
+class PatchedCamByteBuffer : public vanetza::convertible::byte_buffer_impl<vanetza::asn1::Cam>
+{
+public:
+    using base_type = vanetza::convertible::byte_buffer_impl<vanetza::asn1::Cam>;
+
+    PatchedCamByteBuffer(std::shared_ptr<const vanetza::asn1::Cam> cam, std::shared_ptr<const vanetza::ByteBuffer> encoded) :
+        base_type(cam), mEncoded(std::move(encoded))
+    {
+    }
+
+    void convert(vanetza::ByteBuffer& buffer) const override
+    {
+        buffer = *mEncoded;
+        patchGenerationDeltaTime(buffer, (*wrapper())->cam.generationDeltaTime);
+    }
+
+    std::size_t size() const override
+    {
+        return mEncoded->size();
+    }
+
+    std::unique_ptr<vanetza::convertible::byte_buffer> duplicate() const override
+    {
+        return std::unique_ptr<vanetza::convertible::byte_buffer> { new PatchedCamByteBuffer(wrapper(), mEncoded) };
+    }
+
+private:
+    std::shared_ptr<const vanetza::ByteBuffer> mEncoded;
+};
+
+} // namespace
+
 Define_Module(RsuCaService)
 
 void RsuCaService::initialize()
@@ -118,12 +168,61 @@ void RsuCaService::sendCam()
 
     using CamByteBuffer = convertible::byte_buffer_impl<asn1::Cam>;
     std::unique_ptr<geonet::DownPacket> payload { new geonet::DownPacket() };
-    std::unique_ptr<convertible::byte_buffer> buffer { new CamByteBuffer(obj.shared_ptr()) };
+    std::unique_ptr<convertible::byte_buffer> buffer;
+    if (mEncodedTemplate) {
+        buffer.reset(new PatchedCamByteBuffer(obj.shared_ptr(), mEncodedTemplate));
+    } else {
+        buffer.reset(new CamByteBuffer(obj.shared_ptr()));
+    }
     payload->layer(OsiLayer::Application) = std::move(buffer);
     this->request(request, std::move(payload));
 }
 
-vanetza::asn1::Cam RsuCaService::createMessage() const
+vanetza::asn1::Cam RsuCaService::createMessage()
+{
+    if (isTemplateOutdated()) {
+        updateTemplate();
+    }
+
+    vanetza::asn1::Cam message = mCamTemplate;
+    const uint16_t genDeltaTime = countTaiMilliseconds(mTimer->getCurrentTime());
+    message->cam.generationDeltaTime = genDeltaTime * GenerationDeltaTime_oneMilliSec;
+    return message;
+}
+
+bool RsuCaService::isTemplateOutdated() const
+{
+    return !mHasTemplate || mTemplateStationId != mIdentity->application ||
+        mTemplatePosition.latitude != mGeoPosition->latitude ||
+        mTemplatePosition.longitude != mGeoPosition->longitude;
+}
+
+void RsuCaService::updateTemplate()
+{
+    mCamTemplate = createTemplate();
+    mTemplatePosition = *mGeoPosition;
+    mTemplateStationId = mIdentity->application;
+    mHasTemplate = true;
+
+    // encoding is patchable if generationDeltaTime is at its expected position
+    vanetza::ByteBuffer encoded = mCamTemplate.encode();
+    vanetza::asn1::Cam probe = mCamTemplate;
+    const GenerationDeltaTime_t probeDeltaTime = 0xa55a;
+    probe->cam.generationDeltaTime = probeDeltaTime;
+    vanetza::ByteBuffer expected = encoded;
+    if (expected.size() >= scGenerationDeltaTimeOffset + 2) {
+        patchGenerationDeltaTime(expected, probeDeltaTime);
+    }
+
+    if (expected == probe.encode()) {
+        mEncodedTemplate = std::make_shared<const vanetza::ByteBuffer>(std::move(encoded));
+    } else {
+        EV_WARN << "RSU CAM encoding cannot be patched, encoding every CAM from scratch\n";
+        mEncodedTemplate.reset();
+    }
+}
+
+vanetza::asn1::Cam RsuCaService::createTemplate() const
 {
     vanetza::asn1::Cam message;
     ItsPduHeader_t& header = (*message).header;
@@ -132,8 +231,7 @@ vanetza::asn1::Cam RsuCaService::createMessage() const
     header.stationID = mIdentity->application;
 
     CoopAwareness_t& cam = (*message).cam;
-    const uint16_t genDeltaTime = countTaiMilliseconds(mTimer->getCurrentTime());
-    cam.generationDeltaTime = genDeltaTime * GenerationDeltaTime_oneMilliSec;
+    cam.generationDeltaTime = 0;
     BasicContainer_t& basic = cam.camParameters.basicContainer;
     HighFrequencyContainer_t& hfc = cam.camParameters.highFrequencyContainer;
 
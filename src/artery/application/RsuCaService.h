@@ -9,15 +9,18 @@
 
 #include "artery/application/ItsG5BaseService.h"
 #include "artery/utility/Channel.h"
+#include "artery/utility/Geometry.h"
 #include <vanetza/asn1/cam.hpp>
+#include <vanetza/common/byte_buffer.hpp>
 #include <omnetpp/simtime.h>
 #include <boost/optional/optional.hpp>
+#include <cstdint>
 #include <list>
+#include <memory>
 
 namespace artery
 {
 
-class GeoPosition;
 class Identity;
 class LocalDynamicMap;
 class NetworkInterfaceTable;
@@ -29,6 +32,7 @@ class RsuCaService : public ItsG5BaseService
         void initialize() override;
         void indicate(const vanetza::btp::DataIndication&, std::unique_ptr<vanetza::UpPacket>) override;
         void trigger() override;
+        bool requiresTrigger() const override { return true; }
 
         struct ProtectedCommunicationZone
         {
@@ -43,7 +47,10 @@ class RsuCaService : public ItsG5BaseService
 
     private:
         void sendCam();
-        vanetza::asn1::Cam createMessage() const;
+        vanetza::asn1::Cam createMessage();
+        vanetza::asn1::Cam createTemplate() const;
+        bool isTemplateOutdated() const;
+        void updateTemplate();
 
         ChannelNumber mPrimaryChannel = channel::CCH;
         const NetworkInterfaceTable* mNetworkInterfaceTable = nullptr;
@@ -54,6 +61,13 @@ class RsuCaService : public ItsG5BaseService
         omnetpp::SimTime mGenerationInterval;
         omnetpp::SimTime mLastCamTimestamp;
         std::list<ProtectedCommunicationZone> mProtectedCommunicationZones;
+
+        // RSU CAMs differ only by their generation delta time, see createMessage()
+        vanetza::asn1::Cam mCamTemplate;
+        std::shared_ptr<const vanetza::ByteBuffer> mEncodedTemplate; /*< null if encoding cannot be patched */
+        GeoPosition mTemplatePosition;
+        uint32_t mTemplateStationId = 0;
+        bool mHasTemplate = false;
 };
 
 } // namespace artery
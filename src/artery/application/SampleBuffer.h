@@ -48,6 +48,7 @@ public:
     };
 
     void set_capacity(std::size_t n) { m_buffer.set_capacity(n); }
+    std::size_t capacity() const { return m_buffer.capacity(); }
     std::size_t size() const { return m_buffer.size(); }
     bool empty() const { return m_buffer.empty(); }
     bool full() const { return m_buffer.full(); }
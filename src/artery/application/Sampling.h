@@ -4,6 +4,9 @@
 #include "artery/application/SampleBuffer.h"
 #include <omnetpp/simtime.h>
 #include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <iterator>
 #include <stdexcept>
 
 template<typename IN, typename OUT = IN>
@@ -106,5 +109,156 @@ public:
     }
 };
 
+/**
+ * WindowedSampler skips early samples like SkipEarlySampler and maintains aggregates of its window
+ *
+ * Minimum and maximum are tracked by monotonic queues, the mean by a running sum.
+ * Additionally, the newest sample reaching a threshold is tracked.
+ * All queries take constant time, insertions take amortized constant time.
+ */
+template<typename T>
+class WindowedSampler : public IntervalSampler<T>
+{
+public:
+    using base_type = IntervalSampler<T>;
+    using value_type = typename base_type::buffer_type::value_type;
+
+    void setDuration(omnetpp::SimTime d)
+    {
+        base_type::setDuration(d);
+        rebuild();
+    }
+
+    void setInterval(omnetpp::SimTime interval)
+    {
+        base_type::setInterval(interval);
+        rebuild();
+    }
+
+    /**
+     * Set threshold for newestReachingThreshold(), previous samples are re-evaluated
+     */
+    void setThreshold(const T& threshold)
+    {
+        m_threshold = threshold;
+        m_has_threshold = true;
+        rebuild();
+    }
+
+    void feed(const typename base_type::input_type& sample, omnetpp::SimTime timestamp)
+    {
+        auto offset = base_type::offset(timestamp);
+        if (offset >= omnetpp::SimTime::ZERO && base_type::m_buffer.capacity() > 0) {
+            if (base_type::m_buffer.full()) {
+                evict();
+            }
+            base_type::m_buffer.insert(sample, timestamp);
+            push(sample);
+        }
+    }
+
+    const value_type* minimum() const { return m_minima.empty() ? nullptr : at(m_minima.front()); }
+    const value_type* maximum() const { return m_maxima.empty() ? nullptr : at(m_maxima.front()); }
+
+    /**
+     * Mean value of all buffered samples
+     * \note only meaningful if buffer is not empty
+     */
+    T mean() const
+    {
+        T result = m_sum;
+        if (!base_type::m_buffer.empty()) {
+            result /= static_cast<double>(base_type::m_buffer.size());
+        }
+        return result;
+    }
+
+    /**
+     * Find newest sample greater than or equal to threshold
+     * \param skip_latest ignore latest sample
+     * \return sample or nullptr if there is no such sample
+     */
+    const value_type* newestReachingThreshold(bool skip_latest = false) const
+    {
+        const std::size_t seq = skip_latest ? m_reaching_before_latest : m_reaching;
+        return seq != npos && isBuffered(seq) ? at(seq) : nullptr;
+    }
+
+private:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    // sequence numbers count inserted samples, i.e. newest sample has number m_inserted - 1
+    bool isBuffered(std::size_t seq) const
+    {
+        return seq < m_inserted && m_inserted - seq <= base_type::m_buffer.size();
+    }
+
+    const value_type* at(std::size_t seq) const
+    {
+        return &*(base_type::m_buffer.begin() + (m_inserted - 1 - seq));
+    }
+
+    void evict()
+    {
+        const std::size_t oldest = m_inserted - base_type::m_buffer.size();
+        m_sum -= std::prev(base_type::m_buffer.end())->value;
+        if (!m_minima.empty() && m_minima.front() == oldest) {
+            m_minima.pop_front();
+        }
+        if (!m_maxima.empty() && m_maxima.front() == oldest) {
+            m_maxima.pop_front();
+        }
+    }
+
+    void push(const T& sample)
+    {
+        const std::size_t seq = m_inserted++;
+        m_sum += sample;
+        while (!m_minima.empty() && !(at(m_minima.back())->value < sample)) {
+            m_minima.pop_back();
+        }
+        m_minima.push_back(seq);
+        while (!m_maxima.empty() && !(sample < at(m_maxima.back())->value)) {
+            m_maxima.pop_back();
+        }
+        m_maxima.push_back(seq);
+
+        m_reaching_before_latest = m_reaching;
+        if (m_has_threshold && !(sample < m_threshold)) {
+            m_reaching = seq;
+        }
+    }
+
+    void rebuild()
+    {
+        // buffer may have been cleared or shrunk, thus replay remaining samples from oldest to newest
+        typename base_type::buffer_type samples = base_type::m_buffer;
+        base_type::m_buffer.clear();
+        m_minima.clear();
+        m_maxima.clear();
+        m_sum = T();
+        m_inserted = 0;
+        m_reaching = npos;
+        m_reaching_before_latest = npos;
+        for (auto it = samples.end(); it != samples.begin();) {
+            --it;
+            base_type::m_buffer.insert(it->value, it->timestamp);
+            push(it->value);
+        }
+    }
+
+    std::deque<std::size_t> m_minima;
+    std::deque<std::size_t> m_maxima;
+    T m_sum = T();
+    T m_threshold = T();
+    bool m_has_threshold = false;
+    std::size_t m_inserted = 0;
+    std::size_t m_reaching = npos;
+    std::size_t m_reaching_before_latest = npos;
+};
+
+template<typename T>
+constexpr std::size_t WindowedSampler<T>::npos;
+
 #endif /* SAMPLING_H_3WCIABPU */
 
@@ -22,6 +22,7 @@ void StationaryMiddleware::initialize(int stage)
 {
     if (stage == InitStages::Self) {
         setStationType(vanetza::geonet::StationType::RSU);
+        setStaticStation(par("staticStation"));
 
         Identity identity;
         identity.application = Identity::deriveStationId(findHost(), par("stationIdDerivation").stringValue());
@@ -43,6 +44,10 @@ void StationaryMiddleware::receiveSignal(cComponent*, simsignal_t signal, cObjec
         auto position = check_and_cast<const vanetza::PositionFix*>(obj);
         mGeoPosition.latitude = position->latitude;
         mGeoPosition.longitude = position->longitude;
+        if (par("staticStation")) {
+            // position is fixed once and for all
+            findHost()->unsubscribe(scPositionFixSignal, this);
+        }
     }
 }
 
@@ -4,12 +4,38 @@
 #include "artery/application/TransportDispatcher.h"
 #include <omnetpp/clog.h>
 #include <vanetza/btp/header.hpp>
+#include <algorithm>
+#include <iterator>
 
 using namespace vanetza;
 
 namespace artery
 {
 
+namespace
+{
+
+struct ByKey
+{
+    template<typename K, typename V>
+    bool operator()(const std::pair<K, V>& entry, const K& key) const { return entry.first < key; }
+
+    template<typename K, typename V>
+    bool operator()(const K& key, const std::pair<K, V>& entry) const { return key < entry.first; }
+};
+
+template<typename K, typename V>
+void insertSorted(std::vector<std::pair<K, V>>& table, const K& key, V value)
+{
+    const std::pair<K, V> entry { key, value };
+    auto found = std::lower_bound(table.begin(), table.end(), entry);
+    if (found == table.end() || *found != entry) {
+        table.insert(found, entry);
+    }
+}
+
+} // namespace
+
 void TransportDispatcher::indicate(const geonet::DataIndication& gn_ind, std::unique_ptr<UpPacket> packet, const  NetworkInterface& net) const
 {
     if (gn_ind.upper_protocol == geonet::UpperProtocol::BTP_B && packet) {
@@ -18,25 +44,22 @@ void TransportDispatcher::indicate(const geonet::DataIndication& gn_ind, std::un
         btp::DataIndication btp_ind(gn_ind, hdr);
 
         // indicate promiscuous listeners
-        auto found_channel = mPromiscuousListeners.find(net.channel);
-        if (found_channel != mPromiscuousListeners.end()) {
-            for (TappingInterface* listener : found_channel->second) {
-                listener->tap(btp_ind, *packet, net);
-            }
+        auto tapping = std::equal_range(mPromiscuousListeners.begin(), mPromiscuousListeners.end(), net.channel, ByKey {});
+        for (auto it = tapping.first; it != tapping.second; ++it) {
+            it->second->tap(btp_ind, *packet, net);
         }
 
         // indicate regular listeners
-        auto found_descriptor = mListeners.find(std::make_tuple(net.channel, btp_ind.destination_port.host()));
-        if (found_descriptor != mListeners.end()) {
-            unsigned pending = found_descriptor->second.size();
-            for (IndicationInterface* listener : found_descriptor->second) {
-                if (pending > 1) {
-                    std::unique_ptr<vanetza::UpPacket> dup { new vanetza::UpPacket { *packet } };
-                    listener->indicate(btp_ind, std::move(dup), net);
-                } else {
-                    listener->indicate(btp_ind, std::move(packet), net);
-                }
-                --pending;
+        const TransportDescriptor td = std::make_tuple(net.channel, btp_ind.destination_port.host());
+        auto listeners = std::equal_range(mListeners.begin(), mListeners.end(), td, ByKey {});
+        auto pending = std::distance(listeners.first, listeners.second);
+        for (auto it = listeners.first; it != listeners.second; ++it, --pending) {
+            if (pending > 1) {
+                // copies of chunk packets share their application payload
+                std::unique_ptr<vanetza::UpPacket> dup { new vanetza::UpPacket { *packet } };
+                it->second->indicate(btp_ind, std::move(dup), net);
+            } else {
+                it->second->indicate(btp_ind, std::move(packet), net);
             }
         }
     } else {
@@ -48,14 +71,14 @@ void TransportDispatcher::indicate(const geonet::DataIndication& gn_ind, std::un
 void TransportDispatcher::addListener(IndicationInterface* ifc, const TransportDescriptor& td)
 {
     if (ifc) {
-        mListeners[td].insert(ifc);
+        insertSorted(mListeners, td, ifc);
     }
 }
 
 void TransportDispatcher::addPromiscuousListener(TappingInterface* ifc, ChannelNumber ch)
 {
     if (ifc) {
-        mPromiscuousListeners[ch].insert(ifc);
+        insertSorted(mPromiscuousListeners, ch, ifc);
     }
 }
 
@@ -4,8 +4,8 @@
 #include "artery/application/TransportDescriptor.h"
 #include "artery/utility/Channel.h"
 #include <vanetza/geonet/data_indication.hpp>
-#include <map>
-#include <set>
+#include <utility>
+#include <vector>
 
 namespace artery
 {
@@ -17,6 +17,9 @@ class TappingInterface;
 
 /**
  * TransportDispatcher forwards incoming BTP-B packets to matching listeners, i.e. ITS-G5 services
+ *
+ * Listeners are kept in flat arrays sorted by their keys. Listeners sharing a key are stored
+ * contiguously, so dispatching a packet takes one binary search per table.
  */
 class TransportDispatcher
 {
@@ -45,8 +48,11 @@ class TransportDispatcher
         void addPromiscuousListener(TappingInterface*, ChannelNumber ch = channel::CCH);
 
     private:
-        std::map<TransportDescriptor, std::set<IndicationInterface*>> mListeners;
-        std::map<ChannelNumber, std::set<TappingInterface*>> mPromiscuousListeners;
+        using Listener = std::pair<TransportDescriptor, IndicationInterface*>;
+        using PromiscuousListener = std::pair<ChannelNumber, TappingInterface*>;
+
+        std::vector<Listener> mListeners;
+        std::vector<PromiscuousListener> mPromiscuousListeners;
 };
 
 } // namespace artery
@@ -27,43 +27,63 @@
 #include <vanetza/units/angular_velocity.hpp>
 #include <cassert>
 #include <cmath>
-#include <limits>
 #include <random>
-#include <stdexcept>
+#include <type_traits>
 
 namespace artery
 {
 
 const double pi = boost::math::constants::pi<double>();
-const auto degree_per_second_squared = vanetza::units::degree / (vanetza::units::si::second * vanetza::units::si::second);
-const std::map<VehicleDataProvider::AngularAcceleration, double> VehicleDataProvider::mConfidenceTable {
-    { AngularAcceleration(0.0 * degree_per_second_squared), 1.0 },
-    { AngularAcceleration(0.5 * degree_per_second_squared), 0.9 },
-    { AngularAcceleration(1.0 * degree_per_second_squared), 0.8 },
-    { AngularAcceleration(1.5 * degree_per_second_squared), 0.7 },
-    { AngularAcceleration(2.0 * degree_per_second_squared), 0.6 },
-    { AngularAcceleration(2.5 * degree_per_second_squared), 0.5 },
-    { AngularAcceleration(5.0 * degree_per_second_squared), 0.4 },
-    { AngularAcceleration(10.0 * degree_per_second_squared), 0.3 },
-    { AngularAcceleration(15.0 * degree_per_second_squared), 0.2 },
-    { AngularAcceleration(20.0 * degree_per_second_squared), 0.1 },
-    { AngularAcceleration(25.0 * degree_per_second_squared), 0.0 },
-    { AngularAcceleration(std::numeric_limits<double>::infinity() * degree_per_second_squared), 0.0 }
-};
 
+namespace
+{
+
+// apply filters at least once per this many updates, bounds memory of unread providers
+const std::size_t maxPendingFilterInputs = 64;
+
+// confidence of curvature by filtered angular acceleration in degree/s^2, see lower bounds
+// steps of 0.5 degree/s^2 up to 2.5 degree/s^2, followed by steps of 5 degree/s^2 up to 25 degree/s^2
+constexpr double fineConfidenceTable[] = { 1.0, 0.9, 0.8, 0.7, 0.6, 0.5 };
+constexpr double fineConfidenceStep = 0.5;
+constexpr double coarseConfidenceTable[] = { 0.5, 0.4, 0.3, 0.2, 0.1, 0.0 };
+constexpr double coarseConfidenceStep = 5.0;
+
+} // namespace
 
 VehicleDataProvider::VehicleDataProvider(uint32_t id) :
 	mStationId(id), mStationType(StationType::Unknown),
-	mConfidence(0.0), mLastUpdate(omnetpp::SimTime::getMaxTime()),
+	mLastUpdate(omnetpp::SimTime::getMaxTime()), mConfidence(0.0),
 	mCurvatureOutput(2), mCurvatureConfidenceOutput(2)
 {
+	mFilterInputs.reserve(maxPendingFilterInputs);
 	while (!mCurvatureConfidenceOutput.full()) {
 		using namespace vanetza::units::si;
 		mCurvatureConfidenceOutput.push_front(0.0 * radians_per_second / second);
 	}
 }
 
-void VehicleDataProvider::calculateCurvature()
+vanetza::units::Curvature VehicleDataProvider::curvature() const
+{
+	applyFilters();
+	return mCurvature;
+}
+
+double VehicleDataProvider::curvature_confidence() const
+{
+	applyFilters();
+	return mConfidence;
+}
+
+void VehicleDataProvider::applyFilters() const
+{
+	for (const FilterInput& input : mFilterInputs) {
+		calculateCurvature(input);
+		calculateCurvatureConfidence(input);
+	}
+	mFilterInputs.clear();
+}
+
+void VehicleDataProvider::calculateCurvature(const FilterInput& input) const
 {
 	using namespace vanetza::units::si;
 	static const vanetza::units::Frequency f_cut = 0.33 * hertz;
@@ -72,12 +92,12 @@ void VehicleDataProvider::calculateCurvature()
 	static const vanetza::units::Curvature upper_threshold = 1.0 * vanetza::units::reciprocal_metre;
 	static const double damping = 1.0;
 
-	if (fabs(mVehicleKinematics.speed) < 1.0 * meter_per_second) {
+	if (fabs(input.speed) < 1.0 * meter_per_second) {
 		// assume straight road below minimum speed
 		mCurvature = 0.0 * vanetza::units::reciprocal_metre;
 	} else {
 		// curvature calculation algorithm
-		mCurvature = (mVehicleKinematics.yaw_rate / radians) / mVehicleKinematics.speed;
+		mCurvature = (input.yaw_rate / radians) / input.speed;
 
 		if (!mCurvatureOutput.full()) {
 			// save first two values for initialization
@@ -102,7 +122,7 @@ void VehicleDataProvider::calculateCurvature()
 	}
 }
 
-void VehicleDataProvider::calculateCurvatureConfidence()
+void VehicleDataProvider::calculateCurvatureConfidence(const FilterInput& input) const
 {
 	assert(mCurvatureConfidenceOutput.full());
 	using namespace vanetza::units::si;
@@ -113,11 +133,11 @@ void VehicleDataProvider::calculateCurvatureConfidence()
 
 	AngularAcceleration filter = -mCurvatureConfidenceOutput[1] +
 		(2.0 + 2.0 * omega * damping * t_sample) * mCurvatureConfidenceOutput[0] +
-		omega * omega * t_sample * mVehicleKinematics.yaw_rate -
+		omega * omega * t_sample * input.yaw_rate -
 		omega * omega * t_sample * mCurvatureConfidenceInput;
 	filter /= 1.0 + 2.0 * omega * damping * t_sample + omega * omega * t_sample * t_sample;
 	mCurvatureConfidenceOutput.push_front(filter);
-	mCurvatureConfidenceInput = mVehicleKinematics.yaw_rate;
+	mCurvatureConfidenceInput = input.yaw_rate;
 	mConfidence = mapOntoConfidence(abs(filter));
 }
 
@@ -165,17 +185,25 @@ void VehicleDataProvider::update(const VehicleKinematics& dynamics)
 	}
 
 	mLastUpdate = simTime();
-	calculateCurvature();
-	calculateCurvatureConfidence();
+	mFilterInputs.push_back({ mVehicleKinematics.yaw_rate, mVehicleKinematics.speed });
+	if (mFilterInputs.size() >= maxPendingFilterInputs) {
+		applyFilters();
+	}
 }
 
-double VehicleDataProvider::mapOntoConfidence(AngularAcceleration x) const
+double VehicleDataProvider::mapOntoConfidence(AngularAcceleration x)
 {
-	auto it = mConfidenceTable.lower_bound(x);
-	if (it == mConfidenceTable.end()) {
-		throw std::domain_error("input value is less than smallest entry in confidence table");
+	static const double rad2deg = 180.0 / pi;
+	const double value = x.value() * rad2deg;
+	if (!(value > 0.0)) {
+		return fineConfidenceTable[0];
+	} else if (value <= fineConfidenceStep * (std::extent<decltype(fineConfidenceTable)>::value - 1)) {
+		return fineConfidenceTable[static_cast<std::size_t>(std::ceil(value / fineConfidenceStep))];
+	} else if (value <= coarseConfidenceStep * (std::extent<decltype(coarseConfidenceTable)>::value - 1)) {
+		return coarseConfidenceTable[static_cast<std::size_t>(std::ceil(value / coarseConfidenceStep))];
+	} else {
+		return 0.0;
 	}
-	return it->second;
 }
 
 void VehicleDataProvider::setStationType(StationType type)
@@ -31,7 +31,7 @@
 #include <vanetza/units/angular_velocity.hpp>
 #include <vanetza/units/curvature.hpp>
 #include <cstdint>
-#include <map>
+#include <vector>
 
 namespace artery
 {
@@ -57,8 +57,8 @@ class VehicleDataProvider
 		vanetza::units::Acceleration acceleration() const { return mVehicleKinematics.acceleration; }
 		vanetza::units::Angle heading() const { return mVehicleKinematics.heading; } // degree from north, clockwise
 		vanetza::units::AngularVelocity yaw_rate() const { return mVehicleKinematics.yaw_rate; } // left turn positive
-		vanetza::units::Curvature curvature() const { return mCurvature; } // 1/m radius, left turn positive
-		double curvature_confidence() const { return mConfidence; } // percentage value
+		vanetza::units::Curvature curvature() const; // 1/m radius, left turn positive
+		double curvature_confidence() const; // percentage value
 
 		void setStationType(StationType);
 		StationType getStationType() const;
@@ -69,20 +69,29 @@ class VehicleDataProvider
 
 	private:
 		typedef boost::units::quantity<boost::units::si::angular_acceleration> AngularAcceleration;
-		void calculateCurvature();
-		void calculateCurvatureConfidence();
-		double mapOntoConfidence(AngularAcceleration) const;
+
+		struct FilterInput
+		{
+			vanetza::units::AngularVelocity yaw_rate;
+			vanetza::units::Velocity speed;
+		};
+
+		// curvature filters are applied lazily, i.e. when their output is read
+		void applyFilters() const;
+		void calculateCurvature(const FilterInput&) const;
+		void calculateCurvatureConfidence(const FilterInput&) const;
+		static double mapOntoConfidence(AngularAcceleration);
 
 		uint32_t mStationId;
 		StationType mStationType;
 		VehicleKinematics mVehicleKinematics;
-		vanetza::units::Curvature mCurvature;
-		double mConfidence;
 		omnetpp::SimTime mLastUpdate;
-		boost::circular_buffer<vanetza::units::Curvature> mCurvatureOutput;
-		boost::circular_buffer<AngularAcceleration> mCurvatureConfidenceOutput;
-		vanetza::units::AngularVelocity mCurvatureConfidenceInput;
-		static const std::map<AngularAcceleration, double> mConfidenceTable;
+		mutable std::vector<FilterInput> mFilterInputs; /*< pending inputs of curvature filters */
+		mutable vanetza::units::Curvature mCurvature;
+		mutable double mConfidence;
+		mutable boost::circular_buffer<vanetza::units::Curvature> mCurvatureOutput;
+		mutable boost::circular_buffer<AngularAcceleration> mCurvatureConfidenceOutput;
+		mutable vanetza::units::AngularVelocity mCurvatureConfidenceInput;
 };
 
 } // namespace artery
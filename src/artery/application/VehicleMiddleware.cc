@@ -71,5 +71,11 @@ void VehicleMiddleware::receiveSignal(cComponent* component, simsignal_t signal,
 	}
 }
 
+std::set<int> VehicleMiddleware::getConsumedVehicleVariables() const
+{
+    // VehicleDataProvider is updated with the vehicle's speed
+    return { libsumo::VAR_SPEED };
+}
+
 } // namespace artery
 
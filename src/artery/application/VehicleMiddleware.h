@@ -10,17 +10,21 @@
 #include "artery/application/Middleware.h"
 #include "artery/application/VehicleDataProvider.h"
 #include "artery/traci/VehicleController.h"
+#include "traci/VehicleVariableConsumer.h"
 
 namespace artery
 {
 
-class VehicleMiddleware : public Middleware
+class VehicleMiddleware : public Middleware, public traci::VehicleVariableConsumer
 {
     public:
         VehicleMiddleware();
         void initialize(int stage) override;
         void finish() override;
 
+        // traci::VehicleVariableConsumer (VehicleDataProvider)
+        std::set<int> getConsumedVehicleVariables() const override;
+
     protected:
         void initializeStationType(const std::string&);
         void initializeVehicleController(omnetpp::cPar&);
@@ -28,19 +28,19 @@
 namespace vanetza {
 namespace convertible {
 
+/**
+ * Byte buffer carrying a cPacket
+ *
+ * Duplicates share the carried packet, which is treated as immutable while it is shared.
+ * Hence, a packet passed to several network interfaces or listeners is only copied when it
+ * is consumed while further buffers still refer to it.
+ */
 template<>
-class byte_buffer_impl<omnetpp::cPacket*> : public byte_buffer, private omnetpp::cObject
+class byte_buffer_impl<omnetpp::cPacket*> : public byte_buffer
 {
 	public:
-		byte_buffer_impl(omnetpp::cPacket* packet) : m_packet(packet)
+		byte_buffer_impl(omnetpp::cPacket* packet) : m_holder(std::make_shared<holder>(packet))
 		{
-			assert(packet);
-			take(m_packet.get());
-		}
-
-		~byte_buffer_impl()
-		{
-			drop_packet();
 		}
 
 		void convert(ByteBuffer& buf) const override
@@ -52,31 +52,54 @@ class byte_buffer_impl<omnetpp::cPacket*> : public byte_buffer, private omnetpp:
 
 		std::size_t size() const override
 		{
-			return m_packet->getByteLength();
+			return m_holder->packet->getByteLength();
 		}
 
 		std::unique_ptr<byte_buffer> duplicate() const override
 		{
 			return std::unique_ptr<byte_buffer> {
-				new byte_buffer_impl<omnetpp::cPacket*>(m_packet->dup())
+				new byte_buffer_impl<omnetpp::cPacket*>(m_holder)
 			};
 		}
 
 		omnetpp::cPacket* consume()
 		{
-			drop_packet();
-			return m_packet.release();
+			omnetpp::cPacket* packet = m_holder.use_count() > 1 ? m_holder->packet->dup() : m_holder->release();
+			m_holder.reset();
+			return packet;
 		}
 
 	private:
-		void drop_packet()
+		class holder : private omnetpp::cObject
+		{
+			public:
+				holder(omnetpp::cPacket* p) : packet(p)
+				{
+					assert(p);
+					take(p);
+				}
+
+				~holder()
+				{
+					if (packet) {
+						drop(packet.get());
+					}
+				}
+
+				omnetpp::cPacket* release()
+				{
+					drop(packet.get());
+					return packet.release();
+				}
+
+				std::unique_ptr<omnetpp::cPacket> packet;
+		};
+
+		byte_buffer_impl(std::shared_ptr<holder> shared) : m_holder(std::move(shared))
 		{
-			if (m_packet) {
-				drop(m_packet.get());
-			}
 		}
 
-		std::unique_ptr<omnetpp::cPacket> m_packet;
+		std::shared_ptr<holder> m_holder;
 };
 
 }
@@ -36,9 +36,18 @@ void EmergencyBrakeLight::initialize(int stage)
     }
 }
 
-void EmergencyBrakeLight::check()
+void EmergencyBrakeLight::sample()
 {
     mAccelerationSampler.feed(mVdp->acceleration(), mVdp->updated());
+}
+
+bool EmergencyBrakeLight::checkPreconditions()
+{
+    return checkEgoSpeed();
+}
+
+void EmergencyBrakeLight::check()
+{
     if (!isDetectionBlocked() && checkConditions())
     {
         blockDetection();
@@ -20,6 +20,7 @@ namespace den
 class EmergencyBrakeLight : public SuspendableUseCase
 {
 public:
+    void sample() override;
     void check() override;
     void indicate(const artery::DenmObject&) override {};
     void handleStoryboardTrigger(const StoryboardSignal&) override {};
@@ -27,6 +28,7 @@ public:
 protected:
     void initialize(int) override;
 
+    bool checkPreconditions() override;
     bool checkConditions();
     bool checkEgoDeceleration() const;
     bool checkEgoSpeed() const;
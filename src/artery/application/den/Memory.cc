@@ -51,14 +51,11 @@ bool operator<(const INTEGER_t& lhs, const INTEGER_t& rhs)
 
 Reception::Reception(const DenmObject& object) :
     timestamp(omnetpp::simTime()),
-    message(object.shared_ptr())
+    message(object.shared_ptr()),
+    m_action_id((*message)->denm.management.actionID)
 {
-}
-
-vanetza::Clock::time_point Reception::expiry() const
-{
-    unsigned long detectionTimeRaw = 0;
     const ManagementContainer_t& denmManagement = (*message)->denm.management;
+    unsigned long detectionTimeRaw = 0;
     if (asn_INTEGER2ulong(&denmManagement.detectionTime, &detectionTimeRaw) != 0) {
         throw std::range_error("DENM detectionTime cannot be converted to unsigned long");
     }
@@ -68,23 +65,18 @@ vanetza::Clock::time_point Reception::expiry() const
     if (denmManagement.validityDuration) {
         validityDuration = std::chrono::seconds(*denmManagement.validityDuration / ValidityDuration_oneSecondAfterDetection);
     }
+    m_expiry = detectionTime + validityDuration;
 
-    return detectionTime + validityDuration;
-}
-
-ActionID Reception::action_id() const
-{
-    return ActionID((*message)->denm.management.actionID);
-}
-
-CauseCode Reception::cause_code() const
-{
     const SituationContainer* situation = (*message)->denm.situation;
     if (situation) {
-        return convert(situation->eventType.causeCode);
+        m_cause_code = convert(situation->eventType.causeCode);
     } else {
-        return static_cast<CauseCode>(0);
+        m_cause_code = static_cast<CauseCode>(0);
     }
+
+    const ReferencePosition_t& event = denmManagement.eventPosition;
+    m_event_position.latitude = event.latitude / (1e6 * Latitude_oneMicrodegreeNorth) * boost::units::degree::degrees;
+    m_event_position.longitude = event.longitude / (1e6 * Longitude_oneMicrodegreeEast) * boost::units::degree::degrees;
 }
 
 Memory::Memory(const Timer& timer) :
@@ -122,6 +114,17 @@ unsigned Memory::count(CauseCode cause_code) const
     return idx_cause_code.count(cause_code);
 }
 
+unsigned Memory::count(CauseCode cause_code, const GeoPosition& center, Position::value_type radius) const
+{
+    unsigned result = 0;
+    for (const Reception& reception : messages(cause_code)) {
+        if (distance(center, reception.event_position()) <= radius) {
+            ++result;
+        }
+    }
+    return result;
+}
+
 auto Memory::messages(CauseCode cause_code) const -> boost::iterator_range<cause_code_iterator>
 {
     auto& idx_cause_code = m_container.get<by_cause_code>();
@@ -8,6 +8,7 @@
 #define ARTERY_DEN_MEMORY_H_NNPEDDM9
 
 #include "artery/application/DenmObject.h"
+#include "artery/utility/Geometry.h"
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/mem_fun.hpp>
 #include <boost/multi_index/ordered_index.hpp>
@@ -36,6 +37,9 @@ struct ActionID
 bool operator<(const ActionID&, const ActionID&);
 bool operator==(const ActionID&, const ActionID&);
 
+/**
+ * Received DENM along with its index keys, which are decoded once on reception
+ */
 struct Reception
 {
     Reception(const DenmObject&);
@@ -43,9 +47,16 @@ struct Reception
     omnetpp::SimTime timestamp;
     std::shared_ptr<const vanetza::asn1::Denm> message;
 
-    vanetza::Clock::time_point expiry() const;
-    ActionID action_id() const;
-    CauseCode cause_code() const;
+    vanetza::Clock::time_point expiry() const { return m_expiry; }
+    ActionID action_id() const { return m_action_id; }
+    CauseCode cause_code() const { return m_cause_code; }
+    const GeoPosition& event_position() const { return m_event_position; }
+
+private:
+    vanetza::Clock::time_point m_expiry;
+    ActionID m_action_id;
+    CauseCode m_cause_code;
+    GeoPosition m_event_position;
 };
 
 class Memory
@@ -76,6 +87,15 @@ public:
     unsigned count(CauseCode) const;
     boost::iterator_range<cause_code_iterator> messages(CauseCode) const;
 
+    /**
+     * Count DENMs of a cause with event positions in a relevance area
+     * \param cause cause code of counted DENMs
+     * \param center center of circular relevance area, e.g. ego position
+     * \param radius radius of relevance area
+     * \return number of relevant DENMs
+     */
+    unsigned count(CauseCode cause, const GeoPosition& center, Position::value_type radius) const;
+
 private:
     const Timer& m_timer;
     container_type m_container;
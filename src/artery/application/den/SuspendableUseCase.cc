@@ -36,6 +36,8 @@ bool SuspendableUseCase::isDetectionBlocked()
 void SuspendableUseCase::blockDetection()
 {
     mDetectionBlockingSince = omnetpp::simTime();
+    // detection is blocked anyway, hence skip checks till then
+    suspendCheck(*mDetectionBlockingSince + mDetectionBlockingInterval);
 }
 
 } // namespace den
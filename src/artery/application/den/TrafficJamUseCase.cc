@@ -23,6 +23,7 @@
 
 static const auto hour = 3600.0 * boost::units::si::seconds;
 static const auto km_per_hour = boost::units::si::kilo * boost::units::si::meter / hour;
+static const vanetza::units::Velocity endOfQueueInitialVelocity { 80.0 * km_per_hour };
 
 using omnetpp::SIMTIME_S;
 using omnetpp::SIMTIME_MS;
@@ -35,6 +36,23 @@ namespace artery
 namespace den
 {
 
+namespace
+{
+
+unsigned countRelevant(const Memory& memory, CauseCode cause, const VehicleDataProvider& vdp, Position::value_type radius)
+{
+    if (radius.value() > 0.0) {
+        GeoPosition ego;
+        ego.latitude = vdp.latitude();
+        ego.longitude = vdp.longitude();
+        return memory.count(cause, ego, radius);
+    } else {
+        return memory.count(cause);
+    }
+}
+
+} // namespace
+
 void TrafficJamEndOfQueue::initialize(int stage)
 {
     UseCase::initialize(stage);
@@ -42,14 +60,20 @@ void TrafficJamEndOfQueue::initialize(int stage)
     {
         mNonUrbanEnvironment = par("nonUrbanEnvironment").boolValue();
         mDenmMemory = mService->getMemory();
+        mRelevanceDistance = par("relevanceDistance").doubleValue() * boost::units::si::meter;
         mVelocitySampler.setDuration(par("sampleDuration"));
         mVelocitySampler.setInterval(par("sampleInterval"));
+        mVelocitySampler.setThreshold(endOfQueueInitialVelocity);
     }
 }
 
-void TrafficJamEndOfQueue::check()
+void TrafficJamEndOfQueue::sample()
 {
     mVelocitySampler.feed(mVdp->speed(), mVdp->updated());
+}
+
+void TrafficJamEndOfQueue::check()
+{
     if (!isDetectionBlocked() && checkPreconditions() && checkConditions())
     {
         blockDetection();
@@ -61,20 +85,22 @@ void TrafficJamEndOfQueue::check()
 
 bool TrafficJamEndOfQueue::checkPreconditions()
 {
-    return mNonUrbanEnvironment;
+    // ego deceleration (tc0) is mandatory as long as hazard lights (tc1, tc2) are not simulated
+    static const vanetza::units::Velocity targetVelocityThreshold { 30.0 * km_per_hour };
+    const auto& velocitySamples = mVelocitySampler.buffer();
+    return mNonUrbanEnvironment && !velocitySamples.empty() && velocitySamples.latest().value <= targetVelocityThreshold;
 }
 
 bool TrafficJamEndOfQueue::checkConditions()
 {
-    const TriggeringCondition tc0 = std::bind(&TrafficJamEndOfQueue::checkEgoDeceleration, this);
     const bool tc1 = false; // there are no passengers in ego vehicle enabling hazard lights, assume false
     const bool tc2 = false; // so far no simulated vehicle enables hazard lights, assume false
-    const TriggeringCondition tc3 = std::bind(&TrafficJamEndOfQueue::checkEndOfQueueReceived, this);
-    const TriggeringCondition tc4 = std::bind(&TrafficJamEndOfQueue::checkJamAheadReceived, this);
     const bool tc5 = false; // so far there are no emergency vehicles in simulation, assume false
     const bool tc6 = false; // simulated vehicle has no on-board sensors for end of queue detection, assume false
 
-    return (tc1 && tc2) || (tc0() && (tc2 || tc3() || tc4() || tc5 || tc6));
+    // evaluate expensive conditions tc0, tc3 and tc4 lazily
+    return (tc1 && tc2) || (checkEgoDeceleration() &&
+        (tc2 || checkEndOfQueueReceived() || checkJamAheadReceived() || tc5 || tc6));
 }
 
 bool TrafficJamEndOfQueue::checkEgoDeceleration() const
@@ -86,7 +112,6 @@ bool TrafficJamEndOfQueue::checkEgoDeceleration() const
     using boost::units::si::meter_per_second_squared;
 
     static const Velocity targetVelocityThreshold { 30.0 * km_per_hour };
-    static const Velocity initialVelocityThreshold { 80.0 * km_per_hour };
     static const Acceleration initialDecelThreshold { -0.1 * meter_per_second_squared };
     static const Duration instantDecelDuration { 10.0 * seconds };
     static const Acceleration instantDecelThreshold { -3.5 * meter_per_second_squared };
@@ -96,10 +121,9 @@ bool TrafficJamEndOfQueue::checkEgoDeceleration() const
 
     // current velocity shall not exceed target velocity
     if (!velocitySamples.empty() && velocitySamples.latest().value <= targetVelocityThreshold) {
-        // find the newest sample above initial velocity threshold
-        auto initialVelocity = std::find_if(std::next(velocitySamples.begin()), velocitySamples.end(),
-                [](const Sample<Velocity>& s) { return s.value >= initialVelocityThreshold; });
-        if (initialVelocity != velocitySamples.end()) {
+        // newest sample above initial velocity threshold (endOfQueueInitialVelocity) is tracked by sampler
+        auto initialVelocity = mVelocitySampler.newestReachingThreshold(true);
+        if (initialVelocity) {
             // should never fail because only 10s are buffered at all
             assert(duration(*initialVelocity, velocitySamples.latest()) < instantDecelDuration);
             fulfilled = differentiate(*initialVelocity, velocitySamples.latest()) < instantDecelThreshold;
@@ -111,14 +135,12 @@ bool TrafficJamEndOfQueue::checkEgoDeceleration() const
 
 bool TrafficJamEndOfQueue::checkEndOfQueueReceived() const
 {
-    // TODO relevance check for ego vehicle is missing
-    return mDenmMemory->count(CauseCode::DangerousEndOfQueue) >= 1;
+    return countRelevant(*mDenmMemory, CauseCode::DangerousEndOfQueue, *mVdp, mRelevanceDistance) >= 1;
 }
 
 bool TrafficJamEndOfQueue::checkJamAheadReceived() const
 {
-    // TODO relevance check for ego vehicle is missing
-    return mDenmMemory->count(CauseCode::TrafficCondition) >= 5;
+    return countRelevant(*mDenmMemory, CauseCode::TrafficCondition, *mVdp, mRelevanceDistance) >= 5;
 }
 
 vanetza::asn1::Denm TrafficJamEndOfQueue::createMessage()
@@ -174,6 +196,7 @@ void TrafficJamAhead::initialize(int stage)
     if (stage == 0) {
         mNonUrbanEnvironment = par("nonUrbanEnvironment").boolValue();
         mDenmMemory = mService->getMemory();
+        mRelevanceDistance = par("relevanceDistance").doubleValue() * boost::units::si::meter;
         mVelocitySampler.setDuration(par("sampleDuration"));
         mVelocitySampler.setInterval(par("sampleInterval"));
         mUpdateCounter = 0;
@@ -181,9 +204,13 @@ void TrafficJamAhead::initialize(int stage)
     }
 }
 
-void TrafficJamAhead::check()
+void TrafficJamAhead::sample()
 {
     mVelocitySampler.feed(mVdp->speed(), mVdp->updated());
+}
+
+void TrafficJamAhead::check()
+{
     if (!isDetectionBlocked() && checkPreconditions() && checkConditions())
     {
         blockDetection();
@@ -201,14 +228,12 @@ bool TrafficJamAhead::checkPreconditions()
 
 bool TrafficJamAhead::checkConditions()
 {
-    const TriggeringCondition tc0 = std::bind(&TrafficJamAhead::checkLowAverageEgoVelocity, this);
-    const TriggeringCondition tc1 = std::bind(&TrafficJamAhead::checkStationaryEgo, this);
-    const TriggeringCondition tc2 = std::bind(&TrafficJamAhead::checkTrafficJamAheadReceived, this);
     const bool tc3 = false; // no mobile radio equipment available (yet)
-    const TriggeringCondition tc4 = std::bind(&TrafficJamAhead::checkSlowVehiclesAheadByV2X, this);
     const bool tc5 = false; // no on-board sensors available (yet)
 
-    return tc0() || (tc1() && (tc2() || tc3 || tc4() || tc5));
+    // evaluate expensive conditions tc0, tc1, tc2 and tc4 lazily
+    return checkLowAverageEgoVelocity() || (checkStationaryEgo() &&
+        (checkTrafficJamAheadReceived() || tc3 || checkSlowVehiclesAheadByV2X() || tc5));
 }
 
 bool TrafficJamAhead::checkLowAverageEgoVelocity() const
@@ -247,8 +272,7 @@ bool TrafficJamAhead::checkStationaryEgo() const
 
 bool TrafficJamAhead::checkTrafficJamAheadReceived() const
 {
-    // TODO relevance check is missing
-    return mDenmMemory->count(CauseCode::TrafficCondition) >= 1;
+    return countRelevant(*mDenmMemory, CauseCode::TrafficCondition, *mVdp, mRelevanceDistance) >= 1;
 }
 
 bool TrafficJamAhead::checkSlowVehiclesAheadByV2X() const
@@ -39,6 +39,7 @@ public:
     vanetza::asn1::Denm createMessage();
     vanetza::btp::DataRequestB createRequest();
 
+    void sample() override;
     void check() override;
     void indicate(const artery::DenmObject&) override {};
     void handleStoryboardTrigger(const StoryboardSignal&) override {};
@@ -46,7 +47,7 @@ public:
 protected:
     void initialize(int) override;
 
-    bool checkPreconditions();
+    bool checkPreconditions() override;
     bool checkConditions();
     bool checkEgoDeceleration() const;
     bool checkEndOfQueueReceived() const;
@@ -54,8 +55,9 @@ protected:
 
 private:
     std::shared_ptr<const Memory> mDenmMemory;
+    Position::value_type mRelevanceDistance; /*< only DENMs with events nearby are considered if positive */
     bool mNonUrbanEnvironment;
-    SkipEarlySampler<vanetza::units::Velocity> mVelocitySampler;
+    WindowedSampler<vanetza::units::Velocity> mVelocitySampler;
 };
 
 class TrafficJamAhead : public SuspendableUseCase
@@ -71,6 +73,7 @@ public:
     vanetza::btp::DataRequestB createRequest();
     vanetza::asn1::Denm createMessage();
 
+    void sample() override;
     void check() override;
     void indicate(const artery::DenmObject&) override {};
     void handleStoryboardTrigger(const StoryboardSignal&) override {};
@@ -78,7 +81,7 @@ public:
 protected:
     void initialize(int) override;
 
-    bool checkPreconditions();
+    bool checkPreconditions() override;
     bool checkConditions();
     bool checkLowAverageEgoVelocity() const;
     bool checkStationaryEgo() const;
@@ -87,6 +90,7 @@ protected:
 
 private:
     std::shared_ptr<const den::Memory> mDenmMemory;
+    Position::value_type mRelevanceDistance; /*< only DENMs with events nearby are considered if positive */
     const LocalDynamicMap* mLocalDynamicMap;
     bool mNonUrbanEnvironment;
     unsigned mUpdateCounter;
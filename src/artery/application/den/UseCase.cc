@@ -29,6 +29,11 @@ void UseCase::initialize(int stage)
     }
 }
 
+bool UseCase::isCheckDue()
+{
+    return omnetpp::simTime() >= mCheckSuspendedUntil && checkPreconditions();
+}
+
 vanetza::asn1::Denm UseCase::createMessageSkeleton()
 {
     vanetza::asn1::Denm message;
@@ -8,6 +8,7 @@
 #define ARTERY_DEN_USECASE_H_
 
 #include <omnetpp/csimplemodule.h>
+#include <omnetpp/simtime.h>
 #include <vanetza/asn1/denm.hpp>
 #include <functional>
 
@@ -24,10 +25,23 @@ namespace den
 class UseCase : public omnetpp::cSimpleModule
 {
 public:
+    /**
+     * Record data needed by triggering conditions, e.g. samples of ego kinematics
+     * \note invoked for each middleware time step (trigger) before the precondition gate
+     */
+    virtual void sample() {}
+
+    /**
+     * Cheap gate preceding check()
+     * \return false if triggering conditions cannot be fulfilled at this time step
+     * \note check() is not invoked by DenService while gate is closed
+     */
+    bool isCheckDue();
+
     /**
      * Evaluate use case triggering conditions
      * Generates DENM if neccessary
-     * \note invoked for each middleware time step (trigger)
+     * \note invoked for each middleware time step (trigger) passing the precondition gate
      */
     virtual void check() = 0;
 
@@ -51,10 +65,26 @@ public:
 protected:
     using TriggeringCondition = std::function<bool(void)>;
 
+    /**
+     * Preconditions of use case, e.g. environment flags or ego speed band
+     * \note keep this cheap, expensive conditions belong to check()
+     * \return true if triggering conditions may be fulfilled
+     */
+    virtual bool checkPreconditions() { return true; }
+
+    /**
+     * Close precondition gate until given time, e.g. while detection is blocked
+     * \param until gate opens again at this time
+     */
+    void suspendCheck(omnetpp::SimTime until) { mCheckSuspendedUntil = until; }
+
     virtual vanetza::asn1::Denm createMessageSkeleton();
 
     DenService* mService = nullptr;
     const VehicleDataProvider* mVdp = nullptr;
+
+private:
+    omnetpp::SimTime mCheckSuspendedUntil;
 };
 
 } // namespace den
@@ -7,17 +7,28 @@
 #include "artery/envmod/GlobalEnvironmentModel.h"
 #include "artery/envmod/Geometry.h"
 #include "artery/envmod/TraCIEnvironmentModelObject.h"
+#include "artery/envmod/sensor/Sensor.h"
 #include "artery/envmod/sensor/SensorConfiguration.h"
 #include "artery/traci/Cast.h"
 #include "artery/traci/ControllableVehicle.h"
 #include "artery/traci/ControllablePerson.h"
+#include "artery/traci/VehicleController.h"
 #include "artery/utility/IdentityRegistry.h"
+#include "artery/utility/ObstaclePreprocessor.h"
+#include "artery/utility/ObstacleRegistry.h"
+#include "artery/utility/ProfilingScope.h"
+#include "artery/utility/TaskScheduler.h"
+#include "artery/utility/VehicleGeometryIndex.h"
+#include "traci/BasicNodeManager.h"
 #include "traci/Core.h"
 #include <boost/geometry/geometries/register/linestring.hpp>
+#include <boost/math/constants/constants.hpp>
+#include <boost/range/adaptor/filtered.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include <inet/common/ModuleAccess.h>
 #include <algorithm>
 #include <array>
+#include <cmath>
 
 using namespace omnetpp;
 
@@ -34,6 +45,8 @@ const simsignal_t traciCloseSignal = cComponent::registerSignal("traci.close");
 const simsignal_t traciNodeAddSignal = cComponent::registerSignal("traci.node.add");
 const simsignal_t traciNodeRemoveSignal = cComponent::registerSignal("traci.node.remove");
 const simsignal_t traciNodeUpdateSignal = cComponent::registerSignal("traci.node.update");
+const simsignal_t traciVehicleAddSignal = cComponent::registerSignal("traci.vehicle.add");
+const simsignal_t traciVehicleRemoveSignal = cComponent::registerSignal("traci.vehicle.remove");
 
 template<typename RT>
 typename RT::const_query_iterator
@@ -50,6 +63,29 @@ query_intersections(RT& rtree, const std::vector<Position>& area)
     return rtree.qbegin(predicate);
 }
 
+geometry::Box envelope(const SensorSector& sector)
+{
+    const double ox = sector.origin.x.value();
+    const double oy = sector.origin.y.value();
+    geometry::Box box { geometry::Point { ox, oy }, geometry::Point { ox, oy } };
+    auto expand = [&](double angle) {
+        const geometry::Point point { ox + sector.range * std::cos(angle), oy + sector.range * std::sin(angle) };
+        boost::geometry::expand(box, point);
+    };
+
+    // both boundary rays' end points and each axis extreme lying on the arc
+    expand(sector.bisector - sector.halfOpening);
+    expand(sector.bisector + sector.halfOpening);
+    const double half_pi = boost::math::double_constants::half_pi;
+    for (int quadrant = 0; quadrant < 4; ++quadrant) {
+        const double angle = quadrant * half_pi;
+        if (std::abs(std::remainder(angle - sector.bisector, 4.0 * half_pi)) <= sector.halfOpening) {
+            expand(angle);
+        }
+    }
+    return box;
+}
+
 } // namespace
 
 GlobalEnvironmentModel::GlobalEnvironmentModel()
@@ -63,11 +99,18 @@ GlobalEnvironmentModel::~GlobalEnvironmentModel()
 
 void GlobalEnvironmentModel::refresh()
 {
+    ARTERY_PROFILE_SCOPE("envmod.refresh");
+    addPendingVehicles();
+    mObjectSnapshotValid = false;
     for (auto& object_kv : mObjects) {
         object_kv.second->update();
     }
 
-    buildObjectRtree();
+    if (mLooseBoxMargin > 0.0) {
+        updateObjectRtree();
+    } else {
+        buildObjectRtree();
+    }
 
     if (mDrawVehicles) {
         int numObjects = mObjects.size();
@@ -102,7 +145,74 @@ void GlobalEnvironmentModel::refresh()
         }
     }
 
+    detectConcurrently();
     emit(refreshSignal, this);
+    std::fill(mConcurrentDetectionsValid.begin(), mConcurrentDetectionsValid.end(), false);
+}
+
+void GlobalEnvironmentModel::detectConcurrently()
+{
+    if (mConcurrentSensors.empty()) {
+        return;
+    }
+
+    // skip sensors not measuring at this refresh, flags are written before workers read them
+    const SimTime now = simTime();
+    for (std::size_t i = 0; i < mConcurrentSensors.size(); ++i) {
+        mConcurrentDetectionsValid[i] = mConcurrentSensors[i]->isMeasurementDue(now);
+    }
+
+    // objects and obstacles (including their rtrees) are not modified until next refresh
+    mTaskScheduler->parallelFor(mConcurrentSensors.size(), 1, [this](std::size_t i) {
+        if (mConcurrentDetectionsValid[i]) {
+            mConcurrentDetections[i] = mConcurrentSensors[i]->detectObjects();
+        }
+    });
+}
+
+bool GlobalEnvironmentModel::registerConcurrentSensor(Sensor* sensor)
+{
+    if (!mTaskScheduler || mTaskScheduler->getThreads() <= 1 || !sensor->hasConcurrentDetection()) {
+        return false;
+    }
+
+    auto insertion = mConcurrentSensorIndex.emplace(sensor, mConcurrentSensors.size());
+    if (insertion.second) {
+        mConcurrentSensors.push_back(sensor);
+        mConcurrentDetections.emplace_back();
+        mConcurrentDetectionsValid.push_back(false);
+    }
+    return true;
+}
+
+void GlobalEnvironmentModel::unregisterConcurrentSensor(Sensor* sensor)
+{
+    auto found = mConcurrentSensorIndex.find(sensor);
+    if (found != mConcurrentSensorIndex.end()) {
+        // move last sensor into the vacant slot
+        const std::size_t index = found->second;
+        const std::size_t last = mConcurrentSensors.size() - 1;
+        if (index != last) {
+            mConcurrentSensors[index] = mConcurrentSensors[last];
+            mConcurrentDetections[index] = std::move(mConcurrentDetections[last]);
+            mConcurrentDetectionsValid[index] = mConcurrentDetectionsValid[last];
+            mConcurrentSensorIndex[mConcurrentSensors[index]] = index;
+        }
+        mConcurrentSensors.pop_back();
+        mConcurrentDetections.pop_back();
+        mConcurrentDetectionsValid.pop_back();
+        mConcurrentSensorIndex.erase(found);
+    }
+}
+
+SensorDetection* GlobalEnvironmentModel::takeConcurrentDetection(const Sensor* sensor)
+{
+    auto found = mConcurrentSensorIndex.find(sensor);
+    if (found != mConcurrentSensorIndex.end() && mConcurrentDetectionsValid[found->second]) {
+        mConcurrentDetectionsValid[found->second] = false;
+        return &mConcurrentDetections[found->second];
+    }
+    return nullptr;
 }
 
 bool GlobalEnvironmentModel::addObject(traci::Controller* controller)
@@ -118,13 +228,42 @@ bool GlobalEnvironmentModel::addObject(traci::Controller* controller)
     auto object = std::make_shared<TraCIEnvironmentModelObject>(controller, id);
     auto insertion = mObjects.emplace(object->getExternalId(), object);
     if (insertion.second) {
-        auto box = boost::geometry::return_envelope<geometry::Box>(object->getOutline());
-        mObjectRtree.insert(ObjectRtreeValue { std::move(box), object });
+        if (mVehicleGeometry && dynamic_cast<traci::VehicleController*>(controller)) {
+            // vehicle is indexed by shared VehicleGeometryIndex
+            mSharedVehicles.insert(object.get());
+        } else if (mLooseBoxMargin > 0.0) {
+            auto box = getLooseBox(*object);
+            mLooseBoxes.emplace(object.get(), box);
+            mObjectRtree.insert(ObjectRtreeValue { std::move(box), object });
+        } else {
+            auto box = boost::geometry::return_envelope<geometry::Box>(object->getOutline());
+            mObjectRtree.insert(ObjectRtreeValue { std::move(box), object });
+        }
     }
-    ASSERT(mObjects.size() == mObjectRtree.size());
+    ASSERT(mObjects.size() == mObjectRtree.size() + mSharedVehicles.size());
     return insertion.second;
 }
 
+void GlobalEnvironmentModel::addPendingVehicles()
+{
+    if (mPendingVehicles.empty()) {
+        return;
+    }
+
+    ASSERT(mNodeManager);
+    auto api = mNodeManager->getAPI();
+    for (const std::string& id : mPendingVehicles) {
+        if (mObjects.find(id) == mObjects.end()) {
+            auto cache = mNodeManager->getSubscriptions()->getVehicleCache(id);
+            auto controller = std::make_unique<traci::VehicleController>(api, cache);
+            if (addObject(controller.get())) {
+                mDetachedControllers[id] = std::move(controller);
+            }
+        }
+    }
+    mPendingVehicles.clear();
+}
+
 bool GlobalEnvironmentModel::addObstacle(const std::string& id, std::vector<Position> outline)
 {
     boost::geometry::correct(outline);
@@ -178,22 +317,79 @@ void GlobalEnvironmentModel::buildObjectRtree()
         }
     };
 
+    auto unshared = [this](const ObjectDB::value_type& obj_kv) {
+        return mSharedVehicles.find(obj_kv.second.get()) == mSharedVehicles.end();
+    };
+
     // use bulk loading for efficient packing
-    mObjectRtree = ObjectRtree { mObjects | boost::adaptors::transformed(envelope_maker()) };
+    mObjectRtree = ObjectRtree { mObjects | boost::adaptors::filtered(unshared) | boost::adaptors::transformed(envelope_maker()) };
     mTainted = false;
 }
 
+void GlobalEnvironmentModel::updateObjectRtree()
+{
+    namespace bg = boost::geometry;
+    for (const auto& object_kv : mObjects) {
+        const std::shared_ptr<EnvironmentModelObject>& object = object_kv.second;
+        if (mSharedVehicles.find(object.get()) != mSharedVehicles.end()) {
+            continue;
+        }
+        auto loose = mLooseBoxes.find(object.get());
+        ASSERT(loose != mLooseBoxes.end());
+        auto envelope = bg::return_envelope<geometry::Box>(object->getOutline());
+        if (!bg::covered_by(envelope, loose->second)) {
+            // object left its loose box: re-insert with a fresh one
+            mObjectRtree.remove(ObjectRtreeValue { loose->second, object });
+            loose->second = getLooseBox(*object);
+            mObjectRtree.insert(ObjectRtreeValue { loose->second, object });
+        }
+    }
+    ASSERT(mObjects.size() == mObjectRtree.size() + mSharedVehicles.size());
+    mTainted = false;
+}
+
+geometry::Box GlobalEnvironmentModel::getLooseBox(const EnvironmentModelObject& object) const
+{
+    auto box = boost::geometry::return_envelope<geometry::Box>(object.getOutline());
+    geometry::Point& min = box.min_corner();
+    geometry::Point& max = box.max_corner();
+    min.set<0>(min.get<0>() - mLooseBoxMargin);
+    min.set<1>(min.get<1>() - mLooseBoxMargin);
+    max.set<0>(max.get<0>() + mLooseBoxMargin);
+    max.set<1>(max.get<1>() + mLooseBoxMargin);
+    return box;
+}
+
 bool GlobalEnvironmentModel::removeObject(const std::string& objectId)
 {
-    bool erased = mObjects.erase(objectId) > 0;
-    mTainted |= erased; /*< pending object rtree update */
-    return erased;
+    auto found = mObjects.find(objectId);
+    if (found == mObjects.end()) {
+        return false;
+    }
+
+    auto loose = mLooseBoxes.find(found->second.get());
+    if (mSharedVehicles.erase(found->second.get()) > 0) {
+        // shared index keeps track of vehicles itself
+    } else if (loose != mLooseBoxes.end()) {
+        // incremental mode: object rtree stays up-to-date
+        mObjectRtree.remove(ObjectRtreeValue { loose->second, found->second });
+        mLooseBoxes.erase(loose);
+    } else {
+        mTainted = true; /*< pending object rtree update */
+    }
+    mObjectSnapshotValid = false; /*< must not refer to removed objects */
+    mObjects.erase(found);
+    return true;
 }
 
 void GlobalEnvironmentModel::removeObjects()
 {
     mObjects.clear();
     mObjectRtree.clear();
+    mObjectSnapshot.clear();
+    mObjectSnapshotValid = false;
+    mLooseBoxes.clear();
+    mSharedVehicles.clear();
     mTainted = false;
 
     if (mDrawVehicles) {
@@ -220,13 +416,29 @@ void GlobalEnvironmentModel::initialize()
 
         traci->subscribe(traciNodeAddSignal, this);
         traci->subscribe(traciNodeRemoveSignal, this);
-        traci->subscribe(traciNodeUpdateSignal, this);
     } else {
         throw cRuntimeError("No TraCI module found for signal subscription");
     }
 
+    mVehicleGeometry = inet::findModuleFromPar<VehicleGeometryIndex>(par("vehicleGeometryIndexModule"), this, false);
+    if (mVehicleGeometry) {
+        // refresh after shared index has been updated
+        mVehicleGeometry->subscribe(VehicleGeometryIndex::updateSignal, this);
+    } else {
+        traci->subscribe(traciNodeUpdateSignal, this);
+    }
+
     mIdentityRegistry = inet::findModuleFromPar<IdentityRegistry>(par("identityRegistryModule"), this);
+    mObstacleRegistry = inet::findModuleFromPar<ObstacleRegistry>(par("obstacleRegistryModule"), this, false);
     mTainted = false;
+    mLooseBoxMargin = par("looseBoxMargin").doubleValue();
+    mTaskScheduler = inet::findModuleFromPar<TaskScheduler>(par("taskSchedulerModule"), this, false);
+
+    mVehiclesWithoutNodes = par("vehiclesWithoutNodes");
+    if (mVehiclesWithoutNodes) {
+        traci->subscribe(traciVehicleAddSignal, this);
+        traci->subscribe(traciVehicleRemoveSignal, this);
+    }
 
     if (par("drawObstacles")) {
         mDrawObstacles = new omnetpp::cGroupFigure("obstacles");
@@ -251,24 +463,50 @@ void GlobalEnvironmentModel::receiveSignal(cComponent* source, simsignal_t signa
 {
     if (signal == traciInitSignal) {
         auto core = check_and_cast<traci::Core*>(source);
-        fetchObstacles(*core->getAPI());
+        if (mObstacleRegistry) {
+            fetchObstacles(*mObstacleRegistry, *core->getAPI());
+        } else {
+            fetchObstacles(*core->getAPI());
+        }
     } else if (signal == traciCloseSignal) {
         clear();
     }
 }
 
-void GlobalEnvironmentModel::receiveSignal(cComponent*, simsignal_t signal, const char* id, cObject* obj)
+void GlobalEnvironmentModel::receiveSignal(cComponent* source, simsignal_t signal, const char* id, cObject* obj)
 {
     if (signal == traciNodeAddSignal) {
         cModule* module = dynamic_cast<cModule*>(obj);
         if (module) {
             auto controller = getController(module);
             if (controller) {
+                auto detached = mDetachedControllers.find(id);
+                if (detached != mDetachedControllers.end()) {
+                    // node's own controller supersedes the detached one
+                    removeObject(id);
+                    mDetachedControllers.erase(detached);
+                }
+                mPendingVehicles.erase(id);
                 addObject(controller);
             }
         }
     } else if (signal == traciNodeRemoveSignal) {
         removeObject(id);
+        if (mVehicles.count(id) > 0) {
+            // vehicle outlives its node, e.g. when leaving a region of interest
+            mPendingVehicles.insert(id);
+        }
+    } else if (signal == traciVehicleAddSignal) {
+        mNodeManager = check_and_cast<traci::BasicNodeManager*>(source);
+        mVehicles.insert(id);
+        mPendingVehicles.insert(id);
+    } else if (signal == traciVehicleRemoveSignal) {
+        mVehicles.erase(id);
+        mPendingVehicles.erase(id);
+        if (mDetachedControllers.count(id) > 0) {
+            removeObject(id);
+            mDetachedControllers.erase(id);
+        }
     }
 }
 
@@ -279,29 +517,62 @@ void GlobalEnvironmentModel::receiveSignal(cComponent*, simsignal_t signal, unsi
     }
 }
 
-void GlobalEnvironmentModel::fetchObstacles(const traci::API& traci)
+void GlobalEnvironmentModel::receiveSignal(cComponent*, simsignal_t signal, cObject*, cObject*)
+{
+    if (signal == VehicleGeometryIndex::updateSignal) {
+        refresh();
+    }
+}
+
+void GlobalEnvironmentModel::fetchObstacles(traci::API& traci)
 {
-    auto& polygons = traci.polygon;
     const traci::Boundary boundary { traci.simulation.getNetBoundary() };
-    for (const std::string& id : polygons.getIDList()) {
-        if (!mObstacleTypes.empty()) {
-            std::string type = polygons.getType(id);
-            if (mObstacleTypes.find(type) == mObstacleTypes.end()) {
-                // skip polygon because its type is not in our filter set
-                EV_DEBUG << "ignore polygon " << id << " of type " << type << "\n";
-                continue;
-            }
+    auto filter = [this](const traci::API::Polygon& polygon) {
+        if (!mObstacleTypes.empty() && mObstacleTypes.find(polygon.type) == mObstacleTypes.end()) {
+            // skip polygon because its type is not in our filter set
+            EV_DEBUG << "ignore polygon " << polygon.id << " of type " << polygon.type << "\n";
+            return false;
         }
+        return true;
+    };
 
+    std::vector<ObstacleOutline> obstacles;
+    for (traci::API::Polygon& polygon : traci.getPolygons(traci.polygon.getIDList(), filter)) {
         std::vector<Position> shape;
-        for (const traci::TraCIPosition& traci_point : polygons.getShape(id).value) {
+        for (const traci::TraCIPosition& traci_point : polygon.shape.value) {
             shape.push_back(traci::position_cast(boundary, traci_point));
         }
         if (shape.size() >= 3) {
-            addObstacle(id, shape);
+            obstacles.push_back(ObstacleOutline { std::move(polygon.id), std::move(polygon.type), std::move(shape) });
         } else {
-            EV_WARN << "skip obstacle polygon " << id << " because its shape is degraded\n";
+            EV_WARN << "skip obstacle polygon " << polygon.id << " because its shape is degraded\n";
+        }
+    }
+
+    const ObstaclePreprocessor preprocessor {
+        par("obstacleSimplificationTolerance").doubleValue(), par("mergeTouchingObstacles").boolValue()
+    };
+    if (preprocessor.isEnabled()) {
+        for (ObstacleOutline& obstacle : obstacles) {
+            boost::geometry::correct(obstacle.outline);
         }
+        const ObstaclePreprocessor::Statistics stats = preprocessor.process(obstacles);
+        EV_INFO << "obstacle preprocessing: " << stats << "\n";
+        stats.recordScalars(*this);
+    }
+
+    for (ObstacleOutline& obstacle : obstacles) {
+        addObstacle(obstacle.id, std::move(obstacle.outline));
+    }
+
+    buildObstacleRtree();
+}
+
+void GlobalEnvironmentModel::fetchObstacles(ObstacleRegistry& registry, traci::API& traci)
+{
+    registry.fetch(traci);
+    for (const ObstacleRegistry::Obstacle& obstacle : registry.getObstacles()) {
+        addObstacle(obstacle.id, obstacle.outline);
     }
 
     buildObstacleRtree();
@@ -338,41 +609,133 @@ std::shared_ptr<EnvironmentModelObstacle> GlobalEnvironmentModel::getObstacle(co
 }
 
 std::vector<std::shared_ptr<EnvironmentModelObject>>
-GlobalEnvironmentModel::preselectObjects(const std::string& ego, const std::vector<Position>& area)
+GlobalEnvironmentModel::preselectObjects(const std::string& ego, const std::vector<Position>& area, bool validate)
+{
+    std::vector<ObjectHandle> candidates;
+    preselectObjects(ego, area, candidates, validate);
+
+    std::vector<std::shared_ptr<EnvironmentModelObject>> objectsInSearchArea;
+    objectsInSearchArea.reserve(candidates.size());
+    for (ObjectHandle candidate : candidates) {
+        objectsInSearchArea.push_back(*candidate);
+    }
+    return objectsInSearchArea;
+}
+
+std::vector<std::shared_ptr<EnvironmentModelObstacle>>
+GlobalEnvironmentModel::preselectObstacles(const std::vector<Position>& area, bool validate)
+{
+    std::vector<ObstacleHandle> candidates;
+    preselectObstacles(area, candidates, validate);
+
+    std::vector<std::shared_ptr<EnvironmentModelObstacle>> obstacles;
+    obstacles.reserve(candidates.size());
+    for (ObstacleHandle candidate : candidates) {
+        obstacles.push_back(*candidate);
+    }
+    return obstacles;
+}
+
+void GlobalEnvironmentModel::preselectObjects(const std::string& ego, const std::vector<Position>& area,
+        std::vector<ObjectHandle>& candidates, bool validate)
 {
     ASSERT(!mTainted);
 
     boost::geometry::validity_failure_type failure;
-    if (!boost::geometry::is_valid(area, failure)) {
+    if (validate && !boost::geometry::is_valid(area, failure)) {
         std::string error_msg =  boost::geometry::validity_failure_type_message(failure);
         throw omnetpp::cRuntimeError("preselection polygon is invalid: %s", error_msg.c_str());
     }
 
-    std::vector<std::shared_ptr<EnvironmentModelObject>> objectsInSearchArea;
+    candidates.clear();
     ObjectRtree::const_query_iterator it = query_intersections(mObjectRtree, area);
     for (; it != mObjectRtree.qend(); ++it) {
         if (it->second->getExternalId() != ego && it->second->isVisible()) {
-            objectsInSearchArea.push_back(it->second);
+            candidates.push_back(&it->second);
+        }
+    }
+
+    if (mVehicleGeometry) {
+        ASSERT(!mVehicleGeometry->isTainted());
+        const auto& rtree = mVehicleGeometry->getRtree();
+        const auto& vehicles = mVehicleGeometry->getVehicles();
+        for (auto vit = query_intersections(rtree, area); vit != rtree.qend(); ++vit) {
+            const std::string& id = vehicles[vit->second]->getId();
+            ObjectHandle object = id != ego ? findSharedVehicle(id) : nullptr;
+            if (object && (*object)->isVisible()) {
+                candidates.push_back(object);
+            }
         }
     }
-    return objectsInSearchArea;
 }
 
-std::vector<std::shared_ptr<EnvironmentModelObstacle>>
-GlobalEnvironmentModel::preselectObstacles(const std::vector<Position>& area)
+void GlobalEnvironmentModel::preselectObjects(const std::string& ego, const SensorSector& sector,
+        std::vector<ObjectHandle>& candidates)
+{
+    ASSERT(!mTainted);
+
+    candidates.clear();
+    auto it = mObjectRtree.qbegin(boost::geometry::index::intersects(envelope(sector)));
+    for (; it != mObjectRtree.qend(); ++it) {
+        const EnvironmentModelObject& object = *it->second;
+        if (object.getExternalId() != ego && object.isVisible() &&
+                intersects(sector, object.getCentrePoint(), object.getRadius().value())) {
+            candidates.push_back(&it->second);
+        }
+    }
+
+    if (mVehicleGeometry) {
+        ASSERT(!mVehicleGeometry->isTainted());
+        const auto& vehicles = mVehicleGeometry->getVehicles();
+        const auto& rtree = mVehicleGeometry->getRtree();
+        auto vit = rtree.qbegin(boost::geometry::index::intersects(envelope(sector)));
+        for (; vit != rtree.qend(); ++vit) {
+            const std::string& id = vehicles[vit->second]->getId();
+            ObjectHandle object = id != ego ? findSharedVehicle(id) : nullptr;
+            if (object && (*object)->isVisible() &&
+                    intersects(sector, (*object)->getCentrePoint(), (*object)->getRadius().value())) {
+                candidates.push_back(object);
+            }
+        }
+    }
+}
+
+GlobalEnvironmentModel::ObjectHandle GlobalEnvironmentModel::findSharedVehicle(const std::string& id) const
+{
+    auto found = mObjects.find(id);
+    if (found != mObjects.end() && mSharedVehicles.count(found->second.get()) > 0) {
+        return &found->second;
+    }
+    return nullptr;
+}
+
+void GlobalEnvironmentModel::preselectObstacles(const std::vector<Position>& area,
+        std::vector<ObstacleHandle>& candidates, bool validate)
 {
     boost::geometry::validity_failure_type failure;
-    if (!boost::geometry::is_valid(area, failure)) {
+    if (validate && !boost::geometry::is_valid(area, failure)) {
         std::string error_msg =  boost::geometry::validity_failure_type_message(failure);
         throw omnetpp::cRuntimeError("preselection polygon is invalid: %s", error_msg.c_str());
     }
 
-    std::vector<std::shared_ptr<EnvironmentModelObstacle>> obstacles;
+    candidates.clear();
     ObstacleRtree::const_query_iterator it = query_intersections(mObstacleRtree, area);
     for (; it != mObstacleRtree.qend(); ++it) {
-        obstacles.push_back(it->second);
+        candidates.push_back(&it->second);
     }
-    return obstacles;
+}
+
+const ObjectSnapshot& GlobalEnvironmentModel::getObjectSnapshot() const
+{
+    if (!mObjectSnapshotValid) {
+        mObjectSnapshot.clear();
+        mObjectSnapshot.reserve(mObjects.size(), 4 * mObjects.size());
+        for (const auto& object_kv : mObjects) {
+            mObjectSnapshot.add(*object_kv.second);
+        }
+        mObjectSnapshotValid = true;
+    }
+    return mObjectSnapshot;
 }
 
 } // namespace artery
@@ -11,12 +11,14 @@
 #include "artery/envmod/Geometry.h"
 #include "artery/envmod/EnvironmentModelObject.h"
 #include "artery/envmod/EnvironmentModelObstacle.h"
+#include "artery/envmod/ObjectSnapshot.h"
 #include "artery/utility/Geometry.h"
 #include <omnetpp/ccanvas.h>
 #include <omnetpp/clistener.h>
 #include <omnetpp/csimplemodule.h>
 #include <boost/geometry/index/rtree.hpp>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
 #include <string>
 
@@ -24,7 +26,9 @@
 namespace traci
 {
     class API;
+    class BasicNodeManager;
     class Controller;
+    class VehicleController;
 } // namespace traci
 
 
@@ -33,6 +37,11 @@ namespace artery
 
 class EnvironmentModelObstacle;
 class IdentityRegistry;
+class ObstacleRegistry;
+class Sensor;
+class TaskScheduler;
+struct SensorSector;
+class VehicleGeometryIndex;
 
 /**
  * The GlobalEnvironmentModel has the global view of all objects and obstacles
@@ -59,6 +68,7 @@ public:
     void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, const omnetpp::SimTime&, omnetpp::cObject*) override;
     void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, const char*, omnetpp::cObject*) override;
     void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, unsigned long, omnetpp::cObject*) override;
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, omnetpp::cObject*, omnetpp::cObject*) override;
 
     /**
      * Fetch an object by its external id.
@@ -74,22 +84,92 @@ public:
      */
     std::shared_ptr<EnvironmentModelObstacle> getObstacle(const std::string& obsId);
 
+    /**
+     * Handles refer to the model's own shared pointers of objects and obstacles.
+     * They stay valid until the model is modified, i.e. at least for the current simulation step.
+     * Candidates can thus be examined without touching their reference counts.
+     */
+    using ObjectHandle = const std::shared_ptr<EnvironmentModelObject>*;
+    using ObstacleHandle = const std::shared_ptr<EnvironmentModelObstacle>*;
+
     /**
      * Preselect all objects close to the given area
      * @param ego identifier of the ego object, which is filtered out of the result
      * @param area search polygon
+     * @param validate check area polygon for validity, may be skipped for polygons known to be valid
      * @return preselected objects, i.e. candidates for precise sensor checks
      */
     std::vector<std::shared_ptr<EnvironmentModelObject>>
-    preselectObjects(const std::string& ego, const std::vector<Position>& area);
+    preselectObjects(const std::string& ego, const std::vector<Position>& area, bool validate = true);
 
     /**
      * Preselect all obstacles close to the given area
      * @param area search polygon
+     * @param validate check area polygon for validity, may be skipped for polygons known to be valid
      * @return preselected obstacles
      */
     std::vector<std::shared_ptr<EnvironmentModelObstacle>>
-    preselectObstacles(const std::vector<Position>& area);
+    preselectObstacles(const std::vector<Position>& area, bool validate = true);
+
+    /**
+     * Preselect all objects close to the given area into a caller-owned buffer
+     * @param ego identifier of the ego object, which is filtered out of the result
+     * @param area search polygon
+     * @param candidates cleared and filled with handles of preselected objects, capacity is kept
+     * @param validate check area polygon for validity, may be skipped for polygons known to be valid
+     */
+    void preselectObjects(const std::string& ego, const std::vector<Position>& area,
+            std::vector<ObjectHandle>& candidates, bool validate = true);
+
+    /**
+     * Preselect all objects whose bounding circle intersects a sensor sector into a caller-owned buffer
+     *
+     * This is a superset of objects intersecting the cone polygon inscribed into the sector.
+     * Unlike the polygon-based variant, objects merely sharing the bounding box are dropped.
+     * @param ego identifier of the ego object, which is filtered out of the result
+     * @param sector search sector
+     * @param candidates cleared and filled with handles of preselected objects, capacity is kept
+     */
+    void preselectObjects(const std::string& ego, const SensorSector& sector,
+            std::vector<ObjectHandle>& candidates);
+
+    /**
+     * Preselect all obstacles close to the given area into a caller-owned buffer
+     * @param area search polygon
+     * @param candidates cleared and filled with handles of preselected obstacles, capacity is kept
+     * @param validate check area polygon for validity, may be skipped for polygons known to be valid
+     */
+    void preselectObstacles(const std::vector<Position>& area,
+            std::vector<ObstacleHandle>& candidates, bool validate = true);
+
+    /**
+     * Get contiguous snapshot of all objects' poses and outlines
+     *
+     * The snapshot is built on first access after a refresh or removal of objects,
+     * i.e. no snapshot is built at all as long as nobody asks for it.
+     * @return snapshot of objects as updated at the last refresh
+     */
+    const ObjectSnapshot& getObjectSnapshot() const;
+
+    /**
+     * Register a sensor for concurrent detection ahead of each refresh signal
+     * @param sensor sensor supporting concurrent detection
+     * @return true if sensor got registered, false if concurrent detection is disabled
+     */
+    bool registerConcurrentSensor(Sensor* sensor);
+
+    /**
+     * Unregister a previously registered sensor
+     * @param sensor sensor
+     */
+    void unregisterConcurrentSensor(Sensor* sensor);
+
+    /**
+     * Take detection evaluated concurrently for given sensor during current refresh
+     * @param sensor registered sensor
+     * @return detection or nullptr if none is available
+     */
+    SensorDetection* takeConcurrentDetection(const Sensor* sensor);
 
 private:
     /**
@@ -97,6 +177,11 @@ private:
      */
     void refresh();
 
+    /**
+     * Evaluate detections of all registered sensors due for measurement concurrently
+     */
+    void detectConcurrently();
+
     /**
      * Add object to the environment database
      * @param vehicle TraCI mobility corresponding to vehicle
@@ -104,6 +189,13 @@ private:
      */
     bool addObject(traci::Controller* object);
 
+    /**
+     * Add objects for vehicles without a node which are pending since their departure or node removal
+     *
+     * Their controllers are backed by the node manager's subscription caches.
+     */
+    void addPendingVehicles();
+
     /**
      * Remove objects from the database
      * @param nodeId TraCI id of object to be removed
@@ -132,9 +224,30 @@ private:
 
     /**
      * Create the object rtree.
+     * Vehicles indexed by a shared VehicleGeometryIndex are left out.
      */
     void buildObjectRtree();
 
+    /**
+     * Update object rtree incrementally using loose boxes:
+     * only objects which have left their loose box are re-inserted.
+     */
+    void updateObjectRtree();
+
+    /**
+     * Get loose box enclosing an object's outline with configured margin
+     * @param object environment model object
+     * @return enlarged envelope
+     */
+    geometry::Box getLooseBox(const EnvironmentModelObject& object) const;
+
+    /**
+     * Look up object corresponding to a vehicle of the shared VehicleGeometryIndex
+     * @param id vehicle identifier
+     * @return handle of object or nullptr if unknown
+     */
+    ObjectHandle findSharedVehicle(const std::string& id) const;
+
     /**
      * Clears the internal database completely
      */
@@ -144,7 +257,14 @@ private:
      * Fetch static obstacles (polygons) from TraCI
      * @param api TraCI API object
      */
-    void fetchObstacles(const traci::API& api);
+    void fetchObstacles(traci::API& api);
+
+    /**
+     * Copy static obstacles from a shared obstacle registry
+     * @param registry obstacle registry
+     * @param api TraCI API object (used if registry has not fetched obstacles yet)
+     */
+    void fetchObstacles(ObstacleRegistry& registry, traci::API& api);
 
     /**
      * Try to get controller corresponding to given module
@@ -160,11 +280,31 @@ private:
     using ObstacleRtreeValue = std::pair<geometry::Box, std::shared_ptr<EnvironmentModelObstacle>>;
     using ObstacleRtree = boost::geometry::index::rtree<ObstacleRtreeValue, boost::geometry::index::rstar<16>>;
 
+    using LooseBoxes = std::unordered_map<const EnvironmentModelObject*, geometry::Box>;
+    using SharedVehicles = std::unordered_set<const EnvironmentModelObject*>;
+
     ObjectDB mObjects;
     ObjectRtree mObjectRtree;
+    mutable ObjectSnapshot mObjectSnapshot;
+    mutable bool mObjectSnapshotValid = false;
+    LooseBoxes mLooseBoxes;
+    double mLooseBoxMargin = 0.0;
+    TaskScheduler* mTaskScheduler = nullptr;
+    std::vector<Sensor*> mConcurrentSensors;
+    std::vector<SensorDetection> mConcurrentDetections;
+    std::vector<bool> mConcurrentDetectionsValid;
+    std::unordered_map<const Sensor*, std::size_t> mConcurrentSensorIndex;
     ObstacleDB mObstacles;
     ObstacleRtree mObstacleRtree;
     IdentityRegistry* mIdentityRegistry;
+    ObstacleRegistry* mObstacleRegistry = nullptr;
+    VehicleGeometryIndex* mVehicleGeometry = nullptr;
+    SharedVehicles mSharedVehicles; /*< objects indexed by mVehicleGeometry instead of mObjectRtree */
+    bool mVehiclesWithoutNodes = false;
+    traci::BasicNodeManager* mNodeManager = nullptr;
+    std::unordered_set<std::string> mVehicles; /*< all vehicles of the TraCI population */
+    std::unordered_set<std::string> mPendingVehicles; /*< vehicles lacking an object until next refresh */
+    std::unordered_map<std::string, std::unique_ptr<traci::VehicleController>> mDetachedControllers;
     bool mTainted = false;
     omnetpp::cGroupFigure* mDrawObstacles = nullptr;
     omnetpp::cGroupFigure* mDrawVehicles = nullptr;
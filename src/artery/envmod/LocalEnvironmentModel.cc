@@ -10,9 +10,13 @@
 #include "artery/envmod/GlobalEnvironmentModel.h"
 #include "artery/envmod/sensor/Sensor.h"
 #include "artery/utility/FilterRules.h"
+#include "artery/utility/XmlConfigCache.h"
 #include <inet/common/ModuleAccess.h>
 #include <omnetpp/cxmlelement.h>
+#include <algorithm>
+#include <string>
 #include <utility>
+#include <vector>
 
 using namespace omnetpp;
 
@@ -23,6 +27,41 @@ Define_Module(LocalEnvironmentModel)
 
 static const simsignal_t EnvironmentModelRefreshSignal = cComponent::registerSignal("EnvironmentModel.refresh");
 
+namespace
+{
+
+/**
+ * Sensor configuration compiled from XML once for all environment models
+ */
+struct SensorPlan
+{
+    std::string type;
+    cModuleType* module_type; /*< nullptr if type is unknown yet */
+    std::string name; /*< empty for default name */
+    FilterPlan filters;
+};
+
+std::vector<SensorPlan> compileSensorPlans(const cXMLElement& config)
+{
+    std::vector<SensorPlan> plans;
+    for (cXMLElement* sensor_cfg : config.getChildrenByTagName("sensor")) {
+        SensorPlan plan;
+        plan.type = sensor_cfg->getAttribute("type") ? sensor_cfg->getAttribute("type") : "";
+        plan.module_type = cModuleType::find(plan.type.c_str());
+        plan.name = sensor_cfg->getAttribute("name") ? sensor_cfg->getAttribute("name") : "";
+        cXMLElement* sensor_filters = sensor_cfg->getFirstChildWithTag("filters");
+        if (sensor_filters) {
+            plan.filters = FilterPlan { *sensor_filters };
+        }
+        plans.push_back(std::move(plan));
+    }
+    return plans;
+}
+
+XmlConfigCache<std::vector<SensorPlan>> sensorPlanCache;
+
+} // namespace
+
 LocalEnvironmentModel::LocalEnvironmentModel() :
     mGlobalEnvironmentModel(nullptr)
 {
@@ -52,14 +91,33 @@ void LocalEnvironmentModel::initialize(int stage)
 void LocalEnvironmentModel::finish()
 {
     mGlobalEnvironmentModel->unsubscribe(EnvironmentModelRefreshSignal, this);
+    for (auto* sensor : mSensors) {
+        mGlobalEnvironmentModel->unregisterConcurrentSensor(sensor);
+    }
     mObjects.clear();
+    mObjectKeys.clear();
+    mObjectChanges.clear();
+    mObjectIndex.clear();
+    mChanges.clear();
+    mExpiries = decltype(mExpiries) {};
 }
 
 void LocalEnvironmentModel::receiveSignal(cComponent*, simsignal_t signal, cObject* obj, cObject*)
 {
     if (signal == EnvironmentModelRefreshSignal) {
+        const SimTime now = simTime();
         for (auto* sensor : mSensors) {
-            sensor->measurement();
+            if (!sensor->isMeasurementDue(now)) {
+                continue;
+            }
+
+            SensorDetection* detection = mGlobalEnvironmentModel->takeConcurrentDetection(sensor);
+            if (detection) {
+                sensor->completeMeasurement(std::move(*detection));
+            } else {
+                sensor->measurement();
+            }
+            sensor->measurementConducted(now);
         }
         update();
     }
@@ -68,50 +126,177 @@ void LocalEnvironmentModel::receiveSignal(cComponent*, simsignal_t signal, cObje
 void LocalEnvironmentModel::complementObjects(const SensorDetection& detection, const Sensor& sensor)
 {
    for (auto& detectedObject : detection.objects) {
-      auto foundObject = mObjects.find(detectedObject);
-      if (foundObject != mObjects.end()) {
-         Tracking& tracking = foundObject->second;
-         tracking.tap(&sensor);
+      const EnvironmentModelObject* key = detectedObject.get();
+      if (!key) {
+         continue;
+      }
+
+      auto found = mObjectIndex.find(key);
+      if (found != mObjectIndex.end() && mObjects[found->second].first.expired()) {
+         // stale entry of a vanished object whose memory got reused
+         removeObject(found->second);
+         found = mObjectIndex.end();
+      }
+
+      if (found != mObjectIndex.end()) {
+         Tracking& tracking = mObjects[found->second].second;
+         if (tracking.tap(&sensor)) {
+            scheduleExpiry(key, tracking, &sensor);
+         }
+         markChanged(found->second);
       } else {
-         mObjects.emplace(detectedObject, Tracking { ++mTrackingCounter, &sensor });
+         mObjectIndex.emplace(key, mObjects.size());
+         mObjectKeys.push_back(key);
+         mObjectChanges.push_back(0);
+         mObjects.emplace_back(detectedObject, Tracking { ++mTrackingCounter, &sensor, mLabelBits });
+         scheduleExpiry(key, mObjects.back().second, &sensor);
+         markChanged(mObjects.size() - 1);
       }
    }
 }
 
 void LocalEnvironmentModel::update()
 {
-    for (auto it = mObjects.begin(); it != mObjects.end();) {
-        const Object& object = it->first;
-        Tracking& tracking = it->second;
-        tracking.update();
+    // only trackings reaching their deadline are checked, i.e. objects tapped since are rescheduled
+    const SimTime now = simTime();
+    while (!mExpiries.empty() && mExpiries.top().deadline < now) {
+        const Expiry expiry = mExpiries.top();
+        mExpiries.pop();
+
+        auto found = mObjectIndex.find(expiry.object);
+        if (found == mObjectIndex.end()) {
+            continue;
+        }
 
-        if (object.expired() || tracking.expired()) {
-            it = mObjects.erase(it);
+        const std::size_t index = found->second;
+        Tracking& tracking = mObjects[index].second;
+        const TrackingTime* time = tracking.find(expiry.sensor);
+        if (tracking.id() != expiry.tracking || !time) {
+            continue;
+        }
+
+        const SimTime deadline = time->last() + expiry.sensor->getValidityPeriod();
+        if (deadline < now) {
+            tracking.erase(expiry.sensor);
+            if (tracking.expired()) {
+                removeObject(index);
+            }
+        } else {
+            mExpiries.push(Expiry { deadline, expiry.object, expiry.tracking, expiry.sensor });
+        }
+    }
+
+    // drop objects which have left the simulation meanwhile
+    for (std::size_t i = 0; i < mObjects.size();) {
+        if (mObjects[i].first.expired()) {
+            removeObject(i);
         } else {
-            ++it;
+            ++i;
+        }
+    }
+}
+
+void LocalEnvironmentModel::scheduleExpiry(const EnvironmentModelObject* object, const Tracking& tracking, const Sensor* sensor)
+{
+    const TrackingTime* time = tracking.find(sensor);
+    ASSERT(time);
+    mExpiries.push(Expiry { time->last() + sensor->getValidityPeriod(), object, tracking.id(), sensor });
+}
+
+void LocalEnvironmentModel::removeObject(std::size_t index)
+{
+    // move last entry into the gap, pending expiries of the removed entry are skipped by their key
+    mObjectIndex.erase(mObjectKeys[index]);
+    if (index + 1 != mObjects.size()) {
+        mObjects[index] = std::move(mObjects.back());
+        mObjectKeys[index] = mObjectKeys.back();
+        mObjectChanges[index] = mObjectChanges.back();
+        mObjectIndex[mObjectKeys[index]] = index;
+    }
+    mObjects.pop_back();
+    mObjectKeys.pop_back();
+    mObjectChanges.pop_back();
+}
+
+void LocalEnvironmentModel::markChanged(std::size_t index)
+{
+    // append object once to each subscription's list until it is taken
+    ChangeMask& pending = mObjectChanges[index];
+    for (unsigned subscription = 0; subscription < mChanges.size(); ++subscription) {
+        const ChangeMask bit = ChangeMask(1) << subscription;
+        if (!(pending & bit)) {
+            pending |= bit;
+            mChanges[subscription].push_back(mObjectKeys[index]);
+        }
+    }
+}
+
+const LocalEnvironmentModel::TrackedObject* LocalEnvironmentModel::findObject(const EnvironmentModelObject* key) const
+{
+    auto found = mObjectIndex.find(key);
+    if (found != mObjectIndex.end() && !mObjects[found->second].first.expired()) {
+        return &mObjects[found->second];
+    }
+    return nullptr;
+}
+
+unsigned LocalEnvironmentModel::subscribeChanges()
+{
+    if (mChanges.size() >= maxChangeSubscriptions) {
+        throw cRuntimeError("too many change subscriptions (at most %u)", maxChangeSubscriptions);
+    }
+
+    // objects tracked already are reported by the first take
+    const unsigned subscription = mChanges.size();
+    mChanges.emplace_back();
+    for (std::size_t i = 0; i < mObjects.size(); ++i) {
+        mObjectChanges[i] |= ChangeMask(1) << subscription;
+        mChanges.back().push_back(mObjectKeys[i]);
+    }
+    return subscription;
+}
+
+void LocalEnvironmentModel::takeChanges(unsigned subscription, std::vector<const EnvironmentModelObject*>& changed)
+{
+    ASSERT(subscription < mChanges.size());
+    changed.swap(mChanges[subscription]);
+    mChanges[subscription].clear();
+
+    const ChangeMask bit = ChangeMask(1) << subscription;
+    for (const EnvironmentModelObject* key : changed) {
+        auto found = mObjectIndex.find(key);
+        if (found != mObjectIndex.end()) {
+            mObjectChanges[found->second] &= ~bit;
         }
     }
 }
 
+std::size_t LocalEnvironmentModel::estimateMemoryFootprint() const
+{
+    // sensors are modules on their own and tracked objects are owned by the global model
+    std::size_t bytes = sizeof(LocalEnvironmentModel);
+    bytes += memory::bytes(mObjects) + memory::bytes(mObjectKeys) + memory::bytes(mObjectChanges);
+    bytes += memory::bytes(mObjectIndex) + memory::bytes(mExpiries) + memory::bytes(mSensors);
+    for (const TrackedObject& object : mObjects) {
+        bytes += memory::bytes(object.second.sensors());
+    }
+    bytes += memory::bytes(mChanges);
+    for (const auto& changes : mChanges) {
+        bytes += memory::bytes(changes);
+    }
+    return bytes;
+}
+
 void LocalEnvironmentModel::initializeSensors()
 {
     cXMLElement* config = par("sensors").xmlValue();
-    for (cXMLElement* sensor_cfg : config->getChildrenByTagName("sensor"))
+    const auto& plans = sensorPlanCache.get(config, compileSensorPlans);
+    for (const SensorPlan& plan : plans)
     {
-        cXMLElement* sensor_filters = sensor_cfg->getFirstChildWithTag("filters");
-        bool sensor_applicable = true;
-        if (sensor_filters) {
-            auto identity = mMiddleware->getIdentity();
-            FilterRules rules(getRNG(0), identity);
-            sensor_applicable = rules.applyFilterConfig(*sensor_filters);
-        }
-
-        if (sensor_applicable) {
-            cModuleType* module_type = cModuleType::get(sensor_cfg->getAttribute("type"));
-            const char* sensor_name = sensor_cfg->getAttribute("name");
-            if (!sensor_name || !*sensor_name) {
-                sensor_name = module_type->getName();
-            }
+        if (plan.filters.apply(getRNG(0), mMiddleware->getIdentity())) {
+            // cModuleType::get reports unknown types of applicable sensors
+            cModuleType* module_type = plan.module_type ? plan.module_type : cModuleType::get(plan.type.c_str());
+            const char* sensor_name = plan.name.empty() ? module_type->getName() : plan.name.c_str();
 
             cModule* module = module_type->create(sensor_name, this);
             module->finalizeParameters();
@@ -128,14 +313,17 @@ void LocalEnvironmentModel::initializeSensors()
             module->scheduleStart(simTime());
             module->callInitialize();
             mSensors.push_back(sensor);
+            mGlobalEnvironmentModel->registerConcurrentSensor(sensor);
         }
     }
 }
 
 
-LocalEnvironmentModel::Tracking::Tracking(int id, const Sensor* sensor) : mId(id)
+LocalEnvironmentModel::Tracking::Tracking(int id, const Sensor* sensor, LabelBits& labels) :
+    mId(id), mLabels(&labels)
 {
-    mSensors.emplace(sensor, TrackingTime {});
+    mSensors.emplace_back(sensor, TrackingTime {});
+    updateLabels();
 }
 
 bool LocalEnvironmentModel::Tracking::expired() const
@@ -143,32 +331,82 @@ bool LocalEnvironmentModel::Tracking::expired() const
     return mSensors.empty();
 }
 
-void LocalEnvironmentModel::Tracking::update()
+bool LocalEnvironmentModel::Tracking::tap(const Sensor* sensor)
 {
-    for (auto it = mSensors.begin(); it != mSensors.end();) {
-      const Sensor* sensor = it->first;
-      const TrackingTime& tracking = it->second;
-
-      const bool expired = tracking.last() + sensor->getValidityPeriod() < simTime();
-      if (expired) {
-          it = mSensors.erase(it);
-      } else {
-          ++it;
-      }
+    for (auto& entry : mSensors) {
+        if (entry.first == sensor) {
+            entry.second.tap();
+            return false;
+        }
     }
+
+    mSensors.emplace_back(sensor, TrackingTime {});
+    updateLabels();
+    return true;
 }
 
-void LocalEnvironmentModel::Tracking::tap(const Sensor* sensor)
+void LocalEnvironmentModel::Tracking::erase(const Sensor* sensor)
 {
-    auto found = mSensors.find(sensor);
+    auto found = std::find_if(mSensors.begin(), mSensors.end(),
+        [sensor](const TrackingMap::value_type& entry) { return entry.first == sensor; });
     if (found != mSensors.end()) {
-         TrackingTime& tracking = found->second;
-         tracking.tap();
+        mSensors.erase(found);
+        updateLabels();
+    }
+}
+
+const LocalEnvironmentModel::TrackingTime* LocalEnvironmentModel::Tracking::find(const Sensor* sensor) const
+{
+    for (const auto& entry : mSensors) {
+        if (entry.first == sensor) {
+            return &entry.second;
+        }
+    }
+    return nullptr;
+}
+
+void LocalEnvironmentModel::Tracking::updateLabels()
+{
+    // label lookups happen only when the set of tracking sensors changes
+    mCategories = 0;
+    mNames = 0;
+    for (const auto& entry : mSensors) {
+        const unsigned category = mLabels->assign(entry.first->getSensorCategory());
+        const unsigned name = mLabels->assign(entry.first->getSensorName());
+        if (category < maxLabelBits) {
+            mCategories |= LabelMask(1) << category;
+        }
+        if (name < maxLabelBits) {
+            mNames |= LabelMask(1) << name;
+        }
+    }
+}
+
+unsigned LocalEnvironmentModel::LabelBits::assign(const std::string& label)
+{
+    // a local model has few distinct sensor categories and names
+    auto found = mBits.find(label);
+    if (found != mBits.end()) {
+        return found->second;
+    } else if (mBits.size() < maxLabelBits) {
+        const unsigned bit = mBits.size();
+        mBits.emplace(label, bit);
+        return bit;
     } else {
-         mSensors.emplace(sensor, TrackingTime {});
+        return maxLabelBits;
     }
 }
 
+unsigned LocalEnvironmentModel::LabelBits::find(const std::string& label) const
+{
+    auto found = mBits.find(label);
+    return found != mBits.end() ? found->second : maxLabelBits;
+}
+
+constexpr unsigned LocalEnvironmentModel::LabelBits::maxLabelBits;
+constexpr unsigned LocalEnvironmentModel::Tracking::maxLabelBits;
+constexpr unsigned LocalEnvironmentModel::maxChangeSubscriptions;
+
 
 LocalEnvironmentModel::TrackingTime::TrackingTime() :
    mFirst(simTime()), mLast(simTime())
@@ -183,15 +421,26 @@ void LocalEnvironmentModel::TrackingTime::tap()
 
 TrackedObjectsFilterRange filterBySensorCategory(const LocalEnvironmentModel::TrackedObjects& all, const std::string& category)
 {
-    // capture `category` by value because lambda expression will be evaluated after this function's return
-    TrackedObjectsFilterPredicate seenByCategory = [category](const LocalEnvironmentModel::TrackedObject& obj) {
-        const auto& detections = obj.second.sensors();
-        return std::any_of(detections.begin(), detections.end(),
-                [&category](const LocalEnvironmentModel::Tracking::TrackingMap::value_type& tracking) {
-                    const Sensor* sensor = tracking.first;
-                    return sensor->getSensorCategory() == category;
-                });
-    };
+    using Tracking = LocalEnvironmentModel::Tracking;
+    TrackedObjectsFilterPredicate seenByCategory;
+    // all tracked objects of a local model share its label bits, labels without bit are compared by string
+    const unsigned bit = all.empty() ? Tracking::maxLabelBits : all.front().second.labels().find(category);
+    if (bit < Tracking::maxLabelBits) {
+        const Tracking::LabelMask mask = Tracking::LabelMask(1) << bit;
+        seenByCategory = [mask](const LocalEnvironmentModel::TrackedObject& obj) {
+            return (obj.second.categories() & mask) != 0;
+        };
+    } else {
+        // capture `category` by value because lambda expression will be evaluated after this function's return
+        seenByCategory = [category](const LocalEnvironmentModel::TrackedObject& obj) {
+            const auto& detections = obj.second.sensors();
+            return std::any_of(detections.begin(), detections.end(),
+                    [&category](const Tracking::TrackingMap::value_type& tracking) {
+                        const Sensor* sensor = tracking.first;
+                        return sensor->getSensorCategory() == category;
+                    });
+        };
+    }
 
     auto begin = boost::make_filter_iterator(seenByCategory, all.begin(), all.end());
     auto end = boost::make_filter_iterator(seenByCategory, all.end(), all.end());
@@ -200,15 +449,26 @@ TrackedObjectsFilterRange filterBySensorCategory(const LocalEnvironmentModel::Tr
 
 TrackedObjectsFilterRange filterBySensorName(const LocalEnvironmentModel::TrackedObjects& all, const std::string& name)
 {
-    // capture `category` by value because lambda expression will be evaluated after this function's return
-    TrackedObjectsFilterPredicate seenByName = [name](const LocalEnvironmentModel::TrackedObject& obj) {
-        const auto& detections = obj.second.sensors();
-        return std::any_of(detections.begin(), detections.end(),
-                [&name](const LocalEnvironmentModel::Tracking::TrackingMap::value_type& tracking) {
-                    const Sensor* sensor = tracking.first;
-                    return sensor->getSensorName() == name;
-                });
-    };
+    using Tracking = LocalEnvironmentModel::Tracking;
+    TrackedObjectsFilterPredicate seenByName;
+    // all tracked objects of a local model share its label bits, labels without bit are compared by string
+    const unsigned bit = all.empty() ? Tracking::maxLabelBits : all.front().second.labels().find(name);
+    if (bit < Tracking::maxLabelBits) {
+        const Tracking::LabelMask mask = Tracking::LabelMask(1) << bit;
+        seenByName = [mask](const LocalEnvironmentModel::TrackedObject& obj) {
+            return (obj.second.names() & mask) != 0;
+        };
+    } else {
+        // capture `name` by value because lambda expression will be evaluated after this function's return
+        seenByName = [name](const LocalEnvironmentModel::TrackedObject& obj) {
+            const auto& detections = obj.second.sensors();
+            return std::any_of(detections.begin(), detections.end(),
+                    [&name](const Tracking::TrackingMap::value_type& tracking) {
+                        const Sensor* sensor = tracking.first;
+                        return sensor->getSensorName() == name;
+                    });
+        };
+    }
 
     auto begin = boost::make_filter_iterator(seenByName, all.begin(), all.end());
     auto end = boost::make_filter_iterator(seenByName, all.end(), all.end());
@@ -7,14 +7,19 @@
 #ifndef LOCALENVIRONMENTMODEL_H_
 #define LOCALENVIRONMENTMODEL_H_
 
+#include "artery/utility/MemoryFootprint.h"
 #include <boost/iterator/filter_iterator.hpp>
 #include <boost/range/iterator_range.hpp>
 #include <omnetpp/clistener.h>
 #include <omnetpp/csimplemodule.h>
 #include <omnetpp/simtime.h>
+#include <cstdint>
 #include <functional>
-#include <map>
 #include <memory>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace artery
@@ -32,7 +37,7 @@ class SensorDetection;
  * LocalEnvironmentModel tracks the GlobalEnvironmentModel's objects
  * visible by the local sensors feeding this local model.
  */
-class LocalEnvironmentModel : public omnetpp::cSimpleModule, public omnetpp::cListener
+class LocalEnvironmentModel : public omnetpp::cSimpleModule, public omnetpp::cListener, public MemoryFootprint
 {
 public:
     using Object = std::weak_ptr<EnvironmentModelObject>;
@@ -51,26 +56,90 @@ public:
         omnetpp::SimTime mLast;
     };
 
+    /**
+     * LabelBits assigns bit positions to sensor categories and names.
+     *
+     * Each local model has its own assignment, i.e. bits depend only on the sensors of this model
+     * and not on models of other (earlier) runs within the same process.
+     */
+    class LabelBits
+    {
+    public:
+        static constexpr unsigned maxLabelBits = 64;
+
+        /**
+         * Get bit position of a label, unknown labels are assigned the next free bit
+         * @return bit position, maxLabelBits if all bits are in use already
+         */
+        unsigned assign(const std::string& label);
+
+        /**
+         * Look up bit position of a label without assigning one
+         * @return bit position, maxLabelBits if label has no bit
+         */
+        unsigned find(const std::string& label) const;
+
+    private:
+        std::unordered_map<std::string, unsigned> mBits;
+    };
+
     class Tracking
     {
     public:
-        using TrackingMap = std::map<const Sensor*, TrackingTime>;
+        // few sensors per object: a flat vector beats a tree-based map
+        using TrackingMap = std::vector<std::pair<const Sensor*, TrackingTime>>;
+
+        /**
+         * Bit masks of sensor categories and names of all sensors tracking an object.
+         * Bit positions are assigned by the owning model's LabelBits, labels beyond the mask width are not represented.
+         */
+        using LabelMask = std::uint64_t;
+        static constexpr unsigned maxLabelBits = LabelBits::maxLabelBits;
 
-        Tracking(int id, const Sensor* sensor);
+        Tracking(int id, const Sensor* sensor, LabelBits& labels);
 
         bool expired() const;
-        void update();
-        void tap(const Sensor*);
+
+        /**
+         * Tap tracking by sensor
+         * @return true if sensor has not been tracking this object before
+         */
+        bool tap(const Sensor*);
+
+        /**
+         * Stop tracking by sensor
+         * @param sensor sensor which lost track of this object
+         */
+        void erase(const Sensor* sensor);
+
+        /**
+         * Get tracking time of a particular sensor
+         * @return nullptr if sensor is not tracking this object
+         */
+        const TrackingTime* find(const Sensor* sensor) const;
 
         int id() const { return mId; }
         const TrackingMap& sensors() const { return mSensors; }
+        LabelMask categories() const { return mCategories; }
+        LabelMask names() const { return mNames; }
+
+        /**
+         * Get label bit assignment of the owning model
+         */
+        const LabelBits& labels() const { return *mLabels; }
 
     private:
+        void updateLabels();
+
         int mId;
+        LabelBits* mLabels;
         TrackingMap mSensors;
+        LabelMask mCategories = 0;
+        LabelMask mNames = 0;
     };
 
-    using TrackedObjects = std::map<Object, Tracking, std::owner_less<Object>>;
+    // dense storage of tracked objects, indexed by mObjectIndex
+    using TrackedObjects = std::vector<std::pair<Object, Tracking>>;
     using TrackedObject = typename TrackedObjects::value_type;
 
 
@@ -102,6 +171,27 @@ public:
      */
     const TrackedObjects& allObjects() const { return mObjects; }
 
+    /**
+     * Find a tracked object
+     * @param key object as referred to by sensor detections
+     * @return tracked object or nullptr if object is not tracked
+     */
+    const TrackedObject* findObject(const EnvironmentModelObject* key) const;
+
+    /**
+     * Subscribe to changes of tracked objects, e.g. for incremental message generation.
+     * An object is changed whenever it is detected by any local sensor.
+     * @return subscription handle
+     */
+    unsigned subscribeChanges();
+
+    /**
+     * Take objects changed since the last call with this subscription
+     * @param subscription handle returned by subscribeChanges
+     * @param changed replaced by keys of changed objects, some of them might not be tracked anymore
+     */
+    void takeChanges(unsigned subscription, std::vector<const EnvironmentModelObject*>& changed);
+
     /**
      * Get list of all sensors attached to this local entity
      *
@@ -109,13 +199,40 @@ public:
      */
     const std::vector<Sensor*>& getSensors() const { return mSensors; }
 
+    // MemoryFootprint
+    std::size_t estimateMemoryFootprint() const override;
+
 private:
+    // scheduled check of a sensor's tracking of an object
+    struct Expiry
+    {
+        omnetpp::SimTime deadline;
+        const EnvironmentModelObject* object;
+        int tracking;
+        const Sensor* sensor;
+
+        bool operator>(const Expiry& other) const { return deadline > other.deadline; }
+    };
+
     void initializeSensors();
+    void scheduleExpiry(const EnvironmentModelObject*, const Tracking&, const Sensor*);
+    void removeObject(std::size_t index);
+    void markChanged(std::size_t index);
+
+    // one bit per change subscription
+    using ChangeMask = std::uint64_t;
+    static constexpr unsigned maxChangeSubscriptions = 64;
 
     Middleware* mMiddleware;
     GlobalEnvironmentModel* mGlobalEnvironmentModel;
     int mTrackingCounter = 0;
+    LabelBits mLabelBits;
     TrackedObjects mObjects;
+    std::vector<const EnvironmentModelObject*> mObjectKeys; // keys of mObjects entries (same order)
+    std::vector<ChangeMask> mObjectChanges; // pending changes of mObjects entries (same order)
+    std::vector<std::vector<const EnvironmentModelObject*>> mChanges; // changed objects per subscription
+    std::unordered_map<const EnvironmentModelObject*, std::size_t> mObjectIndex;
+    std::priority_queue<Expiry, std::vector<Expiry>, std::greater<Expiry>> mExpiries;
     std::vector<Sensor*> mSensors;
 };
 
@@ -0,0 +1,54 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/envmod/ObjectSnapshot.h"
+#include "artery/envmod/EnvironmentModelObject.h"
+
+namespace artery
+{
+
+void ObjectSnapshot::clear()
+{
+    mObjects.clear();
+    mCentreX.clear();
+    mCentreY.clear();
+    mRadius.clear();
+    mHeading.clear();
+    mOffsets.assign(1, 0);
+    mOutlineX.clear();
+    mOutlineY.clear();
+}
+
+void ObjectSnapshot::reserve(std::size_t objects, std::size_t vertices)
+{
+    mObjects.reserve(objects);
+    mCentreX.reserve(objects);
+    mCentreY.reserve(objects);
+    mRadius.reserve(objects);
+    mHeading.reserve(objects);
+    mOffsets.reserve(objects + 1);
+    mOutlineX.reserve(vertices);
+    mOutlineY.reserve(vertices);
+}
+
+ObjectSnapshot::Index ObjectSnapshot::add(const EnvironmentModelObject& object)
+{
+    const Index index = mObjects.size();
+    const Position& centre = object.getCentrePoint();
+    mObjects.push_back(&object);
+    mCentreX.push_back(centre.x.value());
+    mCentreY.push_back(centre.y.value());
+    mRadius.push_back(object.getRadius().value());
+    mHeading.push_back(object.getHeading().radian());
+
+    for (const Position& vertex : object.getOutline()) {
+        mOutlineX.push_back(vertex.x.value());
+        mOutlineY.push_back(vertex.y.value());
+    }
+    mOffsets.push_back(mOutlineX.size());
+    return index;
+}
+
+} // namespace artery
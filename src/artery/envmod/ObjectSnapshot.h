@@ -0,0 +1,71 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ENVMOD_OBJECTSNAPSHOT_H_W2HXQ9LE
+#define ENVMOD_OBJECTSNAPSHOT_H_W2HXQ9LE
+
+#include "artery/utility/Geometry.h"
+#include <cstddef>
+#include <vector>
+
+namespace artery
+{
+
+class EnvironmentModelObject;
+
+/**
+ * ObjectSnapshot stores poses and outlines of all environment model objects in contiguous arrays.
+ *
+ * GlobalEnvironmentModel refreshes its snapshot once per simulation step after updating its objects.
+ * Consumers scanning many objects read plain coordinates from a few arrays instead of calling
+ * virtual getters on objects scattered across the heap. The snapshot is not modified until the
+ * next refresh, thus it can be read concurrently.
+ */
+class ObjectSnapshot
+{
+public:
+    using Index = std::size_t;
+
+    void clear();
+    void reserve(std::size_t objects, std::size_t vertices);
+
+    /**
+     * Append current state of object
+     * \param object environment model object, has to outlive this snapshot's current contents
+     * \return index of added object
+     */
+    Index add(const EnvironmentModelObject& object);
+
+    std::size_t size() const { return mObjects.size(); }
+    bool empty() const { return mObjects.empty(); }
+
+    const EnvironmentModelObject& object(Index i) const { return *mObjects[i]; }
+    double centreX(Index i) const { return mCentreX[i]; }
+    double centreY(Index i) const { return mCentreY[i]; }
+    double radius(Index i) const { return mRadius[i]; }
+    double heading(Index i) const { return mHeading[i]; } // radian, OMNeT++ coordinate system
+
+    /**
+     * Outline vertices of object i are located at [outlineBegin(i), outlineEnd(i)) in outlineX/Y
+     */
+    std::size_t outlineBegin(Index i) const { return mOffsets[i]; }
+    std::size_t outlineEnd(Index i) const { return mOffsets[i + 1]; }
+    const std::vector<double>& outlineX() const { return mOutlineX; }
+    const std::vector<double>& outlineY() const { return mOutlineY; }
+
+private:
+    std::vector<const EnvironmentModelObject*> mObjects;
+    std::vector<double> mCentreX;
+    std::vector<double> mCentreY;
+    std::vector<double> mRadius;
+    std::vector<double> mHeading;
+    std::vector<std::size_t> mOffsets = { 0 };
+    std::vector<double> mOutlineX;
+    std::vector<double> mOutlineY;
+};
+
+} // namespace artery
+
+#endif /* ENVMOD_OBJECTSNAPSHOT_H_W2HXQ9LE */
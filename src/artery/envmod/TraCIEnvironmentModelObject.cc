@@ -8,11 +8,11 @@
 #include "artery/envmod/TraCIEnvironmentModelObject.h"
 #include "artery/traci/PersonController.h"
 #include "artery/traci/VehicleController.h"
-#include <boost/geometry/strategies/transform/matrix_transformers.hpp>
 #include <boost/math/constants/constants.hpp>
 #include <boost/units/cmath.hpp>
 #include <boost/units/systems/angle/degrees.hpp>
 #include <omnetpp/cexception.h>
+#include <cmath>
 
 namespace artery
 {
@@ -37,41 +37,40 @@ const std::vector<Position> squareAttachmentPoints = {
 
 const Position squareCentrePoint(-0.5, 0.0);
 
-#if BOOST_VERSION < 106400
-boost::geometry::strategy::transform::ublas_transformer<double, 2, 2>
-transformObject(double length, double width, const Position& pos, Angle alpha)
+// closed form of scaling to vehicle dimensions, rotation into driving direction and translation
+// to front bumper position (same rotation sense as boost::geometry's rotate_transformer)
+class ObjectTransform
 {
-    using namespace boost::geometry::strategy::transform;
-    using result_type = ublas_transformer<double, 2, 2>;
-    using matrix_type = boost::numeric::ublas::matrix<double>;
-
-    // scale square to vehicle dimensions
-    scale_transformer<double, 2, 2> scaling(length, width);
-    // rotate into driving direction
-    rotate_transformer<boost::geometry::radian, double, 2, 2> rotation(alpha.radian());
-    // move to given front bumper position
-    translate_transformer<double, 2, 2> translation(pos.x.value(), pos.y.value());
-
-    const matrix_type rotateAfterScale = prod(rotation.matrix(), scaling.matrix());
-    const matrix_type translateAfterRotateAfterScale = prod(translation.matrix(), rotateAfterScale);
-    return result_type { translateAfterRotateAfterScale };
-}
-#else
-boost::geometry::strategy::transform::matrix_transformer<double, 2, 2>
-transformObject(double length, double width, const Position& pos, Angle alpha)
-{
-    using namespace boost::geometry::strategy::transform;
+public:
+    ObjectTransform(double length, double width, const Position& pos, Angle alpha) :
+        mLength(length), mWidth(width), mCos(std::cos(alpha.radian())), mSin(std::sin(alpha.radian())),
+        mX(pos.x.value()), mY(pos.y.value())
+    {
+    }
 
-    // scale square to vehicle dimensions
-    scale_transformer<double, 2, 2> scaling(length, width);
-    // rotate into driving direction
-    rotate_transformer<boost::geometry::radian, double, 2, 2> rotation(alpha.radian());
-    // move to given front bumper position
-    translate_transformer<double, 2, 2> translation(pos.x.value(), pos.y.value());
+    Position operator()(const Position& local) const
+    {
+        const double x = mLength * local.x.value();
+        const double y = mWidth * local.y.value();
+        return Position { mCos * x + mSin * y + mX, -mSin * x + mCos * y + mY };
+    }
 
-    return matrix_transformer<double, 2, 2> { translation.matrix() * rotation.matrix() * scaling.matrix() };
-}
-#endif
+    void operator()(const std::vector<Position>& local, std::vector<Position>& result) const
+    {
+        result.resize(local.size());
+        for (std::size_t i = 0; i < local.size(); ++i) {
+            result[i] = (*this)(local[i]);
+        }
+    }
+
+private:
+    double mLength;
+    double mWidth;
+    double mCos;
+    double mSin;
+    double mX;
+    double mY;
+};
 
 }
 
@@ -105,16 +104,25 @@ void TraCIEnvironmentModelObject::update()
     // Update the internal vdp
     VehicleDataProvider::update(getKinematics(*mController));
 
+    // stationary objects keep their geometry, e.g. vehicles waiting at traffic lights
+    const Position& position = getVehicleData().position();
+    const vanetza::units::Angle vehicleHeading = getVehicleData().heading();
+    if (mHasPose && position.x == mPosePosition.x && position.y == mPosePosition.y && vehicleHeading == mPoseHeading) {
+        return;
+    }
+    mPosePosition = position;
+    mPoseHeading = vehicleHeading;
+    mHasPose = true;
+
     // Recalculate all time and position dependent attributes
     using namespace boost::math::double_constants;
-    Angle heading = -1.0 * (getVehicleData().heading() - 0.5 * pi * boost::units::si::radian);
-    auto affine = transformObject(mLength.value(), mWidth.value(), getVehicleData().position(), heading);
-
-    boost::geometry::transform(squareCentrePoint, mCentrePoint, affine);
-    mOutline.clear();
-    boost::geometry::transform(squareOutline, mOutline, affine);
-    mAttachmentPoints.clear();
-    boost::geometry::transform(squareAttachmentPoints, mAttachmentPoints, affine);
+    Angle heading = -1.0 * (vehicleHeading - 0.5 * pi * boost::units::si::radian);
+    const ObjectTransform transform(mLength.value(), mWidth.value(), position, heading);
+
+    // one sine and cosine per update, outline vectors keep their memory
+    mCentrePoint = transform(squareCentrePoint);
+    transform(squareOutline, mOutline);
+    transform(squareAttachmentPoints, mAttachmentPoints);
 }
 
 EnvironmentModelObject::Heading TraCIEnvironmentModelObject::getHeading() const
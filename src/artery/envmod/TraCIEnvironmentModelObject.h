@@ -42,6 +42,9 @@ public:
 private:
 
     const traci::Controller* mController;
+    Position mPosePosition; /*< position of last geometry update */
+    vanetza::units::Angle mPoseHeading; /*< heading of last geometry update */
+    bool mHasPose = false;
 };
 
 } // namespace artery
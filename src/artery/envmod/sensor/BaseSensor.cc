@@ -59,6 +59,35 @@ void BaseSensor::initialize()
     mMiddleware = middleware;
     mLocalEnvironmentModel = mMiddleware->getFacilities().get_mutable_ptr<LocalEnvironmentModel>();
     mGlobalEnvironmentModel = mMiddleware->getFacilities().get_mutable_ptr<GlobalEnvironmentModel>();
+
+    mMeasurementInterval = par("measurementInterval");
+    const SimTime jitter = par("measurementJitter");
+    if (mMeasurementInterval < SIMTIME_ZERO || jitter < SIMTIME_ZERO) {
+        throw cRuntimeError("measurement interval and jitter must not be negative");
+    }
+    // random phase keeps sensors of equal rate from measuring all at the same refresh
+    mNextMeasurement = simTime();
+    if (jitter > SIMTIME_ZERO) {
+        // no random number is drawn by default, i.e. random streams of existing configurations are kept
+        mNextMeasurement += SimTime { uniform(0.0, jitter.dbl()) };
+    }
+}
+
+bool BaseSensor::isMeasurementDue(SimTime now) const
+{
+    return now >= mNextMeasurement;
+}
+
+void BaseSensor::measurementConducted(SimTime now)
+{
+    if (mMeasurementInterval > SIMTIME_ZERO) {
+        // stick to the phase grid even if refreshes do not coincide with it
+        while (mNextMeasurement <= now) {
+            mNextMeasurement += mMeasurementInterval;
+        }
+    } else {
+        mNextMeasurement = now;
+    }
 }
 
 std::string BaseSensor::getEgoId()
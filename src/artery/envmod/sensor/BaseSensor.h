@@ -23,8 +23,12 @@ class BaseSensor : public Sensor
 public:
     BaseSensor();
 
+    bool isMeasurementDue(omnetpp::SimTime now) const override;
+    void measurementConducted(omnetpp::SimTime now) override;
+
 protected:
     void initialize() override;
+    omnetpp::SimTime getMeasurementInterval() const { return mMeasurementInterval; }
     Facilities& getFacilities();
     const Facilities& getFacilities() const;
     Middleware& getMiddleware();
@@ -37,6 +41,8 @@ protected:
 
 private:
     Middleware* mMiddleware;
+    omnetpp::SimTime mMeasurementInterval; // zero: measure at every refresh
+    omnetpp::SimTime mNextMeasurement;
 };
 
 } // namespace artery
@@ -38,6 +38,25 @@ void CamSensor::finish()
 void CamSensor::measurement()
 {
     Enter_Method("measurement");
+    if (mPendingStations.empty()) {
+        return;
+    }
+
+    mDetection.objects.clear();
+    for (uint32_t stationID : mPendingStations) {
+        auto identity = mIdentityRegistry->lookup<IdentityRegistry::application>(stationID);
+        if (identity) {
+            mDetection.objects.push_back(mGlobalEnvironmentModel->getObject(identity->traci));
+        } else {
+            EV_WARN << "Unknown identity for station ID " << stationID;
+        }
+    }
+    mPendingStations.clear();
+    mPendingIndex.clear();
+
+    mLocalEnvironmentModel->complementObjects(mDetection, *this);
+    // objects are not kept alive by the sensor until its next measurement
+    mDetection.objects.clear();
 }
 
 void CamSensor::receiveSignal(cComponent*, simsignal_t signal, cObject *obj, cObject*)
@@ -46,14 +65,8 @@ void CamSensor::receiveSignal(cComponent*, simsignal_t signal, cObject *obj, cOb
         auto* cam = dynamic_cast<CaObject*>(obj);
         if (cam) {
             uint32_t stationID = cam->asn1()->header.stationID;
-            auto identity = mIdentityRegistry->lookup<IdentityRegistry::application>(stationID);
-            if (identity) {
-                auto object = mGlobalEnvironmentModel->getObject(identity->traci);
-                SensorDetection detection;
-                detection.objects.push_back(object);
-                mLocalEnvironmentModel->complementObjects(detection, *this);
-            } else {
-                EV_WARN << "Unknown identity for station ID " << stationID;
+            if (mPendingIndex.insert(stationID).second) {
+                mPendingStations.push_back(stationID);
             }
         } else {
             EV_ERROR << "received signal has no CaObject";
@@ -74,7 +87,7 @@ const std::string& CamSensor::getSensorCategory() const
 
 SensorDetection CamSensor::detectObjects() const
 {
-    // return empty sensor detection because CAM objects are added upon CAM reception signal
+    // return empty sensor detection because CAM objects are added by measurement
     SensorDetection detection;
     return detection;
 }
@@ -8,14 +8,24 @@
 #define ENVMOD_CAMSENSOR_H_
 
 #include "artery/envmod/sensor/BaseSensor.h"
+#include "artery/envmod/sensor/SensorDetection.h"
 #include <vanetza/asn1/cam.hpp>
 #include <omnetpp/clistener.h>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
 
 namespace artery
 {
 
 class IdentityRegistry;
 
+/**
+ * CamSensor complements the local environment model by stations it has received CAMs from.
+ *
+ * Stations are collected upon CAM reception and resolved in one batch per measurement,
+ * i.e. repeated CAMs of a station between two measurements result in a single detection.
+ */
 class CamSensor : public BaseSensor, public omnetpp::cListener
 {
 public:
@@ -36,6 +46,9 @@ private:
     IdentityRegistry* mIdentityRegistry;
     omnetpp::SimTime mValidityPeriod;
     std::string mSensorName;
+    std::vector<uint32_t> mPendingStations; /*< CAM senders since last measurement in order of reception */
+    std::unordered_set<uint32_t> mPendingIndex;
+    SensorDetection mDetection; /*< reused by measurements */
 };
 
 } // namespace artery
@@ -7,11 +7,19 @@
 #include "artery/application/Middleware.h"
 #include "artery/envmod/GlobalEnvironmentModel.h"
 #include "artery/envmod/sensor/FovSensor.h"
+#include "artery/envmod/sensor/OcclusionEngine.h"
 #include "artery/envmod/sensor/SensorDetection.h"
+#include "artery/envmod/sensor/StaticOcclusionMask.h"
 #include "artery/envmod/LocalEnvironmentModel.h"
 #include "artery/envmod/EnvironmentModelObstacle.h"
+#include "artery/utility/ProfilingScope.h"
 #include <boost/geometry/geometries/register/linestring.hpp>
-#include <unordered_set>
+#include <boost/math/constants/constants.hpp>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <tuple>
+#include <unordered_map>
 
 using namespace omnetpp;
 
@@ -21,6 +29,83 @@ BOOST_GEOMETRY_REGISTER_LINESTRING(LineOfSight)
 namespace artery
 {
 
+namespace
+{
+
+/**
+ * Get validated sensor cone in local frame
+ *
+ * Cone geometry depends on configuration only, thus all sensors of the same configuration
+ * (e.g. the front radar of every vehicle) share one cone created and validated by the first of them.
+ */
+std::shared_ptr<const std::vector<Position>> getLocalSensorCone(const SensorConfigFov& config)
+{
+    using Key = std::tuple<double, double, unsigned, SensorPosition>;
+    static std::map<Key, std::shared_ptr<const std::vector<Position>>> cones;
+
+    const Key key { config.fieldOfView.range.value(), config.fieldOfView.angle.value(), config.numSegments, config.sensorPosition };
+    auto found = cones.find(key);
+    if (found == cones.end()) {
+        auto cone = std::make_shared<const std::vector<Position>>(createSensorArc(config));
+        boost::geometry::validity_failure_type failure;
+        if (!boost::geometry::is_valid(*cone, failure)) {
+            std::string error_msg = boost::geometry::validity_failure_type_message(failure);
+            throw cRuntimeError("sensor cone is invalid: %s", error_msg.c_str());
+        }
+        found = cones.emplace(key, std::move(cone)).first;
+    }
+    return found->second;
+}
+
+/**
+ * Get figure of a pool, i.e. reuse figure at index or append a new one
+ * @param group pool of figures of the same type
+ * @param index figure index within pool
+ * @param init sets up attributes of new figures, which are kept by reused figures
+ */
+template<typename Figure, typename Init>
+Figure* pooledFigure(cGroupFigure* group, int index, Init init)
+{
+    if (index < group->getNumFigures()) {
+        auto figure = static_cast<Figure*>(group->getFigure(index));
+        figure->setVisible(true);
+        return figure;
+    }
+
+    auto figure = new Figure();
+    init(*figure);
+    group->addFigure(figure);
+    return figure;
+}
+
+// surplus figures are kept for later refreshes
+void hideSurplusFigures(cGroupFigure* group, int used)
+{
+    for (int i = used; i < group->getNumFigures(); ++i) {
+        group->getFigure(i)->setVisible(false);
+    }
+}
+
+void assignPoints(std::vector<cFigure::Point>& points, const std::vector<Position>& positions)
+{
+    points.clear();
+    for (const Position& position : positions) {
+        points.push_back(cFigure::Point { position.x.value(), position.y.value() });
+    }
+}
+
+void setPolygon(cPolygonFigure& polygon, const std::string& name, const std::vector<Position>& outline,
+        std::vector<cFigure::Point>& buffer)
+{
+    if (name != polygon.getName()) {
+        polygon.setName(name.c_str());
+    }
+    assignPoints(buffer, outline);
+    polygon.setPoints(buffer);
+}
+
+} // namespace
+
 FovSensor::FovSensor() :
     mGroupFigure(nullptr), mSensorConeFigure(nullptr), mLinesOfSightFigure(nullptr),
     mObjectsFigure(nullptr), mObstaclesFigure(nullptr)
@@ -64,13 +149,37 @@ void FovSensor::initialize()
     mFovConfig.numSegments = par("numSegments");
     mFovConfig.doLineOfSightCheck = par("doLineOfSightCheck");
 
+    if (mFovConfig.fieldOfView.range <= 0.0 * boost::units::si::meter) {
+        throw cRuntimeError("sensor range is 0 meter or less");
+    } else if (mFovConfig.fieldOfView.angle > 360.0 * boost::units::degree::degrees) {
+        throw cRuntimeError("sensor opening angle exceeds 360 degree");
+    }
+
+    mLocalSensorCone = getLocalSensorCone(mFovConfig);
+
+    const std::string visibility = par("visibilityAlgorithm").stdstringValue();
+    if (visibility == "rays") {
+        mVisibilityAlgorithm = VisibilityAlgorithm::Rays;
+    } else if (visibility == "sweep") {
+        mVisibilityAlgorithm = VisibilityAlgorithm::Sweep;
+    } else {
+        throw cRuntimeError("unknown visibility algorithm \"%s\"", visibility.c_str());
+    }
+    mSweepBinsPerSegment = par("sweepBinsPerSegment");
+
     initializeVisualization();
 }
 
 void FovSensor::measurement()
 {
     Enter_Method("measurement");
-    auto detection = detectObjects();
+    ARTERY_PROFILE_SCOPE("envmod.measurement");
+    completeMeasurement(detectObjects());
+}
+
+void FovSensor::completeMeasurement(SensorDetection&& detection)
+{
+    Enter_Method_Silent();
     mLocalEnvironmentModel->complementObjects(detection, *this);
     mLastDetection = std::move(detection);
 }
@@ -78,26 +187,66 @@ void FovSensor::measurement()
 SensorDetection FovSensor::detectObjects() const
 {
     namespace bg = boost::geometry;
-    if (mFovConfig.fieldOfView.range <= 0.0 * boost::units::si::meter) {
-        throw std::runtime_error("sensor range is 0 meter or less");
-    } else if (mFovConfig.fieldOfView.angle > 360.0 * boost::units::degree::degrees) {
-        throw std::runtime_error("sensor opening angle exceeds 360 degree");
-    }
-
     SensorDetection detection = createSensorCone();
-    auto preselObjectsInSensorRange = mGlobalEnvironmentModel->preselectObjects(mFovConfig.egoID, detection.sensorCone);
+    // bounding circle against sector is cheaper than polygon test and still a superset of objects touching the cone
+    const SensorSector sector = createSensorSector(mFovConfig, detection.sensorOrigin, detection.sensorHeading);
+    std::vector<ObjectHandle>& preselObjectsInSensorRange = mScratch.objects;
+    mGlobalEnvironmentModel->preselectObjects(mFovConfig.egoID, sector, preselObjectsInSensorRange);
 
     // get obstacles intersecting with sensor cone
-    auto obstacleIntersections = mGlobalEnvironmentModel->preselectObstacles(detection.sensorCone);
+    std::vector<ObstacleHandle>& obstacleIntersections = mScratch.obstacles;
+    preselectObstacles(detection, obstacleIntersections);
 
-    if (mFovConfig.doLineOfSightCheck)
+    if (mFovConfig.doLineOfSightCheck && mVisibilityAlgorithm == VisibilityAlgorithm::Sweep)
+    {
+        detectVisibleBySweep(detection, preselObjectsInSensorRange, obstacleIntersections);
+    }
+    else if (mFovConfig.doLineOfSightCheck)
     {
-        std::unordered_set<std::shared_ptr<EnvironmentModelObstacle>> blockingObstacles;
+        std::vector<bool>& blockingObstacles = mScratch.blockingObstacles;
+        blockingObstacles.assign(obstacleIntersections.size(), false);
+
+        // flatten outlines once for fast rejection of non-blocking candidates
+        OcclusionEngine& objectOutlines = mScratch.objectOutlines;
+        auto& objectIndices = mScratch.objectIndices;
+        objectOutlines.clear();
+        objectIndices.clear();
+        objectOutlines.reserve(preselObjectsInSensorRange.size(), 4 * preselObjectsInSensorRange.size());
+        for (ObjectHandle object : preselObjectsInSensorRange) {
+            objectIndices.emplace(object->get(), objectOutlines.add((*object)->getOutline()));
+        }
+
+        const StaticOcclusionMask* staticOcclusion = getStaticOcclusionMask(detection, obstacleIntersections);
+        OcclusionEngine& obstacleOutlines = mScratch.obstacleOutlines;
+        obstacleOutlines.clear();
+        if (!staticOcclusion) {
+            for (ObstacleHandle obstacle : obstacleIntersections) {
+                ASSERT(*obstacle);
+                obstacleOutlines.add((*obstacle)->getOutline());
+            }
+        }
+
+        auto occludes = [&](OcclusionEngine::Index i, const LineOfSight& lineOfSight) {
+            return objectOutlines.mayTouch(i, lineOfSight[0], lineOfSight[1]) &&
+                bg::crosses(lineOfSight, (*preselObjectsInSensorRange[i])->getOutline());
+        };
+
+        // blockers found in this step are used as first guess in the next step
+        BlockerCache blockers;
 
         // check if objects in sensor cone are hidden by another object or an obstacle
-        for (const auto& object : preselObjectsInSensorRange)
+        for (ObjectHandle object : preselObjectsInSensorRange)
         {
-            for (const auto& objectPoint : object->getOutline())
+            OcclusionEngine::Index hint = objectIndices.size();
+            auto lastBlocker = mLastBlockers.find(object->get());
+            if (lastBlocker != mLastBlockers.end()) {
+                auto found = objectIndices.find(lastBlocker->second);
+                if (found != objectIndices.end()) {
+                    hint = found->second;
+                }
+            }
+
+            for (const auto& objectPoint : (*object)->getOutline())
             {
                 // skip objects points outside of sensor cone
                 if (!bg::covered_by(objectPoint, detection.sensorCone)) {
@@ -108,25 +257,47 @@ SensorDetection FovSensor::detectObjects() const
                 lineOfSight[0] = detection.sensorOrigin;
                 lineOfSight[1] = objectPoint;
 
-                bool noVehicleOccultation = std::none_of(preselObjectsInSensorRange.begin(), preselObjectsInSensorRange.end(),
-                        [&](const std::shared_ptr<EnvironmentModelObject>& object) {
-                            return bg::crosses(lineOfSight, object->getOutline());
-                        });
-
-                bool noObstacleOccultation = std::none_of(obstacleIntersections.begin(), obstacleIntersections.end(),
-                        [&](const std::shared_ptr<EnvironmentModelObstacle>& obstacle) {
-                            ASSERT(obstacle);
-                            if (bg::intersects(lineOfSight, obstacle->getOutline())) {
-                                blockingObstacles.insert(obstacle);
-                                return true;
-                            } else {
-                                return false;
-                            }
-                        });
+                bool noVehicleOccultation = true;
+                if (hint < objectIndices.size() && occludes(hint, lineOfSight)) {
+                    noVehicleOccultation = false;
+                } else {
+                    for (OcclusionEngine::Index i = 0; i < preselObjectsInSensorRange.size(); ++i) {
+                        if (occludes(i, lineOfSight)) {
+                            noVehicleOccultation = false;
+                            hint = i;
+                            break;
+                        }
+                    }
+                }
+
+                bool noObstacleOccultation = true;
+                if (staticOcclusion) {
+                    const StaticOcclusionMask::Index blocker = staticOcclusion->findBlocker(objectPoint);
+                    if (blocker != StaticOcclusionMask::none) {
+                        blockingObstacles[blocker] = true;
+                        noObstacleOccultation = false;
+                    }
+                } else {
+                    for (OcclusionEngine::Index i = 0; i < obstacleIntersections.size(); ++i) {
+                        // segment either touches the obstacle's boundary or it is completely inside or outside
+                        const bool intersects = obstacleOutlines.mayTouch(i, lineOfSight[0], lineOfSight[1]) ?
+                            bg::intersects(lineOfSight, (*obstacleIntersections[i])->getOutline()) :
+                            obstacleOutlines.contains(i, lineOfSight[0]);
+                        if (intersects) {
+                            blockingObstacles[i] = true;
+                            noObstacleOccultation = false;
+                            break;
+                        }
+                    }
+                }
+
+                if (!noVehicleOccultation) {
+                    blockers[object->get()] = preselObjectsInSensorRange[hint]->get();
+                }
 
                 if (noVehicleOccultation && noObstacleOccultation) {
-                    if (detection.objects.empty() || detection.objects.back() != object) {
-                        detection.objects.push_back(object);
+                    if (detection.objects.empty() || detection.objects.back() != *object) {
+                        detection.objects.push_back(*object);
                     }
 
                     if (mDrawLinesOfSight) {
@@ -139,13 +310,18 @@ SensorDetection FovSensor::detectObjects() const
             } // for each (corner) point of object polygon
         } // for each object
 
-        detection.obstacles.assign(blockingObstacles.begin(), blockingObstacles.end());
+        for (std::size_t i = 0; i < obstacleIntersections.size(); ++i) {
+            if (blockingObstacles[i]) {
+                detection.obstacles.push_back(*obstacleIntersections[i]);
+            }
+        }
+        mLastBlockers = std::move(blockers);
     } else {
-        for (const auto& object : preselObjectsInSensorRange) {
+        for (ObjectHandle object : preselObjectsInSensorRange) {
             // preselection: object's bounding box and sensor cone's bounding box intersect
             // now: check if their actual geometries intersect somewhere
-            if (bg::intersects(object->getOutline(), detection.sensorCone)) {
-                detection.objects.push_back(object);
+            if (bg::intersects((*object)->getOutline(), detection.sensorCone)) {
+                detection.objects.push_back(*object);
             }
         }
     }
@@ -153,19 +329,162 @@ SensorDetection FovSensor::detectObjects() const
     return detection;
 }
 
+void FovSensor::detectVisibleBySweep(SensorDetection& detection,
+        const std::vector<ObjectHandle>& objects, const std::vector<ObstacleHandle>& obstacles) const
+{
+    const double pi = boost::math::double_constants::pi;
+    const double twoPi = boost::math::double_constants::two_pi;
+    const bool fullCircle = mFovConfig.fieldOfView.angle == 360.0 * boost::units::degree::degrees;
+    const double opening = mFovConfig.fieldOfView.angle / boost::units::degree::degrees * pi / 180.0;
+    const double range = mFovConfig.fieldOfView.range / boost::units::si::meters;
+    const std::size_t bins = std::max(1u, mFovConfig.numSegments) * std::max(1, mSweepBinsPerSegment);
+    const double binWidth = opening / bins;
+
+    // derive start angle and sweep direction from the cone's first arc points
+    const Position& origin = detection.sensorOrigin;
+    const std::vector<Position>& cone = detection.sensorCone;
+    const std::size_t firstArc = fullCircle ? 0 : 1;
+    if (cone.size() < firstArc + 2) {
+        return;
+    }
+
+    const double ox = origin.x.value();
+    const double oy = origin.y.value();
+    auto angleOf = [ox, oy](const Position& p) { return std::atan2(p.y.value() - oy, p.x.value() - ox); };
+    const double start = angleOf(cone[firstArc]);
+    const Position& second = cone[firstArc + 1];
+    const double cross = (cone[firstArc].x.value() - ox) * (second.y.value() - oy) -
+        (cone[firstArc].y.value() - oy) * (second.x.value() - ox);
+    const double direction = cross < 0.0 ? -1.0 : 1.0;
+
+    // angle relative to sweep start in [0, 2pi)
+    auto sweepAngle = [&](double x, double y) {
+        double angle = direction * (std::atan2(y - oy, x - ox) - start);
+        angle = std::fmod(angle, twoPi);
+        return angle < 0.0 ? angle + twoPi : angle;
+    };
+
+    struct Bin
+    {
+        double objectDepth = std::numeric_limits<double>::infinity();
+        double obstacleDepth = std::numeric_limits<double>::infinity();
+        std::size_t object = 0;
+        std::size_t obstacle = 0;
+    };
+    std::vector<Bin> buffer(bins);
+
+    // project edge p-q into angular depth buffer, update is called with bin and ray-edge distance
+    auto project = [&](const Position& p, const Position& q, auto update) {
+        const double px = p.x.value(), py = p.y.value();
+        const double qx = q.x.value(), qy = q.y.value();
+        double lo = sweepAngle(px, py);
+        double hi = sweepAngle(qx, qy);
+        if (lo > hi) {
+            std::swap(lo, hi);
+        }
+
+        const double ex = qx - px;
+        const double ey = qy - py;
+        auto projectRange = [&](double from, double to) {
+            const long first = std::max(0L, static_cast<long>(std::ceil(from / binWidth - 0.5)));
+            const long last = std::min(static_cast<long>(bins) - 1, static_cast<long>(std::floor(to / binWidth - 0.5)));
+            for (long k = first; k <= last; ++k) {
+                // intersect ray at bin center with edge
+                const double theta = start + direction * (k + 0.5) * binWidth;
+                const double dx = std::cos(theta);
+                const double dy = std::sin(theta);
+                const double denom = dx * ey - dy * ex;
+                if (std::abs(denom) < 1e-12) {
+                    continue;
+                }
+                const double t = ((px - ox) * ey - (py - oy) * ex) / denom;
+                if (t >= 0.0 && t <= range) {
+                    update(buffer[k], t);
+                }
+            }
+        };
+
+        if (hi - lo > pi) {
+            // edge spans across the sweep start
+            projectRange(hi, twoPi);
+            projectRange(0.0, lo);
+        } else {
+            projectRange(lo, hi);
+        }
+    };
+
+    for (std::size_t i = 0; i < objects.size(); ++i) {
+        const std::vector<Position>& outline = (*objects[i])->getOutline();
+        for (std::size_t j = 0; j < outline.size(); ++j) {
+            project(outline[j], outline[(j + 1) % outline.size()], [i](Bin& bin, double depth) {
+                if (depth < bin.objectDepth) {
+                    bin.objectDepth = depth;
+                    bin.object = i;
+                }
+            });
+        }
+    }
+
+    for (std::size_t i = 0; i < obstacles.size(); ++i) {
+        const std::vector<Position>& outline = (*obstacles[i])->getOutline();
+        for (std::size_t j = 0; j < outline.size(); ++j) {
+            project(outline[j], outline[(j + 1) % outline.size()], [i](Bin& bin, double depth) {
+                if (depth < bin.obstacleDepth) {
+                    bin.obstacleDepth = depth;
+                    bin.obstacle = i;
+                }
+            });
+        }
+    }
+
+    // read visibility off the depth buffer
+    std::vector<bool> visibleObjects(objects.size(), false);
+    std::vector<bool> blockingObstacles(obstacles.size(), false);
+    for (std::size_t k = 0; k < bins; ++k) {
+        const Bin& bin = buffer[k];
+        if (bin.objectDepth < bin.obstacleDepth) {
+            visibleObjects[bin.object] = true;
+            if (mDrawLinesOfSight) {
+                const double theta = start + direction * (k + 0.5) * binWidth;
+                detection.visiblePoints.push_back(Position {
+                    ox + bin.objectDepth * std::cos(theta), oy + bin.objectDepth * std::sin(theta) });
+            }
+        } else if (bin.objectDepth < std::numeric_limits<double>::infinity()) {
+            blockingObstacles[bin.obstacle] = true;
+        }
+    }
+
+    for (std::size_t i = 0; i < objects.size(); ++i) {
+        if (visibleObjects[i]) {
+            detection.objects.push_back(*objects[i]);
+        }
+    }
+    for (std::size_t i = 0; i < obstacles.size(); ++i) {
+        if (blockingObstacles[i]) {
+            detection.obstacles.push_back(*obstacles[i]);
+        }
+    }
+}
+
 SensorDetection FovSensor::createSensorCone() const
 {
     SensorDetection detection;
     const auto& egoObj = mGlobalEnvironmentModel->getObject(mFovConfig.egoID);
     if (egoObj) {
         detection.sensorOrigin = egoObj->getAttachmentPoint(mFovConfig.sensorPosition);
-        detection.sensorCone = createSensorArc(mFovConfig, *egoObj);
+        detection.sensorHeading = egoObj->getHeading();
+        transformSensorArc(*mLocalSensorCone, detection.sensorOrigin, detection.sensorHeading, detection.sensorCone);
     } else {
         throw std::runtime_error("no object found for ID " + mFovConfig.egoID);
     }
     return detection;
 }
 
+void FovSensor::preselectObstacles(const SensorDetection& detection, std::vector<ObstacleHandle>& candidates) const
+{
+    mGlobalEnvironmentModel->preselectObstacles(detection.sensorCone, candidates, false);
+}
+
 void FovSensor::initializeVisualization()
 {
     assert(mGroupFigure);
@@ -216,7 +535,8 @@ const FieldOfView& FovSensor::getFieldOfView() const
 omnetpp::SimTime FovSensor::getValidityPeriod() const
 {
     using namespace omnetpp;
-    return SimTime { 200, SIMTIME_MS };
+    // detections have to outlast the gap until this sensor's next measurement
+    return SimTime { 200, SIMTIME_MS } + getMeasurementInterval();
 }
 
 SensorPosition FovSensor::position() const
@@ -246,65 +566,51 @@ void FovSensor::refreshDisplay() const
         return;
     }
 
+    std::vector<cFigure::Point> points;
     if (mSensorConeFigure) {
-        std::vector<cFigure::Point> points;
-        for (const auto& position : mLastDetection->sensorCone) {
-            points.push_back(cFigure::Point { position.x.value(), position.y.value() });
-        }
+        assignPoints(points, mLastDetection->sensorCone);
         mSensorConeFigure->setPoints(points);
     }
 
     if (mLinesOfSightFigure) {
-        // remove previous lines
-        while (mLinesOfSightFigure->getNumFigures() > 0) {
-            delete mLinesOfSightFigure->removeFigure(0);
-        }
-
         const Position& startPoint = mLastDetection->sensorOrigin;
+        const cFigure::Point start { startPoint.x.value(), startPoint.y.value() };
+        int lines = 0;
         for (const Position& endPoint : mLastDetection->visiblePoints) {
-            auto line = new cLineFigure();
-            line->setLineColor(mColor);
-            line->setLineStyle(cFigure::LINE_DASHED);
-            line->setStart(cFigure::Point { startPoint.x.value(), startPoint.y.value() });
+            auto line = pooledFigure<cLineFigure>(mLinesOfSightFigure, lines++, [this](cLineFigure& figure) {
+                figure.setLineColor(mColor);
+                figure.setLineStyle(cFigure::LINE_DASHED);
+            });
+            line->setStart(start);
             line->setEnd(cFigure::Point { endPoint.x.value(), endPoint.y.value() });
-            mLinesOfSightFigure->addFigure(line);
         }
+        hideSurplusFigures(mLinesOfSightFigure, lines);
     }
 
     if (mObstaclesFigure) {
-        // remove previous obstacles
-        while (mObstaclesFigure->getNumFigures() > 0) {
-            delete mObstaclesFigure->removeFigure(0);
-        }
-
+        int polygons = 0;
         for (const auto& obstacle : mLastDetection->obstacles) {
-            auto polygon = new cPolygonFigure(obstacle->getObstacleId().c_str());
-            polygon->setFilled(true);
-            polygon->setFillColor(mColor);
-            polygon->setLineColor(cFigure::BLUE);
-            for (const auto& position : obstacle->getOutline()) {
-                polygon->addPoint(cFigure::Point { position.x.value(), position.y.value() });
-            }
-            mObstaclesFigure->addFigure(polygon);
+            auto polygon = pooledFigure<cPolygonFigure>(mObstaclesFigure, polygons++, [this](cPolygonFigure& figure) {
+                figure.setFilled(true);
+                figure.setFillColor(mColor);
+                figure.setLineColor(cFigure::BLUE);
+            });
+            setPolygon(*polygon, obstacle->getObstacleId(), obstacle->getOutline(), points);
         }
+        hideSurplusFigures(mObstaclesFigure, polygons);
     }
 
     if (mObjectsFigure) {
-        // remove previous objects
-        while (mObjectsFigure->getNumFigures() > 0) {
-            delete mObjectsFigure->removeFigure(0);
-        }
-
+        int polygons = 0;
         for (const auto& object : mLastDetection->objects) {
-            auto polygon = new cPolygonFigure(object->getExternalId().c_str());
-            polygon->setFilled(true);
-            polygon->setFillColor(mColor);
-            polygon->setLineColor(cFigure::RED);
-            for (const auto& position : object->getOutline()) {
-                polygon->addPoint(cFigure::Point { position.x.value(), position.y.value() });
-            }
-            mObjectsFigure->addFigure(polygon);
+            auto polygon = pooledFigure<cPolygonFigure>(mObjectsFigure, polygons++, [this](cPolygonFigure& figure) {
+                figure.setFilled(true);
+                figure.setFillColor(mColor);
+                figure.setLineColor(cFigure::RED);
+            });
+            setPolygon(*polygon, object->getExternalId(), object->getOutline(), points);
         }
+        hideSurplusFigures(mObjectsFigure, polygons);
     }
 }
 
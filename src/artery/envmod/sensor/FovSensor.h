@@ -10,13 +10,18 @@
 #include "artery/envmod/sensor/SensorConfiguration.h"
 #include "artery/envmod/sensor/SensorDetection.h"
 #include "artery/envmod/sensor/BaseSensor.h"
+#include "artery/envmod/sensor/OcclusionEngine.h"
 #include <omnetpp/ccanvas.h>
 #include <memory>
 #include <functional>
+#include <unordered_map>
+#include <vector>
 
 namespace artery
 {
 
+class StaticOcclusionMask;
+
 class FovSensor : public BaseSensor
 {
 public:
@@ -30,6 +35,8 @@ public:
     const std::string getSensorName() const override;
     void setSensorName(const std::string& name) override;
     SensorDetection detectObjects() const override;
+    bool hasConcurrentDetection() const override { return true; }
+    void completeMeasurement(SensorDetection&&) override;
 
 protected:
     template<typename T>
@@ -46,15 +53,62 @@ protected:
         T mValue;
     };
 
+    // same as GlobalEnvironmentModel's handles: valid throughout a measurement, no reference counting
+    using ObjectHandle = const std::shared_ptr<EnvironmentModelObject>*;
+    using ObstacleHandle = const std::shared_ptr<EnvironmentModelObstacle>*;
+
     void initialize() override;
     void finish() override;
     void initializeVisualization();
     void refreshDisplay() const override;
     virtual SensorDetection createSensorCone() const;
 
+    /**
+     * Preselect obstacles intersecting the sensor cone of a detection
+     * @param detection detection with sensor cone created by createSensorCone()
+     * @param candidates cleared and filled with candidates for line of sight checks
+     */
+    virtual void preselectObstacles(const SensorDetection& detection, std::vector<ObstacleHandle>& candidates) const;
+
+    /**
+     * Get precomputed occlusion mask of static obstacles for line of sight checks
+     * @param detection detection with sensor cone created by createSensorCone()
+     * @param obstacles obstacles returned by preselectObstacles() for this detection
+     * @return mask indexing obstacles or nullptr if every obstacle shall be tested
+     */
+    virtual const StaticOcclusionMask* getStaticOcclusionMask(const SensorDetection& detection,
+            const std::vector<ObstacleHandle>& obstacles) const { return nullptr; }
+
+    enum class VisibilityAlgorithm { Rays, Sweep };
+
+    /**
+     * Determine visible objects and blocking obstacles by an angular depth buffer.
+     * Each object and obstacle edge is projected once into bins spanning the sensor's opening angle.
+     */
+    void detectVisibleBySweep(SensorDetection&, const std::vector<ObjectHandle>&, const std::vector<ObstacleHandle>&) const;
+
     SensorConfigFov mFovConfig;
+    std::shared_ptr<const std::vector<Position>> mLocalSensorCone; // validated cone in sensor's local frame, shared by equal sensors
     Updatable<SensorDetection> mLastDetection;
     bool mDrawLinesOfSight;
+    VisibilityAlgorithm mVisibilityAlgorithm = VisibilityAlgorithm::Rays;
+    int mSweepBinsPerSegment = 1;
+
+    // last known blocker per occluded object (pointers are used as keys only, never dereferenced)
+    using BlockerCache = std::unordered_map<const EnvironmentModelObject*, const EnvironmentModelObject*>;
+    mutable BlockerCache mLastBlockers;
+
+    // buffers reused by every measurement of this sensor, their capacity is retained
+    struct Scratch
+    {
+        std::vector<ObjectHandle> objects;
+        std::vector<ObstacleHandle> obstacles;
+        OcclusionEngine objectOutlines;
+        OcclusionEngine obstacleOutlines;
+        std::unordered_map<const EnvironmentModelObject*, OcclusionEngine::Index> objectIndices;
+        std::vector<bool> blockingObstacles;
+    };
+    mutable Scratch mScratch;
 
 private:
     omnetpp::cFigure::Color mColor;
@@ -0,0 +1,150 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/envmod/sensor/OcclusionEngine.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace artery
+{
+
+namespace
+{
+
+// orientation values within this relative tolerance are treated as collinear
+const double sCollinearTolerance = 1e-9;
+
+inline int sign(double value, double tolerance)
+{
+    return (value > tolerance) - (value < -tolerance);
+}
+
+} // namespace
+
+void OcclusionEngine::clear()
+{
+    mX.clear();
+    mY.clear();
+    mOffsets.assign(1, 0);
+    mMinX.clear();
+    mMinY.clear();
+    mMaxX.clear();
+    mMaxY.clear();
+}
+
+void OcclusionEngine::reserve(std::size_t polygons, std::size_t vertices)
+{
+    mX.reserve(vertices);
+    mY.reserve(vertices);
+    mOffsets.reserve(polygons + 1);
+    mMinX.reserve(polygons);
+    mMinY.reserve(polygons);
+    mMaxX.reserve(polygons);
+    mMaxY.reserve(polygons);
+}
+
+OcclusionEngine::Index OcclusionEngine::add(const std::vector<Position>& outline)
+{
+    double minX = std::numeric_limits<double>::infinity();
+    double minY = minX;
+    double maxX = -minX;
+    double maxY = -minX;
+    for (const Position& pos : outline) {
+        const double x = pos.x.value();
+        const double y = pos.y.value();
+        mX.push_back(x);
+        mY.push_back(y);
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+    }
+
+    const Index index = mMinX.size();
+    mOffsets.push_back(mX.size());
+    mMinX.push_back(minX);
+    mMinY.push_back(minY);
+    mMaxX.push_back(maxX);
+    mMaxY.push_back(maxY);
+    return index;
+}
+
+bool OcclusionEngine::mayTouch(Index polygon, const Position& a, const Position& b) const
+{
+    const double ax = a.x.value();
+    const double ay = a.y.value();
+    const double bx = b.x.value();
+    const double by = b.y.value();
+
+    // bounding box rejection
+    if (std::max(ax, bx) < mMinX[polygon] || std::min(ax, bx) > mMaxX[polygon] ||
+        std::max(ay, by) < mMinY[polygon] || std::min(ay, by) > mMaxY[polygon]) {
+        return false;
+    }
+
+    const std::size_t begin = mOffsets[polygon];
+    const std::size_t end = mOffsets[polygon + 1];
+    if (end - begin < 2) {
+        return true;
+    }
+
+    const double abx = bx - ax;
+    const double aby = by - ay;
+    const double abLengthSq = abx * abx + aby * aby;
+
+    // test segment against each edge including the closing edge from last to first vertex
+    std::size_t prev = end - 1;
+    for (std::size_t i = begin; i < end; prev = i++) {
+        const double px = mX[prev];
+        const double py = mY[prev];
+        const double qx = mX[i];
+        const double qy = mY[i];
+        const double pqx = qx - px;
+        const double pqy = qy - py;
+        const double tolerance = sCollinearTolerance * std::max(abLengthSq, pqx * pqx + pqy * pqy);
+
+        const int s1 = sign(abx * (py - ay) - aby * (px - ax), tolerance);
+        const int s2 = sign(abx * (qy - ay) - aby * (qx - ax), tolerance);
+        const int s3 = sign(pqx * (ay - py) - pqy * (ax - px), tolerance);
+        const int s4 = sign(pqx * (by - py) - pqy * (bx - px), tolerance);
+        // collinear segments are reported as (possibly) touching
+        if (s1 * s2 <= 0 && s3 * s4 <= 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool OcclusionEngine::contains(Index polygon, const Position& p) const
+{
+    const double x = p.x.value();
+    const double y = p.y.value();
+    if (x < mMinX[polygon] || x > mMaxX[polygon] || y < mMinY[polygon] || y > mMaxY[polygon]) {
+        return false;
+    }
+
+    const std::size_t begin = mOffsets[polygon];
+    const std::size_t end = mOffsets[polygon + 1];
+    if (end - begin < 3) {
+        return false;
+    }
+
+    bool inside = false;
+    std::size_t prev = end - 1;
+    for (std::size_t i = begin; i < end; prev = i++) {
+        const double px = mX[prev];
+        const double py = mY[prev];
+        const double qx = mX[i];
+        const double qy = mY[i];
+        if ((qy > y) != (py > y) && x < (px - qx) * (y - qy) / (py - qy) + qx) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+} // namespace artery
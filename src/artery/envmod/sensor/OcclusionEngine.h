@@ -0,0 +1,70 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ENVMOD_OCCLUSIONENGINE_H_R4WQ8NZT
+#define ENVMOD_OCCLUSIONENGINE_H_R4WQ8NZT
+
+#include "artery/utility/Geometry.h"
+#include <cstddef>
+#include <vector>
+
+namespace artery
+{
+
+/**
+ * OcclusionEngine stores polygon outlines flattened into contiguous coordinate arrays
+ * and provides cheap conservative tests of line of sight segments against them.
+ *
+ * mayTouch() never misses a contact between segment and polygon boundary, thus a negative
+ * result is final while a positive result has to be confirmed by an exact geometry predicate.
+ */
+class OcclusionEngine
+{
+public:
+    using Index = std::size_t;
+
+    void clear();
+    void reserve(std::size_t polygons, std::size_t vertices);
+
+    /**
+     * Add polygon outline
+     * \param outline polygon vertices (open or closed ring)
+     * \return index of added polygon
+     */
+    Index add(const std::vector<Position>& outline);
+
+    std::size_t size() const { return mMinX.size(); }
+
+    /**
+     * Check if segment a-b may touch the boundary of a polygon
+     * \param polygon index of polygon
+     * \param a first segment point
+     * \param b second segment point
+     * \return false if segment surely does not touch the polygon's boundary
+     */
+    bool mayTouch(Index polygon, const Position& a, const Position& b) const;
+
+    /**
+     * Check if point is within a polygon (even-odd rule)
+     *
+     * The result is only reliable for points not located on the polygon's boundary.
+     * \param polygon index of polygon
+     * \param p point to test
+     */
+    bool contains(Index polygon, const Position& p) const;
+
+private:
+    std::vector<double> mX;
+    std::vector<double> mY;
+    std::vector<std::size_t> mOffsets = { 0 };
+    std::vector<double> mMinX;
+    std::vector<double> mMinY;
+    std::vector<double> mMaxX;
+    std::vector<double> mMaxY;
+};
+
+} // namespace artery
+
+#endif /* ENVMOD_OCCLUSIONENGINE_H_R4WQ8NZT */
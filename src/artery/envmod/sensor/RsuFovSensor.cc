@@ -6,6 +6,7 @@
 
 #include "artery/application/Facilities.h"
 #include "artery/application/Middleware.h"
+#include "artery/envmod/EnvironmentModelObstacle.h"
 #include "artery/envmod/sensor/RsuFovSensor.h"
 #include "artery/networking/PositionProvider.h"
 
@@ -16,15 +17,71 @@ void RsuFovSensor::initialize()
 {
     FovSensor::initialize();
     mFovHeading = Angle::from_degree(par("fovHeading"));
+
+    const int bins = par("staticOcclusionBins");
+    if (bins < 0) {
+        throw omnetpp::cRuntimeError("staticOcclusionBins must not be negative");
+    }
+    mStaticOcclusionBins = bins;
+}
+
+void RsuFovSensor::finish()
+{
+    mStaticOcclusionMask.reset();
+    mStaticObstacles.clear();
+    mStaticObstaclesValid = false;
+    FovSensor::finish();
 }
 
 SensorDetection RsuFovSensor::createSensorCone() const
 {
+    if (mStaticCone.empty()) {
+        mStaticOrigin = getFacilities().get_const<PositionProvider>().getCartesianPosition();
+        transformSensorArc(mLocalSensorCone, mStaticOrigin, mFovHeading, mStaticCone);
+    }
+
     SensorDetection detection;
-    detection.sensorOrigin = getFacilities().get_const<PositionProvider>().getCartesianPosition();
-    detection.sensorCone = createSensorArc(mFovConfig, detection.sensorOrigin, mFovHeading);
+    detection.sensorOrigin = mStaticOrigin;
+    detection.sensorHeading = mFovHeading;
+    detection.sensorCone = mStaticCone;
     return detection;
 }
 
+void RsuFovSensor::preselectObstacles(const SensorDetection& detection, std::vector<ObstacleHandle>& candidates) const
+{
+    // obstacles are static and so is this sensor's cone
+    if (!mStaticObstaclesValid) {
+        FovSensor::preselectObstacles(detection, candidates);
+        mStaticObstacles.clear();
+        for (ObstacleHandle candidate : candidates) {
+            mStaticObstacles.push_back(*candidate);
+        }
+        mStaticObstaclesValid = true;
+    }
+
+    // handles refer to our own copies, thus they stay valid for the whole run
+    candidates.clear();
+    for (const auto& obstacle : mStaticObstacles) {
+        candidates.push_back(&obstacle);
+    }
+}
+
+const StaticOcclusionMask* RsuFovSensor::getStaticOcclusionMask(const SensorDetection& detection,
+        const std::vector<ObstacleHandle>&) const
+{
+    if (mStaticOcclusionBins == 0) {
+        return nullptr;
+    } else if (!mStaticOcclusionMask) {
+        // obstacle handles refer to the cached static obstacles, i.e. their order is stable
+        std::vector<const std::vector<Position>*> outlines;
+        outlines.reserve(mStaticObstacles.size());
+        for (const auto& obstacle : mStaticObstacles) {
+            outlines.push_back(&obstacle->getOutline());
+        }
+        mStaticOcclusionMask.reset(new StaticOcclusionMask(detection.sensorOrigin, outlines, mStaticOcclusionBins));
+    }
+    return mStaticOcclusionMask.get();
+}
+
 } // namespace artery
 
@@ -8,17 +8,37 @@
 #define ENVMOD_RSUFOVSENSOR_H_
 
 #include "artery/envmod/sensor/FovSensor.h"
+#include "artery/envmod/sensor/StaticOcclusionMask.h"
+#include <memory>
 
 namespace artery
 {
 
+/**
+ * RsuFovSensor is mounted at a stationary road side unit.
+ * Its sensor cone and the static obstacles within are thus determined only once for the whole run.
+ * Optionally, an angular occlusion mask of these obstacles restricts line of sight checks
+ * to the few obstacles located in the direction of each line of sight.
+ */
 class RsuFovSensor : public FovSensor
 {
 protected:
     void initialize() override;
+    void finish() override;
     SensorDetection createSensorCone() const override;
+    void preselectObstacles(const SensorDetection&, std::vector<ObstacleHandle>&) const override;
+    const StaticOcclusionMask* getStaticOcclusionMask(const SensorDetection&,
+            const std::vector<ObstacleHandle>&) const override;
 
     Angle mFovHeading;
+
+private:
+    mutable Position mStaticOrigin;
+    mutable std::vector<Position> mStaticCone;
+    mutable std::vector<std::shared_ptr<EnvironmentModelObstacle>> mStaticObstacles;
+    mutable bool mStaticObstaclesValid = false;
+    unsigned mStaticOcclusionBins = 0;
+    mutable std::unique_ptr<StaticOcclusionMask> mStaticOcclusionMask;
 };
 
 } // namespace artery
@@ -28,6 +28,32 @@ public:
     virtual const std::string getSensorName() const = 0;
     virtual void setSensorName(const std::string& name) = 0;
     virtual SensorDetection detectObjects() const = 0;
+
+    /**
+     * Sensors may allow detectObjects() to run concurrently with other sensors.
+     * Such sensors must only read the global environment model and their own state.
+     * \return true if detectObjects is safe for concurrent evaluation
+     */
+    virtual bool hasConcurrentDetection() const { return false; }
+
+    /**
+     * Finish a measurement whose detection has been evaluated in advance (concurrently).
+     * Only called for sensors with concurrent detection support.
+     */
+    virtual void completeMeasurement(SensorDetection&&) {}
+
+    /**
+     * Sensors may measure at a lower rate than the environment model is refreshed.
+     * \param now time of current refresh
+     * \return true if sensor shall measure at this refresh
+     */
+    virtual bool isMeasurementDue(omnetpp::SimTime now) const { return true; }
+
+    /**
+     * Notify sensor about its measurement at the current refresh
+     * \param now time of measurement
+     */
+    virtual void measurementConducted(omnetpp::SimTime now) {}
 };
 
 } // namespace artery
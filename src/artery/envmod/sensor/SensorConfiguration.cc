@@ -4,15 +4,15 @@
 #include <boost/geometry/strategies/transform/matrix_transformers.hpp>
 #include <boost/math/constants/constants.hpp>
 #include <boost/units/cmath.hpp>
+#include <cmath>
 
 namespace artery
 {
 
-std::vector<Position> createSensorArc(const SensorConfigFov& config, const Position& egoPos, const Angle& egoHeading)
+std::vector<Position> createSensorArc(const SensorConfigFov& config)
 {
     namespace gm = boost::geometry;
     using rotation = gm::strategy::transform::rotate_transformer<gm::degree, double, 2, 2>;
-    using translation = gm::strategy::transform::translate_transformer<double, 2, 2>;
 
     const double openingAngleDeg = config.fieldOfView.angle / boost::units::degree::degrees;
     unsigned segments = std::max(config.numSegments, 1u);
@@ -31,7 +31,7 @@ std::vector<Position> createSensorArc(const SensorConfigFov& config, const Posit
     }
 
     Position sensorBoundary(config.fieldOfView.range / boost::units::si::meters, 0.0);
-    rotation rotateSensorBoundary(egoHeading.degree() - sensorPositionDeg - 0.5 * openingAngleDeg);
+    rotation rotateSensorBoundary(-sensorPositionDeg - 0.5 * openingAngleDeg);
     gm::transform(sensorBoundary, sensorBoundary, rotateSensorBoundary);
     points.push_back(sensorBoundary);
 
@@ -42,13 +42,77 @@ std::vector<Position> createSensorArc(const SensorConfigFov& config, const Posit
         points.push_back(segmentPoint);
     }
 
-    // translate sensor cone points to car position
-    translation translate(egoPos.x.value(), egoPos.y.value());
-    for (auto& point : points) {
-        gm::transform(point, point, translate);
+    return points;
+}
+
+void transformSensorArc(const std::vector<Position>& local, const Position& pos, const Angle& heading, std::vector<Position>& cone)
+{
+    // same (clockwise) rotation sense as boost::geometry's rotate_transformer
+    const double angle = heading.degree() * boost::math::double_constants::degree;
+    const double c = std::cos(angle);
+    const double s = std::sin(angle);
+    const double tx = pos.x.value();
+    const double ty = pos.y.value();
+
+    cone.resize(local.size());
+    for (std::size_t i = 0; i < local.size(); ++i) {
+        const double x = local[i].x.value();
+        const double y = local[i].y.value();
+        cone[i] = Position { c * x + s * y + tx, -s * x + c * y + ty };
     }
+}
 
-    return points;
+SensorSector createSensorSector(const SensorConfigFov& config, const Position& pos, const Angle& heading)
+{
+    namespace bc = boost::math::double_constants;
+    SensorSector sector;
+    sector.origin = pos;
+    sector.range = config.fieldOfView.range / boost::units::si::meters;
+    // createSensorArc rotates clockwise by heading and sensor position, i.e. counter-clockwise by their negation
+    sector.bisector = (relativeAngle(config.sensorPosition).degree() - heading.degree()) * bc::degree;
+    const double openingAngleDeg = config.fieldOfView.angle / boost::units::degree::degrees;
+    sector.halfOpening = std::min(bc::pi, 0.5 * openingAngleDeg * bc::degree);
+    return sector;
+}
+
+bool intersects(const SensorSector& sector, const Position& centre, double radius)
+{
+    namespace bc = boost::math::double_constants;
+    const double dx = centre.x.value() - sector.origin.x.value();
+    const double dy = centre.y.value() - sector.origin.y.value();
+    const double distance = std::hypot(dx, dy);
+    if (distance > sector.range + radius) {
+        return false;
+    } else if (distance <= radius || sector.halfOpening >= bc::pi) {
+        return true;
+    }
+
+    // angular offset of circle centre from bisector in [0, pi]
+    const double offset = std::abs(std::remainder(std::atan2(dy, dx) - sector.bisector, bc::two_pi));
+    if (offset <= sector.halfOpening) {
+        return true;
+    }
+
+    // centre is outside of the sector's angle: circle has to reach the closer boundary segment
+    const double boundary = offset - sector.halfOpening;
+    if (boundary >= bc::half_pi) {
+        // closest point of boundary segment is the origin
+        return distance <= radius;
+    }
+    const double along = distance * std::cos(boundary);
+    const double across = distance * std::sin(boundary);
+    if (along <= sector.range) {
+        return across <= radius;
+    } else {
+        return std::hypot(along - sector.range, across) <= radius;
+    }
+}
+
+std::vector<Position> createSensorArc(const SensorConfigFov& config, const Position& egoPos, const Angle& egoHeading)
+{
+    std::vector<Position> cone;
+    transformSensorArc(createSensorArc(config), egoPos, egoHeading, cone);
+    return cone;
 }
 
 std::vector<Position> createSensorArc(const SensorConfigFov& config, const EnvironmentModelObject& egoObj)
@@ -44,6 +44,52 @@ struct SensorConfigFov : public SensorConfig
 std::vector<Position> createSensorArc(const SensorConfigFov&, const Position&, const Angle&);
 std::vector<Position> createSensorArc(const SensorConfigFov&, const EnvironmentModelObject&);
 
+/**
+ * Creates sensor cone in the sensor's local frame, i.e. at origin with heading of 0 degree.
+ * The result depends on the configuration only and can thus be reused for every measurement.
+ * @param config radar sensor configuration describing the cone geometry
+ * @return polygon approximating cone in local frame
+ */
+std::vector<Position> createSensorArc(const SensorConfigFov&);
+
+/**
+ * Place a local sensor cone at the given pose by a single rotation and translation
+ * @param local sensor cone created in local frame
+ * @param pos sensor position
+ * @param heading ego heading
+ * @param cone transformed cone, allocated memory is reused
+ */
+void transformSensorArc(const std::vector<Position>& local, const Position& pos, const Angle& heading, std::vector<Position>& cone);
+
+/**
+ * Circular sector enclosing a sensor cone, i.e. the cone polygon's arc is inscribed into the sector
+ */
+struct SensorSector
+{
+    Position origin;
+    double range = 0.0; /*< radius in meters */
+    double bisector = 0.0; /*< direction of sector's centre line in radian, counter-clockwise from x-axis */
+    double halfOpening = 0.0; /*< half opening angle in radian, pi for a full circle */
+};
+
+/**
+ * Create sector matching the cone created by createSensorArc for the same sensor pose
+ * @param config sensor configuration
+ * @param pos sensor position
+ * @param heading ego heading
+ * @return sector enclosing the sensor cone
+ */
+SensorSector createSensorSector(const SensorConfigFov&, const Position& pos, const Angle& heading);
+
+/**
+ * Check if a circle intersects a sensor sector
+ * @param sector sensor sector
+ * @param centre circle centre
+ * @param radius circle radius in meters
+ * @return true if circle and sector share at least one point
+ */
+bool intersects(const SensorSector&, const Position& centre, double radius);
+
 } // namespace artery
 
 #endif /* SENSORCONFIGURATION_H_ */
@@ -10,7 +10,6 @@
 #include "artery/envmod/EnvironmentModelObject.h"
 #include "artery/envmod/EnvironmentModelObstacle.h"
 #include "artery/utility/Geometry.h"
-#include <list>
 #include <memory>
 #include <vector>
 
@@ -20,10 +19,11 @@ namespace artery
 struct SensorDetection
 {
     Position sensorOrigin;
+    Angle sensorHeading; // heading sensorCone has been rotated by
     std::vector<Position> sensorCone;
-    std::list<std::shared_ptr<EnvironmentModelObject>> objects;
-    std::list<std::shared_ptr<EnvironmentModelObstacle>> obstacles;
-    std::list<Position> visiblePoints; // LOS = one of these points and first of sensorCone
+    std::vector<std::shared_ptr<EnvironmentModelObject>> objects;
+    std::vector<std::shared_ptr<EnvironmentModelObstacle>> obstacles;
+    std::vector<Position> visiblePoints; // LOS = one of these points and first of sensorCone
 };
 
 } // namespace artery
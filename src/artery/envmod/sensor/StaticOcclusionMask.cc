@@ -0,0 +1,149 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/envmod/sensor/StaticOcclusionMask.h"
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/register/linestring.hpp>
+#include <boost/math/constants/constants.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace { using LineOfSight = std::array<artery::Position, 2>; }
+BOOST_GEOMETRY_REGISTER_LINESTRING(LineOfSight)
+
+namespace artery
+{
+
+namespace
+{
+
+const double sTwoPi = boost::math::double_constants::two_pi;
+
+// edges closer to the origin than this are treated as passing through it
+const double sOriginTolerance = 1e-9;
+
+// distance from origin (0, 0) to segment p-q
+double distanceToSegment(double px, double py, double qx, double qy)
+{
+    const double ex = qx - px;
+    const double ey = qy - py;
+    const double lengthSq = ex * ex + ey * ey;
+    double t = lengthSq > 0.0 ? -(px * ex + py * ey) / lengthSq : 0.0;
+    t = std::min(1.0, std::max(0.0, t));
+    return std::hypot(px + t * ex, py + t * ey);
+}
+
+double normalizedAngle(double x, double y)
+{
+    const double angle = std::atan2(y, x);
+    return angle < 0.0 ? angle + sTwoPi : angle;
+}
+
+} // namespace
+
+constexpr StaticOcclusionMask::Index StaticOcclusionMask::none;
+
+StaticOcclusionMask::StaticOcclusionMask(const Position& origin, const std::vector<const std::vector<Position>*>& obstacles, std::size_t bins) :
+    mOrigin(origin), mBinWidth(sTwoPi / std::max<std::size_t>(bins, 1)), mObstacles(obstacles),
+    mMinDepth(std::max<std::size_t>(bins, 1), std::numeric_limits<double>::infinity())
+{
+    namespace bg = boost::geometry;
+    const std::size_t count = mMinDepth.size();
+    const double ox = mOrigin.x.value();
+    const double oy = mOrigin.y.value();
+
+    std::vector<std::vector<Index>> candidates(count);
+    auto mark = [&](std::size_t bin, Index obstacle, double depth) {
+        mMinDepth[bin] = std::min(mMinDepth[bin], depth);
+        if (candidates[bin].empty() || candidates[bin].back() != obstacle) {
+            candidates[bin].push_back(obstacle);
+        }
+    };
+
+    for (Index i = 0; i < mObstacles.size(); ++i) {
+        const std::vector<Position>& outline = *mObstacles[i];
+        if (bg::covered_by(mOrigin, outline)) {
+            // every line of sight starts within this obstacle
+            for (std::size_t k = 0; k < count; ++k) {
+                mark(k, i, 0.0);
+            }
+            continue;
+        }
+
+        for (std::size_t j = 0; j < outline.size(); ++j) {
+            const Position& p = outline[j];
+            const Position& q = outline[(j + 1) % outline.size()];
+            const double px = p.x.value() - ox, py = p.y.value() - oy;
+            const double qx = q.x.value() - ox, qy = q.y.value() - oy;
+            const double depth = distanceToSegment(px, py, qx, qy);
+            if (depth < sOriginTolerance) {
+                for (std::size_t k = 0; k < count; ++k) {
+                    mark(k, i, 0.0);
+                }
+                continue;
+            }
+
+            // edge not passing through origin spans less than half a circle
+            double from = normalizedAngle(px, py);
+            double to = normalizedAngle(qx, qy);
+            double delta = to - from;
+            if (delta < 0.0) {
+                delta += sTwoPi;
+            }
+            if (delta > 0.5 * sTwoPi) {
+                std::swap(from, to);
+            }
+
+            const std::size_t first = binOf(from);
+            const std::size_t span = (binOf(to) + count - first) % count;
+            // widen span by one bin on each side to cover rounding of angles near bin borders
+            const std::size_t widened = std::min(span + 3, count);
+            for (std::size_t k = 0; k < widened; ++k) {
+                mark((first + count - 1 + k) % count, i, depth);
+            }
+        }
+    }
+
+    mOffsets.reserve(count + 1);
+    mOffsets.push_back(0);
+    for (const std::vector<Index>& bin : candidates) {
+        mCandidates.insert(mCandidates.end(), bin.begin(), bin.end());
+        mOffsets.push_back(mCandidates.size());
+    }
+}
+
+std::size_t StaticOcclusionMask::binOf(double angle) const
+{
+    const std::size_t bin = static_cast<std::size_t>(angle / mBinWidth);
+    return std::min(bin, mMinDepth.size() - 1);
+}
+
+StaticOcclusionMask::Index StaticOcclusionMask::findBlocker(const Position& target) const
+{
+    namespace bg = boost::geometry;
+    const double dx = target.x.value() - mOrigin.x.value();
+    const double dy = target.y.value() - mOrigin.y.value();
+    const std::size_t bin = binOf(normalizedAngle(dx, dy));
+
+    // line of sight ends before reaching any obstacle edge of this bin
+    if (std::hypot(dx, dy) * (1.0 + 1e-9) < mMinDepth[bin]) {
+        return none;
+    }
+
+    // candidates are sorted by index: first match is the same as testing all obstacles in order
+    const LineOfSight lineOfSight { mOrigin, target };
+    for (std::size_t c = mOffsets[bin]; c < mOffsets[bin + 1]; ++c) {
+        const Index candidate = mCandidates[c];
+        if (bg::intersects(lineOfSight, *mObstacles[candidate])) {
+            return candidate;
+        }
+    }
+
+    return none;
+}
+
+} // namespace artery
@@ -0,0 +1,62 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ENVMOD_STATICOCCLUSIONMASK_H_K7PD3XQA
+#define ENVMOD_STATICOCCLUSIONMASK_H_K7PD3XQA
+
+#include "artery/utility/Geometry.h"
+#include <cstddef>
+#include <vector>
+
+namespace artery
+{
+
+/**
+ * StaticOcclusionMask precomputes an angular mask of static obstacles around a fixed sensor origin.
+ *
+ * The full circle around the origin is split into equally sized bins. Each bin stores a lower bound
+ * of the distance to any obstacle edge reaching into it and the obstacles owning those edges.
+ * Lines of sight shorter than this bound are clear without any geometry test, longer lines of sight
+ * are only tested against the bin's candidates. Results are identical to testing all obstacles.
+ */
+class StaticOcclusionMask
+{
+public:
+    using Index = std::size_t;
+    static constexpr Index none = static_cast<Index>(-1);
+
+    /**
+     * Build mask
+     * \param origin fixed origin of all lines of sight
+     * \param obstacles obstacle outlines, their order defines the indices returned by findBlocker
+     * \param bins number of angular bins spanning the full circle
+     */
+    StaticOcclusionMask(const Position& origin, const std::vector<const std::vector<Position>*>& obstacles, std::size_t bins);
+
+    /**
+     * Find a static obstacle blocking the line of sight from origin to target
+     * \param target end point of line of sight
+     * \return index of blocking obstacle or none
+     */
+    Index findBlocker(const Position& target) const;
+
+    std::size_t bins() const { return mMinDepth.size(); }
+
+private:
+    std::size_t binOf(double angle) const;
+
+    Position mOrigin;
+    double mBinWidth;
+    std::vector<const std::vector<Position>*> mObstacles;
+    std::vector<double> mMinDepth;
+    // candidates of bin k are mCandidates[mOffsets[k]] to mCandidates[mOffsets[k + 1]]
+    std::vector<std::size_t> mOffsets;
+    std::vector<Index> mCandidates;
+    Index mEnclosing = none;
+};
+
+} // namespace artery
+
+#endif /* ENVMOD_STATICOCCLUSIONMASK_H_K7PD3XQA */
@@ -4,6 +4,7 @@
 * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
 */
 
+#include "artery/envmod/TraCIEnvironmentModelObject.h"
 #include "artery/envmod/sensor/FovSensor.h"
 #include "artery/envmod/service/CollectivePerceptionMockMessage.h"
 #include "artery/envmod/service/CollectivePerceptionMockService.h"
@@ -12,6 +13,7 @@
 #include <omnetpp/checkandcast.h>
 #include <omnetpp/cmessage.h>
 #include <omnetpp/cpacket.h>
+#include <cmath>
 
 namespace artery
 {
@@ -43,7 +45,7 @@ void CollectivePerceptionMockService::initialize(int stage)
     if (stage == InitStages::Prepare) {
         ItsG5Service::initialize();
         mPositionProvider = &getFacilities().get_const<PositionProvider>();
-        mEnvironmentModel = &getFacilities().get_const<LocalEnvironmentModel>();
+        mEnvironmentModel = &getFacilities().get_mutable<LocalEnvironmentModel>();
 
         mDccProfile = par("dccProfile");
         mLengthHeader = par("lengthHeader");
@@ -53,6 +55,14 @@ void CollectivePerceptionMockService::initialize(int stage)
         mGenerateAfterCam = par("generateAfterCam");
         mCpmOffset = par("cpmOffset");
         mCpmInterval = par("cpmInterval");
+
+        mObjectInclusionRules = par("objectInclusionRules");
+        mMinDisplacement = par("objectMinDisplacement");
+        mMinSpeedChange = par("objectMinSpeedChange");
+        mMaxInclusionAge = par("objectMaxInclusionAge");
+        if (mObjectInclusionRules) {
+            mChangeSubscription = mEnvironmentModel->subscribeChanges();
+        }
     } else if (stage == InitStages::Self) {
         mTrigger = new omnetpp::cMessage("triggger mock-up CPM");
         if (mGenerateAfterCam) {
@@ -122,35 +132,27 @@ void CollectivePerceptionMockService::generatePacket()
     req.gn.traffic_class.tc_id(mDccProfile);
     req.gn.communication_profile = geonet::CommunicationProfile::ITS_G5;
 
+    const bool includeFov = mFovLast + mFovInterval <= omnetpp::simTime();
+    ObjectContainers objectContainers;
+    if (mObjectInclusionRules) {
+        addChangedObjects(objectContainers);
+        if (objectContainers.empty() && !includeFov) {
+            // nothing worth to be reported
+            return;
+        }
+    } else {
+        addAllObjects(objectContainers);
+    }
+
     auto packet = new CollectivePerceptionMockMessage();
     packet->setByteLength(mLengthHeader);
 
-    if (mFovLast + mFovInterval <= omnetpp::simTime()) {
+    if (includeFov) {
         packet->setFovContainers(mFovContainers);
         packet->addByteLength(mLengthFovContainer * mFovContainers.size());
         mFovLast = omnetpp::simTime();
     }
 
-    std::vector<CollectivePerceptionMockMessage::ObjectContainer> objectContainers;
-    using TrackedObject = LocalEnvironmentModel::TrackedObject;
-    for (const TrackedObject& object : mEnvironmentModel->allObjects()) {
-        const LocalEnvironmentModel::Tracking& tracking = object.second;
-        if (tracking.expired()) {
-            // skip objects with lost tracking
-            continue;
-        }
-
-        for (const auto& sensor : tracking.sensors()) {
-            if (mSensors.find(sensor.first) != mSensors.end()) {
-                CollectivePerceptionMockMessage::ObjectContainer objectContainer;
-                objectContainer.object = object.first;
-                objectContainer.objectId = tracking.id();
-                objectContainer.sensorId = sensor.first->getId();
-                objectContainer.timeOfMeasurement = sensor.second.last();
-                objectContainers.emplace_back(std::move(objectContainer));
-            }
-        }
-    }
     packet->addByteLength(mLengthObjectContainer * objectContainers.size());
     packet->setObjectContainers(std::move(objectContainers));
     packet->setSourceStation(mHostId);
@@ -159,4 +161,100 @@ void CollectivePerceptionMockService::generatePacket()
     request(req, packet);
 }
 
+void CollectivePerceptionMockService::addAllObjects(ObjectContainers& containers) const
+{
+    for (const LocalEnvironmentModel::TrackedObject& object : mEnvironmentModel->allObjects()) {
+        addObjectContainers(object, containers);
+    }
+}
+
+void CollectivePerceptionMockService::addChangedObjects(ObjectContainers& containers)
+{
+    // only objects detected since the last CPM can satisfy any inclusion rule
+    const omnetpp::SimTime now = omnetpp::simTime();
+    mEnvironmentModel->takeChanges(mChangeSubscription, mChangedObjects);
+    for (const EnvironmentModelObject* key : mChangedObjects) {
+        const LocalEnvironmentModel::TrackedObject* object = mEnvironmentModel->findObject(key);
+        if (!object) {
+            continue;
+        }
+
+        auto inclusion = mInclusions.find(object->second.id());
+        if (inclusion != mInclusions.end() && !isInclusionDue(*key, inclusion->second)) {
+            continue;
+        }
+
+        const std::size_t before = containers.size();
+        addObjectContainers(*object, containers);
+        if (containers.size() != before) {
+            ObjectInclusion& state = mInclusions[object->second.id()];
+            state.position = key->getCentrePoint();
+            auto traciObject = dynamic_cast<const TraCIEnvironmentModelObject*>(key);
+            state.speed = traciObject ? traciObject->getVehicleData().speed().value() : -1.0;
+            state.time = now;
+        }
+    }
+
+    purgeInclusions();
+}
+
+void CollectivePerceptionMockService::addObjectContainers(const LocalEnvironmentModel::TrackedObject& object,
+        ObjectContainers& containers) const
+{
+    const LocalEnvironmentModel::Tracking& tracking = object.second;
+    if (tracking.expired()) {
+        // skip objects with lost tracking
+        return;
+    }
+
+    for (const auto& sensor : tracking.sensors()) {
+        if (mSensors.find(sensor.first) != mSensors.end()) {
+            CollectivePerceptionMockMessage::ObjectContainer objectContainer;
+            objectContainer.object = object.first;
+            objectContainer.objectId = tracking.id();
+            objectContainer.sensorId = sensor.first->getId();
+            objectContainer.timeOfMeasurement = sensor.second.last();
+            containers.emplace_back(std::move(objectContainer));
+        }
+    }
+}
+
+bool CollectivePerceptionMockService::isInclusionDue(const EnvironmentModelObject& object, const ObjectInclusion& last) const
+{
+    const omnetpp::SimTime now = omnetpp::simTime();
+    if (last.time == now) {
+        // included by this CPM already
+        return false;
+    } else if (now - last.time >= mMaxInclusionAge) {
+        return true;
+    } else if (distance(object.getCentrePoint(), last.position).value() > mMinDisplacement) {
+        return true;
+    }
+
+    auto traciObject = dynamic_cast<const TraCIEnvironmentModelObject*>(&object);
+    if (traciObject && last.speed >= 0.0) {
+        const double speed = traciObject->getVehicleData().speed().value();
+        return std::abs(speed - last.speed) > mMinSpeedChange;
+    }
+    return false;
+}
+
+void CollectivePerceptionMockService::purgeInclusions()
+{
+    // entries older than the maximum age are equivalent to missing entries
+    const omnetpp::SimTime now = omnetpp::simTime();
+    if (now - mInclusionsPurged < mMaxInclusionAge) {
+        return;
+    }
+
+    for (auto it = mInclusions.begin(); it != mInclusions.end();) {
+        if (now - it->second.time >= mMaxInclusionAge) {
+            it = mInclusions.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    mInclusionsPurged = now;
+}
+
 } // namespace artery
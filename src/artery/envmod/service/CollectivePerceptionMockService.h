@@ -10,6 +10,8 @@
 #include "artery/envmod/service/CollectivePerceptionMockMessage.h"
 #include "artery/application/ItsG5Service.h"
 #include "artery/networking/PositionProvider.h"
+#include "artery/utility/Geometry.h"
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -25,15 +27,32 @@ class CollectivePerceptionMockService : public ItsG5Service
         int numInitStages() const override;
         void initialize(int stage) override;
         void trigger() override;
+        bool requiresTrigger() const override { return true; }
         void handleMessage(omnetpp::cMessage*) override;
         void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, omnetpp::cObject*, omnetpp::cObject*) override;
         void generatePacket();
         void indicate(const vanetza::btp::DataIndication&, omnetpp::cPacket*) override;
 
     private:
+        using ObjectContainers = std::vector<CollectivePerceptionMockMessage::ObjectContainer>;
+
+        // object state at its last inclusion into a CPM
+        struct ObjectInclusion
+        {
+            Position position;
+            double speed = 0.0; // m/s, negative if unknown
+            omnetpp::SimTime time;
+        };
+
+        void addAllObjects(ObjectContainers&) const;
+        void addChangedObjects(ObjectContainers&);
+        void addObjectContainers(const LocalEnvironmentModel::TrackedObject&, ObjectContainers&) const;
+        bool isInclusionDue(const EnvironmentModelObject&, const ObjectInclusion&) const;
+        void purgeInclusions();
+
         int mHostId = 0;
         const PositionProvider* mPositionProvider = nullptr;
-        const LocalEnvironmentModel* mEnvironmentModel = nullptr;
+        LocalEnvironmentModel* mEnvironmentModel = nullptr;
         omnetpp::cMessage* mTrigger = nullptr;
         bool mGenerateAfterCam;
         omnetpp::SimTime mCpmOffset;
@@ -46,6 +65,15 @@ class CollectivePerceptionMockService : public ItsG5Service
         unsigned mLengthHeader = 0;
         unsigned mLengthFovContainer = 0;
         unsigned mLengthObjectContainer = 0;
+
+        bool mObjectInclusionRules = false;
+        double mMinDisplacement = 0.0; // m
+        double mMinSpeedChange = 0.0; // m/s
+        omnetpp::SimTime mMaxInclusionAge;
+        unsigned mChangeSubscription = 0;
+        std::vector<const EnvironmentModelObject*> mChangedObjects;
+        std::unordered_map<int, ObjectInclusion> mInclusions; // by tracking id
+        omnetpp::SimTime mInclusionsPurged;
 };
 
 } // namespace artery
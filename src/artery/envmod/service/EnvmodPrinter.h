@@ -23,6 +23,7 @@ class EnvmodPrinter : public ItsG5Service
     public:
         void initialize() override;
         void trigger() override;
+        bool requiresTrigger() const override { return true; }
 
     private:
         void printSensorObjectList(const std::string& title, const TrackedObjectsFilterRange&);
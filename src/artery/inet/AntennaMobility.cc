@@ -10,6 +10,8 @@ void AntennaMobility::initialize(int stage)
 {
     omnetpp::cModule* module = getModuleByPath(par("mobilityModule"));
     mParentMobility = check_and_cast<inet::IMobility*>(module);
+    module->subscribe(inet::IMobility::mobilityStateChangedSignal, this);
+    mPoseValid = false;
 
     mOffsetCoord.x = par("offsetX");
     mOffsetCoord.y = par("offsetY");
@@ -30,23 +32,47 @@ double AntennaMobility::getMaxSpeed() const
     return mParentMobility->getMaxSpeed();
 }
 
-inet::Coord AntennaMobility::getCurrentPosition()
+void AntennaMobility::receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t signal, omnetpp::cObject*, omnetpp::cObject*)
+{
+    if (signal == inet::IMobility::mobilityStateChangedSignal) {
+        mPoseValid = false;
+    }
+}
+
+void AntennaMobility::updatePose()
 {
     inet::EulerAngles angular_pos = mParentMobility->getCurrentAngularPosition();
+    mAngularPosition = angular_pos + mOffsetAngles;
     std::swap(angular_pos.alpha, angular_pos.gamma);
     inet::Rotation rot(angular_pos);
-    inet::Coord rotated_offset = rot.rotateVectorClockwise(mOffsetCoord);
-    return mParentMobility->getCurrentPosition() + rotated_offset;
+    mRotatedOffset = rot.rotateVectorClockwise(mOffsetCoord);
+    mSpeed = mOffsetRotation.rotateVectorClockwise(mParentMobility->getCurrentSpeed());
+    mPoseValid = true;
+}
+
+inet::Coord AntennaMobility::getCurrentPosition()
+{
+    if (!mPoseValid) {
+        updatePose();
+    }
+    // parent position is not cached, it may be extrapolated between updates
+    return mParentMobility->getCurrentPosition() + mRotatedOffset;
 }
 
 inet::Coord AntennaMobility::getCurrentSpeed()
 {
-    return mOffsetRotation.rotateVectorClockwise(mParentMobility->getCurrentSpeed());
+    if (!mPoseValid) {
+        updatePose();
+    }
+    return mSpeed;
 }
 
 inet::EulerAngles AntennaMobility::getCurrentAngularPosition()
 {
-    return mParentMobility->getCurrentAngularPosition() + mOffsetAngles;
+    if (!mPoseValid) {
+        updatePose();
+    }
+    return mAngularPosition;
 }
 
 inet::EulerAngles AntennaMobility::getCurrentAngularSpeed()
@@ -3,11 +3,17 @@
 
 #include <inet/mobility/contract/IMobility.h>
 #include <inet/common/geometry/common/Rotation.h>
+#include <omnetpp/clistener.h>
 
 namespace artery
 {
 
-class AntennaMobility : public inet::IMobility, public omnetpp::cSimpleModule
+/**
+ * AntennaMobility places an antenna relative to its host's mobility
+ *
+ * Offsets rotated by the host's orientation are cached until the host signals a mobility change.
+ */
+class AntennaMobility : public inet::IMobility, public omnetpp::cSimpleModule, public omnetpp::cListener
 {
 public:
     // inet::IMobility interface
@@ -23,11 +29,21 @@ public:
     void initialize(int stage) override;
     int numInitStages() const override;
 
+    // omnetpp::cListener
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, omnetpp::cObject*, omnetpp::cObject*) override;
+
 private:
+    void updatePose();
+
     inet::IMobility* mParentMobility = nullptr;
     inet::Coord mOffsetCoord;
     inet::EulerAngles mOffsetAngles;
     inet::Rotation mOffsetRotation;
+
+    bool mPoseValid = false; /*< cached members below match parent's state */
+    inet::Coord mRotatedOffset;
+    inet::Coord mSpeed;
+    inet::EulerAngles mAngularPosition;
 };
 
 } // namespace artery
@@ -1,4 +1,5 @@
 #include "artery/inet/ChannelLoadRx.h"
+#include <inet/common/ModuleAccess.h>
 #include <cmath>
 
 using namespace omnetpp;
@@ -25,11 +26,17 @@ void ChannelLoadRx::initialize(int stage)
     if (stage == inet::INITSTAGE_LOCAL) {
         mCbrWithTx = par("cbrWithTx");
         mChannelReportInterval = simtime_t { 100, SIMTIME_MS };
-        mChannelReportTrigger = new cMessage("report CL");
 
         if (par("asyncChannelReport").boolValue()) {
+            mChannelReportTrigger = new cMessage("report CL");
             scheduleAt(simTime() + mChannelReportInterval, mChannelReportTrigger);
+        } else if (auto reporter = inet::findModuleFromPar<ChannelLoadReporter>(par("channelLoadReporterModule"), this, false)) {
+            if (reporter->getInterval() != mChannelReportInterval) {
+                throw cRuntimeError("interval of channel load reporter has to be %s", mChannelReportInterval.str().c_str());
+            }
+            reporter->subscribe(this);
         } else {
+            mChannelReportTrigger = new cMessage("report CL");
             double cycle = simTime() / mChannelReportInterval;
             scheduleAt((1.0 + std::ceil(cycle)) * mChannelReportInterval, mChannelReportTrigger);
         }
@@ -48,6 +55,18 @@ void ChannelLoadRx::handleMessage(cMessage* msg)
     }
 }
 
+double ChannelLoadRx::getChannelBusyRatio()
+{
+    Enter_Method_Silent();
+    return mChannelLoadSampler.cbr();
+}
+
+void ChannelLoadRx::reportChannelLoad()
+{
+    Enter_Method_Silent();
+    emit(ChannelLoadSignal, mChannelLoadSampler.cbr());
+}
+
 void ChannelLoadRx::recomputeMediumFree()
 {
     Rx::recomputeMediumFree();
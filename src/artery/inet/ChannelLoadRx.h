@@ -1,13 +1,14 @@
 #ifndef ARTERY_CHANNELLOADRX_H_C0YJMQTS
 #define ARTERY_CHANNELLOADRX_H_C0YJMQTS
 
+#include "artery/nic/ChannelLoadReporter.h"
 #include "artery/nic/ChannelLoadSampler.h"
 #include "inet/linklayer/ieee80211/mac/Rx.h"
 
 namespace artery
 {
 
-class ChannelLoadRx : public inet::ieee80211::Rx
+class ChannelLoadRx : public inet::ieee80211::Rx, public ChannelLoadReporter::Client
 {
 public:
     ChannelLoadRx();
@@ -15,14 +16,20 @@ public:
 
     static const omnetpp::simsignal_t ChannelLoadSignal;
 
+    /**
+     * Get channel busy ratio of the most recent 100 ms
+     */
+    double getChannelBusyRatio();
+
 protected:
     void initialize(int stage) override;
     void handleMessage(omnetpp::cMessage*) override;
     void recomputeMediumFree() override;
+    void reportChannelLoad() override;
 
 private:
     omnetpp::simtime_t mChannelReportInterval;
-    omnetpp::cMessage* mChannelReportTrigger;
+    omnetpp::cMessage* mChannelReportTrigger = nullptr;
     ChannelLoadSampler mChannelLoadSampler;
     bool mCbrWithTx = false;
 };
@@ -16,7 +16,7 @@ void DistanceSwitchPathLoss::initialize()
 {
     mThreshold = inet::m { par("thresholdDistance") };
     if (mThreshold <= inet::m { 0.0 }) {
-        error("threshold distance has to be positive (given: %d)", mThreshold.get());
+        error("threshold distance has to be positive (given: %f)", mThreshold.get());
     }
 
     mModelNear = omnetpp::check_and_cast<inet::physicallayer::IPathLoss*>(getSubmodule("near"));
@@ -44,9 +44,14 @@ double DistanceSwitchPathLoss::computePathLoss(inet::mps propagation, inet::Hz f
 
 inet::m DistanceSwitchPathLoss::computeRange(inet::mps propagation, inet::Hz frequency, double loss) const
 {
-    const inet::m rangeNear = mModelNear->computeRange(propagation, frequency, loss);
+    // far model is in charge beyond threshold, near model reaches at most threshold then
     const inet::m rangeFar = mModelFar->computeRange(propagation, frequency, loss);
-    return rangeNear < rangeFar ? rangeFar : rangeNear;
+    if (rangeFar >= mThreshold) {
+        return rangeFar;
+    }
+
+    const inet::m rangeNear = mModelNear->computeRange(propagation, frequency, loss);
+    return rangeNear < mThreshold ? rangeNear : mThreshold;
 }
 
 } // namespace artery
@@ -28,6 +28,10 @@ void InetMobility::initialize(int stage)
     if (stage == inet::INITSTAGE_LOCAL) {
         mVisualRepresentation = inet::getModuleFromPar<cModule>(par("visualRepresentation"), this, false);
         mAntennaHeight = par("antennaHeight");
+        mExtrapolation = parseExtrapolation(par("extrapolation").stdstringValue());
+        mPositionThreshold = par("positionThreshold");
+        mHeadingThreshold = par("headingThreshold").doubleValue() * M_PI / 180.0;
+        mSpeedThreshold = par("speedThreshold");
         WATCH(mPosition);
         WATCH(mSpeed);
         WATCH(mOrientation);
@@ -36,6 +40,9 @@ void InetMobility::initialize(int stage)
             auto visualizationTarget = mVisualRepresentation->getParentModule();
             mCanvasProjection = inet::CanvasProjection::getCanvasProjection(visualizationTarget->getCanvas());
         }
+        mSignalledPosition = mPosition;
+        mSignalledSpeed = mSpeed;
+        mSignalledHeading = mOrientation.alpha;
         emit(MobilityBase::stateChangedSignal, this);
         updateVisualRepresentation();
     }
@@ -48,21 +55,49 @@ double InetMobility::getMaxSpeed() const
 
 inet::Coord InetMobility::getCurrentPosition()
 {
+    return computePosition();
+}
+
+inet::Coord InetMobility::computePosition() const
+{
+    if (mExtrapolation != Extrapolation::None) {
+        // dead reckoning between (possibly sparse) TraCI updates
+        return computePosition(extrapolateKinematics(omnetpp::simTime()));
+    }
     return mPosition;
 }
 
+inet::Coord InetMobility::computePosition(const Kinematics& kinematics) const
+{
+    using boost::units::si::meter;
+    return inet::Coord { kinematics.position.x / meter, kinematics.position.y / meter, mAntennaHeight };
+}
+
 inet::Coord InetMobility::getCurrentSpeed()
 {
+    if (mExtrapolation == Extrapolation::ConstantAcceleration || mExtrapolation == Extrapolation::ConstantTurnRate) {
+        const Kinematics kinematics = extrapolateKinematics(omnetpp::simTime());
+        const double rad = kinematics.heading.radian();
+        return inet::Coord { cos(rad), -sin(rad) } * kinematics.speed;
+    }
     return mSpeed;
 }
 
 inet::EulerAngles InetMobility::getCurrentAngularPosition()
 {
+    if (mExtrapolation == Extrapolation::ConstantTurnRate) {
+        inet::EulerAngles orientation = mOrientation;
+        orientation.alpha = -extrapolateKinematics(omnetpp::simTime()).heading.radian();
+        return orientation;
+    }
     return mOrientation;
 }
 
 inet::EulerAngles InetMobility::getCurrentAngularSpeed()
 {
+    if (mExtrapolation == Extrapolation::ConstantTurnRate) {
+        return inet::EulerAngles { -extrapolateKinematics(omnetpp::simTime()).turnRate, 0.0, 0.0 };
+    }
     return inet::EulerAngles::ZERO;
 }
 
@@ -79,6 +114,12 @@ inet::Coord InetMobility::getConstraintAreaMin() const
 }
 
 void InetMobility::initialize(const Position& pos, Angle heading, double speed)
+{
+    setState(pos, heading, speed);
+    resetKinematics(pos, heading, speed);
+}
+
+void InetMobility::setState(const Position& pos, Angle heading, double speed)
 {
     using boost::units::si::meter;
     const double rad = heading.radian();
@@ -90,10 +131,37 @@ void InetMobility::initialize(const Position& pos, Angle heading, double speed)
 
 void InetMobility::update(const Position& pos, Angle heading, double speed)
 {
-    initialize(pos, heading, speed);
-    ASSERT(inet::IMobility::mobilityStateChangedSignal == MobilityBase::stateChangedSignal);
-    emit(MobilityBase::stateChangedSignal, this);
-    updateVisualRepresentation();
+    setState(pos, heading, speed);
+    recordKinematics(pos, heading, speed);
+    if (isSignificantChange()) {
+        mSignalledPosition = mPosition;
+        mSignalledSpeed = mSpeed;
+        mSignalledHeading = mOrientation.alpha;
+        ASSERT(inet::IMobility::mobilityStateChangedSignal == MobilityBase::stateChangedSignal);
+        emit(MobilityBase::stateChangedSignal, this);
+        mVisualDirty = true;
+    }
+}
+
+void InetMobility::refreshDisplay() const
+{
+    // extrapolated positions change without updates
+    if (mVisualDirty || mExtrapolation != Extrapolation::None) {
+        const_cast<InetMobility*>(this)->updateVisualRepresentation();
+        mVisualDirty = false;
+    }
+}
+
+bool InetMobility::isSignificantChange() const
+{
+    if (mPositionThreshold <= 0.0 && mHeadingThreshold <= 0.0 && mSpeedThreshold <= 0.0) {
+        return true;
+    }
+
+    const double heading_delta = std::abs(std::remainder(mOrientation.alpha - mSignalledHeading, 2.0 * M_PI));
+    return mPosition.distance(mSignalledPosition) > mPositionThreshold ||
+        heading_delta > mHeadingThreshold ||
+        mSpeed.distance(mSignalledSpeed) > mSpeedThreshold;
 }
 
 void InetMobility::updateVisualRepresentation()
@@ -102,9 +170,9 @@ void InetMobility::updateVisualRepresentation()
     if (hasGUI() && mVisualRepresentation) {
 #ifdef WITH_VISUALIZERS
         using inet::visualizer::MobilityCanvasVisualizer;
-        MobilityCanvasVisualizer::setPosition(mVisualRepresentation, mCanvasProjection->computeCanvasPoint(getCurrentPosition()));
+        MobilityCanvasVisualizer::setPosition(mVisualRepresentation, mCanvasProjection->computeCanvasPoint(computePosition()));
 #else
-        auto position = mCanvasProjection->computeCanvasPoint(getCurrentPosition());
+        auto position = mCanvasProjection->computeCanvasPoint(computePosition());
         char buf[32];
         snprintf(buf, sizeof(buf), "%lf", position.x);
         buf[sizeof(buf) - 1] = 0;
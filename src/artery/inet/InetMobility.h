@@ -27,20 +27,40 @@ public:
     // omnetpp::cSimpleModule
     void initialize(int stage) override;
     int numInitStages() const override;
+    void refreshDisplay() const override;
 
 protected:
+    /**
+     * Place visual representation at current position (formats display string without visualizers)
+     */
     virtual void updateVisualRepresentation();
 
+    /**
+     * Check if the current state differs enough from the last signalled state
+     */
+    virtual bool isSignificantChange() const;
+
     void initialize(const Position& pos, Angle heading, double speed) override;
     void update(const Position& pos, Angle heading, double speed) override;
 
 private:
+    void setState(const Position& pos, Angle heading, double speed);
+    inet::Coord computePosition() const;
+    inet::Coord computePosition(const Kinematics&) const;
+
     inet::Coord mPosition;
     inet::Coord mSpeed;
     inet::EulerAngles mOrientation;
     double mAntennaHeight = 0.0;
+    double mPositionThreshold = 0.0;
+    double mHeadingThreshold = 0.0; /*< radian */
+    double mSpeedThreshold = 0.0;
+    inet::Coord mSignalledPosition;
+    inet::Coord mSignalledSpeed;
+    double mSignalledHeading = 0.0;
     omnetpp::cModule* mVisualRepresentation = nullptr;
     const inet::CanvasProjection* mCanvasProjection = nullptr;
+    mutable bool mVisualDirty = false; /*< visual representation is refreshed lazily by refreshDisplay */
 };
 
 class InetVehicleMobility : public InetMobility, public VehicleMobility
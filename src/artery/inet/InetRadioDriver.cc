@@ -1,7 +1,7 @@
 #include "artery/inet/InetRadioDriver.h"
 #include "artery/inet/VanetRxControl.h"
 #include "artery/inet/VanetTxControl.h"
-#include "artery/networking/GeoNetIndication.h"
+#include "artery/networking/GeoNetPacket.h"
 #include "artery/networking/GeoNetRequest.h"
 #include "artery/nic/RadioDriverProperties.h"
 #include <inet/common/InitStages.h>
@@ -114,11 +114,10 @@ void InetRadioDriver::handleDataRequest(cMessage* packet)
 
 void InetRadioDriver::handleDataIndication(cMessage* packet)
 {
-	auto* info = check_and_cast<VanetRxControl*>(packet->removeControlInfo());
-	auto* indication = new GeoNetIndication();
-	indication->source = convert(info->getSrc());
-	indication->destination = convert(info->getDest());
-	packet->setControlInfo(indication);
+	auto* gn = check_and_cast<GeoNetPacket*>(packet);
+	auto* info = check_and_cast<VanetRxControl*>(gn->removeControlInfo());
+	gn->setSourceAddress(convert(info->getSrc()));
+	gn->setDestinationAddress(convert(info->getDest()));
 	delete info;
 
 	indicateData(packet);
@@ -0,0 +1,145 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/inet/LevelOfDetailRadioMedium.h"
+#include "traci/BasicNodeManager.h"
+#include <boost/geometry/algorithms/append.hpp>
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/covered_by.hpp>
+#include <boost/geometry/algorithms/is_valid.hpp>
+#include <boost/lexical_cast.hpp>
+#include <inet/common/InitStages.h>
+#include <inet/mobility/contract/IMobility.h>
+#include <inet/physicallayer/contract/packetlevel/IReception.h>
+#include <omnetpp/cstringtokenizer.h>
+#include <omnetpp/cxmlelement.h>
+
+namespace artery
+{
+
+Define_Module(LevelOfDetailRadioMedium)
+
+namespace phy = inet::physicallayer;
+
+void LevelOfDetailRadioMedium::initialize(int stage)
+{
+    phy::RadioMedium::initialize(stage);
+    if (stage == inet::INITSTAGE_LOCAL) {
+        if (omnetpp::cXMLElement* areas = par("areasOfInterest").xmlValue()) {
+            initializeAreas(*areas);
+        }
+
+        for (const std::string& id : omnetpp::cStringTokenizer(par("probeVehicles").stringValue()).asVector()) {
+            mProbeVehicles.insert(id);
+        }
+        mProbeRadius = par("probeRadius");
+        if (!mProbeVehicles.empty()) {
+            getSystemModule()->subscribe(traci::BasicNodeManager::addNodeSignal, &mProbeListener);
+            getSystemModule()->subscribe(traci::BasicNodeManager::removeNodeSignal, &mProbeListener);
+        }
+
+        EV_INFO << "Full reception pipeline within " << mAreas.size() << " areas and around "
+            << mProbeVehicles.size() << " probe vehicles" << omnetpp::endl;
+    }
+}
+
+void LevelOfDetailRadioMedium::initializeAreas(const omnetpp::cXMLElement& areas)
+{
+    for (omnetpp::cXMLElement* area : areas.getChildrenByTagName("polygon")) {
+        geometry::Polygon polygon;
+        for (omnetpp::cXMLElement* point : area->getChildrenByTagName("point")) {
+            const char* x = point->getAttribute("x");
+            const char* y = point->getAttribute("y");
+            if (!x || !y) {
+                throw omnetpp::cRuntimeError("Area point requires x and y attributes at %s", point->getSourceLocation());
+            }
+            boost::geometry::append(polygon, geometry::Point { boost::lexical_cast<double>(x), boost::lexical_cast<double>(y) });
+        }
+        boost::geometry::correct(polygon);
+        if (!boost::geometry::is_valid(polygon)) {
+            throw omnetpp::cRuntimeError("Invalid area of interest at %s", area->getSourceLocation());
+        }
+        mAreas.push_back(std::move(polygon));
+    }
+}
+
+void LevelOfDetailRadioMedium::finish()
+{
+    recordScalar("detailedReceptions", mDetailedReceptions);
+    recordScalar("abstractReceptions", mAbstractReceptions);
+    if (!mProbeVehicles.empty()) {
+        getSystemModule()->unsubscribe(traci::BasicNodeManager::addNodeSignal, &mProbeListener);
+        getSystemModule()->unsubscribe(traci::BasicNodeManager::removeNodeSignal, &mProbeListener);
+    }
+    phy::RadioMedium::finish();
+}
+
+void LevelOfDetailRadioMedium::ProbeListener::receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t signal, const char* id, omnetpp::cObject* node)
+{
+    if (mMedium->mProbeVehicles.count(id) == 0) {
+        return;
+    } else if (signal == traci::BasicNodeManager::addNodeSignal) {
+        auto module = omnetpp::check_and_cast<omnetpp::cModule*>(node);
+        auto mobility = dynamic_cast<inet::IMobility*>(module->getSubmodule("mobility"));
+        if (!mobility) {
+            throw omnetpp::cRuntimeError("Probe vehicle %s lacks an INET mobility submodule", id);
+        }
+        mMedium->mProbes[id] = mobility;
+    } else if (signal == traci::BasicNodeManager::removeNodeSignal) {
+        mMedium->mProbes.erase(id);
+    }
+    mMedium->mProbePositionsTime = -1.0;
+}
+
+void LevelOfDetailRadioMedium::updateProbePositions() const
+{
+    // probes move at most once per simulated instant
+    if (mProbePositionsTime == omnetpp::simTime()) {
+        return;
+    }
+
+    mProbePositions.clear();
+    for (const auto& probe : mProbes) {
+        mProbePositions.push_back(probe.second->getCurrentPosition());
+    }
+    mProbePositionsTime = omnetpp::simTime();
+}
+
+bool LevelOfDetailRadioMedium::isDetailed(const inet::Coord& position) const
+{
+    updateProbePositions();
+    const double squaredRadius = mProbeRadius * mProbeRadius;
+    for (const inet::Coord& probe : mProbePositions) {
+        const double dx = probe.x - position.x;
+        const double dy = probe.y - position.y;
+        if (dx * dx + dy * dy <= squaredRadius) {
+            return true;
+        }
+    }
+
+    const geometry::Point point { position.x, position.y };
+    for (const geometry::Polygon& area : mAreas) {
+        if (boost::geometry::covered_by(point, area)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+const std::vector<const phy::IReception*>* LevelOfDetailRadioMedium::computeInterferingReceptions(
+        const phy::IReception* reception, const std::vector<const phy::ITransmission*>* transmissions) const
+{
+    if (isDetailed(reception->getStartPosition())) {
+        ++mDetailedReceptions;
+        return phy::RadioMedium::computeInterferingReceptions(reception, transmissions);
+    } else {
+        // abstract reception: SNIR is limited by background noise only
+        ++mAbstractReceptions;
+        return new std::vector<const phy::IReception*>();
+    }
+}
+
+} // namespace artery
@@ -0,0 +1,75 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_LEVELOFDETAILRADIOMEDIUM_H_Q4RM8TWB
+#define ARTERY_LEVELOFDETAILRADIOMEDIUM_H_Q4RM8TWB
+
+#include "artery/utility/Geometry.h"
+#include <inet/physicallayer/common/packetlevel/RadioMedium.h>
+#include <omnetpp/clistener.h>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace inet { class IMobility; }
+
+namespace artery
+{
+
+/**
+ * LevelOfDetailRadioMedium runs the full reception pipeline only within areas of interest.
+ *
+ * Areas of interest are static polygons and circles around probe vehicles.
+ * Receptions whose receiver is inside any area are computed as usual by INET.
+ * For receptions elsewhere, interfering receptions are not looked up: their SNIR is
+ * the received power after path loss over background noise, and the receiver's error model
+ * turns it into a packet error rate. Listening (i.e. CCA and channel load) is unchanged,
+ * so pair this medium with PowerLevelRx's incrementalBusyPower for cheap channel busy ratios.
+ */
+class LevelOfDetailRadioMedium : public inet::physicallayer::RadioMedium
+{
+public:
+    /**
+     * Check if a position is within any area of interest
+     */
+    bool isDetailed(const inet::Coord&) const;
+
+protected:
+    void initialize(int stage) override;
+    void finish() override;
+
+    const std::vector<const inet::physicallayer::IReception*>* computeInterferingReceptions(
+            const inet::physicallayer::IReception*, const std::vector<const inet::physicallayer::ITransmission*>*) const override;
+
+private:
+    class ProbeListener : public omnetpp::cListener
+    {
+    public:
+        explicit ProbeListener(LevelOfDetailRadioMedium* medium) : mMedium(medium) {}
+        void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, const char*, omnetpp::cObject*) override;
+
+    private:
+        LevelOfDetailRadioMedium* mMedium;
+    };
+
+    void initializeAreas(const omnetpp::cXMLElement&);
+    void updateProbePositions() const;
+
+    std::vector<geometry::Polygon> mAreas;
+    std::unordered_set<std::string> mProbeVehicles;
+    std::unordered_map<std::string, inet::IMobility*> mProbes;
+    double mProbeRadius = 0.0;
+    ProbeListener mProbeListener { this };
+
+    mutable std::vector<inet::Coord> mProbePositions;
+    mutable omnetpp::simtime_t mProbePositionsTime = -1.0;
+    mutable long mDetailedReceptions = 0;
+    mutable long mAbstractReceptions = 0;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_LEVELOFDETAILRADIOMEDIUM_H_Q4RM8TWB */
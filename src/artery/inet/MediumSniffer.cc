@@ -0,0 +1,86 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/inet/MediumSniffer.h"
+#include <inet/common/INETMath.h>
+#include <inet/common/InitStages.h>
+#include <inet/common/ModuleAccess.h>
+#include <inet/physicallayer/analogmodel/packetlevel/ScalarTransmission.h>
+#include <inet/physicallayer/contract/packetlevel/IPathLoss.h>
+#include <inet/physicallayer/contract/packetlevel/IRadio.h>
+#include <inet/physicallayer/contract/packetlevel/IRadioMedium.h>
+
+using namespace omnetpp;
+namespace phy = inet::physicallayer;
+
+namespace artery
+{
+
+Define_Module(MediumSniffer)
+
+const simsignal_t MediumSniffer::powerSignal = cComponent::registerSignal("snifferPower");
+const simsignal_t MediumSniffer::frameSizeSignal = cComponent::registerSignal("snifferFrameSize");
+const simsignal_t MediumSniffer::durationSignal = cComponent::registerSignal("snifferDuration");
+const simsignal_t MediumSniffer::senderSignal = cComponent::registerSignal("snifferSender");
+
+int MediumSniffer::numInitStages() const
+{
+    return inet::NUM_INIT_STAGES;
+}
+
+void MediumSniffer::initialize(int stage)
+{
+    if (stage == inet::INITSTAGE_LOCAL) {
+        mPosition = inet::Coord { par("positionX"), par("positionY"), par("positionZ") };
+        mSensitivity = inet::mW { inet::math::dBm2mW(par("sensitivity")) };
+    } else if (stage == inet::INITSTAGE_PHYSICAL_LAYER) {
+        auto medium = inet::getModuleFromPar<phy::IRadioMedium>(par("radioMediumModule"), this);
+        mMedium = medium;
+        mPathLoss = medium->getPathLoss();
+        mPropagationSpeed = medium->getPropagation()->getPropagationSpeed();
+        check_and_cast<cModule*>(medium)->subscribe(phy::IRadioMedium::transmissionAddedSignal, this);
+    }
+}
+
+void MediumSniffer::finish()
+{
+    recordScalar("sniffedFrames", mFrames);
+}
+
+void MediumSniffer::receiveSignal(cComponent*, simsignal_t signal, cObject* obj, cObject*)
+{
+    if (signal == phy::IRadioMedium::transmissionAddedSignal) {
+        sniff(check_and_cast<const phy::ITransmission*>(obj));
+    }
+}
+
+void MediumSniffer::sniff(const phy::ITransmission* transmission)
+{
+    Enter_Method_Silent();
+    auto scalar = dynamic_cast<const phy::ScalarTransmission*>(transmission);
+    if (!scalar) {
+        throw cRuntimeError("MediumSniffer supports scalar transmissions only");
+    }
+
+    // isotropic antennas, obstacles are not considered
+    const inet::m distance { transmission->getStartPosition().distance(mPosition) };
+    const double loss = mPathLoss->computePathLoss(mPropagationSpeed, scalar->getCarrierFrequency(), distance);
+    const inet::W power = scalar->getPower() * loss;
+    if (power < mSensitivity) {
+        return;
+    }
+
+    ++mFrames;
+    emit(powerSignal, inet::math::mW2dBm(inet::mW(power).get()));
+    emit(durationSignal, transmission->getDuration());
+    if (const cPacket* frame = transmission->getMacFrame()) {
+        emit(frameSizeSignal, frame->getBitLength());
+    }
+    const cModule* radio = check_and_cast<const cModule*>(transmission->getTransmitter());
+    const cModule* node = inet::findContainingNode(radio);
+    emit(senderSignal, static_cast<long>(node ? node->getId() : radio->getId()));
+}
+
+} // namespace artery
@@ -0,0 +1,59 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_MEDIUMSNIFFER_H_T3VQ8ZKD
+#define ARTERY_MEDIUMSNIFFER_H_T3VQ8ZKD
+
+#include <inet/common/Units.h>
+#include <inet/common/geometry/common/Coord.h>
+#include <omnetpp/clistener.h>
+#include <omnetpp/csimplemodule.h>
+
+namespace inet
+{
+namespace physicallayer
+{
+    class IPathLoss;
+    class IRadioMedium;
+    class ITransmission;
+} // namespace physicallayer
+} // namespace inet
+
+namespace artery
+{
+
+/**
+ * MediumSniffer monitors all transmissions on a radio medium at a fixed location.
+ *
+ * Unlike PassiveProbe nodes, no radio is attached to the medium: frame metadata
+ * and the power at the sniffer's location are derived analytically when a transmission is added.
+ */
+class MediumSniffer : public omnetpp::cSimpleModule, public omnetpp::cListener
+{
+public:
+    static const omnetpp::simsignal_t powerSignal;
+    static const omnetpp::simsignal_t frameSizeSignal;
+    static const omnetpp::simsignal_t durationSignal;
+    static const omnetpp::simsignal_t senderSignal;
+
+    int numInitStages() const override;
+    void initialize(int stage) override;
+    void finish() override;
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, omnetpp::cObject*, omnetpp::cObject*) override;
+
+private:
+    void sniff(const inet::physicallayer::ITransmission*);
+
+    const inet::physicallayer::IRadioMedium* mMedium = nullptr;
+    const inet::physicallayer::IPathLoss* mPathLoss = nullptr;
+    inet::mps mPropagationSpeed;
+    inet::Coord mPosition;
+    inet::W mSensitivity;
+    long mFrames = 0;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_MEDIUMSNIFFER_H_T3VQ8ZKD */
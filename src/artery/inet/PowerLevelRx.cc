@@ -6,6 +6,7 @@
 
 #include "artery/inet/PowerLevelRx.h"
 #include "artery/inet/VanetRadio.h"
+#include "artery/utility/ProfilingScope.h"
 #include "inet/common/INETMath.h"
 #include "inet/common/ModuleAccess.h"
 #include "inet/linklayer/ieee80211/mac/contract/IContention.h"
@@ -13,6 +14,7 @@
 #include "inet/physicallayer/analogmodel/packetlevel/ScalarReception.h"
 #include "inet/physicallayer/backgroundnoise/IsotropicScalarBackgroundNoise.h"
 #include "inet/physicallayer/contract/packetlevel/IRadio.h"
+#include "inet/physicallayer/contract/packetlevel/IRadioFrame.h"
 #include "inet/physicallayer/contract/packetlevel/IRadioMedium.h"
 #include <cmath>
 
@@ -43,12 +45,21 @@ void PowerLevelRx::initialize(int stage)
         mCcaNoiseThreshold = inet::mW { inet::math::dBm2mW(par("ccaNoiseThreshold")) };
         mCbrThreshold = inet::mW { inet::math::dBm2mW(par("cbrThreshold")) };
         mCbrWithTx = par("cbrWithTx");
+        mIncrementalBusyPower = par("incrementalBusyPower");
+        mReceivedPower = inet::W { 0 };
+        mStrongReceptions = 0;
 
         mChannelReportInterval = simtime_t { 100, SIMTIME_MS };
-        mChannelReportTrigger = new cMessage("report CL");
         if (par("asyncChannelReport").boolValue()) {
+            mChannelReportTrigger = new cMessage("report CL");
             scheduleAt(simTime() + mChannelReportInterval, mChannelReportTrigger);
+        } else if (auto reporter = inet::findModuleFromPar<ChannelLoadReporter>(par("channelLoadReporterModule"), this, false)) {
+            if (reporter->getInterval() != mChannelReportInterval) {
+                throw cRuntimeError("interval of channel load reporter has to be %s", mChannelReportInterval.str().c_str());
+            }
+            reporter->subscribe(this);
         } else {
+            mChannelReportTrigger = new cMessage("report CL");
             double cycle = simTime() / mChannelReportInterval;
             scheduleAt((1.0 + std::ceil(cycle)) * mChannelReportInterval, mChannelReportTrigger);
         }
@@ -73,6 +84,9 @@ void PowerLevelRx::initialize(int stage)
         }
 
         omnetpp::check_and_cast<omnetpp::cModule*>(mRadio)->subscribe(VanetRadio::RadioFrameSignal, this);
+        if (mIncrementalBusyPower) {
+            omnetpp::check_and_cast<omnetpp::cModule*>(mRadio)->subscribe(VanetRadio::RadioFrameArrivalSignal, this);
+        }
     }
 }
 
@@ -86,18 +100,60 @@ void PowerLevelRx::handleMessage(cMessage* msg)
     }
 }
 
-void PowerLevelRx::receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t signal, omnetpp::cObject*, omnetpp::cObject*)
+void PowerLevelRx::reportChannelLoad()
+{
+    Enter_Method_Silent();
+    emit(ChannelLoadSignal, mChannelLoadSampler.cbr());
+}
+
+void PowerLevelRx::receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t signal, omnetpp::cObject* obj, omnetpp::cObject*)
 {
     Enter_Method_Silent();
 
     if (signal == VanetRadio::RadioFrameSignal) {
         recomputeMediumFree();
+    } else if (signal == VanetRadio::RadioFrameArrivalSignal) {
+        addReceptionPower(omnetpp::check_and_cast<const phy::IRadioFrame*>(obj)->getTransmission());
+    }
+}
+
+void PowerLevelRx::addReceptionPower(const phy::ITransmission* transmission)
+{
+    const phy::IReception* reception = mRadio->getMedium()->getReception(mRadio, transmission);
+    auto scalarReception = omnetpp::check_and_cast<const phy::ScalarReception*>(reception);
+    const inet::W power = scalarReception->getPower();
+    mReceptionPowers.push(ReceptionPower { reception->getEndTime(), power });
+    mReceivedPower += power;
+    if (power >= mCcaSignalThreshold) {
+        ++mStrongReceptions;
+    }
+}
+
+void PowerLevelRx::expireReceptionPowers()
+{
+    const omnetpp::simtime_t now = omnetpp::simTime();
+    while (!mReceptionPowers.empty() && mReceptionPowers.top().end <= now) {
+        const inet::W power = mReceptionPowers.top().power;
+        mReceptionPowers.pop();
+        mReceivedPower -= power;
+        if (power >= mCcaSignalThreshold) {
+            --mStrongReceptions;
+        }
+    }
+
+    if (mReceptionPowers.empty()) {
+        // discard rounding errors accumulated meanwhile
+        mReceivedPower = inet::W { 0 };
     }
 }
 
 void PowerLevelRx::recomputeMediumFree()
 {
+    ARTERY_PROFILE_SCOPE("phy.recomputeMediumFree");
     const bool oldMediumFree = mediumFree;
+    if (mIncrementalBusyPower) {
+        expireReceptionPowers();
+    }
 
     if (receptionState == phy::IRadio::ReceptionState::RECEPTION_STATE_RECEIVING) {
         const phy::ITransmission* transmission = mRadio->getReceptionInProgress();
@@ -117,6 +173,11 @@ void PowerLevelRx::recomputeMediumFree()
         } else {
             error("no reception in progress though reception state is 'receiving'");
         }
+    } else if (receptionState == phy::IRadio::ReceptionState::RECEPTION_STATE_BUSY && mIncrementalBusyPower) {
+        // ended receptions have been expired already, thus only ongoing ones are accumulated
+        const inet::W busyPower = mBackgroundNoise + mReceivedPower;
+        mediumFree = !endNavTimer->isScheduled() && mStrongReceptions == 0 && busyPower < mCcaNoiseThreshold;
+        mChannelLoadSampler.busy(busyPower > mCbrThreshold);
     } else if (receptionState == phy::IRadio::ReceptionState::RECEPTION_STATE_BUSY) {
         static const auto busySymbol = omnetpp::SimTime { 8, omnetpp::SIMTIME_US };
         const auto busyStart = omnetpp::simTime();
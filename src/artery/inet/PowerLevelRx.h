@@ -7,15 +7,20 @@
 #ifndef ARTERY_POWERLEVELRX_H_1N3KJPOI
 #define ARTERY_POWERLEVELRX_H_1N3KJPOI
 
+#include "artery/nic/ChannelLoadReporter.h"
 #include "artery/nic/ChannelLoadSampler.h"
 #include "inet/linklayer/ieee80211/mac/Rx.h"
 #include <omnetpp/clistener.h>
+#include <functional>
+#include <queue>
+#include <vector>
 
 // forward declarations
 namespace inet {
 namespace physicallayer {
     class ICommunicationCache;
     class IRadio;
+    class ITransmission;
 } // namespace physicallayer
 } // namespace inet
 
@@ -28,7 +33,7 @@ namespace artery
  * This allows to use receivers with better sensitivity than the minimum required by the IEEE 802.11 standard
  * while keeping CCA behaviour at a stable level.
  */
-class PowerLevelRx : public inet::ieee80211::Rx, public omnetpp::cListener
+class PowerLevelRx : public inet::ieee80211::Rx, public omnetpp::cListener, public ChannelLoadReporter::Client
 {
 public:
     PowerLevelRx();
@@ -40,15 +45,34 @@ protected:
     void initialize(int stage) override;
     void handleMessage(omnetpp::cMessage*) override;
     void recomputeMediumFree() override;
+    void reportChannelLoad() override;
 
     void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, omnetpp::cObject*, omnetpp::cObject*) override;
 
 private:
+    struct ReceptionPower
+    {
+        omnetpp::simtime_t end;
+        inet::W power;
+
+        bool operator>(const ReceptionPower& other) const { return end > other.end; }
+    };
+
+    /**
+     * Add power of an arriving transmission to the received power accumulator
+     */
+    void addReceptionPower(const inet::physicallayer::ITransmission*);
+
+    /**
+     * Remove powers of receptions which have ended until now
+     */
+    void expireReceptionPowers();
+
     inet::physicallayer::IRadio* mRadio = nullptr;
     inet::physicallayer::ICommunicationCache* mCommunicationCache = nullptr;
 
     omnetpp::simtime_t mChannelReportInterval;
-    omnetpp::cMessage* mChannelReportTrigger;
+    omnetpp::cMessage* mChannelReportTrigger = nullptr;
     ChannelLoadSampler mChannelLoadSampler;
 
     inet::W mBackgroundNoise;
@@ -56,6 +80,12 @@ private:
     inet::W mCcaSignalThreshold;
     inet::W mCcaNoiseThreshold;
     bool mCbrWithTx = false;
+
+    // received power accumulated incrementally at reception start and end
+    bool mIncrementalBusyPower = false;
+    std::priority_queue<ReceptionPower, std::vector<ReceptionPower>, std::greater<ReceptionPower>> mReceptionPowers;
+    inet::W mReceivedPower;
+    unsigned mStrongReceptions = 0; /*< number of receptions at or above CCA signal threshold */
 };
 
 } // namespace artery
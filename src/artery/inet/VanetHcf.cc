@@ -5,6 +5,8 @@
 */
 
 #include "artery/inet/VanetHcf.h"
+#include "artery/inet/ChannelLoadRx.h"
+#include <algorithm>
 
 namespace artery
 {
@@ -14,6 +16,162 @@ Define_Module(VanetHcf)
 using namespace inet::ieee80211;
 using inet::physicallayer::IIeee80211Mode;
 
+namespace
+{
+
+// keeps analytic access delay finite on a saturated channel
+const double scMaxBusyRatio = 0.99;
+
+// sequence number space of IEEE 802.11 sequence control field
+const unsigned scSequenceNumbers = 4096;
+
+} // namespace
+
+VanetHcf::~VanetHcf()
+{
+    cancelAndDelete(mAnalyticTxStart);
+    for (auto& queue : mAnalyticQueues) {
+        for (Ieee80211DataOrMgmtFrame* frame : queue) {
+            delete frame;
+        }
+    }
+}
+
+void VanetHcf::initialize(int stage)
+{
+    Hcf::initialize(stage);
+    if (stage == inet::INITSTAGE_LOCAL) {
+        mAnalyticChannelAccess = par("analyticChannelAccess");
+        if (mAnalyticChannelAccess) {
+            mChannelLoadRx = dynamic_cast<ChannelLoadRx*>(rx);
+            if (!mChannelLoadRx) {
+                throw omnetpp::cRuntimeError("analytic channel access requires ChannelLoadRx as MAC's rx module");
+            }
+
+            omnetpp::cModule* edcaModule = getSubmodule("edca");
+            for (int ac = AC_BK; ac < AC_NUMCATEGORIES; ++ac) {
+                omnetpp::cModule* edcaf = edcaModule ? edcaModule->getSubmodule("edcaf", ac) : nullptr;
+                mAifsn[ac] = edcaf ? edcaf->par("aifsn").intValue() : -1;
+                mCwMin[ac] = edcaf ? edcaf->par("cwMin").intValue() : -1;
+                if (mAifsn[ac] < 0 || mCwMin[ac] < 0) {
+                    throw omnetpp::cRuntimeError("analytic channel access requires explicit aifsn and cwMin of edcaf[%d]", ac);
+                }
+            }
+
+            mAnalyticQueueLength = par("analyticQueueLength");
+            mAnalyticTxStart = new omnetpp::cMessage("analytic channel access");
+        }
+    }
+}
+
+void VanetHcf::handleMessage(omnetpp::cMessage* msg)
+{
+    if (msg == mAnalyticTxStart) {
+        startAnalyticTransmission();
+    } else {
+        Hcf::handleMessage(msg);
+    }
+}
+
+void VanetHcf::processUpperFrame(Ieee80211DataOrMgmtFrame* frame)
+{
+    if (!mAnalyticChannelAccess) {
+        Hcf::processUpperFrame(frame);
+        return;
+    }
+
+    Enter_Method("processUpperFrame(%s)", frame->getName());
+    const AccessCategory ac = classifyFrame(frame);
+    auto& queue = mAnalyticQueues[ac];
+    if (queue.size() >= mAnalyticQueueLength) {
+        EV_WARN << "Dropping frame " << frame->getName() << " because queue of access category " << ac << " is full" << std::endl;
+        delete frame;
+        return;
+    }
+
+    take(frame);
+    queue.push_back(frame);
+    scheduleAnalyticTransmission();
+}
+
+void VanetHcf::transmissionComplete(Ieee80211Frame* frame)
+{
+    if (frame && frame == mAnalyticFrame) {
+        Enter_Method("transmissionComplete");
+        mAnalyticFrame = nullptr;
+        delete frame;
+        scheduleAnalyticTransmission();
+    } else {
+        Hcf::transmissionComplete(frame);
+    }
+}
+
+AccessCategory VanetHcf::classifyFrame(const Ieee80211DataOrMgmtFrame* frame) const
+{
+    // user priority to access category mapping (see table 9-1 in IEEE 802.11-2012)
+    static const AccessCategory categories[] = { AC_BE, AC_BK, AC_BK, AC_BE, AC_VI, AC_VI, AC_VO, AC_VO };
+    auto dataFrame = dynamic_cast<const Ieee80211DataFrame*>(frame);
+    if (dataFrame && dataFrame->getType() == ST_DATA_WITH_QOS && dataFrame->getTid() < 8) {
+        return categories[dataFrame->getTid()];
+    } else if (dataFrame) {
+        return AC_BE;
+    } else {
+        // management frames are sent using AC_VO
+        return AC_VO;
+    }
+}
+
+omnetpp::simtime_t VanetHcf::computeAccessDelay(AccessCategory ac)
+{
+    // AIFS and backoff slots elapse only while the medium is idle
+    const double busy = std::min(std::max(mChannelLoadRx->getChannelBusyRatio(), 0.0), scMaxBusyRatio);
+    const omnetpp::simtime_t slot = modeSet->getSlotTime();
+    const omnetpp::simtime_t aifs = modeSet->getSifsTime() + mAifsn[ac] * slot;
+    const int backoff = intuniform(0, mCwMin[ac]);
+    return (aifs + backoff * slot) / (1.0 - busy);
+}
+
+void VanetHcf::scheduleAnalyticTransmission()
+{
+    if (mAnalyticTxStart->isScheduled() || mAnalyticFrame) {
+        return;
+    }
+
+    for (int ac = AC_VO; ac >= AC_BK; --ac) {
+        if (!mAnalyticQueues[ac].empty()) {
+            scheduleAt(omnetpp::simTime() + computeAccessDelay(AccessCategory(ac)), mAnalyticTxStart);
+            break;
+        }
+    }
+}
+
+void VanetHcf::startAnalyticTransmission()
+{
+    // frame of highest access category wins like an internal collision in EDCA
+    for (int ac = AC_VO; ac >= AC_BK; --ac) {
+        auto& queue = mAnalyticQueues[ac];
+        if (queue.empty()) {
+            continue;
+        }
+
+        Ieee80211DataOrMgmtFrame* frame = queue.front();
+        queue.pop_front();
+        frame->setSequenceNumber(mSequenceNumber);
+        mSequenceNumber = (mSequenceNumber + 1) % scSequenceNumbers;
+        frame->setDuration(0);
+        if (auto dataFrame = dynamic_cast<Ieee80211DataFrame*>(frame)) {
+            // no frame exchange follows, thus receivers must not respond with an ACK
+            if (dataFrame->getType() == ST_DATA_WITH_QOS) {
+                dataFrame->setAckPolicy(NO_ACK);
+            }
+        }
+        setFrameMode(frame, rateSelection->computeMode(frame, nullptr));
+        mAnalyticFrame = frame;
+        tx->transmitFrame(frame, SIMTIME_ZERO, this);
+        break;
+    }
+}
+
 void VanetHcf::setFrameMode(Ieee80211Frame* frame, const IIeee80211Mode* mode) const
 {
     using namespace inet;
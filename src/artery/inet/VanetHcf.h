@@ -7,18 +7,55 @@
 #ifndef ARTERY_VANETHCF_H_FSAYCGUD
 #define ARTERY_VANETHCF_H_FSAYCGUD
 
+#include <inet/linklayer/ieee80211/mac/common/AccessCategory.h>
 #include <inet/linklayer/ieee80211/mac/coordinationfunction/Hcf.h>
+#include <array>
+#include <deque>
 
 namespace artery
 {
 
+class ChannelLoadRx;
+
+/**
+ * VanetHcf is INET's HCF with Artery's transmission requests and an optional analytic channel access.
+ *
+ * With analyticChannelAccess enabled, upper frames bypass EDCA's contention and frame exchange:
+ * the expected access delay is computed from the busy ratio measured by ChannelLoadRx and the
+ * access category's AIFSN and CWmin, and only a single transmission start event is scheduled per frame.
+ * Frames are sent once without acknowledgement.
+ */
 class VanetHcf : public inet::ieee80211::Hcf
 {
+public:
+    ~VanetHcf();
+
 protected:
+    void initialize(int stage) override;
+    void handleMessage(omnetpp::cMessage*) override;
+    void processUpperFrame(inet::ieee80211::Ieee80211DataOrMgmtFrame*) override;
+    void transmissionComplete(inet::ieee80211::Ieee80211Frame*) override;
     void setFrameMode(inet::ieee80211::Ieee80211Frame*, const inet::physicallayer::IIeee80211Mode*) const override;
+
+private:
+    using AccessCategory = inet::ieee80211::AccessCategory;
+
+    AccessCategory classifyFrame(const inet::ieee80211::Ieee80211DataOrMgmtFrame*) const;
+    omnetpp::simtime_t computeAccessDelay(AccessCategory);
+    void scheduleAnalyticTransmission();
+    void startAnalyticTransmission();
+
+    bool mAnalyticChannelAccess = false;
+    ChannelLoadRx* mChannelLoadRx = nullptr;
+    std::array<int, inet::ieee80211::AC_NUMCATEGORIES> mAifsn;
+    std::array<int, inet::ieee80211::AC_NUMCATEGORIES> mCwMin;
+    std::array<std::deque<inet::ieee80211::Ieee80211DataOrMgmtFrame*>, inet::ieee80211::AC_NUMCATEGORIES> mAnalyticQueues;
+    unsigned mAnalyticQueueLength = 0;
+    omnetpp::cMessage* mAnalyticTxStart = nullptr;
+    inet::ieee80211::Ieee80211Frame* mAnalyticFrame = nullptr; /*< frame handed to Tx */
+    unsigned mSequenceNumber = 0;
 };
 
 } // namespace artery
 
 #endif /* ARTERY_VANETHCF_H_FSAYCGUD */
-
@@ -7,7 +7,10 @@
 #include "artery/inet/VanetNakagamiFading.h"
 #include <boost/lexical_cast.hpp>
 #include <inet/common/INETMath.h>
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <map>
 
 namespace artery
 {
@@ -18,7 +21,10 @@ VanetNakagamiFading::VanetNakagamiFading() :
     m_critical_distance(inet::m(100.0)),
     m_gamma1(2), m_gamma2(4),
     m_sigma1(1), m_sigma2(1),
-    m_default_shape(1)
+    m_slope1_factor(20), m_slope2_factor(40), m_slope2_offset(-40),
+    m_default_shape(1),
+    m_ref_wavelength(inet::m(std::numeric_limits<double>::quiet_NaN())),
+    m_ref_loss(std::numeric_limits<double>::quiet_NaN())
 {
 }
 
@@ -34,12 +40,19 @@ void VanetNakagamiFading::initialize(int stage)
         m_sigma1 = par("sigma1");
         m_sigma2 = par("sigma2");
         parseShapeFactors(par("shapes"));
+
+        // loss beyond critical distance: 10 gamma1 log(dc) + 10 gamma2 log(d / dc) = offset + 10 gamma2 log(d)
+        const double logCritical = std::log10(m_critical_distance.get());
+        m_slope1_factor = 10.0 * m_gamma1;
+        m_slope2_factor = 10.0 * m_gamma2;
+        m_slope2_offset = (m_slope1_factor - m_slope2_factor) * logCritical;
+        m_ref_wavelength = inet::m(std::numeric_limits<double>::quiet_NaN());
     }
 }
 
 void VanetNakagamiFading::parseShapeFactors(const omnetpp::cXMLElement* shapes)
 {
-    m_shapes.clear();
+    std::map<double, double> sorted_shapes;
 
     if (shapes && strcmp(shapes->getTagName(), "shapes") == 0) {
         const char* default_value = shapes->getAttribute("default");
@@ -61,13 +74,21 @@ void VanetNakagamiFading::parseShapeFactors(const omnetpp::cXMLElement* shapes)
                 throw omnetpp::cRuntimeError("XML Nakagami configuration contains <shape> tag without 'value' attribute");
             }
 
-            auto dist = inet::m { boost::lexical_cast<double>(dist_attr) };
+            auto dist = boost::lexical_cast<double>(dist_attr);
             auto value = boost::lexical_cast<double>(value_attr);
-            m_shapes[dist] = value;
+            sorted_shapes[dist] = value;
         }
     } else {
         throw omnetpp::cRuntimeError("XML Nakagami shape factor configuration does not start with <shapes> tag");
     }
+
+    // flat arrays are searched faster than map nodes
+    m_shape_distances.clear();
+    m_shape_values.clear();
+    for (const auto& shape : sorted_shapes) {
+        m_shape_distances.push_back(shape.first);
+        m_shape_values.push_back(shape.second);
+    }
 }
 
 double VanetNakagamiFading::computePathLoss(inet::mps propagationSpeed, inet::Hz freq, inet::m dist) const
@@ -85,31 +106,40 @@ double VanetNakagamiFading::computeNakagamiPathLoss(inet::m lambda, inet::m dist
 
 double VanetNakagamiFading::computeDualSlopePathLoss(inet::m lambda, inet::m dist) const
 {
+    // reference distance is 1 m, thus log(d / refDist) is log(d)
     static const inet::m refDist = inet::m(1.0);
-    const double refLoss = computeFreeSpacePathLoss(lambda, refDist, alpha, systemLoss);
+    const double refLoss = computeReferencePathLoss(lambda);
 
     double loss = 0.0;
     if (dist < refDist) {
         loss = refLoss;
     } else if (dist < m_critical_distance) {
-        loss = 10.0 * m_gamma1 * std::log10(inet::unit(dist / refDist).get()) + normal(0.0, m_sigma1);
+        loss = m_slope1_factor * std::log10(dist.get()) + normal(0.0, m_sigma1);
     } else {
-        loss = 10.0 * m_gamma1 * std::log10(inet::unit(m_critical_distance / refDist).get())
-            + 10.0 * m_gamma2 * std::log10(inet::unit(dist / m_critical_distance).get()) + normal(0.0, m_sigma2);
+        loss = m_slope2_offset + m_slope2_factor * std::log10(dist.get()) + normal(0.0, m_sigma2);
     }
 
     return refLoss / inet::math::dB2fraction(loss);
 }
 
+double VanetNakagamiFading::computeReferencePathLoss(inet::m lambda) const
+{
+    // wave length rarely changes, i.e. only for different channels
+    if (lambda != m_ref_wavelength) {
+        m_ref_loss = computeFreeSpacePathLoss(lambda, inet::m(1.0), alpha, systemLoss);
+        m_ref_wavelength = lambda;
+    }
+    return m_ref_loss;
+}
+
 double VanetNakagamiFading::lookUpShapeFactor(inet::m dist) const
 {
-    double shapeFactor = m_default_shape;
-    auto found = m_shapes.lower_bound(dist);
-    if (found != m_shapes.end()) {
-        shapeFactor = found->second;
+    // first shape factor whose distance is not less than dist
+    auto found = std::lower_bound(m_shape_distances.begin(), m_shape_distances.end(), dist.get());
+    if (found != m_shape_distances.end()) {
+        return m_shape_values[found - m_shape_distances.begin()];
     }
-    EV_DEBUG << "Nakagami m = " << shapeFactor << " for distance " << dist << "\n";
-    return shapeFactor;
+    return m_default_shape;
 }
 
 std::ostream& VanetNakagamiFading::printToStream(std::ostream& os, int level) const
@@ -124,7 +154,7 @@ std::ostream& VanetNakagamiFading::printToStream(std::ostream& os, int level) co
             << ", sigma1 = " << m_sigma1
             << ", sigma2 = " << m_sigma2
             << ", default shape factor = " << m_default_shape
-            << ", " << m_shapes.size() << "shape factors";
+            << ", " << m_shape_values.size() << "shape factors";
     }
     return os;
 }
@@ -8,7 +8,7 @@
 #define ARTERY_VANETNAKAGAMIFADING_H_KRHFTXO9
 
 #include <inet/physicallayer/pathloss/FreeSpacePathLoss.h>
-#include <map>
+#include <vector>
 
 namespace artery
 {
@@ -27,6 +27,7 @@ protected:
     double lookUpShapeFactor(inet::m dist) const;
     double computeDualSlopePathLoss(inet::m waveLength, inet::m dist) const;
     double computeNakagamiPathLoss(inet::m waveLength, inet::m dist) const;
+    double computeReferencePathLoss(inet::m waveLength) const;
 
 private:
     inet::m m_critical_distance;
@@ -34,8 +35,14 @@ private:
     double m_gamma2; /*< path loss exponent beyond critical distance */
     double m_sigma1; /*< stdev below critical distance */
     double m_sigma2; /*< stdev beyond critical distance */
-    double m_default_shape; /*< default Nakagami-m shape factor for distance not covered by map */
-    std::map<inet::m, double> m_shapes; /*< Nakagami-m shape factors depending on distance */
+    double m_slope1_factor; /*< 10 * gamma1 */
+    double m_slope2_factor; /*< 10 * gamma2 */
+    double m_slope2_offset; /*< deterministic loss (dB) of second slope except gamma2 term */
+    double m_default_shape; /*< default Nakagami-m shape factor for distance not covered by table */
+    std::vector<double> m_shape_distances; /*< ascending upper distance bounds (m) of shape factors */
+    std::vector<double> m_shape_values; /*< Nakagami-m shape factors corresponding to distances */
+    mutable inet::m m_ref_wavelength; /*< wave length of cached reference loss */
+    mutable double m_ref_loss; /*< free space loss at reference distance */
 };
 
 } // namespace artery
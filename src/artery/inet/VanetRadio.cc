@@ -14,9 +14,12 @@ namespace artery
 Define_Module(VanetRadio)
 
 const omnetpp::simsignal_t VanetRadio::RadioFrameSignal = omnetpp::cComponent::registerSignal("RadioFrame");
+const omnetpp::simsignal_t VanetRadio::RadioFrameArrivalSignal = omnetpp::cComponent::registerSignal("RadioFrameArrival");
 
 void VanetRadio::handleLowerPacket(inet::physicallayer::RadioFrame* frame)
 {
+    // listeners can account for the frame before any reception state change is signalled
+    emit(RadioFrameArrivalSignal, frame);
     phy::Ieee80211Radio::handleLowerPacket(frame);
     emit(RadioFrameSignal, frame);
 }
@@ -17,11 +17,13 @@ namespace artery
  * Specialised INET-based IEEE 802.11 radio for VANET communication.
  *
  * - emit RadioFrame signal on each incoming radio frame for CBR measurements
+ * - emit RadioFrameArrival signal on each incoming radio frame before the radio processes it
  */
 class VanetRadio : public inet::physicallayer::Ieee80211Radio
 {
 public:
     static const omnetpp::simsignal_t RadioFrameSignal;
+    static const omnetpp::simsignal_t RadioFrameArrivalSignal;
 
 protected:
     void handleLowerPacket(inet::physicallayer::RadioFrame*) override;
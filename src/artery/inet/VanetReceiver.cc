@@ -5,6 +5,7 @@
 */
 
 #include "artery/inet/VanetReceiver.h"
+#include "artery/utility/Fingerprint.h"
 #include <inet/physicallayer/analogmodel/packetlevel/ScalarReception.h>
 #include <inet/physicallayer/contract/packetlevel/IRadio.h>
 #include <inet/physicallayer/contract/packetlevel/IRadioMedium.h>
@@ -37,6 +38,12 @@ bool VanetReceiver::computeIsReceptionAttempted(const phy::IListening* listening
         } else {
             // allow capturing of stronger signals
             auto medium = reception->getReceiver()->getMedium();
+            // reception in progress interferes at least with new signal's start, thus it bounds the SNIR
+            auto current = omnetpp::check_and_cast<const phy::ScalarReception*>(medium->getReception(reception->getReceiver(), transmission));
+            auto candidate = omnetpp::check_and_cast<const phy::ScalarReception*>(reception);
+            if (candidate->getPower() <= current->getPower() * mCaptureThreshold) {
+                return false; // too weak for capturing, skip computing its SNIR
+            }
             auto snir = medium->getSNIR(reception->getReceiver(), reception->getTransmission())->getMin();
             return snir > mCaptureThreshold;
         }
@@ -52,6 +59,7 @@ const phy::ReceptionIndication* VanetReceiver::computeReceptionIndication(const
     auto wlanIndication = check_and_cast<Ieee80211ReceptionIndication*>(basicIndication);
     auto reception = check_and_cast<const ScalarReception*>(snir->getReception());
     wlanIndication->setMinRSSI(reception->getPower());
+    fingerprint::add(fingerprint::Ingredient::ReceptionPower, reception->getPower().get());
     return wlanIndication;
 }
 
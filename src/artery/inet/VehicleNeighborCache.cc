@@ -0,0 +1,198 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/inet/VehicleNeighborCache.h"
+#include "artery/utility/VehicleGeometryIndex.h"
+#include "traci/BasicNodeManager.h"
+#include <inet/common/InitStages.h>
+#include <inet/common/ModuleAccess.h>
+#include <inet/mobility/contract/IMobility.h>
+#include <inet/physicallayer/common/packetlevel/RadioMedium.h>
+#include <inet/physicallayer/contract/packetlevel/IAntenna.h>
+#include <inet/physicallayer/contract/packetlevel/IRadio.h>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace artery
+{
+
+Define_Module(VehicleNeighborCache)
+
+using namespace omnetpp;
+namespace bg = boost::geometry;
+namespace phy = inet::physicallayer;
+
+namespace
+{
+
+const inet::Coord& getPosition(const phy::IRadio* radio)
+{
+    return radio->getAntenna()->getMobility()->getCurrentPosition();
+}
+
+void eraseRadio(std::vector<const phy::IRadio*>& radios, const phy::IRadio* radio)
+{
+    radios.erase(std::remove(radios.begin(), radios.end(), radio), radios.end());
+}
+
+} // namespace
+
+int VehicleNeighborCache::numInitStages() const
+{
+    return inet::NUM_INIT_STAGES;
+}
+
+void VehicleNeighborCache::initialize(int stage)
+{
+    if (stage == inet::INITSTAGE_LOCAL) {
+        mMedium = check_and_cast<phy::RadioMedium*>(getParentModule());
+        mIndex = check_and_cast<VehicleGeometryIndex*>(getModuleByPath(par("vehicleGeometryIndexModule")));
+        mMargin = par("rangeMargin");
+
+        mTraci = getModuleByPath(par("traciModule"));
+        if (mTraci) {
+            mTraci->subscribe(traci::BasicNodeManager::addNodeSignal, this);
+            mTraci->subscribe(traci::BasicNodeManager::removeNodeSignal, this);
+        } else {
+            throw cRuntimeError("No TraCI module found for signal subscription");
+        }
+    }
+}
+
+void VehicleNeighborCache::finish()
+{
+    if (mTraci) {
+        mTraci->unsubscribe(traci::BasicNodeManager::addNodeSignal, this);
+        mTraci->unsubscribe(traci::BasicNodeManager::removeNodeSignal, this);
+        mTraci = nullptr;
+    }
+}
+
+void VehicleNeighborCache::receiveSignal(cComponent* source, simsignal_t signal, const char* id, cObject* obj)
+{
+    Enter_Method_Silent();
+    auto manager = check_and_cast<traci::BasicNodeManager*>(source);
+    auto node = check_and_cast<cModule*>(obj);
+    if (signal == traci::BasicNodeManager::addNodeSignal) {
+        // node handles are only acquired by vehicles
+        const traci::NodeHandle handle = manager->getNodeHandles().find(id);
+        if (handle != traci::NodeHandleRegistry::invalid) {
+            mNodeHandles[node] = handle;
+            assignRadios(node, handle);
+        }
+    } else if (signal == traci::BasicNodeManager::removeNodeSignal) {
+        auto found = mNodeHandles.find(node);
+        if (found != mNodeHandles.end()) {
+            releaseRadios(found->second);
+            mNodeHandles.erase(found);
+        }
+    }
+}
+
+void VehicleNeighborCache::addRadio(const phy::IRadio* radio)
+{
+    // vehicle radios are initialized before their node is announced, i.e. assigned later on
+    mOtherRadios.push_back(radio);
+    auto found = mNodeHandles.find(inet::getContainingNode(check_and_cast<const cModule*>(radio)));
+    if (found != mNodeHandles.end()) {
+        assignRadios(found->first, found->second);
+    }
+}
+
+void VehicleNeighborCache::removeRadio(const phy::IRadio* radio)
+{
+    eraseRadio(mOtherRadios, radio);
+    auto found = mNodeHandles.find(inet::getContainingNode(check_and_cast<const cModule*>(radio)));
+    if (found != mNodeHandles.end() && found->second < mVehicleRadios.size()) {
+        eraseRadio(mVehicleRadios[found->second], radio);
+    }
+}
+
+void VehicleNeighborCache::assignRadios(const cModule* node, traci::NodeHandle handle)
+{
+    if (handle >= mVehicleRadios.size()) {
+        mVehicleRadios.resize(handle + 1);
+        mVisited.resize(handle + 1, 0);
+    }
+
+    auto& radios = mVehicleRadios[handle];
+    for (auto it = mOtherRadios.begin(); it != mOtherRadios.end();) {
+        if (inet::getContainingNode(check_and_cast<const cModule*>(*it)) == node) {
+            radios.push_back(*it);
+            it = mOtherRadios.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void VehicleNeighborCache::releaseRadios(traci::NodeHandle handle)
+{
+    // radios of parked nodes stay registered at the medium
+    if (handle < mVehicleRadios.size()) {
+        auto& radios = mVehicleRadios[handle];
+        std::copy(radios.begin(), radios.end(), std::back_inserter(mOtherRadios));
+        radios.clear();
+    }
+}
+
+void VehicleNeighborCache::sendToNeighbors(phy::IRadio* transmitter, const phy::IRadioFrame* frame, double range) const
+{
+    if (!std::isfinite(range)) {
+        // medium without range filter: fall back to maximum communication range of its path loss
+        range = mMedium->getMediumLimitCache()->getMaxCommunicationRange().get();
+        if (!std::isfinite(range)) {
+            sendToAll(transmitter, frame);
+            return;
+        }
+    }
+
+    const inet::Coord& position = getPosition(transmitter);
+    const double reach = range + mMargin;
+    const geometry::Box box {
+        geometry::Point { position.x - reach, position.y - reach },
+        geometry::Point { position.x + reach, position.y + reach }
+    };
+
+    ++mQuery;
+    const auto& rtree = mIndex->getRtree();
+    for (auto it = rtree.qbegin(bg::index::intersects(box)); it != rtree.qend(); ++it) {
+        const traci::NodeHandle handle = it->second;
+        if (handle < mVehicleRadios.size() && mVisited[handle] != mQuery) {
+            mVisited[handle] = mQuery;
+            for (const phy::IRadio* radio : mVehicleRadios[handle]) {
+                if (radio != transmitter) {
+                    mMedium->sendToRadio(transmitter, radio, frame);
+                }
+            }
+        }
+    }
+
+    const double squaredReach = reach * reach;
+    for (const phy::IRadio* radio : mOtherRadios) {
+        if (radio != transmitter && position.sqrdist(getPosition(radio)) <= squaredReach) {
+            mMedium->sendToRadio(transmitter, radio, frame);
+        }
+    }
+}
+
+void VehicleNeighborCache::sendToAll(phy::IRadio* transmitter, const phy::IRadioFrame* frame) const
+{
+    for (const auto& radios : mVehicleRadios) {
+        for (const phy::IRadio* radio : radios) {
+            if (radio != transmitter) {
+                mMedium->sendToRadio(transmitter, radio, frame);
+            }
+        }
+    }
+    for (const phy::IRadio* radio : mOtherRadios) {
+        if (radio != transmitter) {
+            mMedium->sendToRadio(transmitter, radio, frame);
+        }
+    }
+}
+
+} // namespace artery
@@ -0,0 +1,67 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_VEHICLENEIGHBORCACHE_H_M6FZ2RLC
+#define ARTERY_VEHICLENEIGHBORCACHE_H_M6FZ2RLC
+
+#include "traci/NodeHandle.h"
+#include <inet/physicallayer/contract/packetlevel/INeighborCache.h>
+#include <omnetpp/clistener.h>
+#include <omnetpp/csimplemodule.h>
+#include <unordered_map>
+#include <vector>
+
+namespace inet { namespace physicallayer { class RadioMedium; } }
+
+namespace artery
+{
+
+class VehicleGeometryIndex;
+
+/**
+ * VehicleNeighborCache finds potential receivers in the shared VehicleGeometryIndex.
+ *
+ * Unlike INET's grid or quad tree caches it maintains no spatial index of its own:
+ * radios of SUMO vehicles are looked up in the index' rtree, which is updated once per TraCI step.
+ * Radios of other nodes (e.g. road side units or persons) are checked by their mobility position.
+ */
+class VehicleNeighborCache : public omnetpp::cSimpleModule, public omnetpp::cListener,
+    public inet::physicallayer::INeighborCache
+{
+public:
+    int numInitStages() const override;
+    void initialize(int stage) override;
+    void finish() override;
+
+    // INeighborCache
+    void addRadio(const inet::physicallayer::IRadio*) override;
+    void removeRadio(const inet::physicallayer::IRadio*) override;
+    void sendToNeighbors(inet::physicallayer::IRadio* transmitter, const inet::physicallayer::IRadioFrame*, double range) const override;
+
+    // cListener
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, const char*, omnetpp::cObject*) override;
+
+private:
+    void assignRadios(const omnetpp::cModule* node, traci::NodeHandle);
+    void releaseRadios(traci::NodeHandle);
+    void sendToAll(inet::physicallayer::IRadio* transmitter, const inet::physicallayer::IRadioFrame*) const;
+
+    inet::physicallayer::RadioMedium* mMedium = nullptr;
+    const VehicleGeometryIndex* mIndex = nullptr;
+    omnetpp::cModule* mTraci = nullptr;
+    double mMargin = 0.0;
+
+    std::unordered_map<const omnetpp::cModule*, traci::NodeHandle> mNodeHandles;
+    std::vector<std::vector<const inet::physicallayer::IRadio*>> mVehicleRadios; /*< indexed by node handle */
+    std::vector<const inet::physicallayer::IRadio*> mOtherRadios;
+
+    // vehicles may be indexed twice until the rtree is rebuilt, thus mark visited handles
+    mutable std::vector<unsigned long> mVisited;
+    mutable unsigned long mQuery = 0;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_VEHICLENEIGHBORCACHE_H_M6FZ2RLC */
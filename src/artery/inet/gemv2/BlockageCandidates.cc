@@ -0,0 +1,97 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/inet/gemv2/BlockageCandidates.h"
+#include <algorithm>
+#include <limits>
+
+namespace artery
+{
+namespace gemv2
+{
+
+void BlockageCandidates::clear()
+{
+    mIds.clear();
+    mMinX.clear();
+    mMinY.clear();
+    mMaxX.clear();
+    mMaxY.clear();
+    mOffsets.assign(1, 0);
+    mPX.clear();
+    mPY.clear();
+    mQX.clear();
+    mQY.clear();
+}
+
+void BlockageCandidates::add(Index id, const std::vector<Position>& outline)
+{
+    double minX = std::numeric_limits<double>::infinity();
+    double minY = minX;
+    double maxX = -minX;
+    double maxY = -minY;
+    for (std::size_t i = 0; i < outline.size(); ++i) {
+        const Position& p = outline[i];
+        const Position& q = outline[(i + 1) % outline.size()];
+        mPX.push_back(p.x.value());
+        mPY.push_back(p.y.value());
+        mQX.push_back(q.x.value());
+        mQY.push_back(q.y.value());
+        minX = std::min(minX, p.x.value());
+        minY = std::min(minY, p.y.value());
+        maxX = std::max(maxX, p.x.value());
+        maxY = std::max(maxY, p.y.value());
+    }
+
+    mIds.push_back(id);
+    mMinX.push_back(minX);
+    mMinY.push_back(minY);
+    mMaxX.push_back(maxX);
+    mMaxY.push_back(maxY);
+    mOffsets.push_back(mPX.size());
+}
+
+bool BlockageCandidates::any(const Position& a, const Position& b, const std::function<bool(Index)>& visitor) const
+{
+    const double ax = a.x.value();
+    const double ay = a.y.value();
+    const double bx = b.x.value();
+    const double by = b.y.value();
+    const double minX = std::min(ax, bx);
+    const double minY = std::min(ay, by);
+    const double maxX = std::max(ax, bx);
+    const double maxY = std::max(ay, by);
+
+    for (std::size_t k = 0; k < mIds.size(); ++k) {
+        const bool overlap = mMinX[k] <= maxX && minX <= mMaxX[k] && mMinY[k] <= maxY && minY <= mMaxY[k];
+        if (overlap && touches(k, ax, ay, bx, by) && visitor(mIds[k])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool BlockageCandidates::touches(std::size_t k, double ax, double ay, double bx, double by) const
+{
+    const double dx = bx - ax;
+    const double dy = by - ay;
+
+    // no early exit: the loop is kept free of branches for auto-vectorization
+    bool touched = false;
+    for (std::size_t e = mOffsets[k]; e < mOffsets[k + 1]; ++e) {
+        const double ex = mQX[e] - mPX[e];
+        const double ey = mQY[e] - mPY[e];
+        // sides of edge end points relative to segment and vice versa (zero: collinear or touching)
+        const double sideP = dx * (mPY[e] - ay) - dy * (mPX[e] - ax);
+        const double sideQ = dx * (mQY[e] - ay) - dy * (mQX[e] - ax);
+        const double sideA = ex * (ay - mPY[e]) - ey * (ax - mPX[e]);
+        const double sideB = ex * (by - mPY[e]) - ey * (bx - mPX[e]);
+        touched |= (sideP * sideQ <= 0.0) & (sideA * sideB <= 0.0);
+    }
+    return touched;
+}
+
+} // namespace gemv2
+} // namespace artery
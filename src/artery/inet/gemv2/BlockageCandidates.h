@@ -0,0 +1,74 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef BLOCKAGECANDIDATES_H_Q4NR8ZTC
+#define BLOCKAGECANDIDATES_H_Q4NR8ZTC
+
+#include "artery/utility/Geometry.h"
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace artery
+{
+namespace gemv2
+{
+
+/**
+ * BlockageCandidates holds outlines gathered by a single index query covering many lines of sight,
+ * e.g. all links of one transmitter.
+ *
+ * Envelopes and edges are stored in flat arrays, so each line of sight is screened by a
+ * branch-free segment intersection kernel instead of an R-tree query of its own.
+ * Only outlines with an edge touching the line of sight are handed to the exact test.
+ * Any line crossing or cutting an outline passes through one of its edges, thus
+ * screening never drops an actual blockage.
+ */
+class BlockageCandidates
+{
+public:
+    using Index = std::size_t;
+
+    void clear();
+
+    /**
+     * Add outline of a candidate
+     * \param id identifier of candidate passed to visitors
+     * \param outline polygon points, closing edge is added implicitly
+     */
+    void add(Index id, const std::vector<Position>& outline);
+
+    std::size_t size() const { return mIds.size(); }
+    bool empty() const { return mIds.empty(); }
+
+    /**
+     * Visit candidates with an edge touching segment a-b in order of addition
+     * \param a segment start
+     * \param b segment end
+     * \param visitor exact test invoked with candidate id, returning true stops the search
+     * \return true if the visitor stopped the search
+     */
+    bool any(const Position& a, const Position& b, const std::function<bool(Index)>& visitor) const;
+
+private:
+    bool touches(std::size_t candidate, double ax, double ay, double bx, double by) const;
+
+    std::vector<Index> mIds;
+    std::vector<double> mMinX;
+    std::vector<double> mMinY;
+    std::vector<double> mMaxX;
+    std::vector<double> mMaxY;
+    // edges of candidate k are [mOffsets[k], mOffsets[k + 1]) of start (P) and end (Q) arrays
+    std::vector<std::size_t> mOffsets = { 0 };
+    std::vector<double> mPX;
+    std::vector<double> mPY;
+    std::vector<double> mQX;
+    std::vector<double> mQY;
+};
+
+} // namespace gemv2
+} // namespace artery
+
+#endif /* BLOCKAGECANDIDATES_H_Q4NR8ZTC */
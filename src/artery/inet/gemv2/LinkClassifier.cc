@@ -7,7 +7,13 @@
 #include "artery/inet/gemv2/LinkClassifier.h"
 #include "artery/inet/gemv2/ObstacleIndex.h"
 #include "artery/inet/gemv2/VehicleIndex.h"
+#include "artery/utility/ProfilingScope.h"
+#include "artery/utility/TaskScheduler.h"
+#include <boost/geometry/algorithms/distance.hpp>
+#include <boost/geometry/algorithms/expand.hpp>
 #include <inet/common/ModuleAccess.h>
+#include <cmath>
+#include <iterator>
 
 namespace artery
 {
@@ -16,16 +22,32 @@ namespace gemv2
 
 Define_Module(LinkClassifier)
 
+namespace
+{
+
+// unused cache entries are dropped after this period
+const omnetpp::SimTime cachePurgeInterval { 1, omnetpp::SIMTIME_S };
+
+// blockage tests per task, each test only queries a few candidate obstacles
+const std::size_t linksPerTask = 16;
+
+} // namespace
+
 void LinkClassifier::initialize()
 {
     mObstacleIndex = inet::findModuleFromPar<ObstacleIndex>(par("obstacleIndexModule"), this);
     mFoliageIndex = inet::findModuleFromPar<ObstacleIndex>(par("foliageIndexModule"), this);
     mVehicleIndex = inet::findModuleFromPar<VehicleIndex>(par("vehicleIndexModule"), this);
+    mCacheDistance = par("cacheDistance");
+    if (mCacheDistance < 0.0) {
+        throw omnetpp::cRuntimeError("cacheDistance must not be negative");
+    }
 
     WATCH(mCountLOS);
     WATCH(mCountNLOSb);
     WATCH(mCountNLOSf);
     WATCH(mCountNLOSv);
+    WATCH(mCountCacheHits);
 }
 
 void LinkClassifier::finish()
@@ -34,22 +56,211 @@ void LinkClassifier::finish()
     recordScalar("countNLOSb", mCountNLOSb);
     recordScalar("countNLOSf", mCountNLOSf);
     recordScalar("countNLOSv", mCountNLOSv);
+    if (mCacheDistance > 0.0) {
+        recordScalar("countCacheHits", mCountCacheHits);
+    }
+    mCache.clear();
 }
 
 LinkClass LinkClassifier::classifyLink(const Position& tx, const Position& rx) const
 {
+    ARTERY_PROFILE_SCOPE("gemv2.classifyLink");
     LinkClass link = LinkClass::LOS;
     if (mObstacleIndex->anyBlockage(tx, rx)) {
         link = LinkClass::NLOSb;
-        ++mCountNLOSb;
     } else if (mFoliageIndex->anyBlockage(tx, rx)) {
         link = LinkClass::NLOSf;
-        ++mCountNLOSf;
     } else if (mVehicleIndex->anyBlockage(tx, rx)) {
         link = LinkClass::NLOSv;
-        ++mCountNLOSv;
-    } else {
-        ++mCountLOS;
+    }
+    return countLink(link);
+}
+
+void LinkClassifier::prepareBatch(const Position& tx, double range, Batch& batch, int transmitter) const
+{
+    const double x = tx.x.value();
+    const double y = tx.y.value();
+    batch.mTransmitter = tx;
+    batch.mTransmitterId = transmitter;
+    batch.mRange = range;
+    batch.mBox = geometry::Box { geometry::Point { x - range, y - range }, geometry::Point { x + range, y + range } };
+    batch.mGathered = false;
+}
+
+void LinkClassifier::gather(Batch& batch) const
+{
+    if (!batch.mGathered) {
+        mObstacleIndex->gatherCandidates(batch.mBox, batch.mObstacles);
+        mFoliageIndex->gatherCandidates(batch.mBox, batch.mFoliage);
+        mVehicleIndex->gatherCandidates(batch.mBox, batch.mVehicles);
+        batch.mGathered = true;
+    }
+}
+
+LinkClass LinkClassifier::classifyLink(Batch& batch, const Position& rx) const
+{
+    if (mCacheDistance > 0.0 && batch.mTransmitterId >= 0) {
+        return classifyCached(batch, rx);
+    }
+
+    gather(batch);
+    return countLink(testLink(batch, rx));
+}
+
+LinkClass LinkClassifier::testLink(const Batch& batch, const Position& rx) const
+{
+    const Position& tx = batch.mTransmitter;
+    LinkClass link = LinkClass::LOS;
+    if (mObstacleIndex->anyBlockage(batch.mObstacles, tx, rx)) {
+        link = LinkClass::NLOSb;
+    } else if (mFoliageIndex->anyBlockage(batch.mFoliage, tx, rx)) {
+        link = LinkClass::NLOSf;
+    } else if (mVehicleIndex->anyBlockage(batch.mVehicles, tx, rx)) {
+        link = LinkClass::NLOSv;
+    }
+    return link;
+}
+
+void LinkClassifier::classifyLinks(const Position& tx, const std::vector<Position>& rxs, std::vector<LinkClass>& links) const
+{
+    ARTERY_PROFILE_SCOPE("gemv2.classifyLinks");
+    // union of all lines of sight is covered by the envelope of all positions
+    geometry::Box box { geometry::Point { tx.x.value(), tx.y.value() }, geometry::Point { tx.x.value(), tx.y.value() } };
+    for (const Position& rx : rxs) {
+        boost::geometry::expand(box, geometry::Point { rx.x.value(), rx.y.value() });
+    }
+
+    Batch batch;
+    batch.mTransmitter = tx;
+    batch.mBox = box;
+    gather(batch);
+
+    links.clear();
+    links.reserve(rxs.size());
+    for (const Position& rx : rxs) {
+        links.push_back(classifyLink(batch, rx));
+    }
+}
+
+void LinkClassifier::classifyLinks(Batch& batch, const std::vector<Position>& rxs, std::vector<LinkClass>& links, TaskScheduler* scheduler) const
+{
+    ARTERY_PROFILE_SCOPE("gemv2.classifyBatchLinks");
+    links.resize(rxs.size());
+    if (mCacheDistance > 0.0 && batch.mTransmitterId >= 0) {
+        // link cache is modified by lookups and thus not shared among threads
+        for (std::size_t i = 0; i < rxs.size(); ++i) {
+            links[i] = classifyCached(batch, rxs[i]);
+        }
+        return;
+    }
+
+    gather(batch);
+    parallelFor(scheduler, rxs.size(), linksPerTask, [&](std::size_t i) {
+        links[i] = testLink(batch, rxs[i]);
+    });
+    for (LinkClass link : links) {
+        countLink(link);
+    }
+}
+
+LinkClass LinkClassifier::classifyCached(Batch& batch, const Position& rx) const
+{
+    const Position& tx = batch.mTransmitter;
+    CacheEntry& entry = lookupCache(batch.mTransmitterId, tx, rx);
+    bool hit = true;
+    if (!entry.staticValid) {
+        gather(batch);
+        entry.building = mObstacleIndex->anyBlockage(batch.mObstacles, tx, rx);
+        entry.foliage = !entry.building && mFoliageIndex->anyBlockage(batch.mFoliage, tx, rx);
+        entry.staticValid = true;
+        hit = false;
+    }
+
+    // vehicles move at every TraCI step, their blockage is valid until the vehicle index is updated
+    const unsigned long revision = mVehicleIndex->getRevision();
+    if (!entry.building && !entry.foliage && entry.vehicleRevision != revision) {
+        gather(batch);
+        entry.vehicle = mVehicleIndex->anyBlockage(batch.mVehicles, tx, rx);
+        entry.vehicleRevision = revision;
+        hit = false;
+    }
+
+    if (hit) {
+        ++mCountCacheHits;
+    }
+
+    LinkClass link = LinkClass::LOS;
+    if (entry.building) {
+        link = LinkClass::NLOSb;
+    } else if (entry.foliage) {
+        link = LinkClass::NLOSf;
+    } else if (entry.vehicle) {
+        link = LinkClass::NLOSv;
+    }
+    return countLink(link);
+}
+
+LinkClassifier::CacheEntry& LinkClassifier::lookupCache(int transmitter, const Position& tx, const Position& rx) const
+{
+    namespace bg = boost::geometry;
+    const omnetpp::SimTime now = omnetpp::simTime();
+    TransmitterCache& cache = mCache[transmitter];
+    if (now - cache.purged >= cachePurgeInterval) {
+        for (auto it = cache.entries.begin(); it != cache.entries.end();) {
+            it = it->second.used < cache.purged ? cache.entries.erase(it) : std::next(it);
+        }
+        cache.purged = now;
+    }
+
+    // receiver may have moved into a neighbouring cell since the entry has been created
+    for (int dx = -1; dx <= 1; ++dx) {
+        for (int dy = -1; dy <= 1; ++dy) {
+            auto range = cache.entries.equal_range(cacheCell(rx, dx, dy));
+            for (auto it = range.first; it != range.second;) {
+                CacheEntry& entry = it->second;
+                if (bg::distance(entry.rx, rx) > mCacheDistance) {
+                    ++it;
+                } else if (bg::distance(entry.tx, tx) > mCacheDistance) {
+                    // transmitter has moved too far
+                    it = cache.entries.erase(it);
+                } else {
+                    entry.used = now;
+                    return entry;
+                }
+            }
+        }
+    }
+
+    CacheEntry entry;
+    entry.tx = tx;
+    entry.rx = rx;
+    entry.used = now;
+    entry.vehicleRevision = mVehicleIndex->getRevision() - 1;
+    return cache.entries.emplace(cacheCell(rx), entry)->second;
+}
+
+std::uint64_t LinkClassifier::cacheCell(const Position& pos, int dx, int dy) const
+{
+    const auto x = static_cast<std::int32_t>(std::floor(pos.x.value() / mCacheDistance)) + dx;
+    const auto y = static_cast<std::int32_t>(std::floor(pos.y.value() / mCacheDistance)) + dy;
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+}
+
+LinkClass LinkClassifier::countLink(LinkClass link) const
+{
+    switch (link) {
+        case LinkClass::LOS:
+            ++mCountLOS;
+            break;
+        case LinkClass::NLOSb:
+            ++mCountNLOSb;
+            break;
+        case LinkClass::NLOSf:
+            ++mCountNLOSf;
+            break;
+        case LinkClass::NLOSv:
+            ++mCountNLOSv;
+            break;
     }
     return link;
 }
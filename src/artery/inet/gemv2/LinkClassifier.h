@@ -8,13 +8,18 @@
 #define LINKCLASSIFIER_H_OAXCBN1T
 
 #include "LinkClass.h"
+#include "artery/inet/gemv2/BlockageCandidates.h"
+#include "artery/utility/Geometry.h"
 #include <omnetpp/csimplemodule.h>
+#include <omnetpp/simtime.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
 
 namespace artery
 {
 
-// forward declaration
-class Position;
+class TaskScheduler;
 
 namespace gemv2
 {
@@ -30,7 +35,93 @@ public:
     void finish() override;
     LinkClass classifyLink(const Position& tx, const Position& rx) const;
 
+    /**
+     * Blockage candidates around a transmitter, shared by the classification of all its links
+     *
+     * Candidates are gathered on demand, i.e. not at all if every link is served by the link cache.
+     */
+    class Batch
+    {
+    public:
+        const Position& getTransmitter() const { return mTransmitter; }
+        double getRange() const { return mRange; }
+
+    private:
+        friend class LinkClassifier;
+        Position mTransmitter;
+        int mTransmitterId = -1;
+        double mRange = 0.0;
+        geometry::Box mBox;
+        bool mGathered = false;
+        BlockageCandidates mObstacles;
+        BlockageCandidates mFoliage;
+        BlockageCandidates mVehicles;
+    };
+
+    /**
+     * Prepare batch by one query per index covering all lines of sight up to range
+     * \param tx transmitter position
+     * \param range maximum distance of receivers classified with this batch
+     * \param batch batch to be prepared, its buffers are reused
+     * \param transmitter unique identifier of transmitting node enabling the link cache (negative: no caching)
+     */
+    void prepareBatch(const Position& tx, double range, Batch& batch, int transmitter = -1) const;
+
+    /**
+     * Classify link of batch's transmitter, same result as classifyLink(tx, rx) unless served by link cache
+     * \param batch prepared batch
+     * \param rx receiver position within batch range
+     * \return link class
+     */
+    LinkClass classifyLink(Batch& batch, const Position& rx) const;
+
+    /**
+     * Classify links of one transmitter with many receivers at once
+     * \param tx transmitter position
+     * \param rxs receiver positions
+     * \param links link classes in order of receivers
+     */
+    void classifyLinks(const Position& tx, const std::vector<Position>& rxs, std::vector<LinkClass>& links) const;
+
+    /**
+     * Classify links of batch's transmitter with many receivers on a task scheduler
+     *
+     * Blockage tests run concurrently unless the link cache is enabled.
+     * Counters are updated in order of receivers, thus results equal classifyLink(batch, rx) calls.
+     * \param batch prepared batch
+     * \param rxs receiver positions within batch range
+     * \param links link classes in order of receivers
+     * \param scheduler runs blockage tests, tests run on calling thread if nullptr
+     */
+    void classifyLinks(Batch& batch, const std::vector<Position>& rxs, std::vector<LinkClass>& links, TaskScheduler* scheduler) const;
+
 private:
+    // blockage of a tx/rx pair, building and foliage results stay valid while neither end moves much
+    struct CacheEntry
+    {
+        Position tx;
+        Position rx;
+        omnetpp::SimTime used;
+        bool staticValid = false;
+        bool building = false;
+        bool foliage = false;
+        bool vehicle = false;
+        unsigned long vehicleRevision = 0;
+    };
+
+    struct TransmitterCache
+    {
+        std::unordered_multimap<std::uint64_t, CacheEntry> entries; // by grid cell of rx position
+        omnetpp::SimTime purged;
+    };
+
+    void gather(Batch&) const;
+    LinkClass testLink(const Batch&, const Position& rx) const;
+    LinkClass classifyCached(Batch&, const Position& rx) const;
+    CacheEntry& lookupCache(int transmitter, const Position& tx, const Position& rx) const;
+    std::uint64_t cacheCell(const Position&, int dx = 0, int dy = 0) const;
+    LinkClass countLink(LinkClass) const;
+
     const ObstacleIndex* mObstacleIndex;
     const ObstacleIndex* mFoliageIndex;
     const VehicleIndex* mVehicleIndex;
@@ -39,6 +130,10 @@ private:
     mutable unsigned mCountNLOSb = 0;
     mutable unsigned mCountNLOSf = 0;
     mutable unsigned mCountNLOSv = 0;
+
+    double mCacheDistance = 0.0; // zero disables link cache
+    mutable std::unordered_map<int, TransmitterCache> mCache;
+    mutable unsigned mCountCacheHits = 0;
 };
 
 } // namespace gemv2
@@ -41,18 +41,6 @@ double squaredLength(const Position& a, const Position& b)
     return squared(a.x.value() - b.x.value()) + squared(a.y.value() - b.y.value());
 }
 
-Position reflectPoint(const Position& p, const PositionSegment& line)
-{
-    double dx = bg::get<1, 0>(line) - bg::get<0, 0>(line);
-    double dy = bg::get<1, 1>(line) - bg::get<0, 1>(line);
-    double a = (dx * dx - dy * dy) / (dx * dx + dy * dy);
-    double b = 2.0 * dx * dy / (dx * dx + dy * dy);
-    Position q;
-    q.x = a * (p.x - line.first.x) + b * (p.y - line.first.y) + line.first.x;
-    q.y = b * (p.x - line.first.x) - a * (p.y - line.first.y) + line.first.y;
-    return q;
-}
-
 inet::m getWaveLength(const inet::physicallayer::ITransmission* transmission)
 {
     auto radioMedium = transmission->getTransmitter()->getMedium();
@@ -88,6 +76,9 @@ void NLOSb::initialize()
     }
 
     mVisualizer = inet::findModuleFromPar<Visualizer>(par("visualizerModule"), this, false);
+    if (mVisualizer && !mVisualizer->isActive()) {
+        mVisualizer = nullptr; // nothing to show without GUI
+    }
 }
 
 NLOSb::NLOSb() :
@@ -110,15 +101,16 @@ double NLOSb::computePathLoss(const phy::ITransmission* transmission, const phy:
 {
     const Environment env(this, transmission->getStartPosition(), arrival->getStartPosition(), getWaveLength(transmission));
     const inet::m distRxTx { transmission->getStartPosition().distance(arrival->getStartPosition()) };
+    Buffers& buffers = getBuffers();
 
-    std::vector<Position> reflBuildings = computeReflectionRaysFromBuildings(env);
-    std::vector<Attenuation> attReflBuildings = computeReflectionAttenuation(reflBuildings, obsReflRelPerm, env);
+    computeReflectionRaysFromBuildings(env, buffers.reflectionsBuildings);
+    std::vector<Attenuation> attReflBuildings = computeReflectionAttenuation(buffers.reflectionsBuildings, obsReflRelPerm, env);
 
-    std::vector<Position> reflVehicles = computeReflectionRaysFromVehicles(env);
-    std::vector<Attenuation> attReflVehicles = computeReflectionAttenuation(reflVehicles, vehReflRelPerm, env);
+    computeReflectionRaysFromVehicles(env, buffers.reflectionsVehicles);
+    std::vector<Attenuation> attReflVehicles = computeReflectionAttenuation(buffers.reflectionsVehicles, vehReflRelPerm, env);
 
     if (mVisualizer) {
-        mVisualizer->drawReflectionRays(env.tx, env.rx, reflBuildings, reflVehicles);
+        mVisualizer->drawReflectionRays(env.tx, env.rx, buffers.reflectionsBuildings, buffers.reflectionsVehicles);
     }
 
     // shortest reflection ray is upper bound for feasible diffraction rays
@@ -136,8 +128,8 @@ double NLOSb::computePathLoss(const phy::ITransmission* transmission, const phy:
         }
     }
 
-    auto diffractions = computeDiffractionRays(env);
-    auto attenuations = computeDiffractionAttenuation(diffractions, limit, env);
+    computeDiffractionRays(env, buffers.diffractions);
+    auto attenuations = computeDiffractionAttenuation(buffers.diffractions, limit, env);
     attenuations.reserve(attenuations.size() + attReflBuildings.size() + attReflVehicles.size());
     attenuations.insert(attenuations.end(), attReflBuildings.begin(), attReflBuildings.end());
     attenuations.insert(attenuations.end(), attReflVehicles.begin(), attReflVehicles.end());
@@ -147,80 +139,95 @@ double NLOSb::computePathLoss(const phy::ITransmission* transmission, const phy:
     return std::max(refldif, logdist);
 }
 
-std::vector<Position> NLOSb::computeReflectionRaysFromBuildings(const Environment& env) const
+NLOSb::Buffers& NLOSb::getBuffers()
 {
-    std::vector<Position> rays;
-    std::vector<Position> intersections;
-    const double squaredLengthTxRx = squaredLength(env.tx, env.rx);
+    // path losses of several receivers may be computed concurrently
+    static thread_local Buffers buffers;
+    return buffers;
+}
 
+void NLOSb::computeReflectionRaysFromBuildings(const Environment& env, std::vector<Position>& rays) const
+{
+    ReflectionEdges& edges = getBuffers().buildingEdges;
+    edges.clear();
     for (const ObstacleIndex::Obstacle* obstacle : env.obstacles)
     {
-        const PositionRange& outline = obstacle->getOutline();
-        if (outline.size() < 2) continue;
-
-        PositionView view(outline);
-        for (auto a = view.begin(), b = std::next(a); b != view.end(); ++a, ++b)
-        {
-            PositionSegment segment(*a, *b);
-
-            // calculate mirror point Rx' of Rx w.r.t. segment
-            Position rx_m = reflectPoint(env.rx, segment);
-
-            // no valid reflection possible if d(Tx, Rx) > d(Tx, Rx')
-            if (squaredLengthTxRx > squaredLength(env.tx, rx_m)) {
-                // skip segment because Tx and Rx are on opposite sides of segment
-                continue;
-            }
-
-            // intersection between ray TxRx' and segment is reflection point
-            PositionSegment ray(env.tx, rx_m);
-            bg::intersection(segment, ray, intersections);
-            if (intersections.size() == 1 && !isRayObstructed(intersections[0], env)) {
-                rays.emplace_back(intersections[0]);
-            }
-            intersections.clear();
-        }
+        edges.add(obstacle->getOutline());
     }
 
-    return rays;
+    rays.clear();
+    computeReflectionPoints(edges, env, rays);
 }
 
-std::vector<Position> NLOSb::computeReflectionRaysFromVehicles(const Environment& env) const
+void NLOSb::computeReflectionRaysFromVehicles(const Environment& env, std::vector<Position>& rays) const
 {
-    std::vector<Position> rays;
-    std::vector<Position> intersections;
-    const double squaredLengthTxRx = squaredLength(env.tx, env.rx);
-
+    ReflectionEdges& edges = getBuffers().vehicleEdges;
+    edges.clear();
     for (const VehicleIndex::Vehicle* vehicle : env.vehicles)
     {
-        const PositionRange& outline = vehicle->getOutline();
-        if (outline.size() < 2) continue;
+        edges.add(vehicle->getOutline());
+    }
 
-        PositionView view(outline);
-        for (auto a = view.begin(), b = std::next(a); b != view.end(); ++a, ++b)
-        {
-            PositionSegment segment(*a, *b);
+    rays.clear();
+    computeReflectionPoints(edges, env, rays);
+}
 
-            // calculate mirror point Rx' of Rx w.r.t. segment
-            Position rx_m = reflectPoint(env.rx, segment);
+void NLOSb::computeReflectionPoints(ReflectionEdges& edges, const Environment& env, std::vector<Position>& rays) const
+{
+    const std::size_t count = edges.size();
+    edges.param.resize(count);
+    edges.hit.resize(count);
+
+    const double tx = env.tx.x.value();
+    const double ty = env.tx.y.value();
+    const double rx = env.rx.x.value();
+    const double ry = env.rx.y.value();
+    const double squaredLengthTxRx = squaredLength(env.tx, env.rx);
 
-            // no valid reflection possible if d(Tx, Rx) > d(Tx, Rx')
-            if (squaredLengthTxRx > squaredLength(env.tx, rx_m)) {
-                // skip segment because Tx and Rx are on opposite sides of segment
-                continue;
-            }
+    // no branches in this loop to allow its auto-vectorization
+    for (std::size_t e = 0; e < count; ++e)
+    {
+        const double px = edges.px[e];
+        const double py = edges.py[e];
+        const double dx = edges.qx[e] - px;
+        const double dy = edges.qy[e] - py;
+
+        // calculate mirror point Rx' of Rx w.r.t. edge
+        const double a = (dx * dx - dy * dy) / (dx * dx + dy * dy);
+        const double b = 2.0 * dx * dy / (dx * dx + dy * dy);
+        const double mx = a * (rx - px) + b * (ry - py) + px;
+        const double my = b * (rx - px) - a * (ry - py) + py;
+
+        // ray Tx-Rx' and edge intersect at P + t * (Q - P) = Tx + u * (Rx' - Tx)
+        const double sx = mx - tx;
+        const double sy = my - ty;
+        const double wx = tx - px;
+        const double wy = ty - py;
+        const double denom = dx * sy - dy * sx;
+        const double t = (wx * sy - wy * sx) / denom;
+        const double u = (wx * dy - wy * dx) / denom;
+
+        // no valid reflection possible if d(Tx, Rx) > d(Tx, Rx'), i.e. Tx and Rx are on opposite sides of edge
+        const bool sameSide = squaredLengthTxRx <= sx * sx + sy * sy;
+        // parallel (and degenerated) edges yield no single intersection point
+        const bool single = denom != 0.0;
+        edges.param[e] = t;
+        edges.hit[e] = sameSide & single & (t >= 0.0) & (t <= 1.0) & (u >= 0.0) & (u <= 1.0);
+    }
 
-            // intersection between ray TxRx' and segment is reflection point
-            PositionSegment ray(env.tx, rx_m);
-            bg::intersection(segment, ray, intersections);
-            if (intersections.size() == 1 && !isRayObstructed(intersections[0], env)) {
-                rays.emplace_back(intersections[0]);
+    for (std::size_t e = 0; e < count; ++e)
+    {
+        if (edges.hit[e]) {
+            // intersection between ray TxRx' and edge is reflection point
+            const double t = edges.param[e];
+            const Position point {
+                edges.px[e] + t * (edges.qx[e] - edges.px[e]),
+                edges.py[e] + t * (edges.qy[e] - edges.py[e]) };
+            if (!isRayObstructed(point, env)) {
+                rays.emplace_back(point);
             }
-            intersections.clear();
         }
     }
-
-    return rays;
 }
 
 bool NLOSb::isRayObstructed(const Position& point, const Environment& env) const
@@ -249,26 +256,44 @@ bool NLOSb::isRayObstructed(const Position& point, const Environment& env) const
     return false;
 }
 
-std::vector<Position> NLOSb::computeDiffractionRays(const Environment& env) const
+void NLOSb::computeDiffractionRays(const Environment& env, std::vector<Position>& corners) const
 {
-    std::vector<Position> corners;
+    corners.clear();
     const double minVehicleHeight = std::min(env.txHeight.value(), env.rxHeight.value());
 
     auto obstacles = mObstacleIndex->getObstructingObstacles(env.tx, env.rx);
+    if (obstacles.empty()) {
+        if (mVisualizer) {
+            mVisualizer->drawDiffractionRays(env.tx, env.rx, corners);
+        }
+        return;
+    }
+
+    // all lines of sight via corners are covered by envelope of Tx, Rx and obstructing obstacles
+    geometry::Box box;
+    bg::envelope(PositionSegment { env.tx, env.rx }, box);
+    for (auto& obstacle : obstacles)
+    {
+        bg::expand(box, bg::return_envelope<geometry::Box>(obstacle->getOutline()));
+    }
+    Buffers& buffers = getBuffers();
+    mObstacleIndex->gatherCandidates(box, buffers.obstacleCandidates);
+    mVehicleIndex->gatherCandidates(box, buffers.vehicleCandidates);
+
     for (auto& obstacle : obstacles)
     {
         for (auto& corner : obstacle->getOutline())
         {
-            if (mObstacleIndex->anyBlockage(env.tx, corner)) {
+            if (mObstacleIndex->anyBlockage(buffers.obstacleCandidates, env.tx, corner)) {
                 // TxC is blocked by a building
                 continue;
-            } else if (mObstacleIndex->anyBlockage(corner, env.rx)) {
+            } else if (mObstacleIndex->anyBlockage(buffers.obstacleCandidates, corner, env.rx)) {
                 // CRx is blocked by a building
                 continue;
-            } else if (mVehicleIndex->anyBlockage(env.tx, corner, minVehicleHeight)) {
+            } else if (mVehicleIndex->anyBlockage(buffers.vehicleCandidates, env.tx, corner, minVehicleHeight)) {
                 // TxC is blocked by a tall enough vehicle
                 continue;
-            } else if (mVehicleIndex->anyBlockage(corner, env.rx, minVehicleHeight)) {
+            } else if (mVehicleIndex->anyBlockage(buffers.vehicleCandidates, corner, env.rx, minVehicleHeight)) {
                 // CRx is blocked by a tall enough vehicle
                 continue;
             }
@@ -280,8 +305,6 @@ std::vector<Position> NLOSb::computeDiffractionRays(const Environment& env) cons
     if (mVisualizer) {
         mVisualizer->drawDiffractionRays(env.tx, env.rx, corners);
     }
-
-    return corners;
 }
 
 std::vector<NLOSb::Attenuation> NLOSb::computeDiffractionAttenuation(const std::vector<Position>& corners, Length limit, const Environment& env) const
@@ -466,6 +489,28 @@ NLOSb::Environment::Environment(const NLOSb* model, const inet::Coord& itx, cons
 {
 }
 
+void NLOSb::ReflectionEdges::clear()
+{
+    px.clear();
+    py.clear();
+    qx.clear();
+    qy.clear();
+}
+
+void NLOSb::ReflectionEdges::add(const std::vector<Position>& outline)
+{
+    if (outline.size() < 2) return;
+
+    PositionView view(outline);
+    for (auto a = view.begin(), b = std::next(a); b != view.end(); ++a, ++b)
+    {
+        px.push_back(a->x.value());
+        py.push_back(a->y.value());
+        qx.push_back(b->x.value());
+        qy.push_back(b->y.value());
+    }
+}
+
 NLOSb::Attenuation::Attenuation(Length len, double att) :
     length(len), fraction(att)
 {
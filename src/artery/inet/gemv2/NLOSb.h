@@ -7,6 +7,7 @@
 #ifndef ARTERY_GEMV2_NLOSB_H_NV3WEACB
 #define ARTERY_GEMV2_NLOSB_H_NV3WEACB
 
+#include "artery/inet/gemv2/BlockageCandidates.h"
 #include "artery/inet/gemv2/ObstacleIndex.h"
 #include "artery/inet/gemv2/VehicleIndex.h"
 #include <inet/common/ModuleAccess.h>
@@ -65,26 +66,82 @@ protected:
     };
     friend struct Environment;
 
+    /**
+     * ReflectionEdges packs the outline edges of all reflecting surfaces of one query into flat arrays.
+     * Per-edge results of the reflection kernel are kept alongside, so all buffers are reused across queries.
+     */
+    struct ReflectionEdges
+    {
+        void clear();
+
+        /**
+         * Add all edges of an outline including its closing edge
+         * \param outline polygon points, outlines with less than two points are ignored
+         */
+        void add(const std::vector<Position>& outline);
+
+        std::size_t size() const { return px.size(); }
+
+        // edge e goes from (px[e], py[e]) to (qx[e], qy[e])
+        std::vector<double> px;
+        std::vector<double> py;
+        std::vector<double> qx;
+        std::vector<double> qy;
+        // kernel results: relative position of reflection point along edge e if hit[e] is set
+        std::vector<double> param;
+        std::vector<unsigned char> hit;
+    };
+
+    /**
+     * Buffers reused by all computePathLoss calls of one thread
+     */
+    struct Buffers
+    {
+        ReflectionEdges buildingEdges;
+        ReflectionEdges vehicleEdges;
+        std::vector<Position> reflectionsBuildings;
+        std::vector<Position> reflectionsVehicles;
+        std::vector<Position> diffractions;
+        BlockageCandidates obstacleCandidates;
+        BlockageCandidates vehicleCandidates;
+    };
+
+    /**
+     * Get buffers of calling thread
+     */
+    static Buffers& getBuffers();
+
     /**
      * Compute reflection rays based on single interaction with builidings
      * \param env NLOSb environment
-     * \return points at buildings where signal (env) can be reflected without obstruction
+     * \param rays cleared and filled with points at buildings where signal (env) can be reflected without obstruction
      */
-    virtual std::vector<Position> computeReflectionRaysFromBuildings(const Environment& env) const;
+    virtual void computeReflectionRaysFromBuildings(const Environment& env, std::vector<Position>& rays) const;
 
     /**
      * Compute reflection rays based on single interaction with vehicles
      * \param env NLOSb environment
-     * \return points at vehicles where signal (env) can be reflected without obstruction
+     * \param rays cleared and filled with points at vehicles where signal (env) can be reflected without obstruction
+     */
+    virtual void computeReflectionRaysFromVehicles(const Environment& env, std::vector<Position>& rays) const;
+
+    /**
+     * Compute unobstructed reflection points at packed edges
+     *
+     * Mirror images of Rx and intersections of rays Tx-Rx' with edges are computed for all edges
+     * by a single branch-free loop, only edges hit by their ray are checked for obstruction afterwards.
+     * \param edges packed edges of reflecting surfaces, kernel results are stored there as well
+     * \param env NLOSb environment
+     * \param rays filled with reflection points in order of edges
      */
-    virtual std::vector<Position> computeReflectionRaysFromVehicles(const Environment& env) const;
+    void computeReflectionPoints(ReflectionEdges& edges, const Environment& env, std::vector<Position>& rays) const;
 
     /**
      * Compute diffraction rays based on single interaction with corners of buildings
      * \param env NLOSb environment
-     * \return corners of buildings where diffraction without obstruction can happen
+     * \param corners cleared and filled with corners of buildings where diffraction without obstruction can happen
      */
-    virtual std::vector<Position> computeDiffractionRays(const Environment& env) const;
+    virtual void computeDiffractionRays(const Environment& env, std::vector<Position>& corners) const;
 
     /**
      * Check if a given ray is obstructed by any building or vehicle
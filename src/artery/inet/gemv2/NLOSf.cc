@@ -36,6 +36,9 @@ void NLOSf::initialize(int stage)
     if (stage == INITSTAGE_LOCAL) {
         mFoliageIndex = inet::findModuleFromPar<ObstacleIndex>(par("foliageIndexModule"), this);
         mVisualizer = inet::findModuleFromPar<Visualizer>(par("visualizerModule"), this, false);
+        if (mVisualizer && !mVisualizer->isActive()) {
+            mVisualizer = nullptr; // nothing to show without GUI
+        }
     }
 }
 
@@ -10,6 +10,8 @@
 #include <inet/common/ModuleAccess.h>
 #include <inet/common/Units.h>
 #include <inet/physicallayer/contract/packetlevel/IRadioMedium.h>
+#include <boost/container/small_vector.hpp>
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <vector>
@@ -28,9 +30,14 @@ namespace {
 auto compareDistance = [](const DiffractionObstacle& a, const DiffractionObstacle& b) { return a.d < b.d; };
 auto compareHeight = [](const DiffractionObstacle& a, const DiffractionObstacle& b) { return a.h < b.h; };
 
-using ObstacleIterator = std::list<DiffractionObstacle>::const_iterator;
+template<typename ObstacleIterator>
 ObstacleIterator findMainObstacle(ObstacleIterator, ObstacleIterator);
+template<typename ObstacleIterator>
 ObstacleIterator findSecondaryObstacle(ObstacleIterator, ObstacleIterator);
+template<typename Vehicles, typename Sink>
+void collectTopObstacles(const Vehicles&, const Coord& tx, const Coord& rx, Sink);
+template<typename Vehicles, typename LeftSink, typename RightSink>
+void collectSideObstacles(const Vehicles&, const Coord& tx, const Coord& rx, LeftSink, RightSink);
 } // namespace
 
 DiffractionObstacle::DiffractionObstacle(meter distTx, meter height) :
@@ -44,13 +51,14 @@ DiffractionPath::DiffractionPath() :
 }
 
 NLOSv::NLOSv() :
-    mVehicleIndex(nullptr)
+    mVehicleIndex(nullptr), mFresnelPruning(false)
 {
 }
 
 void NLOSv::initialize()
 {
     mVehicleIndex = inet::findModuleFromPar<VehicleIndex>(par("vehicleIndexModule"), this);
+    mFresnelPruning = par("fresnelPruning");
 }
 
 double NLOSv::computePathLoss(const phy::ITransmission* transmission, const phy::IArrival* arrival) const
@@ -67,7 +75,11 @@ double NLOSv::computePathLoss(const phy::ITransmission* transmission, const phy:
         // free space loss
         loss = static_cast<inet::unit>(squared(waveLength) / (16.0 * squared(M_PI) * squared(distance))).get();
         // and additional attenuation by vehicles
-        loss *= computeVehiclePathLoss(transmission->getStartPosition(), arrival->getStartPosition(), waveLength);
+        if (mFresnelPruning) {
+            loss *= computePrunedVehiclePathLoss(transmission->getStartPosition(), arrival->getStartPosition(), waveLength);
+        } else {
+            loss *= computeVehiclePathLoss(transmission->getStartPosition(), arrival->getStartPosition(), waveLength);
+        }
     }
     ASSERT(loss >= 0.0 && loss <= 1.0);
     return loss;
@@ -108,6 +120,84 @@ double NLOSv::computeVehiclePathLoss(const Coord& pos_tx, const Coord& pos_rx, m
     return combineDiffractionLoss(paths, lambda);
 }
 
+double NLOSv::computePrunedVehiclePathLoss(const Coord& pos_tx, const Coord& pos_rx, m lambda) const
+{
+    const double vx = pos_rx.x - pos_tx.x;
+    const double vy = pos_rx.y - pos_tx.y;
+    const double vl2 = squared(vx) + squared(vy);
+    const double vl = sqrt(vl2); /*< ground distance! */
+    const double wavelength = lambda.get();
+
+    // same knife-edge parameter as computeSimpleKnifeEdge for a vehicle on the Tx-Rx line
+    unsigned pruned = 0;
+    auto fresnelClearance = [&](const VehicleIndex::Vehicle& vehicle) {
+        const Position& midpoint = vehicle.getMidpoint();
+        const double k = ((midpoint.x.value() - pos_tx.x) * vx + (midpoint.y.value() - pos_tx.y) * vy) / vl2;
+        if (k <= 0.0 || k >= 1.0) {
+            return true; /*< no top obstacle, but relevant for side paths */
+        }
+        const double distTxObs = k * vl;
+        const double h = vehicle.getHeight() - (pos_tx.z + k * (pos_rx.z - pos_tx.z));
+        const double r = sqrt(wavelength * distTxObs * (vl - distTxObs) / vl);
+        if (sqrt(2.0) * h / r <= -0.78) {
+            ++pruned;
+            return false;
+        }
+        return true;
+    };
+
+    PrunedVehicleList vehicles;
+    bool overflow = false;
+    mVehicleIndex->getObstructingVehicles(Position { pos_tx.x, pos_tx.y }, Position { pos_rx.x, pos_rx.y }, fresnelClearance,
+            [&](const VehicleIndex::Vehicle& vehicle) {
+                if (vehicles.size() < vehicles.capacity()) {
+                    vehicles.push_back(&vehicle);
+                } else {
+                    overflow = true;
+                }
+            });
+    if (overflow) {
+        return computeVehiclePathLoss(pos_tx, pos_rx, lambda);
+    }
+
+    const DiffractionObstacle Tx { meter(0.0), meter(pos_tx.z) };
+    const DiffractionObstacle Rx { meter(vl), meter(pos_rx.z) };
+    std::vector<DiffractionPath> paths;
+    paths.reserve(3);
+
+    PrunedObstacleList obsTop;
+    obsTop.push_back(Tx);
+    collectTopObstacles(vehicles, pos_tx, pos_rx, [&obsTop](const DiffractionObstacle& obs) { obsTop.push_back(obs); });
+    if (obsTop.size() > 1) {
+        std::stable_sort(std::next(obsTop.begin()), obsTop.end(), compareDistance);
+        obsTop.push_back(Rx);
+        paths.push_back(computeMultipleKnifeEdge(obsTop, lambda));
+    } else if (pruned > 0) {
+        // pruned vehicles leave zero knife-edge loss on top path, shadowing all other paths
+        return 1.0;
+    }
+
+    // zero "height" of Tx and Rx on side paths as in computeVehiclePathLoss
+    const DiffractionObstacle TxSide { meter(0.0), meter(0.0) };
+    const DiffractionObstacle RxSide { meter(vl), meter(0.0) };
+    PrunedObstacleList obsLeft;
+    PrunedObstacleList obsRight;
+    obsLeft.push_back(TxSide);
+    obsRight.push_back(TxSide);
+    collectSideObstacles(vehicles, pos_tx, pos_rx,
+            [&obsLeft](const DiffractionObstacle& obs) { obsLeft.push_back(obs); },
+            [&obsRight](const DiffractionObstacle& obs) { obsRight.push_back(obs); });
+    for (PrunedObstacleList* obsSide : { &obsLeft, &obsRight }) {
+        if (obsSide->size() > 1) {
+            std::stable_sort(std::next(obsSide->begin()), obsSide->end(), compareDistance);
+            obsSide->push_back(RxSide);
+            paths.push_back(computeMultipleKnifeEdge(*obsSide, lambda));
+        }
+    }
+
+    return paths.empty() ? 1.0 : combineDiffractionLoss(paths, lambda);
+}
+
 double NLOSv::computePathLoss(mps propagationSpeed, Hz frequency, m distance) const
 {
     return NaN;
@@ -153,11 +243,24 @@ double NLOSv::computeSimpleKnifeEdge(m heightTx, m heightRx, m heightObs, m dist
 
 DiffractionPath NLOSv::computeMultipleKnifeEdge(const std::list<DiffractionObstacle>& obs, m lambda) const
 {
+    return computeMultipleKnifeEdgeImpl(obs, lambda);
+}
+
+DiffractionPath NLOSv::computeMultipleKnifeEdge(const PrunedObstacleList& obs, m lambda) const
+{
+    return computeMultipleKnifeEdgeImpl(obs, lambda);
+}
+
+template<typename Obstacles>
+DiffractionPath NLOSv::computeMultipleKnifeEdgeImpl(const Obstacles& obs, m lambda) const
+{
+    using ObstacleIterator = typename Obstacles::const_iterator;
+    using ObstacleIterators = boost::container::small_vector<ObstacleIterator, maxPrunedVehicles + 2>;
     ASSERT(obs.size() > 2);
     DiffractionPath path;
 
     // determine main and secondary obstacles
-    std::vector<ObstacleIterator> mainObs;
+    ObstacleIterators mainObs;
     mainObs.push_back(obs.begin()); // Tx
     for (ObstacleIterator it = obs.begin(); it != obs.end();) {
         it = findMainObstacle(it, obs.end());
@@ -176,8 +279,8 @@ DiffractionPath NLOSv::computeMultipleKnifeEdge(const std::list<DiffractionObsta
         ObstacleIterator rx;
     };
 
-    std::vector<SecondaryObstacle> secObs;
-    std::vector<meter> mainObsDistances;
+    boost::container::small_vector<SecondaryObstacle, maxPrunedVehicles + 1> secObs;
+    boost::container::small_vector<meter, maxPrunedVehicles + 1> mainObsDistances;
     for (std::size_t i = 0, j = 1; j < mainObs.size(); ++i, ++j) {
         const meter d = mainObs[j]->d - mainObs[i]->d;
         path.d += sqrt(squared(d) + squared(mainObs[j]->h - mainObs[i]->h));
@@ -227,6 +330,44 @@ DiffractionPath NLOSv::computeMultipleKnifeEdge(const std::list<DiffractionObsta
 std::list<DiffractionObstacle> NLOSv::buildTopObstacles(const VehicleList& vehicles, const Coord& pos_tx, const Coord& pos_rx) const
 {
     std::list<DiffractionObstacle> diffTop;
+    collectTopObstacles(vehicles, pos_tx, pos_rx, [&diffTop](const DiffractionObstacle& obs) { diffTop.push_back(obs); });
+    diffTop.sort(compareDistance);
+    return diffTop;
+}
+
+NLOSv::SideObstacles NLOSv::buildSideObstacles(const VehicleList& vehicles, const Coord& pos_tx, const Coord& pos_rx) const
+{
+    std::list<DiffractionObstacle> diffOnRightSide;
+    std::list<DiffractionObstacle> diffOnLeftSide;
+    collectSideObstacles(vehicles, pos_tx, pos_rx,
+            [&diffOnLeftSide](const DiffractionObstacle& obs) { diffOnLeftSide.push_back(obs); },
+            [&diffOnRightSide](const DiffractionObstacle& obs) { diffOnRightSide.push_back(obs); });
+
+    diffOnLeftSide.sort(compareDistance);
+    diffOnRightSide.sort(compareDistance);
+    return SideObstacles { std::move(diffOnLeftSide), std::move(diffOnRightSide) };
+}
+
+double NLOSv::combineDiffractionLoss(const std::vector<DiffractionPath>& paths, m /* lambda */) const
+{
+    ASSERT(!paths.empty());
+
+    // use only smallest diffraction attenuation (maximum E-field)
+    double min_attenuation = std::numeric_limits<double>::infinity();
+    for (const DiffractionPath& path : paths) {
+        if (path.attenuation < min_attenuation) {
+            min_attenuation = path.attenuation;
+        }
+    }
+
+    return 1.0 / min_attenuation;
+}
+
+namespace {
+
+template<typename Vehicles, typename Sink>
+void collectTopObstacles(const Vehicles& vehicles, const Coord& pos_tx, const Coord& pos_rx, Sink sink)
+{
     const double vx = pos_rx.x - pos_tx.x;
     const double vy = pos_rx.y - pos_tx.y;
 
@@ -235,18 +376,13 @@ std::list<DiffractionObstacle> NLOSv::buildTopObstacles(const VehicleList& vehic
         const double k = (midpoint.x.value() * vx - vy * pos_tx.y + vy * midpoint.y.value() - pos_tx.x * vx) / (squared(vx) + squared(vy));
         if (k < 0.0 || k > 1.0) continue; /*< skip points beyond the ends of TxRx line segment */
         const double d = k * sqrt(squared(vx) + squared(vy));
-        diffTop.emplace_back(meter(d), meter(vehicle->getHeight()));
+        sink(DiffractionObstacle { meter(d), meter(vehicle->getHeight()) });
     }
-
-    diffTop.sort(compareDistance);
-    return diffTop;
 }
 
-NLOSv::SideObstacles NLOSv::buildSideObstacles(const VehicleList& vehicles, const Coord& pos_tx, const Coord& pos_rx) const
+template<typename Vehicles, typename LeftSink, typename RightSink>
+void collectSideObstacles(const Vehicles& vehicles, const Coord& pos_tx, const Coord& pos_rx, LeftSink left, RightSink right)
 {
-    std::list<DiffractionObstacle> diffOnRightSide;
-    std::list<DiffractionObstacle> diffOnLeftSide;
-
     //constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
     constexpr double Inf = std::numeric_limits<double>::infinity();
 
@@ -303,35 +439,15 @@ NLOSv::SideObstacles NLOSv::buildSideObstacles(const VehicleList& vehicles, cons
         }
 
         if (leftmost.l > -Inf) {
-            diffOnLeftSide.emplace_back(meter(leftmost.k * vl), meter(leftmost.l * vl));
+            left(DiffractionObstacle { meter(leftmost.k * vl), meter(leftmost.l * vl) });
         }
         if (rightmost.l < Inf) {
-            diffOnRightSide.emplace_back(meter(rightmost.k * vl), meter(-rightmost.l * vl));
-        }
-    }
-
-    diffOnLeftSide.sort(compareDistance);
-    diffOnRightSide.sort(compareDistance);
-    return SideObstacles { std::move(diffOnLeftSide), std::move(diffOnRightSide) };
-}
-
-double NLOSv::combineDiffractionLoss(const std::vector<DiffractionPath>& paths, m /* lambda */) const
-{
-    ASSERT(!paths.empty());
-
-    // use only smallest diffraction attenuation (maximum E-field)
-    double min_attenuation = std::numeric_limits<double>::infinity();
-    for (const DiffractionPath& path : paths) {
-        if (path.attenuation < min_attenuation) {
-            min_attenuation = path.attenuation;
+            right(DiffractionObstacle { meter(rightmost.k * vl), meter(-rightmost.l * vl) });
         }
     }
-
-    return 1.0 / min_attenuation;
 }
 
-namespace {
-
+template<typename ObstacleIterator>
 ObstacleIterator findMainObstacle(ObstacleIterator begin, ObstacleIterator end)
 {
     ObstacleIterator mainIterator = end;
@@ -350,6 +466,7 @@ ObstacleIterator findMainObstacle(ObstacleIterator begin, ObstacleIterator end)
     return mainIterator;
 }
 
+template<typename ObstacleIterator>
 ObstacleIterator findSecondaryObstacle(ObstacleIterator first, ObstacleIterator last)
 {
     ASSERT(std::distance(first, last) > 2);
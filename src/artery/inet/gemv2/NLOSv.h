@@ -5,6 +5,7 @@
 #include <inet/common/Units.h>
 #include <inet/physicallayer/contract/packetlevel/IPathLoss.h>
 #include <omnetpp/csimplemodule.h>
+#include <boost/container/static_vector.hpp>
 #include <list>
 
 namespace artery
@@ -42,6 +43,10 @@ public:
 protected:
     using VehicleList = std::vector<const VehicleIndex::Vehicle*>;
 
+    // fixed capacity containers used by computePrunedVehiclePathLoss
+    static constexpr std::size_t maxPrunedVehicles = 16;
+    using PrunedVehicleList = boost::container::static_vector<const VehicleIndex::Vehicle*, maxPrunedVehicles>;
+    using PrunedObstacleList = boost::container::static_vector<DiffractionObstacle, maxPrunedVehicles + 2>;
 
     struct SideObstacles {
         std::list<DiffractionObstacle> left;
@@ -49,13 +54,30 @@ protected:
     };
 
     virtual double computeVehiclePathLoss(const inet::Coord&, const inet::Coord&, inet::m lambda) const;
+
+    /**
+     * Compute attenuation by vehicles like computeVehiclePathLoss, but with pruned candidates
+     *
+     * Vehicles whose roof is so far below the Tx-Rx line that their knife-edge loss is zero,
+     * i.e. the first Fresnel zone is sufficiently clear, are skipped already while querying the vehicle index.
+     * Pruned vehicles neither contribute to the top nor to the side paths.
+     * Falls back to computeVehiclePathLoss if more than maxPrunedVehicles vehicles remain.
+     */
+    virtual double computePrunedVehiclePathLoss(const inet::Coord&, const inet::Coord&, inet::m lambda) const;
+
     virtual DiffractionPath computeMultipleKnifeEdge(const std::list<DiffractionObstacle>&, inet::m lambda) const;
+    virtual DiffractionPath computeMultipleKnifeEdge(const PrunedObstacleList&, inet::m lambda) const;
     virtual double computeSimpleKnifeEdge(inet::m heightTx, inet::m heightRx, inet::m heightObs, inet::m distTxRx, inet::m distTxObs, inet::m lambda) const;
     virtual std::list<DiffractionObstacle> buildTopObstacles(const VehicleList&, const inet::Coord& tx, const inet::Coord& rx) const;
     virtual SideObstacles buildSideObstacles(const VehicleList&, const inet::Coord& tx, const inet::Coord& rx) const;
     virtual double combineDiffractionLoss(const std::vector<DiffractionPath>&, inet::m lambda) const;
 
     const VehicleIndex* mVehicleIndex;
+    bool mFresnelPruning;
+
+private:
+    template<typename Obstacles>
+    DiffractionPath computeMultipleKnifeEdgeImpl(const Obstacles&, inet::m lambda) const;
 };
 
 } // namespace gemv2
@@ -7,6 +7,8 @@
 #include "artery/inet/gemv2/ObstacleIndex.h"
 #include "artery/inet/gemv2/Visualizer.h"
 #include "artery/traci/Cast.h"
+#include "artery/utility/ObstaclePreprocessor.h"
+#include "artery/utility/ObstacleRegistry.h"
 #include "traci/API.h"
 #include "traci/Core.h"
 #include <boost/algorithm/string.hpp>
@@ -53,7 +55,11 @@ void ObstacleIndex::initialize()
     const std::string filterTypes = par("filterTypes");
     boost::split(mFilterTypes, filterTypes, boost::is_any_of(" "));
 
+    mRegistry = inet::findModuleFromPar<ObstacleRegistry>(par("obstacleRegistryModule"), this, false);
     mVisualizer = inet::findModuleFromPar<Visualizer>(par("visualizerModule"), this, false);
+    if (mVisualizer && !mVisualizer->isActive()) {
+        mVisualizer = nullptr; // nothing to show without GUI
+    }
     mColor = cFigure::Color(par("obstacleColor"));
 }
 
@@ -62,53 +68,68 @@ void ObstacleIndex::receiveSignal(cComponent* source, simsignal_t signal, const
     Enter_Method_Silent();
     if (signal == traciInitSignal) {
         auto core = check_and_cast<traci::Core*>(source);
-        fetchObstacles(*core->getAPI());
+        if (mRegistry) {
+            fetchObstacles(*mRegistry, *core->getAPI());
+        } else {
+            fetchObstacles(*core->getAPI());
+        }
         if (mVisualizer) {
             mVisualizer->drawObstacles(this);
         }
     }
 }
 
-void ObstacleIndex::fetchObstacles(const traci::API& traci)
+void ObstacleIndex::fetchObstacles(traci::API& traci)
 {
-    const auto& polygons = traci.polygon;
     const traci::Boundary boundary { traci.simulation.getNetBoundary() };
     const bool require_filled = par("requireFilled");
     unsigned ignored = 0;
-    std::string shape_msg;
-    for (const std::string& id : polygons.getIDList()) {
-        if (!mFilterTypes.empty()) {
-            std::string type = polygons.getType(id);
-            auto found = mFilterTypes.find(type);
-            if (found == mFilterTypes.end()) {
-                EV_DEBUG << "ignore polygon " << id << " of type " << type << "\n";
-                // skip polygon because its type is not in our filter set
-                ++ignored;
-                continue;
-            }
+    auto filter = [&](const traci::API::Polygon& polygon) {
+        if (!mFilterTypes.empty() && mFilterTypes.find(polygon.type) == mFilterTypes.end()) {
+            EV_DEBUG << "ignore polygon " << polygon.id << " of type " << polygon.type << "\n";
+            // skip polygon because its type is not in our filter set
+            ++ignored;
+            return false;
         }
 
-        if (require_filled) {
-            if (!polygons.getFilled(id)) {
-                EV_DEBUG << "ignore unfilled polygon " << id << "\n";
-                ++ignored;
-                continue;
-            }
+        if (require_filled && !polygon.filled) {
+            EV_DEBUG << "ignore unfilled polygon " << polygon.id << "\n";
+            ++ignored;
+            return false;
         }
 
+        return true;
+    };
+
+    std::string shape_msg;
+    std::vector<ObstacleOutline> obstacles;
+    for (traci::API::Polygon& polygon : traci.getPolygons(traci.polygon.getIDList(), filter)) {
         std::vector<Position> shape;
-        for (const traci::TraCIPosition& point : polygons.getShape(id).value) {
+        for (const traci::TraCIPosition& point : polygon.shape.value) {
             bg::append(shape, traci::position_cast(boundary, point));
         }
 
         bg::correct(shape); // fixes issues such as reversed point order
         if (!bg::is_valid(shape, shape_msg)) {
-            EV_DEBUG << "ignore invalid polygon " << id << " (" << shape_msg << ")\n";
+            EV_DEBUG << "ignore invalid polygon " << polygon.id << " (" << shape_msg << ")\n";
             ++ignored;
             continue;
         }
 
-        mObstacles.emplace_back(std::move(shape));
+        obstacles.push_back(ObstacleOutline { std::move(polygon.id), std::move(polygon.type), std::move(shape) });
+    }
+
+    const ObstaclePreprocessor preprocessor {
+        par("simplificationTolerance").doubleValue(), par("mergeTouchingObstacles").boolValue()
+    };
+    if (preprocessor.isEnabled()) {
+        const ObstaclePreprocessor::Statistics stats = preprocessor.process(obstacles);
+        EV_INFO << "obstacle preprocessing: " << stats << "\n";
+        stats.recordScalars(*this);
+    }
+
+    for (ObstacleOutline& obstacle : obstacles) {
+        mObstacles.emplace_back(std::move(obstacle.outline));
     }
 
     struct rtree_value_maker
@@ -126,9 +147,33 @@ void ObstacleIndex::fetchObstacles(const traci::API& traci)
     EV_INFO << mObstacles.size() << " obstacles stored (" << ignored << " ignored)\n";
 }
 
+void ObstacleIndex::fetchObstacles(ObstacleRegistry& registry, traci::API& traci)
+{
+    registry.fetch(traci);
+
+    // keep registry order: its indices are used for segment queries
+    mObstacles.clear();
+    mObstacles.reserve(registry.getObstacles().size());
+    for (const ObstacleRegistry::Obstacle& obstacle : registry.getObstacles()) {
+        std::vector<Position> shape = obstacle.outline;
+        mObstacles.emplace_back(std::move(shape));
+    }
+    mObstacleRtree.clear();
+    EV_INFO << mObstacles.size() << " obstacles shared by registry\n";
+}
+
 bool ObstacleIndex::anyBlockage(const Position& a, const Position& b) const
 {
     const LineOfSight los { a, b };
+    if (mRegistry) {
+        bool blocked = false;
+        mRegistry->querySegment(a, b, [&](std::size_t candidate) {
+            blocked = bg::crosses(los, mObstacles[candidate].getOutline());
+            return !blocked;
+        });
+        return blocked;
+    }
+
     auto rtree_intersect = bg::index::intersects(los);
     return std::any_of(mObstacleRtree.qbegin(rtree_intersect), mObstacleRtree.qend(),
             [&](const RtreeValue& candidate) {
@@ -136,6 +181,29 @@ bool ObstacleIndex::anyBlockage(const Position& a, const Position& b) const
             });
 }
 
+bool ObstacleIndex::anyBlockage(const BlockageCandidates& candidates, const Position& a, const Position& b) const
+{
+    const LineOfSight los { a, b };
+    return candidates.any(a, b, [&](BlockageCandidates::Index candidate) {
+        return bg::crosses(los, mObstacles[candidate].getOutline());
+    });
+}
+
+void ObstacleIndex::gatherCandidates(const geometry::Box& box, BlockageCandidates& candidates) const
+{
+    candidates.clear();
+    if (mRegistry) {
+        mRegistry->queryEnvelopes(box, [&](std::size_t candidate) {
+            candidates.add(candidate, mObstacles[candidate].getOutline());
+        });
+    } else {
+        auto rtree_intersect = bg::index::intersects(box);
+        for (auto it = mObstacleRtree.qbegin(rtree_intersect); it != mObstacleRtree.qend(); ++it) {
+            candidates.add(it->second, mObstacles[it->second].getOutline());
+        }
+    }
+}
+
 std::vector<const ObstacleIndex::Obstacle*>
 ObstacleIndex::obstaclesEllipse(const Position& a, const Position& b, double r) const
 {
@@ -155,14 +223,22 @@ ObstacleIndex::obstaclesEllipse(const Position& a, const Position& b, double r)
         bg::set<bg::max_corner, 0>(ebb, fmax(a.x, b.x).value() + k); // right
         bg::set<bg::max_corner, 1>(ebb, fmax(a.y, b.y).value() + k); // bottom
 
-        auto rtree_intersect = bg::index::intersects(ebb);
-        for (auto it = mObstacleRtree.qbegin(rtree_intersect); it != mObstacleRtree.qend(); ++it) {
-            const Obstacle& obstacle = mObstacles[it->second];
+        auto visit = [&](std::size_t index) {
+            const Obstacle& obstacle = mObstacles[index];
             const Position& c = obstacle.getCentroid();
             if (bg::distance(a, c) + bg::distance(b, c) <= r) {
                 // obstacle's center is within ellipse
                 obstacles.push_back(&obstacle);
             }
+        };
+
+        if (mRegistry) {
+            mRegistry->queryEnvelopes(ebb, visit);
+        } else {
+            auto rtree_intersect = bg::index::intersects(ebb);
+            for (auto it = mObstacleRtree.qbegin(rtree_intersect); it != mObstacleRtree.qend(); ++it) {
+                visit(it->second);
+            }
         }
     }
 
@@ -174,6 +250,17 @@ ObstacleIndex::getObstructingObstacles(const Position& a, const Position& b) con
 {
     std::vector<const Obstacle*> result;
     const LineOfSight los { a, b };
+    if (mRegistry) {
+        mRegistry->querySegment(a, b, [&](std::size_t candidate) {
+            const Obstacle& obstacle = mObstacles[candidate];
+            if (bg::crosses(los, obstacle.getOutline())) {
+                result.push_back(&obstacle);
+            }
+            return true;
+        });
+        return result;
+    }
+
     auto rtree_intersect = bg::index::intersects(los);
     for (auto it = mObstacleRtree.qbegin(rtree_intersect); it != mObstacleRtree.qend(); ++it) {
         const Obstacle& obstacle = mObstacles[it->second];
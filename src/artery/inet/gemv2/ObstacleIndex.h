@@ -7,6 +7,7 @@
 #ifndef OBSTACLEINDEX_H_WKZBN6QH
 #define OBSTACLEINDEX_H_WKZBN6QH
 
+#include "artery/inet/gemv2/BlockageCandidates.h"
 #include "artery/utility/Geometry.h"
 #include <boost/geometry/index/rtree.hpp>
 #include <omnetpp/ccanvas.h>
@@ -21,6 +22,9 @@ namespace traci { class API; }
 
 namespace artery
 {
+
+class ObstacleRegistry;
+
 namespace gemv2
 {
 
@@ -51,6 +55,19 @@ public:
 
     bool anyBlockage(const Position& a, const Position& b) const;
 
+    /**
+     * Check for blockage among previously gathered candidates, same result as anyBlockage(a, b)
+     * \param candidates gathered by gatherCandidates for a box covering segment a-b
+     */
+    bool anyBlockage(const BlockageCandidates& candidates, const Position& a, const Position& b) const;
+
+    /**
+     * Gather all obstacles whose envelope intersects a box
+     * \param box e.g. covering all lines of sight of a transmitter
+     * \param candidates cleared and filled with obstacles
+     */
+    void gatherCandidates(const geometry::Box& box, BlockageCandidates& candidates) const;
+
     /**
      * Get obstacles with their center point being within the defined ellipse.
      *
@@ -82,7 +99,8 @@ public:
     omnetpp::cFigure::Color getColor() const { return mColor; }
 
 private:
-    void fetchObstacles(const traci::API&);
+    void fetchObstacles(traci::API&);
+    void fetchObstacles(ObstacleRegistry&, traci::API&);
 
     using RtreeValue = std::pair<geometry::Box, std::size_t>;
     using Rtree = boost::geometry::index::rtree<RtreeValue, boost::geometry::index::rstar<16>>;
@@ -90,6 +108,7 @@ private:
     std::set<std::string> mFilterTypes;
     std::vector<Obstacle> mObstacles;
     Rtree mObstacleRtree;
+    ObstacleRegistry* mRegistry = nullptr;
     Visualizer* mVisualizer = nullptr;
     omnetpp::cFigure::Color mColor;
 };
@@ -7,9 +7,18 @@
 #include "artery/inet/gemv2/LinkClassifier.h"
 #include "artery/inet/gemv2/PathLoss.h"
 #include "artery/inet/gemv2/SmallScaleVariation.h"
+#include "artery/inet/gemv2/VehicleIndex.h"
+#include "artery/inet/gemv2/Visualizer.h"
 #include "artery/utility/Geometry.h"
+#include "artery/utility/TaskScheduler.h"
+#include <inet/common/ModuleAccess.h>
+#include <inet/physicallayer/contract/packetlevel/ICommunicationCache.h>
+#include <inet/physicallayer/contract/packetlevel/IRadio.h>
+#include <inet/physicallayer/contract/packetlevel/IRadioMedium.h>
 #include <omnetpp/checkandcast.h>
 #include <omnetpp/cexception.h>
+#include <omnetpp/csimulation.h>
+#include <algorithm>
 
 namespace artery
 {
@@ -21,10 +30,34 @@ Define_Module(PathLoss)
 using namespace inet;
 namespace phy = inet::physicallayer;
 
+namespace
+{
+
+// receivers per task, evaluating path loss models is costly enough for small tasks
+const std::size_t receiversPerTask = 4;
+
+const char* getLinkName(LinkClass link)
+{
+    switch (link) {
+        case LinkClass::LOS:
+            return "LOS";
+        case LinkClass::NLOSb:
+            return "NLOSb";
+        case LinkClass::NLOSf:
+            return "NLOSf";
+        case LinkClass::NLOSv:
+            return "NLOSv";
+        default:
+            return "unknown";
+    }
+}
+
+} // namespace
+
 PathLoss::PathLoss() :
     m_los(nullptr), m_nlos_b(nullptr), m_nlos_f(nullptr), m_nlos_v(nullptr),
     m_classifier(nullptr), m_small_scale(nullptr),
-    m_range_los(NaN), m_range_nlos_b(NaN), m_range_nlos_f(NaN), m_range_nlos_v(NaN)
+    m_range_los(NaN), m_range_nlos_b(NaN), m_range_nlos_f(NaN), m_range_nlos_v(NaN), m_range_max(NaN)
 {
 }
 
@@ -40,6 +73,16 @@ void PathLoss::initialize()
     m_range_nlos_b = meter(par("rangeNLOSb"));
     m_range_nlos_f = meter(par("rangeNLOSf"));
     m_range_nlos_v = meter(par("rangeNLOSv"));
+    m_range_max = std::max({m_range_los, m_range_nlos_b, m_range_nlos_f, m_range_nlos_v});
+
+    m_task_scheduler = inet::findModuleFromPar<TaskScheduler>(par("taskSchedulerModule"), this, false);
+    if (m_task_scheduler && m_task_scheduler->getThreads() > 1) {
+        auto visualizer = dynamic_cast<Visualizer*>(getSubmodule("visualizer"));
+        if (visualizer && visualizer->isActive()) {
+            throw cRuntimeError("concurrent path loss computation cannot be combined with visualization");
+        }
+        m_vehicles = check_and_cast<VehicleIndex*>(getSubmodule("vehicles"));
+    }
 }
 
 double PathLoss::computePathLoss(const phy::ITransmission* transmission, const phy::IArrival* arrival) const
@@ -47,45 +90,129 @@ double PathLoss::computePathLoss(const phy::ITransmission* transmission, const p
     inet::Coord tx = transmission->getStartPosition();
     inet::Coord rx = arrival->getStartPosition();
 
-    LinkClass link = m_classifier->classifyLink(Position { tx.x, tx.y }, Position { rx.x, rx.y });
-    IPathLoss* model = nullptr;
+    // signal is lost beyond range of any link class
+    if (tx.distance(rx) > m_range_max.get()) {
+        return 0.0;
+    }
+
+    if (m_vehicles) {
+        // precomputed losses are valid as long as vehicles have not been updated
+        if (m_precomputed_transmission != transmission->getId() || m_precomputed_revision != m_vehicles->getRevision()) {
+            precompute(transmission);
+        }
+        auto found = m_precomputed.find(arrival);
+        if (found != m_precomputed.end()) {
+            return found->second;
+        }
+        // arrival has not been known when precomputing, compute its loss on its own
+    }
+
+    // vehicles do not move within an event, so one batch serves all arrivals of a transmission
+    const omnetpp::eventnumber_t event = omnetpp::getSimulation()->getEventNumber();
+    if (m_batch_transmission != transmission->getId() || m_batch_event != event) {
+        const int transmitter = transmission->getTransmitter()->getId();
+        m_classifier->prepareBatch(Position { tx.x, tx.y }, m_range_max.get(), m_batch, transmitter);
+        m_batch_transmission = transmission->getId();
+        m_batch_event = event;
+    }
+
+    LinkClass link = m_classifier->classifyLink(m_batch, Position { rx.x, rx.y });
     meter range { 0.0 };
+    IPathLoss* model = selectModel(link, range);
+    EV_DETAIL << getLinkName(link) << " propagation for " << *transmission << "\n";
+
+    // compare model's maximum range with actual distance
+    if (tx.distance(rx) > range.get()) {
+        return 0.0; // all signal power is lost
+    }
+
+    double loss = model->computePathLoss(transmission, arrival);
+    if (m_small_scale) {
+        loss *= m_small_scale->computeVariation(Position { tx.x, tx.y }, Position { rx.x, rx.y }, range, link);
+    }
+    return loss;
+}
+
+void PathLoss::precompute(const phy::ITransmission* transmission) const
+{
+    const inet::Coord tx = transmission->getStartPosition();
+    const Position txPos { tx.x, tx.y };
+    const phy::IRadio* transmitter = transmission->getTransmitter();
+    auto cache = const_cast<phy::ICommunicationCache*>(transmitter->getMedium()->getCommunicationCache());
+
+    // radio medium has created arrivals at all potential receivers when the transmission started
+    m_receivers.clear();
+    m_receiver_positions.clear();
+    cache->mapRadios([&](const phy::IRadio* radio) {
+        const phy::IArrival* arrival = radio != transmitter ? cache->getCachedArrival(radio, transmission) : nullptr;
+        if (arrival && tx.distance(arrival->getStartPosition()) <= m_range_max.get()) {
+            const inet::Coord rx = arrival->getStartPosition();
+            m_receivers.push_back(Receiver { arrival, false, 0.0, 0.0 });
+            m_receiver_positions.push_back(Position { rx.x, rx.y });
+        }
+    });
+
+    m_classifier->prepareBatch(txPos, m_range_max.get(), m_batch, transmitter->getId());
+    m_batch_transmission = transmission->getId();
+    m_batch_event = omnetpp::getSimulation()->getEventNumber();
+    m_classifier->classifyLinks(m_batch, m_receiver_positions, m_receiver_links, m_task_scheduler);
+
+    if (m_small_scale) {
+        m_small_scale->prepareConcurrent();
+    }
+
+    parallelFor(m_task_scheduler, m_receivers.size(), receiversPerTask, [&](std::size_t i) {
+        Receiver& receiver = m_receivers[i];
+        const LinkClass link = m_receiver_links[i];
+        meter range { 0.0 };
+        IPathLoss* model = selectModel(link, range);
+        receiver.reachable = tx.distance(receiver.arrival->getStartPosition()) <= range.get();
+        if (receiver.reachable) {
+            receiver.loss = model->computePathLoss(transmission, receiver.arrival);
+            if (m_small_scale) {
+                receiver.deviation = m_small_scale->computeDeviation(txPos, m_receiver_positions[i], range, link);
+            }
+        }
+    });
+
+    // random variates are drawn in order of receivers, i.e. independent of thread count
+    m_precomputed.clear();
+    for (std::size_t i = 0; i < m_receivers.size(); ++i) {
+        const Receiver& receiver = m_receivers[i];
+        EV_DETAIL << getLinkName(m_receiver_links[i]) << " propagation for " << *transmission << "\n";
+        double loss = 0.0; // all signal power is lost if out of range
+        if (receiver.reachable) {
+            loss = receiver.loss;
+            if (m_small_scale) {
+                loss *= m_small_scale->drawVariation(receiver.deviation);
+            }
+        }
+        m_precomputed.emplace(receiver.arrival, loss);
+    }
+
+    m_precomputed_transmission = transmission->getId();
+    m_precomputed_revision = m_vehicles->getRevision();
+}
+
+phy::IPathLoss* PathLoss::selectModel(LinkClass link, meter& range) const
+{
     switch (link)
     {
         case LinkClass::LOS:
-            model = m_los;
             range = m_range_los;
-            EV_DETAIL << "LOS propagation for " << *transmission << "\n";
-            break;
+            return m_los;
         case LinkClass::NLOSb:
-            model = m_nlos_b;
             range = m_range_nlos_b;
-            EV_DETAIL << "NLOSb propagation for " << *transmission << "\n";
-            break;
+            return m_nlos_b;
         case LinkClass::NLOSf:
-            model = m_nlos_f;
             range = m_range_nlos_f;
-            EV_DETAIL << "NLOSf propagation for " << *transmission << "\n";
-            break;
+            return m_nlos_f;
         case LinkClass::NLOSv:
-            model = m_nlos_v;
             range = m_range_nlos_v;
-            EV_DETAIL << "NLOSv propagation for " << *transmission << "\n";
-            break;
+            return m_nlos_v;
         default:
             throw cRuntimeError("invalid link classification");
     };
-
-    // compare model's maximum range with actual distance
-    if (tx.distance(rx) > range.get()) {
-        return 0.0; // all signal power is lost
-    }
-
-    double loss = model->computePathLoss(transmission, arrival);
-    if (m_small_scale) {
-        loss *= m_small_scale->computeVariation(Position { tx.x, tx.y }, Position { rx.x, rx.y }, range, link);
-    }
-    return loss;
 }
 
 double PathLoss::computePathLoss(mps, Hz, m) const
@@ -96,7 +223,8 @@ double PathLoss::computePathLoss(mps, Hz, m) const
 
 m PathLoss::computeRange(mps, Hz, double loss) const
 {
-    return std::max({m_range_los, m_range_nlos_b, m_range_nlos_v});
+    // INET's range filter relies on this: no link class may reach beyond
+    return m_range_max;
 }
 
 } // namespace gemv2
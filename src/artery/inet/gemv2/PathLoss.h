@@ -7,18 +7,25 @@
 #ifndef PATHLOSS_H_ZABKB47G
 #define PATHLOSS_H_ZABKB47G
 
+#include "artery/inet/gemv2/LinkClassifier.h"
+#include "artery/utility/Geometry.h"
 #include <inet/common/Units.h>
 #include <inet/physicallayer/contract/packetlevel/IPathLoss.h>
 #include <omnetpp/csimplemodule.h>
+#include <unordered_map>
+#include <vector>
 
 namespace artery
 {
+
+class TaskScheduler;
+
 namespace gemv2
 {
 
 // forward declarations
-class LinkClassifier;
 class SmallScaleVariation;
+class VehicleIndex;
 
 class PathLoss : public omnetpp::cSimpleModule, public inet::physicallayer::IPathLoss
 {
@@ -36,6 +43,30 @@ public:
 private:
     using meter = inet::m;
 
+    /**
+     * Select path loss model of a link class
+     * \param link link class
+     * \param range set to maximum range of selected model
+     * \return path loss model
+     */
+    inet::physicallayer::IPathLoss* selectModel(LinkClass link, meter& range) const;
+
+    /**
+     * Compute path losses of all receivers with an arrival of this transmission at once
+     *
+     * Link classification and path loss models are evaluated on the task scheduler's threads,
+     * small scale variations are drawn afterwards in order of receivers.
+     */
+    void precompute(const inet::physicallayer::ITransmission*) const;
+
+    struct Receiver
+    {
+        const inet::physicallayer::IArrival* arrival;
+        bool reachable;
+        double loss;
+        double deviation;
+    };
+
     inet::physicallayer::IPathLoss* m_los;
     inet::physicallayer::IPathLoss* m_nlos_b;
     inet::physicallayer::IPathLoss* m_nlos_f;
@@ -46,6 +77,22 @@ private:
     meter m_range_nlos_b;
     meter m_range_nlos_f;
     meter m_range_nlos_v;
+    meter m_range_max;
+
+    // links of a transmission are classified with candidates gathered once per event
+    mutable LinkClassifier::Batch m_batch;
+    mutable int m_batch_transmission = -1;
+    mutable omnetpp::eventnumber_t m_batch_event = -1;
+
+    // losses of the latest transmission's receivers precomputed concurrently (if vehicle index is set)
+    TaskScheduler* m_task_scheduler = nullptr;
+    const VehicleIndex* m_vehicles = nullptr;
+    mutable std::vector<Receiver> m_receivers;
+    mutable std::vector<Position> m_receiver_positions;
+    mutable std::vector<LinkClass> m_receiver_links;
+    mutable std::unordered_map<const inet::physicallayer::IArrival*, double> m_precomputed;
+    mutable int m_precomputed_transmission = -1;
+    mutable unsigned long m_precomputed_revision = 0;
 };
 
 } // namespace gemv2
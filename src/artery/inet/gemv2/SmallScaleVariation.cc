@@ -10,6 +10,8 @@
 #include <artery/inet/gemv2/VehicleIndex.h>
 #include <inet/common/INETMath.h>
 #include <inet/common/ModuleAccess.h>
+#include <boost/functional/hash.hpp>
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <numeric>
@@ -45,6 +47,12 @@ void SmallScaleVariation::initialize()
     mMaxObservedObstacleDensity = -std::numeric_limits<double>::infinity();
     WATCH(mMaxObservedVehicleDensity);
     WATCH(mMaxObservedObstacleDensity);
+
+    mDensityCellSize = par("densityCellSize");
+    mDensityCacheLimit = par("densityCacheLimit");
+    mObstacleAreas.clear();
+    mVehicleGridRevision = 0;
+    mVehicleGridValid = false;
 }
 
 void SmallScaleVariation::finish()
@@ -63,6 +71,28 @@ void SmallScaleVariation::finish()
 }
 
 double SmallScaleVariation::computeVariation(const Position& a, const Position& b, m range, LinkClass link) const
+{
+    return drawVariation(computeDeviation(a, b, range, link));
+}
+
+double SmallScaleVariation::computeVariation(const Position& a, const Position& b, m range, double minDev, double maxDev) const
+{
+    return drawVariation(computeDeviation(a, b, range, minDev, maxDev));
+}
+
+double SmallScaleVariation::drawVariation(double deviation) const
+{
+    return inet::math::dB2fraction(normal(0.0, deviation));
+}
+
+void SmallScaleVariation::prepareConcurrent() const
+{
+    if (mDensityCellSize > 0.0) {
+        updateVehicleGrid();
+    }
+}
+
+double SmallScaleVariation::computeDeviation(const Position& a, const Position& b, m range, LinkClass link) const
 {
     double minDev = 0.0;
     double maxDev = 0.0;
@@ -89,37 +119,110 @@ double SmallScaleVariation::computeVariation(const Position& a, const Position&
             break;
     }
 
-    return computeVariation(a, b, range, minDev, maxDev);
+    return computeDeviation(a, b, range, minDev, maxDev);
 }
 
-double SmallScaleVariation::computeVariation(const Position& a, const Position& b, m range, double minDev, double maxDev) const
+double SmallScaleVariation::computeDeviation(const Position& a, const Position& b, m range, double minDev, double maxDev) const
 {
-    using Obstacle = ObstacleIndex::Obstacle;
-    using Vehicle = VehicleIndex::Vehicle;
-    std::vector<const Obstacle*> obstacles = mObstacleIndex->obstaclesEllipse(a, b, range.get());
-    std::vector<const Vehicle*> vehicles = mVehicleIndex->vehiclesEllipse(a, b, range.get());
-
     // Calculate relative vehicle density: number of vehicles divided by squared effective range
-    const double relVehDensity = vehicles.size() / squared(range.get());
-    if (relVehDensity > mMaxObservedVehicleDensity) {
-        mMaxObservedVehicleDensity = relVehDensity;
-    }
+    const double relVehDensity = countVehicles(a, b, range) / squared(range.get());
 
     // Calculate relative obstacle density: area covered by obstacles divided by squared range
-    const double obsTotalArea = std::accumulate(obstacles.begin(), obstacles.end(), 0.0,
-            [](double accu, const Obstacle* obs) {
-                return accu + obs->getArea();
-            });
+    const double obsTotalArea = computeObstacleArea(a, b, range);
     const double relObsDensity = obsTotalArea / squared(range.get());
-    if (relObsDensity > mMaxObservedObstacleDensity) {
-        mMaxObservedObstacleDensity = relObsDensity;
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mMaxObservedVehicleDensity = std::max(mMaxObservedVehicleDensity, relVehDensity);
+        mMaxObservedObstacleDensity = std::max(mMaxObservedObstacleDensity, relObsDensity);
     }
 
     // Calculate the vehicle density coefficient and static density coefficient
     const double vehDensityCoeff = std::min(1.0, sqrt(relVehDensity / mMaxVehicleDensity));
     const double obsDensityCoeff = std::min(1.0, sqrt(relObsDensity / mMaxObstacleDensity));
-    const double deviation = minDev + 0.5 * (maxDev - minDev) * (vehDensityCoeff + obsDensityCoeff);
-    return inet::math::dB2fraction(normal(0.0, deviation));
+    return minDev + 0.5 * (maxDev - minDev) * (vehDensityCoeff + obsDensityCoeff);
+}
+
+double SmallScaleVariation::computeObstacleArea(const Position& a, const Position& b, m range) const
+{
+    using Obstacle = ObstacleIndex::Obstacle;
+    auto sumAreas = [this](const Position& a, const Position& b, double range) {
+        std::vector<const Obstacle*> obstacles = mObstacleIndex->obstaclesEllipse(a, b, range);
+        return std::accumulate(obstacles.begin(), obstacles.end(), 0.0,
+                [](double accu, const Obstacle* obs) {
+                    return accu + obs->getArea();
+                });
+    };
+
+    if (mDensityCellSize <= 0.0) {
+        return sumAreas(a, b, range.get());
+    }
+
+    // obstacles are static: area depends only on quantised foci, ellipse is symmetric w.r.t. its foci
+    DensityKey key { densityCell(a), densityCell(b), range.get() };
+    if (key.b < key.a) {
+        std::swap(key.a, key.b);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto found = mObstacleAreas.find(key);
+        if (found != mObstacleAreas.end()) {
+            return found->second;
+        }
+    }
+
+    // concurrent callers may compute the same area, the first one is kept
+    const double area = sumAreas(densityCellCentre(key.a), densityCellCentre(key.b), key.range);
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mObstacleAreas.size() >= mDensityCacheLimit) {
+        mObstacleAreas.clear();
+    }
+    mObstacleAreas.emplace(key, area);
+    return area;
+}
+
+std::size_t SmallScaleVariation::countVehicles(const Position& a, const Position& b, m range) const
+{
+    if (mDensityCellSize <= 0.0) {
+        return mVehicleIndex->vehiclesEllipse(a, b, range.get()).size();
+    }
+
+    updateVehicleGrid();
+    return mVehicleGrid.countEllipse(a, b, range.get());
+}
+
+void SmallScaleVariation::updateVehicleGrid() const
+{
+    // rebuild grid once per vehicle index update
+    if (!mVehicleGridValid || mVehicleGridRevision != mVehicleIndex->getRevision()) {
+        mVehicleGrid.rebuild(mVehicleIndex->getVehicles(), mDensityCellSize);
+        mVehicleGridRevision = mVehicleIndex->getRevision();
+        mVehicleGridValid = true;
+    }
+}
+
+std::uint64_t SmallScaleVariation::densityCell(const Position& pos) const
+{
+    const auto x = static_cast<std::int32_t>(std::floor(pos.x.value() / mDensityCellSize));
+    const auto y = static_cast<std::int32_t>(std::floor(pos.y.value() / mDensityCellSize));
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+}
+
+Position SmallScaleVariation::densityCellCentre(std::uint64_t cell) const
+{
+    const auto x = static_cast<std::int32_t>(static_cast<std::uint32_t>(cell >> 32));
+    const auto y = static_cast<std::int32_t>(static_cast<std::uint32_t>(cell));
+    return Position { (x + 0.5) * mDensityCellSize, (y + 0.5) * mDensityCellSize };
+}
+
+std::size_t SmallScaleVariation::DensityKeyHash::operator()(const DensityKey& key) const
+{
+    std::size_t seed = 0;
+    boost::hash_combine(seed, key.a);
+    boost::hash_combine(seed, key.b);
+    boost::hash_combine(seed, key.range);
+    return seed;
 }
 
 } // namespace gemv2
@@ -8,8 +8,12 @@
 #define SMALL_SCALE_H
 
 #include "artery/inet/gemv2/LinkClass.h"
+#include "artery/inet/gemv2/VehicleDensityGrid.h"
 #include "inet/common/Units.h"
 #include <omnetpp/csimplemodule.h>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
 
 
 // forward declaration
@@ -35,7 +39,54 @@ public:
    double computeVariation(const Position& a, const Position& b, m range, LinkClass link) const;
    double computeVariation(const Position& a, const Position& b, m range, double minSD, double maxSD) const;
 
+   /**
+    * Compute standard deviation of small scale variation without drawing a variate
+    *
+    * Concurrent calls are safe after prepareConcurrent() until vehicles are updated again.
+    * \return standard deviation in dB
+    */
+   double computeDeviation(const Position& a, const Position& b, m range, LinkClass link) const;
+
+   /**
+    * Draw small scale variation from module's RNG
+    * \param deviation standard deviation in dB
+    * \return variation as fraction
+    */
+   double drawVariation(double deviation) const;
+
+   /**
+    * Update shared state once so that subsequent computeDeviation calls can run concurrently
+    */
+   void prepareConcurrent() const;
+
 private:
+   /**
+    * Key of obstacle densities: quantised foci (in canonical order) and range
+    */
+   struct DensityKey
+   {
+      std::uint64_t a;
+      std::uint64_t b;
+      double range;
+
+      bool operator==(const DensityKey& other) const
+      {
+         return a == other.a && b == other.b && range == other.range;
+      }
+   };
+
+   struct DensityKeyHash
+   {
+      std::size_t operator()(const DensityKey& key) const;
+   };
+
+   double computeDeviation(const Position& a, const Position& b, m range, double minSD, double maxSD) const;
+   double computeObstacleArea(const Position& a, const Position& b, m range) const;
+   void updateVehicleGrid() const;
+   std::size_t countVehicles(const Position& a, const Position& b, m range) const;
+   std::uint64_t densityCell(const Position&) const;
+   Position densityCellCentre(std::uint64_t cell) const;
+
    const ObstacleIndex* mObstacleIndex;
    const VehicleIndex* mVehicleIndex;
 
@@ -55,6 +106,15 @@ private:
    double mMaxStdDevNLOSv;
    double mMaxStdDevNLOSb;
    double mMaxStdDevNLOSf;
+
+   // quantisation of obstacle and vehicle densities (exact ellipse queries if zero)
+   double mDensityCellSize;
+   std::size_t mDensityCacheLimit;
+   mutable std::unordered_map<DensityKey, double, DensityKeyHash> mObstacleAreas;
+   mutable VehicleDensityGrid mVehicleGrid;
+   mutable unsigned long mVehicleGridRevision;
+   mutable bool mVehicleGridValid;
+   mutable std::mutex mMutex; // guards observed densities and cached obstacle areas
 };
 
 } // namespace gemv2
@@ -0,0 +1,125 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/inet/gemv2/VehicleDensityGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace artery
+{
+namespace gemv2
+{
+
+void VehicleDensityGrid::rebuild(const VehicleIndex::VehicleSlots& vehicles, double cellSize)
+{
+    double minX = std::numeric_limits<double>::infinity();
+    double minY = minX;
+    double maxX = -minX;
+    double maxY = -minY;
+    for (const auto& vehicle : vehicles) {
+        if (vehicle) {
+            const Position& mid = vehicle->getMidpoint();
+            minX = std::min(minX, mid.x.value());
+            minY = std::min(minY, mid.y.value());
+            maxX = std::max(maxX, mid.x.value());
+            maxY = std::max(maxY, mid.y.value());
+        }
+    }
+
+    mCellSize = cellSize;
+    mPrefixSums.clear();
+    if (minX > maxX) {
+        // no vehicles at all
+        mColumns = 0;
+        mRows = 0;
+        return;
+    }
+
+    // grid is aligned to multiples of cell size, so cell centres do not depend on vehicle positions
+    mOriginX = std::floor(minX / cellSize) * cellSize;
+    mOriginY = std::floor(minY / cellSize) * cellSize;
+    mColumns = static_cast<int>(std::floor((maxX - mOriginX) / cellSize)) + 1;
+    mRows = static_cast<int>(std::floor((maxY - mOriginY) / cellSize)) + 1;
+    mPrefixSums.assign(static_cast<std::size_t>(mRows) * (mColumns + 1), 0);
+
+    for (const auto& vehicle : vehicles) {
+        if (vehicle) {
+            const Position& mid = vehicle->getMidpoint();
+            const int column = std::min(mColumns - 1, static_cast<int>((mid.x.value() - mOriginX) / cellSize));
+            const int row = std::min(mRows - 1, static_cast<int>((mid.y.value() - mOriginY) / cellSize));
+            ++mPrefixSums[row * (mColumns + 1) + column + 1];
+        }
+    }
+
+    for (int row = 0; row < mRows; ++row) {
+        std::size_t* sums = &mPrefixSums[row * (mColumns + 1)];
+        for (int column = 1; column <= mColumns; ++column) {
+            sums[column] += sums[column - 1];
+        }
+    }
+}
+
+std::size_t VehicleDensityGrid::countEllipse(const Position& a, const Position& b, double range) const
+{
+    const double ax = a.x.value();
+    const double ay = a.y.value();
+    const double bx = b.x.value();
+    const double by = b.y.value();
+    const double dist = std::hypot(bx - ax, by - ay);
+    if (mRows == 0 || dist > range) {
+        return 0;
+    }
+
+    // ellipse centred at (cx, cy) with semi-axes major and minor, major axis along (ux, uy)
+    const double cx = 0.5 * (ax + bx);
+    const double cy = 0.5 * (ay + by);
+    const double major = 0.5 * range;
+    const double minor = std::sqrt(major * major - 0.25 * dist * dist);
+    const double ux = dist > 0.0 ? (bx - ax) / dist : 1.0;
+    const double uy = dist > 0.0 ? (by - ay) / dist : 0.0;
+    const double major2 = major * major;
+    const double minor2 = std::max(minor * minor, std::numeric_limits<double>::min());
+
+    // points (cx + dx, cy + dy) within ellipse satisfy alpha * dx^2 + 2 * beta * dx + gamma <= 0
+    const double alpha = ux * ux / major2 + uy * uy / minor2;
+    const double betaFactor = ux * uy / major2 - ux * uy / minor2;
+    const double gammaFactor = uy * uy / major2 + ux * ux / minor2;
+
+    // rows whose centres are within vertical extent of ellipse
+    const double extentY = std::sqrt(major2 * uy * uy + minor2 * ux * ux);
+    const int firstRow = std::max(0, static_cast<int>(std::ceil((cy - extentY - mOriginY) / mCellSize - 0.5)));
+    const int lastRow = std::min(mRows - 1, static_cast<int>(std::floor((cy + extentY - mOriginY) / mCellSize - 0.5)));
+
+    std::size_t count = 0;
+    for (int row = firstRow; row <= lastRow; ++row) {
+        const double dy = mOriginY + (row + 0.5) * mCellSize - cy;
+        const double beta = betaFactor * dy;
+        const double gamma = gammaFactor * dy * dy - 1.0;
+        const double discriminant = beta * beta - alpha * gamma;
+        if (discriminant < 0.0) {
+            continue;
+        }
+
+        const double root = std::sqrt(discriminant);
+        const double left = cx + (-beta - root) / alpha;
+        const double right = cx + (-beta + root) / alpha;
+        const int first = std::max(0, static_cast<int>(std::ceil((left - mOriginX) / mCellSize - 0.5)));
+        const int last = std::min(mColumns - 1, static_cast<int>(std::floor((right - mOriginX) / mCellSize - 0.5)));
+        if (first <= last) {
+            count += sumRow(row, first, last);
+        }
+    }
+    return count;
+}
+
+std::size_t VehicleDensityGrid::sumRow(int row, int first, int last) const
+{
+    const std::size_t* sums = &mPrefixSums[row * (mColumns + 1)];
+    return sums[last + 1] - sums[first];
+}
+
+} // namespace gemv2
+} // namespace artery
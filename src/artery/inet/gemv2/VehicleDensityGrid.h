@@ -0,0 +1,58 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef VEHICLEDENSITYGRID_H_G7MW2RKD
+#define VEHICLEDENSITYGRID_H_G7MW2RKD
+
+#include "artery/inet/gemv2/VehicleIndex.h"
+#include "artery/utility/Geometry.h"
+#include <cstddef>
+#include <vector>
+
+namespace artery
+{
+namespace gemv2
+{
+
+/**
+ * VehicleDensityGrid counts vehicle midpoints per square cell.
+ *
+ * Each grid row stores prefix sums of its cells, thus counting vehicles within an ellipse
+ * takes one lookup per row instead of a walk over all vehicles close to the ellipse.
+ * Vehicles are counted if the centre of their cell lies within the ellipse,
+ * i.e. the count is exact up to the cell size.
+ */
+class VehicleDensityGrid
+{
+public:
+    /**
+     * Rebuild grid from scratch
+     * \param vehicles indexed vehicles
+     * \param cellSize edge length of cells
+     */
+    void rebuild(const VehicleIndex::VehicleSlots& vehicles, double cellSize);
+
+    /**
+     * Count vehicles within ellipse with foci a and b, semi-major axis is 1/2 of given range
+     * \return approximate number of vehicles (cell centres within ellipse)
+     */
+    std::size_t countEllipse(const Position& a, const Position& b, double range) const;
+
+private:
+    std::size_t sumRow(int row, int first, int last) const;
+
+    double mCellSize = 0.0;
+    double mOriginX = 0.0;
+    double mOriginY = 0.0;
+    int mColumns = 0;
+    int mRows = 0;
+    // mColumns + 1 prefix sums per row, first one is always zero
+    std::vector<std::size_t> mPrefixSums;
+};
+
+} // namespace gemv2
+} // namespace artery
+
+#endif /* VEHICLEDENSITYGRID_H_G7MW2RKD */
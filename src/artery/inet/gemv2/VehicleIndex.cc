@@ -6,18 +6,12 @@
 
 #include "artery/inet/gemv2/VehicleIndex.h"
 #include "artery/inet/gemv2/Visualizer.h"
-#include "artery/traci/Cast.h"
-#include "traci/Core.h"
-#include "traci/BasicNodeManager.h"
-#include "traci/API.h"
 #include <boost/geometry.hpp>
 #include <boost/geometry/geometries/register/linestring.hpp>
-#include <boost/geometry/strategies/transform/matrix_transformers.hpp>
 #include <boost/range/adaptor/indexed.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/units/cmath.hpp>
 #include <inet/common/ModuleAccess.h>
-#include <omnetpp/checkandcast.h>
 #include <algorithm>
 #include <array>
 
@@ -35,78 +29,40 @@ using namespace omnetpp;
 namespace bg = boost::geometry;
 
 namespace {
-    const simsignal_t traciInitSignal = cComponent::registerSignal("traci.init");
     const bg::de9im::mask cutting("T**FF****");
 }
 
 
 void VehicleIndex::initialize()
 {
-    cModule* traci = getModuleByPath(par("traciModule"));
-    if (traci) {
-        traci->subscribe(traci::BasicNodeManager::updateNodeSignal, this);
-        traci->subscribe(traci::BasicNodeManager::addVehicleSignal, this);
-        traci->subscribe(traci::BasicNodeManager::updateVehicleSignal, this);
-        traci->subscribe(traci::BasicNodeManager::removeVehicleSignal, this);
-    } else {
-        throw cRuntimeError("No TraCI module found for signal subscription");
-    }
-
+    auto geometry = inet::findModuleFromPar<VehicleGeometryIndex>(par("vehicleGeometryIndexModule"), this);
+    mGeometry = geometry;
     mVisualizer = inet::findModuleFromPar<Visualizer>(par("visualizerModule"), this, false);
-    mVehicleMargin = std::abs(par("vehicleMargin").doubleValue());
-}
-
-void VehicleIndex::receiveSignal(cComponent* source, simsignal_t signal, unsigned long, cObject* obj)
-{
-    Enter_Method_Silent();
-    if (signal == traci::BasicNodeManager::updateNodeSignal) {
-        using Indexable = typename RtreeValue::first_type;
-        using Iterator = typename RtreeValue::second_type;
-        mVehicleRtree.clear();
-        for (Iterator it = mVehicles.begin(); it != mVehicles.end(); ++it) {
-            const Vehicle& vehicle = it->second;
-            mVehicleRtree.insert(RtreeValue { bg::return_envelope<Indexable>(vehicle.getOutline()), it });
-        }
-        mRtreeTainted = false;
-        if (mVisualizer) {
-            mVisualizer->drawVehicles(this);
-        }
+    if (mVisualizer && !mVisualizer->isActive()) {
+        mVisualizer = nullptr; // nothing to show without GUI
+    }
+    if (mVisualizer) {
+        geometry->subscribe(VehicleGeometryIndex::updateSignal, this);
     }
 }
 
-void VehicleIndex::receiveSignal(cComponent* source, simsignal_t signal, const char* id, cObject* obj)
+void VehicleIndex::receiveSignal(cComponent*, simsignal_t signal, cObject*, cObject*)
 {
     Enter_Method_Silent();
-    if (signal == traci::BasicNodeManager::addVehicleSignal) {
-        auto api = check_and_cast<traci::NodeManager*>(source)->getAPI();
-        ASSERT(api);
-        Vehicle vehicle(*api, id, mVehicleMargin);
-        auto insertion = mVehicles.emplace(id, std::move(vehicle));
-        if (insertion.second) {
-            const Vehicle& vehicle = insertion.first->second;
-            RtreeValue value {
-                bg::return_envelope<RtreeValue::first_type>(vehicle.getOutline()),
-                insertion.first };
-            mVehicleRtree.insert(std::move(value));
-        }
-    } else if (signal == traci::BasicNodeManager::updateVehicleSignal) {
-        auto vehicle = check_and_cast<traci::BasicNodeManager::VehicleObject*>(obj);
-        mVehicles.at(id).update(vehicle->getPosition(), vehicle->getHeading());
-        mRtreeTainted = true;
-    } else if (signal == traci::BasicNodeManager::removeVehicleSignal) {
-        mVehicles.erase(id);
-        mRtreeTainted = true;
+    if (signal == VehicleGeometryIndex::updateSignal && mVisualizer) {
+        mVisualizer->drawVehicles(this);
     }
 }
 
 bool VehicleIndex::anyBlockage(const Position& a, const Position& b) const
 {
-    ASSERT(!mRtreeTainted && mVehicles.size() == mVehicleRtree.size());
+    ASSERT(!mGeometry->isTainted() && mGeometry->getVehicleCount() == mGeometry->getRtree().size());
     const LineOfSight los { a, b };
     auto rtree_intersect = bg::index::intersects(los);
-    return std::any_of(mVehicleRtree.qbegin(rtree_intersect), mVehicleRtree.qend(),
-            [&](const RtreeValue& candidate) {
-                const Vehicle& vehicle = candidate.second->second;
+    const auto& rtree = mGeometry->getRtree();
+    return std::any_of(rtree.qbegin(rtree_intersect), rtree.qend(),
+            [&](const VehicleGeometryIndex::RtreeValue& candidate) {
+                const Vehicle& vehicle = *mGeometry->getVehicles()[candidate.second];
                 const std::vector<Position>& outline = vehicle.getOutline();
                 return bg::relate(los, outline, cutting);
             });
@@ -114,77 +70,81 @@ bool VehicleIndex::anyBlockage(const Position& a, const Position& b) const
 
 bool VehicleIndex::anyBlockage(const Position& a, const Position& b, double height) const
 {
-    ASSERT(!mRtreeTainted);
+    ASSERT(!mGeometry->isTainted());
     const LineOfSight los { a, b };
     auto rtree_intersect = bg::index::intersects(los);
-    return std::any_of(mVehicleRtree.qbegin(rtree_intersect), mVehicleRtree.qend(),
-            [&](const RtreeValue& candidate) {
-                const Vehicle& vehicle = candidate.second->second;
+    const auto& rtree = mGeometry->getRtree();
+    return std::any_of(rtree.qbegin(rtree_intersect), rtree.qend(),
+            [&](const VehicleGeometryIndex::RtreeValue& candidate) {
+                const Vehicle& vehicle = *mGeometry->getVehicles()[candidate.second];
                 const std::vector<Position>& outline = vehicle.getOutline();
                 return vehicle.getHeight() > height && bg::relate(los, outline, cutting);
             });
 }
 
-std::vector<const VehicleIndex::Vehicle*>
-VehicleIndex::getObstructingVehicles(const Position& a, const Position& b) const
+bool VehicleIndex::anyBlockage(const BlockageCandidates& candidates, const Position& a, const Position& b) const
 {
-    ASSERT(!mRtreeTainted);
-    std::vector<const Vehicle*> result;
     const LineOfSight los { a, b };
-    auto rtree_intersect = bg::index::intersects(los);
-    for (auto it = mVehicleRtree.qbegin(rtree_intersect); it != mVehicleRtree.qend(); ++it) {
-        const Vehicle& vehicle = it->second->second;
-        if (bg::relate(los, vehicle.getOutline(), cutting)) {
-            result.push_back(&vehicle);
-        }
-    }
-    return result;
+    return candidates.any(a, b, [&](BlockageCandidates::Index candidate) {
+        return bg::relate(los, mGeometry->getVehicles()[candidate]->getOutline(), cutting);
+    });
 }
 
-VehicleIndex::Vehicle::Vehicle(const traci::API& api, const std::string& id, double margin) :
-    mBoundary(api.simulation.getNetBoundary()), mHeight(0.0)
+bool VehicleIndex::anyBlockage(const BlockageCandidates& candidates, const Position& a, const Position& b, double height) const
 {
-    auto vtype = api.vehicle.getTypeID(id);
-    mHeight = api.vehicletype.getHeight(vtype);
-    createLocalOutline(api.vehicletype.getWidth(vtype), api.vehicletype.getLength(vtype), margin);
-    update(api.vehicle.getPosition(id), traci::TraCIAngle { api.vehicle.getAngle(id) });
+    const LineOfSight los { a, b };
+    return candidates.any(a, b, [&](BlockageCandidates::Index candidate) {
+        const Vehicle& vehicle = *mGeometry->getVehicles()[candidate];
+        return vehicle.getHeight() > height && bg::relate(los, vehicle.getOutline(), cutting);
+    });
 }
 
-void VehicleIndex::Vehicle::update(const traci::TraCIPosition& pos, traci::TraCIAngle heading)
+void VehicleIndex::gatherCandidates(const geometry::Box& box, BlockageCandidates& candidates) const
 {
-    mPosition = traci::position_cast(mBoundary, pos);
-    mHeading = traci::angle_cast(heading);
-    calculateWorldOutline();
+    ASSERT(!mGeometry->isTainted() && mGeometry->getVehicleCount() == mGeometry->getRtree().size());
+    candidates.clear();
+    auto rtree_intersect = bg::index::intersects(box);
+    const auto& rtree = mGeometry->getRtree();
+    for (auto it = rtree.qbegin(rtree_intersect); it != rtree.qend(); ++it) {
+        candidates.add(it->second, mGeometry->getVehicles()[it->second]->getOutline());
+    }
 }
 
-void VehicleIndex::Vehicle::createLocalOutline(double width, double length, double margin)
+std::vector<const VehicleIndex::Vehicle*>
+VehicleIndex::getObstructingVehicles(const Position& a, const Position& b) const
 {
-    // vehicle corner points in clockwise order, center of front bumper at origin, heading east
-    mLocalOutline.assign({
-        Position(margin, 0.5 * width + margin),
-        Position(margin, -(0.5 * width + margin)),
-        Position(-(length + margin), -(0.5 * width + margin)),
-        Position(-(length + margin), 0.5 * width + margin)
-    });
-    mLocalMidpoint = Position { -0.5 * length, 0.0 };
+    ASSERT(!mGeometry->isTainted());
+    std::vector<const Vehicle*> result;
+    const LineOfSight los { a, b };
+    auto rtree_intersect = bg::index::intersects(los);
+    const auto& rtree = mGeometry->getRtree();
+    for (auto it = rtree.qbegin(rtree_intersect); it != rtree.qend(); ++it) {
+        const Vehicle& vehicle = *mGeometry->getVehicles()[it->second];
+        if (bg::relate(los, vehicle.getOutline(), cutting)) {
+            result.push_back(&vehicle);
+        }
+    }
+    return result;
 }
 
-void VehicleIndex::Vehicle::calculateWorldOutline()
+void VehicleIndex::getObstructingVehicles(const Position& a, const Position& b,
+        const std::function<bool(const Vehicle&)>& filter,
+        const std::function<void(const Vehicle&)>& visitor) const
 {
-    using namespace boost::geometry::strategy::transform;
-    std::vector<Position> tmp;
-    mWorldOutline.clear();
-
-    rotate_transformer<boost::geometry::radian, double, 2, 2> rot(mHeading.radian());
-    translate_transformer<double, 2, 2> mov(mPosition.x.value(), mPosition.y.value());
-    boost::geometry::transform(mLocalOutline, tmp, rot);
-    boost::geometry::transform(tmp, mWorldOutline, mov);
-    tmp.resize(1);
-    boost::geometry::transform(mLocalMidpoint, tmp.front(), rot);
-    boost::geometry::transform(tmp.front(), mWorldMidpoint, mov);
-
-    ASSERT(mWorldOutline.size() == mLocalOutline.size());
-    ASSERT(bg::is_valid(mWorldOutline));
+    ASSERT(!mGeometry->isTainted());
+    const LineOfSight los { a, b };
+    const auto& vehicles = mGeometry->getVehicles();
+    auto rtree_query = bg::index::intersects(los) && bg::index::satisfies(
+            [&](const VehicleGeometryIndex::RtreeValue& candidate) {
+                return filter(*vehicles[candidate.second]);
+            });
+    const auto& rtree = mGeometry->getRtree();
+    for (auto it = rtree.qbegin(rtree_query); it != rtree.qend(); ++it) {
+        const Vehicle& vehicle = *vehicles[it->second];
+        if (bg::relate(los, vehicle.getOutline(), cutting)) {
+            visitor(vehicle);
+        }
+    }
 }
 
 std::vector<const VehicleIndex::Vehicle*>
@@ -209,7 +169,7 @@ VehicleIndex::vehiclesEllipseOthers(const Position& a, const Position& b, double
 
 void VehicleIndex::vehiclesEllipse(const Position& a, const Position& b, double r, std::function<void(const Vehicle&)> fn) const
 {
-    ASSERT(!mRtreeTainted);
+    ASSERT(!mGeometry->isTainted());
     using boost::units::fmin;
     using boost::units::fmax;
 
@@ -226,8 +186,9 @@ void VehicleIndex::vehiclesEllipse(const Position& a, const Position& b, double
         bg::set<bg::max_corner, 1>(ebb, fmax(a.y, b.y).value() + k); // bottom
 
         auto rtree_intersect = bg::index::intersects(ebb);
-        for (auto it = mVehicleRtree.qbegin(rtree_intersect); it != mVehicleRtree.qend(); ++it) {
-            const Vehicle& vehicle = it->second->second;
+        const auto& rtree = mGeometry->getRtree();
+        for (auto it = rtree.qbegin(rtree_intersect); it != rtree.qend(); ++it) {
+            const Vehicle& vehicle = *mGeometry->getVehicles()[it->second];
             const Position& c = vehicle.getMidpoint();
             if (bg::distance(a, c) + bg::distance(b, c) <= r) {
                 // vehicle's center is within ellipse
@@ -7,20 +7,14 @@
 #ifndef VEHICLEINDEX_H_V9YES7AR
 #define VEHICLEINDEX_H_V9YES7AR
 
+#include "artery/inet/gemv2/BlockageCandidates.h"
 #include "artery/utility/Geometry.h"
-#include "traci/Angle.h"
-#include "traci/Boundary.h"
-#include "traci/Position.h"
-#include <boost/geometry/index/rtree.hpp>
+#include "artery/utility/VehicleGeometryIndex.h"
 #include <omnetpp/clistener.h>
 #include <omnetpp/csimplemodule.h>
 #include <functional>
-#include <set>
 #include <vector>
 
-// forward declaration
-namespace traci { class API; }
-
 namespace artery
 {
 namespace gemv2
@@ -28,42 +22,39 @@ namespace gemv2
 
 class Visualizer;
 
+/**
+ * VehicleIndex answers GEMV2's queries about vehicles, e.g. blockage of lines of sight.
+ * Vehicle geometries and their spatial index are provided by a VehicleGeometryIndex,
+ * which may be shared with other modules.
+ */
 class VehicleIndex : public omnetpp::cSimpleModule, public omnetpp::cListener
 {
 public:
-    class Vehicle
-    {
-    public:
-        Vehicle(const traci::API&, const std::string& id, double margin = 0.0);
-        void update(const traci::TraCIPosition& pos, traci::TraCIAngle heading);
-        const std::vector<Position>& getOutline() const { return mWorldOutline; }
-        const double getHeight() const { return mHeight; }
-        const Position& getMidpoint() const { return mWorldMidpoint; }
-
-    private:
-        void createLocalOutline(double width, double length, double margin);
-        void calculateWorldOutline();
-
-        traci::Boundary mBoundary;
-        double mHeight;
-        Angle mHeading;
-        Position mPosition;
-        Position mLocalMidpoint;
-        Position mWorldMidpoint;
-        std::vector<Position> mLocalOutline;
-        std::vector<Position> mWorldOutline;
-    };
+    using Vehicle = VehicleGeometryIndex::Vehicle;
 
     // cSimpleModule
     void initialize() override;
 
     // cListener
-    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, unsigned long, omnetpp::cObject*) override;
-    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, const char*, omnetpp::cObject*) override;
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, omnetpp::cObject*, omnetpp::cObject*) override;
 
     bool anyBlockage(const Position& a, const Position& b) const;
     bool anyBlockage(const Position& a, const Position& b, double height) const;
 
+    /**
+     * Check for blockage among previously gathered candidates, same result as anyBlockage(a, b)
+     * \param candidates gathered by gatherCandidates for a box covering segment a-b
+     */
+    bool anyBlockage(const BlockageCandidates& candidates, const Position& a, const Position& b) const;
+    bool anyBlockage(const BlockageCandidates& candidates, const Position& a, const Position& b, double height) const;
+
+    /**
+     * Gather all vehicles whose envelope intersects a box
+     * \param box e.g. covering all lines of sight of a transmitter
+     * \param candidates cleared and filled with vehicles
+     */
+    void gatherCandidates(const geometry::Box& box, BlockageCandidates& candidates) const;
+
     /**
      * Get all vehicles obstructing the line of sight between given points
      * \param a position a, e.g. transmitter
@@ -72,6 +63,19 @@ public:
      */
     std::vector<const Vehicle*> getObstructingVehicles(const Position& a, const Position& b) const;
 
+    /**
+     * Visit vehicles obstructing the line of sight between given points
+     *
+     * Filter is evaluated during the rtree walk, i.e. before the exact (and expensive) obstruction test.
+     * \param a position a, e.g. transmitter
+     * \param b position b, e.g. receiver
+     * \param filter rejects vehicles by returning false
+     * \param visitor invoked for each accepted vehicle obstructing line of sight
+     */
+    void getObstructingVehicles(const Position& a, const Position& b,
+            const std::function<bool(const Vehicle&)>& filter,
+            const std::function<void(const Vehicle&)>& visitor) const;
+
     /**
      * Get vehicles with their center point being within the defined ellipse.
      *
@@ -90,24 +94,25 @@ public:
      */
     std::vector<const Vehicle*> vehiclesEllipseOthers(const Position& a, const Position& b, double range) const;
 
+    /**
+     * Get revision of indexed vehicle positions
+     * \return counter incremented whenever vehicles are added or the vehicle index is updated
+     */
+    unsigned long getRevision() const { return mGeometry->getRevision(); }
+
+    using VehicleSlots = VehicleGeometryIndex::VehicleSlots;
+
     /**
      * Get all indexed vehicles
-     * \return map of vehicles
+     * \return vehicles indexed by their node handle (slots of released handles are empty)
      */
-    const std::map<std::string, Vehicle>& getVehicles() const { return mVehicles; }
+    const VehicleSlots& getVehicles() const { return mGeometry->getVehicles(); }
 
 private:
-    using VehicleMap = std::map<std::string, Vehicle>;
-    using RtreeValue = std::pair<geometry::Box, VehicleMap::const_iterator>;
-    using Rtree = boost::geometry::index::rtree<RtreeValue, boost::geometry::index::rstar<16>>;
-
     void vehiclesEllipse(const Position& a, const Position& b, double r, std::function<void(const Vehicle&)>) const;
 
-    VehicleMap mVehicles;
-    Rtree mVehicleRtree;
-    bool mRtreeTainted = false;
+    const VehicleGeometryIndex* mGeometry = nullptr;
     Visualizer* mVisualizer = nullptr;
-    double mVehicleMargin = 0.0;
 };
 
 } // namespace gemv2
@@ -1,6 +1,9 @@
 #include "artery/inet/gemv2/Visualizer.h"
 #include "artery/inet/gemv2/ObstacleIndex.h"
 #include "artery/inet/gemv2/VehicleIndex.h"
+#include <boost/geometry/algorithms/distance.hpp>
+#include <omnetpp/cenvir.h>
+#include <utility>
 
 namespace artery
 {
@@ -22,6 +25,14 @@ void Visualizer::initialize(int stage)
         mReflectionColorObstacle = omnetpp::cFigure::Color(par("reflectionColorObstacle"));
         mReflectionColorVehicle = omnetpp::cFigure::Color(par("reflectionColorVehicle"));
 
+        const int maxLinks = par("maxLinks");
+        if (maxLinks < 0) {
+            throw omnetpp::cRuntimeError("maxLinks must not be negative");
+        }
+        mMaxLinks = maxLinks;
+        mFocusVehicle = par("focusVehicle").stdstringValue();
+        mFocusDistance = par("focusDistance");
+
         auto canvas = this->getCanvas();
         canvas->addFigure(mVehicleGroup);
         canvas->addFigure(mRaysGroup);
@@ -29,6 +40,11 @@ void Visualizer::initialize(int stage)
     }
 }
 
+bool Visualizer::isActive() const
+{
+    return getEnvir()->isGUI();
+}
+
 omnetpp::cGroupFigure* Visualizer::getObstacleGroup(const omnetpp::cModule* module)
 {
     omnetpp::cGroupFigure* figure = nullptr;
@@ -67,7 +83,35 @@ void Visualizer::drawObstacles(const ObstacleIndex* index)
 
 void Visualizer::drawVehicles(const VehicleIndex* index)
 {
-    auto vehicles = index->getVehicles();
+    // polygons are updated lazily by refreshDisplay
+    mVehicleIndex = index;
+    mVehiclesDirty = true;
+    if (!mFocusVehicle.empty()) {
+        updateFocus();
+    }
+}
+
+void Visualizer::refreshDisplay() const
+{
+    if (mVehiclesDirty) {
+        refreshVehicles();
+        mVehiclesDirty = false;
+    }
+    if (mRaysDirty) {
+        refreshRays();
+        mRaysDirty = false;
+    }
+}
+
+void Visualizer::refreshVehicles() const
+{
+    std::unordered_map<std::string, const VehicleIndex::Vehicle*> vehicles;
+    for (const auto& slot : mVehicleIndex->getVehicles())
+    {
+        if (slot) {
+            vehicles.emplace(slot->getId(), &*slot);
+        }
+    }
 
     // remove vehicles that do not exist longer
     for (auto it = mVehiclePolygons.begin(); it != mVehiclePolygons.end();)
@@ -89,27 +133,90 @@ void Visualizer::drawVehicles(const VehicleIndex* index)
             omnetpp::cPolygonFigure* polygon = new omnetpp::cPolygonFigure(name_vehicle.first.c_str());
             mVehicleGroup->addFigure(polygon);
             mVehiclePolygons[name_vehicle.first] = polygon;
-            for (const Position& pos : name_vehicle.second.getOutline())
+            for (const Position& pos : name_vehicle.second->getOutline())
             {
                 polygon->addPoint(omnetpp::cFigure::Point { pos.x.value(), pos.y.value() });
             }
-            polygon->setLineColor(omnetpp::cFigure::BLUE);
+            polygon->setLineColor(name_vehicle.first == mFocusVehicle ? omnetpp::cFigure::RED : omnetpp::cFigure::BLUE);
         } else {
             // update existing polygon
             omnetpp::cPolygonFigure* polygon = found->second;
-            auto& outline = name_vehicle.second.getOutline();
+            auto& outline = name_vehicle.second->getOutline();
             for (int i = 0; i < polygon->getNumPoints(); ++i)
             {
                 polygon->setPoint(i, omnetpp::cFigure::Point { outline[i].x.value(), outline[i].y.value() });
             }
         }
     }
+}
+
+void Visualizer::refreshRays() const
+{
+    std::size_t used = 0;
+    for (const Link& link : mLinks)
+    {
+        for (const Ray& ray : link.rays)
+        {
+            if (used == mRayFigures.size()) {
+                auto figure = new omnetpp::cPolylineFigure();
+                mRaysGroup->addFigure(figure);
+                mRayFigures.push_back(figure);
+            }
+            omnetpp::cPolylineFigure* figure = mRayFigures[used++];
+            figure->setPoints(ray.points);
+            figure->setLineColor(ray.color);
+            figure->setVisible(true);
+        }
+    }
+
+    // keep spare figures for later links
+    for (; used < mRayFigures.size(); ++used)
+    {
+        mRayFigures[used]->setVisible(false);
+    }
+}
 
-    // remove all previous rays
-    for (int i = mRaysGroup->getNumFigures() - 1; i >= 0; --i)
+void Visualizer::updateFocus()
+{
+    mFocusOutline.clear();
+    for (const auto& slot : mVehicleIndex->getVehicles())
     {
-        delete mRaysGroup->removeFigure(i);
+        if (slot && slot->getId() == mFocusVehicle) {
+            mFocusOutline = slot->getOutline();
+            break;
+        }
+    }
+}
+
+bool Visualizer::isFocused(const Position& pos) const
+{
+    return !mFocusOutline.empty() && boost::geometry::distance(pos, mFocusOutline) <= mFocusDistance;
+}
+
+Visualizer::Link* Visualizer::recordLink(const Position& tx, const Position& rx)
+{
+    if (mMaxLinks == 0 || !isActive()) {
+        return nullptr;
+    } else if (!mFocusVehicle.empty() && !isFocused(tx) && !isFocused(rx)) {
+        return nullptr;
+    }
+
+    // consecutive draw calls for the same pair of positions belong to one link
+    if (mLinks.empty() || mLinks.back().tx != tx || mLinks.back().rx != rx) {
+        Link link;
+        if (mLinks.size() >= mMaxLinks) {
+            // recycle oldest link and its buffers
+            link = std::move(mLinks.front());
+            mLinks.pop_front();
+            link.rays.clear();
+        }
+        link.tx = tx;
+        link.rx = rx;
+        mLinks.push_back(std::move(link));
     }
+
+    mRaysDirty = true;
+    return &mLinks.back();
 }
 
 void Visualizer::drawReflectionRays(const Position& tx, const Position& rx,
@@ -126,41 +233,46 @@ void Visualizer::drawDiffractionRays(const Position& tx, const Position& rx, con
 
 void Visualizer::drawFoliageRay(const Position& tx, const Position& rx, const std::vector<Position>& foliage)
 {
-    bool isOutside = true;
+    Link* link = recordLink(tx, rx);
+    if (!link) {
+        return;
+    }
 
+    bool isOutside = true;
     const Position* start = &tx;
+    auto addSegment = [&](const Position& end, omnetpp::cFigure::Color color) {
+        link->rays.push_back(Ray {
+            { omnetpp::cFigure::Point { start->x.value(), start->y.value() },
+              omnetpp::cFigure::Point { end.x.value(), end.y.value() } },
+            color });
+    };
+
     for (const Position& point : foliage)
     {
-        auto figure = new omnetpp::cLineFigure();
-        mRaysGroup->addFigure(figure);
-        figure->setLineColor(isOutside ? mFoliageColorOutside : mFoliageColorInside);
-        figure->setStart(omnetpp::cFigure::Point { start->x.value(), start->y.value() });
-        figure->setEnd(omnetpp::cFigure::Point { point.x.value(), point.y.value() });
+        addSegment(point, isOutside ? mFoliageColorOutside : mFoliageColorInside);
         start = &point;
         isOutside = !isOutside;
     }
-
-    auto figure = new omnetpp::cLineFigure();
-    mRaysGroup->addFigure(figure);
-    figure->setLineColor(mFoliageColorOutside);
-    figure->setStart(omnetpp::cFigure::Point { start->x.value(), start->y.value() });
-    figure->setEnd(omnetpp::cFigure::Point { rx.x.value(), rx.y.value() });
+    addSegment(rx, mFoliageColorOutside);
 }
 
 void Visualizer::drawRays(const Position& tx, const Position& rx,
-        const std::vector<Position>& points, omnetpp::cFigure::Color c) const
+        const std::vector<Position>& points, omnetpp::cFigure::Color c)
 {
+    if (points.empty()) {
+        return;
+    }
+
+    Link* link = recordLink(tx, rx);
+    if (!link) {
+        return;
+    }
+
     const omnetpp::cFigure::Point begin { tx.x.value(), tx.y.value() };
     const omnetpp::cFigure::Point end { rx.x.value(), rx.y.value() };
-
     for (auto& point : points)
     {
-        auto figure = new omnetpp::cPolylineFigure();
-        mRaysGroup->addFigure(figure);
-        figure->setLineColor(c);
-        figure->addPoint(begin);
-        figure->addPoint(omnetpp::cFigure::Point { point.x.value(), point.y.value() });
-        figure->addPoint(end);
+        link->rays.push_back(Ray { { begin, omnetpp::cFigure::Point { point.x.value(), point.y.value() }, end }, c });
     }
 }
 
@@ -4,8 +4,10 @@
 #include "artery/utility/Geometry.h"
 #include <omnetpp/ccanvas.h>
 #include <omnetpp/csimplemodule.h>
+#include <deque>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace artery
 {
@@ -16,10 +18,26 @@ namespace gemv2
 class ObstacleIndex;
 class VehicleIndex;
 
+/**
+ * Visualizer shows GEMV2's geometry and propagation paths on the canvas.
+ *
+ * Draw calls only record rays of the latest links (optionally those of a focused vehicle),
+ * figures are updated in refreshDisplay and reused across updates.
+ * Nothing is recorded unless a graphical user interface is active.
+ */
 class Visualizer : public omnetpp::cSimpleModule
 {
 public:
     void initialize(int stage) override;
+    void refreshDisplay() const override;
+
+    /**
+     * Check if visualization takes effect at all
+     *
+     * Modules may drop their visualizer reference during initialization if it is inactive.
+     * \return true if a graphical user interface is active
+     */
+    bool isActive() const;
 
     void drawObstacles(const ObstacleIndex*);
     void drawVehicles(const VehicleIndex*);
@@ -29,15 +47,49 @@ public:
     void drawFoliageRay(const Position&, const Position&, const std::vector<Position>&);
 
 protected:
+    struct Ray
+    {
+        std::vector<omnetpp::cFigure::Point> points;
+        omnetpp::cFigure::Color color;
+    };
+
+    struct Link
+    {
+        Position tx;
+        Position rx;
+        std::vector<Ray> rays;
+    };
+
     omnetpp::cGroupFigure* getObstacleGroup(const omnetpp::cModule*);
-    void drawRays(const Position&, const Position&, const std::vector<Position>&, omnetpp::cFigure::Color) const;
+    void drawRays(const Position&, const Position&, const std::vector<Position>&, omnetpp::cFigure::Color);
+
+    /**
+     * Get link record for rays between tx and rx if this link shall be shown
+     * \return link record or nullptr if link is filtered
+     */
+    Link* recordLink(const Position& tx, const Position& rx);
+    bool isFocused(const Position&) const;
+    void updateFocus();
+    void refreshVehicles() const;
+    void refreshRays() const;
 
 private:
     omnetpp::cGroupFigure* mVehicleGroup;
     omnetpp::cGroupFigure* mRaysGroup;
-    std::unordered_map<std::string, omnetpp::cPolygonFigure*> mVehiclePolygons;
+    mutable std::unordered_map<std::string, omnetpp::cPolygonFigure*> mVehiclePolygons;
     std::unordered_map<int, omnetpp::cGroupFigure*> mObstacleGroups;
 
+    const VehicleIndex* mVehicleIndex = nullptr;
+    mutable bool mVehiclesDirty = false;
+    std::deque<Link> mLinks;
+    std::size_t mMaxLinks = 0;
+    mutable bool mRaysDirty = false;
+    mutable std::vector<omnetpp::cPolylineFigure*> mRayFigures; /*< pool of figures, unused ones are hidden */
+
+    std::string mFocusVehicle;
+    std::vector<Position> mFocusOutline; /*< empty if focused vehicle is not present */
+    double mFocusDistance = 0.0;
+
     omnetpp::cFigure::Color mBackgroundColor;
     omnetpp::cFigure::Color mDiffractionColor;
     omnetpp::cFigure::Color mFoliageColorInside;
@@ -50,4 +102,3 @@ private:
 } // namespace artery
 
 #endif /* ARTERY_GEMV2_VISUALIZER_H_U4LMLGVJ */
-
@@ -1,6 +1,7 @@
 #include "artery/networking/AccessInterface.h"
 #include "artery/networking/GeoNetPacket.h"
 #include "artery/networking/GeoNetRequest.h"
+#include "artery/utility/Fingerprint.h"
 #include "artery/utility/PointerCheck.h"
 #include <omnetpp/checkandcast.h>
 #include <omnetpp/csimplemodule.h>
@@ -24,6 +25,18 @@ void AccessInterface::request(const DataRequest& request, std::unique_ptr<ChunkP
     omnetpp::cMethodCallContextSwitcher ctx(mModuleOut);
     ctx.methodCall("request");
 
+    if (fingerprint::isEnabled(fingerprint::Ingredient::PayloadData)) {
+        vanetza::ByteBuffer buffer;
+        for (auto layer : { vanetza::OsiLayer::Network, vanetza::OsiLayer::Transport, vanetza::OsiLayer::Session,
+                vanetza::OsiLayer::Presentation, vanetza::OsiLayer::Application }) {
+            vanetza::ByteBuffer layerBuffer;
+            (*payload)[layer].convert(layerBuffer);
+            buffer.insert(buffer.end(), layerBuffer.begin(), layerBuffer.end());
+        }
+        fingerprint::addBytes(fingerprint::Ingredient::PayloadData, buffer.data(), buffer.size());
+    }
+
+    // packet and request objects are recycled by their classes' free lists
     GeoNetPacket* gn = new GeoNetPacket("GeoNet packet");
     gn->setPayload(std::move(payload));
     gn->setControlInfo(new GeoNetRequest(request));
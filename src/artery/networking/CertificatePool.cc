@@ -0,0 +1,303 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/networking/CertificatePool.h"
+#include "artery/utility/ReplicationFork.h"
+#include <omnetpp/cexception.h>
+#include <vanetza/common/archives.hpp>
+#include <vanetza/security/v2/basic_elements.hpp>
+#include <vanetza/security/v2/naive_certificate_provider.hpp>
+#include <vanetza/security/v2/validity_restriction.hpp>
+#include <boost/variant/get.hpp>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+namespace artery
+{
+
+Define_Module(CertificatePool)
+
+namespace vs2 = vanetza::security::v2;
+
+namespace
+{
+
+const char magic[8] = { 'A', 'R', 'T', 'E', 'R', 'Y', 'C', 'P' };
+const std::uint32_t version = 1;
+
+bool isValidAt(const vs2::Certificate& certificate, vs2::Time32 now)
+{
+    for (const vs2::ValidityRestriction& restriction : certificate.validity_restriction) {
+        if (auto end = boost::get<vs2::EndValidity>(&restriction)) {
+            if (now >= *end) {
+                return false;
+            }
+        } else if (auto span = boost::get<vs2::StartAndEndValidity>(&restriction)) {
+            if (now < span->start_validity || now >= span->end_validity) {
+                return false;
+            }
+        } else if (auto span = boost::get<vs2::StartAndDurationValidity>(&restriction)) {
+            if (now < span->start_validity || now >= span->start_validity + span->duration.to_seconds().count()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool isValidAt(const CertificatePool::Entry& entry, vs2::Time32 now)
+{
+    if (!isValidAt(entry.certificate, now)) {
+        return false;
+    }
+    for (const vs2::Certificate& certificate : entry.chain) {
+        if (!isValidAt(certificate, now)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+CertificatePool::~CertificatePool()
+{
+    stop();
+}
+
+void CertificatePool::initialize()
+{
+    prepare();
+}
+
+void CertificatePool::finish()
+{
+    stop();
+    if (mLowWatermark > 0) {
+        getSystemModule()->unsubscribe(ReplicationFork::prepareSignal, this);
+        getSystemModule()->unsubscribe(ReplicationFork::resumeSignal, this);
+    }
+    recordScalar("generated", mGenerated);
+    recordScalar("exhausted", mExhausted);
+}
+
+void CertificatePool::receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t signal, bool, omnetpp::cObject*)
+{
+    // refill thread does not survive fork, each process continues with a thread of its own
+    if (signal == ReplicationFork::prepareSignal) {
+        stop();
+    } else if (signal == ReplicationFork::resumeSignal) {
+        start();
+    }
+}
+
+CertificatePool::Entry CertificatePool::acquire()
+{
+    // security entities may ask before this module has been initialized
+    prepare();
+    mClock.update(mTimer.getCurrentTime());
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    if (mEntries.empty()) {
+        lock.unlock();
+        ++mExhausted;
+        return generate();
+    }
+
+    Entry entry = std::move(mEntries.front());
+    mEntries.pop_front();
+    if (mEntries.size() < mLowWatermark) {
+        mCondition.notify_one();
+    }
+    return entry;
+}
+
+void CertificatePool::prepare()
+{
+    if (mPrepared) {
+        return;
+    }
+    mPrepared = true;
+
+    mTimer.setTimebase(par("datetime"));
+    mClock.update(mTimer.getCurrentTime());
+    const int capacity = par("size");
+    const int lowWatermark = par("lowWatermark");
+    if (capacity < 0 || lowWatermark < 0 || lowWatermark > capacity) {
+        throw omnetpp::cRuntimeError("certificate pool requires 0 <= lowWatermark <= size");
+    }
+    mCapacity = capacity;
+    mLowWatermark = lowWatermark;
+
+    const std::string poolFile = par("poolFile").stdstringValue();
+    if (!poolFile.empty()) {
+        load(poolFile);
+    }
+    // pre-generate synchronously, i.e. before any station is created
+    while (mEntries.size() < mCapacity) {
+        mEntries.push_back(generate());
+        ++mGenerated;
+    }
+    const std::string saveFile = par("savePoolFile").stdstringValue();
+    if (!saveFile.empty()) {
+        save(saveFile);
+    }
+
+    if (mLowWatermark > 0) {
+        getSystemModule()->subscribe(ReplicationFork::prepareSignal, this);
+        getSystemModule()->subscribe(ReplicationFork::resumeSignal, this);
+        start();
+    }
+}
+
+CertificatePool::Entry CertificatePool::generate()
+{
+    // each provider generates a fresh key pair and its authorization ticket signed by the shared AA
+    vs2::NaiveCertificateProvider provider(mClock);
+    return Entry { provider.own_certificate(), provider.own_private_key(), provider.own_chain() };
+}
+
+void CertificatePool::refill()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true) {
+        mCondition.wait(lock, [this] { return mStop || mEntries.size() < mLowWatermark; });
+        while (!mStop && mEntries.size() < mCapacity) {
+            lock.unlock();
+            Entry entry = generate();
+            lock.lock();
+            mEntries.push_back(std::move(entry));
+            ++mGenerated;
+        }
+        if (mStop) {
+            return;
+        }
+    }
+}
+
+void CertificatePool::start()
+{
+    if (!mThread.joinable()) {
+        mStop = false;
+        mThread = std::thread(&CertificatePool::refill, this);
+    }
+}
+
+void CertificatePool::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mCondition.notify_one();
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+}
+
+/*
+ * Pool files store magic "ARTERYCP", uint32 version, uint32 number of entries and then per entry
+ * its certificate, 32 bytes private key, uint32 chain length and the chain's certificates.
+ * Certificates are serialized like on the wire, numbers by boost's binary archive.
+ */
+void CertificatePool::load(const std::string& filename)
+{
+    std::ifstream stream(filename, std::ios::binary);
+    if (!stream) {
+        // pool file is yet to be written, e.g. by savePoolFile
+        EV_WARN << "certificate pool file " << filename << " not found, generating all tickets\n";
+        return;
+    }
+
+    try {
+        vanetza::InputArchive ar(stream, boost::archive::no_header);
+        char header[sizeof(magic)];
+        std::uint32_t fileVersion = 0;
+        std::uint32_t count = 0;
+        ar.load_binary(header, sizeof(header));
+        ar >> fileVersion;
+        if (std::memcmp(header, magic, sizeof(magic)) != 0 || fileVersion != version) {
+            throw omnetpp::cRuntimeError("certificate pool file %s has unknown format", filename.c_str());
+        }
+
+        ar >> count;
+        // tickets may have been saved for an earlier simulation date
+        const vs2::Time32 now = vs2::convert_time32(mClock.now());
+        std::uint32_t stale = 0;
+        for (std::uint32_t i = 0; i < count; ++i) {
+            Entry entry;
+            vs2::deserialize(ar, entry.certificate);
+            ar.load_binary(entry.privateKey.key.data(), entry.privateKey.key.size());
+            std::uint32_t chain = 0;
+            ar >> chain;
+            for (std::uint32_t j = 0; j < chain; ++j) {
+                entry.chain.emplace_back();
+                vs2::deserialize(ar, entry.chain.back());
+            }
+            if (isValidAt(entry, now)) {
+                mEntries.push_back(std::move(entry));
+            } else {
+                ++stale;
+            }
+        }
+        if (stale > 0) {
+            EV_WARN << "discarded " << stale << " expired tickets of certificate pool file " << filename << "\n";
+        }
+    } catch (const omnetpp::cRuntimeError&) {
+        throw;
+    } catch (const std::exception& e) {
+        throw omnetpp::cRuntimeError("cannot read certificate pool file %s: %s", filename.c_str(), e.what());
+    }
+}
+
+void CertificatePool::save(const std::string& filename)
+{
+    std::ofstream stream(filename, std::ios::binary | std::ios::trunc);
+    if (!stream) {
+        throw omnetpp::cRuntimeError("cannot write certificate pool file %s", filename.c_str());
+    }
+
+    vanetza::OutputArchive ar(stream, boost::archive::no_header);
+    const std::uint32_t count = mEntries.size();
+    ar.save_binary(magic, sizeof(magic));
+    ar << version;
+    ar << count;
+    for (const Entry& entry : mEntries) {
+        vs2::serialize(ar, entry.certificate);
+        ar.save_binary(entry.privateKey.key.data(), entry.privateKey.key.size());
+        const std::uint32_t chain = entry.chain.size();
+        ar << chain;
+        for (const vs2::Certificate& certificate : entry.chain) {
+            vs2::serialize(ar, certificate);
+        }
+    }
+}
+
+void CertificatePool::Clock::schedule(vanetza::Clock::time_point, const Callback&, const void*)
+{
+    throw omnetpp::cRuntimeError("CertificatePool does not support scheduling of callbacks");
+}
+
+void CertificatePool::Clock::schedule(vanetza::Clock::duration, const Callback&, const void*)
+{
+    throw omnetpp::cRuntimeError("CertificatePool does not support scheduling of callbacks");
+}
+
+void CertificatePool::Clock::cancel(const void*)
+{
+}
+
+vanetza::Clock::time_point CertificatePool::Clock::now() const
+{
+    return vanetza::Clock::time_point { vanetza::Clock::duration { mNow.load(std::memory_order_relaxed) } };
+}
+
+void CertificatePool::Clock::update(vanetza::Clock::time_point now)
+{
+    mNow.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+} // namespace artery
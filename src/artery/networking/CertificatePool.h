@@ -0,0 +1,102 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_CERTIFICATEPOOL_H_T5NCW8LB
+#define ARTERY_CERTIFICATEPOOL_H_T5NCW8LB
+
+#include "artery/application/Timer.h"
+#include <omnetpp/clistener.h>
+#include <omnetpp/csimplemodule.h>
+#include <vanetza/common/runtime.hpp>
+#include <vanetza/security/ecdsa256.hpp>
+#include <vanetza/security/v2/certificate.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace artery
+{
+
+/**
+ * CertificatePool is a network-level module handing out pre-generated authorization tickets.
+ *
+ * Generating a key pair and signing its authorization ticket is costly, i.e. creating
+ * a "Naive" certificate provider for each departing vehicle slows down node creation.
+ * Security entities with the "Pool" certificate provider take a ready ticket in O(1) instead.
+ * Tickets are signed like by vanetza's NaiveCertificateProvider and may be loaded from a pool file
+ * written by a previous run. A background thread tops up the pool while the simulation runs.
+ * This thread is stopped before ReplicationFork forks and restarted in every process afterwards.
+ */
+class CertificatePool : public omnetpp::cSimpleModule, public omnetpp::cListener
+{
+    public:
+        struct Entry
+        {
+            vanetza::security::v2::Certificate certificate;
+            vanetza::security::ecdsa256::PrivateKey privateKey;
+            std::list<vanetza::security::v2::Certificate> chain;
+        };
+
+        ~CertificatePool();
+
+        void initialize() override;
+        void finish() override;
+        void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, bool, omnetpp::cObject*) override;
+
+        /**
+         * Take an authorization ticket out of the pool
+         * \return ticket, generated on the spot if pool has run dry
+         */
+        Entry acquire();
+
+    private:
+        /**
+         * Clock of ticket generation, readable by the background thread.
+         * Its time is advanced by the simulation thread whenever a ticket is acquired.
+         */
+        class Clock : public vanetza::Runtime
+        {
+            public:
+                void schedule(vanetza::Clock::time_point, const Callback&, const void*) override;
+                void schedule(vanetza::Clock::duration, const Callback&, const void*) override;
+                void cancel(const void*) override;
+                vanetza::Clock::time_point now() const override;
+                void update(vanetza::Clock::time_point);
+
+            private:
+                std::atomic<vanetza::Clock::rep> mNow { 0 };
+        };
+
+        void prepare();
+        Entry generate();
+        void refill();
+        void start();
+        void stop();
+        void load(const std::string&);
+        void save(const std::string&);
+
+        Timer mTimer;
+        Clock mClock;
+        bool mPrepared = false;
+        std::size_t mCapacity = 0;
+        std::size_t mLowWatermark = 0;
+        unsigned long mGenerated = 0;
+        unsigned long mExhausted = 0;
+
+        std::deque<Entry> mEntries;
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::thread mThread;
+        bool mStop = false;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_CERTIFICATEPOOL_H_T5NCW8LB */
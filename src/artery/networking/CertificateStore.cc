@@ -0,0 +1,53 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/networking/CertificateStore.h"
+#include <omnetpp/cexception.h>
+
+namespace artery
+{
+
+Define_Module(CertificateStore)
+
+void CertificateStore::initialize()
+{
+    getCertificateCache();
+}
+
+vanetza::security::v2::CertificateCache& CertificateStore::getCertificateCache()
+{
+    if (!mCertificateCache) {
+        // security entities may ask before this module has been initialized
+        mTimer.setTimebase(par("datetime"));
+        mClock.reset(new Clock(mTimer));
+        mCertificateCache.reset(new vanetza::security::v2::CertificateCache(*mClock));
+    }
+    return *mCertificateCache;
+}
+
+CertificateStore::Clock::Clock(const Timer& timer) : mTimer(timer)
+{
+}
+
+void CertificateStore::Clock::schedule(vanetza::Clock::time_point, const Callback&, const void*)
+{
+    throw omnetpp::cRuntimeError("CertificateStore does not support scheduling of callbacks");
+}
+
+void CertificateStore::Clock::schedule(vanetza::Clock::duration, const Callback&, const void*)
+{
+    throw omnetpp::cRuntimeError("CertificateStore does not support scheduling of callbacks");
+}
+
+void CertificateStore::Clock::cancel(const void*)
+{
+}
+
+vanetza::Clock::time_point CertificateStore::Clock::now() const
+{
+    return mTimer.getCurrentTime();
+}
+
+} // namespace artery
@@ -0,0 +1,56 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_CERTIFICATESTORE_H_V9KD3QWM
+#define ARTERY_CERTIFICATESTORE_H_V9KD3QWM
+
+#include "artery/application/Timer.h"
+#include <omnetpp/csimplemodule.h>
+#include <vanetza/common/runtime.hpp>
+#include <vanetza/security/v2/certificate_cache.hpp>
+#include <memory>
+
+namespace artery
+{
+
+/**
+ * CertificateStore is a network-level module sharing a certificate cache among all security entities.
+ *
+ * Without a store, every station caches the certificates of its neighbours on its own.
+ * Stations' own key pairs and certificates are not affected, they stay with each station.
+ */
+class CertificateStore : public omnetpp::cSimpleModule
+{
+    public:
+        void initialize() override;
+
+        vanetza::security::v2::CertificateCache& getCertificateCache();
+
+    private:
+        /**
+         * Clock of certificate cache, identical to stations' runtimes with the same time base.
+         * Callbacks cannot be scheduled, they are not used by the cache.
+         */
+        class Clock : public vanetza::Runtime
+        {
+            public:
+                explicit Clock(const Timer&);
+                void schedule(vanetza::Clock::time_point, const Callback&, const void*) override;
+                void schedule(vanetza::Clock::duration, const Callback&, const void*) override;
+                void cancel(const void*) override;
+                vanetza::Clock::time_point now() const override;
+
+            private:
+                const Timer& mTimer;
+        };
+
+        Timer mTimer;
+        std::unique_ptr<Clock> mClock;
+        std::unique_ptr<vanetza::security::v2::CertificateCache> mCertificateCache;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_CERTIFICATESTORE_H_V9KD3QWM */
@@ -0,0 +1,134 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/networking/DccController.h"
+#include <cmath>
+
+namespace artery
+{
+
+Define_Module(DccController)
+
+using namespace omnetpp;
+
+DccController::Client::~Client()
+{
+    if (mController) {
+        mController->cancel(this);
+    }
+}
+
+DccController::~DccController()
+{
+    cancelAndDelete(mTrigger);
+    for (auto& bucket : mBuckets) {
+        for (Client* client : bucket.second) {
+            client->mController = nullptr;
+        }
+    }
+    for (Client* client : mExpiring) {
+        if (client) {
+            client->mController = nullptr;
+        }
+    }
+}
+
+void DccController::initialize()
+{
+    mGranularity = par("granularity");
+    if (mGranularity < SIMTIME_ZERO) {
+        throw cRuntimeError("granularity of DCC controller must not be negative");
+    }
+    mTrigger = new cMessage("DCC controller");
+}
+
+void DccController::handleMessage(cMessage* msg)
+{
+    if (msg != mTrigger) {
+        throw cRuntimeError("unexpected message");
+    }
+
+    auto bucket = mBuckets.begin();
+    ASSERT(bucket != mBuckets.end() && bucket->first == simTime());
+    mExpiringDue = bucket->first;
+    mExpiring = std::move(bucket->second);
+    mBuckets.erase(bucket);
+
+    // clients are detached before being drained, thus they may request their next wake-up meanwhile
+    for (std::size_t i = 0; i < mExpiring.size(); ++i) {
+        Client* client = mExpiring[i];
+        if (client) {
+            mExpiring[i] = nullptr;
+            client->mController = nullptr;
+            client->drainFlowControl();
+        }
+    }
+
+    mExpiring.clear();
+    scheduleBucket();
+}
+
+void DccController::wake(Client* client, simtime_t due)
+{
+    Enter_Method_Silent();
+    ASSERT(client);
+    due = roundUp(due);
+    if (due < simTime()) {
+        throw cRuntimeError("DCC controller cannot wake clients in the past");
+    } else if (client->mController == this && client->mDue == due) {
+        return;
+    }
+
+    cancel(client);
+    Bucket& bucket = mBuckets[due];
+    client->mController = this;
+    client->mDue = due;
+    client->mSlot = bucket.size();
+    bucket.push_back(client);
+    scheduleBucket();
+}
+
+void DccController::cancel(Client* client)
+{
+    Enter_Method_Silent();
+    ASSERT(client);
+    if (client->mController != this) {
+        return;
+    }
+
+    if (client->mDue == mExpiringDue && client->mSlot < mExpiring.size() && mExpiring[client->mSlot] == client) {
+        // keep slots of expiring bucket stable while draining its clients
+        mExpiring[client->mSlot] = nullptr;
+    } else {
+        auto found = mBuckets.find(client->mDue);
+        ASSERT(found != mBuckets.end());
+        Bucket& bucket = found->second;
+        ASSERT(bucket[client->mSlot] == client);
+        bucket[client->mSlot] = bucket.back();
+        bucket[client->mSlot]->mSlot = client->mSlot;
+        bucket.pop_back();
+        if (bucket.empty()) {
+            mBuckets.erase(found);
+        }
+    }
+    client->mController = nullptr;
+}
+
+simtime_t DccController::roundUp(simtime_t t) const
+{
+    return mGranularity > SIMTIME_ZERO ? std::ceil(t / mGranularity) * mGranularity : t;
+}
+
+void DccController::scheduleBucket()
+{
+    if (mBuckets.empty()) {
+        cancelEvent(mTrigger);
+    } else if (!mTrigger->isScheduled() || mTrigger->getArrivalTime() != mBuckets.begin()->first) {
+        cancelEvent(mTrigger);
+        scheduleAt(mBuckets.begin()->first, mTrigger);
+    }
+}
+
+} // namespace artery
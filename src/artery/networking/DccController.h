@@ -0,0 +1,82 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_DCCCONTROLLER_H_M2QWZ8TD
+#define ARTERY_DCCCONTROLLER_H_M2QWZ8TD
+
+#include <omnetpp/cmessage.h>
+#include <omnetpp/csimplemodule.h>
+#include <omnetpp/simtime.h>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+namespace artery
+{
+
+/**
+ * DccController drains the flow control queues of many stations by a single timer.
+ *
+ * Each client requests one wake-up at a time, e.g. when its transmit rate control opens the gate
+ * for a queued packet or when queued packets expire. Clients due at the same instant are
+ * woken one after another within one event, optionally wake-ups are rounded up to a granularity.
+ */
+class DccController : public omnetpp::cSimpleModule
+{
+public:
+    class Client
+    {
+    public:
+        Client() = default;
+        Client(const Client&) = delete;
+        Client& operator=(const Client&) = delete;
+        virtual ~Client();
+
+        /**
+         * Serve queued packets, invoked by controller in context of its wake-up event
+         */
+        virtual void drainFlowControl() = 0;
+
+    private:
+        friend class DccController;
+        DccController* mController = nullptr; /*< set while a wake-up is pending */
+        omnetpp::simtime_t mDue;
+        std::size_t mSlot = 0;
+    };
+
+    ~DccController();
+
+    void initialize() override;
+    void handleMessage(omnetpp::cMessage*) override;
+
+    /**
+     * Request wake-up of client, replaces its pending wake-up
+     * \param client flow control to be drained
+     * \param due time of wake-up, rounded up to granularity
+     */
+    void wake(Client* client, omnetpp::simtime_t due);
+
+    /**
+     * Cancel pending wake-up of client (if any)
+     * \param client flow control
+     */
+    void cancel(Client* client);
+
+private:
+    using Bucket = std::vector<Client*>;
+
+    omnetpp::simtime_t roundUp(omnetpp::simtime_t) const;
+    void scheduleBucket();
+
+    omnetpp::simtime_t mGranularity;
+    omnetpp::cMessage* mTrigger = nullptr;
+    std::map<omnetpp::simtime_t, Bucket> mBuckets;
+    Bucket mExpiring; /*< clients of expiring bucket, slots of woken clients are null */
+    omnetpp::simtime_t mExpiringDue;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_DCCCONTROLLER_H_M2QWZ8TD */
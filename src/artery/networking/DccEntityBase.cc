@@ -1,4 +1,5 @@
 #include "artery/application/Middleware.h"
+#include "artery/networking/DccController.h"
 #include "artery/networking/DccEntityBase.h"
 #include "artery/networking/Router.h"
 #include "artery/networking/Runtime.h"
@@ -8,12 +9,16 @@
 #include "inet/common/ModuleAccess.h"
 #include <vanetza/dcc/hooked_channel_probe_processor.hpp>
 #include <vanetza/dcc/smoothing_channel_probe_processor.hpp>
+#include <chrono>
 
 using namespace omnetpp;
 
 namespace artery
 {
 
+static const simsignal_t scPacketExpiredSignal = cComponent::registerSignal("DccPacketExpired");
+static const simsignal_t scQueueOverflowSignal = cComponent::registerSignal("DccQueueOverflow");
+
 void DccEntityBase::initialize(int stage)
 {
     if (stage == InitStages::Prepare) {
@@ -30,8 +35,23 @@ void DccEntityBase::initialize(int stage)
         initializeNetworkEntity(par("NetworkEntity"));
         initializeTransmitRateControl();
         auto trc = notNullPtr(getTransmitRateControl());
-        mFlowControl.reset(new vanetza::dcc::FlowControl(*mRuntime, *trc, *mAccessInterface));
-        mFlowControl->queue_length(par("queueLength"));
+        if (par("expiringFlowControl")) {
+            using namespace std::chrono;
+            auto controller = inet::findModuleFromPar<DccController>(par("dccControllerModule"), this, false);
+            const SimTime width = par("expiryBucketWidth");
+            const int buckets = par("expiryBuckets");
+            if (buckets < 1) {
+                error("expiryBuckets has to be at least 1");
+            }
+            mExpiringFlowControl.reset(new ExpiringFlowControl(*mRuntime, *trc, *mAccessInterface, controller,
+                    duration_cast<vanetza::Clock::duration>(microseconds(width.inUnit(SIMTIME_US))), buckets));
+            mExpiringFlowControl->queueLength(par("queueLength"));
+            mExpiringFlowControl->setDropHook(std::bind(&DccEntityBase::onPacketDropped, this,
+                    std::placeholders::_1, std::placeholders::_2));
+        } else {
+            mFlowControl.reset(new vanetza::dcc::FlowControl(*mRuntime, *trc, *mAccessInterface));
+            mFlowControl->queue_length(par("queueLength"));
+        }
     }
 }
 
@@ -43,11 +63,21 @@ int DccEntityBase::numInitStages() const
 void DccEntityBase::finish()
 {
     // free those objects before runtime vanishes
+    mExpiringFlowControl.reset();
     mFlowControl.reset();
     mNetworkEntity.reset();
     mCbrProcessor.reset();
 }
 
+vanetza::dcc::RequestInterface* DccEntityBase::getRequestInterface()
+{
+    if (mExpiringFlowControl) {
+        return mExpiringFlowControl.get();
+    } else {
+        return mFlowControl.get();
+    }
+}
+
 void DccEntityBase::receiveSignal(cComponent*, simsignal_t signal, double value, cObject*)
 {
     if (signal == RadioDriverBase::ChannelLoadSignal) {
@@ -68,6 +98,7 @@ void DccEntityBase::initializeNetworkEntity(const std::string& name)
         using namespace vanetza;
         const auto& loct = mRouter->getLocationTable();
         const UnitInterval delay { uniform(0.0, 1.0) };
+        // vanetza aggregates the neighbours' CBR once per interval, global CBR is cached until then
         mNetworkEntity.reset(new geonet::DccInformationSharing(*mRuntime, loct, mTargetCbr, delay));
         mNetworkEntity->on_global_cbr_update = [this](const geonet::CbrAggregator& cbr) {
             this->onGlobalCbr(cbr.get_global_cbr());
@@ -99,6 +130,18 @@ void DccEntityBase::reportLocalChannelLoad(vanetza::dcc::ChannelLoad cbr)
     mCbrProcessor->indicate(cbr);
 }
 
+void DccEntityBase::onPacketDropped(const vanetza::dcc::DataRequest& request, ExpiringFlowControl::DropReason reason)
+{
+    // packets expire in context of DCC controller
+    Enter_Method_Silent();
+    const long profile = static_cast<long>(request.dcc_profile);
+    if (reason == ExpiringFlowControl::DropReason::Expired) {
+        emit(scPacketExpiredSignal, profile);
+    } else {
+        emit(scQueueOverflowSignal, profile);
+    }
+}
+
 void DccEntityBase::onLocalCbr(vanetza::dcc::ChannelLoad cbr)
 {
     if (mNetworkEntity) {
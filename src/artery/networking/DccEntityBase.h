@@ -2,6 +2,7 @@
 #define ARTERY_DCCENTITYBASE_H_VLQQNLKF
 
 #include "artery/networking/AccessInterface.h"
+#include "artery/networking/ExpiringFlowControl.h"
 #include "artery/networking/IDccEntity.h"
 #include <vanetza/dcc/flow_control.hpp>
 #include <vanetza/geonet/dcc_information_sharing.hpp>
@@ -28,7 +29,7 @@ public:
 
     // IDccEntity
     vanetza::dcc::ChannelProbeProcessor* getChannelProbeProcessor() override { return mCbrProcessor.get(); }
-    vanetza::dcc::RequestInterface* getRequestInterface() override { return mFlowControl.get(); }
+    vanetza::dcc::RequestInterface* getRequestInterface() override;
     vanetza::geonet::DccFieldGenerator* getGeonetFieldGenerator() override { return mNetworkEntity.get(); }
     void reportLocalChannelLoad(vanetza::dcc::ChannelLoad) override;
 
@@ -40,10 +41,12 @@ protected:
     virtual void onLocalCbr(vanetza::dcc::ChannelLoad);
     virtual void onGlobalCbr(vanetza::dcc::ChannelLoad) = 0;
     virtual vanetza::dcc::TransmitRateControl* getTransmitRateControl() = 0;
+    virtual void onPacketDropped(const vanetza::dcc::DataRequest&, ExpiringFlowControl::DropReason);
 
     std::unique_ptr<vanetza::dcc::ChannelProbeProcessor> mCbrProcessor;
     std::unique_ptr<vanetza::geonet::DccInformationSharing> mNetworkEntity;
     std::unique_ptr<vanetza::dcc::FlowControl> mFlowControl;
+    std::unique_ptr<ExpiringFlowControl> mExpiringFlowControl;
     vanetza::dcc::ChannelLoad mTargetCbr;
     Router* mRouter;
     vanetza::Runtime* mRuntime;
@@ -0,0 +1,234 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/networking/ExpiringFlowControl.h"
+#include <omnetpp/cexception.h>
+#include <omnetpp/csimulation.h>
+#include <vanetza/dcc/mapping.hpp>
+#include <vanetza/dcc/transmission.hpp>
+#include <algorithm>
+#include <chrono>
+
+using vanetza::Clock;
+using vanetza::ChunkPacket;
+using vanetza::access::AccessCategory;
+using vanetza::dcc::DataRequest;
+using vanetza::dcc::TransmissionLite;
+
+namespace artery
+{
+
+ExpiringFlowControl::ExpiringFlowControl(vanetza::Runtime& runtime, vanetza::dcc::TransmitRateControl& trc,
+        vanetza::access::Interface& access, DccController* controller, Clock::duration bucketWidth, std::size_t buckets) :
+    mRuntime(runtime), mTrc(trc), mAccess(access), mController(controller), mBucketWidth(bucketWidth), mWheel(buckets)
+{
+    if (mBucketWidth <= Clock::duration::zero()) {
+        throw omnetpp::cRuntimeError("expiry bucket width has to be positive");
+    } else if (buckets < 1) {
+        throw omnetpp::cRuntimeError("flow control requires at least one expiry bucket");
+    }
+    mExpiredBucket = mRuntime.now().time_since_epoch() / mBucketWidth;
+}
+
+ExpiringFlowControl::~ExpiringFlowControl()
+{
+    if (mController) {
+        mController->cancel(this);
+    } else {
+        mRuntime.cancel(this);
+    }
+}
+
+void ExpiringFlowControl::request(const DataRequest& request, std::unique_ptr<ChunkPacket> packet)
+{
+    const Clock::time_point now = mRuntime.now();
+    expire(now);
+
+    const std::size_t index = getQueueIndex(request);
+    Queue& queue = mQueues[index];
+    const TransmissionLite transmission { request.dcc_profile, packet->size() };
+    // like vanetza's FlowControl: packets queued with equal or higher priority go first
+    const bool contention = std::any_of(mQueues.begin(), mQueues.begin() + index + 1,
+            [](const Queue& queue) { return !queue.empty(); });
+    if (!contention && mTrc.delay(transmission) == Clock::duration::zero()) {
+        transmit(request, std::move(packet));
+        return;
+    }
+
+    const Clock::time_point expiry = now + request.lifetime;
+    if (mQueueLength == 0 || expiry <= now) {
+        if (mDropHook) {
+            mDropHook(request, mQueueLength == 0 ? DropReason::Overflow : DropReason::Expired);
+        }
+        return;
+    } else if (queue.size() >= mQueueLength) {
+        drop(queue.begin(), DropReason::Overflow);
+    }
+
+    auto pending = queue.insert(queue.end(), Pending {});
+    pending->request = request;
+    pending->packet = std::move(packet);
+    pending->expiry = expiry;
+    pending->queue = index;
+    pending->slot = getBucket(expiry) % mWheel.size();
+    pending->position = mWheel[pending->slot].size();
+    mWheel[pending->slot].push_back(pending);
+    ++mWheelLength;
+    scheduleWakeup();
+}
+
+void ExpiringFlowControl::drainFlowControl()
+{
+    drain();
+}
+
+void ExpiringFlowControl::drain()
+{
+    const Clock::time_point now = mRuntime.now();
+    expire(now);
+
+    // serve packets by descending priority as long as the gate stays open
+    bool served = true;
+    while (served) {
+        served = false;
+        for (Queue& queue : mQueues) {
+            if (queue.empty()) {
+                continue;
+            }
+
+            Pending& head = queue.front();
+            if (head.expiry <= now) {
+                // expired within a bucket not yet due
+                drop(queue.begin(), DropReason::Expired);
+                served = true;
+                break;
+            }
+
+            const TransmissionLite transmission { head.request.dcc_profile, head.packet->size() };
+            if (mTrc.delay(transmission) == Clock::duration::zero()) {
+                const DataRequest request = head.request;
+                std::unique_ptr<ChunkPacket> packet = std::move(head.packet);
+                unlink(queue.begin());
+                transmit(request, std::move(packet));
+                served = true;
+                break;
+            }
+        }
+    }
+
+    scheduleWakeup();
+}
+
+void ExpiringFlowControl::expire(Clock::time_point now)
+{
+    const std::int64_t current = now.time_since_epoch() / mBucketWidth;
+    // a full revolution visits every bucket once
+    const std::int64_t wheel = mWheel.size();
+    for (std::int64_t bucket = std::max(mExpiredBucket + 1, current + 1 - wheel);
+            bucket <= current && mWheelLength > 0; ++bucket) {
+        auto& entries = mWheel[bucket % wheel];
+        // entries of later revolutions share this bucket and are kept
+        for (std::size_t i = entries.size(); i > 0; --i) {
+            if (entries[i - 1]->expiry <= now) {
+                drop(entries[i - 1], DropReason::Expired);
+            }
+        }
+    }
+    mExpiredBucket = std::max(mExpiredBucket, current);
+}
+
+void ExpiringFlowControl::drop(Queue::iterator pending, DropReason reason)
+{
+    if (mDropHook) {
+        mDropHook(pending->request, reason);
+    }
+    unlink(pending);
+}
+
+void ExpiringFlowControl::unlink(Queue::iterator pending)
+{
+    auto& entries = mWheel[pending->slot];
+    entries[pending->position] = entries.back();
+    entries[pending->position]->position = pending->position;
+    entries.pop_back();
+    --mWheelLength;
+    mQueues[pending->queue].erase(pending);
+}
+
+void ExpiringFlowControl::transmit(const DataRequest& request, std::unique_ptr<ChunkPacket> packet)
+{
+    const TransmissionLite transmission { request.dcc_profile, packet->size() };
+    mTrc.notify(transmission);
+
+    vanetza::access::DataRequest access;
+    access.source_addr = request.source;
+    access.destination_addr = request.destination;
+    access.ether_type = request.ether_type;
+    access.access_category = vanetza::dcc::map_profile_onto_ac(request.dcc_profile);
+    mAccess.request(access, std::move(packet));
+}
+
+void ExpiringFlowControl::scheduleWakeup()
+{
+    const Clock::time_point now = mRuntime.now();
+    Clock::time_point wakeup = Clock::time_point::max();
+
+    // gate opening for head of any queue
+    for (const Queue& queue : mQueues) {
+        if (!queue.empty()) {
+            const Pending& head = queue.front();
+            const TransmissionLite transmission { head.request.dcc_profile, head.packet->size() };
+            wakeup = std::min(wakeup, now + mTrc.delay(transmission));
+        }
+    }
+
+    // next occupied expiry bucket, its entries may belong to later revolutions yet
+    const std::int64_t wheel = mWheel.size();
+    for (std::int64_t bucket = mExpiredBucket + 1; mWheelLength > 0 && bucket <= mExpiredBucket + wheel; ++bucket) {
+        if (!mWheel[bucket % wheel].empty()) {
+            wakeup = std::min(wakeup, Clock::time_point { bucket * mBucketWidth });
+            break;
+        }
+    }
+
+    if (wakeup == Clock::time_point::max()) {
+        if (mController) {
+            mController->cancel(this);
+        } else {
+            mRuntime.cancel(this);
+        }
+    } else if (mController) {
+        using namespace std::chrono;
+        const auto delay = duration_cast<microseconds>(wakeup - now);
+        mController->wake(this, omnetpp::simTime() + omnetpp::SimTime { delay.count(), omnetpp::SIMTIME_US });
+    } else {
+        mRuntime.cancel(this);
+        mRuntime.schedule(wakeup, [this](Clock::time_point) { drain(); }, this);
+    }
+}
+
+std::size_t ExpiringFlowControl::getQueueIndex(const DataRequest& request) const
+{
+    switch (vanetza::dcc::map_profile_onto_ac(request.dcc_profile)) {
+        case AccessCategory::VO:
+            return 0;
+        case AccessCategory::VI:
+            return 1;
+        case AccessCategory::BE:
+            return 2;
+        case AccessCategory::BK:
+        default:
+            return 3;
+    }
+}
+
+std::int64_t ExpiringFlowControl::getBucket(Clock::time_point expiry) const
+{
+    // bucket is due once its packets have expired, i.e. round up
+    const auto since = expiry.time_since_epoch();
+    return (since + mBucketWidth - Clock::duration { 1 }) / mBucketWidth;
+}
+
+} // namespace artery
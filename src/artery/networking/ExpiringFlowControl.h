@@ -0,0 +1,107 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_EXPIRINGFLOWCONTROL_H_J6VRN3XA
+#define ARTERY_EXPIRINGFLOWCONTROL_H_J6VRN3XA
+
+#include "artery/networking/DccController.h"
+#include <vanetza/access/interface.hpp>
+#include <vanetza/common/clock.hpp>
+#include <vanetza/common/runtime.hpp>
+#include <vanetza/dcc/data_request.hpp>
+#include <vanetza/dcc/interface.hpp>
+#include <vanetza/dcc/transmit_rate_control.hpp>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <vector>
+
+namespace artery
+{
+
+/**
+ * ExpiringFlowControl queues packets per access category like vanetza::dcc::FlowControl,
+ * but drops packets as soon as their lifetime has passed.
+ *
+ * Queued packets are additionally hashed by their expiry into the buckets of a small timing wheel,
+ * so dropping an expired packet is O(1) and does not wait for its dequeue attempt.
+ * Bucket boundaries are aligned for all stations, i.e. wake-ups for expiry coincide at the network level.
+ * With a DccController, all stations due at the same instant are drained within a single event,
+ * otherwise wake-ups are scheduled at the station's runtime.
+ */
+class ExpiringFlowControl : public vanetza::dcc::RequestInterface, private DccController::Client
+{
+public:
+    enum class DropReason { Expired, Overflow };
+    using DropHook = std::function<void(const vanetza::dcc::DataRequest&, DropReason)>;
+
+    /**
+     * \param runtime station's runtime
+     * \param trc transmit rate control gating packets
+     * \param access interface for transmission of ready packets
+     * \param controller optional DCC controller scheduling all wake-ups
+     * \param bucketWidth time span of each expiry bucket
+     * \param buckets number of expiry buckets, later expiries wrap around
+     */
+    ExpiringFlowControl(vanetza::Runtime& runtime, vanetza::dcc::TransmitRateControl& trc,
+            vanetza::access::Interface& access, DccController* controller,
+            vanetza::Clock::duration bucketWidth, std::size_t buckets);
+    ~ExpiringFlowControl();
+
+    void request(const vanetza::dcc::DataRequest&, std::unique_ptr<vanetza::ChunkPacket>) override;
+
+    /**
+     * Set maximum number of packets queued per access category, exceeding packets drop the oldest one
+     */
+    void queueLength(std::size_t length) { mQueueLength = length; }
+
+    /**
+     * Set hook invoked for each dropped packet
+     */
+    void setDropHook(DropHook hook) { mDropHook = std::move(hook); }
+
+private:
+    struct Pending
+    {
+        vanetza::dcc::DataRequest request;
+        std::unique_ptr<vanetza::ChunkPacket> packet;
+        vanetza::Clock::time_point expiry;
+        std::size_t queue; /*< index of access category's queue */
+        std::size_t slot; /*< expiry bucket in wheel */
+        std::size_t position; /*< index within expiry bucket */
+    };
+    using Queue = std::list<Pending>;
+
+    // DccController::Client
+    void drainFlowControl() override;
+
+    void drain();
+    void expire(vanetza::Clock::time_point now);
+    void drop(Queue::iterator, DropReason);
+    void unlink(Queue::iterator);
+    void transmit(const vanetza::dcc::DataRequest&, std::unique_ptr<vanetza::ChunkPacket>);
+    void scheduleWakeup();
+    std::size_t getQueueIndex(const vanetza::dcc::DataRequest&) const;
+    std::int64_t getBucket(vanetza::Clock::time_point) const;
+
+    vanetza::Runtime& mRuntime;
+    vanetza::dcc::TransmitRateControl& mTrc;
+    vanetza::access::Interface& mAccess;
+    DccController* mController;
+    vanetza::Clock::duration mBucketWidth;
+    std::size_t mQueueLength = 2;
+    DropHook mDropHook;
+
+    std::array<Queue, 4> mQueues; /*< ordered by descending priority, i.e. VO, VI, BE, BK */
+    std::vector<std::vector<Queue::iterator>> mWheel;
+    std::int64_t mExpiredBucket; /*< buckets up to this one have been checked for expired packets */
+    std::size_t mWheelLength = 0;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_EXPIRINGFLOWCONTROL_H_J6VRN3XA */
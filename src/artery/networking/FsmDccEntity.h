@@ -10,6 +10,13 @@
 namespace artery
 {
 
+/**
+ * FsmDccEntity controls transmit rates by one of ETSI's reactive DCC state machines.
+ *
+ * The state machine has no timer of its own but is evaluated whenever a channel load is reported.
+ * With a ChannelLoadReporter (see World's withChannelLoadReporter), the state machines
+ * of all stations are thus evaluated one after another within the reporter's single event.
+ */
 class FsmDccEntity : public DccEntityBase
 {
 public:
@@ -1,4 +1,5 @@
 #include "artery/networking/GeoNetPacket.h"
+#include "artery/utility/FreeList.h"
 
 Register_Class(artery::GeoNetPacket)
 
@@ -14,28 +15,28 @@ GeoNetPacket& GeoNetPacket::operator=(const GeoNetPacket& other)
 {
     if (&other != this) {
         cPacket::operator=(other);
-        if (other.mPayload) {
-            mPayload.reset(new vanetza::PacketVariant(*other.mPayload));
-        } else {
-            mPayload.reset();
-        }
+        mPayload = other.mPayload;
+        mSourceAddress = other.mSourceAddress;
+        mDestinationAddress = other.mDestinationAddress;
     }
     return *this;
 }
 
 void GeoNetPacket::setPayload(std::unique_ptr<vanetza::PacketVariant> payload)
 {
-    mPayload = std::move(payload);
+    if (payload) {
+        // never assign to a payload which might be shared with copies
+        mPayload = std::allocate_shared<PayloadPtr>(FreeListAllocator<PayloadPtr>(), std::move(payload));
+    } else {
+        mPayload.reset();
+    }
 }
 
 void GeoNetPacket::setPayload(std::unique_ptr<vanetza::CohesivePacket> payload)
 {
     if (payload) {
-        if (mPayload) {
-            *mPayload = std::move(*payload);
-        } else {
-            mPayload.reset(new vanetza::PacketVariant(std::move(*payload)));
-        }
+        // never assign to a payload which might be shared with copies
+        setPayload(PayloadPtr { new vanetza::PacketVariant(std::move(*payload)) });
     } else {
         mPayload.reset();
     }
@@ -44,11 +45,7 @@ void GeoNetPacket::setPayload(std::unique_ptr<vanetza::CohesivePacket> payload)
 void GeoNetPacket::setPayload(std::unique_ptr<vanetza::ChunkPacket> payload)
 {
     if (payload) {
-        if (mPayload) {
-            *mPayload = std::move(*payload);
-        } else {
-            mPayload.reset(new vanetza::PacketVariant(std::move(*payload)));
-        }
+        setPayload(PayloadPtr { new vanetza::PacketVariant(std::move(*payload)) });
     } else {
         mPayload.reset();
     }
@@ -59,7 +56,7 @@ const vanetza::PacketVariant& GeoNetPacket::getPayload() const
     if (!mPayload) {
         throw omnetpp::cRuntimeError("No payload assigned to GeoNetPacket");
     }
-    return *mPayload;
+    return **mPayload;
 }
 
 bool GeoNetPacket::hasPayload() const
@@ -69,14 +66,23 @@ bool GeoNetPacket::hasPayload() const
 
 std::unique_ptr<vanetza::PacketVariant> GeoNetPacket::extractPayload() &&
 {
-    return std::move(mPayload);
+    PayloadPtr payload;
+    if (mPayload.use_count() == 1) {
+        // sole owner: release payload without touching its buffers
+        payload = std::move(*mPayload);
+    } else if (mPayload) {
+        // vanetza's router modifies its packets, thus copies may not share them
+        payload.reset(new vanetza::PacketVariant(**mPayload));
+    }
+    mPayload.reset();
+    return payload;
 }
 
 int64_t GeoNetPacket::getBitLength() const
 {
     int64_t length = omnetpp::cPacket::getBitLength();
     if (mPayload) {
-        length += size(*mPayload) * 8;
+        length += size(**mPayload) * 8;
     }
     return length;
 }
@@ -86,4 +92,14 @@ omnetpp::cPacket* GeoNetPacket::dup() const
     return new GeoNetPacket(*this);
 }
 
+void* GeoNetPacket::operator new(std::size_t size)
+{
+    return FreeList<sizeof(GeoNetPacket)>::allocate(size);
+}
+
+void GeoNetPacket::operator delete(void* ptr, std::size_t size) noexcept
+{
+    FreeList<sizeof(GeoNetPacket)>::deallocate(ptr, size);
+}
+
 } // namespace artery
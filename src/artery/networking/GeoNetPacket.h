@@ -1,13 +1,22 @@
 #ifndef ARTERY_GEONETPACKET_H_OT36RUH0
 #define ARTERY_GEONETPACKET_H_OT36RUH0
 
+#include <vanetza/net/mac_address.hpp>
 #include <vanetza/net/packet_variant.hpp>
 #include <omnetpp/cpacket.h>
+#include <cstddef>
 #include <memory>
 
 namespace artery
 {
 
+/**
+ * GeoNetPacket wraps a vanetza packet for transfer between OMNeT++ modules.
+ *
+ * Copies of a GeoNetPacket share their payload, e.g. when a radio medium duplicates a frame
+ * for each receiver. A shared payload is never modified, extraction copies it if necessary.
+ * Link layer addresses of received packets are set by radio drivers.
+ */
 class GeoNetPacket : public omnetpp::cPacket
 {
     public:
@@ -24,13 +33,34 @@ class GeoNetPacket : public omnetpp::cPacket
         void setPayload(std::unique_ptr<vanetza::ChunkPacket>);
         const vanetza::PacketVariant& getPayload() const;
         bool hasPayload() const;
+
+        /**
+         * Extract payload for exclusive use, e.g. by a vanetza router
+         *
+         * The sole owner hands over its payload as is, i.e. neither copied nor moved.
+         * Payload is only copied if it is still shared with other GeoNetPacket copies.
+         * \return payload (maybe nullptr)
+         */
         std::unique_ptr<vanetza::PacketVariant> extractPayload() &&;
 
+        void setSourceAddress(const vanetza::MacAddress& addr) { mSourceAddress = addr; }
+        const vanetza::MacAddress& getSourceAddress() const { return mSourceAddress; }
+        void setDestinationAddress(const vanetza::MacAddress& addr) { mDestinationAddress = addr; }
+        const vanetza::MacAddress& getDestinationAddress() const { return mDestinationAddress; }
+
         int64_t getBitLength() const override;
         omnetpp::cPacket* dup() const override;
 
+        // packets are recycled by a free list because they are created and deleted at high rates
+        static void* operator new(std::size_t);
+        static void operator delete(void*, std::size_t) noexcept;
+
     private:
-        std::unique_ptr<vanetza::PacketVariant> mPayload;
+        // shared holder allows the sole owner to release the payload itself
+        using PayloadPtr = std::unique_ptr<vanetza::PacketVariant>;
+        std::shared_ptr<PayloadPtr> mPayload;
+        vanetza::MacAddress mSourceAddress;
+        vanetza::MacAddress mDestinationAddress;
 };
 
 } // namespace artery
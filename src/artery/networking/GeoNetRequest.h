@@ -2,7 +2,9 @@
 #define ARTERY_GEONETREQUEST_H_WMCTXM3I
 
 #include <omnetpp/cobject.h>
+#include "artery/utility/FreeList.h"
 #include <vanetza/access/data_request.hpp>
+#include <cstddef>
 
 namespace artery
 {
@@ -15,8 +17,22 @@ class GeoNetRequest : public omnetpp::cObject, public vanetza::access::DataReque
         }
 
         GeoNetRequest* dup() const override { return new GeoNetRequest(*this); }
+
+        // one request per transmitted frame, deleted by radio drivers
+        static void* operator new(std::size_t);
+        static void operator delete(void*, std::size_t) noexcept;
 };
 
+inline void* GeoNetRequest::operator new(std::size_t size)
+{
+    return FreeList<sizeof(GeoNetRequest)>::allocate(size);
+}
+
+inline void GeoNetRequest::operator delete(void* ptr, std::size_t size) noexcept
+{
+    FreeList<sizeof(GeoNetRequest)>::deallocate(ptr, size);
+}
+
 } // namespace artery
 
 #endif /* ARTERY_GEONETREQUEST_H_WMCTXM3I */
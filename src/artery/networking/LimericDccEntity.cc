@@ -50,4 +50,4 @@ void LimericDccEntity::onGlobalCbr(vanetza::dcc::ChannelLoad cbr)
     mAlgorithm->update_cbr(cbr);
 }
 
-} // namespace arterd
+} // namespace artery
@@ -9,6 +9,12 @@
 namespace artery
 {
 
+/**
+ * LimericDccEntity adapts transmit rates by vanetza's LIMERIC implementation.
+ *
+ * Channel loads are passed to the algorithm when reported, its duty cycle is
+ * computed by vanetza::dcc::Limeric at its own pace using the station's runtime.
+ */
 class LimericDccEntity : public DccEntityBase
 {
 public:
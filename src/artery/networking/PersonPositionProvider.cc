@@ -15,6 +15,7 @@ void PersonPositionProvider::initialize(int stage)
 {
     if (stage == InitStages::Prepare) {
         mRuntime = inet::getModuleFromPar<Runtime>(par("runtimeModule"), this);
+        mThrottle.configure(par("updateDistance"), par("maxUpdateInterval"));
         auto& mobilityPar = par("mobilityModule");
         auto* mobilityModule = getModuleByPath(mobilityPar);
         if (mobilityModule) {
@@ -40,7 +41,8 @@ int PersonPositionProvider::numInitStages() const
 
 void PersonPositionProvider::receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t signal, omnetpp::cObject*, omnetpp::cObject*)
 {
-    if (signal == MobilityBase::stateChangedSignal && mPersonController) {
+    if (signal == MobilityBase::stateChangedSignal && mPersonController &&
+            mThrottle.isDue(mPersonController->getPosition(), omnetpp::simTime())) {
         updatePosition();
     }
 }
@@ -50,6 +52,7 @@ void PersonPositionProvider::updatePosition()
     using namespace vanetza::units;
     static const TrueNorth north;
 
+    mThrottle.updated(mPersonController->getPosition(), omnetpp::simTime());
     auto geopos = mPersonController->getGeoPosition();
     mPositionFix.timestamp = mRuntime->now();
     mPositionFix.latitude = geopos.latitude;
@@ -60,8 +63,10 @@ void PersonPositionProvider::updatePosition()
     mPositionFix.speed.assign(mPersonController->getSpeed(), 1.0 * si::meter_per_second);
 
     // prevent signal listeners to modify our position data
-    PositionFixObject tmp { mPositionFix };
-    emit(scPositionFixSignal, &tmp);
+    if (mayHaveListeners(scPositionFixSignal)) {
+        PositionFixObject tmp { mPositionFix };
+        emit(scPositionFixSignal, &tmp);
+    }
 }
 
 Position PersonPositionProvider::getCartesianPosition() const
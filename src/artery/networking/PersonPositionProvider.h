@@ -3,6 +3,7 @@
 
 #include "artery/networking/PositionFixObject.h"
 #include "artery/networking/PositionProvider.h"
+#include "artery/utility/DisplacementThrottle.h"
 #include <omnetpp/clistener.h>
 #include <omnetpp/csimplemodule.h>
 #include <vanetza/common/position_provider.hpp>
@@ -39,6 +40,7 @@ class PersonPositionProvider :
         PositionFixObject mPositionFix;
         Runtime* mRuntime = nullptr;
         traci::PersonController* mPersonController = nullptr;
+        DisplacementThrottle mThrottle;
 };
 
 } // namespace artery
@@ -8,14 +8,22 @@
 #include "artery/networking/SecurityEntity.h"
 #include "artery/nic/RadioDriverBase.h"
 #include "artery/nic/RadioDriverProperties.h"
+#include "artery/utility/Fingerprint.h"
+#include "artery/utility/Geometry.h"
 #include "artery/utility/InitStages.h"
 #include "artery/utility/PointerCheck.h"
+#include "artery/utility/ProfilingScope.h"
 #include <boost/units/cmath.hpp>
 #include <boost/units/io.hpp>
+#include <boost/variant/get.hpp>
 #include <inet/common/ModuleAccess.h>
 #include <vanetza/btp/header.hpp>
 #include <vanetza/btp/header_conversion.hpp>
 #include <vanetza/geonet/data_confirm.hpp>
+#include <vanetza/units/time.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 
 namespace vanetza {
 namespace geonet {
@@ -42,6 +50,14 @@ Define_Module(Router)
 static const omnetpp::simsignal_t scPositionFixSignal = omnetpp::cComponent::registerSignal("PositionFix");
 static const omnetpp::simsignal_t scLinkReceptionSignal = omnetpp::cComponent::registerSignal("LinkReception");
 
+Router::~Router()
+{
+    cancelAndDelete(mVerificationEvent);
+    for (PendingPacket& pending : mPendingPackets) {
+        delete pending.packet;
+    }
+}
+
 int Router::numInitStages() const
 {
     return InitStages::Total;
@@ -55,14 +71,26 @@ void Router::initialize(int stage)
         mRadioDriver = inet::getModuleFromPar<RadioDriverBase>(par("radioDriverModule"), this);
         mRadioDriverDataIn = gate("radioDriverData");
         mRadioDriverPropertiesIn = gate("radioDriverProperties");
-        mSecurityEntity = inet::findModuleFromPar<SecurityEntity>(par("securityModule"), this, false);
+        mPositionDeadband.distance = par("positionDeadbandDistance");
+        mPositionDeadband.heading = par("positionDeadbandHeading");
+        mPositionDeadband.speed = par("positionDeadbandSpeed");
+        mPositionDeadband.maxAge = par("positionDeadbandMaxAge");
+        mStaticPositionVector = par("staticPositionVector");
+        mGeoBroadcastPrefilter = par("geoBroadcastPrefilter");
+        mGeoBroadcastPrefilterMargin = par("geoBroadcastPrefilterMargin");
+        auto securityEntity = inet::findModuleFromPar<SecurityEntity>(par("securityModule"), this, false);
+        if (securityEntity) {
+            mSecurityEntity = securityEntity;
+            mVerificationLatency = securityEntity->getVerificationLatency();
+            mVerificationEvent = new omnetpp::cMessage("verification latency");
+        }
     } else if (stage == InitStages::Self) {
         // initialize MIB (will check for existence of security entity)
         initializeManagementInformationBase(mMIB);
 
         // basic router setup
-        auto runtime = inet::getModuleFromPar<Runtime>(par("runtimeModule"), this);
-        mRouter.reset(new vanetza::geonet::Router(*runtime, mMIB));
+        mRuntime = inet::getModuleFromPar<Runtime>(par("runtimeModule"), this);
+        mRouter.reset(new vanetza::geonet::Router(*mRuntime, mMIB));
         vanetza::MacAddress init_mac = vanetza::create_mac_address(getId());
         mRouter->set_address(generateAddress(init_mac));
 
@@ -98,18 +126,81 @@ void Router::receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t signal, om
     if (signal == scPositionFixSignal) {
         auto fix = dynamic_cast<PositionFixObject*>(obj);
         if (fix && mRouter) {
-            mRouter->update_position(*fix);
+            updatePosition(*fix);
         }
     }
 }
 
+void Router::updatePosition(const vanetza::PositionFix& fix)
+{
+    fingerprint::add(fingerprint::Ingredient::PositionFix, fix.latitude.value(), fix.longitude.value(),
+            fix.speed.value().value(), fix.course.value().value());
+
+    if (mStaticPositionVector && mHasAppliedPositionFix) {
+        refreshPositionTimestamp(fix.timestamp);
+    } else if (isInsidePositionDeadband(fix)) {
+        // skip vanetza's position update altogether, maxAge bounds the age of the position vector
+    } else {
+        mRouter->update_position(fix);
+        mAppliedPositionFix = fix;
+        mAppliedPositionFixTime = omnetpp::simTime();
+        mHasAppliedPositionFix = true;
+    }
+}
+
+void Router::refreshPositionTimestamp(vanetza::Clock::time_point timestamp)
+{
+    // transmitted position vector keeps its previous values but gets a fresh timestamp
+    vanetza::PositionFix refresh = mAppliedPositionFix;
+    refresh.timestamp = timestamp;
+    mRouter->update_position(refresh);
+}
+
+bool Router::isInsidePositionDeadband(const vanetza::PositionFix& fix) const
+{
+    if (!mPositionDeadband.enabled() || !mHasAppliedPositionFix) {
+        return false;
+    } else if (omnetpp::simTime() - mAppliedPositionFixTime >= mPositionDeadband.maxAge) {
+        return false;
+    }
+
+    const vanetza::PositionFix& last = mAppliedPositionFix;
+    if (mPositionDeadband.distance > 0.0) {
+        GeoPosition from, to;
+        from.latitude = last.latitude;
+        from.longitude = last.longitude;
+        to.latitude = fix.latitude;
+        to.longitude = fix.longitude;
+        if (distance(from, to).value() > mPositionDeadband.distance) {
+            return false;
+        }
+    }
+
+    if (mPositionDeadband.heading > 0.0) {
+        const double delta = std::remainder((fix.course.value() - last.course.value()).value(), 360.0);
+        if (std::abs(delta) > mPositionDeadband.heading) {
+            return false;
+        }
+    }
+
+    if (mPositionDeadband.speed > 0.0) {
+        const double delta = (fix.speed.value() - last.speed.value()).value();
+        if (std::abs(delta) > mPositionDeadband.speed) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void Router::handleMessage(omnetpp::cMessage* msg)
 {
-    if (msg->getArrivalGate() == mRadioDriverDataIn) {
-        auto* packet = omnetpp::check_and_cast<GeoNetPacket*>(msg);
-        auto* indication = omnetpp::check_and_cast<GeoNetIndication*>(packet->getControlInfo());
-        emit(scLinkReceptionSignal, packet);
-        mRouter->indicate(std::move(*packet).extractPayload(), indication->source, indication->destination);
+    if (msg == mVerificationEvent) {
+        indicatePendingPackets();
+        return;
+    } else if (msg->getArrivalGate() == mRadioDriverDataIn) {
+        receivePacket(omnetpp::check_and_cast<GeoNetPacket*>(msg));
+        return;
     } else if (msg->getArrivalGate() == mRadioDriverPropertiesIn) {
         auto* properties = omnetpp::check_and_cast<RadioDriverProperties*>(msg);
         auto addr = generateAddress(properties->LinkLayerAddress);
@@ -125,6 +216,108 @@ void Router::handleMessage(omnetpp::cMessage* msg)
     delete msg;
 }
 
+void Router::indicateData(omnetpp::cPacket* packet)
+{
+    Enter_Method_Silent();
+    take(packet);
+    receivePacket(omnetpp::check_and_cast<GeoNetPacket*>(packet));
+}
+
+void Router::receivePacket(GeoNetPacket* packet)
+{
+    if (mVerificationLatency > omnetpp::SIMTIME_ZERO) {
+        // constant latency keeps packets in order of their reception
+        mPendingPackets.push_back(PendingPacket { omnetpp::simTime() + mVerificationLatency, packet });
+        if (!mVerificationEvent->isScheduled()) {
+            scheduleAt(mPendingPackets.front().due, mVerificationEvent);
+        }
+    } else {
+        indicatePacket(*packet);
+        delete packet;
+    }
+}
+
+void Router::indicatePendingPackets()
+{
+    while (!mPendingPackets.empty() && mPendingPackets.front().due <= omnetpp::simTime()) {
+        GeoNetPacket* packet = mPendingPackets.front().packet;
+        mPendingPackets.pop_front();
+        indicatePacket(*packet);
+        delete packet;
+    }
+
+    if (!mPendingPackets.empty()) {
+        scheduleAt(mPendingPackets.front().due, mVerificationEvent);
+    }
+}
+
+void Router::indicatePacket(GeoNetPacket& packet)
+{
+    ARTERY_PROFILE_SCOPE("geonet.indicate");
+    emit(scLinkReceptionSignal, &packet);
+    if (mGeoBroadcastPrefilter && isFarFromDestinationArea(packet)) {
+        EV_DETAIL << "dropping packet destined to a far away area\n";
+        return;
+    }
+
+    if (auto indication = dynamic_cast<GeoNetIndication*>(packet.getControlInfo())) {
+        // addresses passed by control info of radio drivers not (yet) embedding them into packet
+        fingerprint::add(fingerprint::Ingredient::StationId, indication->source.octets);
+        mRouter->indicate(std::move(packet).extractPayload(), indication->source, indication->destination);
+    } else {
+        const vanetza::MacAddress source = packet.getSourceAddress();
+        const vanetza::MacAddress destination = packet.getDestinationAddress();
+        fingerprint::add(fingerprint::Ingredient::StationId, source.octets);
+        mRouter->indicate(std::move(packet).extractPayload(), source, destination);
+    }
+}
+
+bool Router::isFarFromDestinationArea(const GeoNetPacket& packet) const
+{
+    // only packets of local simulation carry their headers as separate layer
+    auto chunk = packet.hasPayload() ? boost::get<vanetza::ChunkPacket>(&packet.getPayload()) : nullptr;
+    if (!chunk) {
+        return false;
+    }
+
+    // header layout per EN 302 636-4-1: basic (4 bytes), common (8 bytes), GBC/GAC extended header
+    static const std::size_t areaOffset = 4 + 8 + 28;
+    vanetza::ByteBuffer headers;
+    (*chunk)[vanetza::OsiLayer::Network].convert(headers);
+    if (headers.size() < areaOffset + 12) {
+        return false;
+    }
+
+    const unsigned basicNextHeader = headers[0] & 0x0f;
+    const unsigned headerType = headers[5] >> 4;
+    const unsigned headerSubtype = headers[5] & 0x0f;
+    if (basicNextHeader != 1 /* common header */ || (headerType != 3 && headerType != 4) /* GAC, GBC */) {
+        return false;
+    }
+
+    auto read32 = [&headers](std::size_t offset) {
+        return static_cast<std::int32_t>(std::uint32_t(headers[offset]) << 24 | std::uint32_t(headers[offset + 1]) << 16 |
+            std::uint32_t(headers[offset + 2]) << 8 | headers[offset + 3]);
+    };
+    auto read16 = [&headers](std::size_t offset) {
+        return static_cast<unsigned>(headers[offset] << 8 | headers[offset + 1]);
+    };
+
+    GeoPosition center;
+    center.latitude = read32(areaOffset) * 1e-7 * boost::units::degree::degrees;
+    center.longitude = read32(areaOffset + 4) * 1e-7 * boost::units::degree::degrees;
+    const double distanceA = read16(areaOffset + 8);
+    const double distanceB = read16(areaOffset + 10);
+    // circle (0) and ellipse (2) are bounded by their larger axis, rectangles (1) by their half diagonal
+    const double radius = headerSubtype == 1 ? std::hypot(distanceA, distanceB) : std::max(distanceA, distanceB);
+
+    const auto& epv = mRouter->get_local_position_vector();
+    GeoPosition ego;
+    ego.latitude = GeoPosition::value_type { epv.position().latitude };
+    ego.longitude = GeoPosition::value_type { epv.position().longitude };
+    return distance(ego, center).value() > radius + mGeoBroadcastPrefilterMargin;
+}
+
 void Router::initializeManagementInformationBase(vanetza::geonet::ManagementInformationBase& mib)
 {
     using namespace std::chrono;
@@ -134,12 +327,26 @@ void Router::initializeManagementInformationBase(vanetza::geonet::ManagementInfo
     mib.itsGnSecurity = (mSecurityEntity != nullptr);
     mib.vanetzaDeferInitialBeacon = duration_cast<vanetza::Clock::duration>(duration<double>(par("deferInitialBeacon")));
     mib.vanetzaDisableBeaconing = par("disableBeaconing");
+
+    // shorter lifetimes bound location table size in dense scenarios
+    const double lifetime = par("locationTableLifetime");
+    if (lifetime > 0.0) {
+        mib.itsGnLifetimeLocTE = lifetime * vanetza::units::si::seconds;
+    }
 }
 
 void Router::request(const vanetza::btp::DataRequestB& request, std::unique_ptr<vanetza::DownPacket> packet)
 {
     ASSERT(mRouter);
     Enter_Method("request");
+    ARTERY_PROFILE_SCOPE("geonet.request");
+
+    fingerprint::add(fingerprint::Ingredient::StationId, getAddress().mid().octets);
+
+    if (mStaticPositionVector && mHasAppliedPositionFix) {
+        // there are no further position fixes which would keep the timestamp current
+        refreshPositionTimestamp(mRuntime->now());
+    }
 
     using namespace vanetza;
     btp::HeaderB btp_header;
@@ -1,23 +1,29 @@
 #ifndef ARTERY_ROUTER_H_1YTFC6NB
 #define ARTERY_ROUTER_H_1YTFC6NB
 
+#include "artery/nic/RadioDriverBase.h"
 #include <omnetpp/csimplemodule.h>
 #include <vanetza/geonet/mib.hpp>
 #include <vanetza/geonet/router.hpp>
 #include <vanetza/btp/data_request.hpp>
+#include <vanetza/common/position_fix.hpp>
 #include <vanetza/security/security_entity.hpp>
+#include <deque>
 #include <memory>
 
 namespace artery
 {
 
+class GeoNetPacket;
 class Middleware;
 class NetworkInterface;
-class RadioDriverBase;
+class Runtime;
 
-class Router : public omnetpp::cSimpleModule, public omnetpp::cListener
+class Router : public omnetpp::cSimpleModule, public omnetpp::cListener, public RadioDriverBase::UpperLayer
 {
     public:
+        ~Router();
+
         // cSimpleModule
         int numInitStages() const override;
         void initialize(int stage) override;
@@ -27,6 +33,9 @@ class Router : public omnetpp::cSimpleModule, public omnetpp::cListener
         // cListener
         void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, omnetpp::cObject*, omnetpp::cObject*) override;
 
+        // RadioDriverBase::UpperLayer
+        void indicateData(omnetpp::cPacket*) override;
+
         void request(const vanetza::btp::DataRequestB&, std::unique_ptr<vanetza::DownPacket>);
         vanetza::geonet::Address getAddress() const;
         const vanetza::geonet::LocationTable& getLocationTable() const;
@@ -37,6 +46,19 @@ class Router : public omnetpp::cSimpleModule, public omnetpp::cListener
         vanetza::geonet::Address generateAddress(const vanetza::MacAddress&);
 
     private:
+        struct PendingPacket
+        {
+            omnetpp::SimTime due;
+            GeoNetPacket* packet;
+        };
+
+        void updatePosition(const vanetza::PositionFix&);
+        void refreshPositionTimestamp(vanetza::Clock::time_point);
+        bool isInsidePositionDeadband(const vanetza::PositionFix&) const;
+        void receivePacket(GeoNetPacket*);
+        void indicatePendingPackets();
+        void indicatePacket(GeoNetPacket&);
+        bool isFarFromDestinationArea(const GeoNetPacket&) const;
         vanetza::geonet::ManagementInformationBase mMIB;
         std::unique_ptr<vanetza::geonet::Router> mRouter;
         Middleware* mMiddleware = nullptr;
@@ -45,6 +67,27 @@ class Router : public omnetpp::cSimpleModule, public omnetpp::cListener
         omnetpp::cGate* mRadioDriverDataIn;
         omnetpp::cGate* mRadioDriverPropertiesIn;
         std::shared_ptr<NetworkInterface> mNetworkInterface;
+        omnetpp::SimTime mVerificationLatency;
+        omnetpp::cMessage* mVerificationEvent = nullptr;
+        std::deque<PendingPacket> mPendingPackets; /*< ordered by due time, owned by router */
+
+        struct PositionDeadband
+        {
+            double distance = 0.0; /*< metres */
+            double heading = 0.0; /*< degrees */
+            double speed = 0.0; /*< metres per second */
+            omnetpp::SimTime maxAge;
+            bool enabled() const { return distance > 0.0 || heading > 0.0 || speed > 0.0; }
+        };
+
+        bool mGeoBroadcastPrefilter = false;
+        double mGeoBroadcastPrefilterMargin = 0.0; /*< metres */
+        PositionDeadband mPositionDeadband;
+        vanetza::PositionFix mAppliedPositionFix; /*< last fix applied in full */
+        omnetpp::SimTime mAppliedPositionFixTime;
+        bool mHasAppliedPositionFix = false;
+        bool mStaticPositionVector = false;
+        Runtime* mRuntime = nullptr;
 };
 
 } // namespace artery
@@ -20,6 +20,7 @@ void Runtime::initialize(int stage)
         mTimer.setTimebase(par("datetime"));
         mRuntime.reset(mTimer.getCurrentTime());
         mLastUpdate = omnetpp::simTime();
+        mLazyReschedule = par("lazyReschedule");
     }
 }
 
@@ -74,8 +75,14 @@ void Runtime::schedule()
     auto next_event = mRuntime.next();
     while (next_event < vanetza::Clock::time_point::max()) {
         if (next_event > mRuntime.now()) {
-            cancelEvent(mUpdateEvent);
-            scheduleAt(convertSimTime(next_event), mUpdateEvent);
+            const omnetpp::SimTime next_update = convertSimTime(next_event);
+            if (!mUpdateEvent->isScheduled()) {
+                scheduleAt(next_update, mUpdateEvent);
+            } else if (!mLazyReschedule || next_update < mUpdateEvent->getArrivalTime()) {
+                // lazy mode: a pending update event firing too early is harmless, it just schedules again
+                cancelEvent(mUpdateEvent);
+                scheduleAt(next_update, mUpdateEvent);
+            }
             break;
         } else {
             mRuntime.trigger(mRuntime.now());
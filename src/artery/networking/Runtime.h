@@ -36,6 +36,7 @@ private:
     vanetza::ManualRuntime mRuntime;
     omnetpp::cMessage* mUpdateEvent = nullptr;
     omnetpp::SimTime mLastUpdate;
+    bool mLazyReschedule = false;
 };
 
 } // namespace artery
@@ -1,5 +1,8 @@
+#include "artery/networking/CertificatePool.h"
+#include "artery/networking/CertificateStore.h"
 #include "artery/networking/Runtime.h"
 #include "artery/networking/SecurityEntity.h"
+#include "artery/networking/VerificationCache.h"
 #include "artery/utility/PointerCheck.h"
 #include <inet/common/ModuleAccess.h>
 #include <vanetza/common/position_provider.hpp>
@@ -10,6 +13,7 @@
 #include <vanetza/security/v2/null_certificate_provider.hpp>
 #include <vanetza/security/v2/null_certificate_validator.hpp>
 #include <vanetza/security/v2/sign_service.hpp>
+#include <vanetza/security/v2/static_certificate_provider.hpp>
 
 namespace vs = vanetza::security;
 namespace vs2 = vanetza::security::v2;
@@ -33,7 +37,14 @@ void SecurityEntity::initialize(int stage)
         mBackend = createBackend(par("CryptoBackend"));
         mCertificateProvider = createCertificateProvider(par("CertificateProvider"));
         mCertificateValidator = createCertificateValidator(par("CertificateValidator"));
-        mCertificateCache.reset(new vs2::CertificateCache(*notNullPtr(mRuntime)));
+        const std::string storePath = par("certificateStoreModule").stringValue();
+        if (storePath.empty()) {
+            mOwnCertificateCache.reset(new vs2::CertificateCache(*notNullPtr(mRuntime)));
+            mCertificateCache = mOwnCertificateCache.get();
+        } else {
+            auto store = inet::getModuleFromPar<CertificateStore>(par("certificateStoreModule"), this);
+            mCertificateCache = &store->getCertificateCache();
+        }
         mSignHeaderPolicy.reset(new vs2::DefaultSignHeaderPolicy(*notNullPtr(mRuntime), *mPositionProvider));
         mEntity.reset(new vs::DelegatingSecurityEntity(createSignService(par("SignService")), createVerifyService(par("VerifyService"))));
     }
@@ -44,18 +55,32 @@ void SecurityEntity::finish()
     // free objects before runtime vanishes
     mEntity.reset();
     mSignHeaderPolicy.reset();
-    mCertificateCache.reset();
+    mCertificateCache = nullptr;
+    mOwnCertificateCache.reset();
     mCertificateValidator.reset();
     mCertificateProvider.reset();
     mBackend.reset();
 }
 
+omnetpp::SimTime SecurityEntity::getVerificationLatency() const
+{
+    // read on demand because users may query it before this module is initialized
+    omnetpp::SimTime latency = par("verificationLatency");
+    if (latency < omnetpp::SIMTIME_ZERO) {
+        error("verificationLatency must not be negative");
+    }
+    return latency;
+}
+
 std::unique_ptr<vs::Backend> SecurityEntity::createBackend(const std::string& name) const
 {
     auto backend = vs::create_backend(name.c_str());
     if (!backend) {
         error("No security backend found with name \"%s\"", name.c_str());
     }
+    if (par("shareVerifications")) {
+        backend.reset(new CachingBackend(std::move(backend), VerificationCache::instance(name)));
+    }
     return backend;
 }
 
@@ -66,6 +91,10 @@ std::unique_ptr<vs2::CertificateProvider> SecurityEntity::createCertificateProvi
         certificates.reset(new vs2::NullCertificateProvider());
     } else if (name == "Naive") {
         certificates.reset(new vs2::NaiveCertificateProvider(*notNullPtr(mRuntime)));
+    } else if (name == "Pool") {
+        auto pool = inet::getModuleFromPar<CertificatePool>(par("certificatePoolModule"), this);
+        CertificatePool::Entry ticket = pool->acquire();
+        certificates.reset(new vs2::StaticCertificateProvider(ticket.certificate, ticket.privateKey, ticket.chain));
     } else {
         error("No certificate provider available with name \"%s\"", name.c_str());
     }
@@ -107,7 +136,7 @@ std::unique_ptr<vs::VerifyService> SecurityEntity::createVerifyService(const std
 {
     if (name == "straight") {
         auto verify_service = std::make_unique<vs::StraightVerifyService>(*mRuntime, *mBackend, *mPositionProvider);
-        verify_service->use_certificate_cache(mCertificateCache.get());
+        verify_service->use_certificate_cache(mCertificateCache);
         verify_service->use_certificate_provider(mCertificateProvider.get());
         verify_service->use_certificate_validator(mCertificateValidator.get());
         verify_service->use_sign_header_policy(mSignHeaderPolicy.get());
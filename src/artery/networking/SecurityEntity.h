@@ -2,6 +2,7 @@
 #define ARTERY_SECURITYENTITY_H_UWBA0SPJ
 
 #include <omnetpp/csimplemodule.h>
+#include <omnetpp/simtime.h>
 #include <vanetza/security/backend.hpp>
 #include <vanetza/security/security_entity.hpp>
 #include <vanetza/security/sign_service.hpp>
@@ -33,6 +34,12 @@ class SecurityEntity : public omnetpp::cSimpleModule, public vanetza::security::
         vanetza::security::EncapConfirm encapsulate_packet(vanetza::security::EncapRequest&&) override;
         vanetza::security::DecapConfirm decapsulate_packet(vanetza::security::DecapRequest&&) override;
 
+        /**
+         * Delay between reception of a packet and its verification
+         * \return latency, zero if packets are verified on the spot
+         */
+        omnetpp::SimTime getVerificationLatency() const;
+
     protected:
         std::unique_ptr<vanetza::security::Backend> createBackend(const std::string&) const;
         std::unique_ptr<vanetza::security::v2::CertificateProvider> createCertificateProvider(const std::string&) const;
@@ -46,7 +53,8 @@ class SecurityEntity : public omnetpp::cSimpleModule, public vanetza::security::
         std::unique_ptr<vanetza::security::Backend> mBackend;
         std::unique_ptr<vanetza::security::v2::CertificateProvider> mCertificateProvider;
         std::unique_ptr<vanetza::security::v2::CertificateValidator> mCertificateValidator;
-        std::unique_ptr<vanetza::security::v2::CertificateCache> mCertificateCache;
+        std::unique_ptr<vanetza::security::v2::CertificateCache> mOwnCertificateCache;
+        vanetza::security::v2::CertificateCache* mCertificateCache = nullptr;
         std::unique_ptr<vanetza::security::v2::SignHeaderPolicy> mSignHeaderPolicy;
         std::unique_ptr<vanetza::security::SecurityEntity> mEntity;
 };
@@ -63,8 +63,10 @@ void StationaryPositionProvider::initializePosition(const Position& pos)
     mPositionFix.speed.assign(0.0 * si::meter_per_second, 0.0 * si::meter_per_second);
 
     // prevent signal listeners to modify our position data
-    PositionFixObject tmp { mPositionFix };
-    emit(scPositionFixSignal, &tmp);
+    if (mayHaveListeners(scPositionFixSignal)) {
+        PositionFixObject tmp { mPositionFix };
+        emit(scPositionFixSignal, &tmp);
+    }
 }
 
 } // namespace artery
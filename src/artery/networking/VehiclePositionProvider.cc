@@ -60,8 +60,10 @@ void VehiclePositionProvider::updatePosition()
     mPositionFix.speed.assign(mVehicleController->getSpeed(), 1.0 * si::meter_per_second);
 
     // prevent signal listeners to modify our position data
-    PositionFixObject tmp { mPositionFix };
-    emit(scPositionFixSignal, &tmp);
+    if (mayHaveListeners(scPositionFixSignal)) {
+        PositionFixObject tmp { mPositionFix };
+        emit(scPositionFixSignal, &tmp);
+    }
 }
 
 Position VehiclePositionProvider::getCartesianPosition() const
@@ -74,4 +76,10 @@ GeoPosition VehiclePositionProvider::getGeodeticPosition() const
     return mVehicleController->getGeoPosition();
 }
 
+std::set<int> VehiclePositionProvider::getConsumedVehicleVariables() const
+{
+    // position fixes include the vehicle's speed
+    return { libsumo::VAR_SPEED };
+}
+
 } // namespace artery
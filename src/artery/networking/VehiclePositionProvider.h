@@ -3,6 +3,7 @@
 
 #include "artery/networking/PositionFixObject.h"
 #include "artery/networking/PositionProvider.h"
+#include "traci/VehicleVariableConsumer.h"
 #include <omnetpp/clistener.h>
 #include <omnetpp/csimplemodule.h>
 #include <vanetza/common/position_provider.hpp>
@@ -16,7 +17,8 @@ class Runtime;
 
 class VehiclePositionProvider :
     public omnetpp::cSimpleModule, public omnetpp::cListener,
-    public artery::PositionProvider, public vanetza::PositionProvider
+    public artery::PositionProvider, public vanetza::PositionProvider,
+    public traci::VehicleVariableConsumer
 {
     public:
         // cSimpleModule
@@ -33,6 +35,9 @@ class VehiclePositionProvider :
         // vanetza::PositionProvider
         const vanetza::PositionFix& position_fix() override { return mPositionFix; }
 
+        // traci::VehicleVariableConsumer
+        std::set<int> getConsumedVehicleVariables() const override;
+
     private:
         void updatePosition();
 
@@ -0,0 +1,100 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/networking/VerificationCache.h"
+#include <boost/variant/apply_visitor.hpp>
+#include <cstdint>
+#include <map>
+
+namespace vs = vanetza::security;
+
+namespace artery
+{
+
+namespace
+{
+
+// fields are prefixed by their length, hence concatenated keys are unambiguous
+template<typename Range>
+void appendField(VerificationCache::Key& key, const Range& field)
+{
+    const std::uint32_t length = field.size();
+    for (unsigned shift = 0; shift < 32; shift += 8) {
+        key.push_back((length >> shift) & 0xff);
+    }
+    key.insert(key.end(), field.begin(), field.end());
+}
+
+void appendTag(VerificationCache::Key& key, int tag)
+{
+    key.push_back(static_cast<std::uint8_t>(tag));
+}
+
+} // namespace
+
+VerificationCache& VerificationCache::instance(const std::string& backend)
+{
+    // results of different backends may differ, e.g. "Null" does not verify at all
+    static std::map<std::string, VerificationCache> caches;
+    auto found = caches.find(backend);
+    if (found == caches.end()) {
+        found = caches.emplace(backend, VerificationCache { 4096 }).first;
+    }
+    return found->second;
+}
+
+CachingBackend::CachingBackend(std::unique_ptr<vs::Backend> backend, VerificationCache& cache) :
+    mBackend(std::move(backend)), mCache(cache)
+{
+}
+
+vs::EcdsaSignature CachingBackend::sign_data(const vs::ecdsa256::PrivateKey& key, const vanetza::ByteBuffer& data)
+{
+    return mBackend->sign_data(key, data);
+}
+
+bool CachingBackend::verify_data(const vs::ecdsa256::PublicKey& public_key, const vanetza::ByteBuffer& data,
+        const vs::EcdsaSignature& sig)
+{
+    VerificationCache::Key key;
+    appendTag(key, 1);
+    appendField(key, public_key.x);
+    appendField(key, public_key.y);
+    appendField(key, data);
+    // ECDSA verification depends on x coordinate of R only, but keep variant's type anyway
+    appendTag(key, sig.R.which());
+    boost::apply_visitor([&key](const auto& point) { appendField(key, point.x); }, sig.R);
+    appendField(key, sig.s);
+
+    return mCache.verify(std::move(key), [&]() { return mBackend->verify_data(public_key, data, sig); });
+}
+
+bool CachingBackend::verify_digest(const vs::PublicKey& public_key, const vanetza::ByteBuffer& digest,
+        const vs::Signature& sig)
+{
+    VerificationCache::Key key;
+    appendTag(key, 2);
+    appendTag(key, static_cast<int>(public_key.type));
+    appendField(key, public_key.x);
+    appendField(key, public_key.y);
+    appendField(key, digest);
+    appendTag(key, static_cast<int>(sig.type));
+    appendField(key, sig.r);
+    appendField(key, sig.s);
+
+    return mCache.verify(std::move(key), [&]() { return mBackend->verify_digest(public_key, digest, sig); });
+}
+
+boost::optional<vs::Uncompressed> CachingBackend::decompress_point(const vs::EccPoint& point)
+{
+    return mBackend->decompress_point(point);
+}
+
+vanetza::ByteBuffer CachingBackend::calculate_hash(vs::KeyType type, const vanetza::ByteBuffer& data)
+{
+    return mBackend->calculate_hash(type, data);
+}
+
+} // namespace artery
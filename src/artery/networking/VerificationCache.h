@@ -0,0 +1,108 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_VERIFICATIONCACHE_H_C4PX8TJE
+#define ARTERY_VERIFICATIONCACHE_H_C4PX8TJE
+
+#include <boost/functional/hash.hpp>
+#include <vanetza/common/byte_buffer.hpp>
+#include <vanetza/security/backend.hpp>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace artery
+{
+
+/**
+ * VerificationCache remembers results of signature verifications.
+ *
+ * All receivers of a transmission verify identical signed bytes with the signer's key,
+ * thus only the first receiver needs to compute the curve math.
+ * Each entry is keyed by public key, signed data (or digest) and signature.
+ * The oldest entries are evicted first.
+ */
+class VerificationCache
+{
+public:
+    using Key = vanetza::ByteBuffer;
+
+    /**
+     * Get cache shared by all security entities using the same crypto backend
+     * \param backend name of crypto backend
+     */
+    static VerificationCache& instance(const std::string& backend);
+
+    explicit VerificationCache(std::size_t capacity) : mCapacity(capacity) {}
+
+    /**
+     * Look up result or verify
+     * \param key identifies verification inputs
+     * \param verify invoked if no result is cached for key
+     * \return verification result
+     */
+    template<typename F>
+    bool verify(Key&& key, F&& verify)
+    {
+        auto found = mResults.find(key);
+        if (found != mResults.end()) {
+            return found->second;
+        }
+
+        const bool result = verify();
+        if (mCapacity > 0) {
+            if (mResults.size() >= mCapacity) {
+                mResults.erase(mInsertions.front());
+                mInsertions.pop_front();
+            }
+            mInsertions.push_back(key);
+            mResults.emplace(std::move(key), result);
+        }
+        return result;
+    }
+
+private:
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const
+        {
+            return boost::hash_range(key.begin(), key.end());
+        }
+    };
+
+    std::size_t mCapacity;
+    std::unordered_map<Key, bool, KeyHash> mResults;
+    std::deque<Key> mInsertions; /*< keys in insertion order */
+};
+
+/**
+ * CachingBackend consults a VerificationCache before verifying signatures by its backend.
+ *
+ * Only the curve math is shared: verification services still evaluate certificates,
+ * generation times and positions per receiver.
+ */
+class CachingBackend : public vanetza::security::Backend
+{
+public:
+    CachingBackend(std::unique_ptr<vanetza::security::Backend>, VerificationCache&);
+
+    vanetza::security::EcdsaSignature sign_data(const vanetza::security::ecdsa256::PrivateKey&, const vanetza::ByteBuffer&) override;
+    bool verify_data(const vanetza::security::ecdsa256::PublicKey&, const vanetza::ByteBuffer&,
+            const vanetza::security::EcdsaSignature&) override;
+    bool verify_digest(const vanetza::security::PublicKey&, const vanetza::ByteBuffer&,
+            const vanetza::security::Signature&) override;
+    boost::optional<vanetza::security::Uncompressed> decompress_point(const vanetza::security::EccPoint&) override;
+    vanetza::ByteBuffer calculate_hash(vanetza::security::KeyType, const vanetza::ByteBuffer&) override;
+
+private:
+    std::unique_ptr<vanetza::security::Backend> mBackend;
+    VerificationCache& mCache;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_VERIFICATIONCACHE_H_C4PX8TJE */
@@ -0,0 +1,102 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/nic/ChannelLoadReporter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace artery
+{
+
+Define_Module(ChannelLoadReporter)
+
+using namespace omnetpp;
+
+ChannelLoadReporter::Client::~Client()
+{
+    if (mReporter) {
+        mReporter->unsubscribe(this);
+    }
+}
+
+ChannelLoadReporter::~ChannelLoadReporter()
+{
+    cancelAndDelete(mTrigger);
+    for (Client* client : mClients) {
+        if (client) {
+            client->mReporter = nullptr;
+        }
+    }
+}
+
+void ChannelLoadReporter::initialize()
+{
+    if (getInterval() <= SIMTIME_ZERO) {
+        throw cRuntimeError("channel load report interval must be positive");
+    }
+
+    mTrigger = new cMessage("report CL");
+    scheduleAt(getInterval(), mTrigger);
+}
+
+void ChannelLoadReporter::handleMessage(cMessage* msg)
+{
+    if (msg == mTrigger) {
+        const simtime_t now = simTime();
+        mReporting = true;
+        // clients subscribing meanwhile are appended and not due yet
+        for (std::size_t i = 0; i < mClients.size(); ++i) {
+            Client* client = mClients[i];
+            if (client && client->mFirstReport <= now) {
+                client->reportChannelLoad();
+            }
+        }
+        mReporting = false;
+        removeVacantSlots();
+        scheduleAt(now + getInterval(), mTrigger);
+    } else {
+        throw cRuntimeError("unexpected message");
+    }
+}
+
+void ChannelLoadReporter::subscribe(Client* client)
+{
+    ASSERT(client && !client->mReporter);
+    const simtime_t interval = getInterval();
+    const double cycle = simTime() / interval;
+    client->mReporter = this;
+    client->mSlot = mClients.size();
+    client->mFirstReport = (1.0 + std::ceil(cycle)) * interval;
+    mClients.push_back(client);
+}
+
+void ChannelLoadReporter::unsubscribe(Client* client)
+{
+    ASSERT(client && client->mReporter == this && mClients[client->mSlot] == client);
+    if (mReporting) {
+        // keep slots stable while iterating clients
+        mClients[client->mSlot] = nullptr;
+    } else {
+        mClients[client->mSlot] = mClients.back();
+        mClients[client->mSlot]->mSlot = client->mSlot;
+        mClients.pop_back();
+    }
+    client->mReporter = nullptr;
+}
+
+simtime_t ChannelLoadReporter::getInterval() const
+{
+    return par("interval");
+}
+
+void ChannelLoadReporter::removeVacantSlots()
+{
+    mClients.erase(std::remove(mClients.begin(), mClients.end(), nullptr), mClients.end());
+    for (std::size_t i = 0; i < mClients.size(); ++i) {
+        mClients[i]->mSlot = i;
+    }
+}
+
+} // namespace artery
@@ -0,0 +1,80 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_CHANNELLOADREPORTER_H_W4TQ8RZC
+#define ARTERY_CHANNELLOADREPORTER_H_W4TQ8RZC
+
+#include <omnetpp/cmessage.h>
+#include <omnetpp/csimplemodule.h>
+#include <omnetpp/simtime.h>
+#include <cstddef>
+#include <vector>
+
+namespace artery
+{
+
+/**
+ * ChannelLoadReporter triggers synchronised channel load reports of many nodes by a single timer.
+ *
+ * Instead of scheduling a report message per node, subscribed clients are invoked one after another
+ * whenever the global report interval elapses. Like a node's own synchronised timer, a client is
+ * reported first at the second interval boundary following its subscription.
+ */
+class ChannelLoadReporter : public omnetpp::cSimpleModule
+{
+public:
+    class Client
+    {
+    public:
+        Client() = default;
+        Client(const Client&) = delete;
+        Client& operator=(const Client&) = delete;
+        virtual ~Client();
+
+        /**
+         * Report channel load, invoked by reporter in context of its report event
+         */
+        virtual void reportChannelLoad() = 0;
+
+    private:
+        friend class ChannelLoadReporter;
+        ChannelLoadReporter* mReporter = nullptr;
+        std::size_t mSlot = 0;
+        omnetpp::simtime_t mFirstReport;
+    };
+
+    ~ChannelLoadReporter();
+
+    void initialize() override;
+    void handleMessage(omnetpp::cMessage*) override;
+
+    /**
+     * Subscribe client for reports at each interval boundary
+     * \param client not yet subscribed client
+     */
+    void subscribe(Client* client);
+
+    /**
+     * Unsubscribe client, no further reports are triggered then
+     * \param client subscribed client
+     */
+    void unsubscribe(Client* client);
+
+    /**
+     * Get interval between reports
+     */
+    omnetpp::simtime_t getInterval() const;
+
+private:
+    void removeVacantSlots();
+
+    omnetpp::cMessage* mTrigger = nullptr;
+    std::vector<Client*> mClients; /*< slots of unsubscribed clients are null while reporting */
+    bool mReporting = false;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_CHANNELLOADREPORTER_H_W4TQ8RZC */
@@ -1,11 +1,12 @@
 #include "artery/nic/ChannelLoadSampler.h"
 #include <omnetpp/csimulation.h>
+#include <algorithm>
 #include <chrono>
 
 namespace artery
 {
 
-ChannelLoadSampler::ChannelLoadSampler() : mBusy(false), mCbr(0.0)
+ChannelLoadSampler::ChannelLoadSampler() : mRunSamples(0), mRunBusySamples(0), mBusy(false), mCbr(0.0)
 {
     reset();
 }
@@ -13,72 +14,81 @@ ChannelLoadSampler::ChannelLoadSampler() : mBusy(false), mCbr(0.0)
 void ChannelLoadSampler::reset()
 {
     mLastUpdate = omnetpp::simTime();
-    mSamples.clear();
+    mRuns.clear();
+    mRunSamples = 0;
+    mRunBusySamples = 0;
     mBusy = false;
     mCbr = 0.0;
 }
 
 void ChannelLoadSampler::busy(bool flag)
+{
+    busy(flag, omnetpp::simTime());
+}
+
+void ChannelLoadSampler::busy(bool flag, const omnetpp::SimTime& at)
 {
     if (mBusy != flag) {
-        const auto fillSamples = computePendingSamples();
+        const auto fillSamples = computePendingSamples(at);
         if (fillSamples > 0) {
             // fill if busy state changed for at least one sample
-            mSamples.emplace_front(fillSamples, mBusy);
+            mRuns.push_back(Run { fillSamples, mBusy });
+            mRunSamples += fillSamples;
+            mRunBusySamples += mBusy ? fillSamples : 0;
         }
         mBusy = flag;
-        mLastUpdate = omnetpp::simTime();
+        mLastUpdate = at;
     }
 }
 
 unsigned ChannelLoadSampler::computePendingSamples() const
+{
+    return computePendingSamples(omnetpp::simTime());
+}
+
+unsigned ChannelLoadSampler::computePendingSamples(const omnetpp::SimTime& now) const
 {
     static const omnetpp::SimTime cbrSamplePeriod { 8, omnetpp::SIMTIME_US };
 
-    const auto updateDelta = omnetpp::simTime() - mLastUpdate;
+    const auto updateDelta = now - mLastUpdate;
     return updateDelta / cbrSamplePeriod;
 }
 
 void ChannelLoadSampler::updateCbr()
 {
-    static const unsigned cbrIntervalSamples = 12500;
+    static const unsigned long cbrIntervalSamples = 12500;
 
-    unsigned samples = 0;
-    unsigned busy = 0;
+    unsigned long samples = 0;
+    unsigned long busy = 0;
 
     // consider samples since last busy state change
     const auto pendingSamples = computePendingSamples();
     if (pendingSamples > 0) {
-        samples = std::min(cbrIntervalSamples, pendingSamples);
+        samples = std::min<unsigned long>(cbrIntervalSamples, pendingSamples);
         busy = mBusy ? samples : 0;
     }
 
-    // iterate recorded busy periods (begin with most recent period)
-    for (auto it = mSamples.begin(); it != mSamples.end();) {
-        // get values from tuples
-        unsigned sampleLength = std::get<0>(*it);
-        bool mediumBusy = std::get<1>(*it);
-
-        // add length of list entry to total samples
-        samples += sampleLength;
-
-        if (samples < cbrIntervalSamples) {
-            if (mediumBusy) {
-                // increase busy time by full sample length
-                busy += sampleLength;
-            }
-            ++it;
-        } else {
-            if (mediumBusy) {
-                // increase busy time up to boundary of sampling interval
-                busy += sampleLength - (samples - cbrIntervalSamples);
-            }
-
-            // remove obsolete periods
-            it = mSamples.erase(it, mSamples.end());
+    // remove runs beyond the one crossing the boundary of sampling interval
+    auto popOldestRun = [this]() {
+        const Run& oldest = mRuns.front();
+        mRunSamples -= oldest.samples;
+        mRunBusySamples -= oldest.busy ? oldest.samples : 0;
+        mRuns.pop_front();
+    };
+    while (!mRuns.empty() && samples + mRunSamples - mRuns.front().samples >= cbrIntervalSamples) {
+        popOldestRun();
+    }
+
+    if (!mRuns.empty() && samples + mRunSamples >= cbrIntervalSamples) {
+        // oldest run crosses boundary: count busy time up to boundary, run is obsolete afterwards
+        const Run oldest = mRuns.front();
+        popOldestRun();
+        if (oldest.busy) {
+            busy += oldest.samples - (samples + mRunSamples + oldest.samples - cbrIntervalSamples);
         }
     }
 
+    busy += mRunBusySamples;
     mCbr = static_cast<double>(busy) / static_cast<double>(cbrIntervalSamples);
 }
 
@@ -90,7 +100,7 @@ double ChannelLoadSampler::cbr()
 
 std::ostream& operator<<(std::ostream& os, const ChannelLoadSampler& sampler)
 {
-    os << "CBR=" << sampler.mCbr << " (" << sampler.mSamples.size() << " busy edges pending)";
+    os << "CBR=" << sampler.mCbr << " (" << sampler.mRuns.size() << " busy edges pending)";
     return os;
 }
 
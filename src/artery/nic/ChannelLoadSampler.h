@@ -10,27 +10,49 @@
 #include <omnetpp/simtime.h>
 #include <deque>
 #include <ostream>
-#include <tuple>
 
 namespace artery
 {
 
+/**
+ * ChannelLoadSampler measures the Channel Busy Ratio (CBR) over the most recent 100 ms
+ *
+ * Busy and idle periods are recorded as runs of 8 µs samples. Running totals of all recorded
+ * runs are maintained, so recording a state change is O(1) and cbr() only drops outdated runs.
+ */
 class ChannelLoadSampler
 {
     public:
         ChannelLoadSampler();
         void reset();
         void busy(bool flag);
+
+        /**
+         * Change busy state at a past point in time
+         * \param flag busy state
+         * \param at time of state change, not before the last change
+         */
+        void busy(bool flag, const omnetpp::SimTime& at);
+
         double cbr();
 
         friend std::ostream& operator<<(std::ostream& os, const ChannelLoadSampler&);
 
     private:
+        struct Run
+        {
+            unsigned samples;
+            bool busy;
+        };
+
         void updateCbr();
         unsigned computePendingSamples() const;
+        unsigned computePendingSamples(const omnetpp::SimTime& now) const;
 
         omnetpp::SimTime mLastUpdate;
-        std::deque<std::tuple<unsigned, bool>> mSamples;
+        std::deque<Run> mRuns; /*< oldest run at front */
+        unsigned long mRunSamples; /*< total samples of all runs */
+        unsigned long mRunBusySamples; /*< total busy samples of all runs */
         bool mBusy;
         double mCbr;
 };
@@ -0,0 +1,203 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/networking/GeoNetPacket.h"
+#include "artery/networking/GeoNetRequest.h"
+#include "artery/networking/PositionProvider.h"
+#include "artery/nic/FastRadioDriver.h"
+#include "artery/nic/FastRadioFrame.h"
+#include "artery/nic/FastRadioMedium.h"
+#include "artery/nic/RadioDriverProperties.h"
+#include <omnetpp/checkandcast.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace omnetpp;
+
+namespace artery
+{
+
+Register_Class(FastRadioDriver)
+
+namespace
+{
+    // OFDM timing of 10 MHz channels, see IEEE 802.11-2012 clause 18
+    const SimTime ofdmSymbol { 8, SIMTIME_US };
+    const SimTime ofdmPreamble { 40, SIMTIME_US }; // including SIGNAL field
+    const unsigned ofdmServiceTailBits = 16 + 6;
+}
+
+FastRadioDriver::~FastRadioDriver()
+{
+    cancelAndDelete(mTransmissionEnd);
+    cancelAndDelete(mChannelLoadReport);
+    for (FastRadioFrame* frame : mQueue) {
+        delete frame;
+    }
+}
+
+void FastRadioDriver::initialize()
+{
+    RadioDriverBase::initialize();
+    mRadioIn = gate("radioIn");
+
+    mMedium = dynamic_cast<FastRadioMedium*>(getModuleByPath(par("mediumModule")));
+    if (!mMedium) {
+        throw cRuntimeError("no FastRadioMedium found at %s", par("mediumModule").stringValue());
+    }
+    mPositionProvider = dynamic_cast<const PositionProvider*>(getModuleByPath(par("positionModule")));
+    if (!mPositionProvider) {
+        throw cRuntimeError("no PositionProvider found at %s", par("positionModule").stringValue());
+    }
+    mAddress = mMedium->registerDriver(this);
+
+    mBitrate = par("bitrate");
+    mMacOverhead = par("macOverhead");
+    mInterFrameSpace = par("interFrameSpace");
+    mQueueLength = par("queueLength");
+    mCollisionFactor = par("collisionFactor");
+    mTransmissionEnd = new cMessage("transmission end");
+
+    mChannelLoadSampler.reset();
+    mChannelLoadReportInterval = par("channelLoadReportInterval");
+    if (par("asyncChannelReport").boolValue()) {
+        mChannelLoadReport = new cMessage("report channel load");
+        scheduleAt(simTime() + mChannelLoadReportInterval, mChannelLoadReport);
+    } else if (auto reporter = dynamic_cast<ChannelLoadReporter*>(getModuleByPath(par("channelLoadReporterModule")))) {
+        if (reporter->getInterval() != mChannelLoadReportInterval) {
+            throw cRuntimeError("interval of channel load reporter differs from channelLoadReportInterval");
+        }
+        reporter->subscribe(this);
+    } else {
+        mChannelLoadReport = new cMessage("report channel load");
+        double cycle = simTime() / mChannelLoadReportInterval;
+        scheduleAt((1.0 + std::ceil(cycle)) * mChannelLoadReportInterval, mChannelLoadReport);
+    }
+
+    auto properties = new RadioDriverProperties();
+    properties->LinkLayerAddress = mAddress;
+    properties->ServingChannel = par("channelNumber");
+    indicateProperties(properties);
+}
+
+void FastRadioDriver::finish()
+{
+    if (mMedium) {
+        mMedium->unregisterDriver(this);
+        mMedium = nullptr;
+    }
+    RadioDriverBase::finish();
+}
+
+void FastRadioDriver::handleMessage(cMessage* msg)
+{
+    if (msg == mTransmissionEnd) {
+        if (!mQueue.empty()) {
+            FastRadioFrame* frame = mQueue.front();
+            mQueue.pop_front();
+            transmitFrame(frame);
+        }
+    } else if (msg == mChannelLoadReport) {
+        updateChannelLoad();
+        scheduleAt(simTime() + mChannelLoadReportInterval, mChannelLoadReport);
+    } else if (RadioDriverBase::isDataRequest(msg)) {
+        handleDataRequest(msg);
+    } else if (msg->getArrivalGate() == mRadioIn) {
+        handleDataIndication(check_and_cast<FastRadioFrame*>(msg));
+    } else {
+        throw cRuntimeError("unexpected message");
+    }
+}
+
+void FastRadioDriver::handleDataRequest(cMessage* packet)
+{
+    auto request = check_and_cast<GeoNetRequest*>(packet->removeControlInfo());
+    auto frame = new FastRadioFrame("fast radio frame");
+    frame->setByteLength(mMacOverhead);
+    frame->encapsulate(check_and_cast<cPacket*>(packet));
+    frame->setSourceAddress(request->source_addr);
+    frame->setDestinationAddress(request->destination_addr);
+    delete request;
+
+    if (mTransmissionEnd->isScheduled()) {
+        if (mQueueLength > 0 && mQueue.size() >= mQueueLength) {
+            EV_WARN << "dropping frame due to full queue" << endl;
+            delete frame;
+        } else {
+            mQueue.push_back(frame);
+        }
+    } else {
+        transmitFrame(frame);
+    }
+}
+
+void FastRadioDriver::handleDataIndication(FastRadioFrame* frame)
+{
+    auto gn = check_and_cast<GeoNetPacket*>(frame->decapsulate());
+    gn->setSourceAddress(frame->getSourceAddress());
+    gn->setDestinationAddress(frame->getDestinationAddress());
+    delete frame;
+
+    indicateData(gn);
+}
+
+void FastRadioDriver::transmitFrame(FastRadioFrame* frame)
+{
+    const SimTime duration = computeAirTime(*frame);
+    mTransmittingUntil = simTime() + duration;
+    mMedium->transmit(*this, *frame, duration);
+    delete frame;
+    scheduleAt(mTransmittingUntil + mInterFrameSpace, mTransmissionEnd);
+}
+
+SimTime FastRadioDriver::computeAirTime(const FastRadioFrame& frame) const
+{
+    const double bitsPerSymbol = mBitrate * ofdmSymbol.dbl();
+    const double bits = ofdmServiceTailBits + frame.getBitLength();
+    return ofdmPreamble + ofdmSymbol * std::ceil(bits / bitsPerSymbol);
+}
+
+Position FastRadioDriver::getPosition() const
+{
+    return mPositionProvider->getCartesianPosition();
+}
+
+void FastRadioDriver::senseTransmission(SimTime duration)
+{
+    const SimTime now = simTime();
+    if (mBusyUntil <= now) {
+        // channel has been idle since end of last sensed transmission
+        mChannelLoadSampler.busy(false, mBusyUntil);
+        mChannelLoadSampler.busy(true, now);
+    }
+    mBusyUntil = std::max(mBusyUntil, now + duration);
+}
+
+bool FastRadioDriver::isTransmitting() const
+{
+    return mTransmittingUntil > simTime();
+}
+
+double FastRadioDriver::getCollisionProbability() const
+{
+    return std::min(1.0, mCollisionFactor * mChannelLoad);
+}
+
+void FastRadioDriver::reportChannelLoad()
+{
+    Enter_Method_Silent();
+    updateChannelLoad();
+}
+
+void FastRadioDriver::updateChannelLoad()
+{
+    if (mBusyUntil <= simTime()) {
+        mChannelLoadSampler.busy(false, mBusyUntil);
+    }
+    mChannelLoad = mChannelLoadSampler.cbr();
+    emit(RadioDriverBase::ChannelLoadSignal, mChannelLoad);
+}
+
+} // namespace artery
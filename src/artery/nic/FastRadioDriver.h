@@ -0,0 +1,97 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_FASTRADIODRIVER_H_R8XN4CHA
+#define ARTERY_FASTRADIODRIVER_H_R8XN4CHA
+
+#include "artery/nic/ChannelLoadReporter.h"
+#include "artery/nic/ChannelLoadSampler.h"
+#include "artery/nic/RadioDriverBase.h"
+#include "artery/utility/Geometry.h"
+#include <omnetpp/simtime.h>
+#include <vanetza/net/mac_address.hpp>
+#include <cstddef>
+#include <deque>
+
+namespace artery
+{
+
+class FastRadioMedium;
+class FastRadioFrame;
+class PositionProvider;
+
+/**
+ * FastRadioDriver is a radio driver without MAC and PHY layer simulation.
+ *
+ * Frames are passed to a FastRadioMedium for abstract reception decisions. Queued frames are sent
+ * one after another without channel contention, hence collisions are solely modelled by
+ * the receiver's channel busy ratio (CBR). Frames sensed by this driver yield its CBR.
+ */
+class FastRadioDriver : public RadioDriverBase, public ChannelLoadReporter::Client
+{
+public:
+    ~FastRadioDriver();
+
+    void initialize() override;
+    void handleMessage(omnetpp::cMessage*) override;
+    void finish() override;
+
+    const vanetza::MacAddress& getAddress() const { return mAddress; }
+    Position getPosition() const;
+
+    /**
+     * Channel is sensed busy by a transmission starting now
+     * \param duration air time of transmission
+     */
+    void senseTransmission(omnetpp::SimTime duration);
+
+    /**
+     * Check if driver is transmitting, i.e. cannot receive (half duplex)
+     */
+    bool isTransmitting() const;
+
+    /**
+     * Get probability of a reception failing due to collisions
+     * \return probability derived from most recently measured CBR
+     */
+    double getCollisionProbability() const;
+
+protected:
+    void handleDataRequest(omnetpp::cMessage*) override;
+    void handleDataIndication(FastRadioFrame*);
+    void reportChannelLoad() override;
+
+private:
+    friend class FastRadioMedium;
+
+    void transmitFrame(FastRadioFrame*);
+    omnetpp::SimTime computeAirTime(const FastRadioFrame&) const;
+    void updateChannelLoad();
+
+    FastRadioMedium* mMedium = nullptr;
+    std::size_t mMediumSlot = 0; /*< managed by medium */
+    const PositionProvider* mPositionProvider = nullptr;
+    omnetpp::cGate* mRadioIn = nullptr;
+    vanetza::MacAddress mAddress;
+
+    double mBitrate = 0.0;
+    int mMacOverhead = 0;
+    omnetpp::SimTime mInterFrameSpace;
+    unsigned mQueueLength = 0;
+    std::deque<FastRadioFrame*> mQueue;
+    omnetpp::cMessage* mTransmissionEnd = nullptr;
+    omnetpp::SimTime mTransmittingUntil;
+
+    double mCollisionFactor = 0.0;
+    omnetpp::SimTime mBusyUntil;
+    ChannelLoadSampler mChannelLoadSampler;
+    double mChannelLoad = 0.0;
+    omnetpp::cMessage* mChannelLoadReport = nullptr;
+    omnetpp::SimTime mChannelLoadReportInterval;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_FASTRADIODRIVER_H_R8XN4CHA */
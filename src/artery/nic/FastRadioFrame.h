@@ -0,0 +1,38 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_FASTRADIOFRAME_H_P3ZV6NDE
+#define ARTERY_FASTRADIOFRAME_H_P3ZV6NDE
+
+#include <omnetpp/cpacket.h>
+#include <vanetza/net/mac_address.hpp>
+
+namespace artery
+{
+
+/**
+ * FastRadioFrame carries a GeoNetworking packet between FastRadioDrivers
+ */
+class FastRadioFrame : public omnetpp::cPacket
+{
+public:
+    using omnetpp::cPacket::cPacket;
+
+    void setSourceAddress(const vanetza::MacAddress& addr) { mSourceAddress = addr; }
+    const vanetza::MacAddress& getSourceAddress() const { return mSourceAddress; }
+
+    void setDestinationAddress(const vanetza::MacAddress& addr) { mDestinationAddress = addr; }
+    const vanetza::MacAddress& getDestinationAddress() const { return mDestinationAddress; }
+
+    FastRadioFrame* dup() const override { return new FastRadioFrame(*this); }
+
+private:
+    vanetza::MacAddress mSourceAddress;
+    vanetza::MacAddress mDestinationAddress;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_FASTRADIOFRAME_H_P3ZV6NDE */
@@ -0,0 +1,196 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/nic/FastRadioMedium.h"
+#include "artery/nic/FastRadioDriver.h"
+#include "artery/nic/FastRadioFrame.h"
+#include <omnetpp/cstringtokenizer.h>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace artery
+{
+
+Define_Module(FastRadioMedium)
+
+using namespace omnetpp;
+
+namespace
+{
+    const double speedOfLight = 299792458.0; // m/s
+}
+
+void FastRadioMedium::initialize()
+{
+    parseErrorRates(par("packetErrorRates"));
+
+    // decodable range ends where PER reaches 1.0 first
+    auto undecodable = std::find_if(mErrorRates.begin(), mErrorRates.end(),
+            [](const std::pair<double, double>& entry) { return entry.second >= 1.0; });
+    mDecodingRange = undecodable != mErrorRates.end() ? undecodable->first : mErrorRates.back().first;
+
+    mSensingRange = par("sensingRange");
+    if (mSensingRange < 0.0) {
+        mSensingRange = mDecodingRange;
+    } else if (mSensingRange < mDecodingRange) {
+        throw cRuntimeError("sensingRange has to cover decodable range of %f m", mDecodingRange);
+    }
+
+    mCellSize = par("cellSize");
+    if (mCellSize <= 0.0) {
+        mCellSize = std::max(mSensingRange, 1.0);
+    }
+}
+
+void FastRadioMedium::handleMessage(cMessage*)
+{
+    throw cRuntimeError("FastRadioMedium does not handle any messages");
+}
+
+void FastRadioMedium::parseErrorRates(const char* table)
+{
+    const std::vector<double> values = cStringTokenizer(table).asDoubleVector();
+    if (values.empty() || values.size() % 2 != 0) {
+        throw cRuntimeError("packetErrorRates requires pairs of distance and packet error rate");
+    }
+
+    mErrorRates.clear();
+    for (std::size_t i = 0; i < values.size(); i += 2) {
+        const double distance = values[i];
+        const double per = values[i + 1];
+        if (!mErrorRates.empty() && distance <= mErrorRates.back().first) {
+            throw cRuntimeError("distances of packetErrorRates have to be strictly ascending");
+        } else if (per < 0.0 || per > 1.0) {
+            throw cRuntimeError("packet error rate %f at %f m is out of range [0, 1]", per, distance);
+        }
+        mErrorRates.emplace_back(distance, per);
+    }
+}
+
+vanetza::MacAddress FastRadioMedium::registerDriver(FastRadioDriver* driver)
+{
+    Enter_Method_Silent();
+    ASSERT(driver);
+    driver->mMediumSlot = mDrivers.size();
+    mDrivers.push_back(driver);
+    mGridValid = false;
+
+    // locally administered unicast address
+    const std::uint32_t id = mNextAddress++;
+    vanetza::MacAddress address;
+    address.octets = { 0x02, 0x00,
+        static_cast<uint8_t>(id >> 24), static_cast<uint8_t>(id >> 16),
+        static_cast<uint8_t>(id >> 8), static_cast<uint8_t>(id) };
+    return address;
+}
+
+void FastRadioMedium::unregisterDriver(FastRadioDriver* driver)
+{
+    Enter_Method_Silent();
+    ASSERT(driver && mDrivers.at(driver->mMediumSlot) == driver);
+    mDrivers[driver->mMediumSlot] = mDrivers.back();
+    mDrivers[driver->mMediumSlot]->mMediumSlot = driver->mMediumSlot;
+    mDrivers.pop_back();
+    mGridValid = false;
+}
+
+void FastRadioMedium::transmit(const FastRadioDriver& sender, const FastRadioFrame& frame, SimTime duration)
+{
+    Enter_Method_Silent();
+    if (!mGridValid || mGridTime != simTime()) {
+        updateGrid();
+    }
+
+    const Position txPos = sender.getPosition();
+    const double tx = txPos.x.value();
+    const double ty = txPos.y.value();
+    const bool broadcast = frame.getDestinationAddress() == vanetza::cBroadcastMacAddress;
+
+    for (long cx = getCellIndex(tx - mSensingRange); cx <= getCellIndex(tx + mSensingRange); ++cx) {
+        for (long cy = getCellIndex(ty - mSensingRange); cy <= getCellIndex(ty + mSensingRange); ++cy) {
+            auto cell = mGrid.find(getCellKey(cx, cy));
+            if (cell == mGrid.end()) {
+                continue;
+            }
+
+            for (const GridEntry& entry : cell->second) {
+                FastRadioDriver* receiver = entry.driver;
+                const double distance = artery::distance(txPos, entry.position).value();
+                if (receiver == &sender || distance > mSensingRange) {
+                    continue;
+                }
+
+                receiver->senseTransmission(duration);
+                if (distance > mDecodingRange || receiver->isTransmitting()) {
+                    continue;
+                } else if (!broadcast && receiver->getAddress() != frame.getDestinationAddress()) {
+                    continue;
+                }
+
+                const double per = computePacketErrorRate(txPos, entry.position, distance);
+                if (per >= 1.0 || (per > 0.0 && uniform(0.0, 1.0) < per)) {
+                    continue;
+                }
+
+                const double collision = receiver->getCollisionProbability();
+                if (collision > 0.0 && uniform(0.0, 1.0) < collision) {
+                    continue;
+                }
+
+                const SimTime delay { distance / speedOfLight };
+                sendDirect(frame.dup(), delay, duration, receiver->mRadioIn);
+            }
+        }
+    }
+}
+
+double FastRadioMedium::getPacketErrorRate(double distance) const
+{
+    auto upper = std::lower_bound(mErrorRates.begin(), mErrorRates.end(), distance,
+            [](const std::pair<double, double>& entry, double d) { return entry.first < d; });
+    if (upper == mErrorRates.end()) {
+        return 1.0;
+    } else if (upper == mErrorRates.begin() || upper->first == distance) {
+        return upper->second;
+    } else {
+        auto lower = std::prev(upper);
+        const double ratio = (distance - lower->first) / (upper->first - lower->first);
+        return lower->second + ratio * (upper->second - lower->second);
+    }
+}
+
+double FastRadioMedium::computePacketErrorRate(const Position&, const Position&, double distance) const
+{
+    return getPacketErrorRate(distance);
+}
+
+void FastRadioMedium::updateGrid()
+{
+    for (auto& cell : mGrid) {
+        cell.second.clear();
+    }
+
+    for (FastRadioDriver* driver : mDrivers) {
+        const Position pos = driver->getPosition();
+        const CellKey key = getCellKey(getCellIndex(pos.x.value()), getCellIndex(pos.y.value()));
+        mGrid[key].push_back(GridEntry { driver, pos });
+    }
+
+    mGridTime = simTime();
+    mGridValid = true;
+}
+
+FastRadioMedium::CellKey FastRadioMedium::getCellKey(long x, long y) const
+{
+    return (static_cast<CellKey>(x) << 32) ^ (static_cast<CellKey>(y) & 0xffffffff);
+}
+
+long FastRadioMedium::getCellIndex(double coordinate) const
+{
+    return static_cast<long>(std::floor(coordinate / mCellSize));
+}
+
+} // namespace artery
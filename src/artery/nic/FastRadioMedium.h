@@ -0,0 +1,105 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_FASTRADIOMEDIUM_H_7GQK2WLM
+#define ARTERY_FASTRADIOMEDIUM_H_7GQK2WLM
+
+#include "artery/utility/Geometry.h"
+#include <omnetpp/csimplemodule.h>
+#include <omnetpp/simtime.h>
+#include <vanetza/net/mac_address.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace artery
+{
+
+class FastRadioDriver;
+class FastRadioFrame;
+
+/**
+ * FastRadioMedium connects FastRadioDrivers without simulating a physical layer.
+ *
+ * Receptions are decided by a packet error rate (PER) table over distance and a collision model
+ * driven by the receiver's channel busy ratio. Receivers are found by a uniform grid of driver
+ * positions, which is refreshed at most once per simulation time step, and frames are directly
+ * delivered to receiving drivers at the end of their air time.
+ */
+class FastRadioMedium : public omnetpp::cSimpleModule
+{
+public:
+    void initialize() override;
+    void handleMessage(omnetpp::cMessage*) override;
+
+    /**
+     * Register driver at medium
+     * \param driver radio driver
+     * \return unique link layer address assigned to driver
+     */
+    vanetza::MacAddress registerDriver(FastRadioDriver* driver);
+
+    /**
+     * Unregister driver, it will not receive any further frames
+     * \param driver registered radio driver
+     */
+    void unregisterDriver(FastRadioDriver* driver);
+
+    /**
+     * Transmit frame to drivers in range
+     * \param sender transmitting driver
+     * \param frame transmitted frame, copies are delivered to receivers
+     * \param duration air time of frame
+     */
+    void transmit(const FastRadioDriver& sender, const FastRadioFrame& frame, omnetpp::SimTime duration);
+
+    /**
+     * Look up packet error rate in PER table
+     * \param distance distance between transmitter and receiver [m]
+     * \return interpolated error rate, 1.0 beyond range of table
+     */
+    double getPacketErrorRate(double distance) const;
+
+protected:
+    /**
+     * Compute packet error rate of a link, e.g. refined by link classification in derived media
+     * \param tx transmitter position
+     * \param rx receiver position
+     * \param distance distance between both positions [m]
+     * \return packet error rate between 0.0 and 1.0
+     */
+    virtual double computePacketErrorRate(const Position& tx, const Position& rx, double distance) const;
+
+private:
+    struct GridEntry
+    {
+        FastRadioDriver* driver;
+        Position position;
+    };
+
+    using CellKey = std::int64_t;
+
+    void parseErrorRates(const char*);
+    void updateGrid();
+    CellKey getCellKey(long x, long y) const;
+    long getCellIndex(double coordinate) const;
+
+    std::vector<FastRadioDriver*> mDrivers;
+    std::unordered_map<CellKey, std::vector<GridEntry>> mGrid;
+    omnetpp::SimTime mGridTime;
+    bool mGridValid = false;
+    std::uint32_t mNextAddress = 1;
+
+    std::vector<std::pair<double, double>> mErrorRates; /*< distance and PER, ascending distances */
+    double mDecodingRange = 0.0;
+    double mSensingRange = 0.0;
+    double mCellSize = 0.0;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_FASTRADIOMEDIUM_H_7GQK2WLM */
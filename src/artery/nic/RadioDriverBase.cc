@@ -1,5 +1,7 @@
 #include "artery/nic/RadioDriverBase.h"
 #include "artery/nic/RadioDriverProperties.h"
+#include <omnetpp/checkandcast.h>
+#include <omnetpp/clog.h>
 
 using namespace omnetpp;
 
@@ -13,6 +15,14 @@ void RadioDriverBase::initialize()
     mUpperLayerIn = gate("upperLayer$i");
     mUpperLayerOut = gate("upperLayer$o");
     mPropertiesOut = gate("properties");
+
+    if (hasPar("directIndication") && par("directIndication").boolValue()) {
+        cGate* upperLayerIn = mUpperLayerOut->getPathEndGate();
+        mDirectUpperLayer = dynamic_cast<UpperLayer*>(upperLayerIn->getOwnerModule());
+        if (!mDirectUpperLayer) {
+            EV_WARN << "upper layer does not support direct indications, sending messages instead\n";
+        }
+    }
 }
 
 void RadioDriverBase::handleMessage(cMessage* msg)
@@ -31,7 +41,12 @@ bool RadioDriverBase::isDataRequest(cMessage* msg)
 
 void RadioDriverBase::indicateData(cMessage* msg)
 {
-    send(msg, mUpperLayerOut);
+    if (mDirectUpperLayer) {
+        drop(msg);
+        mDirectUpperLayer->indicateData(check_and_cast<cPacket*>(msg));
+    } else {
+        send(msg, mUpperLayerOut);
+    }
 }
 
 void RadioDriverBase::indicateProperties(RadioDriverProperties* properties)
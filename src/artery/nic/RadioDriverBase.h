@@ -3,6 +3,7 @@
 
 #include <omnetpp/ccomponent.h>
 #include <omnetpp/cmessage.h>
+#include <omnetpp/cpacket.h>
 #include <omnetpp/csimplemodule.h>
 
 namespace artery
@@ -13,6 +14,23 @@ struct RadioDriverProperties;
 class RadioDriverBase : public omnetpp::cSimpleModule
 {
     public:
+        /**
+         * UpperLayer receives data indications by method calls instead of messages
+         *
+         * Radio drivers with enabled directIndication parameter call the module connected to
+         * their upper layer gate directly if it implements this interface.
+         */
+        class UpperLayer
+        {
+            public:
+                /**
+                 * Indicate a received packet
+                 * \param packet received packet, ownership is passed to upper layer
+                 */
+                virtual void indicateData(omnetpp::cPacket* packet) = 0;
+                virtual ~UpperLayer() = default;
+        };
+
         static const omnetpp::simsignal_t ChannelLoadSignal;
 
         virtual void initialize() override;
@@ -28,6 +46,7 @@ class RadioDriverBase : public omnetpp::cSimpleModule
         omnetpp::cGate* mUpperLayerIn;
         omnetpp::cGate* mUpperLayerOut;
         omnetpp::cGate* mPropertiesOut;
+        UpperLayer* mDirectUpperLayer = nullptr;
 };
 
 } // namespace artery
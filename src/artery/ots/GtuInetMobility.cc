@@ -89,12 +89,30 @@ void GtuInetMobility::initialize(const ots::GtuObject& gtu)
 }
 
 void GtuInetMobility::update(const ots::GtuObject& gtu)
+{
+    apply(gtu);
+    notify();
+}
+
+void GtuInetMobility::apply(const ots::GtuObject& gtu)
 {
     setInetProperties(gtu);
-    emit(inet::IMobility::mobilityStateChangedSignal, this);
-    emit(gtuPositionChangedSignal, &gtu);
-    updateVisualRepresentation();
     mLastGtuObject = gtu;
+    mVisualDirty = true;
+}
+
+void GtuInetMobility::notify()
+{
+    emit(inet::IMobility::mobilityStateChangedSignal, this);
+    emit(gtuPositionChangedSignal, &mLastGtuObject);
+}
+
+void GtuInetMobility::refreshDisplay() const
+{
+    if (mVisualDirty) {
+        const_cast<GtuInetMobility*>(this)->updateVisualRepresentation();
+        mVisualDirty = false;
+    }
 }
 
 void GtuInetMobility::setInetProperties(const ots::GtuObject& gtu)
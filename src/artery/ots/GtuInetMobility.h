@@ -21,6 +21,7 @@ class GtuInetMobility :
 public:
     void initialize(int stage) override;
     int numInitStages() const override;
+    void refreshDisplay() const override;
 
     // inet::IMobility interface
     double getMaxSpeed() const override;
@@ -34,6 +35,8 @@ public:
     // ots::GtuSink
     void initialize(const ots::GtuObject&) override;
     void update(const ots::GtuObject&) override;
+    void apply(const ots::GtuObject&) override;
+    void notify() override;
 
     const ots::GtuObject& getLastGtuObject() const { return mLastGtuObject; }
     Position getPosition() const;
@@ -52,6 +55,7 @@ private:
     omnetpp::cModule* mVisualRepresentation = nullptr;
     const inet::CanvasProjection* mCanvasProjection = nullptr;
     const inet::IGeographicCoordinateSystem* mCoordinateSystem = nullptr;
+    mutable bool mVisualDirty = false; /*< visual representation is refreshed lazily by refreshDisplay */
 };
 
 } // namespace artery
@@ -64,8 +64,10 @@ void GtuPositionProvider::updatePositionFix()
             1.0 * si::meter_per_second);
 
     // prevent signal listeners to modify our position data
-    PositionFixObject tmp { mPositionFix };
-    emit(positionFixSignal, &tmp);
+    if (mayHaveListeners(positionFixSignal)) {
+        PositionFixObject tmp { mPositionFix };
+        emit(positionFixSignal, &tmp);
+    }
 }
 
 } // namespace artery
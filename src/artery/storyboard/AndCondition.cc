@@ -1,4 +1,6 @@
 #include "artery/storyboard/AndCondition.h"
+#include <algorithm>
+#include <iterator>
 
 namespace artery
 {
@@ -10,7 +12,7 @@ public:
         return lhs && rhs;
     }
 
-    ConditionResult operator()(const std::set<const Vehicle*>& lhs, bool rhs) const {
+    ConditionResult operator()(const VehicleSet& lhs, bool rhs) const {
         if(!rhs) {
             return false;
         } else {
@@ -18,7 +20,7 @@ public:
         }
     }
 
-    ConditionResult operator()(bool lhs, const std::set<const Vehicle*>& rhs) const {
+    ConditionResult operator()(bool lhs, const VehicleSet& rhs) const {
         if(!lhs) {
             return false;
         } else {
@@ -26,10 +28,10 @@ public:
         }
     }
 
-    ConditionResult operator()(std::set<const Vehicle*> lhs, std::set<const Vehicle*> rhs) const {
-         std::set<const Vehicle*> intersect;
+    ConditionResult operator()(const VehicleSet& lhs, const VehicleSet& rhs) const {
+         VehicleSet intersect;
          std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
-                 std::inserter(intersect, intersect.begin()));
+                 std::back_inserter(intersect));
          return intersect;
     }
 };
@@ -51,6 +53,65 @@ ConditionResult AndCondition::testCondition(const Vehicle& car)
     }
 }
 
+boost::optional<geometry::Box> AndCondition::getEnvelope() const
+{
+    auto envelope = m_left->getEnvelope();
+    // right envelope is only applicable if skipping the left condition is harmless
+    if (m_left->isStateless()) {
+        auto right = m_right->getEnvelope();
+        if (!envelope) {
+            envelope = right;
+        } else if (right) {
+            geometry::Box intersection;
+            if (boost::geometry::intersection(*envelope, *right, intersection)) {
+                envelope = intersection;
+            }
+        }
+    }
+    return envelope;
+}
+
+auto AndCondition::getTimeWindow() const -> boost::optional<TimeWindow>
+{
+    auto window = m_left->getTimeWindow();
+    if (m_left->isStateless()) {
+        auto right = m_right->getTimeWindow();
+        if (!window) {
+            window = right;
+        } else if (right && right->begin <= window->end && window->begin <= right->end) {
+            window->begin = std::max(window->begin, right->begin);
+            window->end = std::min(window->end, right->end);
+        }
+    }
+    return window;
+}
+
+auto AndCondition::getDependency() const -> Dependency
+{
+    const Dependency left = m_left->getDependency();
+    return left == m_right->getDependency() ? left : Dependency::Dynamic;
+}
+
+double AndCondition::getCost() const
+{
+    return m_left->getCost() + m_right->getCost();
+}
+
+bool AndCondition::isStateless() const
+{
+    return m_left->isStateless() && m_right->isStateless();
+}
+
+void AndCondition::optimize()
+{
+    m_left->optimize();
+    m_right->optimize();
+    // a stateful operand would be tested for other vehicles after swapping
+    if (isStateless() && m_right->getCost() < m_left->getCost()) {
+        std::swap(m_left, m_right);
+    }
+}
+
 void AndCondition::drawCondition(omnetpp::cCanvas* canvas)
 {
     m_left->drawCondition(canvas);
@@ -27,6 +27,30 @@ public:
 
     void drawCondition(omnetpp::cCanvas*) override;
 
+    /**
+     * Envelope of left condition, right condition is only tested within this envelope.
+     * Envelopes of both conditions are intersected if the left condition is stateless.
+     */
+    boost::optional<geometry::Box> getEnvelope() const override;
+
+    /**
+     * Time window of left condition, also intersected with right one's if left condition is stateless
+     */
+    boost::optional<TimeWindow> getTimeWindow() const override;
+
+    /**
+     * Common dependency of both conditions or dynamic if they differ
+     */
+    Dependency getDependency() const override;
+
+    double getCost() const override;
+    bool isStateless() const override;
+
+    /**
+     * Test cheaper condition first if both conditions are stateless
+     */
+    void optimize() override;
+
 private:
     ConditionPtr m_left;
     ConditionPtr m_right;
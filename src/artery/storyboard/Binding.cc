@@ -39,6 +39,8 @@ PYBIND11_EMBEDDED_MODULE(storyboard, m) {
 
     py::class_<omnetpp::cRNG>(m, "RNG");
 
+    // Condition has no trampoline class on purpose: Python scripts can only compose native conditions,
+    // thus stories are evaluated without entering the interpreter once createStories has returned
     py::class_<Condition, std::shared_ptr<Condition>>(m, "Condition");
 
     py::class_<AndCondition, std::shared_ptr<AndCondition>, Condition>(m, "AndCondition")
@@ -109,7 +111,9 @@ PYBIND11_EMBEDDED_MODULE(storyboard, m) {
 
 
     py::class_<Story, std::shared_ptr<Story>>(m, "Story")
-        .def(py::init<std::shared_ptr<Condition>, std::vector<std::shared_ptr<EffectFactory>>>());
+        .def(py::init<std::shared_ptr<Condition>, std::vector<std::shared_ptr<EffectFactory>>>())
+        .def("setUpdateInterval", &Story::setUpdateInterval,
+                py::arg("interval"), py::arg("offset") = omnetpp::SimTime::ZERO);
 
     py::class_<artery::Storyboard>(m, "Storyboard")
         .def("registerStory", &artery::Storyboard::registerStory)
@@ -33,6 +33,8 @@ public:
      * \return result of the test
      */
     ConditionResult testCondition(const Vehicle& car);
+    bool isStateless() const override { return true; }
+    Dependency getDependency() const override { return Dependency::PerVehicle; }
 
 private:
     std::set<std::string> m_cars;
@@ -4,6 +4,9 @@
 #include "artery/storyboard/ConditionResult.h"
 #include "artery/storyboard/Macros.h"
 #include "artery/storyboard/Vehicle.h"
+#include "artery/utility/Geometry.h"
+#include <boost/optional/optional.hpp>
+#include <omnetpp/simtime.h>
 
 namespace omnetpp { class cCanvas; }
 
@@ -16,9 +19,72 @@ namespace artery
 class STORYBOARD_API Condition
 {
 public:
+    /**
+     * Inputs a condition's result depends on
+     */
+    enum class Dependency
+    {
+        Time, /*< same result for all vehicles at a time */
+        PerVehicle, /*< result for a vehicle never changes once it has been tested */
+        Dynamic /*< anything else, e.g. vehicle kinematics */
+    };
+
+    /**
+     * Closed time interval
+     */
+    struct TimeWindow
+    {
+        omnetpp::SimTime begin;
+        omnetpp::SimTime end;
+    };
+
     virtual ~Condition() = default;
     virtual ConditionResult testCondition(const Vehicle& car) = 0;
     virtual void drawCondition(omnetpp::cCanvas*) {};
+
+    /**
+     * Area outside of which this condition is false for any vehicle
+     *
+     * Storyboard skips testing vehicles outside of this envelope.
+     * Hence, conditions must not change their state either when testing such vehicles.
+     * \return bounding box or none if the condition is not bounded spatially
+     */
+    virtual boost::optional<geometry::Box> getEnvelope() const { return boost::none; }
+
+    /**
+     * Time window outside of which this condition is false for any vehicle
+     *
+     * Storyboard skips testing vehicles outside of this window like outside of the envelope.
+     * \return time window or none if the condition is not bounded in time
+     */
+    virtual boost::optional<TimeWindow> getTimeWindow() const { return boost::none; }
+
+    /**
+     * Storyboard tests vehicles of per-vehicle conditions only once
+     */
+    virtual Dependency getDependency() const { return Dependency::Dynamic; }
+
+    /**
+     * Rough cost of testing a single vehicle relative to a trivial comparison
+     *
+     * Composite conditions may test cheaper operands first.
+     */
+    virtual double getCost() const { return 1.0; }
+
+    /**
+     * Stateless conditions yield the same result no matter which vehicles have been tested before
+     *
+     * Only stateless operands may be skipped or reordered by composite conditions.
+     * Conditions drawing random numbers or counting vehicles are not stateless, for example.
+     */
+    virtual bool isStateless() const { return false; }
+
+    /**
+     * Reorder operands of composite conditions without changing their results
+     *
+     * Storyboard calls this once when a story is registered.
+     */
+    virtual void optimize() {}
 };
 
 } // namespace artery
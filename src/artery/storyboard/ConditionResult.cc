@@ -1,9 +1,16 @@
 #include "artery/storyboard/ConditionResult.h"
 #include <boost/variant/static_visitor.hpp>
+#include <algorithm>
 
 namespace artery
 {
 
+void normalize(VehicleSet& vehicles)
+{
+    std::sort(vehicles.begin(), vehicles.end());
+    vehicles.erase(std::unique(vehicles.begin(), vehicles.end()), vehicles.end());
+}
+
 bool is_true(const ConditionResult& result)
 {
     struct visitor : boost::static_visitor<bool>
@@ -12,7 +19,7 @@ bool is_true(const ConditionResult& result)
             return b;
         }
 
-        bool operator()(const std::set<const Vehicle*>& s) const {
+        bool operator()(const VehicleSet& s) const {
             return !s.empty();
         }
     };
@@ -2,8 +2,8 @@
 #define ARTERY_CONDITIONRESULT_H_2UBLV1EE
 
 #include "artery/storyboard/Macros.h"
+#include <boost/container/small_vector.hpp>
 #include <boost/variant.hpp>
-#include <set>
 
 namespace artery
 {
@@ -11,7 +11,20 @@ namespace artery
 // forward declaration
 class Vehicle;
 
-using ConditionResult = boost::variant<bool, std::set<const Vehicle*>>;
+/**
+ * Set of vehicles affected by a condition
+ *
+ * Vehicles are sorted by their addresses without duplicates, i.e. like std::set but without node allocations.
+ * Few vehicles are stored inline.
+ */
+using VehicleSet = boost::container::small_vector<const Vehicle*, 8>;
+
+/**
+ * Sort vehicles and remove duplicates to form a proper VehicleSet
+ */
+void STORYBOARD_API normalize(VehicleSet&);
+
+using ConditionResult = boost::variant<bool, VehicleSet>;
 bool STORYBOARD_API is_true(const ConditionResult&);
 
 } // namespace artery
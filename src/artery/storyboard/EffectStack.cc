@@ -35,6 +35,7 @@ void EffectStack::removeFromMiddle(const Effect* effect)
         if(effectCount >= m_effects.size() - removedEffects) {
             ef->reapplyEffect();
         }
+        ++effectCount;
     }
 }
 
@@ -53,17 +54,26 @@ void EffectStack::removeEffect(const Effect* effect)
 
 void EffectStack::removeEffectsByStory(const Story* story)
 {
-    std::vector<Effect*> tmp;
-    // Add all Effects related to a Story in a tmp vector
-    for (auto effect : m_effects) {
-        if (&effect->getStory() == story) {
-            tmp.push_back(effect.get());
+    // Lowest Effect of the Story determines how far the Stack has to be unwound
+    auto lowest = std::find_if(m_effects.begin(), m_effects.end(),
+            [story](const std::shared_ptr<Effect>& effect) { return &effect->getStory() == story; });
+    const std::size_t depth = lowest - m_effects.begin();
+
+    // Unwind the Stack once for all Effects of the Story, usually these are on top
+    std::vector<std::shared_ptr<Effect>> others;
+    while (m_effects.size() > depth) {
+        std::shared_ptr<Effect> effect = std::move(m_effects.back());
+        m_effects.pop_back();
+        effect->removeEffect();
+        if (&effect->getStory() != story) {
+            others.push_back(std::move(effect));
         }
     }
 
-    // Remove all found Effects
-    for (auto& effect : tmp) {
-        removeEffect(effect);
+    // Apply the Effects of other Stories again in their previous order
+    for (auto& effect : boost::adaptors::reverse(others)) {
+        effect->reapplyEffect();
+        m_effects.push_back(std::move(effect));
     }
 }
 
@@ -28,6 +28,8 @@ public:
 
     /**
      * Removes all effect related to a specific Story
+     *
+     * Only Effects above the Story's lowest Effect are removed and applied again afterwards.
      * \param Story to remove
      */
     void removeEffectsByStory(const Story*);
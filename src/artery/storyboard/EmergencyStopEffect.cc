@@ -9,12 +9,25 @@ void EmergencyStopEffect::applyEffect()
 {
     traci::VehicleController& controller = getCar().getController();
     std::shared_ptr<traci::API> api = controller.getTraCI();
-    api->vehicle.setSpeedMode(controller.getVehicleId(), 0);
 
+    // query before setting speed mode, queries flush deferred set commands
     double speed = api->vehicle.getSpeed(controller.getVehicleId());
     double decel = api->vehicletype.getEmergencyDecel(controller.getTypeId());
+
+    tcpip::Storage speedMode;
+    speedMode.writeUnsignedByte(libsumo::TYPE_INTEGER);
+    speedMode.writeInt(0);
+    api->setVariable(libsumo::CMD_SET_VEHICLE_VARIABLE, libsumo::VAR_SPEEDSETMODE, controller.getVehicleId(), speedMode);
+
     if (speed > 0.0 && decel > 0.0) {
-        api->vehicle.slowDown(controller.getVehicleId(), 0.0, speed / decel);
+        tcpip::Storage slowDown;
+        slowDown.writeUnsignedByte(libsumo::TYPE_COMPOUND);
+        slowDown.writeInt(2);
+        slowDown.writeUnsignedByte(libsumo::TYPE_DOUBLE);
+        slowDown.writeDouble(0.0);
+        slowDown.writeUnsignedByte(libsumo::TYPE_DOUBLE);
+        slowDown.writeDouble(speed / decel);
+        api->setVariable(libsumo::CMD_SET_VEHICLE_VARIABLE, libsumo::CMD_SLOWDOWN, controller.getVehicleId(), slowDown);
     } else {
         controller.setSpeed(0.0 * boost::units::si::meter_per_second);
     }
@@ -25,6 +25,7 @@ class STORYBOARD_API LikelihoodCondition : public Condition
 public:
     LikelihoodCondition(omnetpp::cRNG*, double likelihood);
     ConditionResult testCondition(const Vehicle&) override;
+    Dependency getDependency() const override { return Dependency::PerVehicle; }
 
 private:
     const double mLikelihood;
@@ -17,6 +17,9 @@ public:
 
     ConditionResult testCondition(const Vehicle& car) override;
 
+    // admitted vehicles stay admitted, rejected ones are rejected for good because the count never decreases
+    Dependency getDependency() const override { return Dependency::PerVehicle; }
+
 private:
     const unsigned m_limit;
     std::set<const Vehicle*> m_count;
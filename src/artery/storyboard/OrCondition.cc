@@ -1,4 +1,6 @@
 #include "artery/storyboard/OrCondition.h"
+#include <algorithm>
+#include <iterator>
 
 namespace artery
 {
@@ -10,7 +12,7 @@ public:
         return lhs || rhs;
     }
 
-    ConditionResult operator()(const std::set<const Vehicle*>& lhs, bool rhs) const {
+    ConditionResult operator()(const VehicleSet& lhs, bool rhs) const {
         if (lhs.empty()) {
             return rhs;
         } else {
@@ -18,7 +20,7 @@ public:
         }
     }
 
-    ConditionResult operator()(bool lhs, const std::set<const Vehicle*>& rhs) const {
+    ConditionResult operator()(bool lhs, const VehicleSet& rhs) const {
         if (rhs.empty()) {
             return lhs;
         } else {
@@ -26,10 +28,10 @@ public:
         }
     }
 
-    ConditionResult operator()(const std::set<const Vehicle*>& lhs, const std::set<const Vehicle*>& rhs) const {
-        std::set<const Vehicle*> unite;
+    ConditionResult operator()(const VehicleSet& lhs, const VehicleSet& rhs) const {
+        VehicleSet unite;
         std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
-                std::inserter(unite , unite.begin()));
+                std::back_inserter(unite));
         return unite;
     }
 };
@@ -51,6 +53,57 @@ ConditionResult OrCondition::testCondition(const Vehicle& car)
     }
 }
 
+boost::optional<geometry::Box> OrCondition::getEnvelope() const
+{
+    boost::optional<geometry::Box> envelope = m_left->getEnvelope();
+    if (envelope) {
+        auto right = m_right->getEnvelope();
+        if (right) {
+            boost::geometry::expand(*envelope, *right);
+        } else {
+            envelope = boost::none;
+        }
+    }
+    return envelope;
+}
+
+auto OrCondition::getTimeWindow() const -> boost::optional<TimeWindow>
+{
+    auto window = m_left->getTimeWindow();
+    if (window) {
+        auto right = m_right->getTimeWindow();
+        if (right) {
+            window->begin = std::min(window->begin, right->begin);
+            window->end = std::max(window->end, right->end);
+        } else {
+            window = boost::none;
+        }
+    }
+    return window;
+}
+
+auto OrCondition::getDependency() const -> Dependency
+{
+    const Dependency left = m_left->getDependency();
+    return left == m_right->getDependency() ? left : Dependency::Dynamic;
+}
+
+double OrCondition::getCost() const
+{
+    return m_left->getCost() + m_right->getCost();
+}
+
+bool OrCondition::isStateless() const
+{
+    return m_left->isStateless() && m_right->isStateless();
+}
+
+void OrCondition::optimize()
+{
+    m_left->optimize();
+    m_right->optimize();
+}
+
 void OrCondition::drawCondition(omnetpp::cCanvas* canvas)
 {
     m_left->drawCondition(canvas);
@@ -26,6 +26,31 @@ public:
 
     void drawCondition(omnetpp::cCanvas*) override;
 
+    /**
+     * Envelope covering both conditions' envelopes if both are bounded
+     */
+    boost::optional<geometry::Box> getEnvelope() const override;
+
+    /**
+     * Time window covering both conditions' windows if both are bounded
+     */
+    boost::optional<TimeWindow> getTimeWindow() const override;
+
+    /**
+     * Common dependency of both conditions or dynamic if they differ
+     */
+    Dependency getDependency() const override;
+
+    double getCost() const override;
+    bool isStateless() const override;
+
+    /**
+     * Optimize both conditions but keep their order
+     *
+     * Swapping would change results: a vehicle set of the left condition takes precedence over a true right condition.
+     */
+    void optimize() override;
+
 private:
     ConditionPtr m_left;
     ConditionPtr m_right;
@@ -18,6 +18,7 @@ PolygonCondition::PolygonCondition(const std::vector<Position>& vertices) :
     }
 
     boost::geometry::correct(m_vertices);
+    boost::geometry::envelope(m_vertices, m_envelope);
 
     mDraw = true;
 }
@@ -28,6 +29,11 @@ ConditionResult PolygonCondition::testCondition(const Vehicle& car)
     return boost::geometry::within(point, m_vertices);
 }
 
+boost::optional<geometry::Box> PolygonCondition::getEnvelope() const
+{
+    return m_envelope;
+}
+
 int PolygonCondition::edges() const {
     return m_vertices.size() - 1;
 }
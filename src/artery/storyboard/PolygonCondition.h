@@ -28,8 +28,13 @@ public:
 
     virtual void drawCondition(omnetpp::cCanvas*) override;
 
+    boost::optional<geometry::Box> getEnvelope() const override;
+    double getCost() const override { return m_vertices.size(); }
+    bool isStateless() const override { return true; }
+
 private:
     std::vector<Position> m_vertices;
+    geometry::Box m_envelope;
     bool mDraw;
     int STORYBOARD_LOCAL edges() const;
 };
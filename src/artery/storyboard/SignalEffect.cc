@@ -1,5 +1,6 @@
 #include "artery/storyboard/SignalEffect.h"
 #include "artery/application/StoryboardSignal.h"
+#include <set>
 
 using namespace omnetpp;
 
@@ -8,18 +9,17 @@ namespace artery
 
 namespace {
 
-class Visitor : public boost::static_visitor<const std::set<const Vehicle*>&>
+class Visitor : public boost::static_visitor<std::set<const Vehicle*>>
 {
 public:
-    const std::set<const Vehicle*>& operator()(bool) const
+    std::set<const Vehicle*> operator()(bool) const
     {
-        static const std::set<const Vehicle*> empty;
-        return empty;
+        return {};
     }
 
-    const std::set<const Vehicle*>& operator()(std::set<const Vehicle*>& s) const
+    std::set<const Vehicle*> operator()(const VehicleSet& s) const
     {
-        return s;
+        return { s.begin(), s.end() };
     }
 };
 
@@ -23,6 +23,8 @@ public:
         return m_comp(car.get<VehicleDataProvider>().speed(), m_speed);
     }
 
+    bool isStateless() const override { return true; }
+
 private:
     boost::units::quantity<boost::units::si::velocity> m_speed;
     const COMP m_comp;
@@ -1,28 +1,54 @@
 #include "artery/storyboard/SpeedDifferenceCondition.h"
+#include <omnetpp/csimulation.h>
+#include <algorithm>
 
 namespace artery
 {
 
-ConditionResult SpeedDifferenceConditionFaster::testCondition(const Vehicle& car)
+auto SpeedDifferenceCondition::getSpeeds(const Vehicle& car) -> const SpeedSnapshot&
 {
-    std::set<const Vehicle*> affected;
-    for (auto& other : car.getVehicles()) {
-        if ((car.getController().getSpeed() - other.second.getController().getSpeed()) > mSpeedDifference) {
-            affected.insert(&other.second);
+    if (mSpeedsTime != omnetpp::simTime()) {
+        mSpeeds.clear();
+        for (auto& other : car.getVehicles()) {
+            mSpeeds.emplace_back(other.second.getController().getSpeed(), &other.second);
         }
+        std::sort(mSpeeds.begin(), mSpeeds.end(),
+            [](const SpeedSnapshot::value_type& a, const SpeedSnapshot::value_type& b) { return a.first < b.first; });
+        mSpeedsTime = omnetpp::simTime();
     }
+    return mSpeeds;
+}
+
+ConditionResult SpeedDifferenceConditionFaster::testCondition(const Vehicle& car)
+{
+    // vehicles slower than ego speed minus difference
+    const SpeedSnapshot& speeds = getSpeeds(car);
+    const Velocity threshold = car.getController().getSpeed() - mSpeedDifference;
+    auto last = std::lower_bound(speeds.begin(), speeds.end(), threshold,
+        [](const SpeedSnapshot::value_type& entry, Velocity speed) { return entry.first < speed; });
+
+    VehicleSet affected;
+    for (auto it = speeds.begin(); it != last; ++it) {
+        affected.push_back(it->second);
+    }
+    normalize(affected);
 
     return affected;
 }
 
 ConditionResult SpeedDifferenceConditionSlower::testCondition(const Vehicle& car)
 {
-    std::set<const Vehicle*> affected;
-    for (auto& other : car.getVehicles()) {
-        if ((other.second.getController().getSpeed() - car.getController().getSpeed()) > mSpeedDifference) {
-            affected.insert(&other.second);
-        }
+    // vehicles faster than ego speed plus difference
+    const SpeedSnapshot& speeds = getSpeeds(car);
+    const Velocity threshold = car.getController().getSpeed() + mSpeedDifference;
+    auto first = std::upper_bound(speeds.begin(), speeds.end(), threshold,
+        [](Velocity speed, const SpeedSnapshot::value_type& entry) { return speed < entry.first; });
+
+    VehicleSet affected;
+    for (auto it = first; it != speeds.end(); ++it) {
+        affected.push_back(it->second);
     }
+    normalize(affected);
 
     return affected;
 }
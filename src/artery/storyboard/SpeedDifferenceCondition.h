@@ -4,6 +4,9 @@
 #include "artery/storyboard/Condition.h"
 #include "boost/units/quantity.hpp"
 #include "boost/units/systems/si/velocity.hpp"
+#include <omnetpp/simtime.h>
+#include <utility>
+#include <vector>
 
 namespace artery
 {
@@ -18,8 +21,28 @@ public:
 
     virtual ConditionResult testCondition(const Vehicle& car) = 0;
 
+    // compares speed with all other vehicles
+    double getCost() const override { return 100.0; }
+    bool isStateless() const override { return true; }
+
 protected:
-    const boost::units::quantity<boost::units::si::velocity> mSpeedDifference;
+    using Velocity = boost::units::quantity<boost::units::si::velocity>;
+    using SpeedSnapshot = std::vector<std::pair<Velocity, const Vehicle*>>;
+
+    /**
+     * Get speeds of all vehicles in ascending order
+     *
+     * Speeds are fetched only once per simulation time step.
+     * \param car any vehicle of storyboard
+     * \return sorted speeds and their vehicles
+     */
+    const SpeedSnapshot& getSpeeds(const Vehicle& car);
+
+    const Velocity mSpeedDifference;
+
+private:
+    SpeedSnapshot mSpeeds;
+    omnetpp::SimTime mSpeedsTime = omnetpp::SimTime::getMaxTime();
 };
 
 
@@ -14,6 +14,12 @@ ConditionResult Story::testCondition(const Vehicle& car)
     return (m_condition->testCondition(car));
 }
 
+void Story::setUpdateInterval(omnetpp::SimTime interval, omnetpp::SimTime offset)
+{
+    m_updateInterval = interval;
+    m_updateOffset = offset;
+}
+
 auto Story::getEffectFactories() -> EffectFactories {
     return m_factories;
 }
@@ -5,6 +5,8 @@
 #include "artery/storyboard/EffectFactory.h"
 #include "artery/storyboard/Macros.h"
 #include "artery/storyboard/Vehicle.h"
+#include <boost/optional/optional.hpp>
+#include <omnetpp/simtime.h>
 #include <memory>
 #include <vector>
 
@@ -39,9 +41,21 @@ public:
 
     std::shared_ptr<Condition> getCondition() { return m_condition; }
 
+    /**
+     * Evaluate this story at most once per interval instead of storyboard's interval
+     * \param interval between evaluations (zero for every TraCI step)
+     * \param offset of first evaluation relative to storyboard's first step
+     */
+    void setUpdateInterval(omnetpp::SimTime interval, omnetpp::SimTime offset = omnetpp::SimTime::ZERO);
+
+    const boost::optional<omnetpp::SimTime>& getUpdateInterval() const { return m_updateInterval; }
+    omnetpp::SimTime getUpdateOffset() const { return m_updateOffset; }
+
 private:
     std::shared_ptr<Condition> m_condition;
     EffectFactories m_factories;
+    boost::optional<omnetpp::SimTime> m_updateInterval;
+    omnetpp::SimTime m_updateOffset;
 };
 
 } // namespace artery
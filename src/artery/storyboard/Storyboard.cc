@@ -9,6 +9,8 @@
 #include <omnetpp/ccomponent.h>
 #include <omnetpp/cexception.h>
 #include <pybind11/embed.h>
+#include <algorithm>
+#include <iterator>
 
 using namespace omnetpp;
 namespace py = pybind11;
@@ -73,8 +75,9 @@ void Storyboard::initialize(int stage)
             throw;
         }
 
-        // Par visualisation flag from ned
-        mDrawConditions = par("drawConditions");
+        // Par visualisation flag from ned, nobody would see the drawings without GUI
+        mDrawConditions = par("drawConditions").boolValue() && getEnvir()->isGUI();
+        mUpdateInterval = par("updateInterval");
     } else if(stage == 1) {
         std::string canvas = par("canvas");
         if(canvas == "storyboard") {
@@ -101,13 +104,25 @@ void Storyboard::receiveSignal(cComponent* source, simsignal_t signalId, const c
         cModule* nodeModule = dynamic_cast<cModule*>(node);
         artery::Middleware* appl = inet::findModuleFromPar<artery::Middleware>(par("middlewareModule"), nodeModule, false);
         if (appl) {
-            m_vehicles.emplace(nodeId, Vehicle { *appl, m_vehicles });
+            m_vehicles.emplace(nodeId, Vehicle { *appl, m_vehicles, m_positionIndex });
         } else {
             EV_DEBUG << "Node " << nodeId << " is not equipped with middleware module, skipped by Storyboard" << endl;
         }
     }
     else if (signalId == traciRemoveNodeSignal) {
-        m_vehicles.erase(nodeId);
+        auto found = m_vehicles.find(nodeId);
+        if (found != m_vehicles.end()) {
+            for (auto& storyCars : m_storyCars) {
+                storyCars.second.erase(&found->second);
+            }
+            for (auto& settledCars : m_settledCars) {
+                settledCars.second.erase(&found->second);
+            }
+            // effects of a removed vehicle are discarded without removing them from the vehicle
+            m_affectedCars.erase(&found->second);
+            m_vehicles.erase(found);
+            m_positionIndex.clear();
+        }
     }
 }
 
@@ -121,7 +136,8 @@ void Storyboard::receiveSignal(cComponent* source, simsignal_t signalId, const s
     }
     else if (signalId == traciInitSignal) {
         traci::Core* core = check_and_cast<traci::Core*>(source);
-        const libsumo::TraCIPositionVector& boundary = core->getAPI()->simulation.getNetBoundary();
+        mTraci = core->getAPI();
+        const libsumo::TraCIPositionVector& boundary = mTraci->simulation.getNetBoundary();
         mNetworkBoundary = traci::Boundary { boundary };
 
         try {
@@ -136,17 +152,110 @@ void Storyboard::receiveSignal(cComponent* source, simsignal_t signalId, const s
 
 void Storyboard::updateStoryboard()
 {
-    // iterate through all cars
-    for (auto& car : m_vehicles) {
-        // test all story conditions for each story
-        for (auto& story : m_stories) {
-            ConditionResult conditionTest = story->testCondition(car.second);
-            // check if the story has to be applied or removed
-            checkCar(car.second, conditionTest, story.get());
+    std::vector<Story*> dueStories;
+    for (std::size_t i = 0; i < m_stories.size(); ++i) {
+        if (isStoryDue(*m_stories[i], i)) {
+            dueStories.push_back(m_stories[i].get());
+        }
+    }
+    if (dueStories.empty()) {
+        return;
+    }
+
+    // index car positions once per step, stories with a spatial envelope query only nearby cars
+    m_positionIndex.update(m_vehicles);
+
+    // commands of effects are sent in one batch, their order is retained
+    mTraci->deferSetCommands(true);
+    try {
+        // stories are tested in order of their registration, thus effects are stacked as before
+        for (Story* story : dueStories) {
+            updateStory(*story);
+        }
+    } catch (...) {
+        mTraci->deferSetCommands(false);
+        throw;
+    }
+    mTraci->deferSetCommands(false);
+}
+
+bool Storyboard::isStoryDue(const Story& story, std::size_t index)
+{
+    const auto& storyInterval = story.getUpdateInterval();
+    const SimTime interval = storyInterval ? *storyInterval : mUpdateInterval;
+    if (interval <= SimTime::ZERO) {
+        return true;
+    }
+
+    const SimTime now = simTime();
+    auto next = m_nextUpdates.find(&story);
+    if (next == m_nextUpdates.end()) {
+        // spread stories sharing storyboard's interval evenly
+        const SimTime offset = storyInterval ? story.getUpdateOffset() : interval * (double(index) / m_stories.size());
+        next = m_nextUpdates.emplace(&story, now + offset).first;
+    }
+
+    if (now < next->second) {
+        return false;
+    }
+
+    // keep phase even if steps do not hit due times exactly
+    do {
+        next->second += interval;
+    } while (next->second <= now);
+    return true;
+}
+
+void Storyboard::updateStory(Story& story)
+{
+    const Condition& condition = *story.getCondition();
+    auto affected = m_storyCars.find(&story);
+    const bool anyAffected = affected != m_storyCars.end() && !affected->second.empty();
+
+    // story is false for all cars outside its time window, skip it unless effects need to be removed
+    const auto window = condition.getTimeWindow();
+    const SimTime now = simTime();
+    if (window && (now < window->begin || now > window->end) && !anyAffected) {
+        return;
+    }
+
+    const bool settle = condition.getDependency() == Condition::Dependency::PerVehicle;
+    const auto envelope = condition.getEnvelope();
+    if (!envelope) {
+        for (auto& car : m_vehicles) {
+            updateCar(car.second, story, settle);
+        }
+        return;
+    }
+
+    // index yields cars in order of their identifiers like unbounded stories, e.g. for limit conditions
+    std::set<Vehicle*> tested;
+    for (Vehicle* car : m_positionIndex.query(*envelope)) {
+        updateCar(*car, story, settle);
+        tested.insert(car);
+    }
+
+    // affected cars outside of envelope have left the story's area
+    if (anyAffected) {
+        std::vector<Vehicle*> left;
+        std::set_difference(affected->second.begin(), affected->second.end(), tested.begin(), tested.end(),
+                std::back_inserter(left));
+        for (Vehicle* car : left) {
+            removeStory(car, &story);
         }
     }
 }
 
+void Storyboard::updateCar(Vehicle& car, Story& story, bool settle)
+{
+    if (settle && !m_settledCars[&story].insert(&car).second) {
+        return;
+    }
+
+    ConditionResult conditionTest = story.testCondition(car);
+    checkCar(car, conditionTest, &story);
+}
+
 void Storyboard::drawConditions()
 {
     if (mCanvas != nullptr) {
@@ -178,6 +287,7 @@ void Storyboard::checkCar(Vehicle& car, ConditionResult& conditionResult, Story*
 
 void Storyboard::registerStory(std::shared_ptr<Story> story)
 {
+    story->getCondition()->optimize();
     m_stories.push_back(story);
 }
 
@@ -192,12 +302,8 @@ Position Storyboard::convertTraciPosition(double x, double y)
 
 bool Storyboard::storyApplied(Vehicle* car, const Story* story)
 {
-    if (m_affectedCars.count(car) == 0) {
-        return false;
-    }
-    else {
-        return m_affectedCars[car].isStoryOnStack(story);
-    }
+    auto found = m_storyCars.find(story);
+    return found != m_storyCars.end() && found->second.count(car) > 0;
 }
 
 void Storyboard::addEffect(const std::vector<std::shared_ptr<Effect>>& effects)
@@ -206,11 +312,13 @@ void Storyboard::addEffect(const std::vector<std::shared_ptr<Effect>>& effects)
     Story& story = effects.front()->getStory();
     // No EffectStack found for this car or the story is not applied yet
     // apply effect
-    if (m_affectedCars.count(&car) == 0 || !m_affectedCars[&car].isStoryOnStack(&story) ) {
+    if (!storyApplied(&car, &story)) {
+        EffectStack& stack = m_affectedCars[&car];
         for(auto effect : effects) {
-            m_affectedCars[&car].addEffect(std::move(effect));
+            stack.addEffect(std::move(effect));
             EV_DEBUG << "Effect added for: " << car.getId() << endl;
         }
+        m_storyCars[&story].insert(&car);
     }
     // Effect is already on Stack -> should never happen
     else {
@@ -220,7 +328,11 @@ void Storyboard::addEffect(const std::vector<std::shared_ptr<Effect>>& effects)
 
 void Storyboard::removeStory(Vehicle* car, const Story* story)
 {
-    m_affectedCars[car].removeEffectsByStory(story);
+    auto stack = m_affectedCars.find(car);
+    if (stack != m_affectedCars.end()) {
+        stack->second.removeEffectsByStory(story);
+    }
+    m_storyCars[story].erase(car);
 }
 
 int Storyboard::numInitStages() const
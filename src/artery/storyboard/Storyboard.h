@@ -3,6 +3,8 @@
 
 #include <map>
 #include <memory>
+#include <set>
+#include <unordered_map>
 #include <omnetpp/ccanvas.h>
 #include <omnetpp/clistener.h>
 #include <omnetpp/csimplemodule.h>
@@ -10,10 +12,12 @@
 #include "artery/storyboard/EffectStack.h"
 #include "artery/storyboard/Macros.h"
 #include "artery/storyboard/Vehicle.h"
+#include "artery/storyboard/VehiclePositionIndex.h"
 #include "artery/utility/Geometry.h"
 #include "traci/Boundary.h"
 
 namespace pybind11 { class module_; }
+namespace traci { class API; }
 
 namespace artery
 {
@@ -60,6 +64,28 @@ private:
      */
     void STORYBOARD_LOCAL updateStoryboard();
 
+    /**
+     * Checks if a story is due for evaluation according to its update interval
+     * \param story to check
+     * \param index of story in registration order, determines default phase offset
+     * \return true if story shall be evaluated at this step
+     */
+    bool STORYBOARD_LOCAL isStoryDue(const Story&, std::size_t index);
+
+    /**
+     * Tests a story's condition for all cars within the story's envelope and time window
+     * \param story to test
+     */
+    void STORYBOARD_LOCAL updateStory(Story&);
+
+    /**
+     * Tests a story's condition for a car unless its result is settled already
+     * \param car to test
+     * \param story to test
+     * \param settle true if result will not change for this car anymore
+     */
+    void STORYBOARD_LOCAL updateCar(Vehicle&, Story&, bool settle);
+
     /**
      * Adds all effects generated from a story
      * \param list all effects to add, all effects needs to be from the same story and the same car
@@ -96,11 +122,17 @@ private:
 
     std::unique_ptr<PythonContext> m_python;
     std::vector<std::shared_ptr<Story>> m_stories;
-    std::map<Vehicle*, EffectStack> m_affectedCars;
+    std::unordered_map<const Vehicle*, EffectStack> m_affectedCars;
+    std::unordered_map<const Story*, std::set<Vehicle*>> m_storyCars; /*< cars affected by each story */
+    std::unordered_map<const Story*, std::set<const Vehicle*>> m_settledCars; /*< cars tested by per-vehicle stories */
     std::map<std::string, Vehicle> m_vehicles;
+    VehiclePositionIndex m_positionIndex;
     bool mDrawConditions;
+    omnetpp::SimTime mUpdateInterval;
+    std::unordered_map<const Story*, omnetpp::SimTime> m_nextUpdates;
     omnetpp::cCanvas* mCanvas = nullptr;
     traci::Boundary mNetworkBoundary;
+    std::shared_ptr<traci::API> mTraci;
 };
 
 } // namespace artery
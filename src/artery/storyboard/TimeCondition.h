@@ -38,6 +38,9 @@ public:
      * \return result of the performed test
      */
     ConditionResult testCondition(const Vehicle& car);
+    bool isStateless() const override { return true; }
+    Dependency getDependency() const override { return Dependency::Time; }
+    boost::optional<TimeWindow> getTimeWindow() const override { return TimeWindow { m_begin, m_end }; }
 
 private:
     omnetpp::SimTime m_begin;
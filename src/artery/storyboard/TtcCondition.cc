@@ -5,6 +5,7 @@
 #include <boost/units/cmath.hpp>
 #include <boost/units/systems/si/length.hpp>
 #include <boost/units/systems/si/time.hpp>
+#include <omnetpp/csimulation.h>
 
 namespace artery
 {
@@ -94,6 +95,21 @@ TtcCondition::Route TtcCondition::calculateRoute(const Vehicle& car, int steps,
     return shapes;
 }
 
+auto TtcCondition::getRoute(const Vehicle& car, int steps, double dt) -> std::shared_ptr<const Route>
+{
+    // vehicles move only between time steps, routes are shared by all pairings of a step
+    if (mRouteCacheTime != omnetpp::simTime()) {
+        mRouteCache.clear();
+        mRouteCacheTime = omnetpp::simTime();
+    }
+
+    auto& route = mRouteCache[std::make_tuple(&car, steps, dt)];
+    if (!route) {
+        route = std::make_shared<const Route>(calculateRoute(car, steps, dt));
+    }
+    return route;
+}
+
 double TtcCondition::calculateTimeDelta(const Vehicle& car1, const Vehicle& car2) const
 {
     auto& vdp1 = car1.get<VehicleDataProvider>();
@@ -118,35 +134,35 @@ bool TtcCondition::calculateIntersect(const CarShape& shape1, const CarShape& sh
 
 bool TtcCondition::intersect(const Vehicle& car1, const Vehicle& car2)
 {
-    bool no_intersection = true;
-    if (boost::geometry::distance(car1.getController().getPosition(), car2.getController().getPosition()) <= m_ttcDistanceThreshold) {
-        const double dt = calculateTimeDelta(car1, car2);
-        int steps = ceil(m_ttc / dt);
-
-        mEgoRoute = calculateRoute(car1, steps, dt);
-        mOthersRoute.push_back(calculateRoute(car2, steps, dt));
-
-        no_intersection = boost::range::equal(mEgoRoute, mOthersRoute.back(),
-                [this](CarShape s1, CarShape s2) {
-                    return !calculateIntersect(s1, s2);
-                }
-        );
-    }
+    const double dt = calculateTimeDelta(car1, car2);
+    int steps = ceil(m_ttc / dt);
+
+    mEgoRoute = getRoute(car1, steps, dt);
+    mOthersRoute.push_back(getRoute(car2, steps, dt));
+
+    const bool no_intersection = boost::range::equal(*mEgoRoute, *mOthersRoute.back(),
+            [this](const CarShape& s1, const CarShape& s2) {
+                return !calculateIntersect(s1, s2);
+            }
+    );
     return !no_intersection;
 }
 
 ConditionResult TtcCondition::testCondition(const Vehicle& car)
 {
-    mEgoRoute.clear();
+    mEgoRoute.reset();
     mOthersRoute.clear();
-    std::set<const Vehicle*> affected;
-    for (auto& testCar : car.getVehicles()) {
-        if (testCar.first != car.getId()) {
-            if (intersect(car, testCar.second)) {
-                affected.insert(&testCar.second);
+    VehicleSet affected;
+    // only cars within distance threshold are tested for collisions
+    const auto& position = car.getController().getPosition();
+    for (const Vehicle* testCar : car.getPositionIndex().queryNearby(position, m_ttcDistanceThreshold)) {
+        if (testCar != &car) {
+            if (intersect(car, *testCar)) {
+                affected.push_back(testCar);
             }
         }
     }
+    normalize(affected);
     return affected;
 }
 
@@ -158,9 +174,11 @@ void TtcCondition::drawCondition(omnetpp::cCanvas* canvas)
     }
     mFigures.clear();
 
-    drawPath(mEgoRoute, canvas);
+    if(mEgoRoute) {
+        drawPath(*mEgoRoute, canvas);
+    }
     for(auto& p : mOthersRoute) {
-        drawPath(p, canvas);
+        drawPath(*p, canvas);
     }
 }
 
@@ -5,6 +5,10 @@
 #include "artery/storyboard/Condition.h"
 #include "artery/utility/Geometry.h"
 #include <omnetpp/ccanvas.h>
+#include <omnetpp/simtime.h>
+#include <map>
+#include <memory>
+#include <tuple>
 #include <vector>
 
 namespace artery
@@ -48,6 +52,10 @@ public:
 
     ConditionResult testCondition(const Vehicle& car);
 
+    // predicts and intersects routes of nearby vehicles, drawn routes are not considered state
+    double getCost() const override { return 1000.0; }
+    bool isStateless() const override { return true; }
+
 private:
     /**
      * Calculates the shape of a car
@@ -70,6 +78,13 @@ private:
      */
     Route STORYBOARD_LOCAL calculateRoute(const Vehicle&, int steps, double dt) const;
 
+    /**
+     * Get predicted route of a car, calculated at most once per simulation time step
+     *
+     * \see calculateRoute
+     */
+    std::shared_ptr<const Route> STORYBOARD_LOCAL getRoute(const Vehicle&, int steps, double dt);
+
     /**
      * Calculates the Time between two car shapes
      *
@@ -102,8 +117,10 @@ private:
 
     double m_ttc;
     double m_ttcDistanceThreshold;
-    Route mEgoRoute;
-    std::vector<Route> mOthersRoute;
+    std::shared_ptr<const Route> mEgoRoute;
+    std::vector<std::shared_ptr<const Route>> mOthersRoute;
+    std::map<std::tuple<const Vehicle*, int, double>, std::shared_ptr<const Route>> mRouteCache;
+    omnetpp::SimTime mRouteCacheTime;
     std::list<omnetpp::cFigure*> mFigures;
 };
 
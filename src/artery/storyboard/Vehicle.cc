@@ -9,8 +9,9 @@ namespace artery
 
 static const simsignal_t signalStoryboard = cComponent::registerSignal("StoryboardSignal");
 
-Vehicle::Vehicle(artery::Middleware& mw, std::map<std::string, Vehicle>& vs) :
-    mMiddleware(mw), mVehicles(vs)
+Vehicle::Vehicle(artery::Middleware& mw, std::map<std::string, Vehicle>& vs, const VehiclePositionIndex& index) :
+    mMiddleware(mw), mController(&mw.getFacilities().get_mutable<traci::VehicleController>()),
+    mVehicles(vs), mPositionIndex(index)
 {
 }
 
@@ -21,12 +22,12 @@ const std::string& Vehicle::getId() const
 
 traci::VehicleController& Vehicle::getController()
 {
-    return mMiddleware.getFacilities().get_mutable<traci::VehicleController>();
+    return *mController;
 }
 
 const traci::VehicleController& Vehicle::getController() const
 {
-    return mMiddleware.getFacilities().get_const<traci::VehicleController>();
+    return *mController;
 }
 
 const std::map<std::string, Vehicle>& Vehicle::getVehicles() const
@@ -34,6 +35,11 @@ const std::map<std::string, Vehicle>& Vehicle::getVehicles() const
     return mVehicles;
 }
 
+const VehiclePositionIndex& Vehicle::getPositionIndex() const
+{
+    return mPositionIndex;
+}
+
 void Vehicle::emit(const StoryboardSignal& signal) const
 {
     const omnetpp::cObject* obj = &signal;
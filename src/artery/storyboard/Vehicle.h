@@ -3,6 +3,7 @@
 
 #include "artery/application/Middleware.h"
 #include "artery/storyboard/Macros.h"
+#include "artery/storyboard/VehiclePositionIndex.h"
 #include "artery/traci/VehicleController.h"
 #include "artery/application/VehicleDataProvider.h"
 #include <map>
@@ -20,7 +21,7 @@ class VehicleDataProvider;
 class STORYBOARD_API Vehicle
 {
 public:
-    Vehicle(artery::Middleware&, std::map<std::string, Vehicle>&);
+    Vehicle(artery::Middleware&, std::map<std::string, Vehicle>&, const VehiclePositionIndex&);
 
     const std::string& getId() const;
 
@@ -29,6 +30,11 @@ public:
 
     const std::map<std::string, Vehicle>& getVehicles() const;
 
+    /**
+     * Get spatial index of all vehicles, updated before stories are tested
+     */
+    const VehiclePositionIndex& getPositionIndex() const;
+
     void emit(const StoryboardSignal&) const;
 
     template<typename T>
@@ -39,7 +45,9 @@ public:
 
 private:
     artery::Middleware& mMiddleware;
+    traci::VehicleController* mController; /*< looked up once, owned by middleware's facilities */
     std::map<std::string, Vehicle>& mVehicles;
+    const VehiclePositionIndex& mPositionIndex;
 };
 
 } // namespace artery
@@ -0,0 +1,74 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/storyboard/VehiclePositionIndex.h"
+#include "artery/storyboard/Vehicle.h"
+#include <algorithm>
+#include <iterator>
+
+namespace artery
+{
+
+namespace bgi = boost::geometry::index;
+
+void VehiclePositionIndex::update(std::map<std::string, Vehicle>& vehicles)
+{
+    std::vector<Value> values;
+    values.reserve(vehicles.size());
+    mVehicles.clear();
+    mVehicles.reserve(vehicles.size());
+    for (auto& vehicle : vehicles) {
+        const Position& pos = vehicle.second.getController().getPosition();
+        values.emplace_back(geometry::Point { pos.x.value(), pos.y.value() }, mVehicles.size());
+        mVehicles.push_back(&vehicle.second);
+    }
+
+    // bulk loading yields a better packed tree than repeated insertions
+    decltype(mRtree) rtree { values.begin(), values.end() };
+    mRtree = std::move(rtree);
+}
+
+void VehiclePositionIndex::clear()
+{
+    mRtree.clear();
+    mVehicles.clear();
+}
+
+std::vector<Vehicle*> VehiclePositionIndex::query(const geometry::Box& box) const
+{
+    std::vector<Value> found;
+    mRtree.query(bgi::intersects(box), std::back_inserter(found));
+    return sort(found);
+}
+
+std::vector<Vehicle*> VehiclePositionIndex::queryNearby(const Position& center, double distance) const
+{
+    const geometry::Point point { center.x.value(), center.y.value() };
+    const geometry::Box box {
+        geometry::Point { point.get<0>() - distance, point.get<1>() - distance },
+        geometry::Point { point.get<0>() + distance, point.get<1>() + distance }
+    };
+
+    std::vector<Value> found;
+    mRtree.query(bgi::intersects(box) && bgi::satisfies([&point, distance](const Value& value) {
+                return boost::geometry::distance(point, value.first) <= distance;
+            }), std::back_inserter(found));
+    return sort(found);
+}
+
+std::vector<Vehicle*> VehiclePositionIndex::sort(std::vector<Value>& values) const
+{
+    std::sort(values.begin(), values.end(),
+        [](const Value& a, const Value& b) { return a.second < b.second; });
+
+    std::vector<Vehicle*> vehicles;
+    vehicles.reserve(values.size());
+    for (const Value& value : values) {
+        vehicles.push_back(mVehicles[value.second]);
+    }
+    return vehicles;
+}
+
+} // namespace artery
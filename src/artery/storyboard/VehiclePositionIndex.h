@@ -0,0 +1,66 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_VEHICLEPOSITIONINDEX_H_T8KD3WZN
+#define ARTERY_VEHICLEPOSITIONINDEX_H_T8KD3WZN
+
+#include "artery/storyboard/Macros.h"
+#include "artery/utility/Geometry.h"
+#include <boost/geometry/index/rtree.hpp>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace artery
+{
+
+class Vehicle;
+
+/**
+ * VehiclePositionIndex keeps the storyboard's vehicles in a spatial index.
+ *
+ * It is rebuilt once per TraCI step by the storyboard and shared by all conditions.
+ * Query results are ordered by vehicle identifiers like the storyboard's vehicle map.
+ */
+class STORYBOARD_API VehiclePositionIndex
+{
+public:
+    /**
+     * Rebuild index from vehicles' current positions
+     * \param vehicles all vehicles of storyboard
+     */
+    void update(std::map<std::string, Vehicle>& vehicles);
+
+    /**
+     * Forget all indexed vehicles, e.g. when a vehicle is removed
+     */
+    void clear();
+
+    /**
+     * Get vehicles whose positions are within a box
+     */
+    std::vector<Vehicle*> query(const geometry::Box&) const;
+
+    /**
+     * Get vehicles within a distance around a position
+     * \param center position
+     * \param distance maximum distance to center in meters
+     */
+    std::vector<Vehicle*> queryNearby(const Position& center, double distance) const;
+
+private:
+    using Value = std::pair<geometry::Point, std::size_t>;
+
+    std::vector<Vehicle*> sort(std::vector<Value>&) const;
+
+    boost::geometry::index::rtree<Value, boost::geometry::index::quadratic<16>> mRtree;
+    std::vector<Vehicle*> mVehicles; /*< ordered by identifiers, indexed by rtree values */
+};
+
+} // namespace artery
+
+#endif /* ARTERY_VEHICLEPOSITIONINDEX_H_T8KD3WZN */
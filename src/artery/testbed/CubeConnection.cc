@@ -1,5 +1,6 @@
 #include "artery/testbed/CubeConnection.h"
 #include "nfiniity_cube_radio.pb.h"
+#include <boost/asio/post.hpp>
 #include <omnetpp/clog.h>
 #include <vanetza/access/ethertype.hpp>
 
@@ -16,13 +17,14 @@ CubeConnection::CubeConnection(const boost::asio::ip::address& addr, int rxPort,
     mTxSocket(mIoContext),
     mRxSocket(mIoContext, mRxEndpoint) /*< opens and binds to given endpoint */
 {
-    mTxSocket.async_connect(mTxEndpoint, [](const boost::system::error_code& ec) {
+    mTxSocket.async_connect(mTxEndpoint, [this](const boost::system::error_code& ec) {
         if (ec) {
-            EV_ERROR << "Failed to establish CubeConnection: " << ec.message() << std::endl;
+            report(Severity::Error, "Failed to establish CubeConnection: " + ec.message());
         } else {
-            EV_INFO << "CubeConnection established" << std::endl;
+            report(Severity::Info, "CubeConnection established");
         }
     });
+    receivePacket();
 
     mIoThread = std::thread([this]() {
         mIoContext.run();
@@ -33,6 +35,30 @@ CubeConnection::~CubeConnection()
 {
     mIoContext.stop();
     mIoThread.join();
+    logReports();
+}
+
+void CubeConnection::report(Severity severity, std::string text)
+{
+    std::lock_guard<std::mutex> lock(mReportsMutex);
+    mReports.emplace_back(severity, std::move(text));
+}
+
+void CubeConnection::logReports()
+{
+    std::vector<std::pair<Severity, std::string>> reports;
+    {
+        std::lock_guard<std::mutex> lock(mReportsMutex);
+        std::swap(reports, mReports);
+    }
+
+    for (const auto& entry : reports) {
+        if (entry.first == Severity::Error) {
+            EV_ERROR << entry.second << std::endl;
+        } else {
+            EV_INFO << entry.second << std::endl;
+        }
+    }
 }
 
 void CubeConnection::receivePacket()
@@ -54,15 +80,13 @@ void CubeConnection::receivePacket()
 
                 vanetza::ByteBuffer buffer { rx.payload().begin(), rx.payload().end() };
                 auto payload = std::make_unique<vanetza::CohesivePacket>(std::move(buffer), vanetza::OsiLayer::Network);
-
-                EV_INFO << "received packet over CubeConnection" << std::endl;
                 mReceivePacketHandler(request, std::move(payload));
             }
 
             // receive next packet
             receivePacket();
         } else {
-            EV_ERROR << "receiving packet over CubeConnection failed: " << ec.message() << std::endl;
+            report(Severity::Error, "receiving packet over CubeConnection failed: " + ec.message());
         }
     };
 
@@ -71,6 +95,8 @@ void CubeConnection::receivePacket()
 
 void CubeConnection::sendPacket(const vanetza::MacAddress& source, const vanetza::MacAddress& destination, const vanetza::byte_view_range& data)
 {
+    logReports();
+
     CommandRequest command;
     LinkLayerTransmission* tx = command.mutable_linklayer_tx();
     tx->set_source(source.octets.data(), source.octets.size());
@@ -78,12 +104,27 @@ void CubeConnection::sendPacket(const vanetza::MacAddress& source, const vanetza
     tx->set_priority(LinkLayerPriority::BEST_EFFORT);
     tx->set_payload(data.data(), data.size());
     
+    // serialise on simulation thread, but socket is operated by IO thread only
     auto buffer = std::make_shared<std::string>(command.SerializeAsString());
-    mTxSocket.async_send(boost::asio::buffer(*buffer), [buffer](const boost::system::error_code& ec, std::size_t) {
+    boost::asio::post(mIoContext, [this, buffer]() {
+        mTxQueue.emplace_back(std::move(*buffer));
+        if (mTxQueue.size() == 1) {
+            transmitPacket();
+        }
+    });
+}
+
+void CubeConnection::transmitPacket()
+{
+    // queued datagrams are sent back to back by IO thread
+    mTxSocket.async_send(boost::asio::buffer(mTxQueue.front()), [this](const boost::system::error_code& ec, std::size_t) {
         if (ec) {
-            EV_ERROR << "sending packet over CubeConnection failed: " << ec.message() << std::endl;;
-        } else {
-            EV_INFO << "sent packet over CubeConnection" << std::endl;
+            report(Severity::Error, "sending packet over CubeConnection failed: " + ec.message());
+        }
+
+        mTxQueue.pop_front();
+        if (!mTxQueue.empty()) {
+            transmitPacket();
         }
     });
 }
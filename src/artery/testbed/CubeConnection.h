@@ -15,8 +15,13 @@
 #include <vanetza/net/cohesive_packet.hpp>
 #include <vanetza/net/mac_address.hpp>
 #include <array>
+#include <deque>
 #include <functional>
+#include <mutex>
+#include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 
 namespace artery
 {
@@ -48,8 +53,20 @@ public:
      */
     void sendPacket(const vanetza::MacAddress& source, const vanetza::MacAddress& destination, const vanetza::byte_view_range& data);
 
+    /**
+     * \brief Log reports of the IO thread, e.g. failed transmissions
+     *
+     * OMNeT++ logging is not thread-safe, thus reports are queued by the IO thread
+     * and logged by the simulation thread calling this method.
+     */
+    void logReports();
+
 private:
+    enum class Severity { Info, Error };
+
     void receivePacket();
+    void transmitPacket();
+    void report(Severity, std::string);
 
     ReceivePacketHandler mReceivePacketHandler;
     std::thread mIoThread;
@@ -60,6 +77,9 @@ private:
     boost::asio::ip::udp::socket mTxSocket;
     boost::asio::ip::udp::socket mRxSocket;
     std::array<uint8_t, 4096> mRxBuffer;
+    std::deque<std::string> mTxQueue; /*< serialised commands, only accessed by IO thread */
+    std::mutex mReportsMutex;
+    std::vector<std::pair<Severity, std::string>> mReports; /*< reports of IO thread pending for logging */
 };
 
 } // namespace artery
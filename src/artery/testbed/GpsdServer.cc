@@ -1,6 +1,7 @@
 #include "artery/testbed/GpsdServer.h"
 #include "artery/testbed/OtaInterfaceLayer.h"
 #include "artery/traci/Cast.h"
+#include <omnetpp/clog.h>
 #include <vanetza/gnss/nmea.hpp>
 #include <vanetza/gnss/wgs84point.hpp>
 
@@ -21,30 +22,45 @@ GpsdServer::~GpsdServer()
 
 void GpsdServer::sendPositionFix(OtaInterfaceLayer& ota)
 {
+    if (!mConnected) {
+        return;
+    } else if (!flush()) {
+        // gpsd is lagging behind, its next fix will be more recent anyway
+        return;
+    }
+
     auto pos = ota.getCurrentPosition();
     vanetza::Wgs84Point point(pos.latitude, pos.longitude);
     auto velocity = ota.getCurrentSpeed();
     auto angle = traci::angle_cast(ota.getCurrentHeading());
     auto time = vanetza::Clock::at(mTimer.getCurrentTime());
 
-    std::string gprmcSentence = vanetza::nmea::gprmc(time, point, vanetza::units::NauticalVelocity(velocity),
-            vanetza::units::TrueNorth(angle.degree * vanetza::units::true_north_degrees));
-    gprmcSentence.append("\r\n");
-    write(gprmcSentence);
-
-    std::string gpgaaSentence = gpgga(time, point, vanetza::nmea::Quality::Simulation,
-            vanetza::units::Length(1.0 * boost::units::si::meters));
-    gpgaaSentence.append("\r\n");
-    write(gpgaaSentence);
+    mBuffer.clear();
+    mBufferOffset = 0;
+    mBuffer.append(vanetza::nmea::gprmc(time, point, vanetza::units::NauticalVelocity(velocity),
+            vanetza::units::TrueNorth(angle.degree * vanetza::units::true_north_degrees)));
+    mBuffer.append("\r\n");
+    mBuffer.append(gpgga(time, point, vanetza::nmea::Quality::Simulation,
+            vanetza::units::Length(1.0 * boost::units::si::meters)));
+    mBuffer.append("\r\n");
+    flush();
 }
 
-void GpsdServer::write(const std::string& sentence)
+bool GpsdServer::flush()
 {
+    // remainder of a partially written fix is completed first, gpsd expects whole sentences
     boost::system::error_code ec;
-    boost::asio::write(mSocket, boost::asio::buffer(sentence), boost::asio::transfer_all(), ec);
-    if (ec) {
-        throw omnetpp::cRuntimeError("unable to write on gpsd socket");
+    while (mBufferOffset < mBuffer.size()) {
+        mBufferOffset += mSocket.write_some(boost::asio::buffer(mBuffer.data() + mBufferOffset, mBuffer.size() - mBufferOffset), ec);
+        if (ec == boost::asio::error::would_block) {
+            return false;
+        } else if (ec) {
+            EV_ERROR << "writing on gpsd socket failed, no further position fixes are sent: " << ec.message() << "\n";
+            mConnected = false;
+            return false;
+        }
     }
+    return true;
 }
 
 void GpsdServer::waitForListener(unsigned short port)
@@ -53,6 +69,8 @@ void GpsdServer::waitForListener(unsigned short port)
     tcp::acceptor acceptor(mIoContext, tcp::endpoint(tcp::v4(), port));
     std::cout << "wait for gpsd" << std::endl;
     acceptor.accept(mSocket);
+    mSocket.non_blocking(true);
+    mConnected = true;
     std::cout << "gpsd connected" << std::endl;
 }
 
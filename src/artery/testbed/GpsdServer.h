@@ -20,15 +20,24 @@ public:
      */
     GpsdServer(const std::string& timebase, unsigned short port);
     ~GpsdServer();
+
+    /**
+     * Send GPRMC and GPGGA sentences of current position without blocking
+     *
+     * A fix is dropped if gpsd has not yet consumed the previous one completely.
+     */
     void sendPositionFix(OtaInterfaceLayer&);
 
 private:
-    void write(const std::string& sentence);
+    bool flush();
     void waitForListener(unsigned short port);
 
     boost::asio::io_context mIoContext;
     boost::asio::ip::tcp::socket mSocket;
     Timer mTimer;
+    std::string mBuffer; /*< sentences of latest fix, reused */
+    std::size_t mBufferOffset = 0; /*< bytes of mBuffer already written */
+    bool mConnected = false;
 };
 
 } // namespace artery
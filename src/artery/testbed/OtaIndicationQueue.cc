@@ -1,47 +1,88 @@
 #include "artery/testbed/OtaIndicationQueue.h"
 #include "artery/testbed/OtaInterface.h"
+#include <omnetpp/clog.h>
 
 namespace artery
 {
 
+constexpr std::size_t OtaIndicationQueue::capacity;
+
 OtaIndicationQueue::OtaIndicationQueue(OtaInterface* interface) :
-    mOtaInterface(interface), mNotified(false)
+    mHead(0), mTail(0), mWaiting(false), mDropped(0), mOtaInterface(interface)
 {
 }
 
+OtaIndicationQueue::~OtaIndicationQueue()
+{
+    // slots still holding undelivered indications delete them
+}
+
 void OtaIndicationQueue::waitFor(std::chrono::microseconds waitFor)
 {
-    std::unique_lock<std::mutex> lock(mMutex);
-    if (mCondVar.wait_for(lock, waitFor, [this]{ return mNotified; })) {
-        // create sending event only if the physical twin has already been created
-        if (mOtaInterface->hasRegisteredModule()) {
-            for (auto& ind : mIndicationList) {
-                mOtaInterface->receiveMessage(std::move(ind));
-            }
+    if (empty()) {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mWaiting.store(true);
+        const bool notified = mCondVar.wait_for(lock, waitFor, [this]{ return !empty(); });
+        mWaiting.store(false);
+        if (!notified) {
+            return;
         }
-        mIndicationList.clear();
-        mNotified = false;
     }
+
+    deliver();
 }
 
 void OtaIndicationQueue::trigger(std::unique_ptr<GeoNetPacket> ind)
 {
-    std::lock_guard<std::mutex> lock(mMutex);
-    mIndicationList.emplace_back(std::move(ind));
-    mNotified = true;
-    mCondVar.notify_one();
+    const std::size_t tail = mTail.load(std::memory_order_relaxed);
+    if (tail - mHead.load(std::memory_order_acquire) >= capacity) {
+        // never block the receiving thread, simulation is too far behind anyway
+        // (dropped indication is deleted on return)
+        mDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    mRing[tail % capacity] = std::move(ind);
+    // sequentially consistent store and load pair with waitFor, no wake-up can get lost
+    mTail.store(tail + 1);
+    if (mWaiting.load()) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mCondVar.notify_one();
+    }
 }
 
 void OtaIndicationQueue::flushQueue()
 {
-    std::lock_guard<std::mutex> lock(mMutex);
+    deliver();
+}
+
+bool OtaIndicationQueue::empty() const
+{
+    return mHead.load(std::memory_order_relaxed) == mTail.load();
+}
+
+void OtaIndicationQueue::deliver()
+{
+    const std::size_t tail = mTail.load(std::memory_order_acquire);
+    std::size_t head = mHead.load(std::memory_order_relaxed);
+    for (; head != tail; ++head) {
+        // take ownership, slot is empty afterwards
+        mIndicationList.emplace_back(std::move(mRing[head % capacity]));
+    }
+    mHead.store(head, std::memory_order_release);
+
+    const std::size_t dropped = mDropped.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        EV_WARN << "OtaIndicationQueue was full, dropped " << dropped << " indications\n";
+    }
+
+    // create sending event only if the physical twin has already been created
     if (mOtaInterface->hasRegisteredModule()) {
         for (auto& ind : mIndicationList) {
             mOtaInterface->receiveMessage(std::move(ind));
         }
     }
     mIndicationList.clear();
-    mNotified = false;
 }
 
 } // namespace artery
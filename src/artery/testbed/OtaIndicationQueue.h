@@ -8,8 +8,12 @@
 #define ARTERY_OTA_INDICATION_QUEUE_H
 
 #include "artery/networking/GeoNetPacket.h"
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -20,11 +24,19 @@ class OtaInterface;
 
 /**
  * The OtaIndicationQueue can be used to dispatch messages between an OtaInterface and an OMNeT++ scheduler
+ *
+ * Indications are passed by a bounded lock-free ring from a single receiving thread to the scheduler.
+ * The mutex is only taken for waking up a waiting scheduler, indications are delivered outside of it.
+ * Queued indications are owned by their ring slots, the scheduler takes them over when draining the ring.
+ * Indications the receiving thread drops because of a full ring are deleted right away.
  */
 class OtaIndicationQueue
 {
 public:
+    static constexpr std::size_t capacity = 1024; /*< queued indications at most, power of two */
+
     OtaIndicationQueue(OtaInterface* interface);
+    virtual ~OtaIndicationQueue();
 
     /**
      * Called by the scheduler to wait for the next event
@@ -33,6 +45,7 @@ public:
 
     /**
      * Called by the OtaInterface when a new GeoNetPacket must be scheduled by OMNeT++
+     * \note only one thread may call this at a time, GeoNetPacket is dropped if the queue is full
      * \param GeoNetPacket to send
      */
     virtual void trigger(std::unique_ptr<GeoNetPacket>);
@@ -43,11 +56,20 @@ public:
     virtual void flushQueue();
 
 private:
+    static_assert((capacity & (capacity - 1)) == 0, "capacity has to be a power of two");
+
+    bool empty() const;
+    void deliver();
+
+    std::array<std::unique_ptr<GeoNetPacket>, capacity> mRing;
+    std::atomic<std::size_t> mHead; /*< next slot read by scheduler */
+    std::atomic<std::size_t> mTail; /*< next slot written by receiving thread */
+    std::atomic<bool> mWaiting;
+    std::atomic<std::size_t> mDropped;
     std::condition_variable mCondVar;
-    std::vector<std::unique_ptr<GeoNetPacket>> mIndicationList;
     std::mutex mMutex;
+    std::vector<std::unique_ptr<GeoNetPacket>> mIndicationList; /*< drained indications, reused */
     OtaInterface* mOtaInterface;
-    bool mNotified;
 };
 
 } // namespace artery
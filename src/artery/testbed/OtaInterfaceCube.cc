@@ -69,11 +69,16 @@ void OtaInterfaceCube::sendMessage(const vanetza::MacAddress& source, const vane
 
 void OtaInterfaceCube::finish()
 {
+    // remaining reports are logged when connection is destructed
     mCubeConnection.reset();
 }
 
 void OtaInterfaceCube::receiveMessage(std::unique_ptr<GeoNetPacket> geonetPacket)
 {
+    if (mCubeConnection) {
+        mCubeConnection->logReports();
+    }
+
     if (hasRegisteredModule()) {
         ++mPacketsInjected;
         mRegisteredModule->request(std::move(geonetPacket));
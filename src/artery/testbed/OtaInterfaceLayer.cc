@@ -1,4 +1,3 @@
-#include "artery/networking/GeoNetIndication.h"
 #include "artery/networking/GeoNetPacket.h"
 #include "artery/nic/RadioDriverBase.h"
 #include "artery/testbed/OtaInterfaceLayer.h"
@@ -43,12 +42,9 @@ void OtaInterfaceLayer::handleMessage(omnetpp::cMessage* message)
 {
     if (message->getArrivalGate() == mRadioDriverIn) {
         auto packet = check_and_cast<GeoNetPacket*>(message);
-        auto info = check_and_cast<GeoNetIndication*>(message->removeControlInfo());
-        if (info) {
-            using namespace vanetza;
-            auto range = create_byte_view(packet->getPayload(), OsiLayer::Network, OsiLayer::Application);
-            mOtaModule->sendMessage(info->source, info->destination, range);
-        }
+        using namespace vanetza;
+        auto range = create_byte_view(packet->getPayload(), OsiLayer::Network, OsiLayer::Application);
+        mOtaModule->sendMessage(packet->getSourceAddress(), packet->getDestinationAddress(), range);
     }
 
     delete message;
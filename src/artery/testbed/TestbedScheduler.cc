@@ -3,7 +3,10 @@
 #include <omnetpp/cconfigoption.h>
 #include <omnetpp/cconfiguration.h>
 #include <omnetpp/cfutureeventset.h>
+#include <omnetpp/cmodule.h>
+#include <omnetpp/csimulation.h>
 #include <omnetpp/regmacros.h>
+#include <algorithm>
 
 namespace artery
 {
@@ -13,6 +16,10 @@ Register_GlobalConfigOption(CFG_SIMULATION_TOO_SLOW, "simulation-too-slow", CFG_
         "Threshold for a simulation to lag behind wall-clock (milliseconds).")
 Register_GlobalConfigOption(CFG_STARTUP_TIME, "simulation-startup-time", CFG_DOUBLE, "4",
         "Time span at the beginning of a simulation in which simulation-too-slow is not checked (seconds).")
+Register_GlobalConfigOption(CFG_SIMULATION_CATCH_UP, "simulation-catch-up", CFG_INT, "0",
+        "Lag behind wall-clock (milliseconds) from which modules are asked to catch up, 0 disables catch-up signalling.")
+
+const omnetpp::simsignal_t TestbedScheduler::catchUpSignal = omnetpp::cComponent::registerSignal("testbed.catchUp");
 
 
 void TestbedScheduler::startRun()
@@ -20,9 +27,27 @@ void TestbedScheduler::startRun()
     omnetpp::cConfiguration *config = omnetpp::getEnvir()->getConfig();
     mThresholdTooSlow = std::chrono::milliseconds(config->getAsInt(CFG_SIMULATION_TOO_SLOW));
     mStartupTime = config->getAsDouble(CFG_STARTUP_TIME);
+    mThresholdCatchUp = std::chrono::milliseconds(config->getAsInt(CFG_SIMULATION_CATCH_UP));
+    mCatchingUp = false;
+    mLag = LogLinearHistogram();
     mBaseTime = std::chrono::system_clock::now();
 }
 
+void TestbedScheduler::endRun()
+{
+    // scheduler is no component, thus statistics are attached to the network
+    omnetpp::cModule* network = sim->getSystemModule();
+    if (network && mLag.count() > 0) {
+        network->recordScalar("testbedLagCount", mLag.count());
+        network->recordScalar("testbedLagMean", mLag.mean() * 1e-6, "s");
+        network->recordScalar("testbedLagP50", mLag.percentile(50.0) * 1e-6, "s");
+        network->recordScalar("testbedLagP90", mLag.percentile(90.0) * 1e-6, "s");
+        network->recordScalar("testbedLagP99", mLag.percentile(99.0) * 1e-6, "s");
+        network->recordScalar("testbedLagP999", mLag.percentile(99.9) * 1e-6, "s");
+        network->recordScalar("testbedLagMax", mLag.max() * 1e-6, "s");
+    }
+}
+
 void TestbedScheduler::executionResumed()
 {
     using namespace std::chrono;
@@ -64,6 +89,9 @@ void TestbedScheduler::doTiming(omnetpp::cEvent* event)
     using namespace std::chrono;
     auto arrival = mBaseTime + microseconds(event->getArrivalTime().inUnit(omnetpp::SIMTIME_US));
     auto waitFor = arrival - system_clock::now();
+    const auto lag = std::max(-waitFor, system_clock::duration::zero());
+    mLag.record(duration_cast<microseconds>(lag).count());
+    updateCatchUp(lag);
 
     if (mOtaIndicationQueue && waitFor >= system_clock::duration::zero()) {
         mOtaIndicationQueue->flushQueue();
@@ -78,6 +106,22 @@ void TestbedScheduler::doTiming(omnetpp::cEvent* event)
     }
 }
 
+void TestbedScheduler::updateCatchUp(std::chrono::system_clock::duration lag)
+{
+    if (mThresholdCatchUp <= std::chrono::system_clock::duration::zero()) {
+        return;
+    }
+
+    // hysteresis avoids toggling at every event around the threshold
+    const bool catchingUp = mCatchingUp ? lag > mThresholdCatchUp / 2 : lag > mThresholdCatchUp;
+    if (catchingUp != mCatchingUp) {
+        mCatchingUp = catchingUp;
+        if (omnetpp::cModule* network = sim->getSystemModule()) {
+            network->emit(catchUpSignal, mCatchingUp);
+        }
+    }
+}
+
 omnetpp::cEvent* TestbedScheduler::peekFirstNonStaleEvent()
 {
     omnetpp::cEvent* event = nullptr;
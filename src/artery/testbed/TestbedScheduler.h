@@ -7,6 +7,8 @@
 #ifndef ARTERY_TESTBEDSCHEDULER_H_NJ0QMNVB
 #define ARTERY_TESTBEDSCHEDULER_H_NJ0QMNVB
 
+#include "artery/utility/LogLinearHistogram.h"
+#include <omnetpp/clistener.h>
 #include <omnetpp/cscheduler.h>
 #include <omnetpp/simtime.h>
 #include <chrono>
@@ -20,7 +22,13 @@ class OtaIndicationQueue;
 class TestbedScheduler : public omnetpp::cScheduler
 {
 public:
+    /**
+     * Emitted by system module when simulation falls behind or catches up with real time (bool)
+     */
+    static const omnetpp::simsignal_t catchUpSignal;
+
     void startRun() override;
+    void endRun() override;
     void executionResumed() override;
     omnetpp::cEvent* takeNextEvent() override;
     omnetpp::cEvent* guessNextEvent() override;
@@ -28,8 +36,14 @@ public:
 
     virtual void setOtaIndicationQueue(std::shared_ptr<OtaIndicationQueue>);
 
+    /**
+     * Check if simulation lags behind real time by more than simulation-catch-up
+     */
+    bool isCatchingUp() const { return mCatchingUp; }
+
 protected:
     virtual void doTiming(omnetpp::cEvent*);
+    virtual void updateCatchUp(std::chrono::system_clock::duration lag);
     omnetpp::cEvent* peekFirstNonStaleEvent();
 
 private:
@@ -37,6 +51,9 @@ private:
     std::chrono::system_clock::time_point mBaseTime;
     std::chrono::system_clock::duration mThresholdTooSlow;
     omnetpp::simtime_t mStartupTime;
+    std::chrono::system_clock::duration mThresholdCatchUp;
+    bool mCatchingUp = false;
+    LogLinearHistogram mLag; /*< lag of events behind real time in microseconds */
 };
 
 } // namespace artery
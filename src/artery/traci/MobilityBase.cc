@@ -1,4 +1,7 @@
 #include "artery/traci/MobilityBase.h"
+#include <omnetpp/cexception.h>
+#include <omnetpp/csimulation.h>
+#include <cmath>
 
 using namespace traci;
 
@@ -7,4 +10,80 @@ namespace artery
 
 omnetpp::simsignal_t MobilityBase::stateChangedSignal = omnetpp::cComponent::registerSignal("mobilityStateChanged");
 
+MobilityBase::Extrapolation MobilityBase::parseExtrapolation(const std::string& model)
+{
+    if (model == "none") {
+        return Extrapolation::None;
+    } else if (model == "constantVelocity") {
+        return Extrapolation::ConstantVelocity;
+    } else if (model == "constantAcceleration") {
+        return Extrapolation::ConstantAcceleration;
+    } else if (model == "constantTurnRate") {
+        return Extrapolation::ConstantTurnRate;
+    } else {
+        throw omnetpp::cRuntimeError("unknown mobility extrapolation \"%s\"", model.c_str());
+    }
+}
+
+void MobilityBase::resetKinematics(const Position& pos, Angle heading, double speed)
+{
+    mKinematics = Kinematics {};
+    mKinematics.position = pos;
+    mKinematics.heading = heading;
+    mKinematics.speed = speed;
+    mKinematicsTime = omnetpp::simTime();
+}
+
+void MobilityBase::recordKinematics(const Position& pos, Angle heading, double speed)
+{
+    const double dt = (omnetpp::simTime() - mKinematicsTime).dbl();
+    if (dt > 0.0) {
+        mKinematics.acceleration = (speed - mKinematics.speed) / dt;
+        mKinematics.turnRate = std::remainder(heading.radian() - mKinematics.heading.radian(), 2.0 * M_PI) / dt;
+    }
+    mKinematics.position = pos;
+    mKinematics.heading = heading;
+    mKinematics.speed = speed;
+    mKinematicsTime = omnetpp::simTime();
+}
+
+MobilityBase::Kinematics MobilityBase::extrapolateKinematics(omnetpp::SimTime time) const
+{
+    double dt = (time - mKinematicsTime).dbl();
+    if (mExtrapolation == Extrapolation::None || dt <= 0.0) {
+        return mKinematics;
+    }
+
+    using boost::units::si::meter;
+    const double a = mExtrapolation == Extrapolation::ConstantVelocity ? 0.0 : mKinematics.acceleration;
+    const double w = mExtrapolation == Extrapolation::ConstantTurnRate ? mKinematics.turnRate : 0.0;
+    const double v0 = mKinematics.speed;
+    if (a < 0.0 && v0 + a * dt < 0.0) {
+        // decelerating vehicles stop instead of driving backwards
+        dt = -v0 / a;
+    }
+
+    const double h0 = mKinematics.heading.radian();
+    const double v1 = v0 + a * dt;
+    const double h1 = h0 + w * dt;
+    double dx = 0.0;
+    double dy = 0.0;
+    if (std::abs(w) < 1e-6) {
+        const double distance = v0 * dt + 0.5 * a * dt * dt;
+        dx = distance * std::cos(h0);
+        dy = distance * std::sin(h0);
+    } else {
+        // closed-form integration of constant turn rate and acceleration
+        dx = (v1 * w * std::sin(h1) + a * std::cos(h1) - v0 * w * std::sin(h0) - a * std::cos(h0)) / (w * w);
+        dy = (-v1 * w * std::cos(h1) + a * std::sin(h1) + v0 * w * std::cos(h0) - a * std::sin(h0)) / (w * w);
+    }
+
+    Kinematics extrapolated = mKinematics;
+    // heading is counter-clockwise but y axis points downwards in OMNeT++ coordinates
+    extrapolated.position = Position { mKinematics.position.x / meter + dx, mKinematics.position.y / meter - dy };
+    extrapolated.heading = Angle { std::remainder(h1, 2.0 * M_PI) };
+    extrapolated.speed = v1;
+    return extrapolated;
+}
+
 } // namespace artery
@@ -4,7 +4,9 @@
 #include "traci/API.h"
 #include "artery/utility/Geometry.h"
 #include <omnetpp/ccomponent.h>
+#include <omnetpp/simtime.h>
 #include <memory>
+#include <string>
 
 namespace artery
 {
@@ -16,12 +18,58 @@ public:
     static omnetpp::simsignal_t stateChangedSignal;
     virtual const std::string& getId() = 0;
 
+    /**
+     * Kinematic models for extrapolating the state between TraCI updates
+     */
+    enum class Extrapolation
+    {
+        None, /*< keep state of last update */
+        ConstantVelocity, /*< move along last heading at last speed */
+        ConstantAcceleration, /*< change speed at rate observed between last two updates */
+        ConstantTurnRate, /*< also turn at rate observed between last two updates (CTRA) */
+    };
+
+    /**
+     * Parse extrapolation model: none, constantVelocity, constantAcceleration or constantTurnRate
+     */
+    static Extrapolation parseExtrapolation(const std::string&);
+
+    struct Kinematics
+    {
+        Position position;
+        Angle heading;
+        double speed = 0.0; /*< m/s */
+        double acceleration = 0.0; /*< m/s^2 */
+        double turnRate = 0.0; /*< rad/s, same orientation as heading */
+    };
+
 protected:
     virtual void initialize(const Position&, Angle, double speed) = 0;
     virtual void update(const Position&, Angle, double speed) = 0;
 
+    /**
+     * Start kinematics from scratch, i.e. without acceleration and turn rate
+     */
+    void resetKinematics(const Position&, Angle, double speed);
+
+    /**
+     * Record state of an update, rates are estimated from the previously recorded state
+     */
+    void recordKinematics(const Position&, Angle, double speed);
+
+    /**
+     * Extrapolate recorded state with configured model (evaluated lazily by getters)
+     * \param time point in time not before the last update
+     */
+    Kinematics extrapolateKinematics(omnetpp::SimTime time) const;
+
     std::shared_ptr<traci::API> mTraci;
     traci::Boundary mNetBoundary;
+    Extrapolation mExtrapolation = Extrapolation::None;
+
+private:
+    Kinematics mKinematics;
+    omnetpp::SimTime mKinematicsTime;
 };
 
 } // namespace artery
@@ -1,4 +1,5 @@
 #include "artery/traci/PersonController.h"
+#include "artery/utility/Fingerprint.h"
 
 namespace si = boost::units::si;
 
@@ -22,6 +23,12 @@ const std::string& PersonController::getPersonId() const
 
 void PersonController::setSpeed(Velocity v)
 {
+    using artery::fingerprint::Ingredient;
+    if (artery::fingerprint::isEnabled(Ingredient::TraciCommand)) {
+        artery::fingerprint::add(Ingredient::TraciCommand, libsumo::CMD_SET_PERSON_VARIABLE, libsumo::VAR_SPEED,
+            static_cast<double>(v / si::meter_per_second));
+        artery::fingerprint::addBytes(Ingredient::TraciCommand, getId().data(), getId().size());
+    }
     m_traci->person.setSpeed(getId(), v / si::meter_per_second);
 }
 
@@ -1,10 +1,24 @@
 #include "artery/traci/VehicleController.h"
+#include "artery/utility/Fingerprint.h"
 
 namespace si = boost::units::si;
 
 namespace traci
 {
 
+namespace
+{
+
+void setVehicleDouble(API& api, int var, const std::string& id, double value)
+{
+    tcpip::Storage content;
+    content.writeUnsignedByte(libsumo::TYPE_DOUBLE);
+    content.writeDouble(value);
+    api.setVariable(libsumo::CMD_SET_VEHICLE_VARIABLE, var, id, content);
+}
+
+} // namespace
+
 VehicleController::VehicleController(std::shared_ptr<traci::API> api, const std::string& id) :
     VehicleController(api, std::make_shared<VehicleCache>(api, id))
 {
@@ -12,7 +26,7 @@ VehicleController::VehicleController(std::shared_ptr<traci::API> api, const std:
 
 VehicleController::VehicleController(std::shared_ptr<traci::API> api, std::shared_ptr<VehicleCache> cache) :
     Controller(api, cache),
-    m_type(api->vehicletype, api->vehicle.getTypeID(cache->getId()))
+    m_type(cache->getTypeCache())
 {
 }
 
@@ -38,21 +52,27 @@ auto VehicleController::getMaxSpeed() const -> Velocity
 
 void VehicleController::setMaxSpeed(Velocity v)
 {
-    m_traci->vehicle.setMaxSpeed(getId(), v / si::meter_per_second);
+    setVehicleDouble(*m_traci, libsumo::VAR_MAXSPEED, getId(), v / si::meter_per_second);
 }
 
 void VehicleController::setSpeed(Velocity v)
 {
-    m_traci->vehicle.setSpeed(getId(), v / si::meter_per_second);
+    setVehicleDouble(*m_traci, libsumo::VAR_SPEED, getId(), v / si::meter_per_second);
 }
 
 void VehicleController::setSpeedFactor(double f)
 {
-    m_traci->vehicle.setSpeedFactor(getId(), f);
+    setVehicleDouble(*m_traci, libsumo::VAR_SPEED_FACTOR, getId(), f);
 }
 
 void VehicleController::changeTarget(const std::string& edge)
 {
+    using artery::fingerprint::Ingredient;
+    if (artery::fingerprint::isEnabled(Ingredient::TraciCommand)) {
+        artery::fingerprint::add(Ingredient::TraciCommand, libsumo::CMD_SET_VEHICLE_VARIABLE, libsumo::CMD_CHANGETARGET);
+        artery::fingerprint::addBytes(Ingredient::TraciCommand, getId().data(), getId().size());
+        artery::fingerprint::addBytes(Ingredient::TraciCommand, edge.data(), edge.size());
+    }
     m_traci->vehicle.changeTarget(getId(), edge);
 }
 
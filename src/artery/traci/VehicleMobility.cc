@@ -17,6 +17,11 @@ void VehicleMobility::initializeSink(std::shared_ptr<API> api, std::shared_ptr<V
     mController.reset(new VehicleController(api, cache));
 }
 
+std::set<int> VehicleMobility::getConsumedVehicleVariables() const
+{
+    return { libsumo::VAR_SPEED };
+}
+
 void VehicleMobility::initializeVehicle(const TraCIPosition& traci_pos, TraCIAngle traci_heading, double traci_speed)
 {
     const auto opp_pos = position_cast(mNetBoundary, traci_pos);
@@ -31,6 +36,19 @@ void VehicleMobility::updateVehicle(const TraCIPosition& traci_pos, TraCIAngle t
     update(opp_pos, opp_angle, traci_speed);
 }
 
+bool VehicleMobility::prepareVehicle(const TraCIPosition& traci_pos, TraCIAngle traci_heading, double traci_speed)
+{
+    mPreparedPosition = position_cast(mNetBoundary, traci_pos);
+    mPreparedHeading = angle_cast(traci_heading);
+    mPreparedSpeed = traci_speed;
+    return true;
+}
+
+void VehicleMobility::commitVehicle()
+{
+    update(mPreparedPosition, mPreparedHeading, mPreparedSpeed);
+}
+
 VehicleController* VehicleMobility::getVehicleController()
 {
     ASSERT(mController);
@@ -4,6 +4,7 @@
 #include "artery/traci/ControllableVehicle.h"
 #include "artery/traci/MobilityBase.h"
 #include "traci/VehicleSink.h"
+#include "traci/VehicleVariableConsumer.h"
 #include "traci/VariableCache.h"
 #include <string>
 
@@ -13,22 +14,33 @@ namespace artery
 class VehicleMobility :
     public virtual MobilityBase,
     public traci::VehicleSink, // for receiving updates from TraCI
-    public ControllableVehicle // for controlling the vehicle via TraCI
+    public ControllableVehicle, // for controlling the vehicle via TraCI
+    public traci::VehicleVariableConsumer // speed for updates and controller users, e.g. storyboard
 {
 public:
     // traci::VehicleSink interface
     void initializeSink(std::shared_ptr<traci::API>, std::shared_ptr<traci::VehicleCache>, const traci::Boundary&) override;
     void initializeVehicle(const traci::TraCIPosition&, traci::TraCIAngle, double speed) override;
     void updateVehicle(const traci::TraCIPosition&, traci::TraCIAngle, double speed) override;
+    bool prepareVehicle(const traci::TraCIPosition&, traci::TraCIAngle, double speed) override;
+    void commitVehicle() override;
 
     const std::string& getId() const { return mVehicleId; };
 
     // ControllableVehicle
     traci::VehicleController* getVehicleController() override;
 
+    // traci::VehicleVariableConsumer
+    std::set<int> getConsumedVehicleVariables() const override;
+
 protected:
     std::string mVehicleId;
     std::unique_ptr<traci::VehicleController> mController;
+
+private:
+    Position mPreparedPosition;
+    Angle mPreparedHeading;
+    double mPreparedSpeed = 0.0;
 };
 
 } // namespace artery
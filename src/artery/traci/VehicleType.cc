@@ -8,49 +8,49 @@ namespace si = boost::units::si;
 namespace traci
 {
 
-VehicleType::VehicleType(const traci::API::VehicleTypeScope& api, const std::string& id) :
-    m_id(id), m_api(api)
+VehicleType::VehicleType(std::shared_ptr<VehicleTypeCache> cache) :
+    m_cache(cache)
 {
 }
 
 const std::string& VehicleType::getTypeId() const
 {
-    return m_id;
+    return m_cache->getTypeId();
 }
 
 std::string VehicleType::getVehicleClass() const
 {
-    return m_api.getVehicleClass(m_id);
+    return m_cache->get<libsumo::VAR_VEHICLECLASS>();
 }
 
 auto VehicleType::getMaxSpeed() const -> Velocity
 {
-    return m_api.getMaxSpeed(m_id) * si::meter_per_second;
+    return m_cache->get<libsumo::VAR_MAXSPEED>() * si::meter_per_second;
 }
 
 auto VehicleType::getMaxAcceleration() const -> Acceleration
 {
-    return m_api.getAccel(m_id) * si::meter_per_second_squared;
+    return m_cache->get<libsumo::VAR_ACCEL>() * si::meter_per_second_squared;
 }
 
 auto VehicleType::getMaxDeceleration() const -> Acceleration
 {
-    return m_api.getDecel(m_id) * si::meter_per_second_squared;
+    return m_cache->get<libsumo::VAR_DECEL>() * si::meter_per_second_squared;
 }
 
 auto VehicleType::getLength() const -> Length
 {
-    return m_api.getLength(m_id) * si::meter;
+    return m_cache->get<libsumo::VAR_LENGTH>() * si::meter;
 }
 
 auto VehicleType::getWidth() const -> Length
 {
-    return m_api.getWidth(m_id) * si::meter;
+    return m_cache->get<libsumo::VAR_WIDTH>() * si::meter;
 }
 
 auto VehicleType::getHeight() const -> Length
 {
-    return m_api.getHeight(m_id) * si::meter;
+    return m_cache->get<libsumo::VAR_HEIGHT>() * si::meter;
 }
 
 } // namespace traci
@@ -1,11 +1,12 @@
 #ifndef VEHICLETYPE_H_QHTSUY2F
 #define VEHICLETYPE_H_QHTSUY2F
 
-#include "traci/API.h"
+#include "traci/VariableCache.h"
 #include <vanetza/units/acceleration.hpp>
 #include <vanetza/units/angle.hpp>
 #include <vanetza/units/length.hpp>
 #include <vanetza/units/velocity.hpp>
+#include <memory>
 #include <string>
 
 namespace traci
@@ -18,7 +19,11 @@ public:
     using Length = vanetza::units::Length;
     using Velocity = vanetza::units::Velocity;
 
-    VehicleType(const traci::API::VehicleTypeScope&, const std::string& id);
+    /**
+     * Vehicle type attributes are read through given cache.
+     * Vehicle types are assumed to be constant, i.e. each attribute is retrieved only once per cache.
+     */
+    VehicleType(std::shared_ptr<VehicleTypeCache>);
 
     const std::string& getTypeId() const;
     std::string getVehicleClass() const;
@@ -30,8 +35,7 @@ public:
     Length getHeight() const;
 
 private:
-    std::string m_id;
-    const traci::API::VehicleTypeScope& m_api;
+    std::shared_ptr<VehicleTypeCache> m_cache;
 };
 
 } // namespace traci
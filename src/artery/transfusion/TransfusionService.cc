@@ -20,10 +20,8 @@
 #include "TransfusionMsg.pb.h"
 #include <boost/units/systems/si/prefixes.hpp>
 #include <google/protobuf/io/coded_stream.h>
-#include <google/protobuf/io/zero_copy_stream_impl.h>
 #include <omnetpp/csimulation.h>
 #include <vanetza/common/byte_view.hpp>
-#include <sstream>
 
 using namespace omnetpp;
 
@@ -32,6 +30,13 @@ namespace artery
 
 Define_Module(TransfusionService)
 
+TransfusionService::TransfusionService() :
+    m_message(new Transfusion::TransfusionMsg())
+{
+}
+
+TransfusionService::~TransfusionService() = default;
+
 void TransfusionService::initialize()
 {
     ItsG5BaseService::initialize();
@@ -39,6 +44,7 @@ void TransfusionService::initialize()
 
     AsioScheduler* scheduler = check_and_cast<AsioScheduler*>(getSimulation()->getScheduler());
     m_asio_task = scheduler->createTask(*this);
+    m_asio_task->setWriteLimit(par("send_buffer_limit").intValue());
 
     boost::asio::ip::tcp::endpoint endpoint;
     boost::system::error_code ec;
@@ -57,34 +63,62 @@ void TransfusionService::initialize()
     }
 }
 
+void TransfusionService::finish()
+{
+    // messages tapped during the last events must not get lost when the task is destroyed
+    m_asio_task->drain();
+    ItsG5PromiscuousService::finish();
+}
+
 void TransfusionService::handleMessage(cMessage* msg)
 {
     if (msg == m_asio_task->getDataMessage())
     {
-        // receiving a message from external software
-        auto buffer = m_asio_task->getDataMessage()->getBuffer();
-        std::size_t len = m_asio_task->getDataMessage()->getLength();
-        std::copy(buffer.data(), buffer.data() + len, std::back_inserter(m_buffer));
-
-        google::protobuf::io::ArrayInputStream aos(buffer.data(), buffer.size());
-        google::protobuf::io::CodedInputStream cis(&aos);
-        uint32_t msg_length = 0;
-        cis.ReadVarint32(&msg_length);
-        if (msg_length > 0 && m_buffer.size() >= msg_length) {
-            auto limit = cis.PushLimit(msg_length);
-            Transfusion::TransfusionMsg msg;
-            if (msg.ParseFromCodedStream(&cis)) {
-                processMessage(msg);
+        // receiving messages from external software
+        AsioChunk chunk;
+        while (m_asio_task->receive(chunk)) {
+            if (m_buffer_offset == m_buffer.size()) {
+                // nothing buffered: decode straight from received bytes and keep only a partial trailing message
+                const std::size_t consumed = decodeMessages(chunk.data(), chunk.size());
+                m_buffer.assign(chunk.data() + consumed, chunk.data() + chunk.size());
+                m_buffer_offset = 0;
             } else {
-                EV_WARN << "Decoding of Transfusion message failed, skip it";
+                m_buffer.insert(m_buffer.end(), chunk.data(), chunk.data() + chunk.size());
+                m_buffer_offset += decodeMessages(m_buffer.data() + m_buffer_offset, m_buffer.size() - m_buffer_offset);
+
+                // move partial message to front only when consumed bytes make up most of the buffer
+                if (m_buffer_offset >= m_buffer.size() / 2) {
+                    m_buffer.erase(m_buffer.begin(), m_buffer.begin() + m_buffer_offset);
+                    m_buffer_offset = 0;
+                }
             }
-            cis.PopLimit(limit);
-            m_buffer.erase(m_buffer.begin(), m_buffer.begin() + cis.CurrentPosition());
         }
+    }
+}
 
-        // signal scheduler that we are ready to handle further data
-        m_asio_task->handleNext();
+std::size_t TransfusionService::decodeMessages(const uint8_t* data, std::size_t size)
+{
+    // decode all complete messages, each is prefixed by its length
+    std::size_t consumed = 0;
+    while (consumed < size) {
+        const int available = size - consumed;
+        google::protobuf::io::CodedInputStream cis(data + consumed, available);
+        uint32_t msg_length = 0;
+        if (!cis.ReadVarint32(&msg_length) || static_cast<uint32_t>(available - cis.CurrentPosition()) < msg_length) {
+            // wait for remaining bytes
+            break;
+        }
+
+        auto limit = cis.PushLimit(msg_length);
+        if (m_message->ParseFromCodedStream(&cis) && cis.ConsumedEntireMessage()) {
+            processMessage(*m_message);
+        } else {
+            EV_WARN << "Decoding of Transfusion message failed, skip it";
+        }
+        cis.PopLimit(limit);
+        consumed += cis.CurrentPosition();
     }
+    return consumed;
 }
 
 void TransfusionService::processMessage(const Transfusion::TransfusionMsg& msg)
@@ -142,16 +176,16 @@ void TransfusionService::tapPacket(const vanetza::btp::DataIndication& indicatio
         msg.set_maximum_lifetime(indication.remaining_packet_lifetime->decode() / seconds);
     }
 
-    std::ostringstream strstream;
-    {
-        google::protobuf::io::OstreamOutputStream os(&strstream);
-        google::protobuf::io::CodedOutputStream cos(&os);
-        cos.WriteVarint32(msg.ByteSizeLong());
-        if(!msg.SerializeToCodedStream(&cos)) {
-            throw cRuntimeError("Encoding of Transfusion message failed");
-        }
+    // serialise length-prefixed message into reused buffer, sending is coalesced by AsioTask
+    using google::protobuf::io::CodedOutputStream;
+    const std::size_t msg_length = msg.ByteSizeLong();
+    const std::size_t prefix_length = CodedOutputStream::VarintSize32(msg_length);
+    m_output.resize(prefix_length + msg_length);
+    CodedOutputStream::WriteVarint32ToArray(msg_length, m_output.data());
+    if (!msg.SerializeWithCachedSizesToArray(m_output.data() + prefix_length)) {
+        throw cRuntimeError("Encoding of Transfusion message failed");
     }
-    m_asio_task->write(boost::asio::buffer(strstream.str()));
+    m_asio_task->write(boost::asio::buffer(m_output));
 }
 
 vanetza::geonet::Area TransfusionService::buildDestinationArea(const Transfusion::GeoBroadcast& gbc)
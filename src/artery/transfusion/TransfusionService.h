@@ -36,17 +36,25 @@ namespace artery
 class TransfusionService : public ItsG5PromiscuousService
 {
     public:
+        TransfusionService();
+        ~TransfusionService();
+
         void tapPacket(const vanetza::btp::DataIndication&, const vanetza::UpPacket&) override;
 
     protected:
         void initialize() override;
         void handleMessage(omnetpp::cMessage*) override;
+        void finish() override;
 
     private:
         void processMessage(const Transfusion::TransfusionMsg&);
+        std::size_t decodeMessages(const uint8_t* data, std::size_t size);
         vanetza::geonet::Area buildDestinationArea(const Transfusion::GeoBroadcast&);
         std::unique_ptr<AsioTask> m_asio_task;
-        vanetza::ByteBuffer m_buffer;
+        vanetza::ByteBuffer m_buffer; /*< received bytes, consumed up to m_buffer_offset */
+        std::size_t m_buffer_offset = 0;
+        std::unique_ptr<Transfusion::TransfusionMsg> m_message; /*< reused for decoding, keeps its allocations */
+        vanetza::ByteBuffer m_output; /*< reused for encoding */
 };
 
 } // namespace artery
@@ -15,20 +15,31 @@
 
 #include "AsioScheduler.h"
 #include "AsioTask.h"
+#include "artery/utility/FreeList.h"
 #include <chrono>
 #include <functional>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/read.hpp>
 #include <boost/asio/steady_timer.hpp>
 #include <boost/asio/executor_work_guard.hpp>
+#include <omnetpp/cconfigoption.h>
+#include <omnetpp/cconfiguration.h>
+#include <omnetpp/regmacros.h>
 
 namespace artery
 {
 
 Register_Class(AsioScheduler)
+Register_GlobalConfigOption(CFGID_ASIO_BUSY_POLL, "asio-busy-poll", CFG_BOOL, "false",
+		"AsioScheduler polls IO busily instead of sleeping shortly before events are due.")
+Register_GlobalConfigOptionU(CFGID_ASIO_BUSY_POLL_BUDGET, "asio-busy-poll-budget", "s", "1ms",
+		"Time span before an event in which AsioScheduler polls busily if asio-busy-poll is enabled.")
 
 using namespace omnetpp;
 
+// maximum number of ready IO completions handled before an event is returned
+static const unsigned max_ready_completions = 64;
+
 template<typename PERIOD>
 struct clock_resolution { static const SimTimeUnit unit; };
 
@@ -55,6 +66,8 @@ std::chrono::steady_clock::duration steady_clock_duration(const SimTime t)
 AsioScheduler::AsioScheduler() :
 	m_work_guard(boost::asio::make_work_guard(m_io_context)),
 	m_timer(m_io_context),
+	m_timer_pending(false),
+	m_busy_poll(false),
 	m_state(FluxState::PAUSED)
 {
 }
@@ -79,17 +92,13 @@ cEvent* AsioScheduler::takeNextEvent()
 				ASSERT(tmp == event);
 				delete tmp;
 			} else {
-				m_run_until = m_reference + steady_clock_duration(event->getArrivalTime());
 				try {
 					ASSERT(!m_io_context.stopped());
-					setTimer();
-					while (m_state == FluxState::DWADLING) {
-						m_io_context.run_one();
-					}
-					m_timer.cancel();
-					m_io_context.poll();
+					waitFor(event);
+					// handle completions which are ready anyway, but do not starve the simulation
+					for (unsigned i = 0; i < max_ready_completions && m_io_context.poll_one() > 0; ++i);
 				} catch (boost::system::system_error& e) {
-					cRuntimeError("AsioScheduler IO error: %s", e.what());
+					throw cRuntimeError("AsioScheduler IO error: %s", e.what());
 				}
 
 				if (m_state == FluxState::SYNC) {
@@ -109,8 +118,40 @@ void AsioScheduler::putBackEvent(cEvent* event)
 	sim->getFES()->putBackFirst(event);
 }
 
+void AsioScheduler::waitFor(cEvent* event)
+{
+	using clock = std::chrono::steady_clock;
+	m_run_until = m_reference + steady_clock_duration(event->getArrivalTime());
+	m_state = FluxState::DWADLING;
+	while (m_state == FluxState::DWADLING) {
+		const auto now = clock::now();
+		if (m_run_until <= now) {
+			// event is already due, e.g. when fast-forwarding
+			m_state = FluxState::SYNC;
+			break;
+		} else if (m_busy_poll && m_run_until - now <= m_busy_poll_budget) {
+			m_io_context.poll_one();
+		} else {
+			setTimer(now);
+			m_io_context.run_one();
+		}
+
+		// IO handlers may have inserted an earlier event
+		cEvent* first = sim->getFES()->peekFirst();
+		if (first != event) {
+			event = first;
+			m_run_until = m_reference + steady_clock_duration(event->getArrivalTime());
+		}
+	}
+}
+
 void AsioScheduler::startRun()
 {
+	cConfiguration* config = getEnvir()->getConfig();
+	m_busy_poll = config->getAsBool(CFGID_ASIO_BUSY_POLL);
+	m_busy_poll_budget = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+			std::chrono::duration<double>(config->getAsDouble(CFGID_ASIO_BUSY_POLL_BUDGET)));
+
 	m_state = FluxState::SYNC;
 	if (m_io_context.stopped()) {
 		m_io_context.restart();
@@ -133,25 +174,31 @@ void AsioScheduler::executionResumed()
 
 void AsioScheduler::handleTimer(const boost::system::error_code& ec)
 {
+	if (ec == boost::asio::error::operation_aborted) {
+		// timer has been re-armed for an earlier expiry
+		return;
+	}
+
+	m_timer_pending = false;
 	if (getEnvir()->idle()) {
 		m_state = FluxState::PAUSED;
-	} else if (ec) {
-		m_state = FluxState::SYNC;
-	} else {
-		setTimer();
 	}
 }
 
-void AsioScheduler::setTimer()
+void AsioScheduler::setTimer(std::chrono::steady_clock::time_point now)
 {
+	// wake up regularly for GUI responsiveness
 	static const auto max_timer = std::chrono::milliseconds(100);
-	const auto now = std::chrono::steady_clock::now();
-	if (m_run_until > now) {
-		m_state = FluxState::DWADLING;
-		m_timer.expires_at(std::min(m_run_until, now + max_timer));
+	auto expiry = std::min(m_run_until, now + max_timer);
+	if (m_busy_poll) {
+		expiry = std::min(expiry, m_run_until - m_busy_poll_budget);
+	}
+
+	// re-arm only if pending timer would expire too late
+	if (!m_timer_pending || expiry < m_timer.expiry()) {
+		m_timer.expires_at(expiry);
 		m_timer.async_wait(std::bind(&AsioScheduler::handleTimer, this, std::placeholders::_1));
-	} else {
-		m_state = FluxState::SYNC;
+		m_timer_pending = true;
 	}
 }
 
@@ -173,24 +220,48 @@ void AsioScheduler::cancelTask(AsioTask* task)
 void AsioScheduler::processTask(AsioTask* task)
 {
 	using namespace std::placeholders;
-	auto& buffer = task->m_message->getBuffer();
-	auto handler = std::bind(&AsioScheduler::handleTask, this, task, _1, _2);
-	task->m_socket.async_read_some(boost::asio::buffer(buffer.data(), buffer.size()), handler);
+	// read into a fresh buffer, previous ones may still be referred to by chunks
+	using Buffer = AsioChunk::Buffer;
+	auto buffer = std::allocate_shared<Buffer>(FreeListAllocator<Buffer>());
+	auto handler = std::bind(&AsioScheduler::handleTask, this, task, buffer, _1, _2);
+	task->m_socket.async_read_some(boost::asio::buffer(*buffer), handler);
+}
+
+void AsioScheduler::processOne()
+{
+	if (m_io_context.stopped() || m_io_context.run_one() == 0) {
+		throw cRuntimeError("AsioScheduler: IO context stopped while waiting for pending operations");
+	}
 }
 
-void AsioScheduler::handleTask(AsioTask* task, const boost::system::error_code& ec, std::size_t bytes)
+void AsioScheduler::handleTask(AsioTask* task, std::shared_ptr<AsioChunk::Buffer> buffer, const boost::system::error_code& ec, std::size_t bytes)
 {
+	if (ec == boost::asio::error::operation_aborted) {
+		// task may have been destroyed already, its socket's destruction aborts pending reads
+		return;
+	}
+
+	task->m_reading = false;
 	if (!ec) {
-		using namespace std::chrono;
-		const auto arrival_clock = steady_clock::now() - m_reference;
-		const SimTime arrival_simtime { arrival_clock.count(), steady_clock_resolution() };
-		ASSERT(simTime() <= arrival_simtime);
+		AsioChunk chunk;
+		chunk.buffer = std::move(buffer);
+		chunk.length = bytes;
+		task->m_received.push_back(std::move(chunk));
 
 		AsioData* msg = task->getDataMessage();
-		msg->setLength(bytes);
-		msg->setArrival(task->getDestinationModule()->getId(), -1, arrival_simtime);
-		sim->getFES()->insert(msg);
-	} else if (ec != boost::asio::error::operation_aborted) {
+		if (!msg->isScheduled()) {
+			using namespace std::chrono;
+			const auto arrival_clock = steady_clock::now() - m_reference;
+			const SimTime arrival_simtime { arrival_clock.count(), steady_clock_resolution() };
+			ASSERT(simTime() <= arrival_simtime);
+
+			msg->setArrival(task->getDestinationModule()->getId(), -1, arrival_simtime);
+			sim->getFES()->insert(msg);
+		}
+
+		// continue reading without waiting for the module
+		task->resumeReading();
+	} else {
 		throw cRuntimeError("AsioScheduler: Failed reading from socket: %s", ec.message().c_str());
 	}
 }
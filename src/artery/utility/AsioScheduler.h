@@ -16,6 +16,7 @@
 #ifndef ARTERY_ASIOSCHEDULER_H_
 #define ARTERY_ASIOSCHEDULER_H_
 
+#include "artery/utility/AsioTask.h"
 #include <omnetpp/cmodule.h>
 #include <omnetpp/cscheduler.h>
 #include <boost/asio/io_context.hpp>
@@ -27,8 +28,6 @@
 namespace artery
 {
 
-class AsioTask;
-
 class AsioScheduler : public omnetpp::cScheduler
 {
 	public:
@@ -38,6 +37,11 @@ class AsioScheduler : public omnetpp::cScheduler
 		void cancelTask(AsioTask*);
 		void processTask(AsioTask*);
 
+		/**
+		 * Block until one pending IO handler has been executed
+		 */
+		void processOne();
+
 	protected:
 		virtual omnetpp::cEvent* guessNextEvent() override;
 		virtual omnetpp::cEvent* takeNextEvent() override;
@@ -48,9 +52,10 @@ class AsioScheduler : public omnetpp::cScheduler
 		virtual void executionResumed() override;
 
 	private:
-		void handleTask(AsioTask*, const boost::system::error_code&, std::size_t bytes);
+		void handleTask(AsioTask*, std::shared_ptr<AsioChunk::Buffer>, const boost::system::error_code&, std::size_t bytes);
+		void waitFor(omnetpp::cEvent*);
 		void handleTimer(const boost::system::error_code&);
-		void setTimer();
+		void setTimer(std::chrono::steady_clock::time_point now);
 
 		enum class FluxState {
 			PAUSED, DWADLING, SYNC
@@ -61,6 +66,9 @@ class AsioScheduler : public omnetpp::cScheduler
 		boost::asio::steady_timer m_timer;
 		std::chrono::steady_clock::time_point m_reference;
 		std::chrono::steady_clock::time_point m_run_until;
+		bool m_timer_pending;
+		bool m_busy_poll;
+		std::chrono::steady_clock::duration m_busy_poll_budget;
 		FluxState m_state;
 };
 
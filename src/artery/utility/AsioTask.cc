@@ -1,35 +1,105 @@
 #include "AsioScheduler.h"
 #include "AsioTask.h"
+#include <boost/asio/post.hpp>
 #include <boost/asio/write.hpp>
+#include <omnetpp/cexception.h>
 
 namespace artery
 {
 
 AsioTask::AsioTask(AsioScheduler& scheduler, boost::asio::ip::tcp::socket socket, omnetpp::cModule& mod) :
-	m_scheduler(scheduler), m_socket(std::move(socket)), m_message(new AsioData("Asio Data")), m_module(mod)
+	m_scheduler(scheduler), m_socket(std::move(socket)), m_message(new AsioData("Asio Data")), m_module(mod),
+	m_output(std::make_shared<Output>()), m_write_limit(1024 * 1024), m_reading(false)
 {
 }
 
 AsioTask::~AsioTask()
 {
+	m_output->cancelled = true;
 	m_scheduler.cancelTask(this);
 }
 
 void AsioTask::write(boost::asio::const_buffer buf)
 {
-	boost::asio::write(m_socket, boost::asio::buffer(buf));
+	const uint8_t* data = static_cast<const uint8_t*>(buf.data());
+	m_output->queued.insert(m_output->queued.end(), data, data + buf.size());
+
+	if (!m_output->busy) {
+		// defer flush so all data written during the current event is coalesced
+		m_output->busy = true;
+		std::shared_ptr<Output> output = m_output;
+		boost::asio::post(m_socket.get_executor(), [this, output]() {
+			if (!output->cancelled) {
+				flush();
+			}
+		});
+	}
+
+	// backpressure: let the peer catch up instead of queuing without bounds
+	while (m_output->queued.size() + m_output->sending.size() > m_write_limit) {
+		m_scheduler.processOne();
+	}
+}
+
+void AsioTask::drain()
+{
+	// busy until posted flush and all subsequent writes have completed
+	while (m_output->busy) {
+		m_scheduler.processOne();
+	}
+}
+
+void AsioTask::flush()
+{
+	std::shared_ptr<Output> output = m_output;
+	output->sending.swap(output->queued);
+	boost::asio::async_write(m_socket, boost::asio::buffer(output->sending),
+		[this, output](const boost::system::error_code& ec, std::size_t) {
+			if (output->cancelled || ec == boost::asio::error::operation_aborted) {
+				return;
+			} else if (ec) {
+				throw omnetpp::cRuntimeError("AsioTask: Failed writing to socket: %s", ec.message().c_str());
+			}
+
+			output->sending.clear();
+			if (output->queued.empty()) {
+				output->busy = false;
+			} else {
+				flush();
+			}
+		});
+}
+
+bool AsioTask::receive(AsioChunk& chunk)
+{
+	if (m_received.empty()) {
+		return false;
+	}
+
+	chunk = std::move(m_received.front());
+	m_received.pop_front();
+	resumeReading();
+	return true;
 }
 
 void AsioTask::connect(boost::asio::ip::tcp::endpoint ep, bool tcp_no_delay)
 {
 	m_socket.connect(ep);
 	m_socket.set_option(boost::asio::ip::tcp::no_delay(tcp_no_delay));
-	m_scheduler.processTask(this);
+	resumeReading();
 }
 
 void AsioTask::handleNext()
 {
-	m_scheduler.processTask(this);
+	resumeReading();
+}
+
+void AsioTask::resumeReading()
+{
+	if (!m_reading && m_received.size() < max_received_chunks) {
+		m_reading = true;
+		m_scheduler.processTask(this);
+	}
 }
 
 } // namespace artery
@@ -5,20 +5,75 @@
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <omnetpp/cmodule.h>
+#include <array>
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <vector>
 
 namespace artery
 {
 
 class AsioScheduler;
 
+/**
+ * AsioChunk refers to bytes received by a single read
+ *
+ * Chunks share their buffer, which is recycled when the last chunk referring to it is gone.
+ */
+struct AsioChunk
+{
+	using Buffer = std::array<uint8_t, 4096>;
+
+	std::shared_ptr<const Buffer> buffer;
+	std::size_t length = 0;
+
+	const uint8_t* data() const { return buffer->data(); }
+	std::size_t size() const { return length; }
+};
+
 class AsioTask
 {
 	public:
 		AsioTask(AsioScheduler&, boost::asio::ip::tcp::socket, omnetpp::cModule&);
 		virtual ~AsioTask();
+
+		/**
+		 * Queue data for sending
+		 *
+		 * Data queued while handling an event is sent by a single asynchronous write.
+		 * Only if more than the write limit is queued, this call blocks until enough data has been sent.
+		 */
 		void write(boost::asio::const_buffer);
+
+		/**
+		 * Send all queued data, blocks until the last write has completed
+		 *
+		 * Data still queued when the task is destroyed is discarded, thus drain it at the end of a run.
+		 */
+		void drain();
+
+		/**
+		 * Set number of bytes which may be queued before write blocks
+		 */
+		void setWriteLimit(std::size_t limit) { m_write_limit = limit; }
+
+		/**
+		 * Take next chunk of received bytes
+		 *
+		 * Data message is scheduled when chunks are available.
+		 * Reading continues in the background until max_received_chunks are pending.
+		 * \param chunk is assigned next chunk
+		 * \return false if no chunk is pending
+		 */
+		bool receive(AsioChunk& chunk);
+
 		void connect(boost::asio::ip::tcp::endpoint, bool tcp_no_delay = false);
+
+		/**
+		 * Resume reading if it has been paused because too many chunks were pending
+		 * \note receive() resumes reading on its own
+		 */
 		void handleNext();
 		AsioData* getDataMessage() { return m_message.get(); }
 		const omnetpp::cModule* getDestinationModule() { return &m_module; }
@@ -26,10 +81,28 @@ class AsioTask
 	private:
 		friend class AsioScheduler;
 
+		// shared with pending handlers, which may outlive the task
+		struct Output
+		{
+			std::vector<uint8_t> queued;
+			std::vector<uint8_t> sending;
+			bool busy = false; /*< flush posted or write in progress */
+			bool cancelled = false;
+		};
+
+		static constexpr std::size_t max_received_chunks = 64;
+
+		void flush();
+		void resumeReading();
+
 		AsioScheduler& m_scheduler;
 		boost::asio::ip::tcp::socket m_socket;
 		std::unique_ptr<AsioData> m_message;
 		omnetpp::cModule& m_module;
+		std::shared_ptr<Output> m_output;
+		std::size_t m_write_limit;
+		std::deque<AsioChunk> m_received;
+		bool m_reading;
 };
 
 } // namespace artery
@@ -0,0 +1,149 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include <omnetpp.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace artery
+{
+
+Register_PerRunConfigOption(CFGID_BINARY_TRACE_FILE, "artery-binary-trace-file", CFG_FILENAME,
+    "${resultdir}/${configname}-${iterationvarsf}#${repetition}.atr",
+    "Output file of binaryVector result recorders, traces are declared in a text file with suffix \".idx\"");
+
+namespace
+{
+
+/**
+ * BinaryTraceFile stores samples of all binaryVector recorders in fixed-size little-endian records:
+ * trace id (uint32), simulation time in seconds (double) and value (double).
+ * Each trace id is declared by a line "id<TAB>module path<TAB>result name" in the index file.
+ */
+class BinaryTraceFile
+{
+public:
+    static constexpr std::size_t recordSize = sizeof(std::uint32_t) + 2 * sizeof(double);
+    static constexpr std::size_t bufferSize = 1 << 20;
+
+    static std::shared_ptr<BinaryTraceFile> instance()
+    {
+        // file is shared by all recorders of a run and closed by its last recorder
+        static std::weak_ptr<BinaryTraceFile> shared;
+        std::shared_ptr<BinaryTraceFile> file = shared.lock();
+        if (!file) {
+            file = std::make_shared<BinaryTraceFile>(omnetpp::getEnvir()->getConfig()->getAsFilename(CFGID_BINARY_TRACE_FILE));
+            shared = file;
+        }
+        return file;
+    }
+
+    explicit BinaryTraceFile(const std::string& filename)
+    {
+        const std::filesystem::path path { filename };
+        if (path.has_parent_path()) {
+            std::filesystem::create_directories(path.parent_path());
+        }
+
+        mData = std::fopen(filename.c_str(), "wb");
+        mIndex = std::fopen((filename + ".idx").c_str(), "w");
+        if (!mData || !mIndex) {
+            close();
+            throw omnetpp::cRuntimeError("cannot open binary trace file %s", filename.c_str());
+        }
+        mBuffer.reserve(bufferSize);
+    }
+
+    ~BinaryTraceFile()
+    {
+        flush();
+        close();
+    }
+
+    BinaryTraceFile(const BinaryTraceFile&) = delete;
+    BinaryTraceFile& operator=(const BinaryTraceFile&) = delete;
+
+    std::uint32_t declare(const std::string& module, const std::string& name)
+    {
+        const std::uint32_t id = mTraces++;
+        std::fprintf(mIndex, "%u\t%s\t%s\n", id, module.c_str(), name.c_str());
+        return id;
+    }
+
+    void record(std::uint32_t id, double time, double value)
+    {
+        if (mBuffer.size() + recordSize > bufferSize) {
+            flush();
+        }
+
+        // host byte order is little-endian on all supported platforms
+        char record[recordSize];
+        std::memcpy(record, &id, sizeof(id));
+        std::memcpy(record + sizeof(id), &time, sizeof(time));
+        std::memcpy(record + sizeof(id) + sizeof(time), &value, sizeof(value));
+        mBuffer.insert(mBuffer.end(), record, record + recordSize);
+    }
+
+    void flush()
+    {
+        if (mData && !mBuffer.empty()) {
+            std::fwrite(mBuffer.data(), 1, mBuffer.size(), mData);
+            mBuffer.clear();
+        }
+    }
+
+private:
+    void close()
+    {
+        if (mData) {
+            std::fclose(mData);
+            mData = nullptr;
+        }
+        if (mIndex) {
+            std::fclose(mIndex);
+            mIndex = nullptr;
+        }
+    }
+
+    std::FILE* mData = nullptr;
+    std::FILE* mIndex = nullptr;
+    std::vector<char> mBuffer;
+    std::uint32_t mTraces = 0;
+};
+
+} // namespace
+
+/**
+ * BinaryTraceRecorder records values like "vector" but appends them to a shared binary trace file.
+ *
+ * There is no per-sample formatting or database access, e.g. for high-frequency KPIs of many stations.
+ * Select it per statistic like any other recording mode, e.g. "**.reception.result-recording-modes = binaryVector".
+ */
+class BinaryTraceRecorder : public omnetpp::cNumericResultRecorder
+{
+protected:
+    void collect(omnetpp::simtime_t_cref t, double value, omnetpp::cObject*) override
+    {
+        if (!mFile) {
+            mFile = BinaryTraceFile::instance();
+            const std::string name = std::string(getStatisticName()) + ":" + getRecordingMode();
+            mId = mFile->declare(getComponent()->getFullPath(), name);
+        }
+        mFile->record(mId, t.dbl(), value);
+    }
+
+private:
+    std::shared_ptr<BinaryTraceFile> mFile;
+    std::uint32_t mId = 0;
+};
+
+Register_ResultRecorder("binaryVector", BinaryTraceRecorder)
+
+} // namespace artery
@@ -0,0 +1,57 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_DISPLACEMENTTHROTTLE_H_P3MX9VQT
+#define ARTERY_DISPLACEMENTTHROTTLE_H_P3MX9VQT
+
+#include "artery/utility/Geometry.h"
+#include <omnetpp/simtime.h>
+
+namespace artery
+{
+
+/**
+ * DisplacementThrottle skips updates of slowly moving objects, e.g. pedestrians.
+ *
+ * An update is due once the object has moved by the minimum distance since the last update
+ * or the maximum interval has passed. A distance of zero makes every update due.
+ */
+class DisplacementThrottle
+{
+public:
+    void configure(double distance, omnetpp::SimTime maxInterval)
+    {
+        mDistance = distance;
+        mMaxInterval = maxInterval;
+    }
+
+    bool isDue(const Position& position, omnetpp::SimTime now) const
+    {
+        if (mDistance <= 0.0 || !mUpdated || now - mLastTime >= mMaxInterval) {
+            return true;
+        }
+        const double dx = position.x.value() - mLastPosition.x.value();
+        const double dy = position.y.value() - mLastPosition.y.value();
+        return dx * dx + dy * dy >= mDistance * mDistance;
+    }
+
+    void updated(const Position& position, omnetpp::SimTime now)
+    {
+        mLastPosition = position;
+        mLastTime = now;
+        mUpdated = true;
+    }
+
+private:
+    double mDistance = 0.0;
+    omnetpp::SimTime mMaxInterval;
+    Position mLastPosition;
+    omnetpp::SimTime mLastTime;
+    bool mUpdated = false;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_DISPLACEMENTTHROTTLE_H_P3MX9VQT */
@@ -7,45 +7,75 @@
 #include "artery/utility/Identity.h"
 #include "artery/utility/FilterRules.h"
 #include "artery/utility/PointerCheck.h"
+#include "artery/utility/XmlConfigCache.h"
 #include <boost/lexical_cast.hpp>
 #include <omnetpp/ccomponenttype.h>
 #include <omnetpp/cexception.h>
 #include <omnetpp/cxmlelement.h>
 #include <omnetpp/distrib.h>
 #include <algorithm>
+#include <cstdint>
 #include <cstring>
-#include <list>
+#include <memory>
 #include <regex>
+#include <string>
+#include <unordered_map>
 
 using namespace omnetpp;
 
 namespace artery
 {
 
-FilterRules::FilterRules(omnetpp::cRNG* rng, const Identity& id) :
-    mRNG(rng), mIdentity(id)
+namespace
+{
+
+using PlanFilter = std::function<bool(cRNG*, const Identity&)>;
+
+bool isInverse(const cXMLElement& cfg)
 {
+    const char* match = cfg.getAttribute("match");
+    return match && std::strcmp(match, "inverse") == 0;
 }
 
-auto FilterRules::createFilterNamePattern(const cXMLElement& name_filter_cfg) const -> Filter
+/**
+ * Map a station onto [0, 1) independent of random number generators
+ *
+ * The mapping relies on the TraCI ID (or the host module's path if there is none),
+ * hence a station gets the same value in every run.
+ */
+double hashShare(const Identity& id, const std::string& salt)
+{
+    const std::string& key = id.traci.empty() ? notNullPtr(id.host)->getFullPath() : id.traci;
+    // 64-bit FNV-1a, stable across platforms unlike std::hash
+    std::uint64_t hash = 14695981039346656037ULL;
+    auto feed = [&hash](const std::string& str) {
+        for (unsigned char c : str) {
+            hash ^= c;
+            hash *= 1099511628211ULL;
+        }
+    };
+    feed(salt);
+    feed(key);
+    return (hash >> 11) * (1.0 / 9007199254740992.0); // 53 bits mantissa
+}
+
+PlanFilter compileNameFilter(const cXMLElement& cfg)
 {
-    const char* name_pattern = name_filter_cfg.getAttribute("pattern");
-    const char* name_match = name_filter_cfg.getAttribute("match");
-    bool inverse = name_match && std::strcmp(name_match, "inverse") == 0;
+    const char* name_pattern = cfg.getAttribute("pattern");
     if (!name_pattern) {
         throw cRuntimeError("Required pattern attribute is missing for name filter");
     }
 
+    const bool inverse = isInverse(cfg);
     std::regex name_regex(name_pattern);
-    Filter name_filter = [this, name_regex, inverse]() {
-            return std::regex_match(mIdentity.traci, name_regex) ^ inverse;
+    return [name_regex, inverse](cRNG*, const Identity& id) {
+        return std::regex_match(id.traci, name_regex) ^ inverse;
     };
-    return name_filter;
 }
 
-auto FilterRules::createFilterPenetrationRate(const cXMLElement& penetration_filter_cfg) const -> Filter
+PlanFilter compilePenetrationFilter(const cXMLElement& cfg)
 {
-    const char* penetration_rate_str = penetration_filter_cfg.getAttribute("rate");
+    const char* penetration_rate_str = cfg.getAttribute("rate");
     if (!penetration_rate_str) {
         throw cRuntimeError("Required rate attribute is missing for penetration filter");
     }
@@ -55,23 +85,30 @@ auto FilterRules::createFilterPenetrationRate(const cXMLElement& penetration_fil
         throw cRuntimeError("Penetration rate is out of range [0.0, 1.0]");
     }
 
-    Filter penetration_filter = [this, penetration_rate]() {
-        return penetration_rate >= uniform(mRNG, 0.0, 1.0);
-    };
-    return penetration_filter;
+    const char* mode = cfg.getAttribute("mode");
+    if (!mode || std::strcmp(mode, "random") == 0) {
+        return [penetration_rate](cRNG* rng, const Identity&) {
+            return penetration_rate >= uniform(rng, 0.0, 1.0);
+        };
+    } else if (std::strcmp(mode, "hash") == 0) {
+        const std::string salt = cfg.getAttribute("salt") ? cfg.getAttribute("salt") : "";
+        return [penetration_rate, salt](cRNG*, const Identity& id) {
+            return hashShare(id, salt) < penetration_rate;
+        };
+    } else {
+        throw cRuntimeError("Unsupported penetration mode: %s", mode);
+    }
 }
 
-auto FilterRules::createFilterTypePattern(const cXMLElement& type_filter_cfg) const -> Filter
+PlanFilter compileTypeFilter(const cXMLElement& cfg)
 {
-    const char* type_pattern = type_filter_cfg.getAttribute("pattern");
-    const char* type_match = type_filter_cfg.getAttribute("match");
-    bool inverse = type_match && std::strcmp(type_match, "inverse") == 0;
+    const char* type_pattern = cfg.getAttribute("pattern");
     if (!type_pattern) {
         throw cRuntimeError("Required pattern attribute is missing for type filter");
     }
 
     double type_rate = 1.0;
-    const char* type_rate_str = type_filter_cfg.getAttribute("rate");
+    const char* type_rate_str = cfg.getAttribute("rate");
     if (type_rate_str) {
         type_rate = boost::lexical_cast<double>(type_rate_str);
     }
@@ -79,46 +116,88 @@ auto FilterRules::createFilterTypePattern(const cXMLElement& type_filter_cfg) co
         throw cRuntimeError("Type penetration rate is out of range [0.0, 1.0]");
     }
 
-    std::regex type_regex(type_pattern);
-    Filter type_filter = [this, type_rate, type_regex, inverse]() {
-        auto rate_predicate = type_rate >= uniform(mRNG, 0.0, 1.0);
-        auto type = notNullPtr(mIdentity.host)->getModuleType()->getFullName();
-        return (std::regex_match(type, type_regex) && rate_predicate) ^ inverse;
+    // only a few module types exist, thus remember their matches
+    const bool inverse = isInverse(cfg);
+    auto type_regex = std::make_shared<std::regex>(type_pattern);
+    auto matches = std::make_shared<std::unordered_map<const cModuleType*, bool>>();
+    return [type_rate, type_regex, matches, inverse](cRNG* rng, const Identity& id) {
+        auto rate_predicate = type_rate >= uniform(rng, 0.0, 1.0);
+        const cModuleType* type = notNullPtr(id.host)->getModuleType();
+        auto match = matches->find(type);
+        if (match == matches->end()) {
+            match = matches->emplace(type, std::regex_match(type->getFullName(), *type_regex)).first;
+        }
+        return (match->second && rate_predicate) ^ inverse;
     };
-    return type_filter;
+}
+
+XmlConfigCache<FilterPlan> filterPlanCache;
+
+} // namespace
+
+FilterRules::FilterRules(omnetpp::cRNG* rng, const Identity& id) :
+    mRNG(rng), mIdentity(id)
+{
+}
+
+auto FilterRules::createFilterNamePattern(const cXMLElement& name_filter_cfg) const -> Filter
+{
+    return std::bind(compileNameFilter(name_filter_cfg), mRNG, std::cref(mIdentity));
+}
+
+auto FilterRules::createFilterPenetrationRate(const cXMLElement& penetration_filter_cfg) const -> Filter
+{
+    return std::bind(compilePenetrationFilter(penetration_filter_cfg), mRNG, std::cref(mIdentity));
+}
+
+auto FilterRules::createFilterTypePattern(const cXMLElement& type_filter_cfg) const -> Filter
+{
+    return std::bind(compileTypeFilter(type_filter_cfg), mRNG, std::cref(mIdentity));
 }
 
 bool FilterRules::applyFilterConfig(const omnetpp::cXMLElement& filter_cfg)
 {
-    std::list<Filter> filters;
+    // compiled filters are shared by all stations using this configuration
+    auto compile = [](const cXMLElement& cfg) { return FilterPlan { cfg }; };
+    return filterPlanCache.get(&filter_cfg, compile).apply(mRNG, mIdentity);
+}
 
-    cXMLElementList name_filter_cfg_list = filter_cfg.getChildrenByTagName("name");
-    for (cXMLElement* cfg : name_filter_cfg_list) {
-        filters.emplace_back(createFilterNamePattern(*cfg));
+FilterPlan::FilterPlan(const omnetpp::cXMLElement& filter_cfg)
+{
+    for (cXMLElement* cfg : filter_cfg.getChildrenByTagName("name")) {
+        mFilters.emplace_back(compileNameFilter(*cfg));
     }
 
-    cXMLElement* penetration_filter_cfg = filter_cfg.getFirstChildWithTag("penetration");
-    if (penetration_filter_cfg) {
-        filters.emplace_back(createFilterPenetrationRate(*penetration_filter_cfg));
+    cXMLElement* penetration_cfg = filter_cfg.getFirstChildWithTag("penetration");
+    if (penetration_cfg) {
+        mFilters.emplace_back(compilePenetrationFilter(*penetration_cfg));
     }
 
-    cXMLElementList type_filter_cfg_list = filter_cfg.getChildrenByTagName("type");
-    for (cXMLElement* cfg : type_filter_cfg_list) {
-        filters.emplace_back(createFilterTypePattern(*cfg));
+    for (cXMLElement* cfg : filter_cfg.getChildrenByTagName("type")) {
+        mFilters.emplace_back(compileTypeFilter(*cfg));
     }
 
-    bool applicable = true;
-    if (!filters.empty()) {
+    if (!mFilters.empty()) {
         const char* filter_operator = filter_cfg.getAttribute("operator") ? filter_cfg.getAttribute("operator") : "or";
-        auto filter_executor = [](const Filter& filter) { return filter(); };
-        if (std::strcmp(filter_operator, "or") == 0) {
-            applicable = std::any_of(filters.begin(), filters.end(), filter_executor);
-        } else if (std::strcmp(filter_operator, "and") == 0) {
-            applicable = std::all_of(filters.begin(), filters.end(), filter_executor);
-        } else {
+        if (std::strcmp(filter_operator, "and") == 0) {
+            mConjunction = true;
+        } else if (std::strcmp(filter_operator, "or") != 0) {
             throw cRuntimeError("Unsupported filter operator: %s", filter_operator);
         }
     }
+}
+
+bool FilterPlan::apply(omnetpp::cRNG* rng, const Identity& id) const
+{
+    bool applicable = true;
+    if (!mFilters.empty()) {
+        auto filter_executor = [rng, &id](const Filter& filter) { return filter(rng, id); };
+        if (mConjunction) {
+            applicable = std::all_of(mFilters.begin(), mFilters.end(), filter_executor);
+        } else {
+            applicable = std::any_of(mFilters.begin(), mFilters.end(), filter_executor);
+        }
+    }
     return applicable;
 }
 
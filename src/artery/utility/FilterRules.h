@@ -8,6 +8,7 @@
 #define FILTERRULES_H_UZBNGKZV
 
 #include <functional>
+#include <vector>
 
 // forward declarations
 namespace omnetpp {
@@ -39,6 +40,29 @@ private:
     const Identity& mIdentity;
 };
 
+/**
+ * FilterPlan is a filter configuration compiled once and applicable to any station
+ *
+ * Evaluation is equivalent to FilterRules::applyFilterConfig, including the order of random draws.
+ */
+class FilterPlan
+{
+public:
+    /**
+     * Create plan without filters, i.e. it applies to every station
+     */
+    FilterPlan() = default;
+    explicit FilterPlan(const omnetpp::cXMLElement& filter_cfg);
+
+    bool apply(omnetpp::cRNG*, const Identity&) const;
+
+private:
+    using Filter = std::function<bool(omnetpp::cRNG*, const Identity&)>;
+
+    std::vector<Filter> mFilters;
+    bool mConjunction = false;
+};
+
 } // namespace artery
 
 #endif /* FILTERRULES_H_UZBNGKZV */
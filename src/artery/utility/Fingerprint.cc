@@ -0,0 +1,17 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/utility/Fingerprint.h"
+#include <omnetpp.h>
+
+namespace artery
+{
+
+// option is looked up by its key in Fingerprint.h, thus it can be used by libraries not linking core
+Register_PerRunConfigOption(CFGID_ARTERY_FINGERPRINT_INGREDIENTS, "artery-fingerprint-ingredients", CFG_STRING, "",
+    "Artery's extra fingerprint ingredients: s=station ids, d=payload data, r=reception power, "
+    "p=position fixes, c=TraCI commands; requires ingredient 'x' in the fingerprint option");
+
+} // namespace artery
@@ -0,0 +1,104 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_FINGERPRINT_H_Z4KD7WQE
+#define ARTERY_FINGERPRINT_H_Z4KD7WQE
+
+#include <omnetpp/cconfiguration.h>
+#include <omnetpp/cconfigurationex.h>
+#include <omnetpp/cenvir.h>
+#include <omnetpp/cfingerprint.h>
+#include <omnetpp/csimulation.h>
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+#include <type_traits>
+
+namespace artery
+{
+namespace fingerprint
+{
+
+/**
+ * Ingredients contributed by Artery to OMNeT++'s fingerprint as extra data.
+ * They are selected by the characters of "artery-fingerprint-ingredients", e.g. "sdrpc" for all of them.
+ * OMNeT++ adds extra data only if its "fingerprint" option includes the ingredient 'x', e.g. "0123abcd/tplx".
+ */
+enum class Ingredient : char
+{
+    StationId = 's', /*< station addresses of sent and received packets */
+    PayloadData = 'd', /*< serialised packets passed to access layer */
+    ReceptionPower = 'r', /*< power of receptions at radio */
+    PositionFix = 'p', /*< position fixes applied to GeoNetworking */
+    TraciCommand = 'c', /*< commands changing SUMO's state */
+};
+
+constexpr const char* configKey = "artery-fingerprint-ingredients";
+
+/**
+ * Get fingerprint calculator if given ingredient is enabled for the current run
+ * \return calculator or nullptr
+ */
+inline omnetpp::cFingerprintCalculator* calculator(Ingredient ingredient)
+{
+    omnetpp::cSimulation* simulation = omnetpp::cSimulation::getActiveSimulation();
+    omnetpp::cFingerprintCalculator* calculator = simulation ? simulation->getFingerprintCalculator() : nullptr;
+    if (!calculator) {
+        return nullptr;
+    }
+
+    // each run gets its own calculator, so ingredients are looked up once per run
+    static const omnetpp::cFingerprintCalculator* cachedCalculator = nullptr;
+    static int cachedRun = -1;
+    static std::string ingredients;
+    const int run = omnetpp::getEnvir()->getConfigEx()->getActiveRunNumber();
+    if (calculator != cachedCalculator || run != cachedRun) {
+        const char* value = omnetpp::getEnvir()->getConfig()->getConfigValue(configKey);
+        ingredients = value ? value : "";
+        cachedCalculator = calculator;
+        cachedRun = run;
+    }
+
+    return ingredients.find(static_cast<char>(ingredient)) != std::string::npos ? calculator : nullptr;
+}
+
+inline bool isEnabled(Ingredient ingredient)
+{
+    return calculator(ingredient) != nullptr;
+}
+
+/**
+ * Add raw bytes tagged by their ingredient to the fingerprint
+ */
+inline void addBytes(Ingredient ingredient, const void* data, std::size_t length)
+{
+    if (omnetpp::cFingerprintCalculator* fingerprint = calculator(ingredient)) {
+        fingerprint->addExtraData(static_cast<char>(ingredient));
+        fingerprint->addExtraData(static_cast<const char*>(data), length);
+    }
+}
+
+/**
+ * Add object representation of trivially copyable values, e.g. numbers, to the fingerprint
+ */
+template<typename... T>
+void add(Ingredient ingredient, const T&... values)
+{
+    static_assert(sizeof...(T) > 0, "nothing to add");
+    if (omnetpp::cFingerprintCalculator* fingerprint = calculator(ingredient)) {
+        fingerprint->addExtraData(static_cast<char>(ingredient));
+        auto add_value = [fingerprint](const auto& value) {
+            using Value = std::decay_t<decltype(value)>;
+            static_assert(std::is_trivially_copyable<Value>::value, "only raw values can be added");
+            fingerprint->addExtraData(reinterpret_cast<const char*>(&value), sizeof(Value));
+        };
+        static_cast<void>(std::initializer_list<int> { (add_value(values), 0)... });
+    }
+}
+
+} // namespace fingerprint
+} // namespace artery
+
+#endif /* ARTERY_FINGERPRINT_H_Z4KD7WQE */
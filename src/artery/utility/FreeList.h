@@ -0,0 +1,112 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_FREELIST_H_M2QZ7HVA
+#define ARTERY_FREELIST_H_M2QZ7HVA
+
+#include <cstddef>
+#include <new>
+
+namespace artery
+{
+
+/**
+ * FreeList recycles memory blocks of a fixed size.
+ *
+ * Blocks released by any code path are kept for later allocations instead of returning them
+ * to the heap, e.g. for objects created by one module and deleted by another one.
+ * Requests for other sizes, e.g. by derived classes, are passed to the global allocator.
+ * Each thread has its own list, thus no locking is required.
+ * Blocks kept by the list of a finished thread are leaked, i.e. not meant for short-lived worker threads.
+ *
+ * \tparam Size block size in bytes
+ */
+template<std::size_t Size>
+class FreeList
+{
+public:
+    static constexpr std::size_t capacity = 4096; /*< blocks kept at most */
+
+    static void* allocate(std::size_t size)
+    {
+        List& list = instance();
+        if (size != Size || !list.head) {
+            return ::operator new(size);
+        }
+
+        Node* node = list.head;
+        list.head = node->next;
+        --list.count;
+        return node;
+    }
+
+    static void deallocate(void* ptr, std::size_t size) noexcept
+    {
+        List& list = instance();
+        if (!ptr) {
+            return;
+        } else if (size != Size || list.count >= capacity) {
+            ::operator delete(ptr);
+        } else {
+            Node* node = static_cast<Node*>(ptr);
+            node->next = list.head;
+            list.head = node;
+            ++list.count;
+        }
+    }
+
+private:
+    struct Node
+    {
+        Node* next;
+    };
+    static_assert(Size >= sizeof(Node), "blocks are too small for free list");
+
+    // kept blocks are not released at exit, some objects might be deleted after the list
+    struct List
+    {
+        Node* head = nullptr;
+        std::size_t count = 0;
+    };
+
+    static List& instance()
+    {
+        static thread_local List list;
+        return list;
+    }
+};
+
+/**
+ * Standard allocator drawing single objects from a FreeList, e.g. for std::allocate_shared
+ */
+template<typename T>
+struct FreeListAllocator
+{
+    using value_type = T;
+
+    FreeListAllocator() = default;
+    template<typename U>
+    FreeListAllocator(const FreeListAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(FreeList<sizeof(T)>::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept
+    {
+        FreeList<sizeof(T)>::deallocate(ptr, n * sizeof(T));
+    }
+};
+
+template<typename T, typename U>
+bool operator==(const FreeListAllocator<T>&, const FreeListAllocator<U>&) { return true; }
+
+template<typename T, typename U>
+bool operator!=(const FreeListAllocator<T>&, const FreeListAllocator<U>&) { return false; }
+
+} // namespace artery
+
+#endif /* ARTERY_FREELIST_H_M2QZ7HVA */
@@ -3,6 +3,7 @@
 #include <boost/math/constants/constants.hpp>
 #include <boost/units/cmath.hpp>
 #include <cassert>
+#include <cmath>
 
 namespace artery
 {
@@ -56,6 +57,17 @@ Position::value_type distance(const Position& a, const Position& b)
     return d * boost::units::si::meter;
 }
 
+Position::value_type distance(const GeoPosition& a, const GeoPosition& b)
+{
+    static const double earthRadius = 6371000.0; // mean radius in metres
+    static const double toRadian = boost::math::constants::pi<double>() / 180.0;
+    using boost::units::degree::degree;
+    const double meanLat = 0.5 * (a.latitude + b.latitude) / degree * toRadian;
+    const double x = (b.longitude - a.longitude) / degree * toRadian * std::cos(meanLat);
+    const double y = (b.latitude - a.latitude) / degree * toRadian;
+    return std::sqrt(x * x + y * y) * earthRadius * boost::units::si::meter;
+}
+
 bool operator==(const Position& a, const Position& b)
 {
     return !(a != b);
@@ -65,6 +65,13 @@ struct GeoPosition
     value_type longitude;
 };
 
+/**
+ * Approximate distance between geodetic positions (equirectangular projection)
+ *
+ * This approximation is sufficiently accurate for distances in a station's vicinity.
+ */
+Position::value_type distance(const GeoPosition&, const GeoPosition&);
+
 
 /**
  * OMNeT++ angle
@@ -16,6 +16,24 @@ using namespace omnetpp;
 
 const simsignal_t IdentityRegistry::updateSignal = cComponent::registerSignal("IdentityUpdated");
 const simsignal_t IdentityRegistry::removeSignal = cComponent::registerSignal("IdentityRemoved");
+constexpr IdentityRegistry::Index IdentityRegistry::npos;
+
+namespace
+{
+
+template<typename MAP, typename KEY>
+void eraseEntry(MAP& map, const KEY& key, IdentityRegistry::Index index)
+{
+    auto range = map.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == index) {
+            map.erase(it);
+            break;
+        }
+    }
+}
+
+} // namespace
 
 void IdentityRegistry::initialize()
 {
@@ -33,20 +51,74 @@ void IdentityRegistry::receiveSignal(cComponent*, simsignal_t signal, cObject* o
 {
     if (signal == updateSignal) {
         auto identity = check_and_cast<Identity*>(obj);
-        auto& traci_index = mIdentities.get<traci>();
-        auto found = traci_index.find(identity->traci);
-        if (found != traci_index.end()) {
-            mIdentities.replace(found, *identity);
+        Index index = findIndex(traci {}, identity->traci);
+        if (index != npos) {
+            removeKeys(index);
+        } else if (!mFreeSlots.empty()) {
+            index = mFreeSlots.back();
+            mFreeSlots.pop_back();
         } else {
-            mIdentities.insert(*identity);
+            index = mSlots.size();
+            mSlots.emplace_back();
         }
+
+        mSlots[index].identity = *identity;
+        mSlots[index].used = true;
+        insertKeys(index);
     } else if (signal == removeSignal) {
         auto identity = dynamic_cast<Identity*>(obj);
         if (identity) {
-            auto& traci_index = mIdentities.get<traci>();
-            traci_index.erase(identity->traci);
+            const Index index = findIndex(traci {}, identity->traci);
+            if (index != npos) {
+                removeKeys(index);
+                mSlots[index] = Slot {};
+                mFreeSlots.push_back(index);
+            }
         }
     }
 }
 
+const Identity* IdentityRegistry::find(Index index) const
+{
+    return index < mSlots.size() && mSlots[index].used ? &mSlots[index].identity : nullptr;
+}
+
+auto IdentityRegistry::findIndex(traci, const std::string& id) const -> Index
+{
+    auto found = mTraciIndex.find(id);
+    return found != mTraciIndex.end() ? found->second : npos;
+}
+
+auto IdentityRegistry::findIndex(application, uint32_t id) const -> Index
+{
+    auto found = mApplicationIndex.find(id);
+    return found != mApplicationIndex.end() ? found->second : npos;
+}
+
+auto IdentityRegistry::findIndex(geonet, const vanetza::MacAddress& mid) const -> Index
+{
+    auto found = mGeonetIndex.find(mid);
+    return found != mGeonetIndex.end() ? found->second : npos;
+}
+
+void IdentityRegistry::insertKeys(Index index)
+{
+    const Identity& identity = mSlots[index].identity;
+    mTraciIndex.emplace(identity.traci, index);
+    mApplicationIndex.emplace(identity.application, index);
+    for (const auto& address : identity.geonet) {
+        mGeonetIndex.emplace(address.second.mid(), index);
+    }
+}
+
+void IdentityRegistry::removeKeys(Index index)
+{
+    const Identity& identity = mSlots[index].identity;
+    mTraciIndex.erase(identity.traci);
+    eraseEntry(mApplicationIndex, identity.application, index);
+    for (const auto& address : identity.geonet) {
+        eraseEntry(mGeonetIndex, address.second.mid(), index);
+    }
+}
+
 } // namespace artery
@@ -10,17 +10,28 @@
 #include "artery/utility/Identity.h"
 #include <omnetpp/clistener.h>
 #include <omnetpp/csimplemodule.h>
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/member.hpp>
-#include <boost/multi_index/ordered_index.hpp>
 #include <boost/optional/optional.hpp>
+#include <vanetza/net/mac_address.hpp>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace artery
 {
 
+/**
+ * IdentityRegistry keeps track of all stations' identities
+ *
+ * Each registered station is assigned a dense index, which stays the same while the
+ * station is registered. Indices of removed stations get reused, thus per-station data
+ * can be stored in vectors of size getIndexBound().
+ */
 class IdentityRegistry : public omnetpp::cSimpleModule, public omnetpp::cListener
 {
 public:
+    using Index = std::size_t;
+
     static const omnetpp::simsignal_t updateSignal;
     static const omnetpp::simsignal_t removeSignal;
 
@@ -28,31 +39,66 @@ public:
     void finish() override;
     void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, omnetpp::cObject*, omnetpp::cObject*) override;
 
+    struct traci {};
+    struct application {};
+    struct geonet {}; /*< by MAC address (MID) of any GeoNetworking address */
+
     template<typename TAG, typename VALUE>
-    boost::optional<Identity> lookup(const VALUE& value)
+    boost::optional<Identity> lookup(const VALUE& value) const
     {
         boost::optional<Identity> result;
-        auto& index = mIdentities.get<TAG>();
-        auto found = index.find(value);
-        if (found != index.end()) {
-            result = *found;
+        const Identity* identity = find(findIndex(TAG {}, value));
+        if (identity) {
+            result = *identity;
         }
         return result;
     }
 
-    struct traci {};
-    struct application {};
+    template<typename TAG, typename VALUE>
+    boost::optional<Index> lookupIndex(const VALUE& value) const
+    {
+        boost::optional<Index> result;
+        const Index index = findIndex(TAG {}, value);
+        if (index != npos) {
+            result = index;
+        }
+        return result;
+    }
+
+    /**
+     * Get identity by station index
+     * \param index station index
+     * \return identity or nullptr if no station is registered at index
+     */
+    const Identity* find(Index index) const;
+
+    /**
+     * Get upper bound of assigned station indices
+     * \return all station indices are less than this bound
+     */
+    Index getIndexBound() const { return mSlots.size(); }
 
 private:
-    boost::multi_index_container<Identity,
-        boost::multi_index::indexed_by<
-            boost::multi_index::ordered_unique<
-                boost::multi_index::tag<traci>,
-                boost::multi_index::member<Identity, std::string, &Identity::traci>>,
-            boost::multi_index::ordered_non_unique<
-                boost::multi_index::tag<application>,
-                boost::multi_index::member<Identity, uint32_t, &Identity::application>>
-        >> mIdentities;
+    static constexpr Index npos = static_cast<Index>(-1);
+
+    struct Slot
+    {
+        Identity identity;
+        bool used = false;
+    };
+
+    Index findIndex(traci, const std::string&) const;
+    Index findIndex(application, uint32_t) const;
+    Index findIndex(geonet, const vanetza::MacAddress&) const;
+
+    void insertKeys(Index);
+    void removeKeys(Index);
+
+    std::vector<Slot> mSlots;
+    std::vector<Index> mFreeSlots;
+    std::unordered_map<std::string, Index> mTraciIndex;
+    std::unordered_multimap<uint32_t, Index> mApplicationIndex;
+    std::unordered_multimap<vanetza::MacAddress, Index> mGeonetIndex;
 };
 
 } // namespace artery
@@ -0,0 +1,196 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/utility/KpiAggregator.h"
+#include "artery/application/CaObject.h"
+#include "artery/networking/PositionProvider.h"
+#include "artery/nic/RadioDriverBase.h"
+#include <omnetpp/cmodelchange.h>
+#include <omnetpp/cmodule.h>
+#include <algorithm>
+#include <cmath>
+
+namespace artery
+{
+
+Define_Module(KpiAggregator)
+
+namespace
+{
+
+const omnetpp::simsignal_t scSignalCamReceived = omnetpp::cComponent::registerSignal("CamReceived");
+const omnetpp::simsignal_t scSignalCamSent = omnetpp::cComponent::registerSignal("CamSent");
+const omnetpp::simsignal_t scSignalChannelLoad = omnetpp::cComponent::registerSignal("ChannelLoad");
+
+// histograms count integers: time in microseconds and channel busy ratio in 1/10000
+constexpr double scTimeScale = 1e6;
+constexpr double scRatioScale = 1e4;
+
+std::uint64_t toMicroseconds(const omnetpp::SimTime& time)
+{
+    return time.inUnit(omnetpp::SIMTIME_US);
+}
+
+} // namespace
+
+void KpiAggregator::initialize()
+{
+    mGridCellSize = par("gridCellSize");
+    if (mGridCellSize < 0.0) {
+        throw omnetpp::cRuntimeError("gridCellSize must not be negative");
+    }
+
+    omnetpp::cModule* system = getSystemModule();
+    if (par("camSent")) {
+        system->subscribe(scSignalCamSent, this);
+    }
+    if (par("camReceived")) {
+        system->subscribe(scSignalCamReceived, this);
+    }
+    if (par("channelLoad")) {
+        system->subscribe(scSignalChannelLoad, this);
+    }
+    system->subscribe(omnetpp::PRE_MODEL_CHANGE, this);
+}
+
+void KpiAggregator::finish()
+{
+    omnetpp::cModule* system = getSystemModule();
+    system->unsubscribe(scSignalCamSent, this);
+    system->unsubscribe(scSignalCamReceived, this);
+    system->unsubscribe(scSignalChannelLoad, this);
+    system->unsubscribe(omnetpp::PRE_MODEL_CHANGE, this);
+
+    for (const auto& histogram : mHistograms) {
+        recordGroup(histogram.first, histogram.second);
+    }
+}
+
+void KpiAggregator::receiveSignal(omnetpp::cComponent* source, omnetpp::simsignal_t signal, double value, omnetpp::cObject*)
+{
+    // INET radios emit ChannelLoad besides their radio driver, count each sample only once
+    if (signal == scSignalChannelLoad && dynamic_cast<const RadioDriverBase*>(source)) {
+        const double ratio = std::max(0.0, value);
+        mHistograms[group(findNode(source), Kpi::ChannelBusyRatio)].record(std::lround(ratio * scRatioScale));
+    }
+}
+
+void KpiAggregator::receiveSignal(omnetpp::cComponent* source, omnetpp::simsignal_t signal, omnetpp::cObject* obj, omnetpp::cObject*)
+{
+    const omnetpp::SimTime now = omnetpp::simTime();
+    if (signal == scSignalCamSent) {
+        const omnetpp::cModule* node = findNode(source);
+        auto ca = omnetpp::check_and_cast<const CaObject*>(obj);
+        mStationIds[node->getId()] = ca->asn1()->header.stationID;
+        auto inserted = mLastCamSent.emplace(node->getId(), now);
+        if (!inserted.second) {
+            mHistograms[group(node, Kpi::CamInterval)].record(toMicroseconds(now - inserted.first->second));
+            inserted.first->second = now;
+        }
+    } else if (signal == scSignalCamReceived) {
+        auto ca = omnetpp::check_and_cast<const CaObject*>(obj);
+        const std::uint32_t sender = ca->asn1()->header.stationID;
+        const omnetpp::cModule* node = findNode(source);
+        auto inserted = mLastCamReceived.emplace(std::make_pair(node->getId(), sender), now);
+        if (!inserted.second) {
+            mHistograms[group(node, Kpi::CamInterReception)].record(toMicroseconds(now - inserted.first->second));
+            inserted.first->second = now;
+        }
+    } else if (signal == omnetpp::PRE_MODEL_CHANGE) {
+        auto notification = dynamic_cast<const omnetpp::cPreModuleDeleteNotification*>(obj);
+        if (notification && notification->module->getParentModule() == getSystemModule()) {
+            removeNode(notification->module);
+        }
+    }
+}
+
+void KpiAggregator::removeNode(const omnetpp::cModule* node)
+{
+    const int id = node->getId();
+    mLastCamSent.erase(id);
+    mLastCamReceived.erase(mLastCamReceived.lower_bound(std::make_pair(id, std::uint32_t(0))),
+        mLastCamReceived.lower_bound(std::make_pair(id + 1, std::uint32_t(0))));
+
+    // receivers forget the departed node as sender
+    auto station = mStationIds.find(id);
+    if (station != mStationIds.end()) {
+        const std::uint32_t sender = station->second;
+        mStationIds.erase(station);
+        for (auto it = mLastCamReceived.begin(); it != mLastCamReceived.end();) {
+            if (it->first.second == sender) {
+                it = mLastCamReceived.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+const omnetpp::cModule* KpiAggregator::findNode(const omnetpp::cComponent* component) const
+{
+    // node is the top-level module below the network enclosing the component
+    const omnetpp::cModule* node = dynamic_cast<const omnetpp::cModule*>(component);
+    if (!node) {
+        node = component->getParentModule();
+    }
+    while (node->getParentModule() && node->getParentModule()->getParentModule()) {
+        node = node->getParentModule();
+    }
+    return node;
+}
+
+KpiAggregator::Group KpiAggregator::group(const omnetpp::cModule* node, Kpi kpi) const
+{
+    long x = 0;
+    long y = 0;
+    if (mGridCellSize > 0.0) {
+        for (omnetpp::cModule::SubmoduleIterator it(node); !it.end(); ++it) {
+            if (auto provider = dynamic_cast<const PositionProvider*>(*it)) {
+                const Position position = provider->getCartesianPosition();
+                x = std::floor(position.x.value() / mGridCellSize);
+                y = std::floor(position.y.value() / mGridCellSize);
+                break;
+            }
+        }
+    }
+    return Group { node->getNedTypeName(), x, y, kpi };
+}
+
+void KpiAggregator::recordGroup(const Group& group, const LogLinearHistogram& histogram)
+{
+    std::string name = std::get<0>(group);
+    if (mGridCellSize > 0.0) {
+        name += " [" + std::to_string(std::get<1>(group)) + "," + std::to_string(std::get<2>(group)) + "]";
+    }
+
+    double scale = 1.0;
+    const char* unit = nullptr;
+    switch (std::get<3>(group)) {
+        case Kpi::CamInterval:
+            name += " camInterval";
+            scale = scTimeScale;
+            unit = "s";
+            break;
+        case Kpi::CamInterReception:
+            name += " camInterReception";
+            scale = scTimeScale;
+            unit = "s";
+            break;
+        case Kpi::ChannelBusyRatio:
+            name += " channelBusyRatio";
+            scale = scRatioScale;
+            break;
+    }
+
+    recordScalar((name + " count").c_str(), histogram.count());
+    recordScalar((name + " mean").c_str(), histogram.mean() / scale, unit);
+    recordScalar((name + " max").c_str(), histogram.max() / scale, unit);
+    for (double percentile : { 50.0, 90.0, 99.0 }) {
+        const std::string suffix = " p" + std::to_string(static_cast<int>(percentile));
+        recordScalar((name + suffix).c_str(), histogram.percentile(percentile) / scale, unit);
+    }
+}
+
+} // namespace artery
@@ -0,0 +1,59 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_KPIAGGREGATOR_H_R6PW2LXM
+#define ARTERY_KPIAGGREGATOR_H_R6PW2LXM
+
+#include "artery/utility/LogLinearHistogram.h"
+#include <omnetpp/clistener.h>
+#include <omnetpp/csimplemodule.h>
+#include <omnetpp/simtime.h>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace artery
+{
+
+/**
+ * KpiAggregator summarises CamSent, CamReceived and ChannelLoad signals of all stations.
+ *
+ * Samples are counted in histograms per station type, i.e. the NED type of the emitting node,
+ * and optionally per cell of a square grid on the Cartesian plane.
+ * Only summary scalars (count, mean, max and some percentiles) are recorded at finish.
+ * Channel load is taken from radio drivers only, some radios emit the same signal as well.
+ * Interval bookkeeping of a station is dropped when its node module is deleted.
+ */
+class KpiAggregator : public omnetpp::cSimpleModule, public omnetpp::cListener
+{
+protected:
+    void initialize() override;
+    void finish() override;
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, double, omnetpp::cObject*) override;
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, omnetpp::cObject*, omnetpp::cObject*) override;
+
+private:
+    enum class Kpi { CamInterval, CamInterReception, ChannelBusyRatio };
+
+    // station type, grid cell (x, y) and KPI
+    using Group = std::tuple<std::string, long, long, Kpi>;
+
+    const omnetpp::cModule* findNode(const omnetpp::cComponent*) const;
+    Group group(const omnetpp::cModule* node, Kpi) const;
+    void removeNode(const omnetpp::cModule* node);
+    void recordGroup(const Group&, const LogLinearHistogram&);
+
+    double mGridCellSize = 0.0;
+    std::map<Group, LogLinearHistogram> mHistograms;
+    std::map<int, omnetpp::SimTime> mLastCamSent; /*< per node id */
+    std::map<std::pair<int, std::uint32_t>, omnetpp::SimTime> mLastCamReceived; /*< per node id and sender */
+    std::map<int, std::uint32_t> mStationIds; /*< station id of sending nodes per node id */
+};
+
+} // namespace artery
+
+#endif /* ARTERY_KPIAGGREGATOR_H_R6PW2LXM */
@@ -0,0 +1,101 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_LOGLINEARHISTOGRAM_H_W8DK3QFZ
+#define ARTERY_LOGLINEARHISTOGRAM_H_W8DK3QFZ
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace artery
+{
+
+/**
+ * LogLinearHistogram counts values in log-linear buckets like HdrHistogram
+ *
+ * Values below 32 are counted exactly, larger values within a relative error of about 6%.
+ * Recording is constant time and memory grows only logarithmically with the largest value.
+ */
+class LogLinearHistogram
+{
+public:
+    void record(std::uint64_t value)
+    {
+        const std::size_t index = indexOf(value);
+        if (index >= mCounts.size()) {
+            mCounts.resize(index + 1, 0);
+        }
+        ++mCounts[index];
+        ++mCount;
+        mSum += value;
+        if (value > mMax) {
+            mMax = value;
+        }
+    }
+
+    std::uint64_t count() const { return mCount; }
+    std::uint64_t max() const { return mMax; }
+    double mean() const { return mCount > 0 ? static_cast<double>(mSum) / mCount : 0.0; }
+
+    /**
+     * Get highest value equivalent to the value at given percentile
+     * \param percentile in range [0, 100]
+     * \return upper bound of bucket containing the percentile, 0 if nothing has been recorded
+     */
+    std::uint64_t percentile(double percentile) const
+    {
+        const double threshold = percentile / 100.0 * mCount;
+        std::uint64_t cumulative = 0;
+        for (std::size_t index = 0; index < mCounts.size(); ++index) {
+            cumulative += mCounts[index];
+            if (cumulative > 0 && cumulative >= threshold) {
+                const std::uint64_t upper = upperBound(index);
+                return upper < mMax ? upper : mMax;
+            }
+        }
+        return mMax;
+    }
+
+private:
+    static constexpr unsigned subBits = 5;
+    static constexpr std::uint64_t subCount = 1 << subBits;
+    static constexpr std::uint64_t halfCount = subCount / 2;
+
+    // buckets [0, 32) are exact, then 16 buckets per power of two
+    static std::size_t indexOf(std::uint64_t value)
+    {
+        if (value < subCount) {
+            return value;
+        }
+
+        unsigned msb = 0;
+        for (std::uint64_t v = value; v > 1; v >>= 1) {
+            ++msb;
+        }
+        const unsigned shift = msb - (subBits - 1);
+        return subCount + (shift - 1) * halfCount + ((value >> shift) - halfCount);
+    }
+
+    static std::uint64_t upperBound(std::size_t index)
+    {
+        if (index < subCount) {
+            return index;
+        }
+
+        const unsigned shift = (index - subCount) / halfCount + 1;
+        const std::uint64_t sub = (index - subCount) % halfCount + halfCount;
+        return ((sub + 1) << shift) - 1;
+    }
+
+    std::vector<std::uint64_t> mCounts;
+    std::uint64_t mCount = 0;
+    std::uint64_t mSum = 0;
+    std::uint64_t mMax = 0;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_LOGLINEARHISTOGRAM_H_W8DK3QFZ */
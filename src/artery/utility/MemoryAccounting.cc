@@ -0,0 +1,75 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/utility/MemoryAccounting.h"
+#include "artery/utility/MemoryFootprint.h"
+#include <omnetpp/cmodule.h>
+
+namespace artery
+{
+
+Define_Module(MemoryAccounting)
+
+const omnetpp::simsignal_t MemoryAccounting::sampleSignal = omnetpp::cComponent::registerSignal("memoryAccounting.sample");
+
+void MemoryAccounting::collect(const omnetpp::cModule* module, Totals& totals)
+{
+    if (auto footprint = dynamic_cast<const MemoryFootprint*>(module)) {
+        Total& total = totals[module->getNedTypeName()];
+        total.bytes += footprint->estimateMemoryFootprint();
+        ++total.modules;
+    }
+
+    for (omnetpp::cModule::SubmoduleIterator it(module); !it.end(); ++it) {
+        collect(*it, totals);
+    }
+}
+
+void MemoryAccounting::initialize()
+{
+    getSystemModule()->subscribe(sampleSignal, this);
+}
+
+void MemoryAccounting::finish()
+{
+    getSystemModule()->unsubscribe(sampleSignal, this);
+
+    Totals totals;
+    collect(getSystemModule(), totals);
+    for (const auto& total : totals) {
+        recordScalar((total.first + " bytes").c_str(), total.second.bytes, "B");
+        recordScalar((total.first + " modules").c_str(), total.second.modules);
+    }
+}
+
+void MemoryAccounting::receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t signal, omnetpp::cObject*, omnetpp::cObject*)
+{
+    if (signal == sampleSignal) {
+        sample();
+    }
+}
+
+void MemoryAccounting::receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t signal, bool, omnetpp::cObject*)
+{
+    if (signal == sampleSignal) {
+        sample();
+    }
+}
+
+void MemoryAccounting::sample()
+{
+    Enter_Method_Silent();
+    Totals totals;
+    collect(getSystemModule(), totals);
+    for (const auto& total : totals) {
+        auto& vector = mVectors[total.first];
+        if (!vector) {
+            vector.reset(new omnetpp::cOutVector((total.first + " bytes").c_str()));
+        }
+        vector->record(static_cast<double>(total.second.bytes));
+    }
+}
+
+} // namespace artery
@@ -0,0 +1,60 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_MEMORYACCOUNTING_H_F8JY3NQB
+#define ARTERY_MEMORYACCOUNTING_H_F8JY3NQB
+
+#include <omnetpp/clistener.h>
+#include <omnetpp/coutvector.h>
+#include <omnetpp/csimplemodule.h>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace artery
+{
+
+/**
+ * MemoryAccounting sums up memory estimates of all modules implementing MemoryFootprint.
+ *
+ * Estimates are aggregated per module type and recorded as scalars at finish.
+ * Additional samples are recorded as vectors whenever sampleSignal is emitted at the system module.
+ */
+class MemoryAccounting : public omnetpp::cSimpleModule, public omnetpp::cListener
+{
+public:
+    static const omnetpp::simsignal_t sampleSignal;
+
+    struct Total
+    {
+        std::size_t bytes = 0;
+        std::size_t modules = 0;
+    };
+
+    using Totals = std::map<std::string, Total>;
+
+    /**
+     * Collect estimates of all modules below given module
+     * \param module root of module tree
+     * \param totals estimates are added per module type
+     */
+    static void collect(const omnetpp::cModule* module, Totals& totals);
+
+protected:
+    void initialize() override;
+    void finish() override;
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, omnetpp::cObject*, omnetpp::cObject*) override;
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, bool, omnetpp::cObject*) override;
+
+private:
+    void sample();
+
+    std::map<std::string, std::unique_ptr<omnetpp::cOutVector>> mVectors;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_MEMORYACCOUNTING_H_F8JY3NQB */
@@ -0,0 +1,88 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_MEMORYFOOTPRINT_H_R4CZ9WLE
+#define ARTERY_MEMORYFOOTPRINT_H_R4CZ9WLE
+
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <queue>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace artery
+{
+
+/**
+ * MemoryFootprint is implemented by modules reporting an estimate of their memory usage.
+ *
+ * Estimates cover the module's object and the containers it owns, i.e. size() * sizeof(element)
+ * plus typical per-node overhead of node-based containers. Objects shared among several modules,
+ * e.g. decoded messages, are not accounted to avoid counting them once per holder.
+ * See MemoryAccounting module for recording of these estimates.
+ */
+class MemoryFootprint
+{
+public:
+    /**
+     * Estimate bytes used by this module
+     */
+    virtual std::size_t estimateMemoryFootprint() const = 0;
+
+protected:
+    ~MemoryFootprint() = default;
+};
+
+namespace memory
+{
+
+template<typename T, typename A>
+std::size_t bytes(const std::vector<T, A>& v)
+{
+    return v.capacity() * sizeof(T);
+}
+
+template<typename T, typename A>
+std::size_t bytes(const std::deque<T, A>& d)
+{
+    return d.size() * sizeof(T);
+}
+
+template<typename T, typename C, typename P>
+std::size_t bytes(const std::priority_queue<T, C, P>& q)
+{
+    // underlying container is hidden, thus its capacity is unknown
+    return q.size() * sizeof(T);
+}
+
+template<typename K, typename C, typename A>
+std::size_t bytes(const std::set<K, C, A>& s)
+{
+    // red-black tree node with three links and colour
+    return s.size() * (sizeof(K) + 4 * sizeof(void*));
+}
+
+template<typename K, typename V, typename C, typename A>
+std::size_t bytes(const std::map<K, V, C, A>& m)
+{
+    // red-black tree node with three links and colour
+    using value_type = typename std::map<K, V, C, A>::value_type;
+    return m.size() * (sizeof(value_type) + 4 * sizeof(void*));
+}
+
+template<typename K, typename V, typename H, typename E, typename A>
+std::size_t bytes(const std::unordered_map<K, V, H, E, A>& m)
+{
+    // singly linked node with cached hash plus bucket array
+    using value_type = typename std::unordered_map<K, V, H, E, A>::value_type;
+    return m.size() * (sizeof(value_type) + 2 * sizeof(void*)) + m.bucket_count() * sizeof(void*);
+}
+
+} // namespace memory
+} // namespace artery
+
+#endif /* ARTERY_MEMORYFOOTPRINT_H_R4CZ9WLE */
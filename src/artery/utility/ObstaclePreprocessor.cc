@@ -0,0 +1,201 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/utility/ObstaclePreprocessor.h"
+#include <boost/geometry/index/rtree.hpp>
+#include <omnetpp/ccomponent.h>
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace artery
+{
+
+namespace bg = boost::geometry;
+
+namespace
+{
+
+// same orientation and closure as registered for outlines
+using Polygon = bg::model::polygon<Position, true, false>;
+using MultiPolygon = bg::model::multi_polygon<Polygon>;
+
+std::size_t countVertices(const std::vector<ObstacleOutline>& obstacles)
+{
+    std::size_t vertices = 0;
+    for (const ObstacleOutline& obstacle : obstacles) {
+        vertices += obstacle.outline.size();
+    }
+    return vertices;
+}
+
+class DisjointSets
+{
+public:
+    explicit DisjointSets(std::size_t size) : mParent(size)
+    {
+        std::iota(mParent.begin(), mParent.end(), 0);
+    }
+
+    std::size_t find(std::size_t i)
+    {
+        while (mParent[i] != i) {
+            i = mParent[i] = mParent[mParent[i]];
+        }
+        return i;
+    }
+
+    // lower index becomes root, i.e. roots are first members of their sets
+    void unite(std::size_t a, std::size_t b)
+    {
+        a = find(a);
+        b = find(b);
+        if (a < b) {
+            mParent[b] = a;
+        } else if (b < a) {
+            mParent[a] = b;
+        }
+    }
+
+private:
+    std::vector<std::size_t> mParent;
+};
+
+} // namespace
+
+void ObstaclePreprocessor::Statistics::recordScalars(omnetpp::cComponent& component) const
+{
+    component.recordScalar("obstaclesBeforePreprocessing", obstaclesBefore);
+    component.recordScalar("obstaclesAfterPreprocessing", obstaclesAfter);
+    component.recordScalar("obstacleVerticesBeforePreprocessing", verticesBefore);
+    component.recordScalar("obstacleVerticesAfterPreprocessing", verticesAfter);
+    component.recordScalar("obstacleEdgesBeforePreprocessing", edgesBefore);
+    component.recordScalar("obstacleEdgesAfterPreprocessing", edgesAfter);
+}
+
+std::ostream& operator<<(std::ostream& os, const ObstaclePreprocessor::Statistics& stats)
+{
+    os << stats.obstaclesBefore << " obstacles with " << stats.verticesBefore << " vertices and "
+        << stats.edgesBefore << " edges reduced to " << stats.obstaclesAfter << " obstacles with "
+        << stats.verticesAfter << " vertices and " << stats.edgesAfter << " edges";
+    return os;
+}
+
+ObstaclePreprocessor::ObstaclePreprocessor(double tolerance, bool merge) :
+    mTolerance(std::max(0.0, tolerance)), mMerge(merge)
+{
+}
+
+ObstaclePreprocessor::Statistics ObstaclePreprocessor::process(std::vector<ObstacleOutline>& obstacles) const
+{
+    Statistics stats;
+    stats.obstaclesBefore = obstacles.size();
+    // outlines are open rings: each vertex starts one edge
+    stats.verticesBefore = stats.edgesBefore = countVertices(obstacles);
+
+    if (mMerge) {
+        merge(obstacles);
+    }
+
+    // merging leaves collinear vertices where walls met, hence simplify merged outlines in any case
+    if (mTolerance > 0.0 || mMerge) {
+        for (ObstacleOutline& obstacle : obstacles) {
+            simplify(obstacle.outline);
+        }
+    }
+
+    stats.obstaclesAfter = obstacles.size();
+    stats.verticesAfter = stats.edgesAfter = countVertices(obstacles);
+    return stats;
+}
+
+void ObstaclePreprocessor::merge(std::vector<ObstacleOutline>& obstacles) const
+{
+    using RtreeValue = std::pair<geometry::Box, std::size_t>;
+    using Rtree = bg::index::rtree<RtreeValue, bg::index::rstar<16>>;
+
+    std::vector<RtreeValue> envelopes;
+    for (std::size_t i = 0; i < obstacles.size(); ++i) {
+        if (obstacles[i].outline.size() >= 3 && bg::is_valid(obstacles[i].outline)) {
+            envelopes.emplace_back(bg::return_envelope<geometry::Box>(obstacles[i].outline), i);
+        }
+    }
+    const Rtree rtree { envelopes.begin(), envelopes.end() };
+
+    DisjointSets sets(obstacles.size());
+    for (const RtreeValue& envelope : envelopes) {
+        const std::size_t i = envelope.second;
+        for (auto it = rtree.qbegin(bg::index::intersects(envelope.first)); it != rtree.qend(); ++it) {
+            const std::size_t j = it->second;
+            if (j > i && obstacles[i].type == obstacles[j].type && sets.find(i) != sets.find(j) &&
+                    bg::intersects(obstacles[i].outline, obstacles[j].outline)) {
+                sets.unite(i, j);
+            }
+        }
+    }
+
+    std::vector<std::vector<std::size_t>> groups(obstacles.size());
+    for (std::size_t i = 0; i < obstacles.size(); ++i) {
+        groups[sets.find(i)].push_back(i);
+    }
+
+    std::vector<ObstacleOutline> merged;
+    merged.reserve(obstacles.size());
+    for (std::size_t i = 0; i < obstacles.size(); ++i) {
+        std::vector<std::size_t>& pending = groups[i];
+        if (pending.size() == 1) {
+            merged.push_back(std::move(obstacles[i]));
+            continue;
+        }
+
+        // members join the first outline they form a single polygon without holes with
+        while (!pending.empty()) {
+            ObstacleOutline& first = obstacles[pending.front()];
+            Polygon accumulated;
+            accumulated.outer().assign(first.outline.begin(), first.outline.end());
+            pending.erase(pending.begin());
+
+            bool progress = true;
+            while (progress) {
+                progress = false;
+                for (auto member = pending.begin(); member != pending.end();) {
+                    MultiPolygon result;
+                    bg::union_(accumulated, obstacles[*member].outline, result);
+                    if (result.size() == 1 && result.front().inners().empty()) {
+                        accumulated = std::move(result.front());
+                        member = pending.erase(member);
+                        progress = true;
+                    } else {
+                        ++member;
+                    }
+                }
+            }
+
+            first.outline.assign(accumulated.outer().begin(), accumulated.outer().end());
+            merged.push_back(std::move(first));
+        }
+    }
+
+    obstacles = std::move(merged);
+}
+
+void ObstaclePreprocessor::simplify(std::vector<Position>& outline) const
+{
+    if (outline.size() <= 3 || !bg::is_valid(outline)) {
+        return;
+    }
+
+    std::vector<Position> simplified;
+    bg::simplify(outline, simplified, mTolerance);
+    if (simplified.size() > 1 && simplified.front() == simplified.back()) {
+        // some Boost versions close simplified rings regardless of their closure trait
+        simplified.pop_back();
+    }
+    if (simplified.size() >= 3 && simplified.size() < outline.size() && bg::is_valid(simplified)) {
+        outline = std::move(simplified);
+    }
+}
+
+} // namespace artery
@@ -0,0 +1,81 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_OBSTACLEPREPROCESSOR_H_T2HW7QZN
+#define ARTERY_OBSTACLEPREPROCESSOR_H_T2HW7QZN
+
+#include "artery/utility/Geometry.h"
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// forward declaration
+namespace omnetpp { class cComponent; }
+
+namespace artery
+{
+
+struct ObstacleOutline
+{
+    std::string id;
+    std::string type;
+    std::vector<Position> outline;
+};
+
+/**
+ * ObstaclePreprocessor reduces obstacle outlines once before they are indexed.
+ *
+ * Footprints of the same type touching or overlapping each other are merged into one outline if their
+ * union is a single polygon without holes, i.e. walls shared by adjacent buildings vanish.
+ * Courtyards are thus never filled. A merged obstacle keeps identifier and position of its first part.
+ * Outlines are then simplified by Douglas-Peucker within a tolerance, removing (nearly) collinear vertices.
+ * A simplified outline is only used if it is still a valid polygon.
+ */
+class ObstaclePreprocessor
+{
+public:
+    struct Statistics
+    {
+        std::size_t obstaclesBefore = 0;
+        std::size_t obstaclesAfter = 0;
+        std::size_t verticesBefore = 0;
+        std::size_t verticesAfter = 0;
+        std::size_t edgesBefore = 0;
+        std::size_t edgesAfter = 0;
+
+        void recordScalars(omnetpp::cComponent&) const;
+    };
+
+    /**
+     * \param tolerance maximum deviation of simplified outlines in meters, zero disables simplification
+     * \param merge merge touching footprints
+     */
+    ObstaclePreprocessor(double tolerance, bool merge);
+
+    bool isEnabled() const { return mTolerance > 0.0 || mMerge; }
+    double getTolerance() const { return mTolerance; }
+    bool isMerging() const { return mMerge; }
+
+    /**
+     * Merge and simplify outlines in place
+     * \param obstacles outlines with corrected point order, invalid polygons are passed unchanged
+     * \return vertex and edge counts before and after
+     */
+    Statistics process(std::vector<ObstacleOutline>& obstacles) const;
+
+private:
+    void merge(std::vector<ObstacleOutline>&) const;
+    void simplify(std::vector<Position>&) const;
+
+    double mTolerance;
+    bool mMerge;
+};
+
+std::ostream& operator<<(std::ostream&, const ObstaclePreprocessor::Statistics&);
+
+} // namespace artery
+
+#endif /* ARTERY_OBSTACLEPREPROCESSOR_H_T2HW7QZN */
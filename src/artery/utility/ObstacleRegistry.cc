@@ -0,0 +1,360 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/utility/ObstacleRegistry.h"
+#include "artery/traci/Cast.h"
+#include "traci/API.h"
+#include <omnetpp/cconfiguration.h>
+#include <omnetpp/cenvir.h>
+#include <boost/algorithm/string.hpp>
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/register/linestring.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <fstream>
+
+namespace { using LineOfSight = std::array<artery::Position, 2>; }
+BOOST_GEOMETRY_REGISTER_LINESTRING(LineOfSight)
+
+namespace artery
+{
+
+Define_Module(ObstacleRegistry)
+
+using namespace omnetpp;
+namespace bg = boost::geometry;
+
+namespace {
+    const simsignal_t traciCloseSignal = cComponent::registerSignal("traci.close");
+    const char sCacheMagic[8] = { 'A', 'R', 'T', 'O', 'B', 'S', 'T', 'C' };
+    const std::uint32_t sCacheVersion = 1;
+    const std::size_t sCacheShapeSamples = 16; /*< polygons whose shape and type contribute to cache key */
+
+    // FNV-1a hash, stable across platforms and runs
+    class Fnv1a
+    {
+    public:
+        void add(const void* data, std::size_t length)
+        {
+            auto bytes = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < length; ++i) {
+                mHash ^= bytes[i];
+                mHash *= 0x100000001b3ULL;
+            }
+        }
+
+        void add(const std::string& str)
+        {
+            const std::uint64_t length = str.size();
+            add(&length, sizeof(length));
+            add(str.data(), str.size());
+        }
+
+        void add(double value) { add(&value, sizeof(value)); }
+
+        std::uint64_t value() const { return mHash; }
+
+    private:
+        std::uint64_t mHash = 0xcbf29ce484222325ULL;
+    };
+
+    template<typename T>
+    void writeRaw(std::ostream& os, const T& value)
+    {
+        os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    bool readRaw(std::istream& is, T& value)
+    {
+        return static_cast<bool>(is.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    void writeString(std::ostream& os, const std::string& str)
+    {
+        writeRaw(os, static_cast<std::uint32_t>(str.size()));
+        os.write(str.data(), str.size());
+    }
+
+    bool readString(std::istream& is, std::string& str)
+    {
+        std::uint32_t length = 0;
+        if (!readRaw(is, length)) {
+            return false;
+        }
+        str.resize(length);
+        return static_cast<bool>(is.read(&str[0], length));
+    }
+}
+
+void ObstacleRegistry::initialize()
+{
+    cModule* traci = getModuleByPath(par("traciModule"));
+    if (traci) {
+        traci->subscribe(traciCloseSignal, this);
+    } else {
+        throw cRuntimeError("No TraCI module found for signal subscription");
+    }
+
+    mFilterTypes.clear();
+    const std::string filterTypes = par("filterTypes");
+    boost::split(mFilterTypes, filterTypes, boost::is_any_of(" "));
+    mFilterTypes.erase("");
+    mRequireFilled = par("requireFilled");
+    mPreprocessor = ObstaclePreprocessor { par("simplificationTolerance").doubleValue(), par("mergeTouchingObstacles").boolValue() };
+    mCacheFile = par("cacheFile").stdstringValue();
+}
+
+void ObstacleRegistry::finish()
+{
+    clear();
+    cSimpleModule::finish();
+}
+
+void ObstacleRegistry::receiveSignal(cComponent*, simsignal_t signal, const SimTime&, cObject*)
+{
+    if (signal == traciCloseSignal) {
+        clear();
+    }
+}
+
+void ObstacleRegistry::clear()
+{
+    mObstacles.clear();
+    mEnvelopeRtree.clear();
+    mEdgeRtree.clear();
+    mFetched = false;
+}
+
+void ObstacleRegistry::fetch(traci::API& traci)
+{
+    Enter_Method("fetch");
+    if (mFetched) {
+        return;
+    }
+
+    const traci::Boundary boundary { traci.simulation.getNetBoundary() };
+    const std::vector<std::string> ids = traci.polygon.getIDList();
+
+    std::uint64_t cacheKey = 0;
+    if (!mCacheFile.empty()) {
+        cacheKey = computeCacheKey(traci, ids, boundary);
+        if (loadCache(mCacheFile, cacheKey)) {
+            buildRtrees();
+            EV_INFO << mObstacles.size() << " obstacles loaded from cache " << mCacheFile << "\n";
+            return;
+        }
+    }
+
+    unsigned ignored = 0;
+    auto filter = [this, &ignored](const traci::API::Polygon& polygon) {
+        if (!mFilterTypes.empty() && mFilterTypes.find(polygon.type) == mFilterTypes.end()) {
+            EV_DEBUG << "ignore polygon " << polygon.id << " of type " << polygon.type << "\n";
+            ++ignored;
+            return false;
+        }
+
+        if (mRequireFilled && !polygon.filled) {
+            EV_DEBUG << "ignore unfilled polygon " << polygon.id << "\n";
+            ++ignored;
+            return false;
+        }
+
+        return true;
+    };
+
+    std::string shape_msg;
+    for (traci::API::Polygon& polygon : traci.getPolygons(ids, filter)) {
+        std::vector<Position> shape;
+        for (const traci::TraCIPosition& point : polygon.shape.value) {
+            bg::append(shape, traci::position_cast(boundary, point));
+        }
+
+        bg::correct(shape); // fixes issues such as reversed point order
+        if (shape.size() < 3 || !bg::is_valid(shape, shape_msg)) {
+            EV_DEBUG << "ignore invalid polygon " << polygon.id << " (" << shape_msg << ")\n";
+            ++ignored;
+            continue;
+        }
+
+        mObstacles.push_back(Obstacle { std::move(polygon.id), std::move(polygon.type), std::move(shape) });
+    }
+
+    if (mPreprocessor.isEnabled()) {
+        const ObstaclePreprocessor::Statistics stats = mPreprocessor.process(mObstacles);
+        EV_INFO << "obstacle preprocessing: " << stats << "\n";
+        stats.recordScalars(*this);
+    }
+
+    buildRtrees();
+    EV_INFO << mObstacles.size() << " obstacles registered (" << ignored << " ignored)\n";
+
+    if (!mCacheFile.empty()) {
+        storeCache(mCacheFile, cacheKey);
+    }
+}
+
+void ObstacleRegistry::buildRtrees()
+{
+    std::vector<EnvelopeValue> envelopes;
+    std::vector<EdgeValue> edges;
+    envelopes.reserve(mObstacles.size());
+    for (Index i = 0; i < mObstacles.size(); ++i) {
+        const std::vector<Position>& outline = mObstacles[i].outline;
+        envelopes.emplace_back(bg::return_envelope<geometry::Box>(outline), i);
+        for (std::size_t j = 0; j < outline.size(); ++j) {
+            const LineOfSight edge { outline[j], outline[(j + 1) % outline.size()] };
+            edges.emplace_back(bg::return_envelope<geometry::Box>(edge), i);
+        }
+    }
+
+    // bulk loading packs the trees efficiently
+    mEnvelopeRtree = EnvelopeRtree { envelopes.begin(), envelopes.end() };
+    mEdgeRtree = EdgeRtree { edges.begin(), edges.end() };
+    mFetched = true;
+}
+
+std::uint64_t ObstacleRegistry::computeCacheKey(traci::API& traci, const std::vector<std::string>& ids,
+        const traci::Boundary& boundary) const
+{
+    Fnv1a hash;
+    for (const std::string& type : mFilterTypes) {
+        hash.add(type);
+    }
+    hash.add(mRequireFilled ? "filled" : "any");
+    if (mPreprocessor.isEnabled()) {
+        // keep keys of caches without preprocessing
+        hash.add(mPreprocessor.getTolerance());
+        hash.add(mPreprocessor.isMerging() ? "merged" : "separate");
+    }
+    hash.add(boundary.lowerLeftPosition().x);
+    hash.add(boundary.lowerLeftPosition().y);
+    hash.add(boundary.upperRightPosition().x);
+    hash.add(boundary.upperRightPosition().y);
+    for (const std::string& id : ids) {
+        hash.add(id);
+    }
+
+    // fetching all shapes would defeat the cache, evenly spaced samples catch most edited polygon files
+    const std::size_t samples = std::min(ids.size(), sCacheShapeSamples);
+    for (std::size_t i = 0; i < samples; ++i) {
+        const std::string& id = ids[i * ids.size() / samples];
+        hash.add(traci.polygon.getType(id));
+        hash.add(traci.polygon.getFilled(id) ? "filled" : "unfilled");
+        for (const traci::TraCIPosition& point : traci.polygon.getShape(id).value) {
+            hash.add(point.x);
+            hash.add(point.y);
+        }
+    }
+    return hash.value();
+}
+
+bool ObstacleRegistry::loadCache(const std::string& file, std::uint64_t key)
+{
+    std::ifstream is(file, std::ios::binary);
+    if (!is) {
+        return false;
+    }
+
+    char magic[sizeof(sCacheMagic)];
+    std::uint32_t version = 0;
+    std::uint64_t cachedKey = 0;
+    std::uint64_t count = 0;
+    if (!is.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), sCacheMagic) ||
+        !readRaw(is, version) || version != sCacheVersion ||
+        !readRaw(is, cachedKey) || cachedKey != key || !readRaw(is, count)) {
+        EV_INFO << "ignore outdated obstacle cache " << file << "\n";
+        return false;
+    }
+
+    std::vector<Obstacle> obstacles;
+    obstacles.reserve(count);
+    for (std::uint64_t i = 0; i < count; ++i) {
+        Obstacle obstacle;
+        std::uint32_t points = 0;
+        if (!readString(is, obstacle.id) || !readString(is, obstacle.type) || !readRaw(is, points)) {
+            EV_WARN << "obstacle cache " << file << " is truncated\n";
+            return false;
+        }
+
+        obstacle.outline.reserve(points);
+        for (std::uint32_t j = 0; j < points; ++j) {
+            double x = 0.0;
+            double y = 0.0;
+            if (!readRaw(is, x) || !readRaw(is, y)) {
+                EV_WARN << "obstacle cache " << file << " is truncated\n";
+                return false;
+            }
+            obstacle.outline.emplace_back(x, y);
+        }
+        obstacles.push_back(std::move(obstacle));
+    }
+
+    mObstacles = std::move(obstacles);
+    return true;
+}
+
+void ObstacleRegistry::storeCache(const std::string& file, std::uint64_t key) const
+{
+    // write to temporary file first so concurrent runs never read a partial cache
+    const std::string tmp = file + ".tmp" + std::to_string(getEnvir()->getConfigEx()->getActiveRunNumber());
+    {
+        std::ofstream os(tmp, std::ios::binary | std::ios::trunc);
+        os.write(sCacheMagic, sizeof(sCacheMagic));
+        writeRaw(os, sCacheVersion);
+        writeRaw(os, key);
+        writeRaw(os, static_cast<std::uint64_t>(mObstacles.size()));
+        for (const Obstacle& obstacle : mObstacles) {
+            writeString(os, obstacle.id);
+            writeString(os, obstacle.type);
+            writeRaw(os, static_cast<std::uint32_t>(obstacle.outline.size()));
+            for (const Position& pos : obstacle.outline) {
+                writeRaw(os, pos.x.value());
+                writeRaw(os, pos.y.value());
+            }
+        }
+
+        if (!os) {
+            EV_WARN << "failed to write obstacle cache " << tmp << "\n";
+            std::remove(tmp.c_str());
+            return;
+        }
+    }
+
+    if (std::rename(tmp.c_str(), file.c_str()) != 0) {
+        EV_WARN << "failed to store obstacle cache " << file << "\n";
+        std::remove(tmp.c_str());
+    }
+}
+
+void ObstacleRegistry::queryEnvelopes(const geometry::Box& box, const std::function<void(Index)>& visitor) const
+{
+    auto predicate = bg::index::intersects(box);
+    for (auto it = mEnvelopeRtree.qbegin(predicate); it != mEnvelopeRtree.qend(); ++it) {
+        visitor(it->second);
+    }
+}
+
+void ObstacleRegistry::querySegment(const Position& a, const Position& b, const std::function<bool(Index)>& visitor) const
+{
+    const LineOfSight los { a, b };
+    std::vector<Index> candidates;
+    auto predicate = bg::index::intersects(los);
+    for (auto it = mEdgeRtree.qbegin(predicate); it != mEdgeRtree.qend(); ++it) {
+        candidates.push_back(it->second);
+    }
+
+    // several edges of an obstacle may match, visit each obstacle once in registry order
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    for (Index candidate : candidates) {
+        if (!visitor(candidate)) {
+            break;
+        }
+    }
+}
+
+} // namespace artery
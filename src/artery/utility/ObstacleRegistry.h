@@ -0,0 +1,107 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_OBSTACLEREGISTRY_H_J6TNC2WE
+#define ARTERY_OBSTACLEREGISTRY_H_J6TNC2WE
+
+#include "artery/utility/Geometry.h"
+#include "artery/utility/ObstaclePreprocessor.h"
+#include <boost/geometry/index/rtree.hpp>
+#include <omnetpp/clistener.h>
+#include <omnetpp/csimplemodule.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <string>
+#include <vector>
+
+// forward declaration
+namespace traci { class API; class Boundary; }
+
+namespace artery
+{
+
+/**
+ * ObstacleRegistry fetches static obstacles (SUMO polygons) once and shares them among
+ * several consumers, e.g. the environment model and GEMV2's obstacle index.
+ *
+ * Besides an R-tree over whole polygon envelopes, the registry indexes each polygon edge
+ * individually. Thin line of sight segments are thus only tested against obstacles
+ * with an edge close to the segment instead of all obstacles whose envelope it crosses.
+ *
+ * Validated outlines may be merged and simplified before indexing (see ObstaclePreprocessor).
+ *
+ * Validated outlines can be cached in a binary file to skip fetching polygons
+ * in subsequent runs. The cache is only used if its key (filter settings, network boundary
+ * and polygon identifiers) matches the current simulation.
+ */
+class ObstacleRegistry : public omnetpp::cSimpleModule, public omnetpp::cListener
+{
+public:
+    using Obstacle = ObstacleOutline;
+
+    using Index = std::size_t;
+
+    void initialize() override;
+    void finish() override;
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, const omnetpp::SimTime&, omnetpp::cObject*) override;
+
+    /**
+     * Fetch obstacles via TraCI unless they have been fetched already
+     * \param api TraCI API
+     */
+    void fetch(traci::API& api);
+
+    bool isFetched() const { return mFetched; }
+
+    /**
+     * Get all registered obstacles, their order matches the index used by queries
+     * \return valid (corrected) obstacle polygons
+     */
+    const std::vector<Obstacle>& getObstacles() const { return mObstacles; }
+
+    /**
+     * Call visitor for each obstacle whose envelope intersects the given box
+     * \param box query box
+     * \param visitor invoked with obstacle index
+     */
+    void queryEnvelopes(const geometry::Box& box, const std::function<void(Index)>& visitor) const;
+
+    /**
+     * Call visitor once for each obstacle having an edge whose envelope intersects the segment a-b
+     *
+     * Obstacles completely enclosing the segment are not visited.
+     * \param a segment start
+     * \param b segment end
+     * \param visitor invoked with obstacle index, returning false stops the query
+     */
+    void querySegment(const Position& a, const Position& b, const std::function<bool(Index)>& visitor) const;
+
+private:
+    using EnvelopeValue = std::pair<geometry::Box, Index>;
+    using EnvelopeRtree = boost::geometry::index::rtree<EnvelopeValue, boost::geometry::index::rstar<16>>;
+    using EdgeValue = std::pair<geometry::Box, Index>;
+    using EdgeRtree = boost::geometry::index::rtree<EdgeValue, boost::geometry::index::rstar<16>>;
+
+    void clear();
+    void buildRtrees();
+    std::uint64_t computeCacheKey(traci::API&, const std::vector<std::string>& ids, const traci::Boundary&) const;
+    bool loadCache(const std::string& file, std::uint64_t key);
+    void storeCache(const std::string& file, std::uint64_t key) const;
+
+    std::set<std::string> mFilterTypes;
+    bool mRequireFilled = false;
+    ObstaclePreprocessor mPreprocessor { 0.0, false };
+    std::string mCacheFile;
+    bool mFetched = false;
+    std::vector<Obstacle> mObstacles;
+    EnvelopeRtree mEnvelopeRtree;
+    EdgeRtree mEdgeRtree;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_OBSTACLEREGISTRY_H_J6TNC2WE */
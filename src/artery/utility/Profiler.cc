@@ -0,0 +1,74 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/utility/Profiler.h"
+#include "artery/utility/ProfilingScope.h"
+#include <omnetpp/cenvir.h>
+#include <chrono>
+#include <map>
+#include <string>
+
+namespace artery
+{
+
+Define_Module(Profiler)
+
+Profiler::~Profiler()
+{
+    if (mListening) {
+        omnetpp::getEnvir()->removeLifecycleListener(this);
+    }
+}
+
+void Profiler::initialize()
+{
+#ifdef ARTERY_PROFILER
+    omnetpp::getEnvir()->addLifecycleListener(this);
+    mListening = true;
+#else
+    EV_WARN << "profiling scopes are not compiled in, rebuild Artery with WITH_PROFILER enabled\n";
+#endif
+}
+
+void Profiler::lifecycleEvent(omnetpp::SimulationLifecycleEventType event, omnetpp::cObject*)
+{
+    auto& registry = profiling::Registry::instance();
+    if (event == omnetpp::LF_POST_NETWORK_INITIALIZE) {
+        // exclude initialization, e.g. TraCI connection set-up
+        registry.clear();
+        registry.setEnabled(true);
+    } else if (event == omnetpp::LF_PRE_NETWORK_DELETE) {
+        registry.setEnabled(false);
+        registry.clear();
+    }
+}
+
+void Profiler::finish()
+{
+    auto& registry = profiling::Registry::instance();
+    registry.setEnabled(false);
+
+    using seconds = std::chrono::duration<double>;
+    std::map<std::string, profiling::Counter> nodes;
+    for (const auto& entry : registry.counters()) {
+        const profiling::Key& key = entry.first;
+        const profiling::Counter& counter = entry.second;
+        const std::string node = key.node->getFullName();
+        const std::string name = std::string(key.scope) + " " + key.module->getFullName() + " @" + node;
+        recordScalar((name + " time").c_str(), std::chrono::duration_cast<seconds>(counter.time).count(), "s");
+        recordScalar((name + " calls").c_str(), counter.calls);
+
+        profiling::Counter& total = nodes[node];
+        total.time += counter.time;
+        total.calls += counter.calls;
+    }
+
+    for (const auto& node : nodes) {
+        recordScalar(("@" + node.first + " time").c_str(), std::chrono::duration_cast<seconds>(node.second.time).count(), "s");
+        recordScalar(("@" + node.first + " calls").c_str(), node.second.calls);
+    }
+}
+
+} // namespace artery
@@ -0,0 +1,38 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_PROFILER_H_N6WJ2XKD
+#define ARTERY_PROFILER_H_N6WJ2XKD
+
+#include <omnetpp/clifecyclelistener.h>
+#include <omnetpp/csimplemodule.h>
+
+namespace artery
+{
+
+/**
+ * Profiler enables profiling scopes (see ProfilingScope.h) for the duration of a run.
+ *
+ * Measurement starts once the network has been initialized and ends with finish,
+ * time and call counts of each scope, module type and node class are recorded as scalars then.
+ * Scopes are only compiled in if Artery is built with WITH_PROFILER, this module does nothing otherwise.
+ */
+class Profiler : public omnetpp::cSimpleModule, public omnetpp::cISimulationLifecycleListener
+{
+public:
+    ~Profiler();
+
+protected:
+    void initialize() override;
+    void finish() override;
+    void lifecycleEvent(omnetpp::SimulationLifecycleEventType, omnetpp::cObject*) override;
+
+private:
+    bool mListening = false;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_PROFILER_H_N6WJ2XKD */
@@ -0,0 +1,148 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_PROFILINGSCOPE_H_T3VQ8ZRM
+#define ARTERY_PROFILINGSCOPE_H_T3VQ8ZRM
+
+#include <omnetpp/ccomponent.h>
+#include <omnetpp/ccomponenttype.h>
+#include <omnetpp/cmodule.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+namespace artery
+{
+namespace profiling
+{
+
+using Clock = std::chrono::steady_clock;
+
+struct Counter
+{
+    Clock::duration time = Clock::duration::zero();
+    std::uint64_t calls = 0;
+};
+
+struct Key
+{
+    const char* scope; /*< literal name of scope */
+    const omnetpp::cComponentType* module; /*< type of module executing scope */
+    const omnetpp::cComponentType* node; /*< type of top-level module enclosing that module */
+
+    bool operator==(const Key& other) const
+    {
+        return scope == other.scope && module == other.module && node == other.node;
+    }
+};
+
+struct KeyHash
+{
+    std::size_t operator()(const Key& key) const
+    {
+        std::size_t seed = std::hash<const void*>()(key.scope);
+        seed ^= std::hash<const void*>()(key.module) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        seed ^= std::hash<const void*>()(key.node) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        return seed;
+    }
+};
+
+/**
+ * Registry accumulates time spent in profiling scopes
+ *
+ * Measurements are attributed to the scope's name, the type of the module executing it
+ * and the node class, i.e. the type of the top-level module below the network containing it.
+ * Keys are made of types instead of module instances, thus deleted nodes cannot mix up counters.
+ * Scopes are measured only while the registry is enabled (see Profiler module)
+ * and only by the simulation's main thread.
+ */
+class Registry
+{
+public:
+    using Counters = std::unordered_map<Key, Counter, KeyHash>;
+
+    static Registry& instance()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    bool isEnabled() const { return mEnabled; }
+    void setEnabled(bool enabled) { mEnabled = enabled; }
+
+    /**
+     * Get counter of a scope executed by given component
+     * \param scope name of scope, has to be a string literal (compared by address)
+     * \param component executing component
+     * \return counter, valid until registry is cleared
+     */
+    Counter& counter(const char* scope, const omnetpp::cComponent* component)
+    {
+        const omnetpp::cComponent* node = component;
+        for (const omnetpp::cModule* parent = node->getParentModule(); parent && parent->getParentModule();
+                parent = parent->getParentModule()) {
+            node = parent;
+        }
+        return mCounters[Key { scope, component->getComponentType(), node->getComponentType() }];
+    }
+
+    const Counters& counters() const { return mCounters; }
+    void clear() { mCounters.clear(); }
+
+private:
+    bool mEnabled = false;
+    Counters mCounters;
+};
+
+/**
+ * Scope measures its lifetime and adds it to the registry's counter
+ */
+class Scope
+{
+public:
+    Scope(const char* name, const omnetpp::cComponent* component)
+    {
+        Registry& registry = Registry::instance();
+        if (registry.isEnabled()) {
+            mCounter = &registry.counter(name, component);
+            mStart = Clock::now();
+        }
+    }
+
+    ~Scope()
+    {
+        if (mCounter) {
+            mCounter->time += Clock::now() - mStart;
+            ++mCounter->calls;
+        }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+private:
+    Counter* mCounter = nullptr;
+    Clock::time_point mStart;
+};
+
+} // namespace profiling
+} // namespace artery
+
+/**
+ * Measure the remainder of the enclosing block, to be used in member functions of modules.
+ * Profiling scopes compile to nothing unless Artery is built with WITH_PROFILER.
+ */
+#ifdef ARTERY_PROFILER
+#   define ARTERY_PROFILE_CONCAT_IMPL(a, b) a##b
+#   define ARTERY_PROFILE_CONCAT(a, b) ARTERY_PROFILE_CONCAT_IMPL(a, b)
+#   define ARTERY_PROFILE_SCOPE(name) \
+        ::artery::profiling::Scope ARTERY_PROFILE_CONCAT(artery_profile_scope_, __LINE__) { name, this }
+#else
+#   define ARTERY_PROFILE_SCOPE(name) static_cast<void>(0)
+#endif
+
+#endif /* ARTERY_PROFILINGSCOPE_H_T3VQ8ZRM */
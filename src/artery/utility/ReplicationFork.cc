@@ -0,0 +1,153 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/utility/ReplicationFork.h"
+#include <omnetpp/cconfiguration.h>
+#include <omnetpp/crng.h>
+#include <omnetpp/cstringtokenizer.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace artery
+{
+
+Define_Module(ReplicationFork)
+
+const omnetpp::simsignal_t ReplicationFork::prepareSignal = omnetpp::cComponent::registerSignal("replicationFork.prepare");
+const omnetpp::simsignal_t ReplicationFork::childSignal = omnetpp::cComponent::registerSignal("replicationFork.child");
+const omnetpp::simsignal_t ReplicationFork::resumeSignal = omnetpp::cComponent::registerSignal("replicationFork.resume");
+
+ReplicationFork::~ReplicationFork()
+{
+    cancelAndDelete(mCheckpoint);
+}
+
+void ReplicationFork::initialize()
+{
+    mReplications = par("replications");
+    if (mReplications < 1) {
+        throw omnetpp::cRuntimeError("at least one replication is required");
+    }
+    mSeedSetStride = par("seedSetStride");
+    mDirectoryPrefix = par("directoryPrefix").stringValue();
+
+    omnetpp::cEnvir* envir = getEnvir();
+    mRngs = omnetpp::cStringTokenizer(par("rngs")).asIntVector();
+    if (mRngs.empty()) {
+        for (int rng = 0; rng < envir->getNumRNGs(); ++rng) {
+            mRngs.push_back(rng);
+        }
+    }
+    for (int rng : mRngs) {
+        if (rng < 0 || rng >= envir->getNumRNGs()) {
+            throw omnetpp::cRuntimeError("no RNG %d to reseed, only %d RNGs are configured", rng, envir->getNumRNGs());
+        }
+    }
+
+    const omnetpp::SimTime checkpoint = par("checkpoint");
+    if (mReplications > 1) {
+        if (checkpoint < omnetpp::simTime()) {
+            throw omnetpp::cRuntimeError("checkpoint has to be in the future");
+        }
+        if (getSimulation()->getWarmupPeriod() < checkpoint) {
+            EV_WARN << "warm-up period ends before checkpoint, results recorded before are shared by all replications\n";
+        }
+        mCheckpoint = new omnetpp::cMessage("replication checkpoint");
+        // fork after all other events at checkpoint, i.e. replications start from a consistent state
+        mCheckpoint->setSchedulingPriority(std::numeric_limits<short>::max());
+        scheduleAt(checkpoint, mCheckpoint);
+    }
+}
+
+void ReplicationFork::handleMessage(omnetpp::cMessage* msg)
+{
+    if (msg == mCheckpoint) {
+        fork();
+    } else {
+        throw omnetpp::cRuntimeError("unexpected message");
+    }
+}
+
+void ReplicationFork::finish()
+{
+    recordScalar("replication", mReplication);
+
+    int failures = 0;
+    for (pid_t child : mChildren) {
+        int status = 0;
+        if (::waitpid(child, &status, 0) != child || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            ++failures;
+        }
+    }
+    mChildren.clear();
+
+    if (failures > 0) {
+        throw omnetpp::cRuntimeError("%d of %d forked replications failed", failures, mReplications - 1);
+    }
+}
+
+void ReplicationFork::fork()
+{
+    // thread owners stop their threads here, see class documentation
+    emit(prepareSignal, true);
+
+    // buffered output would be written by each process otherwise
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+
+    EV_INFO << "Forking " << mReplications - 1 << " replications at " << omnetpp::simTime() << "\n";
+    for (int replication = 1; replication < mReplications; ++replication) {
+        const pid_t pid = ::fork();
+        if (pid < 0) {
+            throw omnetpp::cRuntimeError("fork() failed: %s", std::strerror(errno));
+        } else if (pid == 0) {
+            mChildren.clear();
+            continueReplication(replication);
+            emit(childSignal, static_cast<long>(replication));
+            emit(resumeSignal, true);
+            return;
+        }
+        mChildren.push_back(pid);
+    }
+    continueReplication(0);
+    emit(resumeSignal, true);
+}
+
+void ReplicationFork::continueReplication(int replication)
+{
+    mReplication = replication;
+    if (replication > 0) {
+        reseed(replication);
+    }
+
+    // result files are opened on first record, relative paths end up in replication's directory
+    if (!mDirectoryPrefix.empty()) {
+        const std::string directory = mDirectoryPrefix + std::to_string(replication);
+        if (::mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) {
+            throw omnetpp::cRuntimeError("cannot create directory %s: %s", directory.c_str(), std::strerror(errno));
+        } else if (::chdir(directory.c_str()) != 0) {
+            throw omnetpp::cRuntimeError("cannot change to directory %s: %s", directory.c_str(), std::strerror(errno));
+        }
+    }
+}
+
+void ReplicationFork::reseed(int replication)
+{
+    omnetpp::cEnvir* envir = getEnvir();
+    omnetpp::cConfiguration* config = envir->getConfig();
+    const int seedSet = envir->getConfigEx()->getActiveRunNumber() + mSeedSetStride * replication;
+    for (int rng : mRngs) {
+        envir->getRNG(rng)->initialize(seedSet, rng, envir->getNumRNGs(), 0, 1, config);
+    }
+}
+
+} // namespace artery
@@ -0,0 +1,66 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_REPLICATIONFORK_H_5QZRM2WD
+#define ARTERY_REPLICATIONFORK_H_5QZRM2WD
+
+#include <omnetpp/cmessage.h>
+#include <omnetpp/csimplemodule.h>
+#include <sys/types.h>
+#include <string>
+#include <vector>
+
+namespace artery
+{
+
+/**
+ * ReplicationFork runs several replications of a simulation run sharing its initialisation.
+ *
+ * The process forks at the checkpoint time, i.e. all state set up until then is shared copy-on-write.
+ * Each forked process reseeds the configured RNGs from a seed set of its own and continues in a
+ * directory of its own. The original process continues as replication 0 and waits for the forked ones at finish.
+ *
+ * prepareSignal (bool) is emitted before forking, e.g. to finish pending TraCI steps.
+ * childSignal (long) is emitted with the replication number in each forked process.
+ * resumeSignal (bool) is emitted after forking in every process, i.e. the original and each forked one.
+ *
+ * Only the forking thread survives in forked processes. Modules owning threads have to stop and join them
+ * on prepareSignal and may restart them on resumeSignal (or lazily on next use like TaskScheduler).
+ * Threads still running at fork time are only tolerated if they are idle and never touched by forked
+ * processes, e.g. the server thread of traci::PlaybackLauncher, which forked processes rebind on their own.
+ */
+class ReplicationFork : public omnetpp::cSimpleModule
+{
+public:
+    static const omnetpp::simsignal_t prepareSignal;
+    static const omnetpp::simsignal_t childSignal;
+    static const omnetpp::simsignal_t resumeSignal;
+
+    ~ReplicationFork();
+
+    int getReplication() const { return mReplication; }
+
+protected:
+    void initialize() override;
+    void handleMessage(omnetpp::cMessage*) override;
+    void finish() override;
+
+private:
+    void fork();
+    void continueReplication(int replication);
+    void reseed(int replication);
+
+    omnetpp::cMessage* mCheckpoint = nullptr;
+    int mReplications;
+    int mReplication = 0;
+    int mSeedSetStride;
+    std::vector<int> mRngs;
+    std::string mDirectoryPrefix;
+    std::vector<pid_t> mChildren;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_REPLICATIONFORK_H_5QZRM2WD */
@@ -0,0 +1,252 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/utility/TaskScheduler.h"
+#include "artery/utility/ReplicationFork.h"
+#include <omnetpp/crng.h>
+#include <cmath>
+
+namespace artery
+{
+
+Define_Module(TaskScheduler)
+
+namespace
+{
+
+// loops started by a task are not distributed again
+thread_local bool tInsideTask = false;
+
+std::uint64_t splitmix64(std::uint64_t& state)
+{
+    std::uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+} // namespace
+
+TaskRandom::TaskRandom(std::uint64_t seed, std::uint64_t task) : mState(task)
+{
+    // scramble task index before combining, adjacent tasks would get overlapping sequences otherwise
+    mState = seed ^ splitmix64(mState);
+}
+
+std::uint64_t TaskRandom::drawSeed(omnetpp::cRNG& rng)
+{
+    const std::uint64_t high = rng.intRand();
+    return (high << 32) | rng.intRand();
+}
+
+TaskRandom::result_type TaskRandom::operator()()
+{
+    return splitmix64(mState);
+}
+
+double TaskRandom::uniform()
+{
+    return ((*this)() >> 11) * 0x1.0p-53;
+}
+
+double TaskRandom::uniform(double a, double b)
+{
+    return a + (b - a) * uniform();
+}
+
+double TaskRandom::normal(double mean, double stddev)
+{
+    // Box-Muller transform draws exactly two numbers per variate
+    const double u1 = 1.0 - uniform();
+    const double u2 = uniform();
+    return mean + stddev * std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2);
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    stop();
+}
+
+void TaskScheduler::initialize()
+{
+    const int threads = par("threads");
+    if (threads < 0) {
+        throw omnetpp::cRuntimeError("number of task scheduler threads must not be negative");
+    }
+    mThreads = threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 0; i < mThreads; ++i) {
+        mQueues.emplace_back(new Queue());
+    }
+
+    // threads do not survive fork, restart them on next loop
+    getSystemModule()->subscribe(ReplicationFork::prepareSignal, this);
+}
+
+void TaskScheduler::finish()
+{
+    stop();
+    getSystemModule()->unsubscribe(ReplicationFork::prepareSignal, this);
+}
+
+void TaskScheduler::receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t signal, bool, omnetpp::cObject*)
+{
+    if (signal == ReplicationFork::prepareSignal) {
+        stop();
+    }
+}
+
+void TaskScheduler::parallelFor(std::size_t count, std::size_t grain, const std::function<void(std::size_t)>& func)
+{
+    parallelFor<const std::function<void(std::size_t)>&>(count, grain, func);
+}
+
+void TaskScheduler::run(std::size_t chunks, const std::function<void(std::size_t)>& body)
+{
+    if (chunks == 0) {
+        return;
+    }
+
+    Job job;
+    job.body = &body;
+    job.errors.resize(chunks);
+    job.pending = chunks;
+
+    if (mThreads <= 1 || chunks == 1 || tInsideTask) {
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+            try {
+                body(chunk);
+            } catch (...) {
+                job.errors[chunk] = std::current_exception();
+            }
+        }
+    } else {
+        start();
+
+        // deal out contiguous chunk ranges, idle threads steal from the back of other queues
+        mJob = &job;
+        for (std::size_t queue = 0; queue < mQueues.size(); ++queue) {
+            std::lock_guard<std::mutex> lock(mQueues[queue]->mutex);
+            const std::size_t begin = chunks * queue / mQueues.size();
+            const std::size_t end = chunks * (queue + 1) / mQueues.size();
+            for (std::size_t chunk = begin; chunk < end; ++chunk) {
+                mQueues[queue]->chunks.push_back(chunk);
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            ++mGeneration;
+        }
+        mWake.notify_all();
+
+        while (execute(0)) {}
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        mDone.wait(lock, [&job]() { return job.pending == 0; });
+        mJob = nullptr;
+    }
+
+    for (const std::exception_ptr& error : job.errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+void TaskScheduler::start()
+{
+    if (!mWorkers.empty()) {
+        return;
+    }
+
+    mStop = false;
+    for (unsigned worker = 1; worker < mThreads; ++worker) {
+        mWorkers.emplace_back(&TaskScheduler::work, this, worker);
+    }
+}
+
+void TaskScheduler::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mWake.notify_all();
+    for (std::thread& worker : mWorkers) {
+        worker.join();
+    }
+    mWorkers.clear();
+}
+
+void TaskScheduler::work(unsigned worker)
+{
+    std::uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        generation = mGeneration;
+    }
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWake.wait(lock, [this, generation]() { return mStop || mGeneration != generation; });
+            if (mStop) {
+                return;
+            }
+            generation = mGeneration;
+        }
+        while (execute(worker)) {}
+    }
+}
+
+bool TaskScheduler::execute(unsigned worker)
+{
+    std::size_t chunk;
+    if (!pop(worker, chunk)) {
+        return false;
+    }
+
+    // job outlives its chunks, pending chunks keep run() waiting
+    Job* job = mJob;
+    tInsideTask = true;
+    try {
+        (*job->body)(chunk);
+    } catch (...) {
+        job->errors[chunk] = std::current_exception();
+    }
+    tInsideTask = false;
+
+    if (job->pending.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mDone.notify_all();
+    }
+    return true;
+}
+
+bool TaskScheduler::pop(unsigned worker, std::size_t& chunk)
+{
+    {
+        Queue& own = *mQueues[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.chunks.empty()) {
+            chunk = own.chunks.front();
+            own.chunks.pop_front();
+            return true;
+        }
+    }
+
+    for (std::size_t i = 1; i < mQueues.size(); ++i) {
+        Queue& victim = *mQueues[(worker + i) % mQueues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.chunks.empty()) {
+            chunk = victim.chunks.back();
+            victim.chunks.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace artery
@@ -0,0 +1,248 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_TASKSCHEDULER_H_V3NQ8ZKD
+#define ARTERY_TASKSCHEDULER_H_V3NQ8ZKD
+
+#include "traci/ParallelExecutor.h"
+#include <boost/optional/optional.hpp>
+#include <omnetpp/clistener.h>
+#include <omnetpp/csimplemodule.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace omnetpp { class cRNG; }
+
+namespace artery
+{
+
+/**
+ * TaskRandom is a random number generator substream of a parallel task.
+ *
+ * Its sequence only depends on seed and task index, i.e. it does not matter which thread
+ * runs a task or in which order tasks are run. Draw seed once per parallel loop on the
+ * simulation thread and use the loop index as task index.
+ */
+class TaskRandom
+{
+public:
+    using result_type = std::uint64_t;
+
+    TaskRandom(std::uint64_t seed, std::uint64_t task);
+
+    /**
+     * Draw seed of parallel loop from an OMNeT++ RNG (consumes two numbers)
+     */
+    static std::uint64_t drawSeed(omnetpp::cRNG&);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+    result_type operator()();
+
+    /** uniform in [0, 1) */
+    double uniform();
+    /** uniform in [a, b) */
+    double uniform(double a, double b);
+    double normal(double mean, double stddev);
+
+private:
+    std::uint64_t mState;
+};
+
+/**
+ * TaskScheduler runs loop bodies of one simulated instant on a shared pool of threads.
+ *
+ * A loop's index range is cut into chunks of "grain" indices. Chunks are dealt out to
+ * per-thread queues and idle threads steal chunks from others. The simulation thread takes part
+ * in each loop and returns when all chunks are done. Loops are run on the calling thread only
+ * if the pool has a single thread, the loop fits into one chunk or a loop is nested in another.
+ *
+ * Chunk boundaries depend on count and grain only, not on the number of threads.
+ * Thus, reductions combining chunk results in chunk order and TaskRandom substreams
+ * give bit-identical results for any thread count and fingerprints stay valid.
+ *
+ * Workers are started on first use and stopped before ReplicationFork forks.
+ * Modules locate the scheduler by their "taskSchedulerModule" parameter and run serially without it.
+ */
+class TaskScheduler : public omnetpp::cSimpleModule, public omnetpp::cListener, public traci::ParallelExecutor
+{
+public:
+    ~TaskScheduler();
+
+    /**
+     * Number of threads running a loop including the calling thread
+     */
+    unsigned getThreads() const { return mThreads; }
+
+    /**
+     * Invoke func(i) for each i in [0, count)
+     *
+     * Exceptions are rethrown after all chunks have finished, the one of the lowest failing chunk wins.
+     * \param count number of indices
+     * \param grain indices per chunk, i.e. per task
+     * \param func must be safe to call concurrently for distinct indices
+     */
+    template<typename Func>
+    void parallelFor(std::size_t count, std::size_t grain, Func func);
+
+    /**
+     * Type-erased parallelFor for traci modules
+     */
+    void parallelFor(std::size_t count, std::size_t grain, const std::function<void(std::size_t)>& func) override;
+
+    /**
+     * Combine map(i) of all i in [0, count) with init
+     *
+     * Each chunk folds its indices in ascending order, chunk results are then folded in chunk order
+     * on the calling thread. The grain thus determines the association of combine, but threads do not.
+     * \return init if count is zero
+     */
+    template<typename T, typename Map, typename Combine>
+    T parallelReduce(std::size_t count, std::size_t grain, T init, Map map, Combine combine);
+
+    /**
+     * Invoke func(node) for each element of a random-access range, e.g. a vector of node modules
+     */
+    template<typename Range, typename Func>
+    void forEachNode(Range& nodes, std::size_t grain, Func func);
+
+protected:
+    void initialize() override;
+    void finish() override;
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, bool, omnetpp::cObject*) override;
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<std::size_t> chunks;
+    };
+
+    struct Job
+    {
+        const std::function<void(std::size_t)>* body;
+        std::vector<std::exception_ptr> errors;
+        std::atomic<std::size_t> pending;
+    };
+
+    void run(std::size_t chunks, const std::function<void(std::size_t)>& body);
+    void start();
+    void stop();
+    void work(unsigned worker);
+    bool execute(unsigned worker);
+    bool pop(unsigned worker, std::size_t& chunk);
+
+    unsigned mThreads = 1;
+    std::vector<std::thread> mWorkers;
+    std::vector<std::unique_ptr<Queue>> mQueues;
+    Job* mJob = nullptr;
+
+    std::mutex mMutex;
+    std::condition_variable mWake;
+    std::condition_variable mDone;
+    std::uint64_t mGeneration = 0;
+    bool mStop = false;
+};
+
+template<typename Func>
+void TaskScheduler::parallelFor(std::size_t count, std::size_t grain, Func func)
+{
+    if (grain == 0) {
+        grain = 1;
+    }
+    const std::function<void(std::size_t)> body = [count, grain, &func](std::size_t chunk) {
+        const std::size_t end = std::min(count, (chunk + 1) * grain);
+        for (std::size_t i = chunk * grain; i < end; ++i) {
+            func(i);
+        }
+    };
+    run((count + grain - 1) / grain, body);
+}
+
+template<typename T, typename Map, typename Combine>
+T TaskScheduler::parallelReduce(std::size_t count, std::size_t grain, T init, Map map, Combine combine)
+{
+    if (grain == 0) {
+        grain = 1;
+    }
+    std::vector<boost::optional<T>> partials((count + grain - 1) / grain);
+    const std::function<void(std::size_t)> body = [&](std::size_t chunk) {
+        const std::size_t end = std::min(count, (chunk + 1) * grain);
+        std::size_t i = chunk * grain;
+        T partial = map(i);
+        for (++i; i < end; ++i) {
+            partial = combine(std::move(partial), map(i));
+        }
+        partials[chunk] = std::move(partial);
+    };
+    run(partials.size(), body);
+
+    for (auto& partial : partials) {
+        init = combine(std::move(init), std::move(*partial));
+    }
+    return init;
+}
+
+template<typename Range, typename Func>
+void TaskScheduler::forEachNode(Range& nodes, std::size_t grain, Func func)
+{
+    parallelFor(nodes.size(), grain, [&nodes, &func](std::size_t i) { func(nodes[i]); });
+}
+
+/**
+ * Run parallel loop on scheduler if given or on calling thread otherwise
+ */
+template<typename Func>
+void parallelFor(TaskScheduler* scheduler, std::size_t count, std::size_t grain, Func func)
+{
+    if (scheduler) {
+        scheduler->parallelFor(count, grain, std::move(func));
+    } else {
+        for (std::size_t i = 0; i < count; ++i) {
+            func(i);
+        }
+    }
+}
+
+/**
+ * Reduce on scheduler if given or on calling thread otherwise
+ *
+ * The calling thread folds chunks of grain indices like TaskScheduler does,
+ * thus results are identical with and without scheduler.
+ */
+template<typename T, typename Map, typename Combine>
+T parallelReduce(TaskScheduler* scheduler, std::size_t count, std::size_t grain, T init, Map map, Combine combine)
+{
+    if (scheduler) {
+        return scheduler->parallelReduce(count, grain, std::move(init), std::move(map), std::move(combine));
+    }
+
+    if (grain == 0) {
+        grain = 1;
+    }
+    for (std::size_t begin = 0; begin < count; begin += grain) {
+        const std::size_t end = std::min(count, begin + grain);
+        T partial = map(begin);
+        for (std::size_t i = begin + 1; i < end; ++i) {
+            partial = combine(std::move(partial), map(i));
+        }
+        init = combine(std::move(init), std::move(partial));
+    }
+    return init;
+}
+
+} // namespace artery
+
+#endif /* ARTERY_TASKSCHEDULER_H_V3NQ8ZKD */
@@ -0,0 +1,185 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/utility/Telemetry.h"
+#include "artery/utility/ReplicationFork.h"
+#include <omnetpp/cconfigurationex.h>
+#include <omnetpp/cenvir.h>
+#include <omnetpp/cfutureeventset.h>
+#include <omnetpp/csimulation.h>
+#include <cstdio>
+
+namespace artery
+{
+
+Define_Module(Telemetry)
+
+namespace
+{
+
+const omnetpp::simsignal_t scSignalTraciStep = omnetpp::cComponent::registerSignal("traci.step");
+const omnetpp::simsignal_t scSignalTraciSumoTime = omnetpp::cComponent::registerSignal("traciSumoTime");
+const omnetpp::simsignal_t scSignalNodeUpdate = omnetpp::cComponent::registerSignal("traci.node.update");
+
+} // namespace
+
+Telemetry::~Telemetry()
+{
+    stop();
+}
+
+void Telemetry::initialize()
+{
+    const std::string format = par("format").stdstringValue();
+    if (format != "json" && format != "line") {
+        throw omnetpp::cRuntimeError("unknown telemetry format \"%s\"", format.c_str());
+    }
+    const double interval = par("interval");
+    if (interval <= 0.0) {
+        throw omnetpp::cRuntimeError("telemetry interval has to be positive");
+    }
+
+    const std::string host = par("host").stdstringValue();
+    boost::system::error_code ec;
+    mEndpoint.address(boost::asio::ip::make_address(host, ec));
+    mEndpoint.port(static_cast<unsigned short>(par("port").intValue()));
+    if (!ec) {
+        mSocket.open(mEndpoint.protocol(), ec);
+    }
+    if (ec) {
+        throw omnetpp::cRuntimeError("cannot open telemetry socket to \"%s\": %s", host.c_str(), ec.message().c_str());
+    }
+
+    omnetpp::cModule* system = getSystemModule();
+    system->subscribe(scSignalTraciStep, this);
+    system->subscribe(scSignalTraciSumoTime, this);
+    system->subscribe(scSignalNodeUpdate, this);
+    system->subscribe(ReplicationFork::prepareSignal, this);
+    system->subscribe(ReplicationFork::resumeSignal, this);
+
+    mRunId = omnetpp::getEnvir()->getConfigEx()->getVariable("runid");
+    mInterval = std::chrono::milliseconds { static_cast<long>(interval * 1000.0) };
+    mJson = format == "json";
+    updateSnapshot();
+    start();
+}
+
+void Telemetry::finish()
+{
+    updateSnapshot();
+    stop();
+
+    omnetpp::cModule* system = getSystemModule();
+    system->unsubscribe(scSignalTraciStep, this);
+    system->unsubscribe(scSignalTraciSumoTime, this);
+    system->unsubscribe(scSignalNodeUpdate, this);
+    system->unsubscribe(ReplicationFork::prepareSignal, this);
+    system->unsubscribe(ReplicationFork::resumeSignal, this);
+}
+
+void Telemetry::receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t signal, bool, omnetpp::cObject*)
+{
+    // sampling thread does not survive fork, each process continues with a thread of its own
+    if (signal == ReplicationFork::prepareSignal) {
+        stop();
+    } else if (signal == ReplicationFork::resumeSignal) {
+        updateSnapshot();
+        start();
+    }
+}
+
+void Telemetry::receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t signal, unsigned long value, omnetpp::cObject*)
+{
+    if (signal == scSignalNodeUpdate) {
+        mNodes.store(value, std::memory_order_relaxed);
+    }
+}
+
+void Telemetry::receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t signal, double value, omnetpp::cObject*)
+{
+    if (signal == scSignalTraciSumoTime) {
+        mTraciStepTime.store(value, std::memory_order_relaxed);
+    }
+}
+
+void Telemetry::receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t signal, const omnetpp::SimTime&, omnetpp::cObject*)
+{
+    if (signal == scSignalTraciStep) {
+        updateSnapshot();
+    }
+}
+
+void Telemetry::updateSnapshot()
+{
+    omnetpp::cSimulation* simulation = getSimulation();
+    mSimTime.store(simulation->getSimTime().dbl(), std::memory_order_relaxed);
+    mEvents.store(simulation->getEventNumber(), std::memory_order_relaxed);
+    mFutureEvents.store(simulation->getFES()->getLength(), std::memory_order_relaxed);
+}
+
+void Telemetry::run(std::chrono::milliseconds interval, bool json)
+{
+    Sample last { std::chrono::steady_clock::now(), mSimTime.load(std::memory_order_relaxed),
+        mEvents.load(std::memory_order_relaxed) };
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (!mStopCondition.wait_for(lock, interval, [this] { return mStop; })) {
+        Sample current { std::chrono::steady_clock::now(), mSimTime.load(std::memory_order_relaxed),
+            mEvents.load(std::memory_order_relaxed) };
+        const double elapsed = std::chrono::duration<double>(current.wallTime - last.wallTime).count();
+        const double simsecPerSec = elapsed > 0.0 ? (current.simTime - last.simTime) / elapsed : 0.0;
+        const double eventsPerSec = elapsed > 0.0 ? (current.events - last.events) / elapsed : 0.0;
+        last = current;
+
+        const unsigned long long futureEvents = mFutureEvents.load(std::memory_order_relaxed);
+        const unsigned long long nodes = mNodes.load(std::memory_order_relaxed);
+        const double traciStepTime = mTraciStepTime.load(std::memory_order_relaxed);
+
+        char buffer[512];
+        int length = 0;
+        if (json) {
+            length = std::snprintf(buffer, sizeof(buffer),
+                "{\"run\":\"%s\",\"simtime\":%.6f,\"simsec_per_sec\":%.6g,\"events\":%lld,\"events_per_sec\":%.6g,"
+                "\"fes\":%llu,\"nodes\":%llu,\"traci_step_time\":%.6g}",
+                mRunId.c_str(), current.simTime, simsecPerSec, static_cast<long long>(current.events), eventsPerSec,
+                futureEvents, nodes, traciStepTime);
+        } else {
+            const auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            length = std::snprintf(buffer, sizeof(buffer),
+                "artery,run=%s simtime=%.6f,simsec_per_sec=%.6g,events=%lldi,events_per_sec=%.6g,"
+                "fes=%llui,nodes=%llui,traci_step_time=%.6g %lld",
+                mRunId.c_str(), current.simTime, simsecPerSec, static_cast<long long>(current.events), eventsPerSec,
+                futureEvents, nodes, traciStepTime, static_cast<long long>(timestamp));
+        }
+
+        if (length > 0 && static_cast<std::size_t>(length) < sizeof(buffer)) {
+            // telemetry is best effort, failed datagrams are not reported
+            boost::system::error_code ec;
+            mSocket.send_to(boost::asio::buffer(buffer, length), mEndpoint, 0, ec);
+        }
+    }
+}
+
+void Telemetry::start()
+{
+    if (!mThread.joinable()) {
+        mStop = false;
+        mThread = std::thread(&Telemetry::run, this, mInterval, mJson);
+    }
+}
+
+void Telemetry::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mStopCondition.notify_all();
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+}
+
+} // namespace artery
@@ -0,0 +1,78 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_TELEMETRY_H_H9XC4MTA
+#define ARTERY_TELEMETRY_H_H9XC4MTA
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/udp.hpp>
+#include <omnetpp/clistener.h>
+#include <omnetpp/csimplemodule.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace artery
+{
+
+/**
+ * Telemetry publishes progress counters of a running simulation as UDP datagrams.
+ *
+ * The simulation thread only stores a snapshot of its counters in relaxed atomics
+ * whenever TraCI has completed a step. A dedicated thread samples this snapshot at a wall-clock interval,
+ * derives rates from consecutive samples and sends them in JSON or InfluxDB line protocol format.
+ * This thread is stopped before ReplicationFork forks and restarted in every process afterwards.
+ */
+class Telemetry : public omnetpp::cSimpleModule, public omnetpp::cListener
+{
+public:
+    ~Telemetry();
+
+protected:
+    void initialize() override;
+    void finish() override;
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, bool, omnetpp::cObject*) override;
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, unsigned long, omnetpp::cObject*) override;
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, double, omnetpp::cObject*) override;
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, const omnetpp::SimTime&, omnetpp::cObject*) override;
+
+private:
+    struct Sample
+    {
+        std::chrono::steady_clock::time_point wallTime;
+        double simTime;
+        std::int64_t events;
+    };
+
+    void updateSnapshot();
+    void run(std::chrono::milliseconds interval, bool json);
+    void start();
+    void stop();
+
+    std::string mRunId;
+    std::chrono::milliseconds mInterval;
+    bool mJson = false;
+    std::atomic<double> mSimTime { 0.0 };
+    std::atomic<std::int64_t> mEvents { 0 };
+    std::atomic<std::uint64_t> mFutureEvents { 0 };
+    std::atomic<std::uint64_t> mNodes { 0 };
+    std::atomic<double> mTraciStepTime { 0.0 };
+
+    boost::asio::io_context mContext;
+    boost::asio::ip::udp::socket mSocket { mContext };
+    boost::asio::ip::udp::endpoint mEndpoint;
+    std::thread mThread;
+    std::mutex mMutex;
+    std::condition_variable mStopCondition;
+    bool mStop = false;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_TELEMETRY_H_H9XC4MTA */
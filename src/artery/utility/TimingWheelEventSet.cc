@@ -0,0 +1,380 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/utility/TimingWheelEventSet.h"
+#include <omnetpp/cconfigoption.h>
+#include <omnetpp/cconfiguration.h>
+#include <omnetpp/cenvir.h>
+#include <omnetpp/cevent.h>
+#include <omnetpp/cexception.h>
+#include <omnetpp/cvisitor.h>
+#include <omnetpp/regmacros.h>
+#include <algorithm>
+
+namespace artery
+{
+
+Register_Class(TimingWheelEventSet)
+Register_GlobalConfigOptionU(CFGID_TIMING_WHEEL_BUCKET_WIDTH, "timing-wheel-bucket-width", "s", "1ms",
+        "Time span covered by each bucket of artery::TimingWheelEventSet.")
+Register_GlobalConfigOption(CFGID_TIMING_WHEEL_BUCKETS, "timing-wheel-buckets", CFG_INT, "1024",
+        "Number of buckets of artery::TimingWheelEventSet, events beyond are parked in an overflow list.")
+
+namespace
+{
+
+/*
+ * cEvent tracks its scheduling state in a field reserved for cEventHeap,
+ * explicit instantiation grants access without modifying OMNeT++ (see C++ [temp.spec]).
+ */
+struct HeapIndexTag
+{
+    using type = int omnetpp::cEvent::*;
+    friend type member(HeapIndexTag);
+};
+
+template<typename Tag, typename Tag::type Member>
+struct ExposeMember
+{
+    friend typename Tag::type member(Tag) { return Member; }
+};
+
+template struct ExposeMember<HeapIndexTag, &omnetpp::cEvent::heapIndex>;
+
+int& heapIndex(omnetpp::cEvent* event)
+{
+    return event->*member(HeapIndexTag {});
+}
+
+} // namespace
+
+TimingWheelEventSet::TimingWheelEventSet(const char* name) :
+    omnetpp::cFutureEventSet(name)
+{
+    omnetpp::cConfiguration* config = omnetpp::getEnvir()->getConfig();
+    const omnetpp::SimTime width = config->getAsDouble(CFGID_TIMING_WHEEL_BUCKET_WIDTH);
+    const long buckets = config->getAsInt(CFGID_TIMING_WHEEL_BUCKETS);
+    if (width.raw() <= 0) {
+        throw omnetpp::cRuntimeError("timing-wheel-bucket-width has to be positive");
+    } else if (buckets < 1) {
+        throw omnetpp::cRuntimeError("timing-wheel-buckets has to be at least 1");
+    }
+    mBucketWidth = width.raw();
+    mWheel.resize(buckets);
+}
+
+TimingWheelEventSet::~TimingWheelEventSet()
+{
+    clear();
+}
+
+std::string TimingWheelEventSet::str() const
+{
+    return "length=" + std::to_string(mLength);
+}
+
+void TimingWheelEventSet::forEachChild(omnetpp::cVisitor* visitor)
+{
+    for (const Entry& entry : mEntries) {
+        if (entry.event && !visitor->visit(entry.event)) {
+            return;
+        }
+    }
+}
+
+void TimingWheelEventSet::insert(omnetpp::cEvent* event)
+{
+    take(event);
+    const int entry = allocate(event);
+    mEntries[entry].order = mInsertCount++;
+    place(entry);
+    ++mLength;
+    advance();
+}
+
+omnetpp::cEvent* TimingWheelEventSet::peekFirst() const
+{
+    if (!mFront.empty()) {
+        return mEntries[mFront.back()].event;
+    } else if (!mNear.empty()) {
+        return mEntries[mNear.front()].event;
+    } else {
+        return nullptr;
+    }
+}
+
+omnetpp::cEvent* TimingWheelEventSet::removeFirst()
+{
+    omnetpp::cEvent* event = peekFirst();
+    if (event) {
+        remove(event);
+    }
+    return event;
+}
+
+void TimingWheelEventSet::putBackFirst(omnetpp::cEvent* event)
+{
+    take(event);
+    const int entry = allocate(event);
+    mEntries[entry].location = Location::Front;
+    mEntries[entry].position = mFront.size();
+    mFront.push_back(entry);
+    ++mLength;
+}
+
+omnetpp::cEvent* TimingWheelEventSet::remove(omnetpp::cEvent* event)
+{
+    const int entry = heapIndex(event);
+    if (entry < 0 || entry >= static_cast<int>(mEntries.size()) || mEntries[entry].event != event) {
+        return nullptr;
+    }
+
+    unlink(entry);
+    release(entry);
+    --mLength;
+    advance();
+    drop(event);
+    return event;
+}
+
+void TimingWheelEventSet::clear()
+{
+    for (std::size_t i = 0; i < mEntries.size(); ++i) {
+        omnetpp::cEvent* event = mEntries[i].event;
+        if (event) {
+            release(i);
+            dropAndDelete(event);
+        }
+    }
+
+    mEntries.clear();
+    mFreeEntries.clear();
+    mFront.clear();
+    mNear.clear();
+    for (auto& bucket : mWheel) {
+        bucket.clear();
+    }
+    mFar.clear();
+    mSorted.clear();
+    mSortedValid = false;
+    mLength = 0;
+    mWheelLength = 0;
+    mCurrentBucket = 0;
+    mFarBucket = std::numeric_limits<std::int64_t>::max();
+}
+
+omnetpp::cEvent* TimingWheelEventSet::get(int k)
+{
+    if (!mSortedValid) {
+        sort();
+    }
+    return k >= 0 && k < static_cast<int>(mSorted.size()) ? mSorted[k] : nullptr;
+}
+
+void TimingWheelEventSet::sort()
+{
+    std::vector<int> entries(mFront.rbegin(), mFront.rend());
+    const std::size_t front = entries.size();
+    for (std::size_t i = 0; i < mEntries.size(); ++i) {
+        if (mEntries[i].event && mEntries[i].location != Location::Front) {
+            entries.push_back(i);
+        }
+    }
+    std::sort(entries.begin() + front, entries.end(), [this](int a, int b) { return precedes(a, b); });
+
+    mSorted.clear();
+    for (int entry : entries) {
+        mSorted.push_back(mEntries[entry].event);
+    }
+    mSortedValid = true;
+}
+
+bool TimingWheelEventSet::precedes(int a, int b) const
+{
+    // same order as cEventHeap
+    const Entry& lhs = mEntries[a];
+    const Entry& rhs = mEntries[b];
+    if (lhs.time != rhs.time) {
+        return lhs.time < rhs.time;
+    } else if (lhs.priority != rhs.priority) {
+        return lhs.priority < rhs.priority;
+    } else {
+        return lhs.order < rhs.order;
+    }
+}
+
+int TimingWheelEventSet::allocate(omnetpp::cEvent* event)
+{
+    int entry;
+    if (mFreeEntries.empty()) {
+        entry = mEntries.size();
+        mEntries.emplace_back();
+    } else {
+        entry = mFreeEntries.back();
+        mFreeEntries.pop_back();
+    }
+
+    Entry& slot = mEntries[entry];
+    slot.event = event;
+    slot.time = event->getArrivalTime().raw();
+    slot.priority = event->getSchedulingPriority();
+    slot.order = 0;
+    heapIndex(event) = entry;
+    mSortedValid = false;
+    return entry;
+}
+
+void TimingWheelEventSet::release(int entry)
+{
+    heapIndex(mEntries[entry].event) = -1;
+    mEntries[entry].event = nullptr;
+    mFreeEntries.push_back(entry);
+    mSortedValid = false;
+}
+
+void TimingWheelEventSet::place(int entry)
+{
+    Entry& slot = mEntries[entry];
+    const std::int64_t bucket = getBucket(slot.time);
+    if (bucket <= mCurrentBucket) {
+        pushNear(entry);
+    } else if (bucket - mCurrentBucket < static_cast<std::int64_t>(mWheel.size())) {
+        auto& events = mWheel[bucket % mWheel.size()];
+        slot.location = Location::Wheel;
+        slot.position = events.size();
+        events.push_back(entry);
+        ++mWheelLength;
+    } else {
+        slot.location = Location::Far;
+        slot.position = mFar.size();
+        mFar.push_back(entry);
+        mFarBucket = std::min(mFarBucket, bucket);
+    }
+}
+
+void TimingWheelEventSet::unlink(int entry)
+{
+    const Entry& slot = mEntries[entry];
+    auto swapRemove = [this](std::vector<int>& entries, std::size_t position) {
+        entries[position] = entries.back();
+        mEntries[entries[position]].position = position;
+        entries.pop_back();
+    };
+
+    switch (slot.location) {
+        case Location::Front:
+            mFront.erase(mFront.begin() + slot.position);
+            for (std::size_t i = slot.position; i < mFront.size(); ++i) {
+                mEntries[mFront[i]].position = i;
+            }
+            break;
+        case Location::Near:
+            eraseNear(slot.position);
+            break;
+        case Location::Wheel:
+            swapRemove(mWheel[getBucket(slot.time) % mWheel.size()], slot.position);
+            --mWheelLength;
+            break;
+        case Location::Far:
+            swapRemove(mFar, slot.position);
+            break;
+    }
+}
+
+void TimingWheelEventSet::advance()
+{
+    // keep earliest wheel events in near heap, i.e. peekFirst has nothing to do
+    while (mNear.empty() && mWheelLength + mFar.size() > 0) {
+        if (mWheelLength == 0) {
+            // skip empty buckets up to earliest parked event
+            mFarBucket = std::numeric_limits<std::int64_t>::max();
+            for (int entry : mFar) {
+                mFarBucket = std::min(mFarBucket, getBucket(mEntries[entry].time));
+            }
+            mCurrentBucket = mFarBucket - 1;
+        }
+
+        ++mCurrentBucket;
+        if (mFarBucket - mCurrentBucket < static_cast<std::int64_t>(mWheel.size())) {
+            migrateFar();
+        }
+
+        auto& events = mWheel[mCurrentBucket % mWheel.size()];
+        for (int entry : events) {
+            pushNear(entry);
+        }
+        mWheelLength -= events.size();
+        events.clear();
+    }
+}
+
+void TimingWheelEventSet::migrateFar()
+{
+    std::vector<int> parked;
+    parked.swap(mFar);
+    mFarBucket = std::numeric_limits<std::int64_t>::max();
+    for (int entry : parked) {
+        place(entry);
+    }
+}
+
+void TimingWheelEventSet::pushNear(int entry)
+{
+    mEntries[entry].location = Location::Near;
+    mEntries[entry].position = mNear.size();
+    mNear.push_back(entry);
+    siftUp(mNear.size() - 1);
+}
+
+void TimingWheelEventSet::eraseNear(std::size_t position)
+{
+    const int last = mNear.back();
+    mNear.pop_back();
+    if (position < mNear.size()) {
+        mNear[position] = last;
+        mEntries[last].position = position;
+        siftUp(position);
+        siftDown(mEntries[last].position);
+    }
+}
+
+void TimingWheelEventSet::siftUp(std::size_t position)
+{
+    const int entry = mNear[position];
+    while (position > 0) {
+        const std::size_t parent = (position - 1) / 2;
+        if (!precedes(entry, mNear[parent])) {
+            break;
+        }
+        mNear[position] = mNear[parent];
+        mEntries[mNear[position]].position = position;
+        position = parent;
+    }
+    mNear[position] = entry;
+    mEntries[entry].position = position;
+}
+
+void TimingWheelEventSet::siftDown(std::size_t position)
+{
+    const int entry = mNear[position];
+    while (true) {
+        std::size_t child = 2 * position + 1;
+        if (child >= mNear.size()) {
+            break;
+        } else if (child + 1 < mNear.size() && precedes(mNear[child + 1], mNear[child])) {
+            ++child;
+        }
+        if (!precedes(mNear[child], entry)) {
+            break;
+        }
+        mNear[position] = mNear[child];
+        mEntries[mNear[position]].position = position;
+        position = child;
+    }
+    mNear[position] = entry;
+    mEntries[entry].position = position;
+}
+
+} // namespace artery
@@ -0,0 +1,98 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_TIMINGWHEELEVENTSET_H_R7XK2PLE
+#define ARTERY_TIMINGWHEELEVENTSET_H_R7XK2PLE
+
+#include <omnetpp/cfutureeventset.h>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace artery
+{
+
+/**
+ * TimingWheelEventSet is a future event set optimised for many periodic timers.
+ *
+ * Events due within the current bucket are kept in a small binary heap, events due within the
+ * wheel's horizon are appended unsorted to their bucket and later events are parked in an overflow list.
+ * Hence, inserting an event is O(1) unless it is due in the current bucket.
+ * Events are ordered like by cEventHeap, i.e. by arrival time, scheduling priority and insertion order,
+ * thus fingerprints are not affected by choosing this event set.
+ *
+ * Select by "futureeventset-class = artery::TimingWheelEventSet",
+ * bucket width and count are set by the global options "timing-wheel-bucket-width" and "timing-wheel-buckets".
+ */
+class TimingWheelEventSet : public omnetpp::cFutureEventSet
+{
+public:
+    TimingWheelEventSet(const char* name = nullptr);
+    TimingWheelEventSet(const TimingWheelEventSet&) = delete;
+    TimingWheelEventSet& operator=(const TimingWheelEventSet&) = delete;
+    ~TimingWheelEventSet();
+
+    std::string str() const override;
+    void forEachChild(omnetpp::cVisitor*) override;
+
+    void insert(omnetpp::cEvent*) override;
+    omnetpp::cEvent* peekFirst() const override;
+    omnetpp::cEvent* removeFirst() override;
+    void putBackFirst(omnetpp::cEvent*) override;
+    omnetpp::cEvent* remove(omnetpp::cEvent*) override;
+    bool isEmpty() const override { return mLength == 0; }
+    void clear() override;
+    int getLength() const override { return mLength; }
+    omnetpp::cEvent* get(int k) override;
+    void sort() override;
+
+private:
+    enum class Location { Front, Near, Wheel, Far };
+
+    struct Entry
+    {
+        omnetpp::cEvent* event;
+        std::int64_t time;
+        short priority;
+        std::uint64_t order;
+        Location location;
+        std::size_t position;
+    };
+
+    bool precedes(int a, int b) const;
+    std::int64_t getBucket(std::int64_t time) const { return time / mBucketWidth; }
+    int allocate(omnetpp::cEvent*);
+    void release(int entry);
+    void place(int entry);
+    void unlink(int entry);
+    void advance();
+    void migrateFar();
+
+    void pushNear(int entry);
+    void eraseNear(std::size_t position);
+    void siftUp(std::size_t position);
+    void siftDown(std::size_t position);
+
+    std::int64_t mBucketWidth;
+    std::int64_t mCurrentBucket = 0; /*< near heap holds all events up to this bucket */
+    std::int64_t mFarBucket = std::numeric_limits<std::int64_t>::max(); /*< lower bound of buckets in overflow list */
+    std::uint64_t mInsertCount = 0;
+    int mLength = 0;
+    std::size_t mWheelLength = 0;
+
+    std::vector<Entry> mEntries;
+    std::vector<int> mFreeEntries;
+    std::vector<int> mFront; /*< events put back, last one is first */
+    std::vector<int> mNear; /*< binary heap */
+    std::vector<std::vector<int>> mWheel;
+    std::vector<int> mFar;
+    std::vector<omnetpp::cEvent*> mSorted; /*< snapshot for get(k) */
+    bool mSortedValid = false;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_TIMINGWHEELEVENTSET_H_R7XK2PLE */
@@ -0,0 +1,219 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "artery/utility/VehicleGeometryIndex.h"
+#include "artery/traci/Cast.h"
+#include "traci/SubscriptionManager.h"
+#include "traci/VariableCache.h"
+#include <boost/geometry.hpp>
+#include <omnetpp/checkandcast.h>
+#include <cmath>
+
+namespace artery
+{
+
+Define_Module(VehicleGeometryIndex)
+
+using namespace omnetpp;
+namespace bg = boost::geometry;
+
+const simsignal_t VehicleGeometryIndex::updateSignal = cComponent::registerSignal("VehicleGeometryIndex.update");
+
+void VehicleGeometryIndex::initialize()
+{
+    cModule* traci = getModuleByPath(par("traciModule"));
+    if (traci) {
+        traci->subscribe(traci::BasicNodeManager::updateNodeSignal, this);
+        traci->subscribe(traci::BasicNodeManager::updateVehiclesSignal, this);
+        traci->subscribe(traci::BasicNodeManager::addVehicleSignal, this);
+        traci->subscribe(traci::BasicNodeManager::removeVehicleSignal, this);
+    } else {
+        throw cRuntimeError("No TraCI module found for signal subscription");
+    }
+
+    mVehicleMargin = std::abs(par("vehicleMargin").doubleValue());
+    mLooseBoxMargin = std::abs(par("looseBoxMargin").doubleValue());
+}
+
+void VehicleGeometryIndex::receiveSignal(cComponent* source, simsignal_t signal, unsigned long, cObject* obj)
+{
+    Enter_Method_Silent();
+    if (signal == traci::BasicNodeManager::updateNodeSignal) {
+        if (mLooseBoxMargin > 0.0) {
+            updateRtree();
+        } else {
+            buildRtree();
+        }
+        ++mRevision;
+        emit(updateSignal, this);
+    }
+}
+
+void VehicleGeometryIndex::receiveSignal(cComponent* source, simsignal_t signal, const char* id, cObject* obj)
+{
+    Enter_Method_Silent();
+    if (signal == traci::BasicNodeManager::addVehicleSignal) {
+        auto manager = check_and_cast<traci::BasicNodeManager*>(source);
+        const traci::NodeHandle handle = manager->getNodeHandles().find(id);
+        ASSERT(handle != traci::NodeHandleRegistry::invalid);
+        if (handle >= mVehicles.size()) {
+            mVehicles.resize(handle + 1);
+        }
+
+        if (!mVehicles[handle]) {
+            auto cache = manager->getSubscriptions()->getVehicleCache(id);
+            const Vehicle& vehicle = mVehicles[handle].emplace(manager->getBoundary(), *cache, mVehicleMargin);
+            RtreeValue value {
+                bg::return_envelope<RtreeValue::first_type>(vehicle.getOutline()),
+                handle };
+            if (mLooseBoxMargin > 0.0) {
+                if (handle >= mLooseBoxes.size()) {
+                    mLooseBoxes.resize(handle + 1);
+                }
+                value.first = getLooseBox(vehicle);
+                mLooseBoxes[handle] = value.first;
+            }
+            mRtree.insert(std::move(value));
+            ++mVehicleCount;
+            ++mRevision;
+        }
+    } else if (signal == traci::BasicNodeManager::removeVehicleSignal) {
+        auto manager = check_and_cast<traci::BasicNodeManager*>(source);
+        const traci::NodeHandle handle = manager->getNodeHandles().find(id);
+        if (handle < mVehicles.size() && mVehicles[handle]) {
+            mVehicles[handle].reset();
+            --mVehicleCount;
+            if (mLooseBoxMargin > 0.0) {
+                // incremental mode: rtree must not refer to released handle
+                mRtree.remove(RtreeValue { mLooseBoxes[handle], handle });
+            }
+        }
+        mRtreeTainted = true;
+    }
+}
+
+void VehicleGeometryIndex::receiveSignal(cComponent*, simsignal_t signal, cObject* obj, cObject*)
+{
+    Enter_Method_Silent();
+    if (signal == traci::BasicNodeManager::updateVehiclesSignal) {
+        updateVehicles(*check_and_cast<traci::BasicNodeManager::VehicleUpdates*>(obj));
+    }
+}
+
+void VehicleGeometryIndex::updateVehicles(const traci::BasicNodeManager::VehicleUpdates& updates)
+{
+    for (const auto& update : updates) {
+        if (update.handle < mVehicles.size() && mVehicles[update.handle]) {
+            mVehicles[update.handle]->update(update.position, update.heading);
+        }
+    }
+    mRtreeTainted = true;
+}
+
+void VehicleGeometryIndex::buildRtree()
+{
+    mRtreeValues.clear();
+    for (traci::NodeHandle handle = 0; handle < mVehicles.size(); ++handle) {
+        if (mVehicles[handle]) {
+            const Vehicle& vehicle = *mVehicles[handle];
+            mRtreeValues.emplace_back(bg::return_envelope<geometry::Box>(vehicle.getOutline()), handle);
+        }
+    }
+    mRtree = Rtree(mRtreeValues.begin(), mRtreeValues.end());
+    mRtreeTainted = false;
+}
+
+void VehicleGeometryIndex::updateRtree()
+{
+    ASSERT(mVehicleCount == mRtree.size());
+    for (traci::NodeHandle handle = 0; handle < mVehicles.size(); ++handle) {
+        if (mVehicles[handle]) {
+            const Vehicle& vehicle = *mVehicles[handle];
+            geometry::Box& loose = mLooseBoxes[handle];
+            if (!bg::covered_by(bg::return_envelope<geometry::Box>(vehicle.getOutline()), loose)) {
+                // vehicle left its loose box: re-insert with a fresh one
+                mRtree.remove(RtreeValue { loose, handle });
+                loose = getLooseBox(vehicle);
+                mRtree.insert(RtreeValue { loose, handle });
+            }
+        }
+    }
+    mRtreeTainted = false;
+}
+
+geometry::Box VehicleGeometryIndex::getLooseBox(const Vehicle& vehicle) const
+{
+    auto box = bg::return_envelope<geometry::Box>(vehicle.getOutline());
+    geometry::Point& min = box.min_corner();
+    geometry::Point& max = box.max_corner();
+    min.set<0>(min.get<0>() - mLooseBoxMargin);
+    min.set<1>(min.get<1>() - mLooseBoxMargin);
+    max.set<0>(max.get<0>() + mLooseBoxMargin);
+    max.set<1>(max.get<1>() + mLooseBoxMargin);
+    return box;
+}
+
+void VehicleGeometryIndex::queryEnvelopes(const geometry::Box& box, const std::function<void(const Vehicle&)>& visitor) const
+{
+    ASSERT(!mRtreeTainted);
+    auto rtree_intersect = bg::index::intersects(box);
+    for (auto it = mRtree.qbegin(rtree_intersect); it != mRtree.qend(); ++it) {
+        visitor(*mVehicles[it->second]);
+    }
+}
+
+VehicleGeometryIndex::Vehicle::Vehicle(const traci::Boundary& boundary, traci::VehicleCache& cache, double margin) :
+    mId(cache.getVehicleId()), mBoundary(boundary), mHeight(0.0)
+{
+    // vehicle type attributes are shared by all vehicles of a type
+    auto vtype = cache.getTypeCache();
+    mHeight = vtype->get<libsumo::VAR_HEIGHT>();
+    createLocalOutline(vtype->get<libsumo::VAR_WIDTH>(), vtype->get<libsumo::VAR_LENGTH>(), margin);
+    update(cache.get<libsumo::VAR_POSITION>(), traci::TraCIAngle { cache.get<libsumo::VAR_ANGLE>() });
+}
+
+void VehicleGeometryIndex::Vehicle::update(const traci::TraCIPosition& pos, traci::TraCIAngle heading)
+{
+    mPosition = traci::position_cast(mBoundary, pos);
+    mHeading = traci::angle_cast(heading);
+    calculateWorldOutline();
+}
+
+void VehicleGeometryIndex::Vehicle::createLocalOutline(double width, double length, double margin)
+{
+    // vehicle corner points in clockwise order, center of front bumper at origin, heading east
+    mLocalOutline = {
+        Position(margin, 0.5 * width + margin),
+        Position(margin, -(0.5 * width + margin)),
+        Position(-(length + margin), -(0.5 * width + margin)),
+        Position(-(length + margin), 0.5 * width + margin)
+    };
+    mLocalMidpoint = Position { -0.5 * length, 0.0 };
+    mWorldOutline.resize(mLocalOutline.size());
+}
+
+void VehicleGeometryIndex::Vehicle::calculateWorldOutline()
+{
+    // same clockwise rotation followed by translation as boost's rotate and translate transformers
+    const double c = std::cos(mHeading.radian());
+    const double s = std::sin(mHeading.radian());
+    const double px = mPosition.x.value();
+    const double py = mPosition.y.value();
+    auto transform = [=](const Position& local) {
+        const double x = local.x.value();
+        const double y = local.y.value();
+        return Position { c * x + s * y + px, -s * x + c * y + py };
+    };
+
+    for (std::size_t i = 0; i < mLocalOutline.size(); ++i) {
+        mWorldOutline[i] = transform(mLocalOutline[i]);
+    }
+    mWorldMidpoint = transform(mLocalMidpoint);
+
+    ASSERT(mWorldOutline.size() == mLocalOutline.size());
+    ASSERT(bg::is_valid(mWorldOutline));
+}
+
+} // namespace artery
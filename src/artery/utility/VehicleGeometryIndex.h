@@ -0,0 +1,150 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_VEHICLEGEOMETRYINDEX_H_X2PK7QAM
+#define ARTERY_VEHICLEGEOMETRYINDEX_H_X2PK7QAM
+
+#include "artery/utility/Geometry.h"
+#include "traci/Angle.h"
+#include "traci/BasicNodeManager.h"
+#include "traci/Boundary.h"
+#include "traci/NodeHandle.h"
+#include "traci/Position.h"
+#include <boost/geometry/index/rtree.hpp>
+#include <omnetpp/clistener.h>
+#include <omnetpp/csimplemodule.h>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+// forward declaration
+namespace traci { class VehicleCache; }
+
+namespace artery
+{
+
+/**
+ * VehicleGeometryIndex keeps outlines and heights of all SUMO vehicles in a spatial index.
+ *
+ * It is updated once per TraCI step and can be shared by several consumers,
+ * e.g. the environment model and GEMV2's vehicle index.
+ * Consumers should react on updateSignal instead of TraCI's update signal,
+ * the index is guaranteed to be up-to-date then.
+ */
+class VehicleGeometryIndex : public omnetpp::cSimpleModule, public omnetpp::cListener
+{
+public:
+    class Vehicle
+    {
+    public:
+        Vehicle(const traci::Boundary&, traci::VehicleCache&, double margin = 0.0);
+        void update(const traci::TraCIPosition& pos, traci::TraCIAngle heading);
+        const std::string& getId() const { return mId; }
+        const std::vector<Position>& getOutline() const { return mWorldOutline; }
+        const double getHeight() const { return mHeight; }
+        const Position& getMidpoint() const { return mWorldMidpoint; }
+
+    private:
+        void createLocalOutline(double width, double length, double margin);
+        void calculateWorldOutline();
+
+        std::string mId;
+        traci::Boundary mBoundary;
+        double mHeight;
+        Angle mHeading;
+        Position mPosition;
+        Position mLocalMidpoint;
+        Position mWorldMidpoint;
+        std::array<Position, 4> mLocalOutline;
+        std::vector<Position> mWorldOutline; /*< always four corners, overwritten in place */
+    };
+
+    using VehicleSlots = std::vector<std::optional<Vehicle>>;
+    using RtreeValue = std::pair<geometry::Box, traci::NodeHandle>;
+    using Rtree = boost::geometry::index::rtree<RtreeValue, boost::geometry::index::rstar<16>>;
+
+    static const omnetpp::simsignal_t updateSignal;
+
+    // cSimpleModule
+    void initialize() override;
+
+    // cListener
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, unsigned long, omnetpp::cObject*) override;
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, const char*, omnetpp::cObject*) override;
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, omnetpp::cObject*, omnetpp::cObject*) override;
+
+    /**
+     * Get all indexed vehicles
+     * \return vehicles indexed by their node handle (slots of released handles are empty)
+     */
+    const VehicleSlots& getVehicles() const { return mVehicles; }
+
+    /**
+     * Get number of indexed vehicles, i.e. occupied slots
+     */
+    std::size_t getVehicleCount() const { return mVehicleCount; }
+
+    /**
+     * Get spatial index of vehicles
+     *
+     * Boxes may be enlarged by looseBoxMargin, thus candidates of queries need to be checked precisely.
+     * \return rtree of vehicle boxes and their node handles
+     */
+    const Rtree& getRtree() const { return mRtree; }
+
+    /**
+     * Check if vehicles have been modified since the rtree has been updated
+     */
+    bool isTainted() const { return mRtreeTainted; }
+
+    /**
+     * Get revision of indexed vehicle positions
+     * \return counter incremented whenever vehicles are added or the index is updated
+     */
+    unsigned long getRevision() const { return mRevision; }
+
+    /**
+     * Call visitor for each vehicle whose (loose) box intersects the given box
+     * \param box query box
+     * \param visitor invoked with indexed vehicle
+     */
+    void queryEnvelopes(const geometry::Box& box, const std::function<void(const Vehicle&)>& visitor) const;
+
+private:
+    void updateVehicles(const traci::BasicNodeManager::VehicleUpdates&);
+
+    /**
+     * Rebuild rtree from scratch by bulk loading
+     */
+    void buildRtree();
+
+    /**
+     * Update rtree incrementally using loose boxes:
+     * only vehicles which have left their loose box are re-inserted.
+     */
+    void updateRtree();
+
+    /**
+     * Get loose box enclosing a vehicle's outline with configured margin
+     */
+    geometry::Box getLooseBox(const Vehicle&) const;
+
+    VehicleSlots mVehicles;
+    std::size_t mVehicleCount = 0;
+    Rtree mRtree;
+    std::vector<RtreeValue> mRtreeValues; /*< bulk loading buffer */
+    std::vector<geometry::Box> mLooseBoxes; /*< indexed by node handle like mVehicles */
+    double mLooseBoxMargin = 0.0;
+    double mVehicleMargin = 0.0;
+    bool mRtreeTainted = false;
+    unsigned long mRevision = 0;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_VEHICLEGEOMETRYINDEX_H_X2PK7QAM */
@@ -0,0 +1,62 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef ARTERY_XMLCONFIGCACHE_H_B7NW2QLE
+#define ARTERY_XMLCONFIGCACHE_H_B7NW2QLE
+
+#include <omnetpp/cconfiguration.h>
+#include <omnetpp/cenvir.h>
+#include <omnetpp/csimulation.h>
+#include <string>
+#include <unordered_map>
+
+namespace omnetpp { class cXMLElement; }
+
+namespace artery
+{
+
+/**
+ * Cache of plans compiled from XML configuration elements
+ *
+ * OMNeT++ keeps loaded XML documents for a whole run, thus their elements can serve as keys.
+ * All cached plans are discarded when another run begins.
+ */
+template<typename T>
+class XmlConfigCache
+{
+public:
+    /**
+     * Get plan of XML element, compiled on first request
+     * \param element XML configuration element
+     * \param compile callable creating a T from a const cXMLElement&
+     * \return cached plan, valid until end of run
+     */
+    template<typename F>
+    const T& get(const omnetpp::cXMLElement* element, F compile)
+    {
+        const char* run = omnetpp::getEnvir()->getConfigEx()->getVariable(CFGVAR_RUNID);
+        if (!run) {
+            run = "";
+        }
+        if (mRunId != run) {
+            mEntries.clear();
+            mRunId = run;
+        }
+
+        auto found = mEntries.find(element);
+        if (found == mEntries.end()) {
+            found = mEntries.emplace(element, compile(*element)).first;
+        }
+        return found->second;
+    }
+
+private:
+    std::string mRunId;
+    std::unordered_map<const omnetpp::cXMLElement*, T> mEntries;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_XMLCONFIGCACHE_H_B7NW2QLE */
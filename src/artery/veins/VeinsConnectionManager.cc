@@ -1,5 +1,6 @@
 #include "artery/veins/VeinsConnectionManager.h"
 #include <omnetpp/ccomponent.h>
+#include <limits>
 
 namespace artery
 {
@@ -12,10 +13,19 @@ namespace
 const simsignal_t removeNodeSignal = cComponent::registerSignal("traci.node.remove");
 }
 
+VeinsConnectionManager::~VeinsConnectionManager()
+{
+    cancelAndDelete(mFlushEvent);
+}
+
 void VeinsConnectionManager::initialize(int stage)
 {
     if (stage == 0) {
         getSystemModule()->subscribe(removeNodeSignal, this);
+        mBatchUpdates = par("batchUpdates");
+        mFlushEvent = new cMessage("flush connection updates");
+        // run before any other event at the same time, e.g. transmissions
+        mFlushEvent->setSchedulingPriority(std::numeric_limits<short>::min());
     }
 
     ConnectionManager::initialize(stage);
@@ -24,14 +34,52 @@ void VeinsConnectionManager::initialize(int stage)
 void VeinsConnectionManager::finish()
 {
     getSystemModule()->unsubscribe(removeNodeSignal, this);
+    flushConnections();
     ConnectionManager::finish();
 }
 
+void VeinsConnectionManager::handleMessage(cMessage* msg)
+{
+    if (msg == mFlushEvent) {
+        flushConnections();
+    } else {
+        ConnectionManager::handleMessage(msg);
+    }
+}
+
+void VeinsConnectionManager::updateConnections(int nicID, const veins::Coord* oldPos, const veins::Coord* newPos)
+{
+    if (!mBatchUpdates || !oldPos) {
+        ConnectionManager::updateConnections(nicID, oldPos, newPos);
+        return;
+    }
+
+    Enter_Method_Silent();
+    // only the position before the first move matters for leaving grid cells
+    mPendingUpdates.emplace(nicID, *oldPos);
+    if (!mFlushEvent->isScheduled()) {
+        scheduleAt(simTime(), mFlushEvent);
+    }
+}
+
+void VeinsConnectionManager::flushConnections()
+{
+    for (const auto& pending : mPendingUpdates) {
+        auto nic = nics.find(pending.first);
+        if (nic != nics.end()) {
+            const veins::Coord position = nic->second->pos;
+            ConnectionManager::updateConnections(pending.first, &pending.second, &position);
+        }
+    }
+    mPendingUpdates.clear();
+}
+
 void VeinsConnectionManager::receiveSignal(cComponent* src, simsignal_t signal, const char* id, cObject* module)
 {
     if (signal == removeNodeSignal) {
         cModule* nic = check_and_cast<cModule*>(module)->getSubmodule("nic");
         if (nic) {
+            mPendingUpdates.erase(nic->getId());
             this->unregisterNic(nic);
         }
     }
@@ -3,6 +3,8 @@
 
 #include <veins/base/connectionManager/ConnectionManager.h>
 #include <omnetpp/clistener.h>
+#include <omnetpp/cmessage.h>
+#include <map>
 
 namespace artery
 {
@@ -14,13 +16,28 @@ namespace artery
  * when the respective nodes (vehicles) are removed from OMNeT++.
  * Originally,this is done by Veins' TraCIScenarioManager.
  * Note: NICs register automatically at the networks' connection manager.
+ *
+ * Optionally, connection updates of moving NICs are batched: all NICs moved by a TraCI step
+ * are reconnected in one pass right after the step, once per NIC with its final position.
  */
 class VeinsConnectionManager : public veins::ConnectionManager, public omnetpp::cListener
 {
 public:
+    ~VeinsConnectionManager();
     void initialize(int stage) override;
     void finish() override;
+    void handleMessage(omnetpp::cMessage*) override;
     void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, const char*, omnetpp::cObject*) override;
+
+protected:
+    void updateConnections(int nicID, const veins::Coord* oldPos, const veins::Coord* newPos) override;
+
+private:
+    void flushConnections();
+
+    bool mBatchUpdates = false;
+    omnetpp::cMessage* mFlushEvent = nullptr;
+    std::map<int, veins::Coord> mPendingUpdates; /*< NIC id and position before its first deferred move */
 };
 
 } // namespace artery
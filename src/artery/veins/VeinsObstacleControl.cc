@@ -31,21 +31,22 @@ void VeinsObstacleControl::traciInit()
 
 void VeinsObstacleControl::fetchObstacles(std::shared_ptr<traci::API> traci)
 {
-    auto& polygons = traci->polygon;
     const traci::Boundary boundary { traci->simulation.getNetBoundary() };
+    auto filter = [this](const traci::API::Polygon& polygon) {
+        return this->isTypeSupported(polygon.type);
+    };
+
     unsigned fetched = 0;
-    for (const std::string& id : polygons.getIDList()) {
-        std::string type = polygons.getType(id);
-        if (this->isTypeSupported(type)) {
-            std::vector<veins::Coord> shape;
-            for (const traci::TraCIPosition& traci_point : polygons.getShape(id).value) {
-                using boost::units::si::meter;
-                Position point = traci::position_cast(boundary, traci_point);
-                shape.push_back(veins::Coord { point.x / meter, point.y / meter});
-            }
-            this->addFromTypeAndShape(id, type, shape);
-            ++fetched;
+    for (const traci::API::Polygon& polygon : traci->getPolygons(traci->polygon.getIDList(), filter)) {
+        std::vector<veins::Coord> shape;
+        shape.reserve(polygon.shape.value.size());
+        for (const traci::TraCIPosition& traci_point : polygon.shape.value) {
+            using boost::units::si::meter;
+            Position point = traci::position_cast(boundary, traci_point);
+            shape.push_back(veins::Coord { point.x / meter, point.y / meter});
         }
+        this->addFromTypeAndShape(polygon.id, polygon.type, shape);
+        ++fetched;
     }
     EV_INFO << "Added " << fetched << " obstacles to " << this->getFullPath() << endl;
 }
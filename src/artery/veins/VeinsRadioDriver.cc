@@ -1,4 +1,4 @@
-#include "artery/networking/GeoNetIndication.h"
+#include "artery/networking/GeoNetPacket.h"
 #include "artery/networking/GeoNetRequest.h"
 #include "artery/nic/RadioDriverProperties.h"
 #include "artery/veins/VeinsMacFrame.h"
@@ -7,6 +7,7 @@
 #include "veins/base/utils/SimpleAddress.h"
 #include "veins/modules/mac/ieee80211p/Mac1609_4.h"
 #include "veins/modules/utility/Consts80211p.h"
+#include <cmath>
 
 using namespace omnetpp;
 
@@ -70,6 +71,11 @@ const simsignal_t channelBusySignal = veins::Mac1609_4::sigChannelBusy;
 
 } // namespace
 
+VeinsRadioDriver::~VeinsRadioDriver()
+{
+    cancelAndDelete(mChannelLoadReport);
+}
+
 void VeinsRadioDriver::initialize()
 {
     RadioDriverBase::initialize();
@@ -80,9 +86,20 @@ void VeinsRadioDriver::initialize()
     mLowerLayerIn = gate("lowerLayerIn");
 
     mChannelLoadSampler.reset();
-    mChannelLoadReport = new cMessage("report channel load");
     mChannelLoadReportInterval = par("channelLoadReportInterval");
-    scheduleAt(simTime() + mChannelLoadReportInterval, mChannelLoadReport);
+    if (par("asyncChannelReport").boolValue()) {
+        mChannelLoadReport = new cMessage("report channel load");
+        scheduleAt(simTime() + mChannelLoadReportInterval, mChannelLoadReport);
+    } else if (auto reporter = dynamic_cast<ChannelLoadReporter*>(getModuleByPath(par("channelLoadReporterModule")))) {
+        if (reporter->getInterval() != mChannelLoadReportInterval) {
+            throw cRuntimeError("interval of channel load reporter differs from channelLoadReportInterval");
+        }
+        reporter->subscribe(this);
+    } else {
+        mChannelLoadReport = new cMessage("report channel load");
+        double cycle = simTime() / mChannelLoadReportInterval;
+        scheduleAt((1.0 + std::ceil(cycle)) * mChannelLoadReportInterval, mChannelLoadReport);
+    }
 
     auto properties = new RadioDriverProperties();
     // Mac1609_4 uses index of host as MAC address
@@ -107,14 +124,18 @@ void VeinsRadioDriver::handleMessage(cMessage* msg)
     }
 }
 
+void VeinsRadioDriver::reportChannelLoad()
+{
+    Enter_Method_Silent();
+    emit(RadioDriverBase::ChannelLoadSignal, mChannelLoadSampler.cbr());
+}
+
 void VeinsRadioDriver::handleDataIndication(cMessage* packet)
 {
     auto frame = check_and_cast<VeinsMacFrame*>(packet);
-    auto gn = frame->decapsulate();
-    auto* indication = new GeoNetIndication();
-    indication->source = convert(frame->getSenderAddress());
-    indication->destination = convert(frame->getRecipientAddress());
-    gn->setControlInfo(indication);
+    auto gn = check_and_cast<GeoNetPacket*>(frame->decapsulate());
+    gn->setSourceAddress(convert(frame->getSenderAddress()));
+    gn->setDestinationAddress(convert(frame->getRecipientAddress()));
     delete frame;
 
     indicateData(gn);
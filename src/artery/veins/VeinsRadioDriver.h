@@ -1,6 +1,7 @@
 #ifndef VEINSRADIODRIVER_H_ZJ0SI5XC
 #define VEINSRADIODRIVER_H_ZJ0SI5XC
 
+#include "artery/nic/ChannelLoadReporter.h"
 #include "artery/nic/ChannelLoadSampler.h"
 #include "artery/nic/RadioDriverBase.h"
 #include <omnetpp/clistener.h>
@@ -9,9 +10,10 @@
 namespace artery
 {
 
-class VeinsRadioDriver : public RadioDriverBase, public omnetpp::cListener
+class VeinsRadioDriver : public RadioDriverBase, public omnetpp::cListener, public ChannelLoadReporter::Client
 {
 	public:
+		~VeinsRadioDriver();
 		void initialize() override;
 		void handleMessage(omnetpp::cMessage*) override;
 
@@ -19,6 +21,7 @@ class VeinsRadioDriver : public RadioDriverBase, public omnetpp::cListener
 		void handleDataIndication(omnetpp::cMessage*);
 		void handleDataRequest(omnetpp::cMessage*) override;
 		void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, bool, omnetpp::cObject*) override;
+		void reportChannelLoad() override;
 
 	private:
 		omnetpp::cModule* mHost = nullptr;
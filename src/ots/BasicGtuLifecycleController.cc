@@ -1,6 +1,7 @@
 #include "ots/BasicGtuLifecycleController.h"
 #include <omnetpp/ccomponenttype.h>
 #include <omnetpp/cmessage.h>
+#include <algorithm>
 
 namespace ots
 {
@@ -14,7 +15,7 @@ using namespace omnetpp;
 const simsignal_t otsLifecycleSignal = cComponent::registerSignal("ots-lifecycle");
 const simsignal_t otsGtuAddSignal = cComponent::registerSignal("ots-gtu-add");
 const simsignal_t otsGtuRemoveSignal = cComponent::registerSignal("ots-gtu-remove");
-const simsignal_t otsGtuPositionSignal = cComponent::registerSignal("ots-gtu-position");
+const simsignal_t otsGtuPositionsSignal = cComponent::registerSignal("ots-gtu-positions");
 
 class InsertionMessage : public omnetpp::cMessage
 {
@@ -37,7 +38,7 @@ void BasicGtuLifecycleController::initialize()
         emitter->subscribe(otsLifecycleSignal, this);
         emitter->subscribe(otsGtuAddSignal, this);
         emitter->subscribe(otsGtuRemoveSignal, this);
-        emitter->subscribe(otsGtuPositionSignal, this);
+        emitter->subscribe(otsGtuPositionsSignal, this);
     }
 
     m_creation_policy = dynamic_cast<GtuCreationPolicy*>(getSubmodule("creationPolicy"));
@@ -63,9 +64,10 @@ void BasicGtuLifecycleController::receiveSignal(omnetpp::cComponent*, omnetpp::s
 {
     if (signal == otsLifecycleSignal && !flag) {
         m_pending_gtus.clear();
-        m_gtu_sinks.clear();
-        while (!m_nodes.empty()) {
-            removeModule(m_nodes.begin()->first);
+        m_applied_sinks.clear();
+        removeModules();
+        while (!m_gtu_handles.empty()) {
+            removeModule(m_gtu_handles.begin()->first);
         }
     }
 }
@@ -83,10 +85,10 @@ void BasicGtuLifecycleController::receiveSignal(omnetpp::cComponent*, omnetpp::s
 
 void BasicGtuLifecycleController::receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t signal, omnetpp::cObject* obj, omnetpp::cObject*)
 {
-    if (signal == otsGtuPositionSignal) {
-        auto gtu = dynamic_cast<GtuObject*>(obj);
-        if (gtu) {
-            updateGtu(*gtu);
+    if (signal == otsGtuPositionsSignal) {
+        auto gtus = dynamic_cast<GtuObjectList*>(obj);
+        if (gtus) {
+            updateGtus(*gtus);
         }
     } else {
         EV_WARN << "ignoring unknown signal\n";
@@ -95,19 +97,53 @@ void BasicGtuLifecycleController::receiveSignal(omnetpp::cComponent*, omnetpp::s
 
 void BasicGtuLifecycleController::addGtu(const std::string& id)
 {
+    if (std::find(m_pending_removals.begin(), m_pending_removals.end(), id) != m_pending_removals.end()) {
+        // re-used id gets a new module, i.e. removal of its predecessor cannot wait
+        removeModules();
+    }
     m_pending_gtus.insert(std::make_pair(id, nullptr));
 }
 
 void BasicGtuLifecycleController::removeGtu(const std::string& id)
 {
-    removeModule(id);
+    // modules are removed along with the next position updates
+    if (getModule(id)) {
+        m_pending_removals.push_back(id);
+    } else {
+        EV_ERROR << "cannot remove non-existing GTU module for id " << id << "\n";
+    }
     m_pending_gtus.erase(id);
-    m_gtu_sinks.erase(id);
 }
 
 void BasicGtuLifecycleController::updateGtu(const GtuObject& obj)
 {
     Enter_Method_Silent();
+    removeModules();
+    if (GtuSink* sink = applyGtu(obj)) {
+        sink->notify();
+    }
+}
+
+void BasicGtuLifecycleController::updateGtus(const GtuObjectList& gtus)
+{
+    Enter_Method_Silent();
+    removeModules();
+    // apply positions of all GTUs before any mobility listener is notified
+    m_applied_sinks.clear();
+    m_applied_sinks.reserve(gtus.size());
+    for (const GtuObject& gtu : gtus) {
+        if (GtuSink* sink = applyGtu(gtu)) {
+            m_applied_sinks.push_back(sink);
+        }
+    }
+    for (GtuSink* sink : m_applied_sinks) {
+        sink->notify();
+    }
+    m_applied_sinks.clear();
+}
+
+GtuSink* BasicGtuLifecycleController::applyGtu(const GtuObject& obj)
+{
     GtuSink* sink = getSink(obj.getId());
     if (!sink) {
         auto pending = m_pending_gtus.find(obj.getId());
@@ -131,8 +167,9 @@ void BasicGtuLifecycleController::updateGtu(const GtuObject& obj)
             EV_WARN << "no GTU sink found for id " << obj.getId() << "\n";
         }
     } else {
-        sink->update(obj);
+        sink->apply(obj);
     }
+    return sink;
 }
 
 omnetpp::cModule* BasicGtuLifecycleController::addModule(const std::string& id, omnetpp::cModuleType* type, Initializer& init)
@@ -141,7 +178,7 @@ omnetpp::cModule* BasicGtuLifecycleController::addModule(const std::string& id,
     ++m_node_index;
     mod->finalizeParameters();
     mod->buildInside();
-    m_nodes[id] = mod;
+    acquireSlot(id).module = mod;
     init(mod);
     mod->scheduleStart(simTime());
     mod->callInitialize();
@@ -152,24 +189,81 @@ void BasicGtuLifecycleController::removeModule(const std::string& id)
 {
     omnetpp::cModule* mod = getModule(id);
     if (mod) {
+        releaseSlot(id);
         mod->callFinish();
         mod->deleteModule();
-        m_nodes.erase(id);
     } else {
         EV_ERROR << "cannot remove non-existing GTU module for id " << id << "\n";
     }
 }
 
+void BasicGtuLifecycleController::removeModules()
+{
+    if (m_pending_removals.empty()) {
+        return;
+    }
+
+    // all removed GTUs are finished before any of them is deleted
+    std::vector<omnetpp::cModule*> modules;
+    modules.reserve(m_pending_removals.size());
+    for (const std::string& id : m_pending_removals) {
+        if (omnetpp::cModule* mod = getModule(id)) {
+            releaseSlot(id);
+            mod->callFinish();
+            modules.push_back(mod);
+        }
+    }
+    m_pending_removals.clear();
+
+    for (omnetpp::cModule* mod : modules) {
+        mod->deleteModule();
+    }
+}
+
 omnetpp::cModule* BasicGtuLifecycleController::getModule(const std::string& id)
 {
-    auto found = m_nodes.find(id);
-    return found != m_nodes.end() ? found->second : nullptr;
+    GtuSlot* slot = findSlot(id);
+    return slot ? slot->module : nullptr;
 }
 
 GtuSink* BasicGtuLifecycleController::getSink(const std::string& id)
 {
-    auto found = m_gtu_sinks.find(id);
-    return found != m_gtu_sinks.end() ? found->second : nullptr;
+    GtuSlot* slot = findSlot(id);
+    return slot ? slot->sink : nullptr;
+}
+
+BasicGtuLifecycleController::GtuSlot* BasicGtuLifecycleController::findSlot(const std::string& id)
+{
+    auto found = m_gtu_handles.find(id);
+    return found != m_gtu_handles.end() ? &m_gtu_slots[found->second] : nullptr;
+}
+
+BasicGtuLifecycleController::GtuSlot& BasicGtuLifecycleController::acquireSlot(const std::string& id)
+{
+    auto found = m_gtu_handles.find(id);
+    if (found != m_gtu_handles.end()) {
+        return m_gtu_slots[found->second];
+    }
+
+    std::size_t handle = m_gtu_slots.size();
+    if (m_free_gtu_slots.empty()) {
+        m_gtu_slots.emplace_back();
+    } else {
+        handle = m_free_gtu_slots.back();
+        m_free_gtu_slots.pop_back();
+    }
+    m_gtu_handles.emplace(id, handle);
+    return m_gtu_slots[handle];
+}
+
+void BasicGtuLifecycleController::releaseSlot(const std::string& id)
+{
+    auto found = m_gtu_handles.find(id);
+    if (found != m_gtu_handles.end()) {
+        m_gtu_slots[found->second] = GtuSlot {};
+        m_free_gtu_slots.push_back(found->second);
+        m_gtu_handles.erase(found);
+    }
 }
 
 void BasicGtuLifecycleController::createSink(const GtuObject& obj)
@@ -185,10 +279,11 @@ void BasicGtuLifecycleController::createSink(const GtuObject& obj)
     omnetpp::cModule* mod = addModule(obj.getId(), instruction.getModuleType(), init);
 
     if (sink) {
-        auto insertion = m_gtu_sinks.insert({ obj.getId(), sink });
-        if (!insertion.second) {
+        GtuSlot* slot = findSlot(obj.getId());
+        if (!slot || slot->sink) {
             throw omnetpp::cRuntimeError("insertion of GTU sink failed");
         }
+        slot->sink = sink;
     } else {
         EV_ERROR << "could not find GTU sink for module " << mod->getFullPath() << "\n";
     }
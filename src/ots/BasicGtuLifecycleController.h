@@ -6,11 +6,12 @@
 #include "ots/GtuSink.h"
 #include <omnetpp/clistener.h>
 #include <omnetpp/csimplemodule.h>
+#include <cstddef>
 #include <functional>
-#include <map>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace ots
 {
@@ -30,18 +31,37 @@ protected:
     virtual void addGtu(const std::string&);
     virtual void removeGtu(const std::string&);
     virtual void updateGtu(const GtuObject&);
+    virtual void updateGtus(const GtuObjectList&);
+    virtual GtuSink* applyGtu(const GtuObject&);
 
     virtual omnetpp::cModule* addModule(const std::string&, omnetpp::cModuleType*, Initializer&);
     virtual void removeModule(const std::string&);
+    virtual void removeModules();
     virtual omnetpp::cModule* getModule(const std::string&);
     virtual GtuSink* getSink(const std::string&);
     virtual void createSink(const GtuObject&);
 
 private:
+    /**
+     * GtuSlot is an entry of the dense GTU table, free slots have no module
+     */
+    struct GtuSlot
+    {
+        omnetpp::cModule* module = nullptr;
+        GtuSink* sink = nullptr;
+    };
+
+    GtuSlot* findSlot(const std::string&);
+    GtuSlot& acquireSlot(const std::string&);
+    void releaseSlot(const std::string&);
+
     unsigned m_node_index = 0;
-    std::map<std::string, omnetpp::cModule*> m_nodes;
-    std::map<std::string, GtuSink*> m_gtu_sinks;
+    std::unordered_map<std::string, std::size_t> m_gtu_handles; /*< index of GTU slot by sim0mq id */
+    std::vector<GtuSlot> m_gtu_slots;
+    std::vector<std::size_t> m_free_gtu_slots;
     std::unordered_map<std::string, std::unique_ptr<GtuObject>> m_pending_gtus;
+    std::vector<std::string> m_pending_removals; /*< GTUs removed by OTS in the current step */
+    std::vector<GtuSink*> m_applied_sinks;
     GtuCreationPolicy* m_creation_policy = nullptr;
 };
 
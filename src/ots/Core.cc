@@ -46,6 +46,10 @@ const simsignal_t lifecycle_signal = cComponent::registerSignal("ots-lifecycle")
 const simsignal_t gtu_add_signal = cComponent::registerSignal("ots-gtu-add");
 const simsignal_t gtu_remove_signal = cComponent::registerSignal("ots-gtu-remove");
 const simsignal_t gtu_position_signal = cComponent::registerSignal("ots-gtu-position");
+const simsignal_t gtu_positions_signal = cComponent::registerSignal("ots-gtu-positions");
+
+// GTU position requests sent ahead of their responses, bounded to stay below ZMQ's high water marks
+const std::size_t max_pending_gtu_moves = 256;
 
 bool isGoodReply(const sim0mqpp::Message& msg)
 {
@@ -167,22 +171,24 @@ void Core::unregisterRadio(const RadioEndpoint* radio)
     }
 }
 
-bool Core::receive(std::size_t maxlen, bool block)
+bool Core::receive(bool block)
 {
-    m_buffer.resize(maxlen);
-    int length = zmq_recv(m_zmq_socket, m_buffer.data(), m_buffer.size(), block ? 0 : ZMQ_NOBLOCK);
-    if (length < 0) {
-        if (!block && errno == EAGAIN) {
+    // message frames are not truncated, m_buffer grows to the largest frame received so far
+    zmq_msg_t frame;
+    zmq_msg_init(&frame);
+    if (zmq_msg_recv(&frame, m_zmq_socket, block ? 0 : ZMQ_DONTWAIT) < 0) {
+        const int error = errno;
+        zmq_msg_close(&frame);
+        if (!block && error == EAGAIN) {
             return false;
         } else {
-            throw omnetpp::cRuntimeError("Receiving from OTS endpoint failed: %s", zmq_strerror(errno));
+            throw omnetpp::cRuntimeError("Receiving from OTS endpoint failed: %s", zmq_strerror(error));
         }
-    } else if (length > m_buffer.size()) {
-        throw omnetpp::cRuntimeError("Length of replied message exceeds buffer size");
-    } else {
-        m_buffer.resize(length);
     }
 
+    const auto* data = static_cast<const std::uint8_t*>(zmq_msg_data(&frame));
+    m_buffer.assign(data, data + zmq_msg_size(&frame));
+    zmq_msg_close(&frame);
     return true;
 }
 
@@ -226,31 +232,40 @@ void Core::sendCommand(const sim0mqpp::Identifier& cmd, std::int32_t cmd_id, std
 void Core::queryResponses(const sim0mqpp::Identifier& wait_for)
 {
     m_pending.insert(wait_for);
-    while (receive(8192, !m_pending.empty())) {
-        sim0mqpp::BufferDeserializer input(m_buffer);
-        sim0mqpp::Message msg;
-        deserialize(input, msg);
-        if (input.good()) {
-            m_pending.erase(msg.message_type_id);
-
-            if (msg.message_type_id == sim_until_msg) {
-                processSimulationTrigger(msg);
-            } else if (msg.message_type_id == sim_state_msg) {
-                processSimulationChange(msg);
-            } else if (msg.message_type_id == gtu_move_msg) {
-                processGtuMove(msg);
-            } else if (msg.message_type_id == radio_transmit_msg) {
-                processRadio(msg);
-            } else if (msg.message_type_id == gtu_network_msg) {
-                processNetwork(msg);
-            } else if (msg.message_type_id == sim_start_msg) {
-                processSimulationStart(msg);
-            } else {
-                EV_WARN << "ignoring message " << sim0mqpp::to_string(msg.message_type_id) << "\n";
+    // block while responses are pending, then drain already queued messages without blocking
+    while (receive(!m_pending.empty() || m_pending_gtu_moves > 0)) {
+        processResponse();
+    }
+}
+
+void Core::processResponse()
+{
+    sim0mqpp::BufferDeserializer input(m_buffer);
+    sim0mqpp::Message msg;
+    deserialize(input, msg);
+    if (input.good()) {
+        m_pending.erase(msg.message_type_id);
+
+        if (msg.message_type_id == sim_until_msg) {
+            processSimulationTrigger(msg);
+        } else if (msg.message_type_id == sim_state_msg) {
+            processSimulationChange(msg);
+        } else if (msg.message_type_id == gtu_move_msg) {
+            if (m_pending_gtu_moves > 0) {
+                --m_pending_gtu_moves;
             }
+            processGtuMove(msg);
+        } else if (msg.message_type_id == radio_transmit_msg) {
+            processRadio(msg);
+        } else if (msg.message_type_id == gtu_network_msg) {
+            processNetwork(msg);
+        } else if (msg.message_type_id == sim_start_msg) {
+            processSimulationStart(msg);
         } else {
-            throw omnetpp::cRuntimeError("Decoding sim0mqpp message failed: %s", input.error_message().c_str());
+            EV_WARN << "ignoring message " << sim0mqpp::to_string(msg.message_type_id) << "\n";
         }
+    } else {
+        throw omnetpp::cRuntimeError("Decoding sim0mqpp message failed: %s", input.error_message().c_str());
     }
 }
 
@@ -319,14 +334,16 @@ void Core::processGtuMove(const sim0mqpp::Message& msg)
     auto accel = msg.get_payload<sim0mqpp::Unit::Acceleration>(5);
 
     if (id && type && pos && pos->values().size() == 3 && heading && speed && accel) {
-        GtuObject gtu;
+        GtuObject& gtu = m_gtu_positions.append();
         gtu.setId(*id);
         gtu.setType(*type);
         gtu.setPosition({ pos->values()[0], pos->values()[1], pos->values()[2] });
         gtu.setHeadingRad(heading->value());
         gtu.setSpeed(speed->value());
         gtu.setAcceleration(accel->value());
-        emit(gtu_position_signal, &gtu);
+        if (mayHaveListeners(gtu_position_signal)) {
+            emit(gtu_position_signal, &gtu);
+        }
         EV_DETAIL << "GTU position update for ID " << *id << "\n";
     } else {
         EV_ERROR << "received broken GTU position\n";
@@ -471,16 +488,24 @@ void Core::simulateUntil(omnetpp::SimTime time)
 
 void Core::requestGtuPositions()
 {
+    // network reply triggers requests of all GTU positions, responses are awaited altogether
+    m_gtu_positions.clear();
     sendCommand(gtu_network_get_current_msg);
     queryResponses(gtu_network_msg);
+    emit(gtu_positions_signal, &m_gtu_positions);
 }
 
 void Core::requestGtuPosition(const sim0mqpp::Any& gtu_id)
 {
+    while (m_pending_gtu_moves >= max_pending_gtu_moves) {
+        receive();
+        processResponse();
+    }
+
     std::vector<sim0mqpp::Any> payload;
     payload.push_back(gtu_id);
     sendCommand(gtu_move_get_current_msg, std::move(payload));
-    queryResponses(gtu_move_msg);
+    ++m_pending_gtu_moves;
 }
 
 void Core::notifyRadioReception(const RadioMessage& msg)
@@ -1,6 +1,7 @@
 #ifndef OTS_CORE_QMT3LWQG
 #define OTS_CORE_QMT3LWQG
 
+#include "ots/GtuObject.h"
 #include <omnetpp/csimplemodule.h>
 #include <sim0mqpp/any.hpp>
 #include <sim0mqpp/message.hpp>
@@ -40,8 +41,9 @@ protected:
     void requestGtuPositions();
     void requestGtuPosition(const sim0mqpp::Any&);
 
-    bool receive(std::size_t maxlen, bool block = true);
+    bool receive(bool block = true);
     void queryResponses(const sim0mqpp::Identifier&);
+    void processResponse();
     void processNetwork(const sim0mqpp::Message&);
     void processGtuMove(const sim0mqpp::Message&);
     void processGtuAdd(const sim0mqpp::Message&);
@@ -67,6 +69,8 @@ private:
     std::string m_sim_receiver;
     std::vector<std::uint8_t> m_buffer;
     std::unordered_set<sim0mqpp::Identifier> m_pending;
+    std::size_t m_pending_gtu_moves = 0; /*< requested but not yet received GTU positions */
+    GtuObjectList m_gtu_positions; /*< GTU positions of current step */
     bool m_gtu_add_subscribed = false;
     bool m_gtu_remove_subscribed = false;
     bool m_sim_state_subscribed = false;
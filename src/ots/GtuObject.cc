@@ -7,6 +7,7 @@ namespace ots
 {
 
 Register_Abstract_Class(GtuObject)
+Register_Abstract_Class(GtuObjectList)
 
 namespace
 {
@@ -44,4 +45,12 @@ double GtuObject::getHeadingDeg() const
     return m_heading / pi * 180.0;
 }
 
+GtuObject& GtuObjectList::append()
+{
+    if (m_size == m_objects.size()) {
+        m_objects.emplace_back();
+    }
+    return m_objects[m_size++];
+}
+
 } // namespace ots
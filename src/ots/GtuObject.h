@@ -2,7 +2,9 @@
 #define OTS_GTUOBJECT_H_Q7PI0NHO
 
 #include <omnetpp/cobject.h>
+#include <cstddef>
 #include <tuple>
+#include <vector>
 
 namespace ots
 {
@@ -42,6 +44,29 @@ private:
     double m_acceleration;
 };
 
+/**
+ * GtuObjectList carries the GTU objects of one OTS step
+ *
+ * Objects are kept on clear() so their strings can be reused by following steps.
+ */
+class GtuObjectList : public omnetpp::cObject
+{
+public:
+    using const_iterator = std::vector<GtuObject>::const_iterator;
+
+    void clear() { m_size = 0; }
+    GtuObject& append();
+
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    const_iterator begin() const { return m_objects.begin(); }
+    const_iterator end() const { return m_objects.begin() + m_size; }
+
+private:
+    std::vector<GtuObject> m_objects;
+    std::size_t m_size = 0;
+};
+
 } // namespace ots
 
 #endif /* OTS_GTUOBJECT_H_Q7PI0NHO */
@@ -11,6 +11,15 @@ class GtuSink
 public:
     virtual void initialize(const GtuObject&) = 0;
     virtual void update(const GtuObject&) = 0;
+
+    /**
+     * Bulk updates are split into two phases: all sinks of a step apply their new state first,
+     * afterwards each of them notifies its listeners. Hence, listeners never see a half-updated step.
+     * Sinks without distinct phases update and notify at once.
+     */
+    virtual void apply(const GtuObject& obj) { update(obj); }
+    virtual void notify() {}
+
     virtual ~GtuSink() = default;
 };
 
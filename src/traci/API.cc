@@ -1,12 +1,42 @@
 #include "traci/API.h"
 #include "traci/Launcher.h"
+#include "traci/StorageView.h"
+#include "artery/utility/Fingerprint.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
 #include <thread>
 
 namespace traci
 {
 
+namespace
+{
+
+template<typename T>
+T& getPolygonResult(libsumo::SubscriptionResults& results, const std::string& id, int var)
+{
+    // responses lacking a variable or carrying an unexpected data type are protocol errors
+    auto object = results.find(id);
+    if (object != results.end()) {
+        auto found = object->second.find(var);
+        if (found != object->second.end()) {
+            if (T* result = dynamic_cast<T*>(found->second.get())) {
+                return *result;
+            }
+        }
+    }
+    throw libsumo::TraCIException("#Error: missing or mistyped variable " + std::to_string(var) + " of polygon " + id);
+}
+
+} // namespace
+
 TraCIGeoPosition API::convertGeo(const TraCIPosition& pos) const
 {
+    if (m_projection) {
+        return m_projection->toGeo(pos);
+    }
+
     libsumo::TraCIPosition result = simulation.convertGeo(pos.x, pos.y, false);
     TraCIGeoPosition geo;
     geo.longitude = result.x;
@@ -16,9 +46,68 @@ TraCIGeoPosition API::convertGeo(const TraCIPosition& pos) const
 
 TraCIPosition API::convert2D(const TraCIGeoPosition& pos) const
 {
+    if (m_projection) {
+        return m_projection->fromGeo(pos);
+    }
+
     return simulation.convertGeo(pos.longitude, pos.latitude, true);
 }
 
+bool API::useLocalGeoProjection()
+{
+    // about a centimetre
+    static const double tolerance_deg = 1e-7;
+
+    m_projection.reset();
+    const Boundary boundary { simulation.getNetBoundary() };
+    const TraCIPosition& lower = boundary.lowerLeftPosition();
+    const TraCIPosition& upper = boundary.upperRightPosition();
+    TraCIPosition center;
+    center.x = 0.5 * (lower.x + upper.x);
+    center.y = 0.5 * (lower.y + upper.y);
+    center.z = 0.0;
+
+    std::vector<TraCIPosition> checkpoints { lower, upper };
+    checkpoints.push_back(lower);
+    checkpoints.back().x = upper.x;
+    checkpoints.push_back(upper);
+    checkpoints.back().x = lower.x;
+    std::vector<TraCIGeoPosition> expected;
+    for (const TraCIPosition& checkpoint : checkpoints) {
+        expected.push_back(convertGeo(checkpoint));
+    }
+
+    // SUMO may use a neighbouring zone for networks close to a zone border
+    const TraCIGeoPosition center_geo = convertGeo(center);
+    const int center_zone = UtmProjection::zone(center_geo.longitude);
+    for (int zone : { center_zone, center_zone - 1, center_zone + 1 }) {
+        if (zone < 1 || zone > 60) {
+            continue;
+        }
+
+        const TraCIPosition utm = UtmProjection::forward(zone, center_geo);
+        TraCIPosition offset;
+        offset.x = center.x - utm.x;
+        offset.y = center.y - utm.y;
+        offset.z = 0.0;
+        UtmProjection projection { zone, offset };
+
+        bool matching = true;
+        for (std::size_t i = 0; i < checkpoints.size() && matching; ++i) {
+            const TraCIGeoPosition geo = projection.toGeo(checkpoints[i]);
+            matching = std::abs(geo.longitude - expected[i].longitude) < tolerance_deg &&
+                std::abs(geo.latitude - expected[i].latitude) < tolerance_deg;
+        }
+
+        if (matching) {
+            m_projection.reset(new UtmProjection(projection));
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void API::connect(const ServerEndpoint& endpoint)
 {
     const unsigned max_tries = endpoint.retry ? 10 : 0;
@@ -27,8 +116,10 @@ void API::connect(const ServerEndpoint& endpoint)
 
     while (true) {
         try {
-            TraCIAPI::connect(endpoint.hostname, endpoint.port);
+            m_projection.reset();
+            connectServer(endpoint);
             TraCIAPI::setOrder(endpoint.clientId);
+            m_client_id = endpoint.clientId;
             return;
         } catch (tcpip::SocketException&) {
             if (++tries < max_tries) {
@@ -41,4 +132,482 @@ void API::connect(const ServerEndpoint& endpoint)
     }
 }
 
+void API::reconnect(const ServerEndpoint& endpoint)
+{
+    if (m_step_pending) {
+        throw libsumo::TraCIException("cannot reconnect while a simulation step is pending");
+    }
+    closeSocket();
+    m_server.reset();
+    m_server_responses.clear();
+    connectServer(endpoint);
+    TraCIAPI::setOrder(endpoint.clientId);
+    m_client_id = endpoint.clientId;
+}
+
+void API::close()
+{
+    TraCIAPI::close();
+    m_server.reset();
+    m_server_responses.clear();
+}
+
+bool API::isConnected() const
+{
+    return m_server || TraCIAPI::isConnected();
+}
+
+void API::connectServer(const ServerEndpoint& endpoint)
+{
+    if (endpoint.server) {
+        // in-process server: messages are exchanged without any socket
+        m_server = endpoint.server;
+    } else {
+        connectSocket(endpoint);
+    }
+}
+
+void API::connectSocket(const ServerEndpoint& endpoint)
+{
+    if (endpoint.socketPath.empty()) {
+        TraCIAPI::connect(endpoint.hostname, endpoint.port);
+        return;
+    }
+
+    // local server: Unix-domain socket saves TCP/IP stack traversal for each step and subscription
+    std::unique_ptr<tcpip::Socket> socket { new tcpip::Socket(endpoint.hostname, endpoint.port) };
+    socket->set_unix_path(endpoint.socketPath);
+    socket->connect();
+    mySocket = socket.release();
+}
+
+void API::requestSimulationStep(double time)
+{
+    completeSimulationStep();
+    send_commandSimulationStep(time);
+    m_step_pending = true;
+}
+
+void API::completeSimulationStep()
+{
+    if (m_step_pending) {
+        m_step_pending = false;
+        readSimulationStepResult();
+    }
+}
+
+void API::sendCommand(const tcpip::Storage& msg)
+{
+    if (m_step_pending) {
+        // responses arrive in order: pending step response has to be consumed first
+        completeSimulationStep();
+    }
+    if (!m_deferred_command_ids.empty()) {
+        // deferred set commands precede this command
+        flushSetCommands();
+    }
+    if (m_server) {
+        // served synchronously, response is kept until it is received
+        m_server_responses.emplace_back();
+        std::vector<unsigned char>& response = m_server_responses.back();
+        if (msg.size() > 0) {
+            m_server->process(&*msg.begin(), msg.size(), response);
+        }
+    } else {
+        TraCIAPI::sendCommand(msg);
+    }
+}
+
+void API::receiveResponse(tcpip::Storage& msg) const
+{
+    if (m_server) {
+        if (m_server_responses.empty()) {
+            throw tcpip::SocketException("no response of in-process server available");
+        }
+        msg.reset();
+        msg.writePacket(m_server_responses.front());
+        m_server_responses.pop_front();
+    } else {
+        TraCIAPI::receiveResponse(msg);
+    }
+}
+
+std::size_t API::receiveResponse(std::vector<unsigned char>& buffer) const
+{
+    if (m_server) {
+        if (m_server_responses.empty()) {
+            throw tcpip::SocketException("no response of in-process server available");
+        }
+        const std::vector<unsigned char>& response = m_server_responses.front();
+        const std::size_t length = response.size();
+        if (buffer.size() < length) {
+            buffer.resize(length);
+        }
+        std::copy(response.begin(), response.end(), buffer.begin());
+        m_server_responses.pop_front();
+        return length;
+    }
+    return mySocket->receiveExact(buffer);
+}
+
+void API::readSimulationStepResult()
+{
+    const std::size_t length = receiveResponse(m_receive_buffer);
+    m_step_response_size = length;
+    StorageView msg { m_receive_buffer, length };
+    checkResultState(msg, libsumo::CMD_SIMSTEP);
+
+    for (auto& domain : myDomains) {
+        // keep entries of subscribed objects, i.e. their identifiers are not copied again in each step
+        libsumo::SubscriptionResults& objects = domain.second->getModifiableSubscriptionResults();
+        libsumo::SubscriptionResults kept;
+        kept.swap(objects);
+        domain.second->clearSubscriptionResults();
+        objects.swap(kept);
+        for (auto& object : objects) {
+            object.second.clear();
+        }
+    }
+
+    int numSubs = msg.readInt();
+    while (numSubs > 0) {
+        // skip response length (extended length follows if first byte is zero)
+        if (msg.readUnsignedByte() == 0) {
+            msg.readInt();
+        }
+
+        const int cmdId = msg.readUnsignedByte();
+        if (cmdId >= libsumo::RESPONSE_SUBSCRIBE_INDUCTIONLOOP_VARIABLE && cmdId <= libsumo::RESPONSE_SUBSCRIBE_PERSON_VARIABLE) {
+            const std::string_view objectId = msg.readString();
+            const int variableCount = msg.readUnsignedByte();
+            auto& results = myDomains[cmdId]->getModifiableSubscriptionResults();
+            m_object_id.assign(objectId.data(), objectId.size());
+            readVariables(msg, variableCount, results[m_object_id]);
+        } else {
+            const std::string_view contextId = msg.readString();
+            msg.readUnsignedByte(); // context domain
+            const int variableCount = msg.readUnsignedByte();
+            int numObjects = msg.readInt();
+            auto& results = myDomains[cmdId + 0x50]->getModifiableContextSubscriptionResults(std::string { contextId });
+            while (numObjects > 0) {
+                const std::string_view objectId = msg.readString();
+                m_object_id.assign(objectId.data(), objectId.size());
+                readVariables(msg, variableCount, results[m_object_id]);
+                --numObjects;
+            }
+        }
+        --numSubs;
+    }
+
+    // drop objects without results in this step, e.g. arrived vehicles
+    for (auto& domain : myDomains) {
+        libsumo::SubscriptionResults& objects = domain.second->getModifiableSubscriptionResults();
+        for (auto it = objects.begin(); it != objects.end();) {
+            if (it->second.empty()) {
+                it = objects.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+void API::subscribeObjects(int command, const std::vector<std::string>& ids, const std::vector<int>& vars, double beginTime, double endTime)
+{
+    if (ids.empty()) {
+        return;
+    } else if (!isConnected()) {
+        throw tcpip::SocketException("Socket is not initialised");
+    }
+
+    const int response = command + 0x10;
+    auto domain = myDomains.find(response);
+    if (domain == myDomains.end()) {
+        throw libsumo::TraCIException("Unknown subscription command: " + std::to_string(command));
+    }
+
+    tcpip::Storage outMsg;
+    for (const std::string& id : ids) {
+        // same layout as TraCIAPI::send_commandSubscribeObjectVariable
+        outMsg.writeUnsignedByte(0);
+        outMsg.writeInt(5 + 1 + 8 + 8 + 4 + static_cast<int>(id.length()) + 1 + static_cast<int>(vars.size()));
+        outMsg.writeUnsignedByte(command);
+        outMsg.writeDouble(beginTime);
+        outMsg.writeDouble(endTime);
+        outMsg.writeString(id);
+        outMsg.writeUnsignedByte(static_cast<int>(vars.size()));
+        for (int var : vars) {
+            outMsg.writeUnsignedByte(var);
+        }
+    }
+    sendCommand(outMsg);
+
+    const std::size_t length = receiveResponse(m_receive_buffer);
+    StorageView msg { m_receive_buffer, length };
+    auto& results = domain->second->getModifiableSubscriptionResults();
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        checkResultState(msg, command);
+        if (!vars.empty()) {
+            if (msg.readUnsignedByte() == 0) {
+                msg.readInt();
+            }
+            const int cmdId = msg.readUnsignedByte();
+            if (cmdId != response) {
+                throw libsumo::TraCIException("#Error: received response with command id: " + std::to_string(cmdId) + " but expected: " + std::to_string(response));
+            }
+            const std::string_view objectId = msg.readString();
+            const int variableCount = msg.readUnsignedByte();
+            m_object_id.assign(objectId.data(), objectId.size());
+            readVariables(msg, variableCount, results[m_object_id]);
+        }
+    }
+}
+
+void API::getObjectVariables(int command, const std::vector<std::string>& ids, const std::vector<int>& vars, libsumo::SubscriptionResults& into)
+{
+    if (ids.empty() || vars.empty()) {
+        return;
+    } else if (!isConnected()) {
+        throw tcpip::SocketException("Socket is not initialised");
+    }
+
+    tcpip::Storage outMsg;
+    for (const std::string& id : ids) {
+        // same layout as TraCIAPI::createCommand
+        const int length = 1 + 1 + 1 + 4 + static_cast<int>(id.length());
+        for (int var : vars) {
+            if (length <= 255) {
+                outMsg.writeUnsignedByte(length);
+            } else {
+                outMsg.writeUnsignedByte(0);
+                outMsg.writeInt(length + 4);
+            }
+            outMsg.writeUnsignedByte(command);
+            outMsg.writeUnsignedByte(var);
+            outMsg.writeString(id);
+        }
+    }
+    sendCommand(outMsg);
+
+    const int response = command + 0x10;
+    const std::size_t length = receiveResponse(m_receive_buffer);
+    StorageView msg { m_receive_buffer, length };
+    for (std::size_t i = 0; i < ids.size() * vars.size(); ++i) {
+        checkResultState(msg, command);
+        if (msg.readUnsignedByte() == 0) {
+            msg.readInt();
+        }
+        const int cmdId = msg.readUnsignedByte();
+        if (cmdId != response) {
+            throw libsumo::TraCIException("#Error: received response with command id: " + std::to_string(cmdId) + " but expected: " + std::to_string(response));
+        }
+        const int variableId = msg.readUnsignedByte();
+        const std::string_view objectId = msg.readString();
+        const int type = msg.readUnsignedByte();
+        into[std::string { objectId }][variableId] = readValue(msg, type);
+    }
+}
+
+void API::setVariable(int command, int var, const std::string& id, tcpip::Storage& value)
+{
+    using artery::fingerprint::Ingredient;
+    if (artery::fingerprint::isEnabled(Ingredient::TraciCommand)) {
+        artery::fingerprint::add(Ingredient::TraciCommand, command, var);
+        artery::fingerprint::addBytes(Ingredient::TraciCommand, id.data(), id.size());
+        const std::vector<unsigned char> bytes(value.begin(), value.end());
+        artery::fingerprint::addBytes(Ingredient::TraciCommand, bytes.data(), bytes.size());
+    }
+
+    if (!m_defer_set_commands) {
+        createCommand(command, var, id, &value);
+        processSet(command);
+        return;
+    }
+
+    // same layout as TraCIAPI::createCommand
+    const int length = 1 + 1 + 1 + 4 + static_cast<int>(id.length()) + static_cast<int>(value.size());
+    if (length <= 255) {
+        m_deferred_commands.writeUnsignedByte(length);
+    } else {
+        m_deferred_commands.writeUnsignedByte(0);
+        m_deferred_commands.writeInt(length + 4);
+    }
+    m_deferred_commands.writeUnsignedByte(command);
+    m_deferred_commands.writeUnsignedByte(var);
+    m_deferred_commands.writeString(id);
+    m_deferred_commands.writeStorage(value);
+    m_deferred_command_ids.push_back(command);
+}
+
+void API::deferSetCommands(bool defer)
+{
+    m_defer_set_commands = defer;
+    if (!defer) {
+        flushSetCommands();
+    }
+}
+
+void API::flushSetCommands()
+{
+    if (m_deferred_command_ids.empty()) {
+        return;
+    } else if (!isConnected()) {
+        throw tcpip::SocketException("Socket is not initialised");
+    }
+
+    // take commands first, sendCommand would flush them again otherwise
+    tcpip::Storage outMsg;
+    outMsg.writeStorage(m_deferred_commands);
+    m_deferred_commands.reset();
+    std::vector<int> commands;
+    std::swap(commands, m_deferred_command_ids);
+    sendCommand(outMsg);
+
+    const std::size_t length = receiveResponse(m_receive_buffer);
+    StorageView msg { m_receive_buffer, length };
+    for (int command : commands) {
+        checkResultState(msg, command);
+    }
+}
+
+std::vector<API::Polygon> API::getPolygons(const std::vector<std::string>& ids, const PolygonFilter& filter)
+{
+    // bounds size of pipelined messages, shapes of large polygons make up most of a response
+    static const std::size_t batchSize = 1024;
+    static const std::vector<int> propertyVars { libsumo::VAR_TYPE, libsumo::VAR_FILL };
+    static const std::vector<int> shapeVars { libsumo::VAR_SHAPE };
+
+    std::vector<Polygon> polygons;
+    std::vector<std::string> batch;
+    std::vector<std::string> accepted;
+    libsumo::SubscriptionResults results;
+    for (std::size_t offset = 0; offset < ids.size(); offset += batchSize) {
+        const std::size_t end = std::min(offset + batchSize, ids.size());
+        batch.assign(ids.begin() + offset, ids.begin() + end);
+        results.clear();
+        getObjectVariables(libsumo::CMD_GET_POLYGON_VARIABLE, batch, propertyVars, results);
+
+        const std::size_t first = polygons.size();
+        accepted.clear();
+        for (const std::string& id : batch) {
+            Polygon polygon;
+            polygon.id = id;
+            polygon.type = getPolygonResult<libsumo::TraCIString>(results, id, libsumo::VAR_TYPE).value;
+            polygon.filled = getPolygonResult<libsumo::TraCIInt>(results, id, libsumo::VAR_FILL).value != 0;
+            if (!filter || filter(polygon)) {
+                accepted.push_back(id);
+                polygons.push_back(std::move(polygon));
+            }
+        }
+
+        results.clear();
+        getObjectVariables(libsumo::CMD_GET_POLYGON_VARIABLE, accepted, shapeVars, results);
+        for (std::size_t i = first; i < polygons.size(); ++i) {
+            auto& shape = getPolygonResult<libsumo::TraCIPositionVector>(results, polygons[i].id, libsumo::VAR_SHAPE);
+            polygons[i].shape.value = std::move(shape.value);
+        }
+    }
+
+    return polygons;
+}
+
+void API::checkResultState(StorageView& msg, int command) const
+{
+    const std::size_t cmdStart = msg.position();
+    const int cmdLength = msg.readUnsignedByte();
+    const int cmdId = msg.readUnsignedByte();
+    if (cmdId != command) {
+        throw libsumo::TraCIException("#Error: received status response to command: " + std::to_string(cmdId) + " but expected: " + std::to_string(command));
+    }
+
+    const int resultType = msg.readUnsignedByte();
+    const std::string_view description = msg.readString();
+    switch (resultType) {
+        case libsumo::RTYPE_OK:
+            break;
+        case libsumo::RTYPE_ERR:
+            throw libsumo::TraCIException(".. Answered with error to command (" + std::to_string(command) + "), [description: " + std::string(description) + "]");
+        case libsumo::RTYPE_NOTIMPLEMENTED:
+            throw libsumo::TraCIException(".. Sent command is not implemented (" + std::to_string(command) + "), [description: " + std::string(description) + "]");
+        default:
+            throw libsumo::TraCIException(".. Answered with unknown result code(" + std::to_string(resultType) + ") to command(" + std::to_string(command) + "), [description: " + std::string(description) + "]");
+    }
+
+    if (cmdStart + cmdLength != msg.position()) {
+        throw libsumo::TraCIException("#Error: command at position " + std::to_string(cmdStart) + " has wrong length");
+    }
+}
+
+void API::readVariables(StorageView& msg, int count, libsumo::TraCIResults& into) const
+{
+    for (; count > 0; --count) {
+        const int variableId = msg.readUnsignedByte();
+        const int status = msg.readUnsignedByte();
+        const int type = msg.readUnsignedByte();
+        if (status != libsumo::RTYPE_OK) {
+            throw libsumo::TraCIException("Subscription response error: variableID=" + std::to_string(variableId) + " status=" + std::to_string(status));
+        }
+        into[variableId] = readValue(msg, type);
+    }
+}
+
+std::shared_ptr<libsumo::TraCIResult> API::readValue(StorageView& msg, int type) const
+{
+    switch (type) {
+        case libsumo::TYPE_DOUBLE:
+            return std::make_shared<libsumo::TraCIDouble>(msg.readDouble());
+        case libsumo::TYPE_INTEGER:
+            return std::make_shared<libsumo::TraCIInt>(msg.readInt());
+        case libsumo::TYPE_STRING:
+            return std::make_shared<libsumo::TraCIString>(std::string { msg.readString() });
+        case libsumo::POSITION_2D: {
+            auto p = std::make_shared<libsumo::TraCIPosition>();
+            p->x = msg.readDouble();
+            p->y = msg.readDouble();
+            p->z = 0.0;
+            return p;
+        }
+        case libsumo::POSITION_3D: {
+            auto p = std::make_shared<libsumo::TraCIPosition>();
+            p->x = msg.readDouble();
+            p->y = msg.readDouble();
+            p->z = msg.readDouble();
+            return p;
+        }
+        case libsumo::TYPE_COLOR: {
+            auto c = std::make_shared<libsumo::TraCIColor>();
+            c->r = static_cast<unsigned char>(msg.readUnsignedByte());
+            c->g = static_cast<unsigned char>(msg.readUnsignedByte());
+            c->b = static_cast<unsigned char>(msg.readUnsignedByte());
+            c->a = static_cast<unsigned char>(msg.readUnsignedByte());
+            return c;
+        }
+        case libsumo::TYPE_UBYTE:
+            return std::make_shared<libsumo::TraCIInt>(msg.readUnsignedByte());
+        case libsumo::TYPE_POLYGON: {
+            auto shape = std::make_shared<libsumo::TraCIPositionVector>();
+            int size = msg.readUnsignedByte();
+            if (size == 0) {
+                size = msg.readInt();
+            }
+            shape->value.reserve(size);
+            for (int i = 0; i < size; ++i) {
+                libsumo::TraCIPosition p;
+                p.x = msg.readDouble();
+                p.y = msg.readDouble();
+                p.z = 0.0;
+                shape->value.push_back(p);
+            }
+            return shape;
+        }
+        case libsumo::TYPE_STRINGLIST: {
+            auto sl = std::make_shared<libsumo::TraCIStringList>();
+            sl->value = msg.readStringList();
+            return sl;
+        }
+        default:
+            throw libsumo::TraCIException("Unimplemented subscription type: " + std::to_string(type));
+    }
+}
+
 } // namespace traci
@@ -7,12 +7,18 @@
 #include "traci/GeoPosition.h"
 #include "traci/Position.h"
 #include "traci/Time.h"
+#include "traci/UtmProjection.h"
 #include <omnetpp/simtime.h>
+#include <deque>
+#include <functional>
+#include <memory>
 
 namespace traci
 {
 
+class InProcessServer;
 class ServerEndpoint;
+class StorageView;
 
 class API : public TraCIAPI
 {
@@ -22,7 +28,191 @@ public:
     TraCIGeoPosition convertGeo(const TraCIPosition&) const;
     TraCIPosition convert2D(const TraCIGeoPosition&) const;
 
+    /**
+     * Let convertGeo and convert2D project locally instead of sending a TraCI command each time.
+     *
+     * The network's UTM zone and offset are derived from a few conversions by SUMO.
+     * Local projection is only enabled if it matches SUMO's conversions at the network's corners.
+     *
+     * \return true if local projection is in use
+     */
+    bool useLocalGeoProjection();
+
     void connect(const ServerEndpoint&);
+
+    /**
+     * Switch to another server continuing the current session, e.g. in a forked process.
+     *
+     * The previous connection is dropped without closing the session,
+     * subscriptions and local geo projection are retained.
+     */
+    void reconnect(const ServerEndpoint&);
+
+    /**
+     * End the simulation and drop the connection, including an in-process server
+     */
+    void close();
+
+    bool isConnected() const override;
+
+    /**
+     * Execution order of this client among all TraCI clients of SUMO
+     * \return client id passed to connect
+     */
+    int getClientId() const { return m_client_id; }
+
+    /**
+     * Send simulation step command without waiting for SUMO's response.
+     *
+     * SUMO computes the requested step while the caller continues.
+     * The pending response is read by completeSimulationStep() or implicitly
+     * before any other command is sent to SUMO.
+     *
+     * \param time target time of step (0 for a single step)
+     */
+    void requestSimulationStep(double time = 0);
+
+    /**
+     * Read response of a previously requested simulation step.
+     * Nothing happens if no step is pending.
+     */
+    void completeSimulationStep();
+
+    /**
+     * Check if a requested simulation step has not been completed yet
+     * \return true if step response is outstanding
+     */
+    bool isSimulationStepPending() const { return m_step_pending; }
+
+    /**
+     * Size of last simulation step response
+     * \return number of bytes including subscription results
+     */
+    std::size_t getStepResponseSize() const { return m_step_response_size; }
+
+    /**
+     * Subscribe the same variables of several objects at once.
+     *
+     * All subscription commands are sent in a single TraCI message and their
+     * responses are read in one pass, i.e. only one round trip is required.
+     * Initial subscription results are stored like those of regular subscriptions.
+     *
+     * \param command subscription command of domain, e.g. libsumo::CMD_SUBSCRIBE_VEHICLE_VARIABLE
+     * \param ids identifiers of objects to subscribe
+     * \param vars variables to subscribe, empty vector cancels subscriptions
+     */
+    void subscribeObjects(int command, const std::vector<std::string>& ids, const std::vector<int>& vars,
+            double beginTime = libsumo::INVALID_DOUBLE_VALUE, double endTime = libsumo::INVALID_DOUBLE_VALUE);
+
+    /**
+     * Retrieve several variables of several objects at once.
+     *
+     * All GetVariable commands are sent in a single TraCI message and their
+     * responses are read in one pass, i.e. only one round trip is required.
+     *
+     * \param command get command of domain, e.g. libsumo::CMD_GET_VEHICLE_VARIABLE
+     * \param ids identifiers of objects
+     * \param vars variables to retrieve for each object
+     * \param into retrieved values are added per object identifier
+     */
+    void getObjectVariables(int command, const std::vector<std::string>& ids, const std::vector<int>& vars,
+            libsumo::SubscriptionResults& into);
+
+    /**
+     * Set a variable of an object, e.g. a vehicle's speed.
+     *
+     * The command is sent immediately unless set commands are deferred.
+     *
+     * \param command set command of domain, e.g. libsumo::CMD_SET_VEHICLE_VARIABLE
+     * \param var variable to set
+     * \param id identifier of object
+     * \param value type identifier followed by value
+     */
+    void setVariable(int command, int var, const std::string& id, tcpip::Storage& value);
+
+    /**
+     * Defer set commands issued by setVariable until they are flushed.
+     *
+     * Deferred commands are sent in a single TraCI message by flushSetCommands() or implicitly
+     * before any other command is sent to SUMO, i.e. SUMO processes all commands in their original order.
+     * Disabling deferral flushes pending commands.
+     *
+     * \param defer true to defer set commands
+     */
+    void deferSetCommands(bool defer);
+
+    /**
+     * Check if set commands are currently deferred
+     */
+    bool isDeferringSetCommands() const { return m_defer_set_commands; }
+
+    /**
+     * Send all deferred set commands at once and check their responses
+     */
+    void flushSetCommands();
+
+    struct Polygon
+    {
+        std::string id;
+        std::string type;
+        bool filled = false;
+        libsumo::TraCIPositionVector shape;
+    };
+
+    using PolygonFilter = std::function<bool(const Polygon&)>;
+
+    /**
+     * Retrieve many polygons in bulk instead of one getter call per polygon and variable.
+     *
+     * Polygons are processed in batches of pipelined GetVariable commands: types and fill flags
+     * are retrieved first, shapes are then only retrieved for polygons accepted by the filter.
+     *
+     * \param ids identifiers of polygons
+     * \param filter invoked with polygon's type and fill flag (shape is still empty), may be empty
+     * \return accepted polygons in order of ids
+     */
+    std::vector<Polygon> getPolygons(const std::vector<std::string>& ids, const PolygonFilter& filter = nullptr);
+
+protected:
+    /*
+     * All messages exchanged with SUMO pass the following hooks.
+     * A different transport, e.g. an in-process server, only needs to override these.
+     */
+    void sendCommand(const tcpip::Storage&) override;
+    void receiveResponse(tcpip::Storage&) const override;
+
+    /**
+     * Receive next response into a reusable byte buffer
+     * \param buffer grown as necessary, never shrunk
+     * \return length of response message in buffer
+     */
+    virtual std::size_t receiveResponse(std::vector<unsigned char>& buffer) const;
+
+    /**
+     * Decode simulation step response in place from a reusable receive buffer.
+     * This avoids copying the (large) response into a tcpip::Storage.
+     */
+    void readSimulationStepResult() override;
+
+private:
+    void connectServer(const ServerEndpoint&);
+    void connectSocket(const ServerEndpoint&);
+
+    void checkResultState(StorageView&, int command) const;
+    void readVariables(StorageView&, int count, libsumo::TraCIResults&) const;
+    std::shared_ptr<libsumo::TraCIResult> readValue(StorageView&, int type) const;
+
+    int m_client_id = 1;
+    std::unique_ptr<UtmProjection> m_projection;
+    bool m_step_pending = false;
+    bool m_defer_set_commands = false;
+    tcpip::Storage m_deferred_commands;
+    std::vector<int> m_deferred_command_ids;
+    std::size_t m_step_response_size = 0;
+    std::vector<unsigned char> m_receive_buffer;
+    std::string m_object_id; /*< buffer for look-up of decoded object identifiers */
+    std::shared_ptr<InProcessServer> m_server;
+    mutable std::deque<std::vector<unsigned char>> m_server_responses; /*< in-process responses not received yet */
 };
 
 } // namespace traci
@@ -3,10 +3,14 @@
 #include "traci/CheckTimeSync.h"
 #include "traci/Core.h"
 #include "traci/ModuleMapper.h"
+#include "traci/ParallelExecutor.h"
 #include "traci/PersonSink.h"
 #include "traci/VariableCache.h"
 #include "traci/VehicleSink.h"
+#include "traci/VehicleStateTable.h"
+#include "traci/VehicleVariableConsumer.h"
 #include <inet/common/ModuleAccess.h>
+#include <algorithm>
 
 using namespace omnetpp;
 
@@ -20,23 +24,56 @@ static const std::set<int> sPersonVariables {
 static const std::set<int> sVehicleVariables {
     libsumo::VAR_POSITION, libsumo::VAR_SPEED, libsumo::VAR_ANGLE
 };
+// vehicles without node module are only needed as (moving) obstacles
+static const std::set<int> sUnequippedVehicleVariables {
+    libsumo::VAR_POSITION, libsumo::VAR_ANGLE
+};
+static const std::set<int> sStaticVehicleVariables {
+    libsumo::VAR_TYPE, libsumo::VAR_VEHICLECLASS, libsumo::VAR_LENGTH, libsumo::VAR_WIDTH
+};
+static const std::set<int> sStaticVehicleTypeVariables {
+    libsumo::VAR_VEHICLECLASS, libsumo::VAR_MAXSPEED, libsumo::VAR_LENGTH, libsumo::VAR_WIDTH, libsumo::VAR_HEIGHT
+};
 static const std::set<int> sSimulationVariables {
     libsumo::VAR_DEPARTED_VEHICLES_IDS, libsumo::VAR_ARRIVED_VEHICLES_IDS, libsumo::VAR_TELEPORT_STARTING_VEHICLES_IDS,
     libsumo::VAR_TIME
 };
 
+// sink updates per task, a single pose conversion is too cheap to be scheduled on its own
+static const std::size_t sSinkUpdateGrain = 64;
+
+void collectConsumedVehicleVariables(cModule* module, std::set<int>& vars)
+{
+    if (auto consumer = dynamic_cast<VehicleVariableConsumer*>(module)) {
+        const std::set<int> consumed = consumer->getConsumedVehicleVariables();
+        vars.insert(consumed.begin(), consumed.end());
+    }
+    for (cModule::SubmoduleIterator it(module); !it.end(); ++it) {
+        collectConsumedVehicleVariables(*it, vars);
+    }
+}
+
 class VehicleObjectImpl : public BasicNodeManager::VehicleObject
 {
 public:
-    VehicleObjectImpl(std::shared_ptr<VehicleCache> cache) : m_cache(cache) {}
+    VehicleObjectImpl(std::shared_ptr<VehicleCache> cache, NodeHandle handle, const VehicleStateTable& states, VehicleStateTable::Index index) :
+        m_cache(cache), m_handle(handle), m_position(states.position(index)), m_heading(states.angle(index)), m_speed(states.speed(index)) {}
+    VehicleObjectImpl(std::shared_ptr<VehicleCache> cache, NodeHandle handle) :
+        m_cache(cache), m_handle(handle), m_position(cache->get<libsumo::VAR_POSITION>()),
+        m_heading(cache->get<libsumo::VAR_ANGLE>()), m_speed(cache->get<libsumo::VAR_SPEED>()) {}
 
     std::shared_ptr<VehicleCache> getCache() const override { return m_cache; }
-    const TraCIPosition& getPosition() const override { return m_cache->get<libsumo::VAR_POSITION>(); }
-    TraCIAngle getHeading() const override { return TraCIAngle { m_cache->get<libsumo::VAR_ANGLE>() }; }
-    double getSpeed() const override { return m_cache->get<libsumo::VAR_SPEED>(); }
+    NodeHandle getHandle() const override { return m_handle; }
+    const TraCIPosition& getPosition() const override { return m_position; }
+    TraCIAngle getHeading() const override { return m_heading; }
+    double getSpeed() const override { return m_speed; }
 
 private:
     std::shared_ptr<VehicleCache> m_cache;
+    NodeHandle m_handle;
+    TraCIPosition m_position;
+    TraCIAngle m_heading;
+    double m_speed;
 };
 
 class PersonObjectImpl : public BasicNodeManager::PersonObject
@@ -67,6 +104,7 @@ const simsignal_t BasicNodeManager::updatePersonSignal = cComponent::registerSig
 const simsignal_t BasicNodeManager::removePersonSignal = cComponent::registerSignal("traci.person.remove");
 const simsignal_t BasicNodeManager::addVehicleSignal = cComponent::registerSignal("traci.vehicle.add");
 const simsignal_t BasicNodeManager::updateVehicleSignal = cComponent::registerSignal("traci.vehicle.update");
+const simsignal_t BasicNodeManager::updateVehiclesSignal = cComponent::registerSignal("traci.vehicles.updated");
 const simsignal_t BasicNodeManager::removeVehicleSignal = cComponent::registerSignal("traci.vehicle.remove");
 
 void BasicNodeManager::initialize()
@@ -81,6 +119,8 @@ void BasicNodeManager::initialize()
     m_subscriptions = inet::getModuleFromPar<SubscriptionManager>(par("subscriptionsModule"), this);
     m_destroy_vehicles_on_crash = par("destroyVehiclesOnCrash");
     m_ignore_persons = par("ignorePersons");
+    m_subscribe_unequipped_speed = par("subscribeUnequippedSpeed");
+    m_executor = dynamic_cast<ParallelExecutor*>(getModuleByPath(par("taskSchedulerModule")));
 
 }
 
@@ -94,7 +134,9 @@ void BasicNodeManager::traciInit()
 {
     m_boundary = Boundary { m_api->simulation.getNetBoundary() };
     m_subscriptions->subscribeSimulationVariables(sSimulationVariables);
-    m_subscriptions->subscribeVehicleVariables(sVehicleVariables);
+    m_subscriptions->subscribeVehicleVariables(m_subscribe_unequipped_speed ? sVehicleVariables : sUnequippedVehicleVariables);
+    m_subscriptions->subscribeStaticVehicleTypeVariables(sStaticVehicleTypeVariables);
+    m_subscriptions->subscribeStaticVehicleVariables(sStaticVehicleVariables);
 
     // insert already running vehicles
     for (const std::string& id : m_api->vehicle.getIDList()) {
@@ -127,8 +169,10 @@ void BasicNodeManager::traciStep()
 
 void BasicNodeManager::traciClose()
 {
-    for (unsigned i = m_nodes.size(); i > 0; --i) {
-        removeNodeModule(m_nodes.begin()->first);
+    for (NodeHandle handle = 0; handle < m_nodes.size(); ++handle) {
+        if (m_nodes[handle].module) {
+            removeNodeModule(m_handles.getId(handle));
+        }
     }
 }
 
@@ -157,10 +201,25 @@ void BasicNodeManager::processVehicles()
         }
     }
 
-    for (auto& vehicle : m_vehicles) {
-        const std::string& id = vehicle.first;
-        VehicleSink* sink = vehicle.second;
-        updateVehicle(id, sink);
+    // collect vehicle states for bulk update only if someone is interested
+    m_collect_vehicle_updates = mayHaveListeners(updateVehiclesSignal);
+    m_vehicle_updates.clear();
+    if (m_collect_vehicle_updates) {
+        m_vehicle_updates.reserve(m_numberOfVehicles);
+    }
+
+    // slots are looked up per handle because listeners may add vehicles meanwhile
+    for (NodeHandle handle = 0; handle < m_nodes.size(); ++handle) {
+        if (m_nodes[handle].isVehicle) {
+            updateVehicle(m_handles.getId(handle), m_nodes[handle].vehicle);
+        }
+    }
+    commitVehicleSinks();
+
+    if (m_collect_vehicle_updates) {
+        VehicleUpdates updates { m_vehicle_updates, m_handles };
+        emit(updateVehiclesSignal, &updates);
+        m_collect_vehicle_updates = false;
     }
 }
 
@@ -171,15 +230,25 @@ void BasicNodeManager::addVehicle(const std::string& id)
         auto& traci = m_api->vehicle;
         vehicle->initializeSink(m_api, m_subscriptions->getVehicleCache(id), m_boundary);
         vehicle->initializeVehicle(traci.getPosition(id), TraCIAngle { traci.getAngle(id) }, traci.getSpeed(id));
-        m_vehicles[id] = vehicle;
+        getNodeSlot(m_handles.find(id)).vehicle = vehicle;
     };
 
+    NodeSlot& slot = getNodeSlot(m_handles.acquire(id));
+    ASSERT(!slot.isVehicle && !slot.isPerson);
+    slot.isVehicle = true;
+    ++m_numberOfVehicles;
     emit(addVehicleSignal, id.c_str());
     cModuleType* type = m_mapper->vehicle(*this, id);
     if (type != nullptr) {
-        addNodeModule(id, type, init);
-    } else {
-        m_vehicles[id] = nullptr;
+        // vehicle class is the node's NED type, its modules declare the variables they consume
+        const std::string vehicle_class = type->getFullName();
+        m_subscriptions->setVehicleClass(id, vehicle_class);
+        cModule* module = addNodeModule(id, type, init);
+        if (m_consumer_classes.insert(vehicle_class).second) {
+            std::set<int> vars;
+            collectConsumedVehicleVariables(module, vars);
+            m_subscriptions->subscribeVehicleClassVariables(vehicle_class, vars);
+        }
     }
 }
 
@@ -187,19 +256,65 @@ void BasicNodeManager::removeVehicle(const std::string& id)
 {
     emit(removeVehicleSignal, id.c_str());
     removeNodeModule(id);
-    m_vehicles.erase(id);
+    const NodeHandle handle = m_handles.find(id);
+    if (handle != NodeHandleRegistry::invalid && m_nodes[handle].isVehicle) {
+        m_nodes[handle] = NodeSlot {};
+        --m_numberOfVehicles;
+    }
+    m_handles.release(id);
 }
 
 void BasicNodeManager::updateVehicle(const std::string& id, VehicleSink* sink)
 {
+    const VehicleStateTable& states = m_subscriptions->getVehicleStateTable();
+    const VehicleStateTable::Index index = states.find(id);
     auto vehicle = m_subscriptions->getVehicleCache(id);
-    VehicleObjectImpl update(vehicle);
+    // fall back to (possibly synchronous) cache look-up if vehicle is missing in state table
+    const NodeHandle handle = m_handles.find(id);
+    VehicleObjectImpl update = index != VehicleStateTable::npos ?
+        VehicleObjectImpl { vehicle, handle, states, index } : VehicleObjectImpl { vehicle, handle };
     emit(updateVehicleSignal, id.c_str(), &update);
+    if (m_collect_vehicle_updates) {
+        m_vehicle_updates.push_back(VehicleUpdate {
+            handle, update.getPosition(), update.getHeading(), update.getSpeed() });
+    }
     if (sink) {
-        sink->updateVehicle(vehicle->get<libsumo::VAR_POSITION>(),
-                TraCIAngle { vehicle->get<libsumo::VAR_ANGLE>() },
-                vehicle->get<libsumo::VAR_SPEED>());
+        double speed = update.getSpeed();
+        if (speed == libsumo::INVALID_DOUBLE_VALUE) {
+            // subscription of node's vehicle class takes effect with next step
+            speed = vehicle->get<libsumo::VAR_SPEED>();
+        }
+        if (m_executor) {
+            // sink is updated later on by commitVehicleSinks
+            m_pending_sink_updates.push_back(PendingSinkUpdate {
+                sink, update.getPosition(), update.getHeading(), speed, false });
+        } else {
+            sink->updateVehicle(update.getPosition(), update.getHeading(), speed);
+        }
+    }
+}
+
+void BasicNodeManager::commitVehicleSinks()
+{
+    if (m_pending_sink_updates.empty()) {
+        return;
+    }
+
+    // prepare phase is free of OMNeT++ side effects and runs concurrently
+    m_executor->parallelFor(m_pending_sink_updates.size(), sSinkUpdateGrain, [this](std::size_t i) {
+        PendingSinkUpdate& pending = m_pending_sink_updates[i];
+        pending.prepared = pending.sink->prepareVehicle(pending.position, pending.heading, pending.speed);
+    });
+
+    // commit phase emits signals and thus preserves the sequential update order
+    for (PendingSinkUpdate& pending : m_pending_sink_updates) {
+        if (pending.prepared) {
+            pending.sink->commitVehicle();
+        } else {
+            pending.sink->updateVehicle(pending.position, pending.heading, pending.speed);
+        }
     }
+    m_pending_sink_updates.clear();
 }
 
 void BasicNodeManager::processPersons()
@@ -218,10 +333,10 @@ void BasicNodeManager::processPersons()
         removePerson(id);
     }
 
-    for (auto& person : m_persons) {
-        const std::string& id = person.first;
-        PersonSink* sink = person.second;
-        updatePerson(id, sink);
+    for (NodeHandle handle = 0; handle < m_nodes.size(); ++handle) {
+        if (m_nodes[handle].isPerson) {
+            updatePerson(m_handles.getId(handle), m_nodes[handle].person);
+        }
     }
 }
 
@@ -232,15 +347,16 @@ void BasicNodeManager::addPerson(const std::string& id)
         auto& traci = m_api->person;
         person->initializeSink(m_api, m_subscriptions->getPersonCache(id), m_boundary);
         person->initializePerson(traci.getPosition(id), TraCIAngle { traci.getAngle(id) }, traci.getSpeed(id));
-        m_persons[id] = person;
+        getNodeSlot(m_handles.find(id)).person = person;
     };
 
+    NodeSlot& slot = getNodeSlot(m_handles.acquire(id));
+    ASSERT(!slot.isVehicle && !slot.isPerson);
+    slot.isPerson = true;
     emit(addPersonSignal, id.c_str());
     cModuleType* type = m_mapper->person(*this, id);
     if (type != nullptr) {
         addNodeModule(id, type, init);
-    } else {
-        m_persons[id] = nullptr;
     }
 }
 
@@ -248,7 +364,11 @@ void BasicNodeManager::removePerson(const std::string& id)
 {
     emit(removePersonSignal, id.c_str());
     removeNodeModule(id);
-    m_persons.erase(id);
+    const NodeHandle handle = m_handles.find(id);
+    if (handle != NodeHandleRegistry::invalid && m_nodes[handle].isPerson) {
+        m_nodes[handle] = NodeSlot {};
+    }
+    m_handles.release(id);
 }
 
 void BasicNodeManager::updatePerson(const std::string& id, PersonSink* sink)
@@ -275,7 +395,12 @@ cModule* BasicNodeManager::addNodeModule(const std::string& id, cModuleType* typ
     cModule* module = createModule(id, type);
     module->finalizeParameters();
     module->buildInside();
-    m_nodes[id] = module;
+    const NodeHandle handle = m_handles.find(id);
+    if (handle == NodeHandleRegistry::invalid) {
+        throw cRuntimeError("Node %s has no handle, add it as vehicle or person first", id.c_str());
+    }
+    getNodeSlot(handle).module = module;
+    ++m_numberOfNodes;
     init(module);
     module->scheduleStart(simTime());
     module->callInitialize();
@@ -291,7 +416,8 @@ void BasicNodeManager::removeNodeModule(const std::string& id)
         emit(removeNodeSignal, id.c_str(), module);
         module->callFinish();
         module->deleteModule();
-        m_nodes.erase(id);
+        m_nodes[m_handles.find(id)].module = nullptr;
+        --m_numberOfNodes;
     } else {
         EV_DEBUG << "Node with id " << id << " does not exist, no removal\n";
     }
@@ -299,13 +425,22 @@ void BasicNodeManager::removeNodeModule(const std::string& id)
 
 cModule* BasicNodeManager::getNodeModule(const std::string& id)
 {
-    auto found = m_nodes.find(id);
-    return found != m_nodes.end() ? found->second : nullptr;
+    const NodeHandle handle = m_handles.find(id);
+    return handle < m_nodes.size() ? m_nodes[handle].module : nullptr;
 }
 
 std::size_t BasicNodeManager::getNumberOfNodes() const
 {
-    return m_nodes.size();
+    return m_numberOfNodes;
+}
+
+BasicNodeManager::NodeSlot& BasicNodeManager::getNodeSlot(NodeHandle handle)
+{
+    ASSERT(handle != NodeHandleRegistry::invalid);
+    if (handle >= m_nodes.size()) {
+        m_nodes.resize(m_handles.capacity());
+    }
+    return m_nodes[handle];
 }
 
 VehicleSink* BasicNodeManager::getVehicleSink(cModule* node)
@@ -326,8 +461,8 @@ VehicleSink* BasicNodeManager::getVehicleSink(cModule* node)
 
 VehicleSink* BasicNodeManager::getVehicleSink(const std::string& id)
 {
-    auto found = m_vehicles.find(id);
-    return found != m_vehicles.end() ? found->second : nullptr;
+    const NodeHandle handle = m_handles.find(id);
+    return handle < m_nodes.size() ? m_nodes[handle].vehicle : nullptr;
 }
 
 PersonSink* BasicNodeManager::getPersonSink(cModule* node)
@@ -348,8 +483,8 @@ PersonSink* BasicNodeManager::getPersonSink(cModule* node)
 
 PersonSink* BasicNodeManager::getPersonSink(const std::string& id)
 {
-    auto found = m_persons.find(id);
-    return found != m_persons.end() ? found->second : nullptr;
+    const NodeHandle handle = m_handles.find(id);
+    return handle < m_nodes.size() ? m_nodes[handle].person : nullptr;
 }
 
 } // namespace traci
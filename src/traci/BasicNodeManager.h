@@ -5,14 +5,16 @@
 #include "traci/Boundary.h"
 #include "traci/NodeManager.h"
 #include "traci/Listener.h"
+#include "traci/NodeHandle.h"
 #include "traci/Position.h"
 #include "traci/SubscriptionManager.h"
 #include <omnetpp/ccomponent.h>
 #include <omnetpp/csimplemodule.h>
 #include <functional>
-#include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <vector>
 
 namespace traci
 {
@@ -23,6 +25,8 @@ class PersonSink;
 class VehicleCache;
 class VehicleSink;
 
+class ParallelExecutor;
+
 class BasicNodeManager : public NodeManager, public Listener, public omnetpp::cSimpleModule
 {
 public:
@@ -34,10 +38,18 @@ public:
     static const omnetpp::simsignal_t removePersonSignal;
     static const omnetpp::simsignal_t addVehicleSignal;
     static const omnetpp::simsignal_t updateVehicleSignal;
+    static const omnetpp::simsignal_t updateVehiclesSignal;
     static const omnetpp::simsignal_t removeVehicleSignal;
 
     std::shared_ptr<API> getAPI() override { return m_api; }
     SubscriptionManager* getSubscriptions() { return m_subscriptions; }
+    const Boundary& getBoundary() const { return m_boundary; }
+
+    /**
+     * Handles of all managed vehicles and persons.
+     * A node's handle is acquired before its add signal and released after its remove signal.
+     */
+    const NodeHandleRegistry& getNodeHandles() const { return m_handles; }
     std::size_t getNumberOfNodes() const override;
 
     /**
@@ -49,11 +61,52 @@ public:
     {
     public:
         virtual std::shared_ptr<VehicleCache> getCache() const = 0;
+        virtual NodeHandle getHandle() const = 0;
         virtual const TraCIPosition& getPosition() const = 0;
         virtual TraCIAngle getHeading() const = 0;
         virtual double getSpeed() const = 0;
     };
 
+    /**
+     * Plain state of an updated vehicle, member of VehicleUpdates
+     *
+     * Its TraCI identifier is available through VehicleUpdates::getId.
+     */
+    struct VehicleUpdate
+    {
+        NodeHandle handle;
+        TraCIPosition position;
+        TraCIAngle heading;
+        double speed;
+    };
+
+    /**
+     * VehicleUpdates is a view on the states of all vehicles updated in the current step.
+     *
+     * It is emitted once per step along with updateVehiclesSignal after all vehicle sinks have been updated.
+     * Listeners interested in all vehicles should prefer it over the per-vehicle updateVehicleSignal.
+     * The view is only valid during signal emission.
+     */
+    class VehicleUpdates : public omnetpp::cObject
+    {
+    public:
+        using const_iterator = std::vector<VehicleUpdate>::const_iterator;
+
+        VehicleUpdates(const std::vector<VehicleUpdate>& updates, const NodeHandleRegistry& handles) :
+            m_updates(updates), m_handles(handles) {}
+
+        const_iterator begin() const { return m_updates.begin(); }
+        const_iterator end() const { return m_updates.end(); }
+        std::size_t size() const { return m_updates.size(); }
+        bool empty() const { return m_updates.empty(); }
+        const VehicleUpdate& operator[](std::size_t i) const { return m_updates[i]; }
+        const std::string& getId(const VehicleUpdate& update) const { return m_handles.getId(update.handle); }
+
+    private:
+        const std::vector<VehicleUpdate>& m_updates;
+        const NodeHandleRegistry& m_handles;
+    };
+
     class PersonObject : public omnetpp::cObject
     {
     public:
@@ -86,24 +139,52 @@ protected:
     virtual VehicleSink* getVehicleSink(const std::string&);
     virtual void processPersons();
     virtual void processVehicles();
+    virtual void commitVehicleSinks();
 
     void traciInit() override;
     void traciStep() override;
     void traciClose() override;
 
 private:
+    struct PendingSinkUpdate
+    {
+        VehicleSink* sink;
+        TraCIPosition position;
+        TraCIAngle heading;
+        double speed;
+        bool prepared;
+    };
+
+    struct NodeSlot
+    {
+        omnetpp::cModule* module = nullptr;
+        VehicleSink* vehicle = nullptr;
+        PersonSink* person = nullptr;
+        bool isVehicle = false;
+        bool isPerson = false;
+    };
+
+    NodeSlot& getNodeSlot(NodeHandle);
+
     std::shared_ptr<API> m_api;
     ModuleMapper* m_mapper;
     Boundary m_boundary;
     SubscriptionManager* m_subscriptions;
     unsigned m_nodeIndex;
-    std::map<std::string, omnetpp::cModule*> m_nodes;
-    std::map<std::string, PersonSink*> m_persons;
-    std::map<std::string, VehicleSink*> m_vehicles;
+    NodeHandleRegistry m_handles;
+    std::vector<NodeSlot> m_nodes; /*< indexed by node handle */
+    std::size_t m_numberOfNodes = 0;
+    std::size_t m_numberOfVehicles = 0;
+    std::vector<VehicleUpdate> m_vehicle_updates;
+    bool m_collect_vehicle_updates = false;
+    std::vector<PendingSinkUpdate> m_pending_sink_updates;
+    ParallelExecutor* m_executor = nullptr;
     std::string m_vehicle_sink_module;
     std::string m_person_sink_module;
     bool m_destroy_vehicles_on_crash;
     bool m_ignore_persons;
+    bool m_subscribe_unequipped_speed;
+    std::set<std::string> m_consumer_classes; /*< vehicle classes whose consumed variables are subscribed */
     omnetpp::SimTime m_offset = omnetpp::SimTime::ZERO;
 };
 
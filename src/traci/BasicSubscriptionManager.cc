@@ -9,8 +9,15 @@
 #include "traci/CheckTimeSync.h"
 #include "traci/Core.h"
 #include "traci/VariableCache.h"
+#include <boost/lexical_cast.hpp>
 #include <inet/common/ModuleAccess.h>
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_set>
 
 using namespace omnetpp;
 
@@ -30,6 +37,59 @@ void BasicSubscriptionManager::initialize()
     m_api = core->getAPI();
     m_sim_cache = std::make_shared<SimulationCache>(m_api);
     m_ignore_persons = par("ignorePersons");
+
+    cXMLElement* contexts = par("vehicleContexts").xmlValue();
+    if (contexts) {
+        initializeContexts(*contexts);
+    }
+}
+
+void BasicSubscriptionManager::initializeContexts(const cXMLElement& contexts)
+{
+    auto attribute = [](const cXMLElement* element, const char* name) {
+        const char* value = element->getAttribute(name);
+        if (!value) {
+            throw cRuntimeError("Missing attribute %s at %s", name, element->getSourceLocation());
+        }
+        return boost::lexical_cast<double>(value);
+    };
+
+    for (cXMLElement* element : contexts.getChildren()) {
+        VehicleContext context;
+
+        const std::string tag = element->getTagName();
+        if (tag == "circle") {
+            context.x = attribute(element, "x");
+            context.y = attribute(element, "y");
+            context.range = attribute(element, "radius");
+        } else if (tag == "polygon") {
+            // polygon is covered by circle around its bounding box
+            double min_x = std::numeric_limits<double>::infinity();
+            double min_y = min_x;
+            double max_x = -min_x;
+            double max_y = -min_x;
+            for (cXMLElement* point : element->getChildrenByTagName("point")) {
+                const double x = attribute(point, "x");
+                const double y = attribute(point, "y");
+                min_x = std::min(min_x, x);
+                min_y = std::min(min_y, y);
+                max_x = std::max(max_x, x);
+                max_y = std::max(max_y, y);
+            }
+            if (min_x > max_x) {
+                throw cRuntimeError("Context polygon without points at %s", element->getSourceLocation());
+            }
+            context.x = 0.5 * (min_x + max_x);
+            context.y = 0.5 * (min_y + max_y);
+            context.range = 0.5 * std::hypot(max_x - min_x, max_y - min_y);
+        } else {
+            throw cRuntimeError("Unknown vehicle context type %s at %s", tag.c_str(), element->getSourceLocation());
+        }
+
+        m_vehicle_contexts.push_back(context);
+    }
+
+    EV_INFO << "Subscribing vehicles via " << m_vehicle_contexts.size() << " context subscriptions" << endl;
 }
 
 void BasicSubscriptionManager::finish()
@@ -51,15 +111,29 @@ void BasicSubscriptionManager::traciInit()
     };
     subscribeSimulationVariables(vars);
 
-    // subscribe already running vehicles
-    for (const std::string& id : m_api->vehicle.getIDList()) {
-        subscribeVehicle(id);
+    if (m_vehicle_contexts.empty()) {
+        // subscribe already running vehicles
+        for (const std::string& id : m_api->vehicle.getIDList()) {
+            subscribeVehicle(id);
+        }
+    } else {
+        // context anchors are invisible POIs, their identifiers are unique among all TraCI clients
+        const libsumo::TraCIColor transparent { 0, 0, 0, 0 };
+        const std::string prefix = "artery.context." + std::to_string(m_api->getClientId()) + ".";
+        for (std::size_t i = 0; i < m_vehicle_contexts.size(); ++i) {
+            VehicleContext& context = m_vehicle_contexts[i];
+            context.anchor = prefix + std::to_string(i);
+            m_api->poi.add(context.anchor, context.x, context.y, transparent, "artery.context", 0, "", 0.0, 0.0, 0.0);
+        }
+        m_contexts_anchored = true;
+        subscribeContexts();
     }
 
     // subscribe already running persons
     for (const std::string& id : m_api->person.getIDList()) {
         subscribePerson(id);
     }
+    flushSubscriptions();
 
     // read SUMO start time and store it as offset
     m_offset = omnetpp::SimTime { m_api->simulation.getCurrentTime(), omnetpp::SIMTIME_MS };
@@ -77,7 +151,7 @@ void BasicSubscriptionManager::traciClose()
 void BasicSubscriptionManager::subscribePerson(const std::string& id)
 {
     if (!m_person_vars.empty()) {
-        updatePersonSubscription(id, m_person_vars);
+        m_pending_persons.push_back(id);
     }
     m_subscribed_persons.insert(id);
 }
@@ -104,27 +178,31 @@ void BasicSubscriptionManager::subscribePersonVariables(const std::set<int>& add
     ASSERT(m_person_vars.size() >= tmp_vars.size());
 
     if (m_person_vars.size() != tmp_vars.size()) {
-        for (const std::string& vehicle : m_subscribed_persons) {
-            updatePersonSubscription(vehicle, m_person_vars);
-        }
+        // re-subscribe all persons with a single request (pending persons are covered as well)
+        m_pending_persons.assign(m_subscribed_persons.begin(), m_subscribed_persons.end());
+        flushSubscriptions();
     }
 }
 
 void BasicSubscriptionManager::subscribeVehicle(const std::string& id)
 {
+    // new vehicles start in default class
     if (!m_vehicle_vars.empty()) {
-        updateVehicleSubscription(id, m_vehicle_vars);
+        m_pending_vehicles.push_back(id);
     }
     m_subscribed_vehicles.insert(id);
 }
 
 void BasicSubscriptionManager::unsubscribeVehicle(const std::string& id, bool vehicle_exists)
 {
-    if (vehicle_exists && !m_vehicle_vars.empty()) {
+    if (vehicle_exists && !getVehicleVariables(id).empty()) {
         static const std::vector<int> empty;
         updateVehicleSubscription(id, empty);
     }
     m_subscribed_vehicles.erase(id);
+    m_vehicle_classes.erase(id);
+    // vehicle may have been re-assigned to a class just before leaving
+    m_pending_vehicles.erase(std::remove(m_pending_vehicles.begin(), m_pending_vehicles.end(), id), m_pending_vehicles.end());
 }
 
 void BasicSubscriptionManager::updateVehicleSubscription(const std::string& id, const std::vector<int>& vars)
@@ -140,8 +218,236 @@ void BasicSubscriptionManager::subscribeVehicleVariables(const std::set<int>& ad
     ASSERT(m_vehicle_vars.size() >= tmp_vars.size());
 
     if (m_vehicle_vars.size() != tmp_vars.size()) {
-        for (const std::string& vehicle : m_subscribed_vehicles) {
-            updateVehicleSubscription(vehicle, m_vehicle_vars);
+        if (m_vehicle_contexts.empty()) {
+            // re-subscribe all vehicles with a single request (pending vehicles are covered as well)
+            m_pending_vehicles.assign(m_subscribed_vehicles.begin(), m_subscribed_vehicles.end());
+            flushSubscriptions();
+        } else {
+            subscribeContexts();
+        }
+    }
+}
+
+void BasicSubscriptionManager::subscribeVehicleClassVariables(const std::string& vehicle_class, const std::set<int>& add_vars)
+{
+    if (vehicle_class.empty()) {
+        subscribeVehicleVariables(add_vars);
+        return;
+    }
+
+    std::vector<int>& class_vars = m_vehicle_class_vars[vehicle_class];
+    std::vector<int> tmp_vars;
+    std::set_union(class_vars.begin(), class_vars.end(), add_vars.begin(), add_vars.end(), std::back_inserter(tmp_vars));
+    std::swap(class_vars, tmp_vars);
+    ASSERT(class_vars.size() >= tmp_vars.size());
+
+    if (class_vars.size() != tmp_vars.size()) {
+        if (m_vehicle_contexts.empty()) {
+            // re-subscribe only vehicles of this class
+            for (const auto& vehicle : m_vehicle_classes) {
+                if (vehicle.second == vehicle_class && m_subscribed_vehicles.count(vehicle.first) > 0) {
+                    m_pending_vehicles.push_back(vehicle.first);
+                }
+            }
+            flushSubscriptions();
+        } else {
+            subscribeContexts();
+        }
+    }
+}
+
+void BasicSubscriptionManager::setVehicleClass(const std::string& id, const std::string& vehicle_class)
+{
+    const std::vector<int> previous_vars = getVehicleVariables(id);
+    if (vehicle_class.empty()) {
+        m_vehicle_classes.erase(id);
+    } else {
+        m_vehicle_classes[id] = vehicle_class;
+    }
+
+    // context subscriptions cover variables of all classes anyway
+    if (m_vehicle_contexts.empty() && m_subscribed_vehicles.count(id) > 0 && getVehicleVariables(id) != previous_vars) {
+        // batched with departing vehicles by next step
+        m_pending_vehicles.push_back(id);
+    }
+}
+
+std::vector<int> BasicSubscriptionManager::getVehicleVariables(const std::string& id) const
+{
+    auto found = m_vehicle_classes.find(id);
+    return found != m_vehicle_classes.end() ? getVehicleClassVariables(found->second) : m_vehicle_vars;
+}
+
+std::vector<int> BasicSubscriptionManager::getVehicleClassVariables(const std::string& vehicle_class) const
+{
+    auto found = m_vehicle_class_vars.find(vehicle_class);
+    if (found == m_vehicle_class_vars.end()) {
+        return m_vehicle_vars;
+    }
+
+    std::vector<int> vars;
+    std::set_union(m_vehicle_vars.begin(), m_vehicle_vars.end(), found->second.begin(), found->second.end(), std::back_inserter(vars));
+    return vars;
+}
+
+void BasicSubscriptionManager::subscribeContexts()
+{
+    if (!m_contexts_anchored) {
+        // contexts are subscribed as soon as their anchors exist (see traciInit)
+        return;
+    }
+
+    // vehicle classes are unknown before vehicles enter a context, hence subscribe variables of all classes
+    std::vector<int> vars = m_vehicle_vars;
+    for (const auto& class_vars : m_vehicle_class_vars) {
+        std::vector<int> tmp_vars;
+        std::set_union(vars.begin(), vars.end(), class_vars.second.begin(), class_vars.second.end(), std::back_inserter(tmp_vars));
+        std::swap(vars, tmp_vars);
+    }
+
+    for (const VehicleContext& context : m_vehicle_contexts) {
+        m_api->poi.subscribeContext(context.anchor, libsumo::CMD_GET_VEHICLE_VARIABLE, context.range, vars,
+                libsumo::INVALID_DOUBLE_VALUE, libsumo::INVALID_DOUBLE_VALUE);
+    }
+}
+
+void BasicSubscriptionManager::stepContexts()
+{
+    // vehicles are subscribed as long as they are within any context
+    // views refer to keys of this step's context results, i.e. staying vehicles cause no string copies
+    std::unordered_set<std::string_view> current_vehicles;
+    std::vector<std::string> entered_vehicles;
+    m_vehicle_states.beginStep();
+    auto& pois = m_api->poi;
+    for (const VehicleContext& context : m_vehicle_contexts) {
+        for (const auto& vehicle : pois.getModifiableContextSubscriptionResults(context.anchor)) {
+            if (current_vehicles.insert(vehicle.first).second) {
+                getVehicleCache(vehicle.first)->reset(vehicle.second);
+                m_vehicle_states.update(vehicle.first, vehicle.second);
+                if (m_subscribed_vehicles.count(vehicle.first) == 0) {
+                    m_subscribed_vehicles.insert(vehicle.first);
+                    entered_vehicles.push_back(vehicle.first);
+                }
+            }
+        }
+    }
+    reportIncompleteVehicles(m_vehicle_states.endStep());
+    prefetchStaticVariables(entered_vehicles);
+
+    // drop stale values of vehicles which left all contexts
+    static const libsumo::TraCIResults no_results;
+    for (auto it = m_subscribed_vehicles.begin(); it != m_subscribed_vehicles.end();) {
+        if (current_vehicles.count(*it) == 0) {
+            getVehicleCache(*it)->reset(no_results);
+            it = m_subscribed_vehicles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void BasicSubscriptionManager::reportIncompleteVehicles(std::size_t count)
+{
+    // just subscribed vehicles have no results until the next step
+    if (count > 0) {
+        EV_DETAIL << count << " subscribed vehicles lack position or angle results, "
+            << "they are missing in the vehicle state table of this step\n";
+    }
+}
+
+void BasicSubscriptionManager::flushSubscriptions()
+{
+    if (!m_pending_vehicles.empty()) {
+        // one batched request per vehicle class, ordered by class for reproducible command sequences
+        std::map<std::string, std::vector<std::string>> batches;
+        std::unordered_set<std::string> batched;
+        for (const std::string& vehicle : m_pending_vehicles) {
+            if (!batched.insert(vehicle).second) {
+                // e.g. a departed vehicle assigned to its class within the same step
+                continue;
+            }
+            auto found = m_vehicle_classes.find(vehicle);
+            batches[found != m_vehicle_classes.end() ? found->second : std::string()].push_back(vehicle);
+        }
+        for (const auto& batch : batches) {
+            m_api->subscribeObjects(libsumo::CMD_SUBSCRIBE_VEHICLE_VARIABLE, batch.second, getVehicleClassVariables(batch.first));
+        }
+        m_pending_vehicles.clear();
+    }
+
+    if (!m_pending_persons.empty()) {
+        m_api->subscribeObjects(libsumo::CMD_SUBSCRIBE_PERSON_VARIABLE, m_pending_persons, m_person_vars);
+        m_pending_persons.clear();
+    }
+}
+
+void BasicSubscriptionManager::subscribeStaticVehicleVariables(const std::set<int>& add_vars)
+{
+    std::set<int> vars = add_vars;
+    vars.insert(libsumo::VAR_TYPE); // required for sharing type caches
+
+    std::vector<int> tmp_vars;
+    std::set_union(m_static_vehicle_vars.begin(), m_static_vehicle_vars.end(), vars.begin(), vars.end(), std::back_inserter(tmp_vars));
+    std::swap(m_static_vehicle_vars, tmp_vars);
+    ASSERT(m_static_vehicle_vars.size() >= tmp_vars.size());
+
+    if (m_static_vehicle_vars.size() != tmp_vars.size()) {
+        const std::vector<std::string> vehicles(m_subscribed_vehicles.begin(), m_subscribed_vehicles.end());
+        prefetchStaticVariables(vehicles);
+    }
+}
+
+void BasicSubscriptionManager::subscribeStaticVehicleTypeVariables(const std::set<int>& add_vars)
+{
+    std::vector<int> tmp_vars;
+    std::set_union(m_static_type_vars.begin(), m_static_type_vars.end(), add_vars.begin(), add_vars.end(), std::back_inserter(tmp_vars));
+    std::swap(m_static_type_vars, tmp_vars);
+    ASSERT(m_static_type_vars.size() >= tmp_vars.size());
+
+    if (m_static_type_vars.size() != tmp_vars.size() && !m_vehicle_type_caches.empty()) {
+        std::vector<std::string> types;
+        for (const auto& type : m_vehicle_type_caches) {
+            types.push_back(type.first);
+        }
+
+        libsumo::SubscriptionResults results;
+        m_api->getObjectVariables(libsumo::CMD_GET_VEHICLETYPE_VARIABLE, types, m_static_type_vars, results);
+        for (const auto& type : results) {
+            getVehicleTypeCache(type.first)->preserve(type.second);
+        }
+    }
+}
+
+void BasicSubscriptionManager::prefetchStaticVariables(const std::vector<std::string>& vehicles)
+{
+    if (vehicles.empty() || m_static_vehicle_vars.empty()) {
+        return;
+    }
+
+    libsumo::SubscriptionResults results;
+    m_api->getObjectVariables(libsumo::CMD_GET_VEHICLE_VARIABLE, vehicles, m_static_vehicle_vars, results);
+
+    std::vector<std::string> new_types;
+    for (const auto& vehicle : results) {
+        auto cache = getVehicleCache(vehicle.first);
+        cache->preserve(vehicle.second);
+
+        auto type = vehicle.second.find(libsumo::VAR_TYPE);
+        if (type != vehicle.second.end()) {
+            const std::string& type_id = static_cast<const libsumo::TraCIString*>(type->second.get())->value;
+            if (m_vehicle_type_caches.find(type_id) == m_vehicle_type_caches.end()) {
+                new_types.push_back(type_id);
+            }
+            cache->setTypeCache(getVehicleTypeCache(type_id));
+        }
+    }
+
+    // each vehicle type is fetched only once
+    if (!new_types.empty() && !m_static_type_vars.empty()) {
+        results.clear();
+        m_api->getObjectVariables(libsumo::CMD_GET_VEHICLETYPE_VARIABLE, new_types, m_static_type_vars, results);
+        for (const auto& type : results) {
+            getVehicleTypeCache(type.first)->preserve(type.second);
         }
     }
 }
@@ -164,20 +470,31 @@ void BasicSubscriptionManager::step()
     m_sim_cache->reset(simvars);
     ASSERT(checkTimeSync(*m_sim_cache, omnetpp::simTime() + m_offset));
 
-    const auto& arrivedVehicles = m_sim_cache->get<libsumo::VAR_ARRIVED_VEHICLES_IDS>();
-    for (const auto& id : arrivedVehicles) {
-        unsubscribeVehicle(id, false);
-    }
+    if (m_vehicle_contexts.empty()) {
+        const auto& arrivedVehicles = m_sim_cache->get<libsumo::VAR_ARRIVED_VEHICLES_IDS>();
+        for (const auto& id : arrivedVehicles) {
+            unsubscribeVehicle(id, false);
+        }
 
-    const auto& departedVehicles = m_sim_cache->get<libsumo::VAR_DEPARTED_VEHICLES_IDS>();
-    for (const auto& id : departedVehicles) {
-        subscribeVehicle(id);
-    }
+        const auto& departedVehicles = m_sim_cache->get<libsumo::VAR_DEPARTED_VEHICLES_IDS>();
+        for (const auto& id : departedVehicles) {
+            subscribeVehicle(id);
+        }
+        flushSubscriptions();
+        prefetchStaticVariables(departedVehicles);
 
-    const auto& vehicles = m_api->vehicle;
-    for (const std::string& vehicle : m_subscribed_vehicles) {
-        const auto& vars = vehicles.getSubscriptionResults(vehicle);
-        getVehicleCache(vehicle)->reset(vars);
+        static const libsumo::TraCIResults no_results;
+        const auto& vehicles = m_api->vehicle.getModifiableSubscriptionResults();
+        m_vehicle_states.beginStep();
+        for (const std::string& vehicle : m_subscribed_vehicles) {
+            auto found = vehicles.find(vehicle);
+            const auto& vars = found != vehicles.end() ? found->second : no_results;
+            getVehicleCache(vehicle)->reset(vars);
+            m_vehicle_states.update(vehicle, vars);
+        }
+        reportIncompleteVehicles(m_vehicle_states.endStep());
+    } else {
+        stepContexts();
     }
 
     if (!m_ignore_persons) {
@@ -190,6 +507,7 @@ void BasicSubscriptionManager::step()
         for (const auto& id : departedPersons) {
             subscribePerson(id);
         }
+        flushSubscriptions();
 
         const auto& persons = m_api->person;
         for (const std::string& person : m_subscribed_persons) {
@@ -217,12 +535,26 @@ std::shared_ptr<VehicleCache> BasicSubscriptionManager::getVehicleCache(const st
     return found->second;
 }
 
+std::shared_ptr<VehicleTypeCache> BasicSubscriptionManager::getVehicleTypeCache(const std::string& id)
+{
+    auto found = m_vehicle_type_caches.find(id);
+    if (found == m_vehicle_type_caches.end()) {
+        std::tie(found, std::ignore) = m_vehicle_type_caches.emplace(id, std::make_shared<VehicleTypeCache>(m_api, id));
+    }
+    return found->second;
+}
+
 std::shared_ptr<SimulationCache> BasicSubscriptionManager::getSimulationCache()
 {
     ASSERT(m_sim_cache);
     return m_sim_cache;
 }
 
+const VehicleStateTable& BasicSubscriptionManager::getVehicleStateTable() const
+{
+    return m_vehicle_states;
+}
+
 const std::unordered_set<std::string>& BasicSubscriptionManager::getSubscribedPersons() const
 {
     return m_subscribed_persons;
@@ -9,10 +9,13 @@
 
 #include "traci/Listener.h"
 #include "traci/SubscriptionManager.h"
+#include "traci/VehicleStateTable.h"
 #include <omnetpp/csimplemodule.h>
+#include <omnetpp/cxmlelement.h>
 #include <omnetpp/simtime.h>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace traci
 {
@@ -29,12 +32,18 @@ public:
     void subscribePersonVariables(const std::set<int>& personVariables) override;
     void subscribeVehicleVariables(const std::set<int>& vehicleVariables) override;
     void subscribeSimulationVariables(const std::set<int>& simulationVariables) override;
+    void subscribeVehicleClassVariables(const std::string& vehicleClass, const std::set<int>& vehicleVariables) override;
+    void setVehicleClass(const std::string& vehicle, const std::string& vehicleClass) override;
+    void subscribeStaticVehicleVariables(const std::set<int>& vehicleVariables) override;
+    void subscribeStaticVehicleTypeVariables(const std::set<int>& typeVariables) override;
     const std::unordered_set<std::string>& getSubscribedPersons() const override;
     const std::unordered_set<std::string>& getSubscribedVehicles() const override;
     const std::unordered_map<std::string, std::shared_ptr<VehicleCache>>& getAllVehicleCaches() const override;
     std::shared_ptr<PersonCache> getPersonCache(const std::string& id) override;
     std::shared_ptr<VehicleCache> getVehicleCache(const std::string& id) override;
+    std::shared_ptr<VehicleTypeCache> getVehicleTypeCache(const std::string& id) override;
     std::shared_ptr<SimulationCache> getSimulationCache() override;
+    const VehicleStateTable& getVehicleStateTable() const override;
 
 protected:
     void initialize() override;
@@ -52,21 +61,60 @@ private:
     void unsubscribePerson(const std::string& id, bool person_exists);
     void updatePersonSubscription(const std::string& id, const std::vector<int>& vars);
 
+    void initializeContexts(const omnetpp::cXMLElement&);
+    void subscribeContexts();
+    void stepContexts();
+    void reportIncompleteVehicles(std::size_t count);
+
     void subscribeVehicle(const std::string& id);
     void unsubscribeVehicle(const std::string& id, bool vehicle_exists);
     void updateVehicleSubscription(const std::string& id, const std::vector<int>& vars);
 
+    /**
+     * Common vehicle variables joined with those of a vehicle's class
+     */
+    std::vector<int> getVehicleVariables(const std::string& id) const;
+    std::vector<int> getVehicleClassVariables(const std::string& vehicleClass) const;
+
+    /**
+     * Send all pending subscriptions as batched requests
+     */
+    void flushSubscriptions();
+
+    /**
+     * Retrieve static variables of given vehicles and their types in batched requests
+     */
+    void prefetchStaticVariables(const std::vector<std::string>& vehicles);
+
+    struct VehicleContext
+    {
+        std::string anchor; /*< identifier of SUMO POI anchoring this context */
+        double x;
+        double y;
+        double range;
+    };
+
     std::shared_ptr<API> m_api;
+    std::vector<VehicleContext> m_vehicle_contexts;
     std::unordered_set<std::string> m_subscribed_persons;
     std::unordered_set<std::string> m_subscribed_vehicles;
+    std::vector<std::string> m_pending_persons;
+    std::vector<std::string> m_pending_vehicles;
     std::vector<int> m_person_vars;
     std::vector<int> m_vehicle_vars;
+    std::unordered_map<std::string, std::vector<int>> m_vehicle_class_vars; /*< additional variables per class */
+    std::unordered_map<std::string, std::string> m_vehicle_classes; /*< vehicles not in default class */
     std::vector<int> m_sim_vars;
+    std::vector<int> m_static_vehicle_vars;
+    std::vector<int> m_static_type_vars;
     std::unordered_map<std::string, std::shared_ptr<PersonCache>> m_person_caches;
     std::unordered_map<std::string, std::shared_ptr<VehicleCache>> m_vehicle_caches;
+    std::unordered_map<std::string, std::shared_ptr<VehicleTypeCache>> m_vehicle_type_caches;
     std::shared_ptr<SimulationCache> m_sim_cache;
+    VehicleStateTable m_vehicle_states;
     omnetpp::SimTime m_offset = omnetpp::SimTime::ZERO;
     bool m_ignore_persons;
+    bool m_contexts_anchored = false;
 };
 
 } // namespace traci
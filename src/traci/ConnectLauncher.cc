@@ -9,6 +9,7 @@ void ConnectLauncher::initialize()
 {
     m_endpoint.hostname = par("hostname").stringValue();
     m_endpoint.port = par("port");
+    m_endpoint.socketPath = par("socketPath").stringValue();
     m_endpoint.clientId = par("clientId");
 }
 
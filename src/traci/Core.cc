@@ -2,8 +2,12 @@
 #include "traci/Launcher.h"
 #include "traci/API.h"
 #include "traci/SubscriptionManager.h"
+#include "traci/VariableCache.h"
 #include <inet/common/ModuleAccess.h>
+#include <algorithm>
+#include <chrono>
 #include <limits>
+#include <set>
 
 Define_Module(traci::Core)
 
@@ -15,6 +19,43 @@ namespace
 const simsignal_t initSignal = cComponent::registerSignal("traci.init");
 const simsignal_t stepSignal = cComponent::registerSignal("traci.step");
 const simsignal_t closeSignal = cComponent::registerSignal("traci.close");
+const simsignal_t sumoTimeSignal = cComponent::registerSignal("traciSumoTime");
+const simsignal_t subscriptionsTimeSignal = cComponent::registerSignal("traciSubscriptionsTime");
+const simsignal_t listenersTimeSignal = cComponent::registerSignal("traciListenersTime");
+const simsignal_t stepBytesSignal = cComponent::registerSignal("traciStepBytes");
+const simsignal_t catchUpSignal = cComponent::registerSignal("testbed.catchUp");
+const simsignal_t forkPrepareSignal = cComponent::registerSignal("replicationFork.prepare");
+const simsignal_t forkChildSignal = cComponent::registerSignal("replicationFork.child");
+
+class StepTimer
+{
+public:
+    StepTimer(bool enabled) : m_enabled(enabled)
+    {
+        if (m_enabled) {
+            m_start = std::chrono::steady_clock::now();
+        }
+    }
+
+    /**
+     * Get elapsed wall-clock time since last lap (or construction)
+     * \return elapsed seconds, 0 if timer is disabled
+     */
+    double lap()
+    {
+        if (!m_enabled) {
+            return 0.0;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        const std::chrono::duration<double> elapsed = now - m_start;
+        m_start = now;
+        return elapsed.count();
+    }
+
+private:
+    bool m_enabled;
+    std::chrono::steady_clock::time_point m_start;
+};
 }
 
 namespace traci
@@ -38,6 +79,20 @@ void Core::initialize()
     cModule* manager = getParentModule();
     m_launcher = inet::getModuleFromPar<Launcher>(par("launcherModule"), manager);
     m_stopping = par("selfStopping");
+    m_pipelined = par("pipelinedStepping");
+    m_measure = par("measureStepTimes");
+    m_stepsPerUpdate = par("stepsPerUpdate");
+    if (m_stepsPerUpdate < 1) {
+        throw cRuntimeError("stepsPerUpdate has to be at least 1");
+    }
+    m_regularStepsPerUpdate = m_stepsPerUpdate;
+    m_catchUpStepsPerUpdate = par("catchUpStepsPerUpdate");
+    if (m_catchUpStepsPerUpdate > m_stepsPerUpdate) {
+        getSimulation()->getSystemModule()->subscribe(catchUpSignal, this);
+    }
+    m_fastForwardHorizon = par("fastForwardHorizon");
+    getSimulation()->getSystemModule()->subscribe(forkPrepareSignal, this);
+    getSimulation()->getSystemModule()->subscribe(forkChildSignal, this);
     scheduleAt(par("startTime"), m_connectEvent);
     m_subscriptions = inet::getModuleFromPar<SubscriptionManager>(par("subscriptionsModule"), manager, false);
 }
@@ -53,23 +108,180 @@ void Core::finish()
 void Core::handleMessage(cMessage* msg)
 {
     if (msg == m_updateEvent) {
-        m_traci->simulationStep();
+        StepTimer timer(m_measure);
+        if (m_pipelined) {
+            m_traci->completeSimulationStep();
+        } else {
+            m_traci->simulationStep(m_stepTarget);
+        }
+        if (m_measure) {
+            emit(sumoTimeSignal, timer.lap());
+            emit(stepBytesSignal, static_cast<unsigned long>(m_traci->getStepResponseSize()));
+        }
+
         if (m_subscriptions) {
             m_subscriptions->step();
+            if (m_countRunning) {
+                countRunning();
+            }
+            if (m_measure) {
+                emit(subscriptionsTimeSignal, timer.lap());
+            }
         }
+
         emit(stepSignal, simTime());
+        if (m_measure) {
+            emit(listenersTimeSignal, timer.lap());
+        }
 
-        if (!m_stopping || m_traci->simulation.getMinExpectedNumber() > 0) {
-            scheduleAt(simTime() + m_updateInterval, m_updateEvent);
+        const bool fastForward = m_fastForwardHorizon > m_updateInterval;
+        const int expected = m_stopping || fastForward ? getMinExpectedNumber() : 1;
+        if (!m_stopping || expected > 0) {
+            m_quiescent = fastForward && isQuiescent(expected);
+            scheduleNextStep();
         }
     } else if (msg == m_connectEvent) {
         m_traci->connect(m_launcher->launch());
         checkVersion();
         syncTime();
+        if (par("localGeoProjection")) {
+            if (m_traci->useLocalGeoProjection()) {
+                EV_INFO << "Geodetic positions are projected locally" << endl;
+            } else {
+                EV_WARN << "Network projection is not supported locally, converting positions by TraCI" << endl;
+            }
+        }
         emit(initSignal, simTime());
-        m_updateInterval = Time { m_traci->simulation.getDeltaT() };
-        scheduleAt(simTime() + m_updateInterval, m_updateEvent);
+        m_offset = SimTime { m_traci->simulation.getCurrentTime(), SIMTIME_MS } - simTime();
+        m_stepLength = Time { m_traci->simulation.getDeltaT() };
+        m_updateInterval = m_stepLength * m_stepsPerUpdate;
+        if (m_subscriptions) {
+            subscribeRunning();
+        }
+        scheduleNextStep();
+    }
+}
+
+void Core::receiveSignal(cComponent*, simsignal_t signal, bool catchingUp, cObject*)
+{
+    if (signal == catchUpSignal) {
+        // coalesce SUMO steps while real-time simulation lags behind, takes effect with next scheduled step
+        m_stepsPerUpdate = catchingUp ? m_catchUpStepsPerUpdate : m_regularStepsPerUpdate;
+        m_updateInterval = m_stepLength * m_stepsPerUpdate;
+    } else if (signal == forkPrepareSignal) {
+        prepareFork();
+    }
+}
+
+void Core::receiveSignal(cComponent*, simsignal_t signal, long replication, cObject*)
+{
+    if (signal == forkChildSignal) {
+        EV_INFO << "Continuing TraCI session in replication " << replication << endl;
+        continueFork();
+    }
+}
+
+void Core::prepareFork()
+{
+    Enter_Method_Silent();
+    if (m_connectEvent->isScheduled()) {
+        // forked processes connect on their own
+        return;
+    } else if (!m_launcher->canRelaunch()) {
+        throw cRuntimeError("TraCI launcher cannot serve forked processes");
     }
+
+    // server has to be idle while process is forked
+    m_traci->completeSimulationStep();
+    m_traci->flushSetCommands();
+}
+
+void Core::continueFork()
+{
+    Enter_Method_Silent();
+    if (!m_connectEvent->isScheduled()) {
+        m_traci->reconnect(m_launcher->relaunch());
+    }
+}
+
+void Core::scheduleNextStep()
+{
+    const SimTime interval = m_quiescent ? getFastForwardInterval() : m_updateInterval;
+    scheduleAt(simTime() + interval, m_updateEvent);
+    m_stepTarget = getStepTarget(m_updateEvent->getArrivalTime(), interval);
+    if (m_pipelined) {
+        // let SUMO compute next step while OMNeT++ processes events until then
+        m_traci->requestSimulationStep(m_stepTarget);
+    }
+}
+
+void Core::subscribeRunning()
+{
+    // expected number and running vehicles and persons are tracked by subscriptions instead of queries per step
+    std::set<int> vars;
+    if (m_stopping || m_fastForwardHorizon > SimTime::ZERO) {
+        vars.insert(libsumo::VAR_MIN_EXPECTED_VEHICLES);
+    }
+    if (m_fastForwardHorizon > SimTime::ZERO) {
+        vars.insert({
+            libsumo::VAR_DEPARTED_VEHICLES_IDS, libsumo::VAR_ARRIVED_VEHICLES_IDS,
+            libsumo::VAR_DEPARTED_PERSONS_IDS, libsumo::VAR_ARRIVED_PERSONS_IDS
+        });
+        m_runningVehicles = m_traci->vehicle.getIDCount();
+        m_runningPersons = m_traci->person.getIDCount();
+        m_countRunning = true;
+    }
+    if (!vars.empty()) {
+        m_subscriptions->subscribeSimulationVariables(vars);
+    }
+}
+
+void Core::countRunning()
+{
+    auto sim = m_subscriptions->getSimulationCache();
+    m_runningVehicles += sim->get<libsumo::VAR_DEPARTED_VEHICLES_IDS>().size();
+    m_runningVehicles -= sim->get<libsumo::VAR_ARRIVED_VEHICLES_IDS>().size();
+    m_runningPersons += sim->get<libsumo::VAR_DEPARTED_PERSONS_IDS>().size();
+    m_runningPersons -= sim->get<libsumo::VAR_ARRIVED_PERSONS_IDS>().size();
+}
+
+int Core::getMinExpectedNumber()
+{
+    if (m_subscriptions) {
+        return m_subscriptions->getSimulationCache()->get<libsumo::VAR_MIN_EXPECTED_VEHICLES>();
+    } else {
+        return m_traci->simulation.getMinExpectedNumber();
+    }
+}
+
+bool Core::isQuiescent(int expected)
+{
+    // SUMO does not expose its next departure, thus loaded vehicles are waited for at most fastForwardHorizon
+    if (expected == 0) {
+        return true;
+    } else if (m_countRunning) {
+        return m_runningVehicles <= 0 && m_runningPersons <= 0;
+    } else {
+        return m_traci->vehicle.getIDCount() == 0 && m_traci->person.getIDCount() == 0;
+    }
+}
+
+SimTime Core::getFastForwardInterval() const
+{
+    SimTime limit = simTime() + m_fastForwardHorizon;
+    const cFutureEventSet* fes = getSimulation()->getFES();
+    if (!fes->isEmpty()) {
+        // events at limit see SUMO's state of that time because TraCI steps have top priority
+        limit = std::min(limit, fes->peekFirst()->getArrivalTime());
+    }
+    const int64_t steps = std::max<int64_t>(1, (limit - simTime()).raw() / m_updateInterval.raw());
+    return SimTime::fromRaw(m_updateInterval.raw() * steps);
+}
+
+double Core::getStepTarget(SimTime due, SimTime interval) const
+{
+    // SUMO steps to given target time with its own step length
+    return interval > m_stepLength ? (due + m_offset).dbl() : 0.0;
 }
 
 void Core::checkVersion()
@@ -1,6 +1,7 @@
 #ifndef CORE_H_HPQGM1MF
 #define CORE_H_HPQGM1MF
 
+#include <omnetpp/clistener.h>
 #include <omnetpp/cmessage.h>
 #include <omnetpp/csimplemodule.h>
 #include <omnetpp/simtime.h>
@@ -14,7 +15,7 @@ class Launcher;
 class LiteAPI;
 class SubscriptionManager;
 
-class Core : public omnetpp::cSimpleModule
+class Core : public omnetpp::cSimpleModule, public omnetpp::cListener
 {
 public:
     Core();
@@ -23,20 +24,83 @@ public:
     void initialize() override;
     void finish() override;
     void handleMessage(omnetpp::cMessage*) override;
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, bool, omnetpp::cObject*) override;
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, long, omnetpp::cObject*) override;
     std::shared_ptr<API> getAPI();
 
 protected:
     virtual void checkVersion();
     virtual void syncTime();
+    virtual void scheduleNextStep();
+
+    /**
+     * Bring TraCI connection into a state which can be inherited by forked processes
+     */
+    virtual void prepareFork();
+
+    /**
+     * Continue TraCI session on a server of its own in a forked process
+     */
+    virtual void continueFork();
+
+    /**
+     * Check if neither vehicles nor persons are in SUMO's network, i.e. steps can be skipped
+     * \param expected minimum number of expected vehicles and persons reported by SUMO
+     */
+    virtual bool isQuiescent(int expected);
+
+    /**
+     * Get minimum number of expected vehicles and persons, subscribed if SubscriptionManager is available
+     */
+    int getMinExpectedNumber();
+
+    /**
+     * Subscribe simulation variables required for self-stopping and fast-forwarding
+     */
+    void subscribeRunning();
+
+    /**
+     * Count running vehicles and persons by departures and arrivals of last step
+     */
+    void countRunning();
+
+    /**
+     * Get interval until next step while SUMO is quiescent
+     *
+     * The interval is a multiple of the update interval not passing OMNeT++'s next event
+     * and the fast-forward horizon.
+     */
+    omnetpp::SimTime getFastForwardInterval() const;
+
+    /**
+     * Get target time of a SUMO step command
+     * \param due simulation time when step is due
+     * \param interval simulation time since previous step
+     * \return SUMO time in seconds or 0 for a single SUMO step
+     */
+    double getStepTarget(omnetpp::SimTime due, omnetpp::SimTime interval) const;
 
 private:
     omnetpp::cMessage* m_connectEvent;
     omnetpp::cMessage* m_updateEvent;
     omnetpp::SimTime m_updateInterval;
+    omnetpp::SimTime m_offset;
+    omnetpp::SimTime m_stepLength;
+    int m_stepsPerUpdate;
+    int m_regularStepsPerUpdate;
+    int m_catchUpStepsPerUpdate;
+    omnetpp::SimTime m_fastForwardHorizon;
+    bool m_quiescent = false;
+    bool m_countRunning = false;
+    long m_runningVehicles = 0;
+    long m_runningPersons = 0;
+    double m_stepTarget = 0.0;
 
     Launcher* m_launcher;
     std::shared_ptr<API> m_traci;
     bool m_stopping;
+    bool m_pipelined;
+    bool m_measure;
     SubscriptionManager* m_subscriptions;
 };
 
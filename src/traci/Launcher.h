@@ -1,17 +1,35 @@
 #ifndef LAUNCHER_H_NAC0X8JG
 #define LAUNCHER_H_NAC0X8JG
 
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace traci
 {
 
+/**
+ * InProcessServer answers TraCI messages without any socket
+ *
+ * Request and response are sequences of commands without the leading message length.
+ */
+class InProcessServer
+{
+public:
+    virtual ~InProcessServer() = default;
+    virtual void process(const unsigned char* request, std::size_t length, std::vector<unsigned char>& response) = 0;
+};
+
 struct ServerEndpoint
 {
     std::string hostname;
     int port;
+    std::string socketPath; /*< Unix-domain socket preferred over hostname and port if not empty */
     int clientId = 1;
     bool retry = false;
+    std::shared_ptr<InProcessServer> server; /*< in-process server preferred over any socket if set */
 };
 
 class Launcher
@@ -20,6 +38,17 @@ public:
 
     virtual ~Launcher() = default;
     virtual ServerEndpoint launch() = 0;
+
+    /**
+     * Check if relaunch() is supported
+     */
+    virtual bool canRelaunch() const { return false; }
+
+    /**
+     * Provide a server for a forked process continuing the launched server's session
+     * \return endpoint of server serving the forked process exclusively
+     */
+    virtual ServerEndpoint relaunch() { throw std::runtime_error("launcher cannot serve forked processes"); }
 };
 
 } // namespace traci
@@ -0,0 +1,70 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "traci/LibsumoLauncher.h"
+#include "traci/LibsumoServer.h"
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace traci
+{
+
+Define_Module(LibsumoLauncher)
+
+void LibsumoLauncher::initialize()
+{
+    m_sumocfg = par("sumocfg").stringValue();
+    m_seed = par("seed");
+    m_extra_options = par("extraOptions").stringValue();
+}
+
+ServerEndpoint LibsumoLauncher::launch()
+{
+    if (m_server) {
+        throw omnetpp::cRuntimeError("libsumo allows only one SUMO simulation per process");
+    }
+
+    std::vector<std::string> args {
+        "--configuration-file", m_sumocfg,
+        "--seed", std::to_string(m_seed),
+        "--no-step-log"
+    };
+    std::istringstream extra_options { m_extra_options };
+    std::string option;
+    while (extra_options >> option) {
+        args.push_back(option);
+    }
+
+    try {
+        m_server = std::make_shared<LibsumoServer>(args);
+    } catch (std::runtime_error& e) {
+        throw omnetpp::cRuntimeError("%s", e.what());
+    }
+    EV_INFO << "Loaded SUMO configuration " << m_sumocfg << " by libsumo\n";
+
+    return serve();
+}
+
+ServerEndpoint LibsumoLauncher::relaunch()
+{
+    if (!m_server) {
+        throw omnetpp::cRuntimeError("libsumo has not been launched yet");
+    }
+
+    // forked process owns a copy of the simulation, no server thread or socket needs to be restored
+    return serve();
+}
+
+ServerEndpoint LibsumoLauncher::serve() const
+{
+    ServerEndpoint endpoint;
+    endpoint.hostname = "localhost";
+    endpoint.port = 0;
+    endpoint.server = m_server;
+    return endpoint;
+}
+
+} // namespace traci
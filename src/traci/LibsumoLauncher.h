@@ -0,0 +1,46 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef TRACI_LIBSUMOLAUNCHER_H_W7RB2NQE
+#define TRACI_LIBSUMOLAUNCHER_H_W7RB2NQE
+
+#include "traci/Launcher.h"
+#include <omnetpp/csimplemodule.h>
+#include <memory>
+#include <string>
+
+namespace traci
+{
+
+class LibsumoServer;
+
+/**
+ * LibsumoLauncher runs SUMO within Artery's process by libsumo instead of launching a SUMO server
+ *
+ * Core's traci::API exchanges its messages with LibsumoServer in memory, i.e. without socket and context switches.
+ * Only one SUMO simulation can be loaded per process. A forked process continues with its copy of the simulation.
+ */
+class LibsumoLauncher : public Launcher, public omnetpp::cSimpleModule
+{
+public:
+    ServerEndpoint launch() override;
+    bool canRelaunch() const override { return static_cast<bool>(m_server); }
+    ServerEndpoint relaunch() override;
+
+protected:
+    void initialize() override;
+
+private:
+    ServerEndpoint serve() const;
+
+    std::string m_sumocfg;
+    int m_seed;
+    std::string m_extra_options;
+    std::shared_ptr<LibsumoServer> m_server;
+};
+
+} // namespace traci
+
+#endif /* TRACI_LIBSUMOLAUNCHER_H_W7RB2NQE */
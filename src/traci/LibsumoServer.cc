@@ -0,0 +1,677 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "traci/LibsumoServer.h"
+#include "traci/StorageView.h"
+// SUMO's libsumo headers, not those bundled in traci/sumo/libsumo (see CMakeLists.txt)
+#include <libsumo/Person.h>
+#include <libsumo/Polygon.h>
+#include <libsumo/Simulation.h>
+#include <libsumo/TraCIConstants.h>
+#include <libsumo/TraCIDefs.h>
+#include <libsumo/Vehicle.h>
+#include <libsumo/VehicleType.h>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+namespace traci
+{
+
+namespace
+{
+
+std::string hex(int value)
+{
+    char buffer[8];
+    std::snprintf(buffer, sizeof(buffer), "0x%02x", value);
+    return buffer;
+}
+
+void writeStatus(tcpip::Storage& out, int command, int result, const std::string& description = "")
+{
+    // status length is a single byte for clients
+    const std::string text = description.substr(0, 200);
+    out.writeUnsignedByte(1 + 1 + 1 + 4 + static_cast<int>(text.size()));
+    out.writeUnsignedByte(command);
+    out.writeUnsignedByte(result);
+    out.writeString(text);
+}
+
+void writeCommand(tcpip::Storage& out, int command, tcpip::Storage& payload)
+{
+    const int length = 1 + 1 + static_cast<int>(payload.size());
+    if (length <= 255) {
+        out.writeUnsignedByte(length);
+    } else {
+        out.writeUnsignedByte(0);
+        out.writeInt(length + 4);
+    }
+    out.writeUnsignedByte(command);
+    out.writeStorage(payload);
+}
+
+void writeStringList(tcpip::Storage& out, const std::vector<std::string>& list)
+{
+    out.writeUnsignedByte(libsumo::TYPE_STRINGLIST);
+    out.writeStringList(list);
+}
+
+void writeDouble(tcpip::Storage& out, double value)
+{
+    out.writeUnsignedByte(libsumo::TYPE_DOUBLE);
+    out.writeDouble(value);
+}
+
+void writeInt(tcpip::Storage& out, int value)
+{
+    out.writeUnsignedByte(libsumo::TYPE_INTEGER);
+    out.writeInt(value);
+}
+
+void writeString(tcpip::Storage& out, const std::string& value)
+{
+    out.writeUnsignedByte(libsumo::TYPE_STRING);
+    out.writeString(value);
+}
+
+void writePosition(tcpip::Storage& out, const libsumo::TraCIPosition& position, bool includeZ)
+{
+    out.writeUnsignedByte(includeZ ? libsumo::POSITION_3D : libsumo::POSITION_2D);
+    out.writeDouble(position.x);
+    out.writeDouble(position.y);
+    if (includeZ) {
+        out.writeDouble(position.z);
+    }
+}
+
+void writeShape(tcpip::Storage& out, const libsumo::TraCIPositionVector& shape)
+{
+    out.writeUnsignedByte(libsumo::TYPE_POLYGON);
+    if (shape.value.size() < 256) {
+        out.writeUnsignedByte(shape.value.size());
+    } else {
+        out.writeUnsignedByte(0);
+        out.writeInt(shape.value.size());
+    }
+    for (const libsumo::TraCIPosition& position : shape.value) {
+        out.writeDouble(position.x);
+        out.writeDouble(position.y);
+    }
+}
+
+double readTypedDouble(StorageView& content)
+{
+    if (content.readUnsignedByte() != libsumo::TYPE_DOUBLE) {
+        throw std::invalid_argument("expected double value");
+    }
+    return content.readDouble();
+}
+
+int readTypedInt(StorageView& content)
+{
+    if (content.readUnsignedByte() != libsumo::TYPE_INTEGER) {
+        throw std::invalid_argument("expected integer value");
+    }
+    return content.readInt();
+}
+
+std::string readTypedString(StorageView& content)
+{
+    if (content.readUnsignedByte() != libsumo::TYPE_STRING) {
+        throw std::invalid_argument("expected string value");
+    }
+    return std::string { content.readString() };
+}
+
+} // namespace
+
+LibsumoServer::LibsumoServer(const std::vector<std::string>& args)
+{
+    try {
+        libsumo::Simulation::load(args);
+    } catch (libsumo::TraCIException& e) {
+        // SUMO's exception type must not leave this translation unit
+        throw std::runtime_error(std::string("loading SUMO failed: ") + e.what());
+    }
+}
+
+LibsumoServer::~LibsumoServer()
+{
+    if (!m_closed) {
+        try {
+            libsumo::Simulation::close();
+        } catch (...) {
+            // nothing left to report to
+        }
+    }
+}
+
+void LibsumoServer::process(const unsigned char* data, std::size_t length, std::vector<unsigned char>& response)
+{
+    StorageView request { data, length };
+    m_response.reset();
+    while (request.valid_pos()) {
+        const std::size_t start = request.position();
+        std::size_t commandLength = request.readUnsignedByte();
+        if (commandLength == 0) {
+            commandLength = request.readInt();
+        }
+        const int command = request.readUnsignedByte();
+        if (start + commandLength < request.position() || start + commandLength > length) {
+            throw std::invalid_argument("TraCI command exceeds message");
+        }
+
+        const std::size_t contentLength = start + commandLength - request.position();
+        StorageView content { data + request.position(), contentLength };
+        request.skip(contentLength);
+        try {
+            process(command, content, m_response);
+        } catch (std::invalid_argument&) {
+            writeStatus(m_response, command, libsumo::RTYPE_ERR, "malformed command");
+        } catch (libsumo::TraCIException& e) {
+            writeStatus(m_response, command, libsumo::RTYPE_ERR, e.what());
+        }
+    }
+    response.assign(m_response.begin(), m_response.end());
+}
+
+void LibsumoServer::process(int command, StorageView& content, tcpip::Storage& response)
+{
+    switch (command) {
+        case libsumo::CMD_GETVERSION: {
+            const auto version = libsumo::Simulation::getVersion();
+            writeStatus(response, command, libsumo::RTYPE_OK);
+            tcpip::Storage payload;
+            payload.writeInt(version.first);
+            payload.writeString(version.second);
+            writeCommand(response, command, payload);
+            break;
+        }
+        case libsumo::CMD_SETORDER:
+            // there is only one client
+            writeStatus(response, command, libsumo::RTYPE_OK);
+            break;
+        case libsumo::CMD_CLOSE:
+            if (!m_closed) {
+                libsumo::Simulation::close();
+                m_closed = true;
+            }
+            writeStatus(response, command, libsumo::RTYPE_OK);
+            break;
+        case libsumo::CMD_SIMSTEP:
+            processStep(content, response);
+            break;
+        case libsumo::CMD_GET_SIM_VARIABLE:
+        case libsumo::CMD_GET_VEHICLE_VARIABLE:
+        case libsumo::CMD_GET_VEHICLETYPE_VARIABLE:
+        case libsumo::CMD_GET_PERSON_VARIABLE:
+        case libsumo::CMD_GET_POLYGON_VARIABLE:
+            processGet(command, content, response);
+            break;
+        case libsumo::CMD_SET_VEHICLE_VARIABLE:
+        case libsumo::CMD_SET_PERSON_VARIABLE:
+            processSet(command, content, response);
+            break;
+        case libsumo::CMD_SUBSCRIBE_SIM_VARIABLE:
+        case libsumo::CMD_SUBSCRIBE_VEHICLE_VARIABLE:
+        case libsumo::CMD_SUBSCRIBE_PERSON_VARIABLE:
+            processSubscribe(command, content, response);
+            break;
+        default:
+            writeStatus(response, command, libsumo::RTYPE_NOTIMPLEMENTED,
+                "command " + hex(command) + " is not supported by in-process libsumo");
+            break;
+    }
+}
+
+void LibsumoServer::processStep(StorageView& content, tcpip::Storage& response)
+{
+    const double target = content.readDouble();
+    libsumo::Simulation::step(target);
+
+    // subscriptions end with their object like in SUMO
+    for (const std::string& id : libsumo::Simulation::getArrivedIDList()) {
+        m_vehicle_subscriptions.erase(id);
+    }
+    for (const std::string& id : libsumo::Simulation::getArrivedPersonIDList()) {
+        m_person_subscriptions.erase(id);
+    }
+
+    writeStatus(response, libsumo::CMD_SIMSTEP, libsumo::RTYPE_OK);
+    const int subscriptions = (m_simulation_subscription.empty() ? 0 : 1) +
+        m_vehicle_subscriptions.size() + m_person_subscriptions.size();
+    response.writeInt(subscriptions);
+    if (!m_simulation_subscription.empty()) {
+        writeSubscription(response, libsumo::RESPONSE_SUBSCRIBE_SIM_VARIABLE, "", m_simulation_subscription);
+    }
+    for (const auto& subscription : m_vehicle_subscriptions) {
+        writeSubscription(response, libsumo::RESPONSE_SUBSCRIBE_VEHICLE_VARIABLE, subscription.first, subscription.second);
+    }
+    for (const auto& subscription : m_person_subscriptions) {
+        writeSubscription(response, libsumo::RESPONSE_SUBSCRIBE_PERSON_VARIABLE, subscription.first, subscription.second);
+    }
+}
+
+void LibsumoServer::processGet(int command, StorageView& content, tcpip::Storage& response)
+{
+    const int var = content.readUnsignedByte();
+    const std::string id { content.readString() };
+    tcpip::Storage value;
+    bool valid = false;
+    if (command == libsumo::CMD_GET_SIM_VARIABLE && var == libsumo::POSITION_CONVERSION) {
+        valid = writePositionConversion(value, content);
+    } else {
+        valid = writeValue(value, command, id, var);
+    }
+
+    if (valid) {
+        writeStatus(response, command, libsumo::RTYPE_OK);
+        tcpip::Storage payload;
+        payload.writeUnsignedByte(var);
+        payload.writeString(id);
+        payload.writeStorage(value);
+        writeCommand(response, command + 0x10, payload);
+    } else {
+        writeStatus(response, command, libsumo::RTYPE_NOTIMPLEMENTED,
+            "variable " + hex(var) + " of command " + hex(command) + " is not supported by in-process libsumo");
+    }
+}
+
+void LibsumoServer::processSet(int command, StorageView& content, tcpip::Storage& response)
+{
+    const int var = content.readUnsignedByte();
+    const std::string id { content.readString() };
+    bool valid = true;
+
+    if (command == libsumo::CMD_SET_VEHICLE_VARIABLE) {
+        switch (var) {
+            case libsumo::VAR_SPEED:
+                libsumo::Vehicle::setSpeed(id, readTypedDouble(content));
+                break;
+            case libsumo::VAR_MAXSPEED:
+                libsumo::Vehicle::setMaxSpeed(id, readTypedDouble(content));
+                break;
+            case libsumo::VAR_SPEED_FACTOR:
+                libsumo::Vehicle::setSpeedFactor(id, readTypedDouble(content));
+                break;
+            case libsumo::VAR_SPEEDSETMODE:
+                libsumo::Vehicle::setSpeedMode(id, readTypedInt(content));
+                break;
+            case libsumo::CMD_SLOWDOWN: {
+                if (content.readUnsignedByte() != libsumo::TYPE_COMPOUND || content.readInt() != 2) {
+                    throw std::invalid_argument("slow down requires speed and duration");
+                }
+                const double speed = readTypedDouble(content);
+                const double duration = readTypedDouble(content);
+                libsumo::Vehicle::slowDown(id, speed, duration);
+                break;
+            }
+            case libsumo::CMD_CHANGETARGET:
+                libsumo::Vehicle::changeTarget(id, readTypedString(content));
+                break;
+            default:
+                valid = false;
+                break;
+        }
+    } else if (command == libsumo::CMD_SET_PERSON_VARIABLE && var == libsumo::VAR_SPEED) {
+        libsumo::Person::setSpeed(id, readTypedDouble(content));
+    } else {
+        valid = false;
+    }
+
+    if (valid) {
+        writeStatus(response, command, libsumo::RTYPE_OK);
+    } else {
+        writeStatus(response, command, libsumo::RTYPE_NOTIMPLEMENTED,
+            "variable " + hex(var) + " of command " + hex(command) + " is not supported by in-process libsumo");
+    }
+}
+
+void LibsumoServer::processSubscribe(int command, StorageView& content, tcpip::Storage& response)
+{
+    content.readDouble(); // begin time
+    content.readDouble(); // end time
+    const std::string id { content.readString() };
+    std::vector<int> vars(content.readUnsignedByte());
+    for (int& var : vars) {
+        var = content.readUnsignedByte();
+    }
+
+    // reject subscription as a whole if any variable is not available, unknown objects raise an error
+    const int getCommand = command - libsumo::CMD_SUBSCRIBE_SIM_VARIABLE + libsumo::CMD_GET_SIM_VARIABLE;
+    tcpip::Storage probe;
+    for (int var : vars) {
+        if (!writeValue(probe, getCommand, id, var)) {
+            writeStatus(response, command, libsumo::RTYPE_ERR,
+                "variable " + hex(var) + " is not supported by in-process libsumo");
+            return;
+        }
+    }
+
+    if (command == libsumo::CMD_SUBSCRIBE_SIM_VARIABLE) {
+        m_simulation_subscription = vars;
+    } else {
+        auto& subscriptions = command == libsumo::CMD_SUBSCRIBE_VEHICLE_VARIABLE ?
+            m_vehicle_subscriptions : m_person_subscriptions;
+        if (vars.empty()) {
+            subscriptions.erase(id);
+        } else {
+            subscriptions[id] = vars;
+        }
+    }
+
+    writeStatus(response, command, libsumo::RTYPE_OK);
+    if (!vars.empty()) {
+        writeSubscription(response, command + 0x10, id, vars);
+    }
+}
+
+bool LibsumoServer::writeValue(tcpip::Storage& out, int command, const std::string& id, int var) const
+{
+    switch (command) {
+        case libsumo::CMD_GET_SIM_VARIABLE:
+            return writeSimulationValue(out, var);
+        case libsumo::CMD_GET_VEHICLE_VARIABLE:
+            return writeVehicleValue(out, id, var);
+        case libsumo::CMD_GET_VEHICLETYPE_VARIABLE:
+            return writeTypeValue(out, id, var);
+        case libsumo::CMD_GET_PERSON_VARIABLE:
+            return writePersonValue(out, id, var);
+        case libsumo::CMD_GET_POLYGON_VARIABLE:
+            return writePolygonValue(out, id, var);
+        default:
+            return false;
+    }
+}
+
+bool LibsumoServer::writeSimulationValue(tcpip::Storage& out, int var) const
+{
+    using libsumo::Simulation;
+    switch (var) {
+        case libsumo::VAR_TIME:
+            writeDouble(out, Simulation::getTime());
+            break;
+        case libsumo::VAR_TIME_STEP:
+            writeInt(out, std::lround(Simulation::getTime() * 1000.0));
+            break;
+        case libsumo::VAR_DELTA_T:
+            writeDouble(out, Simulation::getDeltaT());
+            break;
+        case libsumo::VAR_NET_BOUNDING_BOX:
+            writeShape(out, Simulation::getNetBoundary());
+            break;
+        case libsumo::VAR_MIN_EXPECTED_VEHICLES:
+            writeInt(out, Simulation::getMinExpectedNumber());
+            break;
+        case libsumo::VAR_LOADED_VEHICLES_IDS:
+            writeStringList(out, Simulation::getLoadedIDList());
+            break;
+        case libsumo::VAR_LOADED_VEHICLES_NUMBER:
+            writeInt(out, Simulation::getLoadedNumber());
+            break;
+        case libsumo::VAR_DEPARTED_VEHICLES_IDS:
+            writeStringList(out, Simulation::getDepartedIDList());
+            break;
+        case libsumo::VAR_DEPARTED_VEHICLES_NUMBER:
+            writeInt(out, Simulation::getDepartedNumber());
+            break;
+        case libsumo::VAR_ARRIVED_VEHICLES_IDS:
+            writeStringList(out, Simulation::getArrivedIDList());
+            break;
+        case libsumo::VAR_ARRIVED_VEHICLES_NUMBER:
+            writeInt(out, Simulation::getArrivedNumber());
+            break;
+        case libsumo::VAR_TELEPORT_STARTING_VEHICLES_IDS:
+            writeStringList(out, Simulation::getStartingTeleportIDList());
+            break;
+        case libsumo::VAR_TELEPORT_STARTING_VEHICLES_NUMBER:
+            writeInt(out, Simulation::getStartingTeleportNumber());
+            break;
+        case libsumo::VAR_TELEPORT_ENDING_VEHICLES_IDS:
+            writeStringList(out, Simulation::getEndingTeleportIDList());
+            break;
+        case libsumo::VAR_TELEPORT_ENDING_VEHICLES_NUMBER:
+            writeInt(out, Simulation::getEndingTeleportNumber());
+            break;
+        case libsumo::VAR_DEPARTED_PERSONS_IDS:
+            writeStringList(out, Simulation::getDepartedPersonIDList());
+            break;
+        case libsumo::VAR_DEPARTED_PERSONS_NUMBER:
+            writeInt(out, Simulation::getDepartedPersonNumber());
+            break;
+        case libsumo::VAR_ARRIVED_PERSONS_IDS:
+            writeStringList(out, Simulation::getArrivedPersonIDList());
+            break;
+        case libsumo::VAR_ARRIVED_PERSONS_NUMBER:
+            writeInt(out, Simulation::getArrivedPersonNumber());
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+bool LibsumoServer::writeVehicleValue(tcpip::Storage& out, const std::string& id, int var) const
+{
+    using libsumo::Vehicle;
+    switch (var) {
+        case libsumo::TRACI_ID_LIST:
+            writeStringList(out, Vehicle::getIDList());
+            break;
+        case libsumo::ID_COUNT:
+            writeInt(out, Vehicle::getIDCount());
+            break;
+        case libsumo::VAR_POSITION:
+            writePosition(out, Vehicle::getPosition(id), false);
+            break;
+        case libsumo::VAR_POSITION3D:
+            writePosition(out, Vehicle::getPosition3D(id), true);
+            break;
+        case libsumo::VAR_SPEED:
+            writeDouble(out, Vehicle::getSpeed(id));
+            break;
+        case libsumo::VAR_ANGLE:
+            writeDouble(out, Vehicle::getAngle(id));
+            break;
+        case libsumo::VAR_SIGNALS:
+            writeInt(out, Vehicle::getSignals(id));
+            break;
+        case libsumo::VAR_TYPE:
+            writeString(out, Vehicle::getTypeID(id));
+            break;
+        case libsumo::VAR_VEHICLECLASS:
+            writeString(out, Vehicle::getVehicleClass(id));
+            break;
+        case libsumo::VAR_LENGTH:
+            writeDouble(out, Vehicle::getLength(id));
+            break;
+        case libsumo::VAR_WIDTH:
+            writeDouble(out, Vehicle::getWidth(id));
+            break;
+        case libsumo::VAR_HEIGHT:
+            writeDouble(out, Vehicle::getHeight(id));
+            break;
+        case libsumo::VAR_MAXSPEED:
+            writeDouble(out, Vehicle::getMaxSpeed(id));
+            break;
+        case libsumo::VAR_ACCEL:
+            writeDouble(out, Vehicle::getAccel(id));
+            break;
+        case libsumo::VAR_DECEL:
+            writeDouble(out, Vehicle::getDecel(id));
+            break;
+        case libsumo::VAR_EMERGENCY_DECEL:
+            writeDouble(out, Vehicle::getEmergencyDecel(id));
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+bool LibsumoServer::writeTypeValue(tcpip::Storage& out, const std::string& id, int var) const
+{
+    using libsumo::VehicleType;
+    switch (var) {
+        case libsumo::TRACI_ID_LIST:
+            writeStringList(out, VehicleType::getIDList());
+            break;
+        case libsumo::ID_COUNT:
+            writeInt(out, VehicleType::getIDCount());
+            break;
+        case libsumo::VAR_VEHICLECLASS:
+            writeString(out, VehicleType::getVehicleClass(id));
+            break;
+        case libsumo::VAR_LENGTH:
+            writeDouble(out, VehicleType::getLength(id));
+            break;
+        case libsumo::VAR_WIDTH:
+            writeDouble(out, VehicleType::getWidth(id));
+            break;
+        case libsumo::VAR_HEIGHT:
+            writeDouble(out, VehicleType::getHeight(id));
+            break;
+        case libsumo::VAR_MAXSPEED:
+            writeDouble(out, VehicleType::getMaxSpeed(id));
+            break;
+        case libsumo::VAR_ACCEL:
+            writeDouble(out, VehicleType::getAccel(id));
+            break;
+        case libsumo::VAR_DECEL:
+            writeDouble(out, VehicleType::getDecel(id));
+            break;
+        case libsumo::VAR_EMERGENCY_DECEL:
+            writeDouble(out, VehicleType::getEmergencyDecel(id));
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+bool LibsumoServer::writePersonValue(tcpip::Storage& out, const std::string& id, int var) const
+{
+    using libsumo::Person;
+    switch (var) {
+        case libsumo::TRACI_ID_LIST:
+            writeStringList(out, Person::getIDList());
+            break;
+        case libsumo::ID_COUNT:
+            writeInt(out, Person::getIDCount());
+            break;
+        case libsumo::VAR_POSITION:
+            writePosition(out, Person::getPosition(id), false);
+            break;
+        case libsumo::VAR_POSITION3D:
+            writePosition(out, Person::getPosition3D(id), true);
+            break;
+        case libsumo::VAR_SPEED:
+            writeDouble(out, Person::getSpeed(id));
+            break;
+        case libsumo::VAR_ANGLE:
+            writeDouble(out, Person::getAngle(id));
+            break;
+        case libsumo::VAR_TYPE:
+            writeString(out, Person::getTypeID(id));
+            break;
+        case libsumo::VAR_VEHICLE:
+            writeString(out, Person::getVehicle(id));
+            break;
+        case libsumo::VAR_LENGTH:
+            writeDouble(out, Person::getLength(id));
+            break;
+        case libsumo::VAR_WIDTH:
+            writeDouble(out, Person::getWidth(id));
+            break;
+        case libsumo::VAR_HEIGHT:
+            writeDouble(out, Person::getHeight(id));
+            break;
+        case libsumo::VAR_MAXSPEED:
+            writeDouble(out, Person::getMaxSpeed(id));
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+bool LibsumoServer::writePolygonValue(tcpip::Storage& out, const std::string& id, int var) const
+{
+    using libsumo::Polygon;
+    switch (var) {
+        case libsumo::TRACI_ID_LIST:
+            writeStringList(out, Polygon::getIDList());
+            break;
+        case libsumo::ID_COUNT:
+            writeInt(out, Polygon::getIDCount());
+            break;
+        case libsumo::VAR_TYPE:
+            writeString(out, Polygon::getType(id));
+            break;
+        case libsumo::VAR_FILL:
+            out.writeUnsignedByte(libsumo::TYPE_UBYTE);
+            out.writeUnsignedByte(Polygon::getFilled(id) ? 1 : 0);
+            break;
+        case libsumo::VAR_SHAPE:
+            writeShape(out, Polygon::getShape(id));
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+bool LibsumoServer::writePositionConversion(tcpip::Storage& out, StorageView& content) const
+{
+    // same layout as TraCIAPI::SimulationScope::convertGeo
+    if (content.readUnsignedByte() != libsumo::TYPE_COMPOUND || content.readInt() != 2) {
+        return false;
+    }
+    const int from = content.readUnsignedByte();
+    const double x = content.readDouble();
+    const double y = content.readDouble();
+    if (content.readUnsignedByte() != libsumo::TYPE_UBYTE) {
+        return false;
+    }
+    const int to = content.readUnsignedByte();
+
+    if (from == libsumo::POSITION_2D && to == libsumo::POSITION_LON_LAT) {
+        const libsumo::TraCIPosition geo = libsumo::Simulation::convertGeo(x, y, false);
+        out.writeUnsignedByte(libsumo::POSITION_LON_LAT);
+        out.writeDouble(geo.x);
+        out.writeDouble(geo.y);
+    } else if (from == libsumo::POSITION_LON_LAT && to == libsumo::POSITION_2D) {
+        const libsumo::TraCIPosition position = libsumo::Simulation::convertGeo(x, y, true);
+        out.writeUnsignedByte(libsumo::POSITION_2D);
+        out.writeDouble(position.x);
+        out.writeDouble(position.y);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void LibsumoServer::writeSubscription(tcpip::Storage& out, int response, const std::string& id, const std::vector<int>& vars) const
+{
+    const int getCommand = response - libsumo::RESPONSE_SUBSCRIBE_SIM_VARIABLE + libsumo::CMD_GET_SIM_VARIABLE;
+    tcpip::Storage payload;
+    payload.writeString(id);
+    payload.writeUnsignedByte(vars.size());
+    for (int var : vars) {
+        payload.writeUnsignedByte(var);
+        payload.writeUnsignedByte(libsumo::RTYPE_OK);
+        writeValue(payload, getCommand, id, var);
+    }
+
+    // subscription responses always use the extended length field
+    const int length = 1 + 4 + 1 + static_cast<int>(payload.size());
+    out.writeUnsignedByte(0);
+    out.writeInt(length);
+    out.writeUnsignedByte(response);
+    out.writeStorage(payload);
+}
+
+} // namespace traci
@@ -0,0 +1,70 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef TRACI_LIBSUMOSERVER_H_P3KD8XWQ
+#define TRACI_LIBSUMOSERVER_H_P3KD8XWQ
+
+#include "traci/Launcher.h"
+#include "traci/sumo/foreign/tcpip/storage.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace traci
+{
+
+class StorageView;
+
+/**
+ * LibsumoServer answers TraCI messages by calling libsumo, i.e. SUMO runs within Artery's process
+ *
+ * Messages are passed in memory without any socket, the client's traci::API is used unchanged.
+ * Retrieval and subscription commands required by node and subscription managers are available,
+ * i.e. simulation, vehicle, vehicle type and person variables as well as polygon shapes,
+ * and the set commands issued by Artery's controllers and storyboard.
+ * Other commands are answered with RTYPE_NOTIMPLEMENTED.
+ *
+ * This class must not include the TraCI definitions bundled with Artery (traci/sumo/libsumo),
+ * its translation unit is compiled against SUMO's libsumo headers instead.
+ */
+class LibsumoServer : public InProcessServer
+{
+public:
+    /**
+     * Load SUMO simulation in this process
+     * \param args SUMO command line options (without executable)
+     */
+    explicit LibsumoServer(const std::vector<std::string>& args);
+    ~LibsumoServer();
+
+    void process(const unsigned char* request, std::size_t length, std::vector<unsigned char>& response) override;
+
+private:
+    void process(int command, StorageView& content, tcpip::Storage& response);
+    void processStep(StorageView& content, tcpip::Storage& response);
+    void processGet(int command, StorageView& content, tcpip::Storage& response);
+    void processSet(int command, StorageView& content, tcpip::Storage& response);
+    void processSubscribe(int command, StorageView& content, tcpip::Storage& response);
+
+    bool writeValue(tcpip::Storage&, int command, const std::string& id, int var) const;
+    bool writeSimulationValue(tcpip::Storage&, int var) const;
+    bool writeVehicleValue(tcpip::Storage&, const std::string& id, int var) const;
+    bool writeTypeValue(tcpip::Storage&, const std::string& id, int var) const;
+    bool writePersonValue(tcpip::Storage&, const std::string& id, int var) const;
+    bool writePolygonValue(tcpip::Storage&, const std::string& id, int var) const;
+    bool writePositionConversion(tcpip::Storage&, StorageView& content) const;
+    void writeSubscription(tcpip::Storage&, int response, const std::string& id, const std::vector<int>& vars) const;
+
+    tcpip::Storage m_response;
+    bool m_closed = false;
+
+    std::vector<int> m_simulation_subscription;
+    std::map<std::string, std::vector<int>> m_vehicle_subscriptions;
+    std::map<std::string, std::vector<int>> m_person_subscriptions;
+};
+
+} // namespace traci
+
+#endif /* TRACI_LIBSUMOSERVER_H_P3KD8XWQ */
@@ -0,0 +1,48 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "traci/NodeHandle.h"
+
+namespace traci
+{
+
+NodeHandle NodeHandleRegistry::acquire(const std::string& id)
+{
+    auto found = m_handles.find(id);
+    if (found != m_handles.end()) {
+        return found->second;
+    }
+
+    NodeHandle handle;
+    if (m_released.empty()) {
+        handle = static_cast<NodeHandle>(m_ids.size());
+        m_ids.push_back(id);
+    } else {
+        // keep handles dense by re-using released ones
+        handle = m_released.back();
+        m_released.pop_back();
+        m_ids[handle] = id;
+    }
+    m_handles.emplace(id, handle);
+    return handle;
+}
+
+void NodeHandleRegistry::release(const std::string& id)
+{
+    auto found = m_handles.find(id);
+    if (found != m_handles.end()) {
+        m_ids[found->second].clear();
+        m_released.push_back(found->second);
+        m_handles.erase(found);
+    }
+}
+
+NodeHandle NodeHandleRegistry::find(const std::string& id) const
+{
+    auto found = m_handles.find(id);
+    return found != m_handles.end() ? found->second : invalid;
+}
+
+} // namespace traci
@@ -0,0 +1,76 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef TRACI_NODEHANDLE_H_8PLQ3ZVD
+#define TRACI_NODEHANDLE_H_8PLQ3ZVD
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace traci
+{
+
+/**
+ * NodeHandle is a dense integer identifying a node managed by a NodeManager.
+ * Handles of removed nodes are handed out again, thus they are suitable as vector indices.
+ */
+using NodeHandle = std::uint32_t;
+
+/**
+ * NodeHandleRegistry interns TraCI identifiers of managed nodes.
+ */
+class NodeHandleRegistry
+{
+public:
+    static constexpr NodeHandle invalid = std::numeric_limits<NodeHandle>::max();
+
+    /**
+     * Get handle for a TraCI identifier, a new handle is assigned if necessary
+     * \param id TraCI identifier
+     * \return handle stable until release
+     */
+    NodeHandle acquire(const std::string& id);
+
+    /**
+     * Release handle of a TraCI identifier so it can be re-used
+     * \param id TraCI identifier
+     */
+    void release(const std::string& id);
+
+    /**
+     * Look up handle of a TraCI identifier
+     * \param id TraCI identifier
+     * \return handle or invalid if identifier is unknown
+     */
+    NodeHandle find(const std::string& id) const;
+
+    /**
+     * Get TraCI identifier of an acquired handle
+     * \param handle node handle
+     * \return TraCI identifier (empty for released handles)
+     */
+    const std::string& getId(NodeHandle handle) const { return m_ids[handle]; }
+
+    /**
+     * All acquired handles are less than this upper bound
+     * \return upper bound of handles, e.g. for sizing vectors
+     */
+    std::size_t capacity() const { return m_ids.size(); }
+
+    std::size_t size() const { return m_handles.size(); }
+
+private:
+    std::unordered_map<std::string, NodeHandle> m_handles;
+    std::vector<std::string> m_ids;
+    std::vector<NodeHandle> m_released;
+};
+
+} // namespace traci
+
+#endif /* TRACI_NODEHANDLE_H_8PLQ3ZVD */
@@ -0,0 +1,36 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef TRACI_PARALLELEXECUTOR_H_M4TZ8QWC
+#define TRACI_PARALLELEXECUTOR_H_M4TZ8QWC
+
+#include <cstddef>
+#include <functional>
+
+namespace traci
+{
+
+/**
+ * ParallelExecutor runs loop bodies on a persistent thread pool provided by an upper layer,
+ * i.e. artery::TaskScheduler, thus traci modules can share its pool without depending on Artery.
+ */
+class ParallelExecutor
+{
+public:
+    virtual ~ParallelExecutor() = default;
+
+    /**
+     * Invoke func(i) for each i in [0, count) and return when all indices are done
+     *
+     * \param count number of indices
+     * \param grain indices per chunk, i.e. per task
+     * \param func must be safe to call concurrently for distinct indices
+     */
+    virtual void parallelFor(std::size_t count, std::size_t grain, const std::function<void(std::size_t)>& func) = 0;
+};
+
+} // namespace traci
+
+#endif /* TRACI_PARALLELEXECUTOR_H_M4TZ8QWC */
@@ -0,0 +1,66 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "traci/PlaybackLauncher.h"
+#include "traci/PlaybackServer.h"
+#include "traci/PlaybackTrace.h"
+#include <stdexcept>
+#include <thread>
+
+namespace traci
+{
+
+Define_Module(PlaybackLauncher)
+
+void PlaybackLauncher::initialize()
+{
+    m_trace_file = par("traceFile").stringValue();
+    m_port = par("port");
+    m_socket_path = par("socketPath").stringValue();
+}
+
+ServerEndpoint PlaybackLauncher::launch()
+{
+    try {
+        auto trace = std::make_shared<const PlaybackTrace>(m_trace_file);
+        EV_INFO << "Playing back " << trace->getVehicles().size() << " vehicles in "
+            << trace->getNumSteps() << " steps from " << m_trace_file << "\n";
+        m_server = std::make_shared<PlaybackServer>(trace, m_port, m_socket_path);
+    } catch (std::runtime_error& e) {
+        throw omnetpp::cRuntimeError("%s", e.what());
+    }
+
+    return serve();
+}
+
+ServerEndpoint PlaybackLauncher::relaunch()
+{
+    if (!m_server) {
+        throw omnetpp::cRuntimeError("playback has not been launched yet");
+    }
+
+    // forked process inherits server state but not its thread
+    try {
+        m_server->rebind();
+    } catch (std::runtime_error& e) {
+        throw omnetpp::cRuntimeError("%s", e.what());
+    }
+    return serve();
+}
+
+ServerEndpoint PlaybackLauncher::serve()
+{
+    // server ends when TraCI connection is closed, even if this module has already been deleted
+    std::shared_ptr<PlaybackServer> server = m_server;
+    std::thread([server]() { server->serve(); }).detach();
+
+    ServerEndpoint endpoint;
+    endpoint.hostname = "localhost";
+    endpoint.port = server->getPort();
+    endpoint.socketPath = server->getSocketPath();
+    return endpoint;
+}
+
+} // namespace traci
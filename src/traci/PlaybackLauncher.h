@@ -0,0 +1,47 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef TRACI_PLAYBACKLAUNCHER_H_H6ZMQ3XE
+#define TRACI_PLAYBACKLAUNCHER_H_H6ZMQ3XE
+
+#include "traci/Launcher.h"
+#include <omnetpp/csimplemodule.h>
+#include <memory>
+#include <string>
+
+namespace traci
+{
+
+class PlaybackServer;
+
+/**
+ * PlaybackLauncher replays a recorded trajectory trace instead of launching SUMO
+ *
+ * Core connects to an in-process TraCI server answering from the trace (see PlaybackServer),
+ * thus node and subscription managers work unchanged. Commands controlling SUMO are rejected.
+ * A forked process can continue the playback session on its own server by relaunch().
+ */
+class PlaybackLauncher : public Launcher, public omnetpp::cSimpleModule
+{
+public:
+    ServerEndpoint launch() override;
+    bool canRelaunch() const override { return static_cast<bool>(m_server); }
+    ServerEndpoint relaunch() override;
+
+protected:
+    void initialize() override;
+
+private:
+    ServerEndpoint serve();
+
+    std::string m_trace_file;
+    int m_port;
+    std::string m_socket_path;
+    std::shared_ptr<PlaybackServer> m_server;
+};
+
+} // namespace traci
+
+#endif /* TRACI_PLAYBACKLAUNCHER_H_H6ZMQ3XE */
@@ -0,0 +1,596 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "traci/PlaybackServer.h"
+#include "traci/StorageView.h"
+#include "traci/sumo/libsumo/TraCIConstants.h"
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace traci
+{
+
+namespace
+{
+
+const std::string serverName = "Artery trace playback";
+
+std::string hex(int value)
+{
+    char buffer[8];
+    std::snprintf(buffer, sizeof(buffer), "0x%02x", value);
+    return buffer;
+}
+
+void writeStatus(tcpip::Storage& out, int command, int result, const std::string& description = "")
+{
+    // status length is a single byte for clients
+    const std::string text = description.substr(0, 200);
+    out.writeUnsignedByte(1 + 1 + 1 + 4 + static_cast<int>(text.size()));
+    out.writeUnsignedByte(command);
+    out.writeUnsignedByte(result);
+    out.writeString(text);
+}
+
+void writeCommand(tcpip::Storage& out, int command, tcpip::Storage& payload)
+{
+    const int length = 1 + 1 + static_cast<int>(payload.size());
+    if (length <= 255) {
+        out.writeUnsignedByte(length);
+    } else {
+        out.writeUnsignedByte(0);
+        out.writeInt(length + 4);
+    }
+    out.writeUnsignedByte(command);
+    out.writeStorage(payload);
+}
+
+void writeStringList(tcpip::Storage& out, const std::vector<std::string>& list)
+{
+    out.writeUnsignedByte(libsumo::TYPE_STRINGLIST);
+    out.writeStringList(list);
+}
+
+void writeDouble(tcpip::Storage& out, double value)
+{
+    out.writeUnsignedByte(libsumo::TYPE_DOUBLE);
+    out.writeDouble(value);
+}
+
+void writeInt(tcpip::Storage& out, int value)
+{
+    out.writeUnsignedByte(libsumo::TYPE_INTEGER);
+    out.writeInt(value);
+}
+
+void writeString(tcpip::Storage& out, const std::string& value)
+{
+    out.writeUnsignedByte(libsumo::TYPE_STRING);
+    out.writeString(value);
+}
+
+bool isControlCommand(int command)
+{
+    return command >= libsumo::CMD_SET_INDUCTIONLOOP_VARIABLE && command <= libsumo::CMD_SET_PERSON_VARIABLE;
+}
+
+} // namespace
+
+PlaybackServer::PlaybackServer(std::shared_ptr<const PlaybackTrace> trace, int port, const std::string& socketPath) :
+    m_trace(std::move(trace)),
+    m_port(port > 0 || !socketPath.empty() ? port : tcpip::Socket::getFreeSocketPort()),
+    m_socket_base_path(socketPath),
+    m_socket_path(socketPath),
+    m_socket(new tcpip::Socket(m_port))
+{
+    if (m_trace->getUtmZone() > 0) {
+        m_projection.reset(new UtmProjection(m_trace->getUtmZone(), m_trace->getUtmOffset()));
+    }
+
+    const auto& vehicles = m_trace->getVehicles();
+    for (std::uint32_t i = 0; i < vehicles.size(); ++i) {
+        m_vehicle_ids.emplace(vehicles[i].id, i);
+    }
+    const auto& types = m_trace->getTypes();
+    for (std::uint32_t i = 0; i < types.size(); ++i) {
+        m_type_ids.emplace(types[i].id, i);
+    }
+    m_active_index.assign(vehicles.size(), -1);
+
+    listen();
+}
+
+int PlaybackServer::rebind()
+{
+    if (m_socket_base_path.empty()) {
+        m_port = tcpip::Socket::getFreeSocketPort();
+    } else {
+        m_socket_path = m_socket_base_path + "." + std::to_string(::getpid());
+    }
+    m_socket.reset(new tcpip::Socket(m_port));
+    listen();
+    return m_port;
+}
+
+void PlaybackServer::listen()
+{
+    // create listening socket right away, i.e. client can connect before serve() is running
+    if (!m_socket_path.empty()) {
+        m_socket->set_unix_path(m_socket_path);
+    }
+    m_socket->set_blocking(false);
+    m_socket->accept();
+    m_socket->set_blocking(true);
+}
+
+void PlaybackServer::serve()
+{
+    std::vector<unsigned char> buffer;
+    tcpip::Storage response;
+
+    try {
+        m_socket->accept();
+        while (!m_closed) {
+            const std::size_t length = m_socket->receiveExact(buffer);
+            StorageView request { buffer, length };
+            response.reset();
+            while (request.valid_pos()) {
+                const std::size_t start = request.position();
+                std::size_t commandLength = request.readUnsignedByte();
+                if (commandLength == 0) {
+                    commandLength = request.readInt();
+                }
+                const int command = request.readUnsignedByte();
+                if (start + commandLength < request.position() || start + commandLength > length) {
+                    throw std::invalid_argument("TraCI command exceeds message");
+                }
+
+                const std::size_t contentLength = start + commandLength - request.position();
+                StorageView content { buffer.data() + request.position(), contentLength };
+                request.skip(contentLength);
+                try {
+                    process(command, content, response);
+                } catch (std::invalid_argument&) {
+                    writeStatus(response, command, libsumo::RTYPE_ERR, "malformed command");
+                }
+            }
+            m_socket->sendExact(response);
+        }
+        m_socket->close();
+    } catch (std::exception&) {
+        // client has gone or sent garbage, nobody is left to report to
+    }
+}
+
+void PlaybackServer::process(int command, StorageView& content, tcpip::Storage& response)
+{
+    switch (command) {
+        case libsumo::CMD_GETVERSION: {
+            writeStatus(response, command, libsumo::RTYPE_OK);
+            tcpip::Storage payload;
+            payload.writeInt(libsumo::TRACI_VERSION);
+            payload.writeString(serverName);
+            writeCommand(response, command, payload);
+            break;
+        }
+        case libsumo::CMD_SETORDER:
+            // there is only one client
+            writeStatus(response, command, libsumo::RTYPE_OK);
+            break;
+        case libsumo::CMD_CLOSE:
+            writeStatus(response, command, libsumo::RTYPE_OK);
+            m_closed = true;
+            break;
+        case libsumo::CMD_SIMSTEP:
+            processStep(content, response);
+            break;
+        case libsumo::CMD_GET_SIM_VARIABLE:
+        case libsumo::CMD_GET_VEHICLE_VARIABLE:
+        case libsumo::CMD_GET_VEHICLETYPE_VARIABLE:
+        case libsumo::CMD_GET_PERSON_VARIABLE:
+            processGet(command, content, response);
+            break;
+        case libsumo::CMD_SUBSCRIBE_SIM_VARIABLE:
+        case libsumo::CMD_SUBSCRIBE_VEHICLE_VARIABLE:
+            processSubscribe(command, content, response);
+            break;
+        default:
+            if (isControlCommand(command)) {
+                writeStatus(response, command, libsumo::RTYPE_ERR,
+                    "traffic is played back from a trace, command " + hex(command) + " requires a live SUMO");
+            } else {
+                writeStatus(response, command, libsumo::RTYPE_NOTIMPLEMENTED,
+                    "command " + hex(command) + " is not supported by trace playback");
+            }
+            break;
+    }
+}
+
+void PlaybackServer::processStep(StorageView& content, tcpip::Storage& response)
+{
+    const double target = content.readDouble();
+    m_departed.clear();
+    m_arrived.clear();
+    // like SUMO: a single step unless target time is ahead
+    do {
+        step();
+    } while (target > 0.0 && getTime() + 0.5 * m_trace->getStepLength() <= target);
+
+    writeStatus(response, libsumo::CMD_SIMSTEP, libsumo::RTYPE_OK);
+    const int subscriptions = (m_simulation_subscription.empty() ? 0 : 1) + m_vehicle_subscriptions.size();
+    response.writeInt(subscriptions);
+    if (!m_simulation_subscription.empty()) {
+        writeSubscription(response, libsumo::RESPONSE_SUBSCRIBE_SIM_VARIABLE, "", nullptr, m_simulation_subscription);
+    }
+    for (const auto& subscription : m_vehicle_subscriptions) {
+        const PlaybackTrace::Record& record = m_active[m_active_index[subscription.first]];
+        writeSubscription(response, libsumo::RESPONSE_SUBSCRIBE_VEHICLE_VARIABLE,
+            m_trace->getVehicles()[subscription.first].id, &record, subscription.second);
+    }
+}
+
+void PlaybackServer::processGet(int command, StorageView& content, tcpip::Storage& response)
+{
+    const int var = content.readUnsignedByte();
+    const std::string id { content.readString() };
+    tcpip::Storage value;
+    bool valid = false;
+    std::string error = "variable " + hex(var) + " of command " + hex(command) + " is not available in trace";
+
+    if (command == libsumo::CMD_GET_SIM_VARIABLE) {
+        if (var == libsumo::POSITION_CONVERSION) {
+            valid = writePositionConversion(value, content);
+            error = "trace lacks geographic projection or conversion is not supported";
+        } else {
+            valid = writeSimulationValue(value, var);
+        }
+    } else if (command == libsumo::CMD_GET_VEHICLE_VARIABLE) {
+        if (var == libsumo::TRACI_ID_LIST) {
+            std::vector<std::string> ids;
+            ids.reserve(m_active.size());
+            for (const PlaybackTrace::Record& record : m_active) {
+                ids.push_back(m_trace->getVehicles()[record.vehicle].id);
+            }
+            writeStringList(value, ids);
+            valid = true;
+        } else if (var == libsumo::ID_COUNT) {
+            writeInt(value, m_active.size());
+            valid = true;
+        } else if (const PlaybackTrace::Record* record = findActive(id)) {
+            valid = writeVehicleValue(value, *record, var);
+        } else {
+            error = "Vehicle '" + id + "' is not known";
+        }
+    } else if (command == libsumo::CMD_GET_VEHICLETYPE_VARIABLE) {
+        const auto& types = m_trace->getTypes();
+        if (var == libsumo::TRACI_ID_LIST) {
+            std::vector<std::string> ids;
+            for (const PlaybackTrace::Type& type : types) {
+                ids.push_back(type.id);
+            }
+            writeStringList(value, ids);
+            valid = true;
+        } else if (var == libsumo::ID_COUNT) {
+            writeInt(value, types.size());
+            valid = true;
+        } else {
+            auto found = m_type_ids.find(id);
+            if (found != m_type_ids.end()) {
+                valid = writeTypeValue(value, types[found->second], var);
+            } else {
+                error = "Vehicle type '" + id + "' is not known";
+            }
+        }
+    } else if (command == libsumo::CMD_GET_PERSON_VARIABLE) {
+        if (var == libsumo::TRACI_ID_LIST) {
+            writeStringList(value, {});
+            valid = true;
+        } else if (var == libsumo::ID_COUNT) {
+            writeInt(value, 0);
+            valid = true;
+        } else {
+            error = "Person '" + id + "' is not known";
+        }
+    }
+
+    if (valid) {
+        writeStatus(response, command, libsumo::RTYPE_OK);
+        tcpip::Storage payload;
+        payload.writeUnsignedByte(var);
+        payload.writeString(id);
+        payload.writeStorage(value);
+        writeCommand(response, command + 0x10, payload);
+    } else {
+        writeStatus(response, command, libsumo::RTYPE_ERR, error);
+    }
+}
+
+void PlaybackServer::processSubscribe(int command, StorageView& content, tcpip::Storage& response)
+{
+    content.readDouble(); // begin time
+    content.readDouble(); // end time
+    const std::string id { content.readString() };
+    std::vector<int> vars(content.readUnsignedByte());
+    for (int& var : vars) {
+        var = content.readUnsignedByte();
+    }
+
+    const PlaybackTrace::Record* record = nullptr;
+    if (command == libsumo::CMD_SUBSCRIBE_VEHICLE_VARIABLE) {
+        record = findActive(id);
+        if (!record) {
+            writeStatus(response, command, libsumo::RTYPE_ERR, "Vehicle '" + id + "' is not known");
+            return;
+        }
+    }
+
+    // reject subscription as a whole if any variable is not recorded
+    tcpip::Storage probe;
+    for (int var : vars) {
+        const bool valid = record ? writeVehicleValue(probe, *record, var) : writeSimulationValue(probe, var);
+        if (!valid) {
+            writeStatus(response, command, libsumo::RTYPE_ERR,
+                "variable " + hex(var) + " is not available in trace");
+            return;
+        }
+    }
+
+    if (record) {
+        if (vars.empty()) {
+            m_vehicle_subscriptions.erase(record->vehicle);
+        } else {
+            m_vehicle_subscriptions[record->vehicle] = vars;
+        }
+    } else {
+        m_simulation_subscription = vars;
+    }
+
+    writeStatus(response, command, libsumo::RTYPE_OK);
+    if (!vars.empty()) {
+        writeSubscription(response, command + 0x10, id, record, vars);
+    }
+}
+
+void PlaybackServer::step()
+{
+    if (m_steps < m_trace->getNumSteps()) {
+        m_trace->getRecords(m_steps, m_next);
+    } else {
+        // all vehicles arrive when trace ends
+        m_next.clear();
+    }
+    ++m_steps;
+
+    // records are ordered by vehicle index: merging them yields departures and arrivals
+    const auto& vehicles = m_trace->getVehicles();
+    auto current = m_active.cbegin();
+    auto next = m_next.cbegin();
+    while (current != m_active.cend() || next != m_next.cend()) {
+        if (next == m_next.cend() || (current != m_active.cend() && current->vehicle < next->vehicle)) {
+            m_arrived.push_back(vehicles[current->vehicle].id);
+            m_vehicle_subscriptions.erase(current->vehicle);
+            ++current;
+        } else if (current == m_active.cend() || next->vehicle < current->vehicle) {
+            m_departed.push_back(vehicles[next->vehicle].id);
+            ++next;
+        } else {
+            ++current;
+            ++next;
+        }
+    }
+
+    for (const PlaybackTrace::Record& record : m_active) {
+        m_active_index[record.vehicle] = -1;
+    }
+    std::swap(m_active, m_next);
+    for (std::size_t i = 0; i < m_active.size(); ++i) {
+        m_active_index[m_active[i].vehicle] = i;
+    }
+}
+
+double PlaybackServer::getTime() const
+{
+    return m_trace->getBegin() + m_steps * m_trace->getStepLength();
+}
+
+int PlaybackServer::getMinExpectedNumber() const
+{
+    if (m_steps == 0) {
+        return m_trace->getNumSteps() > 0 ? m_trace->getNumRecords(0) + m_trace->getNumPendingVehicles(0) : 0;
+    } else if (m_steps <= m_trace->getNumSteps()) {
+        return m_active.size() + m_trace->getNumPendingVehicles(m_steps - 1);
+    } else {
+        return 0;
+    }
+}
+
+const PlaybackTrace::Record* PlaybackServer::findActive(const std::string& id) const
+{
+    auto found = m_vehicle_ids.find(id);
+    if (found != m_vehicle_ids.end() && m_active_index[found->second] >= 0) {
+        return &m_active[m_active_index[found->second]];
+    }
+    return nullptr;
+}
+
+bool PlaybackServer::writeSimulationValue(tcpip::Storage& out, int var) const
+{
+    switch (var) {
+        case libsumo::VAR_TIME:
+            writeDouble(out, getTime());
+            break;
+        case libsumo::VAR_TIME_STEP:
+            writeInt(out, std::lround(getTime() * 1000.0));
+            break;
+        case libsumo::VAR_DELTA_T:
+            writeDouble(out, m_trace->getStepLength());
+            break;
+        case libsumo::VAR_NET_BOUNDING_BOX:
+            out.writeUnsignedByte(libsumo::TYPE_POLYGON);
+            out.writeUnsignedByte(2);
+            out.writeDouble(m_trace->getLowerLeft().x);
+            out.writeDouble(m_trace->getLowerLeft().y);
+            out.writeDouble(m_trace->getUpperRight().x);
+            out.writeDouble(m_trace->getUpperRight().y);
+            break;
+        case libsumo::VAR_MIN_EXPECTED_VEHICLES:
+            writeInt(out, getMinExpectedNumber());
+            break;
+        case libsumo::VAR_LOADED_VEHICLES_IDS:
+        case libsumo::VAR_DEPARTED_VEHICLES_IDS:
+            writeStringList(out, m_departed);
+            break;
+        case libsumo::VAR_LOADED_VEHICLES_NUMBER:
+        case libsumo::VAR_DEPARTED_VEHICLES_NUMBER:
+            writeInt(out, m_departed.size());
+            break;
+        case libsumo::VAR_ARRIVED_VEHICLES_IDS:
+            writeStringList(out, m_arrived);
+            break;
+        case libsumo::VAR_ARRIVED_VEHICLES_NUMBER:
+            writeInt(out, m_arrived.size());
+            break;
+        case libsumo::VAR_TELEPORT_STARTING_VEHICLES_IDS:
+        case libsumo::VAR_TELEPORT_ENDING_VEHICLES_IDS:
+        case libsumo::VAR_DEPARTED_PERSONS_IDS:
+        case libsumo::VAR_ARRIVED_PERSONS_IDS:
+            writeStringList(out, {});
+            break;
+        case libsumo::VAR_TELEPORT_STARTING_VEHICLES_NUMBER:
+        case libsumo::VAR_TELEPORT_ENDING_VEHICLES_NUMBER:
+        case libsumo::VAR_DEPARTED_PERSONS_NUMBER:
+        case libsumo::VAR_ARRIVED_PERSONS_NUMBER:
+            writeInt(out, 0);
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+bool PlaybackServer::writeVehicleValue(tcpip::Storage& out, const PlaybackTrace::Record& record, int var) const
+{
+    const PlaybackTrace::Vehicle& vehicle = m_trace->getVehicles()[record.vehicle];
+    switch (var) {
+        case libsumo::VAR_POSITION:
+            out.writeUnsignedByte(libsumo::POSITION_2D);
+            out.writeDouble(record.position.x);
+            out.writeDouble(record.position.y);
+            break;
+        case libsumo::VAR_POSITION3D:
+            out.writeUnsignedByte(libsumo::POSITION_3D);
+            out.writeDouble(record.position.x);
+            out.writeDouble(record.position.y);
+            out.writeDouble(record.position.z);
+            break;
+        case libsumo::VAR_SPEED:
+            writeDouble(out, record.speed);
+            break;
+        case libsumo::VAR_ANGLE:
+            writeDouble(out, record.angle);
+            break;
+        case libsumo::VAR_TYPE:
+            writeString(out, m_trace->getTypes()[vehicle.type].id);
+            break;
+        default:
+            return writeTypeValue(out, m_trace->getTypes()[vehicle.type], var);
+    }
+    return true;
+}
+
+bool PlaybackServer::writeTypeValue(tcpip::Storage& out, const PlaybackTrace::Type& type, int var) const
+{
+    switch (var) {
+        case libsumo::VAR_VEHICLECLASS:
+            writeString(out, type.vehicleClass);
+            break;
+        case libsumo::VAR_LENGTH:
+            writeDouble(out, type.length);
+            break;
+        case libsumo::VAR_WIDTH:
+            writeDouble(out, type.width);
+            break;
+        case libsumo::VAR_HEIGHT:
+            writeDouble(out, type.height);
+            break;
+        case libsumo::VAR_MAXSPEED:
+            writeDouble(out, type.maxSpeed);
+            break;
+        case libsumo::VAR_ACCEL:
+            writeDouble(out, type.accel);
+            break;
+        case libsumo::VAR_DECEL:
+            writeDouble(out, type.decel);
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+bool PlaybackServer::writePositionConversion(tcpip::Storage& out, StorageView& content) const
+{
+    // same layout as TraCIAPI::SimulationScope::convertGeo
+    if (!m_projection || content.readUnsignedByte() != libsumo::TYPE_COMPOUND || content.readInt() != 2) {
+        return false;
+    }
+    const int from = content.readUnsignedByte();
+    const double x = content.readDouble();
+    const double y = content.readDouble();
+    if (content.readUnsignedByte() != libsumo::TYPE_UBYTE) {
+        return false;
+    }
+    const int to = content.readUnsignedByte();
+
+    if (from == libsumo::POSITION_2D && to == libsumo::POSITION_LON_LAT) {
+        TraCIPosition position;
+        position.x = x;
+        position.y = y;
+        position.z = 0.0;
+        const TraCIGeoPosition geo = m_projection->toGeo(position);
+        out.writeUnsignedByte(libsumo::POSITION_LON_LAT);
+        out.writeDouble(geo.longitude);
+        out.writeDouble(geo.latitude);
+    } else if (from == libsumo::POSITION_LON_LAT && to == libsumo::POSITION_2D) {
+        TraCIGeoPosition geo;
+        geo.longitude = x;
+        geo.latitude = y;
+        const TraCIPosition position = m_projection->fromGeo(geo);
+        out.writeUnsignedByte(libsumo::POSITION_2D);
+        out.writeDouble(position.x);
+        out.writeDouble(position.y);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void PlaybackServer::writeSubscription(tcpip::Storage& out, int response, const std::string& id,
+        const PlaybackTrace::Record* record, const std::vector<int>& vars) const
+{
+    tcpip::Storage payload;
+    payload.writeString(id);
+    payload.writeUnsignedByte(vars.size());
+    for (int var : vars) {
+        payload.writeUnsignedByte(var);
+        payload.writeUnsignedByte(libsumo::RTYPE_OK);
+        if (record) {
+            writeVehicleValue(payload, *record, var);
+        } else {
+            writeSimulationValue(payload, var);
+        }
+    }
+
+    // subscription responses always use the extended length field
+    const int length = 1 + 4 + 1 + static_cast<int>(payload.size());
+    out.writeUnsignedByte(0);
+    out.writeInt(length);
+    out.writeUnsignedByte(response);
+    out.writeStorage(payload);
+}
+
+} // namespace traci
@@ -0,0 +1,103 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef TRACI_PLAYBACKSERVER_H_W9CJ4TLB
+#define TRACI_PLAYBACKSERVER_H_W9CJ4TLB
+
+#include "traci/PlaybackTrace.h"
+#include "traci/UtmProjection.h"
+#include "traci/sumo/foreign/tcpip/socket.h"
+#include "traci/sumo/foreign/tcpip/storage.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace traci
+{
+
+class StorageView;
+
+/**
+ * PlaybackServer answers TraCI commands of a single client from a recorded trace instead of a live SUMO
+ *
+ * Only the retrieval and subscription commands required by node and subscription managers are available:
+ * simulation time, departed and arrived vehicles, network boundary, position conversion,
+ * position, speed, angle and type of vehicles as well as vehicle type properties.
+ * Any other command, in particular commands controlling vehicles, is answered with an error.
+ * Persons are not recorded in traces.
+ */
+class PlaybackServer
+{
+public:
+    /**
+     * Listen for a TraCI client
+     * \param trace recorded trajectories
+     * \param port TCP port, a free port is picked if zero
+     * \param socketPath listen on Unix-domain socket at this path instead of TCP port if not empty
+     */
+    PlaybackServer(std::shared_ptr<const PlaybackTrace> trace, int port, const std::string& socketPath = "");
+
+    int getPort() const { return m_port; }
+    const std::string& getSocketPath() const { return m_socket_path; }
+
+    /**
+     * Accept client and answer its commands until it closes the connection
+     */
+    void serve();
+
+    /**
+     * Listen for another client continuing the current session, e.g. in a forked process
+     *
+     * The connection to the previous client is dropped, the parent process keeps its copy.
+     * A Unix-domain socket path is suffixed by the calling process' PID.
+     * \return TCP port of new listening socket
+     */
+    int rebind();
+
+private:
+    void listen();
+    void process(int command, StorageView& content, tcpip::Storage& response);
+    void processStep(StorageView& content, tcpip::Storage& response);
+    void processGet(int command, StorageView& content, tcpip::Storage& response);
+    void processSubscribe(int command, StorageView& content, tcpip::Storage& response);
+    void step();
+    double getTime() const;
+    int getMinExpectedNumber() const;
+    const PlaybackTrace::Record* findActive(const std::string& id) const;
+
+    bool writeSimulationValue(tcpip::Storage&, int var) const;
+    bool writeVehicleValue(tcpip::Storage&, const PlaybackTrace::Record&, int var) const;
+    bool writeTypeValue(tcpip::Storage&, const PlaybackTrace::Type&, int var) const;
+    bool writePositionConversion(tcpip::Storage&, StorageView& content) const;
+    void writeSubscription(tcpip::Storage&, int response, const std::string& id,
+            const PlaybackTrace::Record*, const std::vector<int>& vars) const;
+
+    std::shared_ptr<const PlaybackTrace> m_trace;
+    std::unique_ptr<UtmProjection> m_projection;
+    int m_port;
+    std::string m_socket_base_path;
+    std::string m_socket_path;
+    std::unique_ptr<tcpip::Socket> m_socket;
+    bool m_closed = false;
+
+    std::size_t m_steps = 0; /*< number of simulated steps */
+    std::vector<PlaybackTrace::Record> m_active; /*< records of vehicles in network */
+    std::vector<PlaybackTrace::Record> m_next;
+    std::vector<int> m_active_index; /*< index into m_active by vehicle index, -1 if not in network */
+    std::vector<std::string> m_departed;
+    std::vector<std::string> m_arrived;
+    std::unordered_map<std::string, std::uint32_t> m_vehicle_ids;
+    std::unordered_map<std::string, std::uint32_t> m_type_ids;
+
+    std::vector<int> m_simulation_subscription;
+    std::map<std::uint32_t, std::vector<int>> m_vehicle_subscriptions;
+};
+
+} // namespace traci
+
+#endif /* TRACI_PLAYBACKSERVER_H_W9CJ4TLB */
@@ -0,0 +1,185 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "traci/PlaybackTrace.h"
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace traci
+{
+
+namespace
+{
+
+const char magic[8] = { 'A', 'R', 'T', 'E', 'R', 'Y', 'T', 'R' };
+const std::uint32_t version = 1;
+const std::size_t headerSize = 96;
+const std::size_t typeSize = 56;
+const std::size_t vehicleSize = 8;
+const std::size_t blockHeaderSize = 8;
+const std::size_t recordSize = 48;
+
+} // namespace
+
+PlaybackTrace::PlaybackTrace(const std::string& filename)
+{
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("cannot open playback trace " + filename);
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(headerSize)) {
+        ::close(fd);
+        throw std::runtime_error("playback trace " + filename + " is truncated");
+    }
+
+    m_size = info.st_size;
+    void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        throw std::runtime_error("cannot map playback trace " + filename);
+    }
+    m_data = static_cast<const unsigned char*>(data);
+
+    try {
+        if (std::memcmp(m_data, magic, sizeof(magic)) != 0 || readUint32(8) != version) {
+            throw std::runtime_error("playback trace " + filename + " has unknown format");
+        }
+
+        const std::uint32_t steps = readUint32(12);
+        const std::uint32_t vehicles = readUint32(16);
+        const std::uint32_t types = readUint32(20);
+        m_begin = readDouble(24);
+        m_step_length = readDouble(32);
+        m_lower_left.x = readDouble(40);
+        m_lower_left.y = readDouble(48);
+        m_upper_right.x = readDouble(56);
+        m_upper_right.y = readDouble(64);
+        m_utm_zone = static_cast<std::int32_t>(readUint32(72));
+        m_utm_offset.x = readDouble(80);
+        m_utm_offset.y = readDouble(88);
+        if (m_step_length <= 0.0) {
+            throw std::runtime_error("playback trace " + filename + " has invalid step length");
+        }
+
+        std::size_t offset = headerSize + readUint32(76);
+        m_types.reserve(types);
+        for (std::uint32_t i = 0; i < types; ++i, offset += typeSize) {
+            Type type;
+            type.id = readString(readUint32(offset));
+            type.vehicleClass = readString(readUint32(offset + 4));
+            type.length = readDouble(offset + 8);
+            type.width = readDouble(offset + 16);
+            type.height = readDouble(offset + 24);
+            type.maxSpeed = readDouble(offset + 32);
+            type.accel = readDouble(offset + 40);
+            type.decel = readDouble(offset + 48);
+            m_types.push_back(std::move(type));
+        }
+
+        m_vehicles.reserve(vehicles);
+        for (std::uint32_t i = 0; i < vehicles; ++i, offset += vehicleSize) {
+            Vehicle vehicle;
+            vehicle.id = readString(readUint32(offset));
+            vehicle.type = readUint32(offset + 4);
+            if (vehicle.type >= m_types.size()) {
+                throw std::runtime_error("playback trace " + filename + " refers to unknown vehicle type");
+            }
+            m_vehicles.push_back(std::move(vehicle));
+        }
+
+        m_step_offsets.reserve(steps);
+        for (std::uint32_t i = 0; i < steps; ++i, offset += 8) {
+            const std::uint64_t block = readUint64(offset);
+            checkRange(block, blockHeaderSize);
+            checkRange(block + blockHeaderSize, readUint32(block) * recordSize);
+            m_step_offsets.push_back(block);
+        }
+    } catch (...) {
+        ::munmap(const_cast<unsigned char*>(m_data), m_size);
+        throw;
+    }
+}
+
+PlaybackTrace::~PlaybackTrace()
+{
+    ::munmap(const_cast<unsigned char*>(m_data), m_size);
+}
+
+std::size_t PlaybackTrace::getNumRecords(std::size_t step) const
+{
+    return readUint32(m_step_offsets.at(step));
+}
+
+std::size_t PlaybackTrace::getNumPendingVehicles(std::size_t step) const
+{
+    return readUint32(m_step_offsets.at(step) + 4);
+}
+
+void PlaybackTrace::getRecords(std::size_t step, std::vector<Record>& records) const
+{
+    const std::size_t block = m_step_offsets.at(step);
+    const std::size_t count = readUint32(block);
+    records.resize(count);
+    std::size_t offset = block + blockHeaderSize;
+    for (Record& record : records) {
+        record.vehicle = readUint32(offset);
+        if (record.vehicle >= m_vehicles.size()) {
+            throw std::runtime_error("playback trace refers to unknown vehicle");
+        }
+        record.position.x = readDouble(offset + 8);
+        record.position.y = readDouble(offset + 16);
+        record.position.z = readDouble(offset + 24);
+        record.speed = readDouble(offset + 32);
+        record.angle = readDouble(offset + 40);
+        offset += recordSize;
+    }
+}
+
+// trace files are little-endian like all supported host platforms
+std::uint32_t PlaybackTrace::readUint32(std::size_t offset) const
+{
+    checkRange(offset, sizeof(std::uint32_t));
+    std::uint32_t value;
+    std::memcpy(&value, m_data + offset, sizeof(value));
+    return value;
+}
+
+std::uint64_t PlaybackTrace::readUint64(std::size_t offset) const
+{
+    checkRange(offset, sizeof(std::uint64_t));
+    std::uint64_t value;
+    std::memcpy(&value, m_data + offset, sizeof(value));
+    return value;
+}
+
+double PlaybackTrace::readDouble(std::size_t offset) const
+{
+    checkRange(offset, sizeof(double));
+    double value;
+    std::memcpy(&value, m_data + offset, sizeof(value));
+    return value;
+}
+
+std::string PlaybackTrace::readString(std::size_t offset) const
+{
+    const std::uint32_t length = readUint32(offset);
+    checkRange(offset + 4, length);
+    return std::string { reinterpret_cast<const char*>(m_data + offset + 4), length };
+}
+
+void PlaybackTrace::checkRange(std::size_t offset, std::size_t length) const
+{
+    if (offset > m_size || length > m_size - offset) {
+        throw std::runtime_error("playback trace access exceeds file");
+    }
+}
+
+} // namespace traci
@@ -0,0 +1,121 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef TRACI_PLAYBACKTRACE_H_K4TWN8QE
+#define TRACI_PLAYBACKTRACE_H_K4TWN8QE
+
+#include "traci/Position.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace traci
+{
+
+/**
+ * PlaybackTrace gives memory-mapped access to a recorded trajectory file
+ *
+ * Trajectory files are converted once from SUMO's FCD output by tools/fcd2trace.py.
+ * All numbers are stored little-endian, strings are referenced by their file offset:
+ *
+ *  header (96 bytes): magic "ARTERYTR", uint32 version, uint32 steps, uint32 vehicles, uint32 types,
+ *      double begin time, double step length, double boundary (x min, y min, x max, y max),
+ *      int32 UTM zone (0 if unknown), uint32 size of string pool, double UTM offset (x, y)
+ *  string pool: strings stored as uint32 length followed by their characters
+ *  types (56 bytes each): uint32 id string, uint32 vehicle class string,
+ *      double length, width, height, max speed, acceleration, deceleration
+ *  vehicles (8 bytes each): uint32 id string, uint32 type index
+ *  step index (8 bytes each): uint64 offset of step block
+ *  step block: uint32 records, uint32 vehicles departing in later steps,
+ *      records (48 bytes each, ascending by vehicle index): uint32 vehicle index, uint32 reserved,
+ *      double x, y, z, speed, angle
+ *
+ * Step block i holds the state after SUMO has simulated i + 1 steps since begin time.
+ */
+class PlaybackTrace
+{
+public:
+    struct Type
+    {
+        std::string id;
+        std::string vehicleClass;
+        double length;
+        double width;
+        double height;
+        double maxSpeed;
+        double accel;
+        double decel;
+    };
+
+    struct Vehicle
+    {
+        std::string id;
+        std::uint32_t type;
+    };
+
+    struct Record
+    {
+        std::uint32_t vehicle;
+        TraCIPosition position;
+        double speed;
+        double angle;
+    };
+
+    /**
+     * Map trace file into memory
+     * \param filename path of trace file
+     * \throw std::runtime_error if file is missing or malformed
+     */
+    explicit PlaybackTrace(const std::string& filename);
+    ~PlaybackTrace();
+
+    PlaybackTrace(const PlaybackTrace&) = delete;
+    PlaybackTrace& operator=(const PlaybackTrace&) = delete;
+
+    double getBegin() const { return m_begin; }
+    double getStepLength() const { return m_step_length; }
+    const TraCIPosition& getLowerLeft() const { return m_lower_left; }
+    const TraCIPosition& getUpperRight() const { return m_upper_right; }
+    int getUtmZone() const { return m_utm_zone; }
+    const TraCIPosition& getUtmOffset() const { return m_utm_offset; }
+
+    const std::vector<Type>& getTypes() const { return m_types; }
+    const std::vector<Vehicle>& getVehicles() const { return m_vehicles; }
+
+    std::size_t getNumSteps() const { return m_step_offsets.size(); }
+    std::size_t getNumRecords(std::size_t step) const;
+    std::size_t getNumPendingVehicles(std::size_t step) const;
+
+    /**
+     * Decode records of a step block
+     * \param step index of step block
+     * \param records replaced by the block's records
+     */
+    void getRecords(std::size_t step, std::vector<Record>& records) const;
+
+private:
+    std::uint32_t readUint32(std::size_t offset) const;
+    std::uint64_t readUint64(std::size_t offset) const;
+    double readDouble(std::size_t offset) const;
+    std::string readString(std::size_t offset) const;
+    void checkRange(std::size_t offset, std::size_t length) const;
+
+    const unsigned char* m_data = nullptr;
+    std::size_t m_size = 0;
+    double m_begin;
+    double m_step_length;
+    TraCIPosition m_lower_left;
+    TraCIPosition m_upper_right;
+    int m_utm_zone;
+    TraCIPosition m_utm_offset;
+    std::vector<Type> m_types;
+    std::vector<Vehicle> m_vehicles;
+    std::vector<std::uint64_t> m_step_offsets;
+};
+
+} // namespace traci
+
+#endif /* TRACI_PLAYBACKTRACE_H_K4TWN8QE */
@@ -1,12 +1,18 @@
 #include "traci/PosixLauncher.h"
 #include <omnetpp/cconfiguration.h>
+#include <algorithm>
 #include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iterator>
 #include <regex>
 #include <arpa/inet.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <netinet/in.h>
+#include <fcntl.h>
+#include <sched.h>
 #include <signal.h>
 #include <unistd.h>
 
@@ -48,6 +54,88 @@ BlockSignal::~BlockSignal()
     ::pthread_sigmask(SIG_UNBLOCK, &block_mask, nullptr);
 }
 
+/**
+ * Parse CPU list like Linux' cpulist format, e.g. "0-3,8"
+ */
+std::vector<int> parseCpuList(const std::string& list)
+{
+    std::vector<int> cpus;
+    if (list.find_first_not_of(" \t") == std::string::npos) {
+        return cpus;
+    }
+
+    std::regex range("\\s*(\\d+)(?:-(\\d+))?\\s*");
+    std::smatch match;
+    std::size_t begin = 0;
+    while (begin <= list.size()) {
+        std::size_t end = list.find(',', begin);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        const std::string item = list.substr(begin, end - begin);
+        if (!std::regex_match(item, match, range)) {
+            throw omnetpp::cRuntimeError("invalid CPU list \"%s\"", list.c_str());
+        }
+        const int first = std::stoi(match[1]);
+        const int last = match[2].matched ? std::stoi(match[2]) : first;
+        if (last < first) {
+            throw omnetpp::cRuntimeError("invalid CPU range in \"%s\"", list.c_str());
+        }
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+        begin = end + 1;
+    }
+
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+/**
+ * Restrict calling thread (and threads and processes it creates later on) to given CPUs
+ *
+ * Memory pages follow by Linux' default policy of allocating on the node of the touching CPU.
+ */
+bool setAffinity(const std::vector<int>& cpus)
+{
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        CPU_SET(cpu, &set);
+    }
+    return ::sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    return cpus.empty();
+#endif
+}
+
+/**
+ * Failure of forked child before it became the TraCI server
+ */
+struct ChildFailure
+{
+    enum Stage : int { Affinity, Exec };
+    int stage;
+    int error;
+};
+
+/**
+ * Report failure to parent and stderr, then terminate the forked child
+ */
+[[noreturn]] void failChild(int fd, ChildFailure::Stage stage, const char* what)
+{
+    const ChildFailure failure { stage, errno };
+    const char* reason = std::strerror(failure.error);
+    ::write(STDERR_FILENO, what, std::strlen(what));
+    ::write(STDERR_FILENO, ": ", 2);
+    ::write(STDERR_FILENO, reason, std::strlen(reason));
+    ::write(STDERR_FILENO, "\n", 1);
+    ::write(fd, &failure, sizeof(failure));
+    ::_exit(1);
+}
+
 }
 
 
@@ -66,8 +154,38 @@ void PosixLauncher::initialize()
     m_command = par("command").stringValue();
     m_sumocfg = par("sumocfg").stringValue();
     m_extra_options = par("extraOptions").stringValue();
+    const std::string append_options = par("appendOptions").stringValue();
+    if (!append_options.empty()) {
+        if (!m_extra_options.empty()) {
+            m_extra_options.append(1, ' ');
+        }
+        m_extra_options.append(append_options);
+    }
+    m_load_state = par("loadState").stringValue();
+    m_save_state = par("saveState").stringValue();
+    m_save_state_times = par("saveStateTimes").stringValue();
+    if (m_save_state.empty() != m_save_state_times.empty()) {
+        throw omnetpp::cRuntimeError("saveState and saveStateTimes have to be given together");
+    }
     m_port = par("port");
     m_seed = par("seed");
+    m_num_clients = par("numClients");
+    if (m_num_clients < 1) {
+        throw omnetpp::cRuntimeError("numClients has to be at least 1");
+    }
+    m_socket_path = par("socketPath").stringValue();
+
+    m_sumo_cpus = lookupCpus("sumoCpus", "sumoNumaNode");
+    m_omnetpp_cpus = lookupCpus("omnetppCpus", "omnetppNumaNode");
+    std::vector<int> shared;
+    std::set_intersection(m_sumo_cpus.begin(), m_sumo_cpus.end(),
+            m_omnetpp_cpus.begin(), m_omnetpp_cpus.end(), std::back_inserter(shared));
+    if (!shared.empty()) {
+        EV_WARN << "SUMO and OMNeT++ share " << shared.size() << " CPUs, they will compete for these cores\n";
+    }
+    if (!m_omnetpp_cpus.empty() && !setAffinity(m_omnetpp_cpus)) {
+        throw omnetpp::cRuntimeError("setting CPU affinity of OMNeT++ failed: %s", std::strerror(errno));
+    }
 }
 
 void PosixLauncher::finish()
@@ -87,30 +205,64 @@ ServerEndpoint PosixLauncher::launch()
     ServerEndpoint endpoint;
     endpoint.hostname = "localhost";
     endpoint.port = m_port;
+    endpoint.socketPath = m_socket_path;
     endpoint.retry = true;
 
+    // child reports failures before exec through this pipe, a successful exec closes it
+    int status[2];
+    if (::pipe(status) != 0) {
+        throw omnetpp::cRuntimeError("pipe() failed: %s", std::strerror(errno));
+    }
+    ::fcntl(status[1], F_SETFD, FD_CLOEXEC);
+
     // temporarily block SIGINT during fork sequence
     BlockSignal block_sigint({ SIGINT });
 
     m_pid = ::fork();
     if (m_pid < 0) {
-        throw omnetpp::cRuntimeError("fork() failed: %s", std::strerror(errno));
+        const int error = errno;
+        ::close(status[0]);
+        ::close(status[1]);
+        throw omnetpp::cRuntimeError("fork() failed: %s", std::strerror(error));
     } else if (m_pid == 0) {
+        ::close(status[0]);
+
         // ignore signal so SUMO does not quit when user interrupts in gdb
         ::signal(SIGINT, SIG_IGN);
 
         // sumo-gui resets SIGINT handler: move process to own process group
         ::setpgid(0, 0);
 
-        if (::execl("/bin/sh", "sh", "-c", command().c_str(), NULL)  == -1) {
-            throw omnetpp::cRuntimeError("Starting TraCI server failed: %s", std::strerror(errno));
+        // pin before exec: SUMO's memory is then allocated on its own NUMA node
+        if (!m_sumo_cpus.empty() && !setAffinity(m_sumo_cpus)) {
+            failChild(status[1], ChildFailure::Affinity, "setting CPU affinity of SUMO failed");
         }
-        ::_exit(1);
+
+        const std::string cmd = command();
+        ::execl("/bin/sh", "sh", "-c", cmd.c_str(), NULL);
+        failChild(status[1], ChildFailure::Exec, "Starting TraCI server failed");
     } else {
+        ::close(status[1]);
         // race between parent and child (see setpgid RATIONALE)
         if (::setpgid(m_pid, m_pid) != 0 && errno != EACCES) {
+            ::close(status[0]);
             throw omnetpp::cRuntimeError("setpgid() failed: %s", std::strerror(errno));
         }
+
+        ChildFailure failure;
+        ssize_t bytes = 0;
+        do {
+            bytes = ::read(status[0], &failure, sizeof(failure));
+        } while (bytes < 0 && errno == EINTR);
+        ::close(status[0]);
+        if (bytes == sizeof(failure)) {
+            // do not retry to connect to a server which never started
+            ::waitpid(m_pid, NULL, 0);
+            m_pid = 0;
+            const char* what = failure.stage == ChildFailure::Affinity ?
+                "setting CPU affinity of SUMO failed" : "Starting TraCI server failed";
+            throw omnetpp::cRuntimeError("%s: %s", what, std::strerror(failure.error));
+        }
     }
 
     return endpoint;
@@ -134,18 +286,32 @@ std::string PosixLauncher::command()
     std::regex seed("%SEED%");
     std::regex run("%RUN%");
     std::regex resultdir("%RESULTDIR%");
+    std::regex socket("%SOCKET%");
 
     const auto cfg = getSimulation()->getEnvir()->getConfigEx();
     const auto cfg_run_number = cfg->getVariable(CFGVAR_RUNNUMBER);
     const auto cfg_result_dir = cfg->getVariable(CFGVAR_RESULTDIR);
 
     std::string command = m_command;
+    // state files may contain placeholders like %RESULTDIR% as well
+    if (!m_load_state.empty()) {
+        command.append(" --load-state ").append(m_load_state);
+    }
+    if (!m_save_state.empty()) {
+        command.append(" --save-state.times ").append(m_save_state_times);
+        command.append(" --save-state.files ").append(m_save_state);
+    }
     command = std::regex_replace(command, executable, m_executable);
     command = std::regex_replace(command, sumocfg, m_sumocfg);
     command = std::regex_replace(command, port, std::to_string(m_port));
     command = std::regex_replace(command, seed, std::to_string(m_seed));
     command = std::regex_replace(command, run, cfg_run_number);
     command = std::regex_replace(command, resultdir, cfg_result_dir);
+    command = std::regex_replace(command, socket, m_socket_path);
+
+    if (m_num_clients > 1) {
+      command.append(" --num-clients ").append(std::to_string(m_num_clients));
+    }
 
     if (!m_extra_options.empty()) {
       command.append(1, ' ').append(m_extra_options);
@@ -180,4 +346,42 @@ int PosixLauncher::lookupPort()
     return ntohs(sin.sin_port);
 }
 
+std::vector<int> PosixLauncher::lookupCpus(const char* cpusPar, const char* nodePar)
+{
+    std::vector<int> cpus = parseCpuList(par(cpusPar).stringValue());
+    const int node = par(nodePar);
+    if (node >= 0) {
+        const std::string nodeFile = "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist";
+        std::ifstream nodeStream(nodeFile);
+        std::string nodeCpuList;
+        if (!std::getline(nodeStream, nodeCpuList)) {
+            throw omnetpp::cRuntimeError("%s: NUMA node %d does not exist", nodePar, node);
+        }
+
+        const std::vector<int> nodeCpus = parseCpuList(nodeCpuList);
+        if (cpus.empty()) {
+            cpus = nodeCpus;
+        } else {
+            std::vector<int> selected;
+            std::set_intersection(cpus.begin(), cpus.end(), nodeCpus.begin(), nodeCpus.end(),
+                    std::back_inserter(selected));
+            if (selected.empty()) {
+                throw omnetpp::cRuntimeError("%s contains no CPU of NUMA node %d", cpusPar, node);
+            }
+            cpus.swap(selected);
+        }
+    }
+
+#ifdef __linux__
+    if (!cpus.empty() && cpus.back() >= CPU_SETSIZE) {
+        throw omnetpp::cRuntimeError("%s exceeds supported number of CPUs", cpusPar);
+    }
+#else
+    if (!cpus.empty()) {
+        throw omnetpp::cRuntimeError("%s is only supported on Linux", cpusPar);
+    }
+#endif
+    return cpus;
+}
+
 } // namespace traci
@@ -4,6 +4,7 @@
 #include "traci/Launcher.h"
 #include <omnetpp/csimplemodule.h>
 #include <string>
+#include <vector>
 #include <unistd.h>
 
 namespace traci
@@ -24,13 +25,21 @@ private:
     void kill();
     std::string command();
     int lookupPort();
+    std::vector<int> lookupCpus(const char* cpusPar, const char* nodePar);
 
     std::string m_executable;
     std::string m_command;
     std::string m_sumocfg;
     std::string m_extra_options;
+    std::string m_load_state;
+    std::string m_save_state;
+    std::string m_save_state_times;
+    std::string m_socket_path;
+    std::vector<int> m_sumo_cpus;
+    std::vector<int> m_omnetpp_cpus;
     int m_port;
     int m_seed;
+    int m_num_clients;
     pid_t m_pid;
 };
 
@@ -0,0 +1,135 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "traci/ProbeVehiclePolicy.h"
+#include "traci/BasicNodeManager.h"
+#include "traci/VariableCache.h"
+#include "traci/VehicleStateTable.h"
+#include <omnetpp/cstringtokenizer.h>
+
+using namespace omnetpp;
+
+namespace traci
+{
+
+Define_Module(ProbeVehiclePolicy)
+
+void ProbeVehiclePolicy::initializePolicy(BasicNodeManager&)
+{
+    for (const std::string& id : cStringTokenizer(par("probeVehicles").stringValue()).asVector()) {
+        m_probe_ids.insert(id);
+    }
+    for (const std::string& type : cStringTokenizer(par("probeVehicleTypes").stringValue()).asVector()) {
+        m_probe_types.insert(type);
+    }
+
+    m_activation_radius = par("activationRadius");
+    m_deactivation_radius = par("deactivationRadius");
+    if (m_deactivation_radius < m_activation_radius) {
+        throw cRuntimeError("deactivationRadius must not be less than activationRadius");
+    }
+    m_min_residence_time = par("minResidenceTime");
+    EV_INFO << "Vehicles are relevant near " << m_probe_ids.size() << " probe vehicles and vehicles of "
+        << m_probe_types.size() << " probe types" << endl;
+}
+
+VehiclePolicy::Decision ProbeVehiclePolicy::addVehicle(const std::string& id)
+{
+    if (isProbe(id)) {
+        EV_DEBUG << "Vehicle " << id << " departed as probe" << endl;
+        m_probes.insert(id);
+        // region of interest moves with new probe right now
+        m_probe_positions_time = -1.0;
+        return Decision::Continue;
+    } else {
+        return ShadowVehiclePolicy::addVehicle(id);
+    }
+}
+
+VehiclePolicy::Decision ProbeVehiclePolicy::removeVehicle(const std::string& id)
+{
+    m_materialised.erase(id);
+    if (m_probes.erase(id) > 0) {
+        m_probe_positions_time = -1.0;
+    }
+    return ShadowVehiclePolicy::removeVehicle(id);
+}
+
+bool ProbeVehiclePolicy::shallMaterialise(const std::string& id)
+{
+    return isNearProbe(id, m_activation_radius);
+}
+
+bool ProbeVehiclePolicy::shallRetain(const std::string& id)
+{
+    if (m_probes.count(id) > 0 || isNearProbe(id, m_deactivation_radius)) {
+        return true;
+    }
+
+    // materialised nodes are kept at least for their minimum residence time
+    auto since = m_materialised.find(id);
+    return since != m_materialised.end() && simTime() - since->second < m_min_residence_time;
+}
+
+void ProbeVehiclePolicy::materialised(const std::string& id)
+{
+    m_materialised[id] = simTime();
+}
+
+bool ProbeVehiclePolicy::isProbe(const std::string& id) const
+{
+    if (m_probe_ids.count(id) > 0) {
+        return true;
+    } else if (m_probe_types.empty()) {
+        return false;
+    }
+
+    // vehicle type is a static variable, i.e. it has been fetched along with the subscription
+    const std::string& type = m_subscriptions->getVehicleCache(id)->get<libsumo::VAR_TYPE>();
+    return m_probe_types.count(type) > 0;
+}
+
+bool ProbeVehiclePolicy::isNearProbe(const std::string& id, double radius)
+{
+    const VehicleStateTable& states = m_subscriptions->getVehicleStateTable();
+    const auto index = states.find(id);
+    if (index == VehicleStateTable::npos) {
+        // vehicle without subscription results is not relevant
+        return false;
+    }
+
+    updateProbePositions();
+    const double x = states.x(index);
+    const double y = states.y(index);
+    const double squared_radius = radius * radius;
+    for (const TraCIPosition& probe : m_probe_positions) {
+        const double dx = probe.x - x;
+        const double dy = probe.y - y;
+        if (dx * dx + dy * dy <= squared_radius) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ProbeVehiclePolicy::updateProbePositions()
+{
+    // probes are looked up once per step
+    if (m_probe_positions_time == simTime()) {
+        return;
+    }
+
+    const VehicleStateTable& states = m_subscriptions->getVehicleStateTable();
+    m_probe_positions.clear();
+    for (const std::string& probe : m_probes) {
+        const auto index = states.find(probe);
+        if (index != VehicleStateTable::npos) {
+            m_probe_positions.push_back(states.position(index));
+        }
+    }
+    m_probe_positions_time = simTime();
+}
+
+} // namespace traci
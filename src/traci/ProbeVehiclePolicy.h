@@ -0,0 +1,58 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef TRACI_PROBEVEHICLEPOLICY_H_K7DW3NXA
+#define TRACI_PROBEVEHICLEPOLICY_H_K7DW3NXA
+
+#include "traci/Position.h"
+#include "traci/ShadowVehiclePolicy.h"
+#include <omnetpp/simtime.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace traci
+{
+
+/**
+ * ProbeVehiclePolicy instantiates vehicle nodes only in the vicinity of probe vehicles.
+ *
+ * Probes are given by their SUMO vehicle identifiers or types and always get a node.
+ * The region of interest is the set of circles centred on all probes, i.e. it moves along
+ * with them. Other vehicles are kept as shadows like ProximityVehiclePolicy does:
+ * their nodes are materialised within activation radius of any probe and torn down again
+ * beyond deactivation radius of all probes, but not before their minimum residence time.
+ */
+class ProbeVehiclePolicy : public ShadowVehiclePolicy
+{
+public:
+    Decision addVehicle(const std::string& id) override;
+    Decision removeVehicle(const std::string& id) override;
+
+protected:
+    void initializePolicy(BasicNodeManager&) override;
+    bool shallMaterialise(const std::string& id) override;
+    bool shallRetain(const std::string& id) override;
+    void materialised(const std::string& id) override;
+
+private:
+    bool isProbe(const std::string& id) const;
+    bool isNearProbe(const std::string& id, double radius);
+    void updateProbePositions();
+
+    std::unordered_set<std::string> m_probe_ids;
+    std::unordered_set<std::string> m_probe_types;
+    double m_activation_radius = 0.0;
+    double m_deactivation_radius = 0.0;
+    omnetpp::SimTime m_min_residence_time;
+    std::unordered_set<std::string> m_probes;
+    std::vector<TraCIPosition> m_probe_positions;
+    omnetpp::SimTime m_probe_positions_time = -1.0;
+    std::unordered_map<std::string, omnetpp::SimTime> m_materialised;
+};
+
+} // namespace traci
+
+#endif /* TRACI_PROBEVEHICLEPOLICY_H_K7DW3NXA */
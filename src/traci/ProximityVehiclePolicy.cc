@@ -0,0 +1,153 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "traci/ProximityVehiclePolicy.h"
+#include "traci/API.h"
+#include "traci/BasicNodeManager.h"
+#include "traci/VariableCache.h"
+#include "traci/VehicleStateTable.h"
+#include <boost/lexical_cast.hpp>
+#include <omnetpp/cstringtokenizer.h>
+#include <omnetpp/cxmlelement.h>
+#include <algorithm>
+
+using namespace omnetpp;
+
+namespace traci
+{
+
+Define_Module(ProximityVehiclePolicy)
+
+void ProximityVehiclePolicy::initializePolicy(BasicNodeManager& manager)
+{
+    cXMLElement* anchors = par("anchors").xmlValue();
+    if (anchors) {
+        for (cXMLElement* point : anchors->getChildrenByTagName("point")) {
+            const char* x = point->getAttribute("x");
+            const char* y = point->getAttribute("y");
+            if (!x || !y) {
+                throw cRuntimeError("Anchor point requires x and y attributes at %s", point->getSourceLocation());
+            }
+            TraCIPosition anchor;
+            anchor.x = boost::lexical_cast<double>(x);
+            anchor.y = boost::lexical_cast<double>(y);
+            m_anchors.push_back(anchor);
+        }
+    }
+
+    for (const std::string& type : cStringTokenizer(par("stationVehicleTypes").stringValue()).asVector()) {
+        m_station_types.insert(type);
+    }
+
+    cXMLElement* regions = par("regionsOfInterest").xmlValue();
+    if (regions) {
+        Boundary boundary { manager.getAPI()->simulation.getNetBoundary() };
+        m_regions.initialize(*regions, boundary);
+    }
+
+    m_activation_distance = par("activationDistance");
+    m_deactivation_distance = par("deactivationDistance");
+    if (m_deactivation_distance < m_activation_distance) {
+        throw cRuntimeError("deactivationDistance must not be less than activationDistance");
+    }
+    EV_INFO << "Vehicles are relevant near " << m_anchors.size() << " anchors, vehicles of "
+        << m_station_types.size() << " station types and within " << m_regions.size() << " regions of interest" << endl;
+}
+
+bool ProximityVehiclePolicy::shallMaterialise(const std::string& id)
+{
+    return isRelevant(id, m_activation_distance);
+}
+
+bool ProximityVehiclePolicy::shallRetain(const std::string& id)
+{
+    return m_stations.count(id) > 0 || isRelevant(id, m_deactivation_distance);
+}
+
+VehiclePolicy::Decision ProximityVehiclePolicy::addVehicle(const std::string& id)
+{
+    if (isStation(id)) {
+        EV_DEBUG << "Vehicle " << id << " departed as station" << endl;
+        m_stations.insert(id);
+        // anchors move along with new station right now
+        m_station_positions_time = -1.0;
+        return Decision::Continue;
+    } else {
+        return ShadowVehiclePolicy::addVehicle(id);
+    }
+}
+
+VehiclePolicy::Decision ProximityVehiclePolicy::removeVehicle(const std::string& id)
+{
+    m_hints.erase(id);
+    if (m_stations.erase(id) > 0) {
+        m_station_positions_time = -1.0;
+    }
+    return ShadowVehiclePolicy::removeVehicle(id);
+}
+
+bool ProximityVehiclePolicy::isStation(const std::string& id) const
+{
+    if (m_station_types.empty()) {
+        return false;
+    }
+
+    // vehicle type is a static variable, i.e. it has been fetched along with the subscription
+    const std::string& type = m_subscriptions->getVehicleCache(id)->get<libsumo::VAR_TYPE>();
+    return m_station_types.count(type) > 0;
+}
+
+void ProximityVehiclePolicy::updateStationPositions()
+{
+    // stations are looked up once per step
+    if (m_station_positions_time == simTime()) {
+        return;
+    }
+
+    const VehicleStateTable& states = m_subscriptions->getVehicleStateTable();
+    m_station_positions.clear();
+    for (const std::string& station : m_stations) {
+        const auto index = states.find(station);
+        if (index != VehicleStateTable::npos) {
+            m_station_positions.push_back(states.position(index));
+        }
+    }
+    m_station_positions_time = simTime();
+}
+
+bool ProximityVehiclePolicy::isRelevant(const std::string& id, double distance)
+{
+    const VehicleStateTable& states = m_subscriptions->getVehicleStateTable();
+    const auto index = states.find(id);
+    if (index == VehicleStateTable::npos) {
+        // vehicle without subscription results is not relevant
+        return false;
+    }
+
+    const double x = states.x(index);
+    const double y = states.y(index);
+    const double squared_distance = distance * distance;
+    auto is_near = [x, y, squared_distance](const TraCIPosition& anchor) {
+        const double dx = anchor.x - x;
+        const double dy = anchor.y - y;
+        return dx * dx + dy * dy <= squared_distance;
+    };
+    if (std::any_of(m_anchors.begin(), m_anchors.end(), is_near)) {
+        return true;
+    }
+
+    updateStationPositions();
+    if (std::any_of(m_station_positions.begin(), m_station_positions.end(), is_near)) {
+        return true;
+    }
+
+    if (m_regions.empty()) {
+        return false;
+    }
+    auto hint = m_hints.emplace(id, RegionsOfInterest::no_hint).first;
+    return m_regions.cover(states.position(index), hint->second);
+}
+
+} // namespace traci
@@ -0,0 +1,59 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef TRACI_PROXIMITYVEHICLEPOLICY_H_R5ZQ2WKM
+#define TRACI_PROXIMITYVEHICLEPOLICY_H_R5ZQ2WKM
+
+#include "traci/Position.h"
+#include "traci/RegionsOfInterest.h"
+#include "traci/ShadowVehiclePolicy.h"
+#include <omnetpp/simtime.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace traci
+{
+
+/**
+ * ProximityVehiclePolicy instantiates vehicle nodes only while they are relevant.
+ *
+ * A vehicle is relevant as long as it is close to any anchor (e.g. a road side unit)
+ * or within a region of interest. Vehicles of station types are equipped stations:
+ * they always get a node and act as anchors moving along with them. Irrelevant vehicles are kept as shadows: they are
+ * still tracked by the SubscriptionManager, but no node module exists for them.
+ * Nodes are materialised when their vehicle comes within activation distance and
+ * torn down again when it moves further away than the deactivation distance.
+ */
+class ProximityVehiclePolicy : public ShadowVehiclePolicy
+{
+public:
+    Decision addVehicle(const std::string& id) override;
+    Decision removeVehicle(const std::string& id) override;
+
+protected:
+    void initializePolicy(BasicNodeManager&) override;
+    bool shallMaterialise(const std::string& id) override;
+    bool shallRetain(const std::string& id) override;
+
+private:
+    bool isRelevant(const std::string& id, double distance);
+    bool isStation(const std::string& id) const;
+    void updateStationPositions();
+
+    RegionsOfInterest m_regions;
+    std::vector<TraCIPosition> m_anchors;
+    std::unordered_set<std::string> m_station_types;
+    std::unordered_set<std::string> m_stations;
+    std::vector<TraCIPosition> m_station_positions;
+    omnetpp::SimTime m_station_positions_time = -1.0;
+    double m_activation_distance = 0.0;
+    double m_deactivation_distance = 0.0;
+    std::unordered_map<std::string, RegionsOfInterest::Hint> m_hints;
+};
+
+} // namespace traci
+
+#endif /* TRACI_PROXIMITYVEHICLEPOLICY_H_R5ZQ2WKM */
@@ -32,6 +32,7 @@ void RegionsOfInterest::initialize(const omnetpp::cXMLElement& regions, const Bo
         boost::geometry::correct(poly);
 
         if (boost::geometry::within(poly, boundary_region)) {
+            m_rtree.insert(RtreeValue { boost::geometry::return_envelope<Box>(poly), m_regions.size() });
             m_regions.emplace_back(std::move(poly));
         } else {
             EV_STATICCONTEXT
@@ -42,12 +43,26 @@ void RegionsOfInterest::initialize(const omnetpp::cXMLElement& regions, const Bo
 
 bool RegionsOfInterest::cover(const TraCIPosition& pos) const
 {
-    for (const auto& region : m_regions) {
-        if (boost::geometry::within(pos, region)) {
+    Hint hint = no_hint;
+    return cover(pos, hint);
+}
+
+bool RegionsOfInterest::cover(const TraCIPosition& pos, Hint& hint) const
+{
+    if (hint < m_regions.size() && boost::geometry::within(pos, m_regions[hint])) {
+        return true;
+    }
+
+    // only regions whose envelope contains the position are candidates
+    const Point point { pos.x, pos.y };
+    for (auto it = m_rtree.qbegin(boost::geometry::index::intersects(point)); it != m_rtree.qend(); ++it) {
+        if (it->second != hint && boost::geometry::within(pos, m_regions[it->second])) {
+            hint = it->second;
             return true;
         }
     }
 
+    hint = no_hint;
     return false;
 }
 
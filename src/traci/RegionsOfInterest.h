@@ -9,10 +9,15 @@
 
 #include "traci/Boundary.h"
 #include "traci/Position.h"
+#include <boost/geometry/geometries/box.hpp>
 #include <boost/geometry/geometries/point_xy.hpp>
 #include <boost/geometry/geometries/polygon.hpp>
+#include <boost/geometry/index/rtree.hpp>
 #include <omnetpp/cxmlelement.h>
-#include <list>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
 
 namespace traci
 {
@@ -23,14 +28,35 @@ public:
     using Point = boost::geometry::model::d2::point_xy<double>;
     using Region = boost::geometry::model::polygon<Point>;
 
+    /**
+     * Hint remembers the region which covered a position most recently.
+     * Objects moving within the same region are then checked in constant time.
+     */
+    using Hint = std::size_t;
+    static constexpr Hint no_hint = std::numeric_limits<Hint>::max();
+
     RegionsOfInterest() = default;
     void initialize(const omnetpp::cXMLElement&, const Boundary&);
     bool cover(const TraCIPosition&) const;
+
+    /**
+     * Check if any region covers position, try hinted region first
+     * \param pos position to check
+     * \param hint region hint, updated to covering region (or no_hint)
+     * \return true if position is covered
+     */
+    bool cover(const TraCIPosition& pos, Hint& hint) const;
+
     std::size_t size() const { return m_regions.size(); }
     bool empty() const { return m_regions.empty(); }
 
 private:
-    std::list<Region> m_regions;
+    using Box = boost::geometry::model::box<Point>;
+    using RtreeValue = std::pair<Box, Hint>;
+    using Rtree = boost::geometry::index::rtree<RtreeValue, boost::geometry::index::rstar<16>>;
+
+    std::vector<Region> m_regions;
+    Rtree m_rtree;
 
     static Region buildRegion(const Boundary&);
 };
@@ -0,0 +1,93 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "traci/ShadowVehiclePolicy.h"
+#include "traci/BasicNodeManager.h"
+#include "traci/VehicleLifecycle.h"
+#include <cassert>
+
+using namespace omnetpp;
+
+namespace traci
+{
+
+void ShadowVehiclePolicy::initialize(VehicleLifecycle* lifecycle)
+{
+    BasicNodeManager* manager = dynamic_cast<BasicNodeManager*>(getParentModule());
+    if (!manager) {
+        throw cRuntimeError("Missing traci::BasicNodeManager as parent module");
+    }
+
+    m_lifecycle = lifecycle;
+    m_subscriptions = manager->getSubscriptions();
+    initializePolicy(*manager);
+    manager->subscribe(BasicNodeManager::updateNodeSignal, this);
+}
+
+void ShadowVehiclePolicy::receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t signal, unsigned long n, omnetpp::cObject*)
+{
+    if (signal == BasicNodeManager::updateNodeSignal) {
+        activateShadows();
+    }
+}
+
+VehiclePolicy::Decision ShadowVehiclePolicy::addVehicle(const std::string& id)
+{
+    assert(m_subscriptions);
+
+    if (shallMaterialise(id)) {
+        materialised(id);
+        return Decision::Continue;
+    } else {
+        EV_DEBUG << "Vehicle " << id << " departed as shadow" << endl;
+        m_shadows.insert(id);
+        return Decision::Discard;
+    }
+}
+
+VehiclePolicy::Decision ShadowVehiclePolicy::updateVehicle(const std::string& id)
+{
+    assert(m_subscriptions);
+    assert(m_lifecycle);
+
+    if (shallRetain(id)) {
+        return Decision::Continue;
+    } else {
+        EV_DEBUG << "Vehicle " << id << " is torn down to shadow: no longer relevant" << endl;
+        m_lifecycle->removeVehicle(id);
+        m_shadows.insert(id);
+        return Decision::Discard;
+    }
+}
+
+VehiclePolicy::Decision ShadowVehiclePolicy::removeVehicle(const std::string& id)
+{
+    auto found = m_shadows.find(id);
+    if (found == m_shadows.end()) {
+        return Decision::Continue;
+    } else {
+        m_shadows.erase(found);
+        return Decision::Discard;
+    }
+}
+
+void ShadowVehiclePolicy::activateShadows()
+{
+    assert(m_subscriptions);
+    assert(m_lifecycle);
+
+    for (auto it = m_shadows.begin(); it != m_shadows.end();) {
+        if (shallMaterialise(*it)) {
+            EV_DEBUG << "Vehicle " << *it << " is materialised: became relevant" << endl;
+            materialised(*it);
+            m_lifecycle->addVehicle(*it);
+            it = m_shadows.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+} // namespace traci
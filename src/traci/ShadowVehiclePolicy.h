@@ -0,0 +1,72 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef TRACI_SHADOWVEHICLEPOLICY_H_P3HV7NTE
+#define TRACI_SHADOWVEHICLEPOLICY_H_P3HV7NTE
+
+#include "traci/VehiclePolicy.h"
+#include <omnetpp/clistener.h>
+#include <unordered_set>
+
+namespace traci
+{
+
+class BasicNodeManager;
+class SubscriptionManager;
+
+/**
+ * ShadowVehiclePolicy is the common base of policies keeping irrelevant vehicles as shadows.
+ *
+ * Shadows are still tracked by the SubscriptionManager, but no node module exists for them.
+ * Derived policies decide when a vehicle is relevant: its node is materialised as soon as
+ * shallMaterialise() holds and torn down again when shallRetain() does not hold anymore.
+ */
+class ShadowVehiclePolicy : public VehiclePolicy, public omnetpp::cListener
+{
+public:
+    void initialize(VehicleLifecycle*) override;
+    Decision addVehicle(const std::string& id) override;
+    Decision updateVehicle(const std::string& id) override;
+    Decision removeVehicle(const std::string& id) override;
+
+protected:
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, unsigned long n, omnetpp::cObject*) override;
+
+    /**
+     * Initialize policy specific parameters
+     * \param manager hosting node manager
+     */
+    virtual void initializePolicy(BasicNodeManager& manager) {}
+
+    /**
+     * \param id TraCI ID of a vehicle without node
+     * \return true if node shall be created for vehicle
+     */
+    virtual bool shallMaterialise(const std::string& id) = 0;
+
+    /**
+     * \param id TraCI ID of a vehicle with node
+     * \return true if node of vehicle shall be kept
+     */
+    virtual bool shallRetain(const std::string& id) = 0;
+
+    /**
+     * Vehicle departed with node or its shadow has been materialised
+     * \param id TraCI ID of vehicle
+     */
+    virtual void materialised(const std::string& id) {}
+
+    SubscriptionManager* m_subscriptions = nullptr;
+
+private:
+    void activateShadows();
+
+    VehicleLifecycle* m_lifecycle = nullptr;
+    std::unordered_set<std::string> m_shadows;
+};
+
+} // namespace traci
+
+#endif /* TRACI_SHADOWVEHICLEPOLICY_H_P3HV7NTE */
@@ -0,0 +1,83 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "traci/SpatialPartitionVehiclePolicy.h"
+#include "traci/API.h"
+#include "traci/BasicNodeManager.h"
+#include "traci/VehicleStateTable.h"
+#include <limits>
+
+using namespace omnetpp;
+
+namespace traci
+{
+
+Define_Module(SpatialPartitionVehiclePolicy)
+
+void SpatialPartitionVehiclePolicy::initializePolicy(BasicNodeManager& manager)
+{
+    const int columns = par("columns");
+    const int rows = par("rows");
+    const int partition = par("partition");
+    if (columns < 1 || rows < 1) {
+        throw cRuntimeError("Partition grid requires at least one column and row");
+    } else if (partition < 0 || partition >= columns * rows) {
+        throw cRuntimeError("Partition %d is outside of %d x %d grid", partition, columns, rows);
+    }
+
+    // partitions are numbered row by row starting at the network's lower left corner
+    Boundary boundary { manager.getAPI()->simulation.getNetBoundary() };
+    const TraCIPosition& lowerLeft = boundary.lowerLeftPosition();
+    const TraCIPosition& upperRight = boundary.upperRightPosition();
+    const double width = (upperRight.x - lowerLeft.x) / columns;
+    const double height = (upperRight.y - lowerLeft.y) / rows;
+    const int column = partition % columns;
+    const int row = partition / columns;
+    m_min_x = lowerLeft.x + column * width;
+    m_min_y = lowerLeft.y + row * height;
+    // outermost cells are unbounded, i.e. vehicles slightly off the network boundary are not lost
+    m_max_x = column + 1 < columns ? m_min_x + width : std::numeric_limits<double>::infinity();
+    m_max_y = row + 1 < rows ? m_min_y + height : std::numeric_limits<double>::infinity();
+    if (column == 0) {
+        m_min_x = -std::numeric_limits<double>::infinity();
+    }
+    if (row == 0) {
+        m_min_y = -std::numeric_limits<double>::infinity();
+    }
+
+    m_activation_margin = par("halo");
+    m_deactivation_margin = m_activation_margin + par("hysteresis").doubleValue();
+    if (m_activation_margin < 0.0 || m_deactivation_margin < m_activation_margin) {
+        throw cRuntimeError("halo and hysteresis must not be negative");
+    }
+    EV_INFO << "Vehicles are instantiated within partition " << partition << " of " << columns << " x " << rows
+        << " grid and its " << m_activation_margin << " m halo" << endl;
+}
+
+bool SpatialPartitionVehiclePolicy::shallMaterialise(const std::string& id)
+{
+    return isWithinPartition(id, m_activation_margin);
+}
+
+bool SpatialPartitionVehiclePolicy::shallRetain(const std::string& id)
+{
+    return isWithinPartition(id, m_deactivation_margin);
+}
+
+bool SpatialPartitionVehiclePolicy::isWithinPartition(const std::string& id, double margin) const
+{
+    const VehicleStateTable& states = m_subscriptions->getVehicleStateTable();
+    const auto index = states.find(id);
+    if (index == VehicleStateTable::npos) {
+        // vehicle without subscription results cannot be located
+        return false;
+    }
+
+    const double x = states.x(index);
+    const double y = states.y(index);
+    return x >= m_min_x - margin && x < m_max_x + margin && y >= m_min_y - margin && y < m_max_y + margin;
+}
+
+} // namespace traci
@@ -0,0 +1,41 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef TRACI_SPATIALPARTITIONVEHICLEPOLICY_H_C2WN8KJD
+#define TRACI_SPATIALPARTITIONVEHICLEPOLICY_H_C2WN8KJD
+
+#include "traci/ShadowVehiclePolicy.h"
+
+namespace traci
+{
+
+/**
+ * SpatialPartitionVehiclePolicy restricts vehicle nodes to one cell of a grid laid over the road network.
+ *
+ * Each cell (partition) can thus be simulated by a separate run, e.g. on its own core.
+ * Vehicles within a halo around the cell are instantiated as well, so stations near the cell's border
+ * still interact with their neighbours. Vehicles outside are kept as shadows like by ProximityVehiclePolicy.
+ */
+class SpatialPartitionVehiclePolicy : public ShadowVehiclePolicy
+{
+protected:
+    void initializePolicy(BasicNodeManager&) override;
+    bool shallMaterialise(const std::string& id) override;
+    bool shallRetain(const std::string& id) override;
+
+private:
+    bool isWithinPartition(const std::string& id, double margin) const;
+
+    double m_min_x = 0.0;
+    double m_min_y = 0.0;
+    double m_max_x = 0.0;
+    double m_max_y = 0.0;
+    double m_activation_margin = 0.0;
+    double m_deactivation_margin = 0.0;
+};
+
+} // namespace traci
+
+#endif /* TRACI_SPATIALPARTITIONVEHICLEPOLICY_H_C2WN8KJD */
@@ -0,0 +1,118 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "traci/StorageView.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+namespace traci
+{
+
+namespace
+{
+
+bool isBigEndianHost()
+{
+    const std::uint16_t probe = 0x0102;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 0x01;
+}
+
+const bool bigEndianHost = isBigEndianHost();
+
+} // namespace
+
+StorageView::StorageView(const unsigned char* data, std::size_t size) :
+    m_data(data), m_size(size), m_position(0)
+{
+}
+
+StorageView::StorageView(const std::vector<unsigned char>& buffer, std::size_t size) :
+    StorageView(buffer.data(), size)
+{
+    assert(size <= buffer.size());
+}
+
+int StorageView::readUnsignedByte()
+{
+    checkReadSafe(1);
+    return m_data[m_position++];
+}
+
+int StorageView::readByte()
+{
+    const int i = readUnsignedByte();
+    return i < 128 ? i : i - 256;
+}
+
+int StorageView::readInt()
+{
+    std::int32_t value = 0;
+    readNetworkOrder(reinterpret_cast<unsigned char*>(&value), sizeof(value));
+    return value;
+}
+
+double StorageView::readDouble()
+{
+    double value = 0.0;
+    readNetworkOrder(reinterpret_cast<unsigned char*>(&value), sizeof(value));
+    return value;
+}
+
+std::string_view StorageView::readString()
+{
+    const int length = readInt();
+    if (length < 0) {
+        throw std::invalid_argument("traci::StorageView::readString: negative string length");
+    }
+    checkReadSafe(length);
+    std::string_view view { reinterpret_cast<const char*>(m_data + m_position), static_cast<std::size_t>(length) };
+    m_position += length;
+    return view;
+}
+
+std::vector<std::string> StorageView::readStringList()
+{
+    std::vector<std::string> list;
+    const int length = readInt();
+    list.reserve(std::max(length, 0));
+    for (int i = 0; i < length; ++i) {
+        list.emplace_back(readString());
+    }
+    return list;
+}
+
+void StorageView::skip(std::size_t n)
+{
+    checkReadSafe(n);
+    m_position += n;
+}
+
+void StorageView::checkReadSafe(std::size_t n) const
+{
+    if (m_size - m_position < n) {
+        std::ostringstream msg;
+        msg << "traci::StorageView: want to read " << n << " bytes, but only " << m_size - m_position << " remaining";
+        throw std::invalid_argument(msg.str());
+    }
+}
+
+void StorageView::readNetworkOrder(unsigned char* value, std::size_t n)
+{
+    checkReadSafe(n);
+    if (bigEndianHost) {
+        std::memcpy(value, m_data + m_position, n);
+    } else {
+        std::reverse_copy(m_data + m_position, m_data + m_position + n, value);
+    }
+    m_position += n;
+}
+
+} // namespace traci
@@ -0,0 +1,59 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef TRACI_STORAGEVIEW_H_J2XDPT8C
+#define TRACI_STORAGEVIEW_H_J2XDPT8C
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace traci
+{
+
+/**
+ * StorageView decodes a TraCI message in place.
+ *
+ * Unlike tcpip::Storage, it neither owns nor copies the underlying bytes.
+ * Strings are returned as views into the message buffer, thus they are only
+ * valid as long as this buffer is not modified by receiving the next message.
+ * Read operations throw std::invalid_argument when exceeding the message.
+ */
+class StorageView
+{
+public:
+    StorageView(const unsigned char* data, std::size_t size);
+    StorageView(const std::vector<unsigned char>& buffer, std::size_t size);
+
+    bool valid_pos() const { return m_position < m_size; }
+    std::size_t position() const { return m_position; }
+    std::size_t size() const { return m_size; }
+
+    int readUnsignedByte();
+    int readByte();
+    int readInt();
+    double readDouble();
+    std::string_view readString();
+    std::vector<std::string> readStringList();
+
+    /**
+     * Skip given number of bytes
+     * \param n number of bytes
+     */
+    void skip(std::size_t n);
+
+private:
+    void checkReadSafe(std::size_t n) const;
+    void readNetworkOrder(unsigned char* value, std::size_t n);
+
+    const unsigned char* m_data;
+    std::size_t m_size;
+    std::size_t m_position;
+};
+
+} // namespace traci
+
+#endif /* TRACI_STORAGEVIEW_H_J2XDPT8C */
@@ -20,6 +20,8 @@ namespace traci
 class PersonCache;
 class SimulationCache;
 class VehicleCache;
+class VehicleTypeCache;
+class VehicleStateTable;
 
 class SubscriptionManager
 {
@@ -29,12 +31,49 @@ public:
     virtual void subscribePersonVariables(const std::set<int>& personVariables) = 0;
     virtual void subscribeVehicleVariables(const std::set<int>& vehicleVariables) = 0;
     virtual void subscribeSimulationVariables(const std::set<int>& simulationVariables) = 0;
+
+    /**
+     * Subscribe vehicle variables only for vehicles of a particular class (see setVehicleClass).
+     * Vehicles of a class are subscribed to its variables in addition to those of subscribeVehicleVariables.
+     * Managers without vehicle classes subscribe these variables for all vehicles.
+     */
+    virtual void subscribeVehicleClassVariables(const std::string& vehicleClass, const std::set<int>& vehicleVariables)
+    {
+        subscribeVehicleVariables(vehicleVariables);
+    }
+
+    /**
+     * Assign a subscribed vehicle to a class, e.g. the node type it got mapped to.
+     * Vehicles belong to the default class (empty string) until assigned.
+     * Subscriptions of re-assigned vehicles may be updated with the next step.
+     */
+    virtual void setVehicleClass(const std::string& vehicle, const std::string& vehicleClass) {}
+
+    /**
+     * Retrieve vehicle variables once when a vehicle is subscribed.
+     * These variables are supposed to stay constant during a vehicle's lifetime.
+     * Their values are retrieved in one batch for all vehicles subscribed in the same step.
+     */
+    virtual void subscribeStaticVehicleVariables(const std::set<int>& vehicleVariables) = 0;
+
+    /**
+     * Retrieve vehicle type variables once when a vehicle type is encountered first.
+     */
+    virtual void subscribeStaticVehicleTypeVariables(const std::set<int>& typeVariables) = 0;
+
     virtual const std::unordered_set<std::string>& getSubscribedPersons() const = 0;
     virtual const std::unordered_set<std::string>& getSubscribedVehicles() const = 0;
     virtual const std::unordered_map<std::string, std::shared_ptr<VehicleCache>>& getAllVehicleCaches() const = 0;
     virtual std::shared_ptr<PersonCache> getPersonCache(const std::string& id) = 0;
     virtual std::shared_ptr<VehicleCache> getVehicleCache(const std::string& id) = 0;
+    virtual std::shared_ptr<VehicleTypeCache> getVehicleTypeCache(const std::string& id) = 0;
     virtual std::shared_ptr<SimulationCache> getSimulationCache() = 0;
+
+    /**
+     * Kinematic state of all subscribed vehicles in current step
+     * \return table rebuilt by last step()
+     */
+    virtual const VehicleStateTable& getVehicleStateTable() const = 0;
 };
 
 } // namespace traci
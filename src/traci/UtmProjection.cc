@@ -0,0 +1,133 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "traci/UtmProjection.h"
+#include <algorithm>
+#include <cmath>
+
+namespace traci
+{
+
+namespace
+{
+
+// WGS84 ellipsoid and UTM scale
+const double a = 6378137.0;
+const double f = 1.0 / 298.257223563;
+const double k0 = 0.9996;
+const double falseEasting = 500000.0;
+const double toRadian = M_PI / 180.0;
+
+// Krüger series (third order is accurate to a millimetre within UTM zones)
+struct Series
+{
+    Series()
+    {
+        const double n = f / (2.0 - f);
+        const double n2 = n * n;
+        const double n3 = n2 * n;
+        A = a / (1.0 + n) * (1.0 + n2 / 4.0 + n2 * n2 / 64.0);
+        alpha[0] = n / 2.0 - 2.0 * n2 / 3.0 + 5.0 * n3 / 16.0;
+        alpha[1] = 13.0 * n2 / 48.0 - 3.0 * n3 / 5.0;
+        alpha[2] = 61.0 * n3 / 240.0;
+        beta[0] = n / 2.0 - 2.0 * n2 / 3.0 + 37.0 * n3 / 96.0;
+        beta[1] = n2 / 48.0 + n3 / 15.0;
+        beta[2] = 17.0 * n3 / 480.0;
+        delta[0] = 2.0 * n - 2.0 * n2 / 3.0 - 2.0 * n3;
+        delta[1] = 7.0 * n2 / 3.0 - 8.0 * n3 / 5.0;
+        delta[2] = 56.0 * n3 / 15.0;
+        conformal = 2.0 * std::sqrt(n) / (1.0 + n);
+    }
+
+    double A;
+    double alpha[3];
+    double beta[3];
+    double delta[3];
+    double conformal;
+};
+
+const Series& series()
+{
+    static const Series s;
+    return s;
+}
+
+} // namespace
+
+UtmProjection::UtmProjection(int zone, const TraCIPosition& offset) :
+    m_zone(zone), m_offset(offset)
+{
+}
+
+double UtmProjection::centralMeridian(int zone)
+{
+    return -183.0 + 6.0 * zone;
+}
+
+int UtmProjection::zone(double longitude)
+{
+    const int zone = static_cast<int>(std::floor((longitude + 180.0) / 6.0)) + 1;
+    return std::min(std::max(zone, 1), 60);
+}
+
+TraCIPosition UtmProjection::forward(int zone, const TraCIGeoPosition& geo)
+{
+    const Series& s = series();
+    const double phi = geo.latitude * toRadian;
+    const double lambda = (geo.longitude - centralMeridian(zone)) * toRadian;
+
+    const double sin_phi = std::sin(phi);
+    const double t = std::sinh(std::atanh(sin_phi) - s.conformal * std::atanh(s.conformal * sin_phi));
+    const double xi_prime = std::atan2(t, std::cos(lambda));
+    const double eta_prime = std::atanh(std::sin(lambda) / std::sqrt(1.0 + t * t));
+
+    double xi = xi_prime;
+    double eta = eta_prime;
+    for (int j = 1; j <= 3; ++j) {
+        xi += s.alpha[j - 1] * std::sin(2.0 * j * xi_prime) * std::cosh(2.0 * j * eta_prime);
+        eta += s.alpha[j - 1] * std::cos(2.0 * j * xi_prime) * std::sinh(2.0 * j * eta_prime);
+    }
+
+    TraCIPosition utm;
+    utm.x = falseEasting + k0 * s.A * eta;
+    utm.y = k0 * s.A * xi;
+    utm.z = 0.0;
+    return utm;
+}
+
+TraCIGeoPosition UtmProjection::toGeo(const TraCIPosition& pos) const
+{
+    const Series& s = series();
+    const double xi = (pos.y - m_offset.y) / (k0 * s.A);
+    const double eta = (pos.x - m_offset.x - falseEasting) / (k0 * s.A);
+
+    double xi_prime = xi;
+    double eta_prime = eta;
+    for (int j = 1; j <= 3; ++j) {
+        xi_prime -= s.beta[j - 1] * std::sin(2.0 * j * xi) * std::cosh(2.0 * j * eta);
+        eta_prime -= s.beta[j - 1] * std::cos(2.0 * j * xi) * std::sinh(2.0 * j * eta);
+    }
+
+    const double chi = std::asin(std::sin(xi_prime) / std::cosh(eta_prime));
+    double phi = chi;
+    for (int j = 1; j <= 3; ++j) {
+        phi += s.delta[j - 1] * std::sin(2.0 * j * chi);
+    }
+
+    TraCIGeoPosition geo;
+    geo.latitude = phi / toRadian;
+    geo.longitude = centralMeridian(m_zone) + std::atan2(std::sinh(eta_prime), std::cos(xi_prime)) / toRadian;
+    return geo;
+}
+
+TraCIPosition UtmProjection::fromGeo(const TraCIGeoPosition& geo) const
+{
+    TraCIPosition pos = forward(m_zone, geo);
+    pos.x += m_offset.x;
+    pos.y += m_offset.y;
+    return pos;
+}
+
+} // namespace traci
@@ -0,0 +1,60 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef TRACI_UTMPROJECTION_H_R7WQ2N5D
+#define TRACI_UTMPROJECTION_H_R7WQ2N5D
+
+#include "traci/GeoPosition.h"
+#include "traci/Position.h"
+
+namespace traci
+{
+
+/**
+ * UtmProjection converts between SUMO's network coordinates and WGS84 locally
+ *
+ * SUMO networks imported from OpenStreetMap usually use a UTM projection
+ * with the network coordinates shifted by a constant offset.
+ * Offsets cover false easting and northing as well.
+ */
+class UtmProjection
+{
+public:
+    /**
+     * \param zone UTM zone number [1, 60]
+     * \param offset network position minus UTM coordinate
+     */
+    UtmProjection(int zone, const TraCIPosition& offset);
+
+    /**
+     * Longitude of central meridian of UTM zone
+     * \param zone UTM zone number
+     * \return longitude in degrees
+     */
+    static double centralMeridian(int zone);
+
+    /**
+     * UTM zone covering a longitude
+     * \param longitude in degrees
+     * \return zone number
+     */
+    static int zone(double longitude);
+
+    /**
+     * Plain UTM easting and northing (false easting 500 km, no false northing)
+     */
+    static TraCIPosition forward(int zone, const TraCIGeoPosition&);
+
+    TraCIGeoPosition toGeo(const TraCIPosition&) const;
+    TraCIPosition fromGeo(const TraCIGeoPosition&) const;
+
+private:
+    int m_zone;
+    TraCIPosition m_offset;
+};
+
+} // namespace traci
+
+#endif /* TRACI_UTMPROJECTION_H_R7WQ2N5D */
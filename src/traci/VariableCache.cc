@@ -19,6 +19,13 @@ void VariableCache::reset(const libsumo::TraCIResults& values)
     m_values = values;
 }
 
+void VariableCache::preserve(const libsumo::TraCIResults& values)
+{
+    for (const auto& value : values) {
+        m_static_values[value.first] = value.second;
+    }
+}
+
 SimulationCache::SimulationCache(std::shared_ptr<API> api) :
     VariableCache(api, libsumo::CMD_GET_SIM_VARIABLE, "")
 {
@@ -29,11 +36,29 @@ PersonCache::PersonCache(std::shared_ptr<API> api, const std::string& personID)
 {
 }
 
+VehicleTypeCache::VehicleTypeCache(std::shared_ptr<API> api, const std::string& typeID) :
+    VariableCache(api, libsumo::CMD_GET_VEHICLETYPE_VARIABLE, typeID)
+{
+}
+
 VehicleCache::VehicleCache(std::shared_ptr<API> api, const std::string& vehicleID) :
     VariableCache(api, libsumo::CMD_GET_VEHICLE_VARIABLE, vehicleID)
 {
 }
 
+std::shared_ptr<VehicleTypeCache> VehicleCache::getTypeCache()
+{
+    if (!m_type_cache) {
+        m_type_cache = std::make_shared<VehicleTypeCache>(getAPI(), get<libsumo::VAR_TYPE>());
+    }
+    return m_type_cache;
+}
+
+void VehicleCache::setTypeCache(std::shared_ptr<VehicleTypeCache> cache)
+{
+    m_type_cache = std::move(cache);
+}
+
 template<>
 double VariableCache::retrieve<double>(int var)
 {
@@ -36,9 +36,12 @@ public:
 
         auto found = m_values.find(VAR);
         if (found == m_values.end()) {
-            value_type value = retrieve<value_type>(VAR);
-            auto result = std::make_shared<result_type>(make_value(std::move(value)));
-            std::tie(found, std::ignore) = m_values.emplace(VAR, std::move(result));
+            found = m_static_values.find(VAR);
+            if (found == m_static_values.end()) {
+                value_type value = retrieve<value_type>(VAR);
+                auto result = std::make_shared<result_type>(make_value(std::move(value)));
+                std::tie(found, std::ignore) = m_values.emplace(VAR, std::move(result));
+            }
         }
 
         return std::dynamic_pointer_cast<result_type>(found->second);
@@ -66,9 +69,18 @@ public:
      */
     void reset(const libsumo::TraCIResults& values);
 
+    /**
+     * Store values which are not dropped by reset, e.g. constant vehicle attributes.
+     * Values passed to reset take precedence over these values.
+     * \param values additional values to be stored
+     */
+    void preserve(const libsumo::TraCIResults& values);
+
 protected:
     VariableCache(std::shared_ptr<API> api, int command, const std::string& id);
 
+    const std::shared_ptr<API>& getAPI() const { return m_api; }
+
     template<typename T>
     T retrieve(int var);
 
@@ -76,6 +88,7 @@ private:
     std::shared_ptr<API> m_api;
     const std::string m_id;
     libsumo::TraCIResults m_values;
+    libsumo::TraCIResults m_static_values;
 };
 
 class PersonCache : public VariableCache
@@ -85,11 +98,35 @@ public:
     const std::string& getPersonId() const { return getId(); }
 };
 
+class VehicleTypeCache : public VariableCache
+{
+public:
+    VehicleTypeCache(std::shared_ptr<API> api, const std::string& typeID);
+    const std::string& getTypeId() const { return getId(); }
+};
+
 class VehicleCache : public VariableCache
 {
 public:
     VehicleCache(std::shared_ptr<API> api, const std::string& vehicleID);
     const std::string& getVehicleId() const { return getId(); }
+
+    /**
+     * Get cache of this vehicle's type.
+     * If no type cache has been assigned, a type cache is created for this vehicle only.
+     *
+     * \return cache of vehicle type
+     */
+    std::shared_ptr<VehicleTypeCache> getTypeCache();
+
+    /**
+     * Assign type cache, usually shared by all vehicles of the same type
+     * \param cache cache of this vehicle's type
+     */
+    void setTypeCache(std::shared_ptr<VehicleTypeCache> cache);
+
+private:
+    std::shared_ptr<VehicleTypeCache> m_type_cache;
 };
 
 class SimulationCache : public VariableCache
@@ -46,9 +46,13 @@ VAR_TRAIT(libsumo::VAR_VEHICLECLASS, std::string)
 VAR_TRAIT(libsumo::VAR_VEHICLE, std::string)
 VAR_TRAIT(libsumo::VAR_LENGTH, double)
 VAR_TRAIT(libsumo::VAR_WIDTH, double)
+VAR_TRAIT(libsumo::VAR_HEIGHT, double)
+VAR_TRAIT(libsumo::VAR_ACCEL, double)
+VAR_TRAIT(libsumo::VAR_DECEL, double)
 VAR_TRAIT(libsumo::VAR_ARRIVED_VEHICLES_IDS, std::vector<std::string>)
 VAR_TRAIT(libsumo::VAR_DEPARTED_VEHICLES_IDS, std::vector<std::string>)
 VAR_TRAIT(libsumo::VAR_DELTA_T, double)
+VAR_TRAIT(libsumo::VAR_MIN_EXPECTED_VEHICLES, int)
 VAR_TRAIT(libsumo::VAR_TELEPORT_STARTING_VEHICLES_IDS, std::vector<std::string>)
 VAR_TRAIT(libsumo::VAR_TIME, double)
 VAR_TRAIT(libsumo::VAR_TIME_STEP, int)
@@ -16,6 +16,22 @@ public:
     virtual void initializeSink(std::shared_ptr<API>, std::shared_ptr<VehicleCache>, const Boundary&) = 0;
     virtual void initializeVehicle(const TraCIPosition&, TraCIAngle, double speed) = 0;
     virtual void updateVehicle(const TraCIPosition&, TraCIAngle, double speed) = 0;
+
+    /**
+     * Prepare an update without any OMNeT++ visible side effects.
+     *
+     * Sinks may be prepared concurrently, thus implementations must only touch their own state
+     * and shall not throw. Prepared updates are applied by commitVehicle in sequence afterwards.
+     *
+     * \return false if the sink does not support prepared updates (updateVehicle is used instead)
+     */
+    virtual bool prepareVehicle(const TraCIPosition&, TraCIAngle, double speed) { return false; }
+
+    /**
+     * Apply update prepared by prepareVehicle
+     */
+    virtual void commitVehicle() {}
+
     virtual ~VehicleSink() = default;
 };
 
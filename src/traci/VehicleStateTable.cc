@@ -0,0 +1,129 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#include "traci/VehicleStateTable.h"
+#include "traci/sumo/libsumo/TraCIConstants.h"
+
+namespace traci
+{
+
+namespace
+{
+
+const libsumo::TraCIResult* lookup(const libsumo::TraCIResults& results, int var)
+{
+    auto found = results.find(var);
+    return found != results.end() ? found->second.get() : nullptr;
+}
+
+double lookupDouble(const libsumo::TraCIResults& results, int var)
+{
+    // subscription results are decoded by data type, static_cast is safe for TYPE_DOUBLE variables
+    const libsumo::TraCIResult* result = lookup(results, var);
+    return result ? static_cast<const libsumo::TraCIDouble*>(result)->value : libsumo::INVALID_DOUBLE_VALUE;
+}
+
+} // namespace
+
+void VehicleStateTable::clear()
+{
+    m_ids.clear();
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+    m_angle.clear();
+    m_speed.clear();
+    m_step.clear();
+    m_index.clear();
+    m_incomplete = 0;
+}
+
+void VehicleStateTable::beginStep()
+{
+    ++m_current_step;
+    m_incomplete = 0;
+}
+
+VehicleStateTable::Index VehicleStateTable::update(const std::string& id, const libsumo::TraCIResults& results)
+{
+    const libsumo::TraCIResult* position = lookup(results, libsumo::VAR_POSITION);
+    const libsumo::TraCIResult* angle = lookup(results, libsumo::VAR_ANGLE);
+    if (!position || !angle) {
+        // a stale row of this vehicle is dropped by endStep
+        ++m_incomplete;
+        return npos;
+    }
+
+    Index index = find(id);
+    if (index == npos) {
+        index = m_ids.size();
+        m_ids.push_back(id);
+        m_x.push_back(0.0);
+        m_y.push_back(0.0);
+        m_z.push_back(0.0);
+        m_angle.push_back(0.0);
+        m_speed.push_back(0.0);
+        m_step.push_back(0);
+        m_index.emplace(id, index);
+    }
+
+    const auto* pos = static_cast<const libsumo::TraCIPosition*>(position);
+    m_x[index] = pos->x;
+    m_y[index] = pos->y;
+    m_z[index] = pos->z;
+    m_angle[index] = static_cast<const libsumo::TraCIDouble*>(angle)->value;
+    m_speed[index] = lookupDouble(results, libsumo::VAR_SPEED);
+    m_step[index] = m_current_step;
+    return index;
+}
+
+std::size_t VehicleStateTable::endStep()
+{
+    for (Index index = m_ids.size(); index > 0; --index) {
+        const Index row = index - 1;
+        if (m_step[row] == m_current_step) {
+            continue;
+        }
+
+        // fill gap with last row, identifiers are moved rather than copied
+        m_index.erase(m_ids[row]);
+        const Index last = m_ids.size() - 1;
+        if (row != last) {
+            m_ids[row] = std::move(m_ids[last]);
+            m_x[row] = m_x[last];
+            m_y[row] = m_y[last];
+            m_z[row] = m_z[last];
+            m_angle[row] = m_angle[last];
+            m_speed[row] = m_speed[last];
+            m_step[row] = m_step[last];
+            m_index[m_ids[row]] = row;
+        }
+        m_ids.pop_back();
+        m_x.pop_back();
+        m_y.pop_back();
+        m_z.pop_back();
+        m_angle.pop_back();
+        m_speed.pop_back();
+        m_step.pop_back();
+    }
+    return m_incomplete;
+}
+
+VehicleStateTable::Index VehicleStateTable::find(const std::string& id) const
+{
+    auto found = m_index.find(id);
+    return found != m_index.end() ? found->second : npos;
+}
+
+TraCIPosition VehicleStateTable::position(Index i) const
+{
+    TraCIPosition pos;
+    pos.x = m_x[i];
+    pos.y = m_y[i];
+    pos.z = m_z[i];
+    return pos;
+}
+
+} // namespace traci
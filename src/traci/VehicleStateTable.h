@@ -0,0 +1,107 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef TRACI_VEHICLESTATETABLE_H_UE3WQ7NB
+#define TRACI_VEHICLESTATETABLE_H_UE3WQ7NB
+
+#include "traci/Angle.h"
+#include "traci/Position.h"
+#include "traci/sumo/libsumo/TraCIDefs.h"
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace traci
+{
+
+/**
+ * VehicleStateTable stores the kinematic state of all subscribed vehicles
+ * of the current TraCI step in a struct-of-arrays layout.
+ *
+ * The table is updated once per step by the SubscriptionManager. Rows are kept across steps,
+ * i.e. a vehicle's identifier is only copied when it enters the table. Consumers
+ * can iterate all vehicles by dense index or look up a vehicle's index once
+ * and access its columns without any map lookups or result casts.
+ * Indices are only valid until the next step.
+ *
+ * Vehicles lacking position or angle results are not part of the table, find() reports npos for them.
+ * Speed is optional (see subscribeUnequippedSpeed of BasicNodeManager) and INVALID_DOUBLE_VALUE if missing.
+ */
+class VehicleStateTable
+{
+public:
+    using Index = std::size_t;
+    static constexpr Index npos = std::numeric_limits<Index>::max();
+
+    /**
+     * Drop all rows, capacity is retained
+     */
+    void clear();
+
+    /**
+     * Start a new step: rows not updated until endStep() are dropped
+     */
+    void beginStep();
+
+    /**
+     * Update (or add) row of given vehicle from its subscription results
+     * \param id vehicle identifier
+     * \param results subscribed variables of this vehicle
+     * \return index of updated row, npos if results lack position or angle
+     */
+    Index update(const std::string& id, const libsumo::TraCIResults& results);
+
+    /**
+     * Drop rows of vehicles not updated since beginStep()
+     * \return number of vehicles which have been updated without pose since beginStep()
+     */
+    std::size_t endStep();
+
+    /**
+     * Look up row index of a vehicle
+     * \param id vehicle identifier
+     * \return row index or npos if vehicle is not present in this step
+     */
+    Index find(const std::string& id) const;
+
+    std::size_t size() const { return m_ids.size(); }
+    bool empty() const { return m_ids.empty(); }
+
+    const std::string& id(Index i) const { return m_ids[i]; }
+    double x(Index i) const { return m_x[i]; }
+    double y(Index i) const { return m_y[i]; }
+    double z(Index i) const { return m_z[i]; }
+    double angle(Index i) const { return m_angle[i]; }
+    double speed(Index i) const { return m_speed[i]; }
+
+    TraCIPosition position(Index i) const;
+    TraCIAngle heading(Index i) const { return TraCIAngle { m_angle[i] }; }
+
+    // column access for bulk processing
+    const std::vector<std::string>& ids() const { return m_ids; }
+    const std::vector<double>& xs() const { return m_x; }
+    const std::vector<double>& ys() const { return m_y; }
+    const std::vector<double>& zs() const { return m_z; }
+    const std::vector<double>& angles() const { return m_angle; }
+    const std::vector<double>& speeds() const { return m_speed; }
+
+private:
+    std::vector<std::string> m_ids;
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    std::vector<double> m_z;
+    std::vector<double> m_angle;
+    std::vector<double> m_speed;
+    std::vector<unsigned> m_step; /*< step of last update per row */
+    std::unordered_map<std::string, Index> m_index;
+    unsigned m_current_step = 0;
+    std::size_t m_incomplete = 0;
+};
+
+} // namespace traci
+
+#endif /* TRACI_VEHICLESTATETABLE_H_UE3WQ7NB */
@@ -0,0 +1,34 @@
+/*
+ * Artery V2X Simulation Framework
+ * Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+ */
+
+#ifndef TRACI_VEHICLEVARIABLECONSUMER_H_F9KQ2ZRD
+#define TRACI_VEHICLEVARIABLECONSUMER_H_F9KQ2ZRD
+
+#include <set>
+
+namespace traci
+{
+
+/**
+ * VehicleVariableConsumer is implemented by modules of a vehicle's node reading its VehicleCache.
+ *
+ * BasicNodeManager collects the variables of all consumers in a node when the first node of a NED type
+ * is created. These variables are subscribed for vehicles mapped to that node type only, in addition to
+ * those subscribed for all vehicles. Nodes of the same type are supposed to consume the same variables.
+ */
+class VehicleVariableConsumer
+{
+public:
+    virtual ~VehicleVariableConsumer() = default;
+
+    /**
+     * Vehicle variables read by this module, e.g. libsumo::VAR_SPEED
+     */
+    virtual std::set<int> getConsumedVehicleVariables() const = 0;
+};
+
+} // namespace traci
+
+#endif /* TRACI_VEHICLEVARIABLECONSUMER_H_F9KQ2ZRD */
@@ -23,6 +23,7 @@
 	#include <netinet/tcp.h>
 	#include <arpa/inet.h>
 	#include <netdb.h>
+	#include <sys/un.h>
 	#include <errno.h>
 	#include <fcntl.h>
 	#include <unistd.h>
@@ -73,6 +74,7 @@ namespace tcpip
 		Socket(std::string host, int port) 
 		: host_( host ),
 		port_( port ),
+		unix_bound_(false),
 		socket_(-1),
 		server_socket_(-1),
 		blocking_(true),
@@ -86,6 +88,7 @@ namespace tcpip
 		Socket(int port) 
 		: host_(""),
 		port_( port ),
+		unix_bound_(false),
 		socket_(-1),
 		server_socket_(-1),
 		blocking_(true),
@@ -162,6 +165,10 @@ namespace tcpip
 #endif
 			server_socket_ = -1;
 		}
+#ifndef WIN32
+		if( unix_bound_ )
+			::unlink( unix_path_.c_str() );
+#endif
 
 #ifdef WIN32
 		if( server_socket_ == -1 && socket_ == -1 
@@ -254,6 +261,21 @@ namespace tcpip
 	}
 
 
+	// ----------------------------------------------------------------------
+	void
+		Socket::
+		set_unix_path(const std::string& path)
+	{
+#ifdef WIN32
+		throw SocketException("tcpip::Socket::set_unix_path() Unix-domain sockets are not supported");
+#else
+		sockaddr_un address;
+		if( path.empty() || path.size() >= sizeof(address.sun_path) )
+			throw SocketException("tcpip::Socket::set_unix_path() @ Invalid socket path " + path);
+		unix_path_ = path;
+#endif
+	}
+
 	// ----------------------------------------------------------------------
 	Socket*
 		Socket::
@@ -262,6 +284,44 @@ namespace tcpip
 		if( socket_ >= 0 )
 			return nullptr;
 
+#ifndef WIN32
+		if( !unix_path_.empty() )
+		{
+			if( server_socket_ < 0 )
+			{
+				sockaddr_un self;
+				memset(&self, 0, sizeof(self));
+				self.sun_family = AF_UNIX;
+				strncpy(self.sun_path, unix_path_.c_str(), sizeof(self.sun_path) - 1);
+
+				server_socket_ = static_cast<int>(socket( AF_UNIX, SOCK_STREAM, 0 ));
+				if( server_socket_ < 0 )
+					BailOnSocketError("tcpip::Socket::accept() @ socket");
+
+				// stale socket file of a previous server prevents binding
+				::unlink( unix_path_.c_str() );
+				if ( bind(server_socket_, (struct sockaddr*)&self, sizeof(self)) != 0 )
+					BailOnSocketError("tcpip::Socket::accept() Unable to create listening socket");
+				unix_bound_ = true;
+
+				if ( listen(server_socket_, 10) == -1 )
+					BailOnSocketError("tcpip::Socket::accept() Unable to listen on server socket");
+
+				set_blocking(blocking_);
+			}
+
+			socket_ = static_cast<int>(::accept(server_socket_, nullptr, nullptr));
+			if( socket_ >= 0 && create )
+			{
+				Socket* result = new Socket(0);
+				result->socket_ = socket_;
+				socket_ = -1;
+				return result;
+			}
+			return nullptr;
+		}
+#endif
+
 		struct sockaddr_in client_addr;
 #ifdef WIN32
 		int addrlen = sizeof(client_addr);
@@ -357,6 +417,30 @@ namespace tcpip
 		Socket::
 		connect()
 	{
+#ifndef WIN32
+		if( !unix_path_.empty() )
+		{
+			sockaddr_un address;
+			memset(&address, 0, sizeof(address));
+			address.sun_family = AF_UNIX;
+			strncpy(address.sun_path, unix_path_.c_str(), sizeof(address.sun_path) - 1);
+
+			socket_ = static_cast<int>(socket( AF_UNIX, SOCK_STREAM, 0 ));
+			if( socket_ < 0 )
+				BailOnSocketError("tcpip::Socket::connect() @ socket");
+
+			if( ::connect( socket_, (sockaddr const*)&address, sizeof(address) ) < 0 )
+			{
+				const int error = errno;
+				::close( socket_ );
+				socket_ = -1;
+				errno = error;
+				BailOnSocketError("tcpip::Socket::connect() @ connect");
+			}
+			return;
+		}
+#endif
+
 		sockaddr_in address;
 
 		if( !atoaddr( host_.c_str(), address) )
@@ -551,6 +635,33 @@ namespace tcpip
 
 		return true;
 	}
+
+
+	// ----------------------------------------------------------------------
+	std::size_t
+		Socket::
+		receiveExact( std::vector<unsigned char> &buffer )
+	{
+		// receive length of TraCI message
+		unsigned char length_buffer[lengthLen];
+		receiveComplete(length_buffer, lengthLen);
+		Storage length_storage(length_buffer, lengthLen);
+		const int totalLen = length_storage.readInt();
+		assert(totalLen > lengthLen);
+
+		// grow buffer if necessary, but keep its capacity for subsequent messages
+		const std::size_t msgLen = totalLen - lengthLen;
+		if (buffer.size() < msgLen)
+			buffer.resize(msgLen);
+
+		// receive remaining TraCI message directly into passed buffer
+		receiveComplete(&buffer[0], msgLen);
+
+		if (verbose_)
+			printBufferOnVerbose(std::vector<unsigned char>(buffer.begin(), buffer.begin() + msgLen), "Rcvd buffer with");
+
+		return msgLen;
+	}
 	
 	
 	// ----------------------------------------------------------------------
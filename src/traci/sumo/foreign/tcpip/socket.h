@@ -74,6 +74,9 @@ namespace tcpip
 		/// @note This is done by binding a socket with port=0, getting the assigned port, and closing the socket again
 		static int getFreeSocketPort();
 
+		/// Use Unix-domain socket at \p path instead of host_:port_ for connect() and accept() (POSIX only)
+		void set_unix_path(const std::string& path);
+
 		/// Connects to host_:port_
 		void connect();
 
@@ -86,6 +89,9 @@ namespace tcpip
 		std::vector<unsigned char> receive( int bufSize = 2048 );
 		/// Receive a complete TraCI message from Socket::socket_
 		bool receiveExact( Storage &);
+		/// Receive a complete TraCI message into \p buffer (grown if necessary, never shrunk)
+		/// @return length of received message without length header
+		std::size_t receiveExact( std::vector<unsigned char> &buffer );
 		void close();
 		int port();
 		void set_blocking(bool);
@@ -118,6 +124,8 @@ namespace tcpip
 
 		std::string host_;
 		int port_;
+		std::string unix_path_;
+		bool unix_bound_;
 		int socket_;
 		int server_socket_;
 		bool blocking_;
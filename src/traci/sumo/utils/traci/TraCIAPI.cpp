@@ -94,7 +94,7 @@ TraCIAPI::setOrder(int order) {
     outMsg.writeUnsignedByte(libsumo::CMD_SETORDER);
     outMsg.writeInt(order);
     // send request message
-    mySocket->sendExact(outMsg);
+    sendCommand(outMsg);
     tcpip::Storage inMsg;
     check_resultState(inMsg, libsumo::CMD_SETORDER);
 }
@@ -122,7 +122,7 @@ TraCIAPI::closeSocket() {
 
 
 void
-TraCIAPI::send_commandSimulationStep(double time) const {
+TraCIAPI::send_commandSimulationStep(double time) {
     tcpip::Storage outMsg;
     // command length
     outMsg.writeUnsignedByte(1 + 1 + 8);
@@ -130,23 +130,23 @@ TraCIAPI::send_commandSimulationStep(double time) const {
     outMsg.writeUnsignedByte(libsumo::CMD_SIMSTEP);
     outMsg.writeDouble(time);
     // send request message
-    mySocket->sendExact(outMsg);
+    sendCommand(outMsg);
 }
 
 
 void
-TraCIAPI::send_commandClose() const {
+TraCIAPI::send_commandClose() {
     tcpip::Storage outMsg;
     // command length
     outMsg.writeUnsignedByte(1 + 1);
     // command id
     outMsg.writeUnsignedByte(libsumo::CMD_CLOSE);
-    mySocket->sendExact(outMsg);
+    sendCommand(outMsg);
 }
 
 
 void
-TraCIAPI::send_commandSetOrder(int order) const {
+TraCIAPI::send_commandSetOrder(int order) {
     tcpip::Storage outMsg;
     // command length
     outMsg.writeUnsignedByte(1 + 1 + 4);
@@ -154,7 +154,19 @@ TraCIAPI::send_commandSetOrder(int order) const {
     outMsg.writeUnsignedByte(libsumo::CMD_SETORDER);
     // client index
     outMsg.writeInt(order);
-    mySocket->sendExact(outMsg);
+    sendCommand(outMsg);
+}
+
+
+void
+TraCIAPI::sendCommand(const tcpip::Storage& msg) {
+    mySocket->sendExact(msg);
+}
+
+
+void
+TraCIAPI::receiveResponse(tcpip::Storage& msg) const {
+    mySocket->receiveExact(msg);
 }
 
 
@@ -207,8 +219,8 @@ TraCIAPI::createFilterCommand(int cmdID, int varID, tcpip::Storage* add) const {
 
 void
 TraCIAPI::send_commandSubscribeObjectVariable(int domID, const std::string& objID, double beginTime, double endTime,
-        const std::vector<int>& vars) const {
-    if (mySocket == nullptr) {
+        const std::vector<int>& vars) {
+    if (!isConnected()) {
         throw tcpip::SocketException("Socket is not initialised");
     }
     tcpip::Storage outMsg;
@@ -229,14 +241,14 @@ TraCIAPI::send_commandSubscribeObjectVariable(int domID, const std::string& objI
         outMsg.writeUnsignedByte(vars[i]);
     }
     // send message
-    mySocket->sendExact(outMsg);
+    sendCommand(outMsg);
 }
 
 
 void
 TraCIAPI::send_commandSubscribeObjectContext(int domID, const std::string& objID, double beginTime, double endTime,
-        int domain, double range, const std::vector<int>& vars) const {
-    if (mySocket == nullptr) {
+        int domain, double range, const std::vector<int>& vars) {
+    if (!isConnected()) {
         throw tcpip::SocketException("Socket is not initialised");
     }
     tcpip::Storage outMsg;
@@ -260,13 +272,13 @@ TraCIAPI::send_commandSubscribeObjectContext(int domID, const std::string& objID
         outMsg.writeUnsignedByte(vars[i]);
     }
     // send message
-    mySocket->sendExact(outMsg);
+    sendCommand(outMsg);
 }
 
 
 void
 TraCIAPI::check_resultState(tcpip::Storage& inMsg, int command, bool ignoreCommandId, std::string* acknowledgement) const {
-    mySocket->receiveExact(inMsg);
+    receiveResponse(inMsg);
     int cmdLength;
     int cmdId;
     int resultType;
@@ -329,8 +341,8 @@ TraCIAPI::check_commandGetResult(tcpip::Storage& inMsg, int command, int expecte
 
 bool
 TraCIAPI::processGet(int command, int expectedType, bool ignoreCommandId) {
-    if (mySocket != nullptr) {
-        mySocket->sendExact(myOutput);
+    if (isConnected()) {
+        sendCommand(myOutput);
         myInput.reset();
         check_resultState(myInput, command, ignoreCommandId);
         check_commandGetResult(myInput, command, expectedType, ignoreCommandId);
@@ -342,8 +354,8 @@ TraCIAPI::processGet(int command, int expectedType, bool ignoreCommandId) {
 
 bool
 TraCIAPI::processSet(int command) {
-    if (mySocket != nullptr) {
-        mySocket->sendExact(myOutput);
+    if (isConnected()) {
+        sendCommand(myOutput);
         myInput.reset();
         check_resultState(myInput, command);
         return true;
@@ -446,6 +458,12 @@ TraCIAPI::readContextSubscription(int cmdId, tcpip::Storage& inMsg) {
 void
 TraCIAPI::simulationStep(double time) {
     send_commandSimulationStep(time);
+    readSimulationStepResult();
+}
+
+
+void
+TraCIAPI::readSimulationStepResult() {
     tcpip::Storage inMsg;
     check_resultState(inMsg, libsumo::CMD_SIMSTEP);
 
@@ -477,7 +495,7 @@ TraCIAPI::load(const std::vector<std::string>& args) {
     content.writeUnsignedByte(libsumo::CMD_LOAD);
     content.writeUnsignedByte(libsumo::TYPE_STRINGLIST);
     content.writeStringList(args);
-    mySocket->sendExact(content);
+    sendCommand(content);
     tcpip::Storage inMsg;
     check_resultState(inMsg, libsumo::CMD_LOAD);
 }
@@ -488,7 +506,7 @@ TraCIAPI::getVersion() {
     tcpip::Storage content;
     content.writeUnsignedByte(2);
     content.writeUnsignedByte(libsumo::CMD_GETVERSION);
-    mySocket->sendExact(content);
+    sendCommand(content);
     tcpip::Storage inMsg;
     check_resultState(inMsg, libsumo::CMD_GETVERSION);
     inMsg.readUnsignedByte(); // msg length
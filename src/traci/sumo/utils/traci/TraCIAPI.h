@@ -69,6 +69,11 @@ public:
 
     /// @brief ends the simulation and closes the connection
     void close();
+
+    /// @brief whether commands can be exchanged with a server
+    virtual bool isConnected() const {
+        return mySocket != nullptr;
+    }
     /// @}
 
     /// @brief Advances by one step (or up to the given time)
@@ -849,17 +854,27 @@ protected:
 
     /** @brief Sends a SimulationStep command
      */
-    void send_commandSimulationStep(double time) const;
+    void send_commandSimulationStep(double time);
 
 
     /** @brief Sends a Close command
      */
-    void send_commandClose() const;
+    void send_commandClose();
 
 
     /** @brief Sends a SetOrder command
      */
-    void send_commandSetOrder(int order) const;
+    void send_commandSetOrder(int order);
+
+    /** @brief Sends a complete request message via mySocket
+     * @param[in] msg The message to send
+     */
+    virtual void sendCommand(const tcpip::Storage& msg);
+
+    /** @brief Receives a complete response message via mySocket
+     * @param[out] msg The buffer to store the message in
+     */
+    virtual void receiveResponse(tcpip::Storage& msg) const;
 
     /** @brief Sends a GetVariable / SetVariable request if mySocket is connected.
      * Otherwise writes to myOutput only.
@@ -879,7 +894,7 @@ protected:
      * @param[in] endTime The end time step of subscriptions
      * @param[in] vars The variables to subscribe
      */
-    void send_commandSubscribeObjectVariable(int domID, const std::string& objID, double beginTime, double endTime, const std::vector<int>& vars) const;
+    void send_commandSubscribeObjectVariable(int domID, const std::string& objID, double beginTime, double endTime, const std::vector<int>& vars);
 
 
     /** @brief Sends a SubscribeContext request
@@ -892,7 +907,7 @@ protected:
      * @param[in] vars The variables to subscribe
      */
     void send_commandSubscribeObjectContext(int domID, const std::string& objID, double beginTime, double endTime,
-                                            int domain, double range, const std::vector<int>& vars) const;
+                                            int domain, double range, const std::vector<int>& vars);
     /// @}
 
 
@@ -914,6 +929,10 @@ protected:
 
     bool processGet(int command, int expectedType, bool ignoreCommandId = false);
     bool processSet(int command);
+
+    /** @brief Reads the response of a SimulationStep command including subscription results
+     */
+    virtual void readSimulationStepResult();
     /// @}
 
     void readVariableSubscription(int cmdId, tcpip::Storage& inMsg);
@@ -3,8 +3,9 @@ import sqlite3
 
 from pathlib import Path
 from functools import cached_property
-from typing import Dict, Optional
+from typing import Dict, Optional, Tuple
 
+import numpy as np
 import pandas as pd
 
 
@@ -114,6 +115,18 @@ class SimRecordedData:
         return self.run['simtimeExp'][0]
 
 
+def read_binary_trace(trace_file: Path) -> Tuple[pd.DataFrame, pd.DataFrame]:
+    """Load samples written by Artery's binaryVector result recorder
+
+    Returns declared traces (id, module, name) and their samples (id, time, value).
+    """
+    traces = pd.read_csv(trace_file.with_name(trace_file.name + '.idx'), sep='\t', header=None,
+        names=['id', 'module', 'name'], dtype={'id': np.uint32})
+    record = np.dtype([('id', '<u4'), ('time', '<f8'), ('value', '<f8')], align=False)
+    samples = pd.DataFrame(np.fromfile(trace_file, dtype=record))
+    return traces, samples
+
+
 class SimResultsReader:
     def __scan_results(self, scenerio_path: Path, results_dir: Path) -> Dict[str, Dict[str, Path]]:
         scenerio_path = scenerio_path.resolve()
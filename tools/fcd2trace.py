@@ -0,0 +1,229 @@
+#!/usr/bin/env python3
+"""Convert SUMO FCD output into an indexed trajectory trace for traci.PlaybackLauncher.
+
+The binary layout is documented in src/traci/PlaybackTrace.h.
+Example: sumo -c scenario.sumocfg --fcd-output fcd.xml && fcd2trace.py fcd.xml scenario.trace --net scenario.net.xml
+"""
+
+import argparse
+import re
+import struct
+import sys
+import xml.etree.ElementTree as ET
+
+from pathlib import Path
+from typing import Dict, Iterator, List, NamedTuple, Optional, Tuple
+
+
+MAGIC = b'ARTERYTR'
+VERSION = 1
+HEADER_SIZE = 96
+TYPE_SIZE = 56
+VEHICLE_SIZE = 8
+BLOCK_HEADER_SIZE = 8
+RECORD_SIZE = 48
+
+
+class VehicleType(NamedTuple):
+    vclass: str = 'passenger'
+    length: float = 5.0
+    width: float = 1.8
+    height: float = 1.5
+    max_speed: float = 55.55
+    accel: float = 2.6
+    decel: float = 4.5
+
+
+class Record(NamedTuple):
+    vehicle: str
+    vtype: str
+    x: float
+    y: float
+    z: float
+    speed: float
+    angle: float
+
+
+class Location(NamedTuple):
+    boundary: Tuple[float, float, float, float]
+    utm_zone: int
+    utm_offset: Tuple[float, float]
+
+
+def iterate_timesteps(fcd: Path) -> Iterator[Tuple[float, List[Record]]]:
+    records = []
+    for event, element in ET.iterparse(str(fcd), events=('end',)):
+        if element.tag == 'vehicle':
+            records.append(Record(
+                element.get('id'), element.get('type', 'DEFAULT_VEHTYPE'),
+                float(element.get('x')), float(element.get('y')), float(element.get('z', 0.0)),
+                float(element.get('speed', 0.0)), float(element.get('angle', 0.0))))
+        elif element.tag == 'timestep':
+            yield float(element.get('time')), records
+            records = []
+            element.clear()
+
+
+def read_location(net: Path) -> Location:
+    for event, element in ET.iterparse(str(net), events=('start',)):
+        if element.tag == 'location':
+            boundary = tuple(float(v) for v in element.get('convBoundary').split(','))
+            offset_x, offset_y = (float(v) for v in element.get('netOffset', '0,0').split(','))
+            zone = 0
+            projection = element.get('projParameter', '')
+            if (match := re.search(r'\+proj=utm\b.*?\+zone=(\d+)', projection)) is not None:
+                zone = int(match.group(1))
+                if '+south' in projection:
+                    # Artery's UTM projection has no false northing
+                    offset_y += 10000000.0
+            return Location(boundary, zone, (offset_x, offset_y))
+    raise ValueError(f'{net} lacks a location element')
+
+
+def read_vehicle_types(files: List[Path]) -> Dict[str, VehicleType]:
+    defaults = VehicleType()
+    types = {}
+    for path in files:
+        for event, element in ET.iterparse(str(path), events=('start',)):
+            if element.tag == 'vType':
+                types[element.get('id')] = VehicleType(
+                    element.get('vClass', defaults.vclass),
+                    float(element.get('length', defaults.length)),
+                    float(element.get('width', defaults.width)),
+                    float(element.get('height', defaults.height)),
+                    float(element.get('maxSpeed', defaults.max_speed)),
+                    float(element.get('accel', defaults.accel)),
+                    float(element.get('decel', defaults.decel)))
+    return types
+
+
+def convert(fcd: Path, output: Path, net: Optional[Path], vtypes: List[Path], step_length: Optional[float]) -> None:
+    # first pass: index vehicles, types and step blocks
+    begin = None
+    times = []
+    vehicles: Dict[str, int] = {}
+    vehicle_types: Dict[str, str] = {}
+    first_block: List[int] = []
+    block_records: Dict[int, int] = {}
+    bounds = [float('inf'), float('inf'), float('-inf'), float('-inf')]
+    for time, records in iterate_timesteps(fcd):
+        times.append(time)
+        if begin is None:
+            begin = time
+        if step_length is None and len(times) == 2:
+            step_length = times[1] - times[0]
+        if step_length is None:
+            block = 0
+        else:
+            block = round((time - begin) / step_length)
+        block_records[block] = len(records)
+        for record in records:
+            if record.vehicle not in vehicles:
+                vehicles[record.vehicle] = len(vehicles)
+                vehicle_types[record.vehicle] = record.vtype
+                first_block.append(block)
+            bounds = [min(bounds[0], record.x), min(bounds[1], record.y),
+                      max(bounds[2], record.x), max(bounds[3], record.y)]
+
+    if begin is None:
+        raise ValueError(f'{fcd} contains no timesteps')
+    if step_length is None or step_length <= 0.0:
+        raise ValueError('cannot infer step length, pass --step-length')
+    num_blocks = max(block_records) + 1
+
+    if net is not None:
+        location = read_location(net)
+    elif vehicles:
+        location = Location(tuple(bounds), 0, (0.0, 0.0))
+    else:
+        location = Location((0.0, 0.0, 0.0, 0.0), 0, (0.0, 0.0))
+
+    known_types = read_vehicle_types(vtypes)
+    type_ids = sorted(set(vehicle_types.values()))
+    type_index = {type_id: i for i, type_id in enumerate(type_ids)}
+    missing = [type_id for type_id in type_ids if type_id not in known_types]
+    if missing:
+        print(f'using default properties for vehicle types: {", ".join(missing)}', file=sys.stderr)
+
+    # vehicles departing after each block
+    departures = [0] * num_blocks
+    for block in first_block:
+        departures[block] += 1
+    pending = [0] * num_blocks
+    remaining = 0
+    for block in reversed(range(num_blocks)):
+        pending[block] = remaining
+        remaining += departures[block]
+
+    # string pool directly follows header
+    strings = bytearray()
+    string_offsets: Dict[str, int] = {}
+
+    def string_offset(value: str) -> int:
+        if value not in string_offsets:
+            encoded = value.encode('utf-8')
+            string_offsets[value] = HEADER_SIZE + len(strings)
+            strings.extend(struct.pack('<I', len(encoded)))
+            strings.extend(encoded)
+        return string_offsets[value]
+
+    type_table = bytearray()
+    for type_id in type_ids:
+        vtype = known_types.get(type_id, VehicleType())
+        type_table.extend(struct.pack('<II6d', string_offset(type_id), string_offset(vtype.vclass),
+                                      vtype.length, vtype.width, vtype.height,
+                                      vtype.max_speed, vtype.accel, vtype.decel))
+
+    vehicle_table = bytearray()
+    for vehicle_id in vehicles:
+        vehicle_table.extend(struct.pack('<II', string_offset(vehicle_id), type_index[vehicle_types[vehicle_id]]))
+
+    index_offset = HEADER_SIZE + len(strings) + len(type_table) + len(vehicle_table)
+    block_offset = index_offset + 8 * num_blocks
+    step_index = bytearray()
+    for block in range(num_blocks):
+        step_index.extend(struct.pack('<Q', block_offset))
+        block_offset += BLOCK_HEADER_SIZE + RECORD_SIZE * block_records.get(block, 0)
+
+    header = MAGIC + struct.pack('<IIII', VERSION, num_blocks, len(vehicles), len(type_ids))
+    header += struct.pack('<2d', begin, step_length)
+    header += struct.pack('<4d', *location.boundary)
+    header += struct.pack('<iI2d', location.utm_zone, len(strings), *location.utm_offset)
+    assert len(header) == HEADER_SIZE
+
+    # second pass: write step blocks, gaps in FCD output become empty blocks
+    with open(output, 'wb') as trace:
+        trace.write(header)
+        trace.write(strings)
+        trace.write(type_table)
+        trace.write(vehicle_table)
+        trace.write(step_index)
+
+        next_block = 0
+        for time, records in iterate_timesteps(fcd):
+            block = round((time - begin) / step_length)
+            while next_block < block:
+                trace.write(struct.pack('<II', 0, pending[next_block]))
+                next_block += 1
+            trace.write(struct.pack('<II', len(records), pending[block]))
+            ordered = sorted(records, key=lambda record: vehicles[record.vehicle])
+            for record in ordered:
+                trace.write(struct.pack('<II5d', vehicles[record.vehicle], 0,
+                                        record.x, record.y, record.z, record.speed, record.angle))
+            next_block = block + 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert SUMO FCD output into an Artery playback trace')
+    parser.add_argument('fcd', type=Path, help='SUMO FCD output (XML)')
+    parser.add_argument('output', type=Path, help='trace file to write')
+    parser.add_argument('--net', type=Path, help='SUMO network for boundary and geographic projection')
+    parser.add_argument('--vtypes', type=Path, nargs='*', default=[],
+                        help='files with vType definitions, e.g. route files')
+    parser.add_argument('--step-length', type=float, help='SUMO step length, inferred from FCD by default')
+    args = parser.parse_args()
+    convert(args.fcd, args.output, args.net, args.vtypes, args.step_length)
+
+
+if __name__ == '__main__':
+    main()
@@ -1,31 +1,27 @@
 #!/usr/bin/env python3
 
+import os
+import re
 import sys
 import argparse
 import subprocess
 import configparser
 import pathlib
+import tempfile
 
 from pathlib import Path
-from typing import Optional, Iterable
+from typing import Optional, Iterable, List, NamedTuple
 
 
-def run_artery(
+def build_command(
     launch_conf: Path,
     opp_args: Optional[Iterable[str]] = None,
-    scenario: Optional[Path] = None,
     runall: bool = False,
     batchsize: Optional[int] = None,
-    jobs: Optional[int] = None,
-    verbose: bool = False,
-    capture_output: bool = False
-) -> int:
-    
+    jobs: Optional[int] = None
+) -> List[str]:
     if opp_args is None:
         opp_args = []
-    
-    if scenario is None:
-        scenario = Path.cwd()
 
     if launch_conf.is_file():
         config_filename = launch_conf
@@ -51,14 +47,32 @@ def run_artery(
     if runall:
         cmd.append(opp_runall)
         if batchsize is not None:
-            cmd.extend(['-b', opp_args.batch])
+            cmd.extend(['-b', str(batchsize)])
         if jobs is not None:
-            cmd.extend(['-j', opp_args.jobs])
+            cmd.extend(['-j', str(jobs)])
 
     cmd.append(opp_run)
     cmd.extend(['-n', ned_folders])
     cmd.extend(libraries.split())
     cmd.extend(opp_args)
+    return cmd
+
+
+def run_artery(
+    launch_conf: Path,
+    opp_args: Optional[Iterable[str]] = None,
+    scenario: Optional[Path] = None,
+    runall: bool = False,
+    batchsize: Optional[int] = None,
+    jobs: Optional[int] = None,
+    verbose: bool = False,
+    capture_output: bool = False
+) -> int:
+    
+    if scenario is None:
+        scenario = Path.cwd()
+
+    cmd = build_command(launch_conf, opp_args, runall, batchsize, jobs)
 
     if verbose:
         print('running command: ', ' '.join(cmd))
@@ -70,6 +84,115 @@ def run_artery(
     return process.returncode
 
 
+class ScalingPoint(NamedTuple):
+    scale: float
+    returncode: int
+    events: Optional[int]
+    simtime: Optional[float]
+    elapsed: Optional[float]
+    traci_time: Optional[float]
+    peak_rss: int  # kilobytes
+
+    @property
+    def events_per_second(self) -> Optional[float]:
+        return self.events / self.elapsed if self.events is not None and self.elapsed else None
+
+    @property
+    def simsec_per_second(self) -> Optional[float]:
+        return self.simtime / self.elapsed if self.simtime is not None and self.elapsed else None
+
+    @property
+    def traci_share(self) -> Optional[float]:
+        return self.traci_time / self.elapsed if self.traci_time is not None and self.elapsed else None
+
+
+# Cmdenv progress line, e.g. "** Event #36864   t=11.2   Elapsed: 2.04s (0m 02s)"
+_progress_pattern = re.compile(r'\*\* Event #(\d+)\s+t=(\S+)\s+Elapsed: ([\d.]+)s')
+
+
+def _parse_progress(output: str):
+    events = simtime = elapsed = None
+    for match in _progress_pattern.finditer(output):
+        events, simtime, elapsed = int(match.group(1)), float(match.group(2)), float(match.group(3))
+    return events, simtime, elapsed
+
+
+def _parse_traci_time(result_dir: Path) -> Optional[float]:
+    # recorded by the Profiler module if Artery is built WITH_PROFILER
+    total = None
+    for sca in result_dir.glob('*.sca'):
+        with open(sca) as sca_file:
+            for line in sca_file:
+                if line.startswith('scalar ') and '"traci.handleMessage ' in line and line.split('"')[1].endswith(' time'):
+                    total = (total or 0.0) + float(line.split()[-1])
+    return total
+
+
+def run_scaling(
+    launch_conf: Path,
+    scales: Iterable[float],
+    opp_args: Optional[Iterable[str]] = None,
+    scenario: Optional[Path] = None,
+    scale_param: str = '*.traci.launcher.appendOptions',
+    verbose: bool = False
+) -> List[ScalingPoint]:
+    """Run a scenario once per SUMO traffic scale factor and collect performance figures"""
+    if scenario is None:
+        scenario = Path.cwd()
+
+    points = []
+    for scale in scales:
+        with tempfile.TemporaryDirectory(prefix='artery-scaling-') as result_dir:
+            # options given for scale_param on the command line are kept, scale is appended to them
+            args = []
+            options = [f'--scale {scale}']
+            for arg in opp_args or []:
+                if arg.startswith(f'--{scale_param}='):
+                    options.insert(-1, arg.split('=', 1)[1].strip('"'))
+                else:
+                    args.append(arg)
+            args.extend(['-u', 'Cmdenv', '--cmdenv-express-mode=true', '--cmdenv-performance-display=true'])
+            args.append(f'--{scale_param}="{" ".join(options)}"')
+            args.append(f'--result-dir={result_dir}')
+            cmd = build_command(launch_conf, args)
+            if verbose:
+                print('running command: ', ' '.join(cmd))
+
+            process = subprocess.Popen(cmd, cwd=scenario, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+            output = process.stdout.read()
+            # wait4 reports resource usage of this run only: ru_maxrss is the peak RSS of opp_run
+            # or of a descendant it has reaped (e.g. SUMO), given in kilobytes on Linux but bytes on macOS
+            _, status, usage = os.wait4(process.pid, 0)
+            peak_rss = usage.ru_maxrss // 1024 if sys.platform == 'darwin' else usage.ru_maxrss
+            process.returncode = os.waitstatus_to_exitcode(status)
+            process.stdout.close()
+
+            events, simtime, elapsed = _parse_progress(output)
+            points.append(ScalingPoint(scale, process.returncode, events, simtime, elapsed,
+                _parse_traci_time(Path(result_dir)), peak_rss))
+            if verbose:
+                print(f'scale {scale} finished with return code {process.returncode}')
+    return points
+
+
+def format_scaling_report(points: Iterable[ScalingPoint]) -> str:
+    def fmt(value, spec):
+        return format(value, spec) if value is not None else 'n/a'
+
+    lines = ['scale\tstatus\tevents\tev/s\tsimsec/s\ttraci share\tpeak RSS (MiB)']
+    for point in points:
+        lines.append('\t'.join([
+            f'{point.scale:g}',
+            str(point.returncode),
+            fmt(point.events, 'd'),
+            fmt(point.events_per_second, '.1f'),
+            fmt(point.simsec_per_second, '.3f'),
+            fmt(point.traci_share, '.1%'),
+            f'{point.peak_rss / 1024:.1f}'
+        ]))
+    return '\n'.join(lines) + '\n'
+
+
 def main():
     parser = argparse.ArgumentParser()
     parser.add_argument('--all', action='store_true', help='sets runall mode')
@@ -78,12 +201,28 @@ def main():
     parser.add_argument('-l', '--launch-conf', action='store', required=True, type=pathlib.Path)
     parser.add_argument('-s', '--scenario', default=pathlib.Path.cwd(), type=pathlib.Path)
     parser.add_argument('-v', '--verbose', action='store_true')
+    parser.add_argument('--scaling', action='store', metavar='SCALES',
+        help='comma-separated SUMO --scale factors, runs the configuration once per factor')
+    parser.add_argument('--scaling-param', action='store', default='*.traci.launcher.appendOptions',
+        help='parameter passing SUMO options in addition to extraOptions (default: %(default)s)')
+    parser.add_argument('--scaling-report', action='store', type=pathlib.Path,
+        help='write scaling report to this file instead of stdout')
     args, opp_args = parser.parse_known_args()
 
     # remove '--' from opp_args when used to split run_artery args from opp_run args
     if len(opp_args) > 0 and opp_args[0] == '--':
         opp_args = opp_args[1:]
     
+    if args.scaling:
+        scales = [float(scale) for scale in args.scaling.split(',')]
+        points = run_scaling(args.launch_conf, scales, opp_args, args.scenario, args.scaling_param, args.verbose)
+        report = format_scaling_report(points)
+        if args.scaling_report:
+            args.scaling_report.write_text(report)
+        else:
+            print(report, end='')
+        sys.exit(max(abs(point.returncode) for point in points))
+
     sys.exit(run_artery(
         args.launch_conf,
         opp_args,